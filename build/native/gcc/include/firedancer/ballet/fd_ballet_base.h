@@ -0,0 +1,18 @@
+#ifndef HEADER_fd_src_ballet_fd_ballet_base_h
+#define HEADER_fd_src_ballet_fd_ballet_base_h
+
+#include "../util/fd_util.h"
+
+/* FD_TPU_MTU: The maximum size of a Solana transaction in serialized
+   wire-protocol form.  This does not count any network-level (e.g. UDP
+   or QUIC) headers. */
+#define FD_TPU_MTU (1232UL)
+//FD_PROTOTYPES_BEGIN
+
+/* This is currently just a stub in anticipation of future common
+   interoperability functionality */
+
+//FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_fd_ballet_base_h */
+
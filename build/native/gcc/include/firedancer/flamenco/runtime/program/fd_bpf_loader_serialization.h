@@ -0,0 +1,66 @@
+#ifndef HEADER_fd_src_flamenco_runtime_program_fd_bpf_loader_serialization_h
+#define HEADER_fd_src_flamenco_runtime_program_fd_bpf_loader_serialization_h
+
+#include "../../fd_flamenco_base.h"
+#include "../fd_executor.h"
+#include "../fd_runtime.h"
+#include "../../vm/fd_vm_context.h"
+
+#define MAX_PERMITTED_DATA_INCREASE (10 * 1024)
+#define BPF_ALIGN_OF_U128           (8UL)
+
+/* FD_BPF_LOADER_INPUT_REGIONS_MAX is the max number of sub-regions in a
+   direct mapped input region for an instruction with acct_cnt accounts
+   (serialized parameters, data and realloc region per account, plus the
+   trailing serialized parameters) */
+
+#define FD_BPF_LOADER_INPUT_REGIONS_MAX( acct_cnt ) (3UL*(acct_cnt)+1UL)
+
+FD_PROTOTYPES_BEGIN
+
+uchar *
+fd_bpf_loader_input_serialize_aligned( fd_exec_instr_ctx_t ctx, ulong * sz, ulong * pre_lens );
+
+int
+fd_bpf_loader_input_deserialize_aligned( fd_exec_instr_ctx_t ctx, ulong const * pre_lens, uchar * input, ulong input_sz );
+
+/* fd_bpf_loader_input_serialize_direct_mapped is the aligned
+   serialization, but with account data mapped in place instead of
+   copied into the returned buffer, which holds everything else.  The
+   alignment padding and realloc region after each account's data are
+   a sub-region of their own, writable only if the data can be changed,
+   and BPF_ALIGN_OF_U128 bytes larger in the buffer than in the aligned
+   serialization.  On return, input_mem_regions[0,*input_mem_regions_cnt)
+   describes the input region as seen by the program, where every field
+   is at the same address as in the aligned serialization, and
+   acc_region_metas[i] is where the data of instruction account i is
+   mapped.  input_mem_regions must have room for
+   FD_BPF_LOADER_INPUT_REGIONS_MAX( acct_cnt ) regions and
+   acc_region_metas for acct_cnt entries.  Returns NULL on failure. */
+
+uchar *
+fd_bpf_loader_input_serialize_direct_mapped( fd_exec_instr_ctx_t       ctx,
+                                             ulong *                   sz,
+                                             ulong *                   pre_lens,
+                                             fd_vm_input_region_t *    input_mem_regions,
+                                             uint *                    input_mem_regions_cnt,
+                                             fd_vm_acc_region_meta_t * acc_region_metas );
+
+/* fd_bpf_loader_input_deserialize_direct_mapped applies the changes the
+   program made to a direct mapped input region to the accounts.  Account
+   data was written in place, so only data the program grew an account
+   by is copied out of input.  Frees input. */
+
+int
+fd_bpf_loader_input_deserialize_direct_mapped( fd_exec_instr_ctx_t ctx, ulong const * pre_lens, uchar * input, ulong input_sz );
+
+uchar *
+fd_bpf_loader_input_serialize_unaligned( fd_exec_instr_ctx_t ctx, ulong * sz, ulong * pre_lens );
+
+int
+fd_bpf_loader_input_deserialize_unaligned( fd_exec_instr_ctx_t ctx, ulong const * pre_lens, uchar * input, ulong input_sz );
+
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_program_fd_bpf_loader_serialization_h */
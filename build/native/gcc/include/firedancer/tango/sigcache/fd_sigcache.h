@@ -0,0 +1,334 @@
+#ifndef HEADER_fd_src_tango_sigcache_fd_sigcache_h
+#define HEADER_fd_src_tango_sigcache_fd_sigcache_h
+
+/* A fd_sigcache_t is a cache of recently observed 128-bit tags, with
+   an expiration time per tag.  Like fd_tcache, it is meant for
+   deduplication of traffic by a thumbprint / hash / signature, but it
+   differs from fd_tcache in a few ways:
+
+   - Tags are 128 bits instead of 64, of which 96 (all of the low word
+     and the low half of the high word) are stored and compared, so
+     the chance that two distinct transactions collide (and one gets
+     incorrectly dropped as a duplicate) is negligible even when the
+     tags are chosen adversarially, e.g. taken straight from a
+     signature.  There is no null tag, any value can be inserted.
+
+   - The cache is organized as a power of 2 number of buckets, each of
+     which holds FD_SIGCACHE_BUCKET_WIDTH tags.  A tag can only ever be
+     found in the bucket it hashes to, so a query or insert examines
+     exactly one bucket, which is done with a handful of SIMD compares
+     on AVX / AVX-512 targets.  The cost of an operation does not depend
+     on how full the cache is.
+
+   - Every tag expires ttl time units after it was inserted, and tags
+     that have expired are treated as absent.  Time is a uint in
+     whatever units the application likes (ticks shifted down, slots,
+     ...), which is allowed to wrap around, and the application must
+     use the same units consistently.  When a tag is inserted into a
+     bucket with no free or expired slots, the oldest tag in the bucket
+     is evicted.
+
+   Each bucket of 8 tags is 128 bytes (two cache lines, which the
+   adjacent line prefetcher on x86 typically fetches together), so
+   remembering depth tags takes about 32*depth bytes at the default
+   sparsity.
+
+   Because time wraps, a slot that was written more than 2^32-ttl time
+   units ago can appear live again for ttl units.  This only ever
+   matches a query for the exact tag that was in it, and it only makes
+   the slot a candidate for eviction rather than a free slot, so it is
+   harmless as long as ttl is much less than 2^32, in which case it is
+   also rare.
+
+   The bucket a tag hashes to is picked with a seeded hash so that a
+   producer of tags (who may control the tags completely) cannot target
+   a specific bucket to evict tags from it.
+
+   As with fd_tcache, it is strongly recommended that the sigcache be
+   backed by a single NUMA page (e.g. in a gigantic page backed
+   workspace) to avoid TLB thrashing in performance critical
+   contexts. */
+
+#include "../fd_tango_base.h"
+
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+#if FD_HAS_AVX512
+#include "../../util/simd/fd_avx512.h"
+#endif
+
+/* FD_SIGCACHE_BUCKET_WIDTH is the number of tags in each bucket.  The
+   bucket layout below assumes this is 8.  FD_SIGCACHE_TTL_MAX is the
+   largest ttl a sigcache can be created with. */
+
+#define FD_SIGCACHE_BUCKET_WIDTH (8UL)
+#define FD_SIGCACHE_TTL_MAX      (1U<<31)
+
+/* FD_SIGCACHE_SPARSE_DEFAULT specifies how many bucket slots there are
+   per tag of depth, as a power of 2, in the default configuration.
+   Since tags are not distributed evenly among buckets, a cache with
+   exactly depth slots would start evicting live tags well before it
+   held depth tags.  With a value of 1 (2 slots per tag of depth), an
+   evicted tag is almost always one of the oldest in the cache. */
+
+#define FD_SIGCACHE_SPARSE_DEFAULT (1)
+
+/* FD_SIGCACHE_{ALIGN,FOOTPRINT} specify the alignment and footprint
+   needed for a sigcache with bucket_cnt buckets.  bucket_cnt is assumed
+   to be a positive integer power of 2.  These are provided to
+   facilitate compile time declarations. */
+
+#define FD_SIGCACHE_ALIGN (128UL)
+#define FD_SIGCACHE_FOOTPRINT( bucket_cnt )                                           \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                 \
+    FD_SIGCACHE_ALIGN, 128UL ),                                                       \
+    64UL,              (bucket_cnt)*2UL*FD_SIGCACHE_BUCKET_WIDTH*sizeof(ulong) ),     \
+    FD_SIGCACHE_ALIGN )
+
+/* fd_sigcache_tag_t is a 128-bit tag. */
+
+struct fd_sigcache_tag {
+  ulong lo;
+  ulong hi;
+};
+
+typedef struct fd_sigcache_tag fd_sigcache_tag_t;
+
+/* A bucket.  The tags and expiration times are stored as structure of
+   arrays so that each can be loaded into a vector register directly.
+   hi holds the low 32 bits of the high word of the tag.  A slot is live
+   at time now if exp[ slot ]-now (mod 2^32) is in [1,ttl]. */
+
+struct __attribute__((aligned(64UL))) fd_sigcache_bucket {
+  ulong lo [ FD_SIGCACHE_BUCKET_WIDTH ];
+  uint  hi [ FD_SIGCACHE_BUCKET_WIDTH ];
+  uint  exp[ FD_SIGCACHE_BUCKET_WIDTH ];
+};
+
+typedef struct fd_sigcache_bucket fd_sigcache_bucket_t;
+
+#define FD_SIGCACHE_MAGIC (0xf17eda2c3751ca41UL) /* firedancer sigcache ver 1 */
+
+struct __attribute__((aligned(FD_SIGCACHE_ALIGN))) fd_sigcache_private {
+  ulong magic;      /* ==FD_SIGCACHE_MAGIC */
+  ulong bucket_cnt; /* positive integer power of 2 */
+  ulong seed;       /* seed of the hash used to pick a bucket for a tag */
+  uint  ttl;        /* in [1,FD_SIGCACHE_TTL_MAX], time a tag lives for */
+
+  /* Padding to FD_SIGCACHE_ALIGN */
+
+  /* bucket_cnt fd_sigcache_bucket_t follow */
+};
+
+typedef struct fd_sigcache_private fd_sigcache_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_sigcache_bucket_cnt_default returns the default bucket_cnt to use
+   for a sigcache that should remember at least depth tags.  Returns 0
+   if depth is not positive or is too large. */
+
+FD_FN_CONST static inline ulong
+fd_sigcache_bucket_cnt_default( ulong depth ) {
+  if( FD_UNLIKELY( !depth ) ) return 0UL;
+  if( FD_UNLIKELY( depth>(1UL<<(58-FD_SIGCACHE_SPARSE_DEFAULT)) ) ) return 0UL; /* too large */
+  ulong slot_cnt = depth << FD_SIGCACHE_SPARSE_DEFAULT;
+  return fd_ulong_pow2_up( (slot_cnt + FD_SIGCACHE_BUCKET_WIDTH - 1UL) / FD_SIGCACHE_BUCKET_WIDTH );
+}
+
+/* fd_sigcache_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a sigcache with
+   bucket_cnt buckets.  If bucket_cnt is not a positive integer power of
+   2 or the footprint would be larger than ULONG_MAX, footprint returns
+   0. */
+
+FD_FN_CONST ulong
+fd_sigcache_align( void );
+
+FD_FN_CONST ulong
+fd_sigcache_footprint( ulong bucket_cnt );
+
+/* fd_sigcache_new formats an unused memory region for use as a
+   sigcache.  shmem is a non-NULL pointer to this region in the local
+   address space with the required footprint and alignment.  seed is an
+   arbitrary value used to seed the hash that picks the bucket for a
+   tag, and should be unpredictable if the tags can be chosen by an
+   adversary.  ttl in [1,FD_SIGCACHE_TTL_MAX] is how many time units a
+   tag is remembered for after it is inserted.  Returns shmem (formatted
+   as an empty sigcache, caller is not joined) on success and NULL on
+   failure (logs details). */
+
+void *
+fd_sigcache_new( void * shmem,
+                 ulong  bucket_cnt,
+                 ulong  seed,
+                 uint   ttl );
+
+/* fd_sigcache_join joins the caller to the sigcache.  Returns a local
+   handle on success and NULL on failure (logs details).
+   fd_sigcache_leave leaves a current local join and returns a pointer
+   to the underlying memory region.  fd_sigcache_delete unformats a
+   memory region used as a sigcache and returns ownership to the
+   caller.  These follow the usual fd conventions. */
+
+fd_sigcache_t *
+fd_sigcache_join( void * _cache );
+
+void *
+fd_sigcache_leave( fd_sigcache_t * cache );
+
+void *
+fd_sigcache_delete( void * _cache );
+
+/* Accessors.  These assume cache is a valid local join. */
+
+FD_FN_PURE static inline ulong fd_sigcache_bucket_cnt( fd_sigcache_t const * cache ) { return cache->bucket_cnt; }
+FD_FN_PURE static inline ulong fd_sigcache_seed      ( fd_sigcache_t const * cache ) { return cache->seed;       }
+FD_FN_PURE static inline uint  fd_sigcache_ttl       ( fd_sigcache_t const * cache ) { return cache->ttl;        }
+
+FD_FN_CONST static inline fd_sigcache_bucket_t *
+fd_sigcache_private_buckets( fd_sigcache_t * cache ) {
+  return (fd_sigcache_bucket_t *)( (ulong)cache + 128UL );
+}
+
+FD_FN_CONST static inline fd_sigcache_bucket_t const *
+fd_sigcache_private_buckets_const( fd_sigcache_t const * cache ) {
+  return (fd_sigcache_bucket_t const *)( (ulong)cache + 128UL );
+}
+
+/* fd_sigcache_tag_from_sig returns the tag to use for an ed25519
+   signature (or any other at least 16 byte thumbprint) pointed to by
+   sig, which is the first 128 bits of it. */
+
+FD_FN_PURE static inline fd_sigcache_tag_t
+fd_sigcache_tag_from_sig( uchar const * sig ) {
+  fd_sigcache_tag_t tag = { .lo = fd_ulong_load_8_fast( sig ), .hi = fd_ulong_load_8_fast( sig+8UL ) };
+  return tag;
+}
+
+/* fd_sigcache_bucket returns the bucket that tag maps to. */
+
+FD_FN_PURE static inline fd_sigcache_bucket_t *
+fd_sigcache_bucket( fd_sigcache_t * cache,
+                    ulong           tag_lo ) {
+  return fd_sigcache_private_buckets( cache ) + (fd_ulong_hash( tag_lo ^ cache->seed ) & (cache->bucket_cnt-1UL));
+}
+
+/* fd_sigcache_private_match compares tag against all the slots in
+   bucket at time now.  Returns a bitmask with bit i set if slot i of
+   the bucket is live and holds tag.  Sets *_live to a bitmask with bit
+   i set if slot i is live. */
+
+FD_FN_PURE static inline uint
+fd_sigcache_private_match( fd_sigcache_bucket_t const * bucket,
+                           ulong                        tag_lo,
+                           ulong                        tag_hi,
+                           uint                         now,
+                           uint                         ttl,
+                           uint *                       _live ) {
+#if FD_HAS_AVX
+  /* Live is exp-now-1 < ttl as unsigned, which also rejects slots that
+     expired exactly now (exp-now-1 wraps to UINT_MAX). */
+  wu_t rem   = wu_sub( wu_ld( bucket->exp ), wu_bcast( now+1U ) );
+  uint live  = (uint)wc_pack( wu_lt( rem, wu_bcast( ttl ) ) );
+  uint hi    = (uint)wc_pack( wu_eq( wu_ld( bucket->hi ), wu_bcast( (uint)tag_hi ) ) );
+#if FD_HAS_AVX512
+  uint lo    = (uint)wwl_eq( wwl_ld( (long const *)bucket->lo ), wwl_bcast( (long)tag_lo ) );
+#else
+  /* Each 64-bit lane is all ones or all zeros, so the sign bit of
+     each lane gives the result. */
+  wl_t v_lo  = wl_bcast( (long)tag_lo );
+  uint lo    = (uint)_mm256_movemask_pd( _mm256_castsi256_pd( wl_eq( wl_ld( (long const *)bucket->lo     ), v_lo ) ) )
+             | ((uint)_mm256_movemask_pd( _mm256_castsi256_pd( wl_eq( wl_ld( (long const *)bucket->lo+4UL ), v_lo ) ) )<<4);
+#endif
+  *_live = live;
+  return live & hi & lo;
+#else
+  uint live  = 0U;
+  uint match = 0U;
+  for( ulong i=0UL; i<FD_SIGCACHE_BUCKET_WIDTH; i++ ) {
+    uint l = (uint)( bucket->exp[ i ]-now-1U < ttl );
+    live  |= l << i;
+    match |= (l & (uint)(bucket->lo[ i ]==tag_lo) & (uint)(bucket->hi[ i ]==(uint)tag_hi)) << i;
+  }
+  *_live = live;
+  return match;
+#endif
+}
+
+/* fd_sigcache_query returns 1 if tag is in the cache and has not
+   expired as of time now, and 0 otherwise.  Does not modify the cache.
+   Assumes cache is a valid local join. */
+
+FD_FN_PURE static inline int
+fd_sigcache_query( fd_sigcache_t const * cache,
+                   fd_sigcache_tag_t     tag,
+                   uint                  now ) {
+  fd_sigcache_bucket_t const * bucket = fd_sigcache_private_buckets_const( cache ) +
+                                        (fd_ulong_hash( tag.lo ^ cache->seed ) & (cache->bucket_cnt-1UL));
+  uint live;
+  return !!fd_sigcache_private_match( bucket, tag.lo, tag.hi, now, cache->ttl, &live );
+}
+
+/* fd_sigcache_insert inserts tag into the cache at time now, expiring
+   ttl time units later.  Returns 1 if tag was already in the cache and
+   not expired as of time now, in which case the cache is unchanged (in
+   particular, the expiration time of the existing tag is not extended,
+   as with fd_tcache).  Returns 0 if tag was inserted, possibly evicting
+   the oldest tag in the bucket.  Assumes cache is a valid local join
+   and now is not before the time of any earlier insert (modulo
+   wraparound). */
+
+static inline int
+fd_sigcache_insert( fd_sigcache_t *   cache,
+                    fd_sigcache_tag_t tag,
+                    uint              now ) {
+  fd_sigcache_bucket_t * bucket = fd_sigcache_bucket( cache, tag.lo );
+  uint ttl = cache->ttl;
+  uint live;
+  if( FD_UNLIKELY( fd_sigcache_private_match( bucket, tag.lo, tag.hi, now, ttl, &live ) ) ) return 1;
+
+  ulong slot;
+  uint  free = (~live) & ((1U<<FD_SIGCACHE_BUCKET_WIDTH)-1U);
+  if( FD_LIKELY( free ) ) {
+    slot = (ulong)fd_uint_find_lsb( free );
+  } else {
+    /* Bucket is full of live tags.  Evict the one that expires
+       soonest, which is the oldest. */
+    slot = 0UL;
+    for( ulong i=1UL; i<FD_SIGCACHE_BUCKET_WIDTH; i++ ) slot = fd_ulong_if( bucket->exp[ i ]-now<bucket->exp[ slot ]-now, i, slot );
+  }
+
+  bucket->lo [ slot ] = tag.lo;
+  bucket->hi [ slot ] = (uint)tag.hi;
+  bucket->exp[ slot ] = now+ttl;
+  return 0;
+}
+
+/* fd_sigcache_{query,insert}_batch do fd_sigcache_{query,insert} for
+   each of the cnt tags in tag, storing the results in out[ i ].  The
+   buckets for the batch are prefetched ahead of use, so with large
+   caches that don't fit in cache, this is substantially faster than
+   doing the operations one at a time.  Tags in the batch are processed
+   in order, so if the same tag appears twice in an insert batch, the
+   second one will be reported as a duplicate.  All tags in the batch
+   use the same time now. */
+
+void
+fd_sigcache_query_batch( fd_sigcache_t const *     cache,
+                         fd_sigcache_tag_t const * tag,
+                         ulong                     cnt,
+                         uint                      now,
+                         int *                     out );
+
+void
+fd_sigcache_insert_batch( fd_sigcache_t *           cache,
+                          fd_sigcache_tag_t const * tag,
+                          ulong                     cnt,
+                          uint                      now,
+                          int *                     out );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_sigcache_fd_sigcache_h */
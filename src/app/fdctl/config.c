@@ -187,6 +187,7 @@ static int parse_key_value( config_t *   config,
   ENTRY_STR   ( ., log,                 level_logfile                                             );
   ENTRY_STR   ( ., log,                 level_stderr                                              );
   ENTRY_STR   ( ., log,                 level_flush                                               );
+  ENTRY_BOOL  ( ., log,                 async                                                     );
 
   ENTRY_STR   ( ., ledger,              path                                                      );
   ENTRY_STR   ( ., ledger,              accounts_path                                             );
@@ -235,6 +236,7 @@ static int parse_key_value( config_t *   config,
   ENTRY_UINT  ( ., layout,              net_tile_count                                            );
   ENTRY_UINT  ( ., layout,              quic_tile_count                                           );
   ENTRY_UINT  ( ., layout,              verify_tile_count                                         );
+  ENTRY_UINT  ( ., layout,              dedup_tile_count                                          );
   ENTRY_UINT  ( ., layout,              bank_tile_count                                           );
   ENTRY_UINT  ( ., layout,              shred_tile_count                                          );
 
@@ -265,11 +267,14 @@ static int parse_key_value( config_t *   config,
   ENTRY_UINT  ( ., tiles.dedup,         signature_cache_size                                      );
 
   ENTRY_UINT  ( ., tiles.pack,          max_pending_transactions                                  );
+  ENTRY_UINT  ( ., tiles.pack,          schedule_lookahead                                        );
+  ENTRY_UINT  ( ., tiles.pack,          max_pending_per_fee_payer                                 );
 
   ENTRY_UINT  ( ., tiles.shred,         max_pending_shred_sets                                    );
   ENTRY_USHORT( ., tiles.shred,         shred_listen_port                                         );
 
   ENTRY_USHORT( ., tiles.metric,        prometheus_listen_port                                    );
+  ENTRY_UINT  ( ., tiles.metric,        trace_sample_rate                                         );
 
   ENTRY_BOOL  ( ., development,         sandbox                                                   );
   ENTRY_BOOL  ( ., development,         no_clone                                                  );
@@ -601,6 +606,10 @@ fdctl_obj_align( fd_topo_t const *     topo,
     return fd_fseq_align();
   } else if( FD_UNLIKELY( !strcmp( obj->name, "metrics" ) ) ) {
     return FD_METRICS_ALIGN;
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "trace" ) ) ) {
+    return fd_trace_align();
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "log" ) ) ) {
+    return fd_log_async_align();
   } else {
     FD_LOG_ERR(( "unknown object `%s`", obj->name ));
     return 0UL;
@@ -643,6 +652,10 @@ fdctl_obj_footprint( fd_topo_t const *     topo,
     return fd_fseq_footprint();
   } else if( FD_UNLIKELY( !strcmp( obj->name, "metrics" ) ) ) {
     return FD_METRICS_FOOTPRINT( VAL("in_cnt"), VAL("out_cnt") );
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "trace" ) ) ) {
+    return fd_trace_footprint( VAL("depth") );
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "log" ) ) ) {
+    return fd_log_async_footprint( VAL("depth") );
   } else {
     FD_LOG_ERR(( "unknown object `%s`", obj->name ));
     return 0UL;
@@ -1032,6 +1045,17 @@ config_parse( int *      pargc,
                                    config->scratch_directory ) );
   }
 
+  if( FD_UNLIKELY( config->tiles.metric.trace_sample_rate && !fd_uint_is_pow2( config->tiles.metric.trace_sample_rate ) ) )
+    FD_LOG_ERR(( "configuration specifies invalid [tiles.metric.trace_sample_rate] `%u`. "
+                 "This must be zero or a power of two",
+                 config->tiles.metric.trace_sample_rate ));
+
+  if( FD_UNLIKELY( !config->layout.dedup_tile_count || config->layout.dedup_tile_count>FD_TOPO_MAX_TILE_OUT_LINKS ) )
+    FD_LOG_ERR(( "configuration specifies invalid [layout.dedup_tile_count] `%u`. "
+                 "This must be in [1,%lu]",
+                 config->layout.dedup_tile_count,
+                 FD_TOPO_MAX_TILE_OUT_LINKS ));
+
   validate_ports( config );
   topo_initialize( config );
 }
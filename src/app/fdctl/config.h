@@ -46,6 +46,7 @@ typedef struct {
     int  level_stderr1;
     char level_flush[ 8 ];
     int  level_flush1;
+    int  async;
 
     /* File descriptor used for logging to the log file.  Stashed
        here for easy communication to child processes. */
@@ -121,6 +122,7 @@ typedef struct {
     uint net_tile_count;
     uint quic_tile_count;
     uint verify_tile_count;
+    uint dedup_tile_count;
     uint bank_tile_count;
     uint shred_tile_count;
   } layout;
@@ -214,6 +216,8 @@ typedef struct {
 
     struct {
       uint max_pending_transactions;
+      uint schedule_lookahead;
+      uint max_pending_per_fee_payer;
     } pack;
 
     struct {
@@ -223,6 +227,7 @@ typedef struct {
 
     struct {
       ushort prometheus_listen_port;
+      uint   trace_sample_rate;
     } metric;
 
     /* Firedancer-only tile configs */
@@ -59,6 +59,10 @@ fdctl_obj_new( fd_topo_t const *     topo,
     fd_fseq_new( laddr, ULONG_MAX );
   } else if( FD_UNLIKELY( !strcmp( obj->name, "metrics" ) ) ) {
     fd_metrics_new( laddr, VAL("in_cnt"), VAL("out_cnt") );
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "trace" ) ) ) {
+    FD_TEST( fd_trace_new( laddr, VAL("depth"), VAL("sample_rate") ) );
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "log" ) ) ) {
+    FD_TEST( fd_log_async_new( laddr, VAL("depth"), (int)VAL("enabled") ) );
   } else {
     FD_LOG_ERR(( "unknown object `%s`", obj->name ));
   }
@@ -69,6 +69,12 @@ typedef union {
     char pcap_path[ 256UL ];
   } dump;
 
+  struct {
+    char  json_path[ 256UL ];
+    long  duration_ns;
+    ulong max_records;
+  } trace;
+
   struct {
     char name[ 13UL ];
   } flame;
@@ -79,11 +79,55 @@ should_colorize( void ) {
   return 0;
 }
 
+/* link_consumer_numa_idx returns the NUMA node that most of the pinned
+   consumers of the link backed by object obj_id are on, or ULONG_MAX
+   if obj_id is not the mcache, dcache or reassembly buffer of a link,
+   or no consumer of it is pinned.  Ties go to the lowest node. */
+
+static ulong
+link_consumer_numa_idx( fd_topo_t const * topo,
+                        ulong             obj_id ) {
+  ulong votes[ FD_SHMEM_NUMA_MAX ] = {0};
+  int   found = 0;
+
+  for( ulong i=0UL; i<topo->link_cnt; i++ ) {
+    fd_topo_link_t const * link = &topo->links[ i ];
+    int backs_link = link->mcache_obj_id==obj_id ||
+                     ( link->is_reasm              && link->reasm_obj_id ==obj_id ) ||
+                     ( !link->is_reasm && link->mtu && link->dcache_obj_id==obj_id );
+    if( FD_LIKELY( !backs_link ) ) continue;
+
+    for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
+      fd_topo_tile_t const * tile = &topo->tiles[ j ];
+      if( FD_UNLIKELY( tile->cpu_idx==ULONG_MAX ) ) continue;
+      for( ulong k=0UL; k<tile->in_cnt; k++ ) {
+        if( FD_LIKELY( tile->in_link_id[ k ]!=i ) ) continue;
+        ulong numa_idx = fd_shmem_numa_idx( tile->cpu_idx );
+        FD_TEST( numa_idx!=ULONG_MAX );
+        votes[ numa_idx ]++;
+        found = 1;
+      }
+    }
+  }
+
+  if( FD_UNLIKELY( !found ) ) return ULONG_MAX;
+
+  ulong best = 0UL;
+  for( ulong i=1UL; i<FD_SHMEM_NUMA_MAX; i++ ) {
+    if( FD_UNLIKELY( votes[ i ]>votes[ best ] ) ) best = i;
+  }
+  return best;
+}
+
 static void
 initialize_numa_assignments( fd_topo_t * topo ) {
   /* Assign workspaces to NUMA nodes.  The heuristic here is pretty
-     simple for now: workspacess go on the NUMA node of the first
-     tile which maps the largest object in the workspace. */
+     simple for now: if the largest object in the workspace backs a
+     link, the workspace goes on the NUMA node of the link's consumers,
+     as they poll the mcache and read every fragment while the producer
+     only writes each one once.  Otherwise, workspacess go on the NUMA
+     node of the first tile which maps the largest object in the
+     workspace. */
 
   for( ulong i=0UL; i<topo->wksp_cnt; i++ ) {
     ulong max_footprint = 0UL;
@@ -101,6 +145,12 @@ initialize_numa_assignments( fd_topo_t * topo ) {
 
     if( FD_UNLIKELY( max_obj==ULONG_MAX ) ) FD_LOG_ERR(( "no object found for workspace %s", topo->workspaces[ i ].name ));
 
+    ulong link_numa_idx = link_consumer_numa_idx( topo, max_obj );
+    if( FD_LIKELY( link_numa_idx!=ULONG_MAX ) ) {
+      topo->workspaces[ i ].numa_idx = link_numa_idx;
+      continue;
+    }
+
     int found_strict = 0;
     int found_lazy   = 1;
     for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
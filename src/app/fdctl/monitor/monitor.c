@@ -167,7 +167,8 @@ link_snap( link_snap_t * snap_cur,
       fd_topo_link_t * link = &topo->links[ topo->tiles[ tile_idx ].in_link_id[ in_idx ] ];
       ulong producer_id = fd_topo_find_link_producer( topo, link );
       ulong const * out_metrics = NULL;
-      if( FD_LIKELY( producer_id!=ULONG_MAX && topo->tiles[ tile_idx ].in_link_reliable[ in_idx ] ) ) {
+      if( FD_LIKELY( producer_id!=ULONG_MAX && topo->tiles[ tile_idx ].in_link_reliable[ in_idx ] &&
+                     topo->tiles[ producer_id ].out_link_id_primary==link->id ) ) {
         fd_topo_tile_t * producer = &topo->tiles[ producer_id ];
         ulong out_idx = find_producer_out_idx( topo, producer, &topo->tiles[ tile_idx ], in_idx );
 
@@ -426,19 +427,25 @@ run_monitor( config_t * const config,
         fd_topo_tile_t const * verify = &topo->tiles[ fd_topo_find_tile( topo, "verify", i ) ];
         verify_overrun += fd_metrics_link_in( verify->metrics, 0UL )[ FD_METRICS_COUNTER_LINK_OVERRUN_POLLING_FRAG_COUNT_OFF ] / config->layout.verify_tile_count;
         verify_failed += fd_metrics_link_in( verify->metrics, 0UL )[ FD_METRICS_COUNTER_LINK_FILTERED_COUNT_OFF ];
-        verify_sent += fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ verify->out_link_id_primary ].mcache ) );
+        for( ulong j=0UL; j<verify->out_cnt; j++ ) {
+          verify_sent += fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ verify->out_link_id[ j ] ].mcache ) );
+        }
       }
 
-      fd_topo_tile_t const * dedup = &topo->tiles[ fd_topo_find_tile( topo, "dedup", 0UL ) ];
       ulong dedup_failed = 0UL;
-      for( ulong i=0UL; i<config->layout.verify_tile_count; i++) {
-        dedup_failed += fd_metrics_link_in( dedup->metrics, i )[ FD_METRICS_COUNTER_LINK_FILTERED_COUNT_OFF ];
+      ulong dedup_sent   = 0UL;
+      for( ulong i=0UL; i<config->layout.dedup_tile_count; i++ ) {
+        fd_topo_tile_t const * dedup = &topo->tiles[ fd_topo_find_tile( topo, "dedup", i ) ];
+        for( ulong j=0UL; j<dedup->in_cnt; j++ ) {
+          dedup_failed += fd_metrics_link_in( dedup->metrics, j )[ FD_METRICS_COUNTER_LINK_FILTERED_COUNT_OFF ];
+        }
+        dedup_sent += fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ dedup->out_link_id_primary ].mcache ) );
       }
-      ulong dedup_sent = fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ dedup->out_link_id_primary ].mcache ) );
 
       fd_topo_tile_t const * pack = &topo->tiles[ fd_topo_find_tile( topo, "pack", 0UL ) ];
       ulong * pack_metrics = fd_metrics_tile( pack->metrics );
-      ulong pack_invalid = pack_metrics[ FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_OFF ] +
+      ulong pack_invalid = pack_metrics[ FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FEE_PAYER_CAP_OFF ] +
+                          pack_metrics[ FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_FULL_OFF ] +
                           pack_metrics[ FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_WRITE_SYSVAR_OFF ] +
                           pack_metrics[ FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_ESTIMATION_FAIL_OFF ] +
                           pack_metrics[ FD_METRICS_COUNTER_PACK_TRANSACTION_INSERTED_TOO_LARGE_OFF ] +
@@ -18,6 +18,11 @@ typedef struct {
 
   void const * _bank;
 
+  /* bundle_failed: non-zero if a microblock of the bundle currently
+     being executed has failed, in which case the rest of the bundle is
+     skipped. */
+  int bundle_failed;
+
   fd_wksp_t * pack_in_mem;
   ulong       pack_in_chunk0;
   ulong       pack_in_wmark;
@@ -170,9 +175,17 @@ after_frag( void *             _ctx,
 
   ulong txn_cnt = (*opt_sz-sizeof(fd_microblock_bank_trailer_t))/sizeof(fd_txn_p_t);
 
+  /* Pack hands out a bundle as consecutive microblocks to this bank
+     tile, with BUNDLE_START on the first transaction.  Once one of them
+     fails, the rest of the bundle is not executed at all. */
+  uint  first_flags = txn_cnt ? ((fd_txn_p_t *)dst)->flags : 0U;
+  int   bundle      = !!(first_flags & FD_TXN_P_FLAGS_BUNDLE);
+  if( FD_UNLIKELY( first_flags & FD_TXN_P_FLAGS_BUNDLE_START ) ) ctx->bundle_failed = 0;
+  ulong exec_cnt    = fd_ulong_if( bundle & ctx->bundle_failed, 0UL, txn_cnt );
+
   ulong sanitized_txn_cnt = 0UL;
   ulong sidecar_footprint_bytes = 0UL;
-  for( ulong i=0UL; i<txn_cnt; i++ ) {
+  for( ulong i=0UL; i<exec_cnt; i++ ) {
     fd_txn_p_t * txn = (fd_txn_p_t *)( dst + (i*sizeof(fd_txn_p_t)) );
 
     void * abi_txn = ctx->txn_abi_mem + (sanitized_txn_cnt*FD_BANK_ABI_TXN_FOOTPRINT);
@@ -205,6 +218,7 @@ after_frag( void *             _ctx,
                                                                       executed_results );
 
   ulong sanitized_idx = 0UL;
+  ulong succeeded_cnt = 0UL;
   for( ulong i=0; i<txn_cnt; i++ ) {
     fd_txn_p_t * txn = (fd_txn_p_t *)( dst + (i*sizeof(fd_txn_p_t)) );
     if( FD_UNLIKELY( !(txn->flags & FD_TXN_P_FLAGS_SANITIZE_SUCCESS) ) ) continue;
@@ -218,15 +232,28 @@ after_frag( void *             _ctx,
 
     ctx->metrics.txn_executed[ executed_results[ sanitized_idx-1 ] ]++;
     txn->flags |= FD_TXN_P_FLAGS_EXECUTE_SUCCESS;
+    succeeded_cnt += (ulong)!executed_results[ sanitized_idx-1 ];
   }
 
-  /* Commit must succeed so no failure path.  This function takes
-      ownership of the load_and_execute_output and pre_balance_info heap
-      allocations and will free them before it returns.  They should not
-      be reused.  Once commit is called, the transactions MUST be mixed
-      into the PoH otherwise we will fork and diverge, so the link from
-      here til PoH mixin must be completely reliable with nothing dropped. */
-  fd_ext_bank_commit_txns( ctx->_bank, ctx->txn_abi_mem, sanitized_txn_cnt, load_and_execute_output, pre_balance_info );
+  /* A microblock of a bundle is committed only if every transaction in
+     it succeeded.  Otherwise nothing in it is committed, and the
+     transactions are published as not executed so that PoH and pack
+     account for them.  Earlier microblocks of the bundle have already
+     been committed and can't be rolled back. */
+  if( FD_UNLIKELY( bundle & (succeeded_cnt<txn_cnt) ) ) {
+    fd_ext_bank_release_thunks( load_and_execute_output );
+    fd_ext_bank_release_pre_balance_info( pre_balance_info );
+    for( ulong i=0UL; i<txn_cnt; i++ ) ((fd_txn_p_t *)( dst + (i*sizeof(fd_txn_p_t)) ))->flags &= ~FD_TXN_P_FLAGS_EXECUTE_SUCCESS;
+    ctx->bundle_failed = 1;
+  } else {
+    /* Commit must succeed so no failure path.  This function takes
+       ownership of the load_and_execute_output and pre_balance_info heap
+       allocations and will free them before it returns.  They should not
+       be reused.  Once commit is called, the transactions MUST be mixed
+       into the PoH otherwise we will fork and diverge, so the link from
+       here til PoH mixin must be completely reliable with nothing dropped. */
+    fd_ext_bank_commit_txns( ctx->_bank, ctx->txn_abi_mem, sanitized_txn_cnt, load_and_execute_output, pre_balance_info );
+  }
   pre_balance_info        = NULL;
   load_and_execute_output = NULL;
 
@@ -269,6 +296,7 @@ unprivileged_init( fd_topo_t *      topo,
       __x; }))
 
   ctx->kind_id = tile->kind_id;
+  ctx->bundle_failed = 0;
   ctx->blake3 = NONNULL( fd_blake3_join( fd_blake3_new( blake3 ) ) );
   ctx->bmtree = NONNULL( bmtree );
 
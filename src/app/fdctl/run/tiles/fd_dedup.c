@@ -2,6 +2,7 @@
 
 #include "generated/dedup_seccomp.h"
 #include <linux/unistd.h>
+#include <sys/random.h>
 
 /* fd_dedup provides services to deduplicate multiple streams of input
    fragments and present them to a mix of reliable and unreliable
@@ -10,7 +11,34 @@
 
    The dedup tile is simply a wrapper around the mux tile, that also
    checks the transaction signature field for duplicates and filters
-   them out. */
+   them out.
+
+   There can be multiple dedup tiles.  Transactions are sharded among
+   them by a seeded hash of their signature, but the hashing is done by
+   the verify tiles: every verify tile has a link to every dedup tile,
+   and publishes each transaction only to the link of its shard.  So
+   each dedup tile sees every copy of the transactions in its shard, the
+   sigcaches of the dedup tiles are disjoint, and each frag is only
+   polled by one dedup tile.
+
+   Duplicates are detected by the first 128 bits of the transaction's
+   first signature, which are remembered for DEDUP_TAG_LIFETIME_NS.
+   This is longer than a transaction can be valid for, so a transaction
+   is only let through twice if the sigcache had to evict it early to
+   make room for newer ones. */
+
+/* DEDUP_TAG_LIFETIME_NS is how long a signature is remembered for.  A
+   transaction's recent blockhash expires after 150 slots, which is
+   about 60 seconds, so there is no need to remember it much longer. */
+
+#define DEDUP_TAG_LIFETIME_NS (120L*1000L*1000L*1000L)
+
+/* The sigcache keeps 32-bit times, so time is measured in units of
+   2^DEDUP_TIME_LG_TICKS ticks (about 20 us at 3 GHz).  This wraps
+   around about once a day, and the tag lifetime is a few million
+   units, which is much less than that as the sigcache wants. */
+
+#define DEDUP_TIME_LG_TICKS (16)
 
 /* fd_dedup_in_ctx_t is a context object for each in (producer) mcache
    connected to the dedup tile. */
@@ -25,11 +53,8 @@ typedef struct {
    mux tile, and contains all state needed to progress the tile. */
 
 typedef struct {
-  ulong   tcache_depth;   /* == fd_tcache_depth( tcache ), depth of this dedups's tcache (const) */
-  ulong   tcache_map_cnt; /* == fd_tcache_map_cnt( tcache ), number of slots to use for tcache map (const) */
-  ulong * tcache_sync;    /* == fd_tcache_oldest_laddr( tcache ), local join to the oldest key in the tcache */
-  ulong * tcache_ring;
-  ulong * tcache_map;
+  ulong           sigcache_seed;
+  fd_sigcache_t * sigcache;
 
   fd_dedup_in_ctx_t in[ 64UL ];
 
@@ -49,7 +74,7 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
   (void)tile;
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
-  l = FD_LAYOUT_APPEND( l, fd_tcache_align(), fd_tcache_footprint( tile->dedup.tcache_depth, 0 ) );
+  l = FD_LAYOUT_APPEND( l, fd_sigcache_align(), fd_sigcache_footprint( fd_sigcache_bucket_cnt_default( tile->dedup.sigcache_depth ) ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -121,9 +146,21 @@ after_frag( void *             _ctx,
 
   fd_dedup_ctx_t * ctx = (fd_dedup_ctx_t *)_ctx;
 
-  int is_dup;
-  FD_TCACHE_INSERT( is_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, *opt_sig );
-  *opt_filter = is_dup;
+  /* The frag was copied to the out dcache in during_frag.  Verify has
+     appended the parsed fd_txn_t and payload_sz after the payload, so
+     find the first signature through those.
+
+          Payload ....... (payload_sz bytes)
+          0 or 1 byte of padding (since alignof(fd_txn) is 2)
+          fd_txn ....... (size computed by fd_txn_footprint)
+          payload_sz  (2B) */
+  uchar const *    dcache_entry = fd_chunk_to_laddr_const( ctx->out_mem, ctx->out_chunk );
+  ulong            payload_sz   = *(ushort const *)(dcache_entry + *opt_sz - sizeof(ushort));
+  fd_txn_t const * txn          = (fd_txn_t const *)( dcache_entry + fd_ulong_align_up( payload_sz, 2UL ) );
+  fd_sigcache_tag_t tag         = fd_sigcache_tag_from_sig( dcache_entry + txn->signature_off );
+
+  uint now = (uint)( (ulong)fd_tickcount() >> DEDUP_TIME_LG_TICKS );
+  *opt_filter = fd_sigcache_insert( ctx->sigcache, tag, now );
   if( FD_LIKELY( !*opt_filter ) ) {
     *opt_chunk     = ctx->out_chunk;
     *opt_sig       = 0; /* indicate this txn is coming from dedup, and has already been parsed */
@@ -131,20 +168,33 @@ after_frag( void *             _ctx,
   }
 }
 
+static void
+privileged_init( fd_topo_t *      topo,
+                 fd_topo_tile_t * tile,
+                 void *           scratch ) {
+  (void)topo;
+  (void)tile;
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_dedup_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
+
+  /* The seed keeps transaction senders from choosing signatures that
+     all land in the same sigcache bucket to evict other signatures. */
+  FD_TEST( sizeof(ulong) == getrandom( &ctx->sigcache_seed, sizeof(ulong), 0 ) );
+}
+
 static void
 unprivileged_init( fd_topo_t *      topo,
                    fd_topo_tile_t * tile,
                    void *           scratch ) {
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_dedup_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
-  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, FD_TCACHE_ALIGN, fd_tcache_footprint( tile->dedup.tcache_depth, 0) ), tile->dedup.tcache_depth, 0 ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_new failed" ));
-
-  ctx->tcache_depth   = fd_tcache_depth       ( tcache );
-  ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
-  ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
-  ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+  ulong bucket_cnt = fd_sigcache_bucket_cnt_default( tile->dedup.sigcache_depth );
+  if( FD_UNLIKELY( !bucket_cnt ) ) FD_LOG_ERR(( "invalid signature cache size %lu", tile->dedup.sigcache_depth ));
+  ulong ttl = ((ulong)(fd_tempo_tick_per_ns( NULL )*(double)DEDUP_TAG_LIFETIME_NS + 0.5) >> DEDUP_TIME_LG_TICKS) + 1UL;
+  void * _sigcache = FD_SCRATCH_ALLOC_APPEND( l, fd_sigcache_align(), fd_sigcache_footprint( bucket_cnt ) );
+  ctx->sigcache = fd_sigcache_join( fd_sigcache_new( _sigcache, bucket_cnt, ctx->sigcache_seed, (uint)fd_ulong_min( ttl, FD_SIGCACHE_TTL_MAX ) ) );
+  if( FD_UNLIKELY( !ctx->sigcache ) ) FD_LOG_ERR(( "fd_sigcache_new failed" ));
 
   FD_TEST( tile->in_cnt<=sizeof( ctx->in )/sizeof( ctx->in[ 0 ] ) );
   for( ulong i=0; i<tile->in_cnt; i++ ) {
@@ -200,6 +250,6 @@ fd_topo_run_tile_t fd_tile_dedup = {
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
   .scratch_footprint        = scratch_footprint,
-  .privileged_init          = NULL,
+  .privileged_init          = privileged_init,
   .unprivileged_init        = unprivileged_init,
 };
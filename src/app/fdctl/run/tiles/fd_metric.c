@@ -17,15 +17,41 @@
 
 /* The metric tile reads metrics updates from other tiles, maybe
    presents them on a local HTTP endpoint, and maybe uploads them to
-   a server InfluxDB endpoint. */
+   a server InfluxDB endpoint.
+
+   Rendering the text exposition for every tile and link is expensive,
+   so it is not done when a request comes in.  Instead, the exposition
+   is rendered every RENDER_INTERVAL_NS into one of two buffers, and
+   requests are answered from whichever was most recently completed.
+   A connection that is still writing out a buffer pins it, and the
+   next render is delayed rather than overwrite it, so a response is
+   always one consistent snapshot.  Connections are closed if they are
+   still open CONN_TIMEOUT_NS after they were accepted, so a stalled or
+   slow scraper can only delay rendering that long.
+
+   The metric tile also drains the deferred log rings of every tile
+   (see fd_log_async.h), up to LOG_DRAIN_MAX records from each per
+   iteration so a noisy tile does not stall the HTTP endpoint. */
+
+#define RENDER_INTERVAL_NS (250L*1000L*1000L)
+#define EXPOSITION_MAX     (16777216UL)
+#define CONN_TIMEOUT_NS    (5L*1000L*1000L*1000L)
+#define LOG_DRAIN_MAX      (64UL)
 
 typedef struct {
   ulong bytes_read;
   char input[ 1024UL ];
 
-  ulong output_len;
-  char output[ 16777216UL ];
+  char   header[ 128UL ]; /* HTTP response status line and headers */
+  ulong  header_len;
+  char * body;            /* Response body, points into an exposition buffer, or NULL */
+  ulong  body_len;
+  ulong  expo_idx;        /* Index of the exposition buffer this connection is reading, or ULONG_MAX */
+
+  ulong output_len;       /* header_len+body_len */
   ulong bytes_written;
+
+  long  deadline_ticks;   /* Connection is closed if still open at this time */
 } fd_metric_connection_t;
 
 typedef struct {
@@ -37,6 +63,18 @@ typedef struct {
   struct pollfd            fds[ MAX_CONNS+1 ];
 
   ulong conn_id;
+
+  ulong expo_front;          /* Index of the most recently rendered exposition, or ULONG_MAX if there is none */
+  ulong expo_len    [ 2 ];
+  ulong expo_readers[ 2 ];   /* Number of connections writing out each exposition */
+  long  next_render_ticks;
+  long  render_interval_ticks;
+  long  conn_timeout_ticks;
+
+  fd_histf_t render_duration[ 1 ];
+  fd_histf_t render_size    [ 1 ];
+
+  char expo[ 2 ][ EXPOSITION_MAX ];
 } fd_metric_ctx_t;
 
 FD_FN_CONST static inline ulong
@@ -63,6 +101,12 @@ close_conn( fd_metric_ctx_t * ctx,
   if( FD_UNLIKELY( -1==close( ctx->fds[ idx ].fd ) ) ) FD_LOG_ERR(( "close failed (%i-%s)", errno, strerror( errno ) ));
   ctx->fds[ idx ].fd = -1;
   ctx->conns[ idx ].bytes_read = 0UL;
+
+  ulong expo_idx = ctx->conns[ idx ].expo_idx;
+  if( FD_LIKELY( expo_idx!=ULONG_MAX ) ) {
+    ctx->expo_readers[ expo_idx ]--;
+    ctx->conns[ idx ].expo_idx = ULONG_MAX;
+  }
 }
 
 static void
@@ -82,9 +126,11 @@ accept_conns( fd_metric_ctx_t * ctx ) {
 
     ctx->fds[ ctx->conn_id ].fd = fd;
     ctx->conns[ ctx->conn_id ] = (fd_metric_connection_t){
-      .bytes_read    = 0UL,
-      .bytes_written = 0UL,
-      .output_len    = 0UL,
+      .bytes_read     = 0UL,
+      .bytes_written  = 0UL,
+      .output_len     = 0UL,
+      .expo_idx       = ULONG_MAX,
+      .deadline_ticks = fd_tickcount() + ctx->conn_timeout_ticks,
     };
     ctx->conn_id = (ctx->conn_id + 1) % MAX_CONNS;
   }
@@ -234,14 +280,6 @@ prometheus_print( fd_topo_t * topo,
                   ulong *     out_len ) {
   ulong start_len = *out_len;
 
-  PRINT( "HTTP/1.1 200 OK\r\nContent-Length: " );
-  char * content_len = *out;
-
-  /* Stuff a bunch of whitespace so we can replace with the real Content-Length later.
-     Enough whitespace to print ULONG_MAX. */
-  PRINT( "                     \r\nContent-Type: text/plain; version=0.0.4\r\n\r\n" );
-  ulong content_start = (ulong)(start_len - *out_len);
-
   long result = prometheus_print1( topo, out, out_len, NULL, FD_METRICS_ALL_TOTAL, FD_METRICS_ALL, PRINT_TILE );
   if( FD_UNLIKELY( result<0 ) ) return result;
   PRINT( "\n" );
@@ -250,30 +288,55 @@ prometheus_print( fd_topo_t * topo,
   PRINT( "\n" );
   result = prometheus_print1( topo, out, out_len, NULL, FD_METRICS_ALL_LINK_OUT_TOTAL, FD_METRICS_ALL_LINK_OUT, PRINT_LINK_OUT );
   if( FD_UNLIKELY( result<0 ) ) return result;
-  PRINT( "\n" );
-  result = prometheus_print1( topo, out, out_len, "quic", FD_METRICS_QUIC_TOTAL, FD_METRICS_QUIC, PRINT_TILE );
-  if( FD_UNLIKELY( result<0 ) ) return result;
-  PRINT( "\n" );
-  result = prometheus_print1( topo, out, out_len, "pack", FD_METRICS_PACK_TOTAL, FD_METRICS_PACK, PRINT_TILE );
-  if( FD_UNLIKELY( result<0 ) ) return result;
-  PRINT( "\n" );
-  result = prometheus_print1( topo, out, out_len, "bank", FD_METRICS_BANK_TOTAL, FD_METRICS_BANK, PRINT_TILE );
-  if( FD_UNLIKELY( result<0 ) ) return result;
-  PRINT( "\n" );
-  result = prometheus_print1( topo, out, out_len, "poh", FD_METRICS_POH_TOTAL, FD_METRICS_POH, PRINT_TILE );
-  if( FD_UNLIKELY( result<0 ) ) return result;
-  PRINT( "\n" );
-  result = prometheus_print1( topo, out, out_len, "shred", FD_METRICS_SHRED_TOTAL, FD_METRICS_SHRED, PRINT_TILE );
-  if( FD_UNLIKELY( result<0 ) ) return result;
-  PRINT( "\n" );
-  result = prometheus_print1( topo, out, out_len, "store", FD_METRICS_STORE_TOTAL, FD_METRICS_STORE, PRINT_TILE );
-  if( FD_UNLIKELY( result<0 ) ) return result;
 
-  /* Now backfill Content-Length */
-  ulong printed;
-  if( FD_UNLIKELY( !fd_cstr_printf_check( content_len, 21, &printed, "%lu", start_len - *out_len - content_start ) ) ) return -1;
-  content_len[ printed ] = ' '; /* Clear NUL terminator */
+  for( ulong i=0UL; i<FD_METRICS_TILE_KIND_CNT; i++ ) {
+    if( FD_UNLIKELY( !FD_METRICS_TILE_KIND_SIZES[ i ] ) ) continue;
+    PRINT( "\n" );
+    result = prometheus_print1( topo, out, out_len, FD_METRICS_TILE_KIND_NAMES[ i ], FD_METRICS_TILE_KIND_SIZES[ i ], FD_METRICS_TILE_KIND_METRICS[ i ], PRINT_TILE );
+    if( FD_UNLIKELY( result<0 ) ) return result;
+  }
+
+  return (long)(start_len - *out_len);
+}
+
+/* render renders the exposition into the buffer that is not the most
+   recent one, and makes it the most recent one.  If a connection is
+   still writing out that buffer, the render is delayed. */
+
+static void
+render( fd_metric_ctx_t * ctx ) {
+  ulong back = fd_ulong_if( ctx->expo_front==0UL, 1UL, 0UL );
+  if( FD_UNLIKELY( ctx->expo_readers[ back ] ) ) {
+    FD_MCNT_INC( METRIC_TILE, RENDER_SKIPPED_COUNT, 1UL );
+    return;
+  }
+
+  long render_duration = -fd_tickcount();
+
+  char * out     = ctx->expo[ back ];
+  ulong  out_len = EXPOSITION_MAX;
+  long   printed = prometheus_print( ctx->topo, &out, &out_len );
+
+  render_duration += fd_tickcount();
+
+  if( FD_UNLIKELY( printed<0 ) ) {
+    FD_LOG_WARNING(( "unable to render metrics, exposition larger than %lu bytes", EXPOSITION_MAX ));
+    return;
+  }
 
+  ctx->expo_len[ back ] = (ulong)printed;
+  ctx->expo_front       = back;
+
+  fd_histf_sample( ctx->render_duration, (ulong)render_duration );
+  fd_histf_sample( ctx->render_size,     (ulong)printed         );
+}
+
+static long
+http_200_print( char ** out,
+                ulong * out_len,
+                ulong   content_len ) {
+  ulong start_len = *out_len;
+  PRINT( "HTTP/1.1 200 OK\r\nContent-Length: %lu\r\nContent-Type: text/plain; version=0.0.4\r\n\r\n", content_len );
   return (long)(start_len - *out_len);
 }
 
@@ -339,18 +402,25 @@ read_conn( fd_metric_ctx_t * ctx,
     return;
   }
 
-  char * out = conn->output;
-  ulong out_len = sizeof( conn->output );
+  char * out = conn->header;
+  ulong out_len = sizeof( conn->header );
 
   /* Well formed request, process it */
   int valid = method_len==3 && !strncmp( method, "GET", method_len ) && path_len==8 && !strncmp( path, "/metrics", path_len );
   long printed = 0;
+  conn->body     = NULL;
+  conn->body_len = 0UL;
   if( FD_UNLIKELY( !valid ) ) printed = http_404_print( &out, &out_len );
+  else if( FD_UNLIKELY( ctx->expo_front==ULONG_MAX ) ) printed = http_400_print( &out, &out_len ); /* Could not render */
   else {
-    printed = prometheus_print( ctx->topo, &out, &out_len );
-    if( FD_UNLIKELY( -1==printed ) ) {
-      FD_LOG_WARNING(( "unable to print metrics to HTTP endpoint" ));
-      printed = http_400_print( &out, &out_len );
+    ulong front = ctx->expo_front;
+    printed = http_200_print( &out, &out_len, ctx->expo_len[ front ] );
+    if( FD_LIKELY( -1!=printed ) ) {
+      conn->body     = ctx->expo[ front ];
+      conn->body_len = ctx->expo_len[ front ];
+      conn->expo_idx = front;
+      ctx->expo_readers[ front ]++;
+      FD_MCNT_INC( METRIC_TILE, SCRAPE_COUNT, 1UL );
     }
   }
 
@@ -361,7 +431,8 @@ read_conn( fd_metric_ctx_t * ctx,
   }
 
   conn->bytes_read = ULONG_MAX; /* Mark connection as ready to write, no longer readable. */
-  conn->output_len = (ulong)printed;
+  conn->header_len = (ulong)printed;
+  conn->output_len = conn->header_len + conn->body_len;
   conn->bytes_written = 0UL;
 }
 
@@ -371,7 +442,17 @@ write_conn( fd_metric_ctx_t *        ctx,
   fd_metric_connection_t * conn = &ctx->conns[ idx ];
   if( FD_UNLIKELY( conn->bytes_read!=ULONG_MAX ) ) return; /* No data staged for write yet. */
 
-  long sz = write( ctx->fds[ idx ].fd, conn->output + conn->bytes_written, conn->output_len - conn->bytes_written );
+  char const * src;
+  ulong        src_len;
+  if( FD_LIKELY( conn->bytes_written<conn->header_len ) ) {
+    src     = conn->header + conn->bytes_written;
+    src_len = conn->header_len - conn->bytes_written;
+  } else {
+    src     = conn->body + (conn->bytes_written - conn->header_len);
+    src_len = conn->output_len - conn->bytes_written;
+  }
+
+  long sz = write( ctx->fds[ idx ].fd, src, src_len );
   if( FD_UNLIKELY( -1==sz && (errno==EAGAIN || errno==EINTR) ) ) return; /* No data to write, continue. */
   if( FD_UNLIKELY( -1==sz && (errno==EPIPE || errno==ECONNRESET) ) ) {
     close_conn( ctx, idx ); /* Peer closed connection */
@@ -385,6 +466,14 @@ write_conn( fd_metric_ctx_t *        ctx,
   }
 }
 
+static void
+metrics_write( void * _ctx ) {
+  fd_metric_ctx_t * ctx = (fd_metric_ctx_t *)_ctx;
+
+  FD_MHIST_COPY( METRIC_TILE, RENDER_DURATION_SECONDS, ctx->render_duration );
+  FD_MHIST_COPY( METRIC_TILE, RENDER_SIZE_BYTES,       ctx->render_size     );
+}
+
 static void
 before_credit( void *             _ctx,
                fd_mux_context_t * mux ) {
@@ -392,6 +481,21 @@ before_credit( void *             _ctx,
 
   fd_metric_ctx_t * ctx = (fd_metric_ctx_t *)_ctx;
 
+  for( ulong i=0UL; i<ctx->topo->tile_cnt; i++ ) fd_log_async_drain( ctx->topo->tiles[ i ].log_async, LOG_DRAIN_MAX );
+
+  long now = fd_tickcount();
+  if( FD_UNLIKELY( now>=ctx->next_render_ticks ) ) {
+    /* Drop connections that ran out of time before rendering, so that
+       they do not keep pinning an exposition buffer. */
+    for( ulong i=0UL; i<MAX_CONNS; i++ ) {
+      if( FD_LIKELY( -1==ctx->fds[ i ].fd || now<ctx->conns[ i ].deadline_ticks ) ) continue;
+      close_conn( ctx, i );
+      FD_MCNT_INC( METRIC_TILE, SCRAPE_TIMEOUT_COUNT, 1UL );
+    }
+    render( ctx );
+    ctx->next_render_ticks = now + ctx->render_interval_ticks;
+  }
+
   int nfds = poll( ctx->fds, MAX_CONNS+1, 0 );
   if( FD_UNLIKELY( 0==nfds ) ) return;
   else if( FD_UNLIKELY( -1==nfds && errno==EINTR ) ) return;
@@ -451,8 +555,21 @@ unprivileged_init( fd_topo_t *      topo,
   for( ulong i=0; i<MAX_CONNS; i++ ) {
     ctx->fds[ i ].fd = -1;
     ctx->fds[ i ].events = POLLIN | POLLOUT;
+    ctx->conns[ i ].expo_idx = ULONG_MAX;
   }
 
+  ctx->expo_front              = ULONG_MAX;
+  ctx->expo_readers[ 0 ]       = 0UL;
+  ctx->expo_readers[ 1 ]       = 0UL;
+  ctx->next_render_ticks       = 0L; /* Render right away */
+  ctx->render_interval_ticks   = (long)(fd_tempo_tick_per_ns( NULL )*(double)RENDER_INTERVAL_NS + 0.5);
+  ctx->conn_timeout_ticks      = (long)(fd_tempo_tick_per_ns( NULL )*(double)CONN_TIMEOUT_NS + 0.5);
+
+  fd_histf_join( fd_histf_new( ctx->render_duration, FD_MHIST_SECONDS_MIN( METRIC_TILE, RENDER_DURATION_SECONDS ),
+                                                     FD_MHIST_SECONDS_MAX( METRIC_TILE, RENDER_DURATION_SECONDS ) ) );
+  fd_histf_join( fd_histf_new( ctx->render_size,     FD_MHIST_MIN( METRIC_TILE, RENDER_SIZE_BYTES ),
+                                                     FD_MHIST_MAX( METRIC_TILE, RENDER_SIZE_BYTES ) ) );
+
   ctx->fds[ MAX_CONNS ].fd = ctx->socket_fd;
   ctx->fds[ MAX_CONNS ].events = POLLIN | POLLOUT;
 
@@ -498,6 +615,7 @@ fd_topo_run_tile_t fd_tile_metric = {
   .rlimit_file_cnt          = MAX_CONNS+5UL, /* pipefd, socket, stderr, logfile, and one spare for new accept() connections */
   .mux_ctx                  = mux_ctx,
   .mux_before_credit        = before_credit,
+  .mux_metrics_write        = metrics_write,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
@@ -14,7 +14,15 @@
    multiple microblocks can execute in parallel, if they don't
    write to the same accounts. */
 
-#define POH_IN_IDX (2UL)
+/* Pack reads from several kinds of in links, which are told apart by
+   the name of the link at startup, since the number of each kind
+   depends on the layout.  IN_KIND_TXN links (dedup_pack, gossip_pack)
+   carry transactions to insert, the IN_KIND_POH link carries leader
+   transitions, and IN_KIND_BANK links (bank_poh) carry the execution
+   results for the microblocks pack scheduled. */
+#define IN_KIND_TXN  (0)
+#define IN_KIND_POH  (1)
+#define IN_KIND_BANK (2)
 
 #define MAX_SLOTS_PER_EPOCH          432000UL
 
@@ -82,6 +90,7 @@ FD_IMPORT( wait_duration, "src/ballet/pack/pack_delay.bin", ulong, 6, "" );
 
 
 typedef struct {
+  int         kind;
   fd_wksp_t * mem;
   ulong       chunk0;
   ulong       wmark;
@@ -156,6 +165,13 @@ typedef struct {
 
   fd_pack_in_ctx_t in[ 32 ];
 
+  /* The executed transactions reported by a bank tile are copied here
+     in during_frag, and are passed to fd_pack_rebate_cus in
+     after_frag. */
+  ulong      rebate_slot;
+  ulong      rebate_txn_cnt;
+  fd_txn_p_t rebate_txns[ MAX_TXN_PER_MICROBLOCK ];
+
   ulong    bank_cnt;
   ulong    bank_idle_bitset; /* bit i is 1 if we've observed *bank_current[i]==bank_expect[i] */
   int      poll_cursor; /* in [0, bank_cnt), the next bank to poll */
@@ -165,6 +181,18 @@ typedef struct {
      least bank_ready_at[x]. */
   long     bank_ready_at[ FD_PACK_PACK_MAX_OUT  ];
 
+  /* conflict_idle_begin is the tickcount at which pack first failed to
+     schedule anything for an idle bank tile even though it had
+     transactions available, or 0 if the most recent attempt succeeded.
+     conflict_idle_bank_cnt is the number of idle bank tiles at that
+     time.  conflict_idle_ticks accumulates the product of the two,
+     and is reported in nanoseconds via the BankConflictIdleNanos
+     metric. */
+  long     conflict_idle_begin;
+  ulong    conflict_idle_bank_cnt;
+  ulong    conflict_idle_ticks;
+  double   ns_per_tick;
+
   fd_wksp_t * out_mem;
   ulong       out_chunk0;
   ulong       out_wmark;
@@ -202,6 +230,16 @@ update_metric_state( fd_pack_ctx_t * ctx,
   }
 }
 
+/* Closes out the current period during which idle bank tiles couldn't
+   be given any work, if there is one. */
+static inline void
+end_conflict_idle( fd_pack_ctx_t * ctx,
+                   long            now ) {
+  if( FD_UNLIKELY( ctx->conflict_idle_begin ) ) {
+    ctx->conflict_idle_ticks += (ulong)fd_long_max( now-ctx->conflict_idle_begin, 0L )*ctx->conflict_idle_bank_cnt;
+    ctx->conflict_idle_begin  = 0L;
+  }
+}
 
 FD_FN_CONST static inline ulong
 scratch_align( void ) {
@@ -241,6 +279,7 @@ metrics_write( void * _ctx ) {
 
   FD_MCNT_ENUM_COPY( PACK, TRANSACTION_INSERTED,          ctx->insert_result  );
   FD_MCNT_ENUM_COPY( PACK, METRIC_TIMING,        ((ulong*)ctx->metric_timing) );
+  FD_MCNT_SET( PACK, BANK_CONFLICT_IDLE_NANOS, (ulong)((double)ctx->conflict_idle_ticks*ctx->ns_per_tick) );
   FD_MHIST_COPY( PACK, SCHEDULE_MICROBLOCK_DURATION_SECONDS, ctx->schedule_duration );
   FD_MHIST_COPY( PACK, INSERT_TRANSACTION_DURATION_SECONDS,  ctx->insert_duration   );
 }
@@ -332,6 +371,7 @@ after_credit( void *             _ctx,
     ctx->leader_slot         = ULONG_MAX;
     ctx->slot_microblock_cnt = 0UL;
     fd_pack_end_block( ctx->pack );
+    end_conflict_idle( ctx, now );
     update_metric_state( ctx, now, FD_PACK_METRIC_STATE_LEADER,       0 );
     update_metric_state( ctx, now, FD_PACK_METRIC_STATE_BANKS,        0 );
     update_metric_state( ctx, now, FD_PACK_METRIC_STATE_MICROBLOCKS,  0 );
@@ -368,6 +408,11 @@ after_credit( void *             _ctx,
 
     int i               = fd_ulong_find_lsb( ctx->bank_idle_bitset );
 
+    /* The rest of a bundle can only go to the bank tile that got its
+       first microblock, so that one goes first whenever it is idle. */
+    ulong bundle_bank   = fd_pack_bundle_bank_tile( ctx->pack );
+    if( FD_UNLIKELY( bundle_bank!=ULONG_MAX && fd_ulong_extract_bit( ctx->bank_idle_bitset, (int)bundle_bank ) ) ) i = (int)bundle_bank;
+
     /* TODO: You can maybe make the case that this should happen as soon
        as we detect the bank has become idle, but doing it now probably
        helps with account locality. */
@@ -397,7 +442,14 @@ after_credit( void *             _ctx,
       ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, msg_sz+sizeof(fd_microblock_bank_trailer_t), ctx->out_chunk0, ctx->out_wmark );
       ctx->slot_microblock_cnt++;
 
-      ctx->bank_idle_bitset = fd_ulong_pop_lsb( ctx->bank_idle_bitset );
+      ctx->bank_idle_bitset = fd_ulong_clear_bit( ctx->bank_idle_bitset, i );
+
+      end_conflict_idle( ctx, now );
+    } else if( FD_UNLIKELY( !ctx->conflict_idle_begin && fd_pack_avail_txn_cnt( ctx->pack ) ) ) {
+      /* Every idle bank tile stays idle until something changes, since
+         we always try the lowest numbered one. */
+      ctx->conflict_idle_begin    = now;
+      ctx->conflict_idle_bank_cnt = (ulong)fd_ulong_popcnt( ctx->bank_idle_bitset );
     }
   }
 
@@ -440,6 +492,7 @@ after_credit( void *             _ctx,
     ctx->leader_slot         = ULONG_MAX;
     ctx->slot_microblock_cnt = 0UL;
     fd_pack_end_block( ctx->pack );
+    end_conflict_idle( ctx, now );
   }
 }
 
@@ -460,7 +513,7 @@ during_frag( void * _ctx,
 
   uchar const * dcache_entry = fd_chunk_to_laddr_const( ctx->in[ in_idx ].mem, chunk );
 
-  if( FD_UNLIKELY( in_idx==POH_IN_IDX ) ) {
+  if( FD_UNLIKELY( ctx->in[ in_idx ].kind==IN_KIND_POH ) ) {
     if( fd_disco_poh_sig_pkt_type( sig )!=POH_PKT_TYPE_BECAME_LEADER ) {
       /* Not interested in stamped microblocks, only leader updates. */
       *opt_filter = 1;
@@ -477,6 +530,7 @@ during_frag( void * _ctx,
       ctx->leader_slot         = ULONG_MAX;
       ctx->slot_microblock_cnt = 0UL;
       fd_pack_end_block( ctx->pack );
+      end_conflict_idle( ctx, fd_tickcount() );
     }
     ctx->leader_slot = fd_disco_poh_sig_slot( sig );
 
@@ -498,6 +552,21 @@ during_frag( void * _ctx,
     return;
   }
 
+  if( FD_UNLIKELY( ctx->in[ in_idx ].kind==IN_KIND_BANK ) ) {
+    if( FD_UNLIKELY( fd_disco_poh_sig_pkt_type( sig )!=POH_PKT_TYPE_MICROBLOCK ) ) {
+      *opt_filter = 1;
+      return;
+    }
+
+    if( FD_UNLIKELY( chunk<ctx->in[ in_idx ].chunk0 || chunk>ctx->in[ in_idx ].wmark || sz>MAX_MICROBLOCK_SZ || sz<sizeof(fd_microblock_trailer_t) ) )
+      FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in[ in_idx ].chunk0, ctx->in[ in_idx ].wmark ));
+
+    ctx->rebate_slot    = fd_disco_poh_sig_slot( sig );
+    ctx->rebate_txn_cnt = (sz-sizeof(fd_microblock_trailer_t))/sizeof(fd_txn_p_t);
+    fd_memcpy( ctx->rebate_txns, dcache_entry, ctx->rebate_txn_cnt*sizeof(fd_txn_p_t) );
+    return;
+  }
+
   if( FD_UNLIKELY( chunk<ctx->in[ in_idx ].chunk0 || chunk>ctx->in[ in_idx ].wmark || sz>FD_TPU_DCACHE_MTU ) )
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in[ in_idx ].chunk0, ctx->in[ in_idx ].wmark ));
 
@@ -583,9 +652,17 @@ after_frag( void *             _ctx,
   fd_pack_ctx_t * ctx = (fd_pack_ctx_t *)_ctx;
   long now = fd_tickcount();
 
-  if( FD_UNLIKELY( in_idx==POH_IN_IDX ) ) {
+  if( FD_UNLIKELY( ctx->in[ in_idx ].kind==IN_KIND_POH ) ) {
     ctx->slot_end_ns = ctx->_slot_end_ns;
     fd_pack_set_block_limits( ctx->pack, ctx->slot_max_microblocks, ctx->slot_max_data );
+  } else if( FD_UNLIKELY( ctx->in[ in_idx ].kind==IN_KIND_BANK ) ) {
+    /* Rebates only make sense for the block we are still packing.  The
+       bank tile only reports which transactions executed, not the CUs
+       they consumed, so there is nothing to learn from a block that has
+       already ended. */
+    int same_block = ctx->leader_slot!=ULONG_MAX && ctx->rebate_slot==ctx->leader_slot;
+    fd_pack_rebate_cus( ctx->pack, ctx->rebate_txns, NULL, ctx->rebate_txn_cnt, same_block );
+    ctx->rebate_txn_cnt = 0UL;
   } else {
     /* Normal transaction case */
     if( FD_LIKELY( !ctx->insert_to_extra ) ) {
@@ -632,6 +709,8 @@ unprivileged_init( fd_topo_t *      topo,
                                          tile->pack.max_pending_transactions, tile->pack.bank_tile_count,
                                          limits, rng ) );
   if( FD_UNLIKELY( !ctx->pack ) ) FD_LOG_ERR(( "fd_pack_new failed" ));
+  fd_pack_set_lookahead( ctx->pack, tile->pack.schedule_lookahead );
+  fd_pack_set_fee_payer_cap( ctx->pack, tile->pack.max_pending_per_fee_payer );
 
   ctx->extra_txn_deq = extra_txn_deq_join( extra_txn_deq_new( FD_SCRATCH_ALLOC_APPEND( l, extra_txn_deq_align(),
                                                                                           extra_txn_deq_footprint() ) ) );
@@ -649,6 +728,12 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->transaction_lifetime_ticks    = (ulong)(fd_tempo_tick_per_ns( NULL )*(double)TRANSACTION_LIFETIME_NS + 0.5);
   ctx->microblock_duration_ticks     = (ulong)(fd_tempo_tick_per_ns( NULL )*(double)MICROBLOCK_DURATION_NS  + 0.5);
   ctx->insert_to_extra               = 0;
+  ctx->rebate_slot                   = ULONG_MAX;
+  ctx->rebate_txn_cnt                = 0UL;
+  ctx->conflict_idle_begin           = 0L;
+  ctx->conflict_idle_bank_cnt        = 0UL;
+  ctx->conflict_idle_ticks           = 0UL;
+  ctx->ns_per_tick                   = 1.0/fd_tempo_tick_per_ns( NULL );
 
   ctx->wait_duration_ticks[ 0 ] = ULONG_MAX;
   for( ulong i=1UL; i<MAX_TXN_PER_MICROBLOCK+1UL; i++ ) {
@@ -669,10 +754,17 @@ unprivileged_init( fd_topo_t *      topo,
     FD_TEST( ULONG_MAX==fd_fseq_query( ctx->bank_current[ i ] ) );
   }
 
+  FD_TEST( tile->in_cnt<=sizeof( ctx->in )/sizeof( ctx->in[ 0 ] ) );
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
     fd_topo_wksp_t * link_wksp = &topo->workspaces[ topo->objs[ link->dcache_obj_id ].wksp_id ];
 
+    if(      !strcmp( link->name, "poh_pack"    ) ) ctx->in[i].kind = IN_KIND_POH;
+    else if( !strcmp( link->name, "bank_poh"    ) ) ctx->in[i].kind = IN_KIND_BANK;
+    else if( !strcmp( link->name, "dedup_pack"  ) ) ctx->in[i].kind = IN_KIND_TXN;
+    else if( !strcmp( link->name, "gossip_pack" ) ) ctx->in[i].kind = IN_KIND_TXN;
+    else FD_LOG_ERR(( "pack tile has unexpected input link %s", link->name ));
+
     ctx->in[i].mem    = link_wksp->wksp;
     ctx->in[i].chunk0 = fd_dcache_compact_chunk0( ctx->in[i].mem, link->dcache );
     ctx->in[i].wmark  = fd_dcache_compact_wmark ( ctx->in[i].mem, link->dcache, link->mtu );
@@ -370,7 +370,7 @@ after_frag( void *             _ctx,
       fork->slot_ctx.funk_txn = fd_funk_txn_prepare(ctx->replay->funk, fork->slot_ctx.funk_txn, &xid, 1);
       fd_funk_end_write( ctx->replay->funk );
 
-      int res = fd_runtime_publish_old_txns( &fork->slot_ctx, ctx->capture_ctx );
+      int res = fd_runtime_publish_old_txns( &fork->slot_ctx, ctx->capture_ctx, ctx->tpool, ctx->max_workers );
       if( res != FD_RUNTIME_EXECUTE_SUCCESS ) {
         FD_LOG_ERR(( "txn publishing failed" ));
       }
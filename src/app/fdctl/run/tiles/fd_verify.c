@@ -6,10 +6,17 @@
 #include "../../../../disco/quic/fd_tpu.h"
 
 #include <linux/unistd.h>
+#include <sys/random.h>
 
 /* The verify tile is a wrapper around the mux tile, that also verifies
    incoming transaction signatures match the data being signed.
-   Non-matching transactions are filtered out of the frag stream. */
+   Non-matching transactions are filtered out of the frag stream.
+
+   Incoming transactions are spread round robin across the verify tiles.
+   Each verify tile has an out link to every dedup tile, and publishes
+   a transaction to the dedup tile of its shard, which is picked by a
+   hash of the transaction tag, seeded at boot so that senders can't
+   choose signatures that all land in the same shard. */
 
 FD_FN_CONST static inline ulong
 scratch_align( void ) {
@@ -46,6 +53,33 @@ before_frag( void * _ctx,
   if( FD_LIKELY( (seq % ctx->round_robin_cnt) != ctx->round_robin_idx ) ) *opt_filter = 1;
 }
 
+/* before_credit is called every iteration of the run loop.  The mux
+   does not know about the out links, so hold it back until every dedup
+   tile can take another transaction, as we don't know which shard the
+   next one is going to. */
+
+static inline void
+before_credit( void *             _ctx,
+               fd_mux_context_t * mux ) {
+  fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
+
+  ulong cr_avail = ULONG_MAX;
+  for( ulong i=0UL; i<ctx->out_cnt; i++ ) cr_avail = fd_ulong_min( cr_avail, ctx->out[ i ].cr_avail );
+  *mux->cr_avail = cr_avail;
+}
+
+static inline void
+during_housekeeping( void * _ctx ) {
+  fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
+
+  for( ulong i=0UL; i<ctx->out_cnt; i++ ) {
+    fd_verify_out_ctx_t * out = &ctx->out[ i ];
+    fd_mcache_seq_update( out->sync, out->seq );
+    ulong rx_seq = fd_fseq_query( out->fseq );
+    out->cr_avail = (ulong)fd_long_max( (long)out->depth - fd_long_max( fd_seq_diff( out->seq, rx_seq ), 0L ), 0L );
+  }
+}
+
 /* during_frag is called between pairs for sequence number checks, as
    we are reading incoming frags.  We don't actually need to copy the
    fragment here, see fd_dedup.c for why we do this.*/
@@ -59,7 +93,6 @@ during_frag( void * _ctx,
              ulong sz,
              int * opt_filter ) {
   (void)seq;
-  (void)sig;
   (void)opt_filter;
 
   fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
@@ -67,8 +100,14 @@ during_frag( void * _ctx,
   if( FD_UNLIKELY( chunk<ctx->in[in_idx].chunk0 || chunk>ctx->in[in_idx].wmark || sz>FD_TPU_MTU ) )
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in[in_idx].chunk0, ctx->in[in_idx].wmark ));
 
+  /* The QUIC tile sets the frag sig to the transaction tag, so the
+     shard is known before the transaction is parsed, and it can be
+     copied straight into the dcache of that dedup tile. */
+  ctx->out_idx = fd_ulong_hash( sig ^ ctx->shard_seed ) % ctx->out_cnt;
+  fd_verify_out_ctx_t * out = &ctx->out[ ctx->out_idx ];
+
   uchar * src = (uchar *)fd_chunk_to_laddr( ctx->in[in_idx].mem, chunk );
-  uchar * dst = (uchar *)fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
+  uchar * dst = (uchar *)fd_chunk_to_laddr( out->mem, out->chunk );
 
   fd_memcpy( dst, src, sz );
 }
@@ -85,10 +124,11 @@ after_frag( void *             _ctx,
             fd_mux_context_t * mux ) {
   (void)in_idx;
   (void)seq;
-  (void)opt_sig;
   (void)opt_chunk;
+  (void)mux;
 
-  fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
+  fd_verify_ctx_t *     ctx = (fd_verify_ctx_t *)_ctx;
+  fd_verify_out_ctx_t * out = &ctx->out[ ctx->out_idx ];
 
   /* At this point, the payload only contains the serialized txn.
      Beyond end of txn, but within bounds of msg layout, add a trailer
@@ -109,7 +149,7 @@ after_frag( void *             _ctx,
                     (long)sizeof(ushort);
   if( FD_UNLIKELY( txnt_maxsz<(long)FD_TXN_MAX_SZ ) ) FD_LOG_ERR(( "got malformed txn (sz %lu) does not fit in dcache", payload_sz ));
 
-  uchar const * txn   = fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
+  uchar const * txn   = fd_chunk_to_laddr( out->mem, out->chunk );
   fd_txn_t *    txn_t = (fd_txn_t *)((ulong)txn + txnt_off);
 
   /* Parse transaction */
@@ -142,6 +182,13 @@ after_frag( void *             _ctx,
     FD_LOG_ERR( ("txn is invalid: payload_sz = %lx, recent_blockhash_off = %x", *opt_sz, recent_blockhash_off ) );
   }
 
+  /* The shard was picked from the frag sig, make sure it really is the
+     tag, or copies of a transaction could reach different dedup tiles. */
+  if( FD_UNLIKELY( FD_LOAD( ulong, txn+txn_t->signature_off )!=*opt_sig ) ) {
+    *opt_filter = 1;
+    return;
+  }
+
   ulong txn_sig;
   int res = fd_txn_verify( ctx, txn, (ushort)payload_sz, txn_t, &txn_sig );
   if( FD_UNLIKELY( res!=FD_TXN_VERIFY_SUCCESS ) ) {
@@ -150,8 +197,34 @@ after_frag( void *             _ctx,
   }
 
   ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
-  fd_mux_publish( mux, txn_sig, ctx->out_chunk, new_sz, 0UL, *opt_tsorig, tspub );
-  ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, new_sz, ctx->out_chunk0, ctx->out_wmark );
+  fd_mcache_publish( out->mcache, out->depth, out->seq, txn_sig, out->chunk, new_sz, 0UL, *opt_tsorig, tspub );
+  out->seq      = fd_seq_inc( out->seq, 1UL );
+  out->cr_avail--;
+  out->chunk    = fd_dcache_compact_next( out->chunk, new_sz, out->chunk0, out->wmark );
+}
+
+static void
+privileged_init( fd_topo_t *      topo,
+                 fd_topo_tile_t * tile,
+                 void *           scratch ) {
+  (void)tile;
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_verify_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_verify_ctx_t ), sizeof( fd_verify_ctx_t ) );
+
+  ulong seed_obj_id = fd_pod_query_ulong( topo->props, "verify_seed", ULONG_MAX );
+  FD_TEST( seed_obj_id!=ULONG_MAX );
+  ulong * seed = fd_fseq_join( fd_topo_obj_laddr( topo, seed_obj_id ) );
+  FD_TEST( seed );
+
+  /* Every verify tile has to send a transaction to the same dedup tile,
+     so the first one to boot picks the seed, and the others use it.
+     The fseq starts at ULONG_MAX, which is never picked. */
+  ulong candidate;
+  FD_TEST( sizeof(ulong)==getrandom( &candidate, sizeof(ulong), 0 ) );
+  candidate = fd_ulong_if( candidate==ULONG_MAX, 0UL, candidate );
+  FD_ATOMIC_CAS( seed, ULONG_MAX, candidate );
+  ctx->shard_seed = FD_VOLATILE_CONST( *seed );
 }
 
 static void
@@ -194,10 +267,35 @@ unprivileged_init( fd_topo_t *      topo,
     }
   }
 
-  ctx->out_mem    = topo->workspaces[ topo->objs[ topo->links[ tile->out_link_id_primary ].dcache_obj_id ].wksp_id ].wksp;
-  ctx->out_chunk0 = fd_dcache_compact_chunk0( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache );
-  ctx->out_wmark  = fd_dcache_compact_wmark ( ctx->out_mem, topo->links[ tile->out_link_id_primary ].dcache, topo->links[ tile->out_link_id_primary ].mtu );
-  ctx->out_chunk  = ctx->out_chunk0;
+  if( FD_UNLIKELY( !tile->out_cnt || tile->out_cnt>sizeof(ctx->out)/sizeof(ctx->out[ 0 ]) ) ) FD_LOG_ERR(( "verify tile has %lu out links", tile->out_cnt ));
+  ctx->out_cnt = tile->out_cnt;
+  for( ulong i=0UL; i<tile->out_cnt; i++ ) {
+    fd_topo_link_t *      link = &topo->links[ tile->out_link_id[ i ] ];
+    fd_verify_out_ctx_t * out  = &ctx->out[ i ];
+
+    out->mcache   = link->mcache;
+    out->depth    = fd_mcache_depth( link->mcache );
+    out->sync     = fd_mcache_seq_laddr( link->mcache );
+    out->seq      = fd_mcache_seq_query( out->sync );
+    out->cr_avail = 0UL; /* Received during the first housekeeping */
+
+    out->fseq = NULL;
+    for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
+      fd_topo_tile_t * consumer = &topo->tiles[ j ];
+      for( ulong k=0UL; k<consumer->in_cnt; k++ ) {
+        if( FD_UNLIKELY( consumer->in_link_id[ k ]==link->id && consumer->in_link_reliable[ k ] ) ) {
+          if( FD_UNLIKELY( out->fseq ) ) FD_LOG_ERR(( "out link %s:%lu has more than one reliable consumer", link->name, link->kind_id ));
+          out->fseq = consumer->in_link_fseq[ k ];
+        }
+      }
+    }
+    if( FD_UNLIKELY( !out->fseq ) ) FD_LOG_ERR(( "out link %s:%lu has no reliable consumer", link->name, link->kind_id ));
+
+    out->mem    = topo->workspaces[ topo->objs[ link->dcache_obj_id ].wksp_id ].wksp;
+    out->chunk0 = fd_dcache_compact_chunk0( out->mem, link->dcache );
+    out->wmark  = fd_dcache_compact_wmark ( out->mem, link->dcache, link->mtu );
+    out->chunk  = out->chunk0;
+  }
 
   ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, 1UL );
   if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) )
@@ -232,6 +330,8 @@ fd_topo_run_tile_t fd_tile_verify = {
   .mux_flags                = FD_MUX_FLAG_COPY | FD_MUX_FLAG_MANUAL_PUBLISH,
   .burst                    = 1UL,
   .mux_ctx                  = mux_ctx,
+  .mux_during_housekeeping  = during_housekeeping,
+  .mux_before_credit        = before_credit,
   .mux_before_frag          = before_frag,
   .mux_during_frag          = during_frag,
   .mux_after_frag           = after_frag,
@@ -239,6 +339,6 @@ fd_topo_run_tile_t fd_tile_verify = {
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
   .scratch_footprint        = scratch_footprint,
-  .privileged_init          = NULL,
+  .privileged_init          = privileged_init,
   .unprivileged_init        = unprivileged_init,
 };
@@ -19,6 +19,25 @@ typedef struct {
   ulong       wmark;
 } fd_verify_in_ctx_t;
 
+/* fd_verify_out_ctx_t is a context object for each out link of the
+   verify tile, there is one to each dedup tile.  The mux only flow
+   controls a primary out, so the verify tile receives the credits from
+   the dedup tiles itself. */
+
+typedef struct {
+  fd_frag_meta_t * mcache;
+  ulong            depth;
+  ulong *          sync;
+  ulong            seq;
+  ulong const *    fseq;     /* fseq of the dedup tile reading this link */
+  ulong            cr_avail;
+
+  fd_wksp_t *      mem;
+  ulong            chunk0;
+  ulong            wmark;
+  ulong            chunk;
+} fd_verify_out_ctx_t;
+
 typedef struct {
   /* TODO switch to fd_sha512_batch_t? */
   fd_sha512_t * sha[ FD_TXN_ACTUAL_SIG_MAX ];
@@ -34,10 +53,10 @@ typedef struct {
 
   fd_verify_in_ctx_t in[ 32 ];
 
-  fd_wksp_t * out_mem;
-  ulong       out_chunk0;
-  ulong       out_wmark;
-  ulong       out_chunk;
+  ulong               shard_seed; /* seed of the dedup shard hash, same for all verify tiles */
+  ulong               out_idx;    /* out link of the frag being processed */
+  ulong               out_cnt;
+  fd_verify_out_ctx_t out[ FD_TOPO_MAX_TILE_OUT_LINKS ];
 } fd_verify_ctx_t;
 
 static inline int
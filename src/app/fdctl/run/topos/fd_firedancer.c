@@ -22,6 +22,7 @@ fd_topo_firedancer( config_t * _config ) {
   ulong shred_tile_cnt  = config->layout.shred_tile_count;
   ulong quic_tile_cnt   = config->layout.quic_tile_count;
   ulong verify_tile_cnt = config->layout.verify_tile_count;
+  ulong dedup_tile_cnt  = config->layout.dedup_tile_count;
 
   ulong replay_tpool_thread_count = config->tiles.replay.tpool_thread_count;
 
@@ -93,8 +94,9 @@ fd_topo_firedancer( config_t * _config ) {
   FOR(net_tile_cnt)    fd_topob_link( topo, "net_shred",    "net_shred",    0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,                    1UL );
   FOR(shred_tile_cnt)  fd_topob_link( topo, "shred_net",    "net_shred",    0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,                    1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_verify",  "quic_verify",  1,        config->tiles.verify.receive_buffer_size, 0UL,                           config->tiles.quic.txn_reassembly_count );
-  FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", 0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,             1UL );
-  /**/                 fd_topob_link( topo, "dedup_pack",   "dedup_pack",   0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,             1UL );
+  FOR(verify_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_link( topo, "verify_dedup", "verify_dedup", 0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,             1UL );
+  FOR(dedup_tile_cnt)  fd_topob_link( topo, "dedup_pack",   "dedup_pack",   0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,             1UL );
 
   /**/                 fd_topob_link( topo, "stake_out",    "stake_out",    0,        128UL,                                    32UL + 40200UL * 40UL,         1UL );
   /* See long comment in fd_shred.c for an explanation about the size of this dcache. */
@@ -127,9 +129,15 @@ fd_topo_firedancer( config_t * _config ) {
 
   ushort parsed_tile_to_cpu[ FD_TILE_MAX ];
   for( ulong i=0UL; i<FD_TILE_MAX; i++ ) parsed_tile_to_cpu[ i ] = USHORT_MAX; /* Unassigned tiles will be floating. */
-  ulong affinity_tile_cnt = fd_tile_private_cpus_parse( config->layout.affinity, parsed_tile_to_cpu );
+  /* With an affinity of "auto", tiles are created floating and pinned
+     by fd_topob_auto_layout below, once the links between them are
+     known. */
+  int   is_auto_affinity  = !strcmp( config->layout.affinity, "auto" );
+  ulong affinity_tile_cnt = 0UL;
+  if( FD_LIKELY( !is_auto_affinity ) ) affinity_tile_cnt = fd_tile_private_cpus_parse( config->layout.affinity, parsed_tile_to_cpu );
 
   ulong tile_to_cpu[ FD_TILE_MAX ];
+  for( ulong i=0UL; i<FD_TILE_MAX; i++ ) tile_to_cpu[ i ] = ULONG_MAX;
   for( ulong i=0UL; i<affinity_tile_cnt; i++ ) {
     if( FD_UNLIKELY( parsed_tile_to_cpu[ i ]!=65535 && parsed_tile_to_cpu[ i ]>=get_nprocs() ) )
       FD_LOG_ERR(( "The CPU affinity string in the configuration file under [layout.affinity] specifies a CPU index of %hu, but the system "
@@ -142,8 +150,8 @@ fd_topo_firedancer( config_t * _config ) {
   /*                                              topo, tile_name, tile_wksp, cnc_wksp,    metrics_wksp, cpu_idx,                       is_labs, out_link,       out_link_kind_id */
   FOR(net_tile_cnt)                fd_topob_tile( topo, "net",     "net",     "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       NULL,           0UL );
   FOR(quic_tile_cnt)               fd_topob_tile( topo, "quic",    "quic",    "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "quic_verify",  i   );
-  FOR(verify_tile_cnt)             fd_topob_tile( topo, "verify",  "verify",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "verify_dedup", i   );
-  /**/                             fd_topob_tile( topo, "dedup",   "dedup",   "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "dedup_pack",   0UL );
+  FOR(verify_tile_cnt)             fd_topob_tile( topo, "verify",  "verify",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       NULL,           0UL );
+  FOR(dedup_tile_cnt)              fd_topob_tile( topo, "dedup",   "dedup",   "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "dedup_pack",   i   );
   FOR(shred_tile_cnt)              fd_topob_tile( topo, "shred",   "shred",   "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "shred_storei", i   );
   /**/                             fd_topob_tile( topo, "gossip",  "gossip",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "gossip_net",   0UL );
   /**/                             fd_topob_tile( topo, "repair",  "repair",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "repair_store", 0UL );
@@ -195,13 +203,24 @@ fd_topo_firedancer( config_t * _config ) {
   }
   FD_TEST( fd_pod_insertf_ulong( topo->props, poh_shred_obj->id, "poh_shred" ) );
 
-  if( FD_UNLIKELY( affinity_tile_cnt<topo->tile_cnt ) ) {
+  /* The verify tiles pick the dedup shard of each transaction by a
+     seeded hash of its signature, so that senders can't grind
+     signatures that all land on one dedup tile.  The seed is shared
+     through this fseq, which the first verify tile to boot fills in. */
+  fd_topo_obj_t * verify_seed_obj = fd_topob_obj( topo, "fseq", "verify" );
+  for( ulong i=0UL; i<verify_tile_cnt; i++ ) {
+    fd_topo_tile_t * verify_tile = &topo->tiles[ fd_topo_find_tile( topo, "verify", i ) ];
+    fd_topob_tile_uses( topo, verify_tile, verify_seed_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  }
+  FD_TEST( fd_pod_insertf_ulong( topo->props, verify_seed_obj->id, "verify_seed" ) );
+
+  if( FD_UNLIKELY( !is_auto_affinity && affinity_tile_cnt<topo->tile_cnt ) ) {
     FD_LOG_ERR(( "The topology you are using has %lu tiles, but the CPU affinity specified in the config tile as [layout.affinity] only provides for %lu cores. "
                  "You should either increase the number of cores dedicated to Firedancer in the affinity string, or decrease the number of cores needed by reducing "
                  "the total tile count. You can reduce the tile count by decreasing individual tile counts in the [layout] section of the configuration file.",
                  topo->tile_cnt, affinity_tile_cnt ));
   }
-  if( FD_UNLIKELY( affinity_tile_cnt>topo->tile_cnt ) ) {
+  if( FD_UNLIKELY( !is_auto_affinity && affinity_tile_cnt>topo->tile_cnt ) ) {
     FD_LOG_WARNING(( "The topology you are using has %lu tiles, but the CPU affinity specified in the config tile as [layout.affinity] provides for %lu cores. "
                      "Not all cores in the affinity will be used by Firedancer. You may wish to increase the number of tiles in the system by increasing "
                      "individual tile counts in the [layout] section of the configuration file.",
@@ -221,7 +240,13 @@ fd_topo_firedancer( config_t * _config ) {
   /* All verify tiles read from all QUIC tiles, packets are round robin. */
   FOR(verify_tile_cnt) for( ulong j=0UL; j<quic_tile_cnt; j++ )
                        fd_topob_tile_in(  topo, "verify",  i,            "metric_in", "quic_verify",  j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers, verify tiles may be overrun */
-  FOR(verify_tile_cnt) fd_topob_tile_in(  topo, "dedup",   0UL,          "metric_in", "verify_dedup", i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  /* Transactions are sharded among the dedup tiles by signature, so
+     each verify tile has a link to every dedup tile, and publishes each
+     transaction to the link of its shard. */
+  FOR(verify_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_tile_out( topo, "verify",  i,                         "verify_dedup", i*dedup_tile_cnt+j                                 );
+  FOR(verify_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_tile_in(  topo, "dedup",   j,            "metric_in", "verify_dedup", i*dedup_tile_cnt+j, FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
 
   FOR(net_tile_cnt)    fd_topob_tile_in(  topo, "net",     i,            "metric_in", "gossip_net",   0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   FOR(net_tile_cnt)    fd_topob_tile_in(  topo, "net",     i,            "metric_in", "repair_net",   0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
@@ -288,7 +313,7 @@ fd_topo_firedancer( config_t * _config ) {
   /**/                 fd_topob_tile_in(  topo, "pohi",  0UL,            "metric_in", "replay_poh",    0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   /**/                 fd_topob_tile_in(  topo, "pohi",  0UL,            "metric_in", "stake_out",     0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   
-  /**/                 fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in", "dedup_pack",    0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
+  FOR(dedup_tile_cnt)  fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in", "dedup_pack",    i,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   /**/                 fd_topob_tile_in(  topo, "pohi",  0UL,            "metric_in", "pack_replay",   0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   /**/                 fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in", "poh_pack",      0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED );
                        fd_topob_tile_out( topo, "pohi",   0UL,                        "poh_pack",      0UL                                                );
@@ -336,7 +361,7 @@ fd_topo_firedancer( config_t * _config ) {
     } else if( FD_UNLIKELY( !strcmp( tile->name, "verify" ) ) ) {
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "dedup" ) ) ) {
-      tile->dedup.tcache_depth = config->tiles.dedup.signature_cache_size;
+      tile->dedup.sigcache_depth = config->tiles.dedup.signature_cache_size;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "shred" ) ) ) {
       fd_memcpy( tile->shred.src_mac_addr, config->tiles.net.mac_addr, 6 );
@@ -408,6 +433,8 @@ fd_topo_firedancer( config_t * _config ) {
 
       tile->pack.max_pending_transactions      = config->tiles.pack.max_pending_transactions;
       tile->pack.bank_tile_count               = config->layout.bank_tile_count;
+      tile->pack.schedule_lookahead            = config->tiles.pack.schedule_lookahead;
+      tile->pack.max_pending_per_fee_payer     = config->tiles.pack.max_pending_per_fee_payer;
       tile->pack.larger_max_cost_per_block     = config->development.bench.larger_max_cost_per_block;
       tile->pack.larger_shred_limits_per_block = config->development.bench.larger_shred_limits_per_block;
     } else if( FD_UNLIKELY( !strcmp( tile->name, "pohi" ) ) ) {
@@ -419,6 +446,17 @@ fd_topo_firedancer( config_t * _config ) {
     }
   }
 
+  if( FD_UNLIKELY( is_auto_affinity ) ) {
+    static fd_topo_cpus_t cpus[ 1 ];
+    fd_topo_cpus_init( cpus );
+    fd_topob_auto_layout( topo, cpus );
+  }
+
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    FD_TEST( !fd_pod_replacef_ulong( topo->props, config->tiles.metric.trace_sample_rate, "obj.%lu.sample_rate", topo->tiles[ i ].trace_obj_id ) );
+    FD_TEST( !fd_pod_replacef_ulong( topo->props, (ulong)config->log.async,              "obj.%lu.enabled",     topo->tiles[ i ].log_obj_id   ) );
+  }
+
   fd_topob_finish( topo, fdctl_obj_align, fdctl_obj_footprint, fdctl_obj_loose );
 
   const char * snapshot = config->tiles.replay.snapshot;
@@ -7,12 +7,55 @@
 #include "../../../../util/tile/fd_tile_private.h"
 #include <sys/sysinfo.h>
 
+/* solana_labs_auto_affinity sets [layout.solana_labs_affinity] to every
+   available CPU that is not running a tile and is not the hyperthread
+   sibling of one, so the Solana Labs threads never share a core with a
+   tile. */
+
+static void
+solana_labs_auto_affinity( config_t *             config,
+                           fd_topo_t const *      topo,
+                           fd_topo_cpus_t const * cpus ) {
+  uchar used[ FD_SHMEM_CPU_MAX ] = {0};
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    ulong cpu_idx = topo->tiles[ i ].cpu_idx;
+    if( FD_UNLIKELY( cpu_idx>=cpus->cpu_cnt ) ) continue;
+    used[ cpu_idx ] = 1;
+    if( FD_LIKELY( cpus->cpu[ cpu_idx ].sibling!=ULONG_MAX ) ) used[ cpus->cpu[ cpu_idx ].sibling ] = 1;
+  }
+
+  char  affinity[ AFFINITY_SZ ];
+  ulong len = 0UL;
+  affinity[ 0 ] = '\0';
+  for( ulong i=0UL; i<cpus->cpu_cnt; i++ ) {
+    if( FD_LIKELY( used[ i ] || !cpus->cpu[ i ].online ) ) continue;
+
+    ulong j = i;
+    while( j+1UL<cpus->cpu_cnt && !used[ j+1UL ] && cpus->cpu[ j+1UL ].online ) j++;
+
+    char range[ 32 ];
+    if( FD_LIKELY( i==j ) ) FD_TEST( fd_cstr_printf_check( range, sizeof(range), NULL, "%lu",     i    ) );
+    else                    FD_TEST( fd_cstr_printf_check( range, sizeof(range), NULL, "%lu-%lu", i, j ) );
+
+    ulong n;
+    if( FD_UNLIKELY( !fd_cstr_printf_check( affinity+len, AFFINITY_SZ-len, &n, "%s%s", len ? "," : "", range ) ) )
+      FD_LOG_ERR(( "The automatically chosen [layout.solana_labs_affinity] is longer than %lu characters. Specify the affinity manually.", AFFINITY_SZ-1UL ));
+    len += n;
+    i = j;
+  }
+
+  if( FD_UNLIKELY( !len ) ) FD_LOG_WARNING(( "Every available CPU is running a Firedancer tile, so the Solana Labs threads "
+                                             "will float on the original core set with [layout.solana_labs_affinity] set to \"auto\"." ));
+  else                      FD_LOG_INFO(( "Solana Labs affinity is %s", affinity ));
+  strcpy( config->layout.solana_labs_affinity, affinity );
+}
 
 void
 fd_topo_frankendancer( config_t * config ) { 
   ulong net_tile_cnt    = config->layout.net_tile_count;
   ulong quic_tile_cnt   = config->layout.quic_tile_count;
   ulong verify_tile_cnt = config->layout.verify_tile_count;
+  ulong dedup_tile_cnt  = config->layout.dedup_tile_count;
   ulong bank_tile_cnt   = config->layout.bank_tile_count;
   ulong shred_tile_cnt  = config->layout.shred_tile_count;
 
@@ -57,10 +100,11 @@ fd_topo_frankendancer( config_t * config ) {
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_net",     "net_quic",     0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
   FOR(shred_tile_cnt)  fd_topob_link( topo, "shred_net",    "net_shred",    0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_verify",  "quic_verify",  1,        config->tiles.verify.receive_buffer_size, 0UL,                    config->tiles.quic.txn_reassembly_count );
-  FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", 0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
+  FOR(verify_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_link( topo, "verify_dedup", "verify_dedup", 0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
   /* dedup_pack is large currently because pack can encounter stalls when running at very high throughput rates that would
      otherwise cause drops. */
-  /**/                 fd_topob_link( topo, "dedup_pack",   "dedup_pack",   0,        4*65536UL,                                FD_TPU_DCACHE_MTU,      1UL );
+  FOR(dedup_tile_cnt)  fd_topob_link( topo, "dedup_pack",   "dedup_pack",   0,        4*65536UL,                                FD_TPU_DCACHE_MTU,      1UL );
   /* gossip_pack could be FD_TPU_MTU for now, since txns are not parsed, but better to just share one size for all the ins of pack */
   /**/                 fd_topob_link( topo, "gossip_pack",  "dedup_pack",   0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
   /**/                 fd_topob_link( topo, "stake_out",    "stake_out",    0,        128UL,                                    32UL + 40200UL * 40UL,  1UL );
@@ -81,9 +125,15 @@ fd_topo_frankendancer( config_t * config ) {
 
   ushort parsed_tile_to_cpu[ FD_TILE_MAX ];
   for( ulong i=0UL; i<FD_TILE_MAX; i++ ) parsed_tile_to_cpu[ i ] = USHORT_MAX; /* Unassigned tiles will be floating. */
-  ulong affinity_tile_cnt = fd_tile_private_cpus_parse( config->layout.affinity, parsed_tile_to_cpu );
+  /* With an affinity of "auto", tiles are created floating and pinned
+     by fd_topob_auto_layout below, once the links between them are
+     known. */
+  int   is_auto_affinity  = !strcmp( config->layout.affinity, "auto" );
+  ulong affinity_tile_cnt = 0UL;
+  if( FD_LIKELY( !is_auto_affinity ) ) affinity_tile_cnt = fd_tile_private_cpus_parse( config->layout.affinity, parsed_tile_to_cpu );
 
   ulong tile_to_cpu[ FD_TILE_MAX ];
+  for( ulong i=0UL; i<FD_TILE_MAX; i++ ) tile_to_cpu[ i ] = ULONG_MAX;
   for( ulong i=0UL; i<affinity_tile_cnt; i++ ) {
     if( FD_UNLIKELY( parsed_tile_to_cpu[ i ]!=65535 && parsed_tile_to_cpu[ i ]>=get_nprocs() ) )
       FD_LOG_ERR(( "The CPU affinity string in the configuration file under [layout.affinity] specifies a CPU index of %hu, but the system "
@@ -96,8 +146,8 @@ fd_topo_frankendancer( config_t * config ) {
   /*                                  topo, tile_name, tile_wksp, cnc_wksp,    metrics_wksp, cpu_idx,                       is_labs, out_link,       out_link_kind_id */
   FOR(net_tile_cnt)    fd_topob_tile( topo, "net",     "net",     "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       NULL,           0UL );
   FOR(quic_tile_cnt)   fd_topob_tile( topo, "quic",    "quic",    "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "quic_verify",  i   );
-  FOR(verify_tile_cnt) fd_topob_tile( topo, "verify",  "verify",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "verify_dedup", i   );
-  /**/                 fd_topob_tile( topo, "dedup",   "dedup",   "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "dedup_pack",   0UL );
+  FOR(verify_tile_cnt) fd_topob_tile( topo, "verify",  "verify",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       NULL,           0UL );
+  FOR(dedup_tile_cnt)  fd_topob_tile( topo, "dedup",   "dedup",   "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "dedup_pack",   i   );
   /**/                 fd_topob_tile( topo, "pack",    "pack",    "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       "pack_bank",    0UL );
   FOR(bank_tile_cnt)   fd_topob_tile( topo, "bank",    "bank",    "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 1,       "bank_poh",     i   );
   /**/                 fd_topob_tile( topo, "poh",     "poh",     "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 1,       "poh_shred",    0UL );
@@ -106,12 +156,12 @@ fd_topo_frankendancer( config_t * config ) {
   /**/                 fd_topob_tile( topo, "sign",    "sign",    "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       NULL,           0UL );
   /**/                 fd_topob_tile( topo, "metric",  "metric",  "metric_in", "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,       NULL,           0UL );
 
-  if( FD_UNLIKELY( affinity_tile_cnt<topo->tile_cnt ) )
+  if( FD_UNLIKELY( !is_auto_affinity && affinity_tile_cnt<topo->tile_cnt ) )
     FD_LOG_ERR(( "The topology you are using has %lu tiles, but the CPU affinity specified in the config tile as [layout.affinity] only provides for %lu cores. "
                  "You should either increase the number of cores dedicated to Firedancer in the affinity string, or decrease the number of cores needed by reducing "
                  "the total tile count. You can reduce the tile count by decreasing individual tile counts in the [layout] section of the configuration file.",
                  topo->tile_cnt, affinity_tile_cnt ));
-  if( FD_UNLIKELY( affinity_tile_cnt>topo->tile_cnt ) )
+  if( FD_UNLIKELY( !is_auto_affinity && affinity_tile_cnt>topo->tile_cnt ) )
     FD_LOG_WARNING(( "The topology you are using has %lu tiles, but the CPU affinity specified in the config tile as [layout.affinity] provides for %lu cores. "
                      "Not all cores in the affinity will be used by Firedancer. You may wish to increase the number of tiles in the system by increasing "
                      "individual tile counts in the [layout] section of the configuration file.",
@@ -131,8 +181,14 @@ fd_topo_frankendancer( config_t * config ) {
   /* All verify tiles read from all QUIC tiles, packets are round robin. */
   FOR(verify_tile_cnt) for( ulong j=0UL; j<quic_tile_cnt; j++ )
                        fd_topob_tile_in(  topo, "verify",  i,            "metric_in", "quic_verify",  j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers, verify tiles may be overrun */
-  FOR(verify_tile_cnt) fd_topob_tile_in(  topo, "dedup",   0UL,          "metric_in", "verify_dedup", i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
-  /**/                 fd_topob_tile_in(  topo, "pack",    0UL,          "metric_in", "dedup_pack",   0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  /* Transactions are sharded among the dedup tiles by signature, so
+     each verify tile has a link to every dedup tile, and publishes each
+     transaction to the link of its shard. */
+  FOR(verify_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_tile_out( topo, "verify",  i,                         "verify_dedup", i*dedup_tile_cnt+j                                 );
+  FOR(verify_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_tile_in(  topo, "dedup",   j,            "metric_in", "verify_dedup", i*dedup_tile_cnt+j, FD_TOPOB_RELIABLE, FD_TOPOB_POLLED );
+  FOR(dedup_tile_cnt)  fd_topob_tile_in(  topo, "pack",    0UL,          "metric_in", "dedup_pack",   i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   /**/                 fd_topob_tile_in(  topo, "pack",    0UL,          "metric_in", "gossip_pack",  0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   /* The PoH to pack link is reliable, and must be.  The fragments going
      across here are "you became leader" which pack must respond to
@@ -145,6 +201,10 @@ fd_topo_frankendancer( config_t * config ) {
      must acknowledge it with a packing done frag, so there will be at
      most one in flight at any time. */
   /**/                 fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in", "poh_pack",     0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED );
+  /* Pack reads back the execution results from the banks so it can
+     rebate the CUs of transactions that were not committed.  This is
+     best effort, so it must not backpressure the banks. */
+  FOR(bank_tile_cnt)   fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in", "bank_poh",     i,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED );
   FOR(bank_tile_cnt)   fd_topob_tile_in(  topo, "bank",   i,             "metric_in", "pack_bank",    0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   FOR(bank_tile_cnt)   fd_topob_tile_in(  topo, "poh",    0UL,           "metric_in", "bank_poh",     i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   /**/                 fd_topob_tile_in(  topo, "poh",    0UL,           "metric_in", "stake_out",    0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
@@ -210,6 +270,17 @@ fd_topo_frankendancer( config_t * config ) {
   }
   FD_TEST( fd_pod_insertf_ulong( topo->props, poh_shred_obj->id, "poh_shred" ) );
 
+  /* The verify tiles pick the dedup shard of each transaction by a
+     seeded hash of its signature, so that senders can't grind
+     signatures that all land on one dedup tile.  The seed is shared
+     through this fseq, which the first verify tile to boot fills in. */
+  fd_topo_obj_t * verify_seed_obj = fd_topob_obj( topo, "fseq", "verify" );
+  for( ulong i=0UL; i<verify_tile_cnt; i++ ) {
+    fd_topo_tile_t * verify_tile = &topo->tiles[ fd_topo_find_tile( topo, "verify", i ) ];
+    fd_topob_tile_uses( topo, verify_tile, verify_seed_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  }
+  FD_TEST( fd_pod_insertf_ulong( topo->props, verify_seed_obj->id, "verify_seed" ) );
+
   for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
     fd_topo_tile_t * tile = &topo->tiles[ i ];
 
@@ -250,13 +321,15 @@ fd_topo_frankendancer( config_t * config ) {
     } else if( FD_UNLIKELY( !strcmp( tile->name, "verify" ) ) ) {
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "dedup" ) ) ) {
-      tile->dedup.tcache_depth = config->tiles.dedup.signature_cache_size;
+      tile->dedup.sigcache_depth = config->tiles.dedup.signature_cache_size;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "pack" ) ) ) {
       strncpy( tile->pack.identity_key_path, config->consensus.identity_path, sizeof(tile->pack.identity_key_path) );
 
       tile->pack.max_pending_transactions      = config->tiles.pack.max_pending_transactions;
       tile->pack.bank_tile_count               = config->layout.bank_tile_count;
+      tile->pack.schedule_lookahead            = config->tiles.pack.schedule_lookahead;
+      tile->pack.max_pending_per_fee_payer     = config->tiles.pack.max_pending_per_fee_payer;
       tile->pack.larger_max_cost_per_block     = config->development.bench.larger_max_cost_per_block;
       tile->pack.larger_shred_limits_per_block = config->development.bench.larger_shred_limits_per_block;
 
@@ -290,6 +363,19 @@ fd_topo_frankendancer( config_t * config ) {
     }
   }
 
+  int is_auto_labs_affinity = !strcmp( config->layout.solana_labs_affinity, "auto" );
+  if( FD_UNLIKELY( is_auto_affinity || is_auto_labs_affinity ) ) {
+    static fd_topo_cpus_t cpus[ 1 ];
+    fd_topo_cpus_init( cpus );
+    if( FD_UNLIKELY( is_auto_affinity      ) ) fd_topob_auto_layout( topo, cpus );
+    if( FD_UNLIKELY( is_auto_labs_affinity ) ) solana_labs_auto_affinity( config, topo, cpus );
+  }
+
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    FD_TEST( !fd_pod_replacef_ulong( topo->props, config->tiles.metric.trace_sample_rate, "obj.%lu.sample_rate", topo->tiles[ i ].trace_obj_id ) );
+    FD_TEST( !fd_pod_replacef_ulong( topo->props, (ulong)config->log.async,              "obj.%lu.enabled",     topo->tiles[ i ].log_obj_id   ) );
+  }
+
   fd_topob_finish( topo, fdctl_obj_align, fdctl_obj_footprint, fdctl_obj_loose );
   config->topo = *topo;
 }
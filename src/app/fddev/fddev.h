@@ -96,6 +96,15 @@ void
 dump_cmd_fn( args_t *         args,
              config_t * const config );
 
+void
+trace_cmd_args( int      * argc,
+                char * * * argv,
+                args_t   * args );
+
+void
+trace_cmd_fn( args_t *         args,
+              config_t * const config );
+
 void
 flame_cmd_perm( args_t *         args,
                 fd_caps_ctx_t *  caps,
@@ -95,6 +95,7 @@ static action_t DEV_ACTIONS[] = {
   { .name = "spammer", .args = spammer_cmd_args, .fn = spammer_cmd_fn, .perm = spammer_cmd_perm },
   { .name = "dump",    .args = dump_cmd_args,    .fn = dump_cmd_fn,    .perm = NULL             },
   { .name = "flame",   .args = flame_cmd_args,   .fn = flame_cmd_fn,   .perm = flame_cmd_perm   },
+  { .name = "trace",   .args = trace_cmd_args,   .fn = trace_cmd_fn,   .perm = NULL             },
 };
 
 extern char fd_log_private_path[ 1024 ];
@@ -0,0 +1,205 @@
+#include "fddev.h"
+#include "../../disco/trace/fd_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SORT_NAME  sort_latency
+#define SORT_KEY_T long
+#include "../../util/tmpl/fd_sort.c"
+
+void
+trace_cmd_args( int      * argc,
+                char * * * argv,
+                args_t   * args ) {
+  char const * out_file    = fd_env_strip_cmdline_cstr ( argc, argv, "--out-file",    NULL, "trace.json" );
+  float        duration    = fd_env_strip_cmdline_float( argc, argv, "--duration",    NULL, 10.f         );
+  ulong        max_records = fd_env_strip_cmdline_ulong( argc, argv, "--max-records", NULL, 1UL<<20      );
+
+  if( FD_UNLIKELY( duration<0.f ) ) FD_LOG_ERR(( "--duration must be non-negative" ));
+  if( FD_UNLIKELY( !max_records ) ) FD_LOG_ERR(( "--max-records must be positive" ));
+
+  fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( args->trace.json_path ), out_file, sizeof(args->trace.json_path)-1UL ) );
+  args->trace.duration_ns = (long)(1e9f*duration);
+  args->trace.max_records = max_records;
+}
+
+/* in_link_name returns the name of the link that the tile receives
+   frags on for the given mux in_idx, which only counts polled links. */
+
+static char const *
+in_link_name( fd_topo_t const *      topo,
+              fd_topo_tile_t const * tile,
+              ulong                  in_idx ) {
+  ulong polled = 0UL;
+  for( ulong i=0UL; i<tile->in_cnt; i++ ) {
+    if( FD_UNLIKELY( !tile->in_link_poll[ i ] ) ) continue;
+    if( polled==in_idx ) return topo->links[ tile->in_link_id[ i ] ].name;
+    polled++;
+  }
+  return "unknown";
+}
+
+/* Latencies of a record, in ticks.  queue is how long the frag waited
+   on the link between being published by the producer and the tile
+   starting to process it.  age is how long since the frag (or the
+   transaction it carries) originated when the tile finished with it.
+   Both are negative if the producer does not set a timestamp. */
+
+static inline long rec_queue( fd_trace_rec_t const * rec ) { return rec->ts - fd_frag_meta_ts_decomp( rec->tspub, rec->ts ); }
+static inline long rec_age  ( fd_trace_rec_t const * rec ) { return rec->ts + (long)rec->dur - fd_frag_meta_ts_decomp( rec->tsorig, rec->ts ); }
+
+static void
+print_percentiles( char const * label,
+                   long *       lat,
+                   ulong        cnt,
+                   double       ns_per_tick ) {
+  if( FD_UNLIKELY( !cnt ) ) {
+    printf( "    %-12s %12s %12s %12s\n", label, "-", "-", "-" );
+    return;
+  }
+  sort_latency_inplace( lat, cnt );
+  printf( "    %-12s %12.3f %12.3f %12.3f\n", label,
+          1e-3*ns_per_tick*(double)lat[ (cnt*50UL)/100UL ],
+          1e-3*ns_per_tick*(double)lat[ (cnt*99UL)/100UL ],
+          1e-3*ns_per_tick*(double)lat[ cnt-1UL ] );
+}
+
+static void
+print_tile_stats( fd_topo_tile_t const * tile,
+                  fd_trace_rec_t const * recs,
+                  ulong                  cnt,
+                  ulong                  lost,
+                  long *                 scratch,
+                  double                 ns_per_tick ) {
+  ulong filter_cnt = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) filter_cnt += (ulong)(recs[ i ].event==FD_TRACE_EVENT_FILTER);
+
+  printf( "%s:%lu (%lu records, %lu filtered, %lu lost)\n", tile->name, tile->kind_id, cnt, filter_cnt, lost );
+  if( FD_UNLIKELY( !cnt ) ) return;
+  printf( "    %-12s %12s %12s %12s\n", "(us)", "p50", "p99", "max" );
+
+  ulong n = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) { long x = rec_queue( recs+i ); if( FD_LIKELY( x>=0L ) ) scratch[ n++ ] = x; }
+  print_percentiles( "queue", scratch, n, ns_per_tick );
+
+  for( ulong i=0UL; i<cnt; i++ ) scratch[ i ] = (long)recs[ i ].dur;
+  print_percentiles( "processing", scratch, cnt, ns_per_tick );
+
+  n = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) { long x = rec_age( recs+i ); if( FD_LIKELY( x>=0L ) ) scratch[ n++ ] = x; }
+  print_percentiles( "age", scratch, n, ns_per_tick );
+}
+
+/* write_json writes the records in the Chrome trace event format, which
+   can be loaded in Perfetto (ui.perfetto.dev) or chrome://tracing.
+   Each tile is a thread, and each traced frag is a complete event on
+   it, named after the link it arrived on. */
+
+static void
+write_json( FILE *                  out,
+            fd_topo_t const *       topo,
+            fd_trace_rec_t * const * recs,
+            ulong const *           cnt,
+            double                  ns_per_tick ) {
+  long t0 = LONG_MAX;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    if( FD_LIKELY( cnt[ i ] ) ) t0 = fd_long_min( t0, recs[ i ][ 0 ].ts );
+  }
+
+  fprintf( out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+  fprintf( out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"%s\"}}", topo->app_name );
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t const * tile = &topo->tiles[ i ];
+    fprintf( out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"%s:%lu\"}}", i, tile->name, tile->kind_id );
+    fprintf( out, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"sort_index\":%lu}}", i, i );
+  }
+
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t const * tile = &topo->tiles[ i ];
+    for( ulong j=0UL; j<cnt[ i ]; j++ ) {
+      fd_trace_rec_t const * rec = recs[ i ]+j;
+      int filter = rec->event==FD_TRACE_EVENT_FILTER;
+      fprintf( out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f,"
+                    "\"args\":{\"sig\":\"0x%016lx\",\"sz\":%u,\"queue_us\":%.3f,\"age_us\":%.3f}}",
+               in_link_name( topo, tile, rec->in_idx ), filter ? "filter" : "publish", i,
+               1e-3*ns_per_tick*(double)(rec->ts-t0), 1e-3*ns_per_tick*(double)rec->dur,
+               rec->sig, (uint)rec->sz,
+               1e-3*ns_per_tick*(double)rec_queue( rec ), 1e-3*ns_per_tick*(double)rec_age( rec ) );
+    }
+  }
+  fprintf( out, "\n]}\n" );
+}
+
+void
+trace_cmd_fn( args_t *         args,
+              config_t * const config ) {
+  fd_topo_t * topo = &config->topo;
+
+  fd_topo_join_workspaces( topo, FD_SHMEM_JOIN_MODE_READ_ONLY );
+  fd_topo_fill( topo );
+
+  ulong max_records = args->trace.max_records;
+
+  fd_trace_rec_t * recs[ FD_TOPO_MAX_TILES ];
+  ulong            cnt [ FD_TOPO_MAX_TILES ];
+  ulong            seq [ FD_TOPO_MAX_TILES ];
+  ulong            lost[ FD_TOPO_MAX_TILES ];
+
+  ulong traced_cnt = 0UL;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_trace_t const * trace = topo->tiles[ i ].trace;
+    FD_TEST( trace );
+    traced_cnt += (ulong)!!trace->sample_rate;
+
+    recs[ i ] = malloc( max_records*sizeof(fd_trace_rec_t) );
+    if( FD_UNLIKELY( !recs[ i ] ) ) FD_LOG_ERR(( "malloc failed, try a smaller --max-records" ));
+    cnt [ i ] = 0UL;
+    lost[ i ] = 0UL;
+
+    /* Start from whatever is already in the ring, so that a trace of
+       zero duration dumps the current contents of the recorder. */
+    ulong seq_now = FD_VOLATILE_CONST( trace->seq );
+    seq[ i ] = fd_ulong_if( seq_now>trace->depth, seq_now-trace->depth, 0UL );
+  }
+
+  if( FD_UNLIKELY( !traced_cnt ) )
+    FD_LOG_ERR(( "tracing is disabled, set [tiles.metric.trace_sample_rate] in the configuration to a power of two and restart" ));
+
+  FD_LOG_NOTICE(( "Tracing for %.3f seconds", 1e-9*(double)args->trace.duration_ns ));
+
+  long deadline = fd_log_wallclock() + args->trace.duration_ns;
+  for(;;) {
+    /* Poll every 10ms, which is frequent enough that the rings do not
+       wrap unless a tile is sampling every frag under heavy load. */
+    int full = 1;
+    for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+      cnt[ i ] += fd_trace_snapshot( topo->tiles[ i ].trace, seq+i, recs[ i ]+cnt[ i ], max_records-cnt[ i ], lost+i );
+      full &= cnt[ i ]==max_records;
+    }
+    if( FD_UNLIKELY( full || fd_log_wallclock()>=deadline ) ) break;
+    fd_log_sleep( 10000000L );
+  }
+
+  double ns_per_tick = 1./fd_tempo_tick_per_ns( NULL );
+
+  ulong max_cnt = 1UL;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) max_cnt = fd_ulong_max( max_cnt, cnt[ i ] );
+  long * scratch = malloc( max_cnt*sizeof(long) );
+  if( FD_UNLIKELY( !scratch ) ) FD_LOG_ERR(( "malloc failed, try a smaller --max-records" ));
+
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    if( FD_UNLIKELY( !topo->tiles[ i ].trace->sample_rate ) ) continue;
+    print_tile_stats( &topo->tiles[ i ], recs[ i ], cnt[ i ], lost[ i ], scratch, ns_per_tick );
+  }
+
+  FILE * out = fopen( args->trace.json_path, "w" );
+  if( FD_UNLIKELY( !out ) ) FD_LOG_ERR(( "fopen(%s) failed (%i-%s)", args->trace.json_path, errno, fd_io_strerror( errno ) ));
+  write_json( out, topo, recs, cnt, ns_per_tick );
+  if( FD_UNLIKELY( fclose( out ) ) ) FD_LOG_ERR(( "fclose(%s) failed (%i-%s)", args->trace.json_path, errno, fd_io_strerror( errno ) ));
+  FD_LOG_NOTICE(( "Wrote trace to %s", args->trace.json_path ));
+
+  free( scratch );
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) free( recs[ i ] );
+  fd_topo_leave_workspaces( topo );
+}
@@ -16,6 +16,7 @@
 #include "../../funk/fd_funk.h"
 #include "../../flamenco/types/fd_types.h"
 #include "../../flamenco/runtime/fd_runtime.h"
+#include "../../flamenco/runtime/fd_runtime_prof.h"
 #include "../../flamenco/runtime/fd_account.h"
 #include "../../flamenco/runtime/fd_rocksdb.h"
 #include "../../ballet/base58/fd_base58.h"
@@ -26,6 +27,7 @@
 #include "../../flamenco/shredcap/fd_shredcap.h"
 #include "../../flamenco/runtime/program/fd_bpf_program_util.h"
 #include "../../flamenco/snapshot/fd_snapshot.h"
+#include "../../tango/tempo/fd_tempo.h"
 
 #pragma GCC diagnostic ignored "-Wformat"
 #pragma GCC diagnostic ignored "-Wformat-extra-args"
@@ -35,16 +37,23 @@ extern void fd_write_builtin_bogus_account( fd_exec_slot_ctx_t * slot_ctx, uchar
 static void usage( char const * progname ) {
   /* TODO: THIS IS OUT OF DATE AND MAY BE MISSING ARGS, REFER TO THE ARGUMENT PARSER */
   fprintf( stderr, "fd_ledger usage: %s\n", progname );
-  fprintf( stderr, " --cmd ingest <ingest|prune|minify|replay>       \n" );
+  fprintf( stderr, " --cmd ingest <ingest|prune|minify|replay|prof>  \n" );
   fprintf( stderr, " --abort-on-mismatch <int>                  abort on mismatch\n" );
   fprintf( stderr, " --allocator <allocator>                    allocator to use\n" );
   fprintf( stderr, " --capture-solcap <capture file>            capture solcap\n" ); /* Capture context tool for solcaps*/
   fprintf( stderr, " --capture-txns <int>                       capture transactions\n" );
+  fprintf( stderr, " --capture-async <int>                      write the solcap from a dedicated tile\n" );
+  fprintf( stderr, " --capture-ring-sz <ulong>                  bytes queued for the solcap writer tile\n" );
+  fprintf( stderr, " --capture-slot-stride <ulong>              only capture slots that are a multiple of this\n" );
+  fprintf( stderr, " --capture-accounts <pubkey,...>            only capture these accounts\n" );
   fprintf( stderr, " --check-acc-hash <uint>                    check account hash against hash generated by data\n" );
   fprintf( stderr, " --checkpt <checkpoint file>                checkpoint wksp into file after execution\n" ); /* Capture context tool for runtime checkpoints */
   fprintf( stderr, " --checkpt-freq <ulong>                     checkpoint frequency\n" );
   fprintf( stderr, " --checkpt-mismatch <int>                   checkpoint on mismatch at last rooted slot\n" );
   fprintf( stderr, " --checkpt-path <checkpoint path>           path to checkpoint\n" );
+  fprintf( stderr, " --checkpt-style <int>                      checkpoint style (0 default, 1 raw, 2 parallel frames)\n" );
+  fprintf( stderr, " --checkpt-base <checkpoint file>           write --checkpt incrementally against this frame checkpoint\n" );
+  fprintf( stderr, " --checkpt-funk-base <checkpoint file>      write --checkpt-funk incrementally against this frame checkpoint\n" );
   fprintf( stderr, " --copy-txn-status <int>                    copy transaction status from rocksdb into blockstore\n" );
   fprintf( stderr, " --dump-insn-output-dir <insn output dir>   dump instructions output directory\n" ); /* Capture ctx tool for insn dumping*/
   fprintf( stderr, " --dump-insn-sig-filter <insn sig filter>   dump instructions signature filter\n" );
@@ -61,7 +70,13 @@ static void usage( char const * progname ) {
   fprintf( stderr, " --minified-rocksdb <mini rocksdb dir>      minified rocksdb directory\n" );
   fprintf( stderr, " --on-demand-block-history <ulong>          on demand block history\n" ); /* On demand block reading */
   fprintf( stderr, " --on-demand-block-ingest <int>             on demand block ingest\n" );
+  fprintf( stderr, " --ingest-tile-cnt <ulong>                  tiles reserved for prefetching blocks from rocksdb (0 reads inline)\n" );
+  fprintf( stderr, " --ingest-depth <ulong>                     max ranges of %lu slots prefetched ahead of the blockstore / replay\n", FD_ROCKSDB_PREFETCH_RANGE_SZ );
   fprintf( stderr, " --page-cnt <page count>                    number of pages for anon wksp\n" );
+  fprintf( stderr, " --prof <int>                               profile replay per program, syscall and phase\n" ); /* Replay profiler */
+  fprintf( stderr, " --prof-prog-max <ulong>                    distinct program instruction types profiled per tile\n" );
+  fprintf( stderr, " --prof-slot-max <ulong>                    number of slots kept in the profile history\n" );
+  fprintf( stderr, " --prof-top <ulong>                         number of hotspots reported by --cmd prof\n" );
   fprintf( stderr, " --pruned-index-max <ulong>                 number of records to index in pruned funk\n" ); /* Prune related */
   fprintf( stderr, " --pruned-page-cnt <ulong>                  number of pages for pruned anon wksp\n" );
   fprintf( stderr, " --reset <int>                              reset workspace\n" );
@@ -93,6 +108,9 @@ struct fd_ledger_args {
   uint              hashseed;
   char const *      checkpt;
   char const *      checkpt_funk;
+  int               checkpt_style;
+  char const *      checkpt_base;
+  char const *      checkpt_funk_base;
   char const *      restore;
   char const *      restore_funk;
   char const *      allocator;
@@ -111,8 +129,15 @@ struct fd_ledger_args {
   ulong             index_max_pruned;
   int               abort_on_mismatch;
   int               on_demand_block_ingest;
+  ulong             ingest_tile_cnt; /* tiles [fd_tile_cnt()-ingest_tile_cnt,fd_tile_cnt()) prefetch from rocksdb */
+  ulong             ingest_depth;
   char const *      capture_fpath; /* solcap */
   int               capture_txns;
+  int               capture_async; /* tile fd_tile_cnt()-ingest_tile_cnt-1 writes the solcap */
+  ulong             capture_ring_sz;
+  ulong             capture_slot_stride;
+  fd_pubkey_t       capture_accounts[ 32UL ]; /* [ Max items ] */
+  ulong             capture_account_cnt;
   char const *      checkpt_path; /* runtime checkpoints */
   ulong             checkpt_freq;
   int               checkpt_mismatch;
@@ -129,6 +154,11 @@ struct fd_ledger_args {
   ulong             vote_acct_max;
   char const *      rocksdb_list[ 32UL ]; /* [ Max items ] */
   ulong             rocksdb_list_cnt;
+  int               prof_enabled;
+  ulong             prof_prog_max;
+  ulong             prof_slot_max;
+  ulong             prof_top;
+  fd_runtime_prof_t * prof;
   #ifdef _ENABLE_LTHASH
   char const *      lthash;
   #endif
@@ -157,8 +187,10 @@ fd_valloc_t allocator_setup( fd_wksp_t * wksp, char const * allocator ) {
 }
 
 static void *
-setup_tpool( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_valloc_t valloc ) {
-  runtime_args->tcnt = fd_tile_cnt();
+setup_tpool( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_valloc_t valloc, ulong reserved_tile_cnt ) {
+  /* The last reserved_tile_cnt tiles are left for rocksdb prefetching
+     and the capture writer */
+  runtime_args->tcnt = fd_tile_cnt() - reserved_tile_cnt;
   uchar * tpool_scr_mem = NULL;
   fd_tpool_t * tpool = NULL;
   if( runtime_args->tcnt > 1 ) {
@@ -212,15 +244,15 @@ runtime_replay( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_l
 
   ulong start_slot = state->slot_ctx->slot_bank.slot + 1;
 
-  /* On demand rocksdb ingest */
-  fd_rocksdb_t rocks_db       = {0};
-  fd_rocksdb_root_iter_t iter = {0};
-  fd_slot_meta_t slot_meta    = {0};
-  ulong curr_rocksdb_idx      = 0UL;
+  /* On demand rocksdb ingest.  Blocks are prefetched (on the ingest
+     tiles if any) while earlier blocks are executing. */
+  static fd_rocksdb_prefetch_t prefetch[1];
+  fd_rocksdb_block_t * prefetch_blk = NULL;
+  int                  prefetch_end = 0;
   if( runtime_args->on_demand_block_ingest ) {
-    fd_rocksdb_init( &rocks_db, ledger_args->rocksdb_list[ 0UL ] );
-    fd_rocksdb_root_iter_new( &iter );
-    if( fd_rocksdb_root_iter_seek( &iter, &rocks_db, start_slot, &slot_meta, state->slot_ctx->valloc ) ) {
+    if( !fd_rocksdb_prefetch_init( prefetch, ledger_args->rocksdb_list, ledger_args->rocksdb_list_cnt, start_slot,
+                                   runtime_args->end_slot, runtime_args->trash_hash, ledger_args->ingest_depth,
+                                   fd_tile_cnt()-ledger_args->ingest_tile_cnt, ledger_args->ingest_tile_cnt ) ) {
       FD_LOG_ERR(( "unable to seek to first slot" ));
     }
   }
@@ -236,10 +268,6 @@ runtime_replay( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_l
     fd_funk_end_write( state->capture_ctx->pruned_funk );
   }
 
-  /* Setup trash_hash */
-  uchar trash_hash_buf[32];
-  memset( trash_hash_buf, 0xFE, sizeof(trash_hash_buf) );
-
   for( ulong slot = start_slot; slot <= runtime_args->end_slot; ++slot ) {
     state->slot_ctx->slot_bank.prev_slot = prev_slot;
     state->slot_ctx->slot_bank.slot      = slot;
@@ -253,11 +281,22 @@ runtime_replay( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_l
     }
 
     if( runtime_args->on_demand_block_ingest ) {
-      if( fd_blockstore_block_query( blockstore, slot ) == NULL && slot_meta.slot == slot ) {
-        int err = fd_rocksdb_import_block_blockstore( &rocks_db, &slot_meta, blockstore,
-                                                      runtime_args->copy_txn_status, slot == (runtime_args->trash_hash) ? trash_hash_buf : NULL );
-        if( FD_UNLIKELY( err ) ) {
-          FD_LOG_ERR(( "Failed to import block %lu", start_slot ));
+      if( fd_blockstore_block_query( blockstore, slot ) == NULL ) {
+        /* Skip prefetched blocks before slot (already in the blockstore) */
+        for(;;) {
+          int err = 0;
+          if( !prefetch_blk && !prefetch_end ) {
+            prefetch_blk = fd_rocksdb_prefetch_next( prefetch, &err );
+            prefetch_end = !prefetch_blk;
+          }
+          if( !prefetch_blk || prefetch_blk->slot > slot ) break;
+          int found = prefetch_blk->slot == slot;
+          if( found && ( err || fd_rocksdb_block_insert( prefetch_blk, blockstore, runtime_args->copy_txn_status ) ) ) {
+            FD_LOG_ERR(( "Failed to import block %lu", slot ));
+          }
+          fd_rocksdb_prefetch_release( prefetch );
+          prefetch_blk = NULL;
+          if( found ) break;
         }
       }
       fd_blockstore_slot_remove( blockstore, slot - runtime_args->on_demand_block_history );
@@ -327,32 +366,6 @@ runtime_replay( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_l
     fd_blockstore_end_read( blockstore );
 
     prev_slot = slot;
-
-    if( runtime_args->on_demand_block_ingest && slot < runtime_args->end_slot ) {
-      int ret = fd_rocksdb_root_iter_next( &iter, &slot_meta, state->slot_ctx->valloc );
-      if( ret<0 ) {
-        ret = fd_rocksdb_get_meta( &rocks_db, slot+1UL, &slot_meta, state->slot_ctx->valloc );
-        if( ret<0 ) {
-          /* If slot doesn't exist try to look in the next indexed rocksdb */
-          if( ++curr_rocksdb_idx>=ledger_args->rocksdb_list_cnt ) {
-            FD_LOG_ERR(( "Failed to get meta for slot %lu", slot+1UL ));
-          }
-          fd_rocksdb_root_iter_destroy( &iter );
-          fd_rocksdb_destroy( &rocks_db );
-
-          fd_memset( &rocks_db,  0, sizeof(fd_rocksdb_t)           );
-          fd_memset( &iter,      0, sizeof(fd_rocksdb_root_iter_t) );
-          fd_memset( &slot_meta, 0, sizeof(fd_slot_meta_t)         );
-
-          fd_rocksdb_init( &rocks_db, ledger_args->rocksdb_list[ curr_rocksdb_idx ] );
-          fd_rocksdb_root_iter_new( &iter );
-          ret = fd_rocksdb_root_iter_seek( &iter, &rocks_db, slot+1UL, &slot_meta, state->slot_ctx->valloc );
-          if( ret<0 ) {
-            FD_LOG_ERR(( "Failed to seek to slot %lu", slot+1UL ));
-          }
-        }
-      }
-    }
   }
 
   if( state->tpool ) {
@@ -360,8 +373,7 @@ runtime_replay( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_l
   }
 
   if( runtime_args->on_demand_block_ingest ) {
-    fd_rocksdb_root_iter_destroy( &iter );
-    fd_rocksdb_destroy( &rocks_db );
+    fd_rocksdb_prefetch_fini( prefetch );
   }
 
   replay_time += fd_log_wallclock();
@@ -385,15 +397,15 @@ runtime_replay( fd_runtime_ctx_t * state, fd_runtime_args_t * runtime_args, fd_l
 
 /***************************** Helpers ****************************************/
 void
-ingest_rocksdb( fd_alloc_t *      alloc,
-                char const *      file,
+ingest_rocksdb( char const *      file,
                 ulong             start_slot,
                 ulong             end_slot,
                 fd_blockstore_t * blockstore,
-                int txn_status,
-                ulong trash_hash ) {
+                int               txn_status,
+                ulong             trash_hash,
+                ulong             ingest_tile_cnt,
+                ulong             ingest_depth ) {
 
-  fd_valloc_t valloc = fd_alloc_virtual( alloc );
   fd_rocksdb_t rocks_db;
   char *err = fd_rocksdb_init( &rocks_db, file );
   if( err != NULL ) {
@@ -410,58 +422,41 @@ ingest_rocksdb( fd_alloc_t *      alloc,
                  fd_rocksdb_first_slot(&rocks_db, &err), last_slot, start_slot ));
   }
 
-  FD_LOG_NOTICE(( "ingesting rocksdb from start=%lu to end=%lu", start_slot, end_slot ));
+  fd_rocksdb_destroy( &rocks_db );
 
-  fd_rocksdb_root_iter_t iter;
-  fd_rocksdb_root_iter_new( &iter );
+  FD_LOG_NOTICE(( "ingesting rocksdb from start=%lu to end=%lu (%lu prefetch tiles)", start_slot, end_slot, ingest_tile_cnt ));
 
-  fd_slot_meta_t slot_meta;
-  fd_memset( &slot_meta, 0, sizeof(slot_meta) );
+  /* Blocks are read from rocksdb (on the ingest tiles if any) ahead of
+     being deshredded into the blockstore here */
 
-  int ret = fd_rocksdb_root_iter_seek( &iter, &rocks_db, start_slot, &slot_meta, valloc );
-  if( ret < 0 ) {
-    FD_LOG_ERR(( "fd_rocksdb_root_iter_seek returned %d", ret ));
+  static fd_rocksdb_prefetch_t prefetch[1];
+  if( !fd_rocksdb_prefetch_init( prefetch, &file, 1UL, start_slot, end_slot, trash_hash, ingest_depth,
+                                 fd_tile_cnt()-ingest_tile_cnt, ingest_tile_cnt ) ) {
+    FD_LOG_ERR(( "fd_rocksdb_prefetch_init failed" ));
   }
 
-  uchar trash_hash_buf[32];
-  memset( trash_hash_buf, 0xFE, sizeof(trash_hash_buf) );
-
   ulong blk_cnt = 0;
-  do {
-    ulong slot = slot_meta.slot;
-    if( slot > end_slot ) {
+  for(;;) {
+    int read_err = 0;
+    fd_rocksdb_block_t * blk = fd_rocksdb_prefetch_next( prefetch, &read_err );
+    if( !blk ) {
       break;
     }
 
-    /* Read and deshred block from RocksDB */
     if( blk_cnt % 100 == 0 ) {
       FD_LOG_WARNING(( "imported %lu blocks", blk_cnt ));
     }
 
-    int err = fd_rocksdb_import_block_blockstore( &rocks_db, &slot_meta, blockstore, txn_status,
-                                                  (slot == trash_hash) ? trash_hash_buf : NULL );
-    if( FD_UNLIKELY( err ) ) {
+    if( FD_UNLIKELY( read_err || fd_rocksdb_block_insert( blk, blockstore, txn_status ) ) ) {
       FD_LOG_ERR(( "fd_rocksdb_get_block failed" ));
     }
 
     ++blk_cnt;
 
-    fd_bincode_destroy_ctx_t ctx = { .valloc = valloc };
-    fd_slot_meta_destroy( &slot_meta, &ctx );
-
-    ret = fd_rocksdb_root_iter_next( &iter, &slot_meta, valloc );
-    if( ret < 0 ) {
-      // FD_LOG_WARNING(("Failed for slot %lu", slot + 1));
-      ret = fd_rocksdb_get_meta( &rocks_db, slot + 1, &slot_meta, valloc );
-      if( ret < 0 ) {
-        break;
-      }
-    }
-      // FD_LOG_ERR(("fd_rocksdb_root_iter_seek returned %d", ret));
-  } while (1);
+    fd_rocksdb_prefetch_release( prefetch );
+  }
 
-  fd_rocksdb_root_iter_destroy( &iter );
-  fd_rocksdb_destroy( &rocks_db );
+  fd_rocksdb_prefetch_fini( prefetch );
 
   FD_LOG_NOTICE(( "ingested %lu blocks", blk_cnt ));
 }
@@ -495,6 +490,24 @@ parse_rocksdb_list(  fd_ledger_args_t * FD_FN_UNUSED args, char const * rocksdb_
      string but it's not a big deal. */
 } 
 
+static void
+parse_capture_accounts( fd_ledger_args_t * args, char const * capture_accounts ) {
+  args->capture_account_cnt = 0UL;
+  if( !capture_accounts ) return;
+
+  char * accounts_str = strdup( capture_accounts );
+  for( char * token = strtok( accounts_str, "," ); token; token = strtok( NULL, "," ) ) {
+    if( FD_UNLIKELY( args->capture_account_cnt>=sizeof(args->capture_accounts)/sizeof(fd_pubkey_t) ) ) {
+      FD_LOG_ERR(( "--capture-accounts has more than %lu accounts", sizeof(args->capture_accounts)/sizeof(fd_pubkey_t) ));
+    }
+    if( FD_UNLIKELY( !fd_base58_decode_32( token, args->capture_accounts[ args->capture_account_cnt ].uc ) ) ) {
+      FD_LOG_ERR(( "--capture-accounts has invalid pubkey %s", token ));
+    }
+    args->capture_account_cnt++;
+  }
+  free( accounts_str );
+}
+
 void
 init_scratch( fd_wksp_t * wksp ) {
   #define FD_SCRATCH_TAG (421UL)
@@ -577,6 +590,147 @@ init_blockstore( fd_ledger_args_t * args ) {
   }
 }
 
+void
+init_prof( fd_ledger_args_t * args ) {
+  fd_wksp_tag_query_info_t info;
+  ulong prof_tag = FD_RUNTIME_PROF_MAGIC;
+  void * shmem;
+  if( fd_wksp_tag_query( args->wksp, &prof_tag, 1, &info, 1 ) > 0 ) {
+    /* Keep accumulating into the profiler of a previous replay */
+    shmem = fd_wksp_laddr_fast( args->wksp, info.gaddr_lo );
+    args->prof = fd_runtime_prof_join( shmem );
+    if( args->prof == NULL ) {
+      FD_LOG_ERR(( "failed to join a profiler" ));
+    }
+    FD_LOG_NOTICE(( "joined profiler" ));
+  } else {
+    ulong shard_cnt = fd_tile_cnt();
+    shmem = fd_wksp_alloc_laddr( args->wksp, fd_runtime_prof_align(),
+                                 fd_runtime_prof_footprint( shard_cnt, args->prof_prog_max, args->prof_slot_max ), prof_tag );
+    if( shmem == NULL ) {
+      FD_LOG_ERR(( "failed to allocate a profiler" ));
+    }
+    args->prof = fd_runtime_prof_join( fd_runtime_prof_new( shmem, shard_cnt, args->prof_prog_max, args->prof_slot_max ) );
+    if( args->prof == NULL ) {
+      fd_wksp_free_laddr( shmem );
+      FD_LOG_ERR(( "failed to allocate a profiler" ));
+    }
+    FD_LOG_NOTICE(( "profiler at global address 0x%016lx", fd_wksp_gaddr_fast( args->wksp, shmem ) ));
+  }
+}
+
+static long
+prof_slot_ticks( fd_runtime_prof_slot_t const * slot ) {
+  long ticks = 0L;
+  for( int i=0; i<FD_RUNTIME_PROF_PHASE_CNT; i++ ) ticks += slot->ticks[ i ];
+  return ticks;
+}
+
+#define SORT_NAME        prof_slot_sort
+#define SORT_KEY_T       fd_runtime_prof_slot_t
+#define SORT_BEFORE(a,b) (prof_slot_ticks( &(a) )>prof_slot_ticks( &(b) ))
+#include "../../util/tmpl/fd_sort.c"
+
+/* prof_report prints the top hotspots recorded by a replay profiler */
+
+void
+prof_report( fd_runtime_prof_t const * prof, ulong top ) {
+  double ns_per_tick = 1.0 / fd_tempo_tick_per_ns( NULL );
+
+  ulong instr_cnt;
+  ulong cus;
+  ulong drop_cnt;
+  fd_runtime_prof_totals( prof, &instr_cnt, &cus, &drop_cnt );
+  ulong slot_cnt = FD_VOLATILE_CONST( prof->slot_cnt );
+  printf( "slots %lu, instructions %lu, cus %lu, dropped %lu\n", slot_cnt, instr_cnt, cus, drop_cnt );
+
+  printf( "\n%-10s %12s %14s %12s\n", "phase", "calls", "total ms", "ms/slot" );
+  for( int i=0; i<FD_RUNTIME_PROF_PHASE_CNT; i++ ) {
+    double ms = (double)prof->phase_ticks[ i ] * ns_per_tick * 1e-6;
+    printf( "%-10s %12lu %14.3f %12.3f\n", fd_runtime_prof_phase_name( i ), prof->phase_cnt[ i ], ms,
+            ms / (double)fd_ulong_max( slot_cnt, 1UL ) );
+  }
+
+  printf( "\n%-22s %10s %14s %12s %12s\n", "publish records", "calls", "records", "ms/call", "max ms" );
+  for( ulong i=0UL; i<FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT; i++ ) {
+    fd_runtime_prof_publish_t const * b = prof->publish + i;
+    if( !b->cnt ) continue;
+    char range[ 32 ];
+    if(      !i                                        ) fd_cstr_printf( range, sizeof(range), NULL, "0" );
+    else if( i==FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT-1UL ) fd_cstr_printf( range, sizeof(range), NULL, "[%lu,inf)", 1UL<<(i-1UL) );
+    else                                                 fd_cstr_printf( range, sizeof(range), NULL, "[%lu,%lu)", 1UL<<(i-1UL), 1UL<<i );
+    printf( "%-22s %10lu %14lu %12.3f %12.3f\n", range, b->cnt, b->rec_cnt,
+            (double)b->ticks * ns_per_tick * 1e-6 / (double)b->cnt, (double)b->ticks_max * ns_per_tick * 1e-6 );
+  }
+
+  ulong prog_max = prof->shard_cnt * prof->prog_max;
+  fd_runtime_prof_prog_t * prog = malloc( prog_max * sizeof(fd_runtime_prof_prog_t) );
+  if( FD_UNLIKELY( !prog ) ) FD_LOG_ERR(( "malloc failed" ));
+  ulong prog_cnt = fd_runtime_prof_prog_top( prof, prog, prog_max );
+  long  prog_ticks = 0L;
+  for( ulong i=0UL; i<prog_cnt; i++ ) prog_ticks += (long)prog[ i ].ticks;
+
+  printf( "\n%-4s %-44s %4s %12s %14s %12s %7s\n", "rank", "program", "ix", "calls", "cus", "ms", "time %" );
+  for( ulong i=0UL; i<fd_ulong_min( prog_cnt, top ); i++ ) {
+    char ix[ 8 ];
+    if( prog[ i ].key.ix==FD_RUNTIME_PROF_IX_NONE ) fd_cstr_printf( ix, sizeof(ix), NULL, "-" );
+    else                                            fd_cstr_printf( ix, sizeof(ix), NULL, "%lu", prog[ i ].key.ix );
+    char id[ FD_BASE58_ENCODED_32_SZ ];
+    fd_base58_encode_32( prog[ i ].key.id.uc, NULL, id );
+    printf( "%-4lu %-44s %4s %12lu %14lu %12.3f %7.2f\n", i+1UL, id, ix,
+            prog[ i ].cnt, prog[ i ].cus, (double)prog[ i ].ticks * ns_per_tick * 1e-6,
+            100.0 * (double)prog[ i ].ticks / (double)fd_long_max( prog_ticks, 1L ) );
+  }
+  free( prog );
+
+  fd_runtime_prof_syscall_t syscall[ 256 ];
+  ulong syscall_cnt = fd_runtime_prof_syscall_top( prof, syscall, 256UL );
+  printf( "\n%-4s %-44s %12s %14s %12s %10s\n", "rank", "syscall", "calls", "cus", "ms", "ns/call" );
+  for( ulong i=0UL; i<fd_ulong_min( syscall_cnt, top ); i++ ) {
+    double ns = (double)syscall[ i ].ticks * ns_per_tick;
+    printf( "%-4lu %-44s %12lu %14lu %12.3f %10.1f\n", i+1UL, syscall[ i ].name, syscall[ i ].cnt, syscall[ i ].cus,
+            ns * 1e-6, ns / (double)fd_ulong_max( syscall[ i ].cnt, 1UL ) );
+  }
+
+  ulong hist_cnt = fd_ulong_min( slot_cnt, prof->slot_max );
+  fd_runtime_prof_slot_t * slot = malloc( fd_ulong_max( hist_cnt, 1UL ) * sizeof(fd_runtime_prof_slot_t) );
+  if( FD_UNLIKELY( !slot ) ) FD_LOG_ERR(( "malloc failed" ));
+  ulong slot_hist_cnt = 0UL;
+  for( ulong i=0UL; i<hist_cnt; i++ ) {
+    fd_runtime_prof_slot_t const * s = fd_runtime_prof_slot( prof, i );
+    if( s ) slot[ slot_hist_cnt++ ] = *s;
+  }
+  prof_slot_sort_inplace( slot, slot_hist_cnt );
+  printf( "\n%-4s %12s %8s %10s %12s %10s", "rank", "slot", "txns", "instrs", "cus", "ms" );
+  for( int j=0; j<FD_RUNTIME_PROF_PHASE_CNT; j++ ) printf( " %9s", fd_runtime_prof_phase_name( j ) );
+  printf( "\n" );
+  for( ulong i=0UL; i<fd_ulong_min( slot_hist_cnt, top ); i++ ) {
+    printf( "%-4lu %12lu %8lu %10lu %12lu %10.3f", i+1UL, slot[ i ].slot, slot[ i ].txn_cnt, slot[ i ].instr_cnt, slot[ i ].cus,
+            (double)prof_slot_ticks( slot + i ) * ns_per_tick * 1e-6 );
+    for( int j=0; j<FD_RUNTIME_PROF_PHASE_CNT; j++ ) printf( " %9.3f", (double)slot[ i ].ticks[ j ] * ns_per_tick * 1e-6 );
+    printf( "\n" );
+  }
+  free( slot );
+}
+
+/* prof reports the profiler left in --wksp-name by a replay with
+   --prof 1 (which can still be running) */
+
+void
+prof( fd_ledger_args_t * args ) {
+  fd_wksp_tag_query_info_t info;
+  ulong prof_tag = FD_RUNTIME_PROF_MAGIC;
+  if( fd_wksp_tag_query( args->wksp, &prof_tag, 1, &info, 1 ) <= 0 ) {
+    FD_LOG_ERR(( "no profiler in the workspace, replay with --prof 1 and --wksp-name" ));
+  }
+  fd_runtime_prof_t * prof = fd_runtime_prof_join( fd_wksp_laddr_fast( args->wksp, info.gaddr_lo ) );
+  if( prof == NULL ) {
+    FD_LOG_ERR(( "failed to join a profiler" ));
+  }
+  prof_report( prof, args->prof_top );
+  fd_runtime_prof_leave( prof );
+}
+
 void
 checkpt( fd_ledger_args_t * args, fd_exec_slot_ctx_t * slot_ctx ) {
   if( !args->checkpt && !args->checkpt_funk ) {
@@ -590,25 +744,51 @@ checkpt( fd_ledger_args_t * args, fd_exec_slot_ctx_t * slot_ctx ) {
     fd_funk_end_write( slot_ctx->acc_mgr->funk );
   }
 
+  if( (args->checkpt_base || args->checkpt_funk_base) && args->checkpt_style!=FD_WKSP_CHECKPT_STYLE_FRAME ) {
+    FD_LOG_ERR(( "--checkpt-base and --checkpt-funk-base require --checkpt-style %d", FD_WKSP_CHECKPT_STYLE_FRAME ));
+  }
+
+  /* Frame checkpts are written by all the tiles.  The replay tpool is
+     gone by now so use a local one (with as many tiles as are free). */
+
+  static uchar tpool_mem[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned( FD_TPOOL_ALIGN )));
+  fd_tpool_t * tpool = NULL;
+  ulong        t1    = 1UL;
+  if( args->checkpt_style==FD_WKSP_CHECKPT_STYLE_FRAME && fd_tile_cnt()>1UL ) {
+    tpool = fd_tpool_init( tpool_mem, fd_tile_cnt() );
+    if( tpool ) {
+      for( ulong i=1UL; i<fd_tile_cnt(); i++ ) {
+        if( !fd_tpool_worker_push( tpool, i, NULL, 0UL ) ) break;
+      }
+      t1 = fd_tpool_worker_cnt( tpool );
+    }
+  }
+
   if( args->checkpt_funk ) {
     if( args->funk_wksp == NULL ) {
       FD_LOG_ERR(( "funk_wksp is NULL" ));
     }
-    FD_LOG_NOTICE(( "writing funk checkpt %s", args->checkpt_funk ));
+    FD_LOG_NOTICE(( "writing funk checkpt %s (%lu threads)", args->checkpt_funk, t1 ));
     unlink( args->checkpt_funk );
-    int err = fd_wksp_checkpt( args->funk_wksp, args->checkpt_funk, 0666, 0, NULL );
+    int err = fd_wksp_checkpt_tpool( tpool, 0UL, t1, args->funk_wksp, args->checkpt_funk, 0666, args->checkpt_style, NULL,
+                                     args->checkpt_funk_base );
     if( err ) {
       FD_LOG_ERR(( "funk checkpt failed: error %d", err ));
     }
   }
   if( args->checkpt ) {
-    FD_LOG_NOTICE(( "writing %s", args->checkpt ));
+    FD_LOG_NOTICE(( "writing %s (%lu threads)", args->checkpt, t1 ));
     unlink( args->checkpt );
-    int err = fd_wksp_checkpt( args->wksp, args->checkpt, 0666, 0, NULL );
+    int err = fd_wksp_checkpt_tpool( tpool, 0UL, t1, args->wksp, args->checkpt, 0666, args->checkpt_style, NULL,
+                                     args->checkpt_base );
     if( err ) {
       FD_LOG_ERR(( "checkpt failed: error %d", err ));
     }
   }
+
+  if( tpool ) {
+    fd_tpool_fini( tpool );
+  }
 }
 
 void
@@ -673,8 +853,8 @@ minify( fd_ledger_args_t * args ) {
   if( args->copy_txn_status ) {
     init_blockstore( args );
     /* Ingest block range into blockstore */
-    ingest_rocksdb( args->alloc, args->rocksdb_list[ 0UL ], args->start_slot,
-                    args->end_slot, args->blockstore, 0, ULONG_MAX );
+    ingest_rocksdb( args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot,
+                    args->blockstore, 0, ULONG_MAX, args->ingest_tile_cnt, args->ingest_depth );
 
     fd_rocksdb_copy_over_txn_status_range( &big_rocksdb, &mini_rocksdb, args->blockstore,
                                            args->start_slot, args->end_slot );
@@ -743,8 +923,8 @@ ingest( fd_ledger_args_t * args ) {
     if( args->end_slot >= slot_ctx->slot_bank.slot + args->slot_history_max ) {
       args->end_slot = slot_ctx->slot_bank.slot + args->slot_history_max - 1;
     }
-    ingest_rocksdb( args->alloc, args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot,
-                    blockstore, args->copy_txn_status, args->trash_hash );
+    ingest_rocksdb( args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot,
+                    blockstore, args->copy_txn_status, args->trash_hash, args->ingest_tile_cnt, args->ingest_depth );
   }
 
   /* Verification */
@@ -886,6 +1066,11 @@ replay( fd_ledger_args_t * args ) {
   runtime_args.allocator               = args->allocator;
   runtime_args.capture_fpath           = args->capture_fpath;
   runtime_args.capture_txns            = args->capture_txns;
+  runtime_args.capture_async_tile      = args->capture_async ? fd_tile_cnt()-args->ingest_tile_cnt-1UL : 0UL;
+  runtime_args.capture_ring_sz         = args->capture_ring_sz;
+  runtime_args.capture_slot_stride     = args->capture_slot_stride;
+  runtime_args.capture_accounts        = args->capture_accounts;
+  runtime_args.capture_account_cnt     = args->capture_account_cnt;
   runtime_args.checkpt_path            = args->checkpt_path;
   runtime_args.checkpt_mismatch        = args->checkpt_mismatch;
   runtime_args.checkpt_freq            = args->checkpt_freq;
@@ -938,19 +1123,32 @@ replay( fd_ledger_args_t * args ) {
 
   fd_valloc_t valloc = allocator_setup( args->wksp, args->allocator );
 
-  void * tpool_scr_mem = setup_tpool( &state, &runtime_args, valloc );
+  void * tpool_scr_mem = setup_tpool( &state, &runtime_args, valloc, args->ingest_tile_cnt + (ulong)!!args->capture_async );
 
   fd_replay_t * replay = NULL;
   fd_tvu_main_setup( &state, &replay, NULL, NULL, 0, wksp, &runtime_args, NULL, capture_ctx, capture_file );
 
+  if( args->prof_enabled ) {
+    init_prof( args );
+    state.slot_ctx->prof = args->prof;
+  }
+
   if( !args->on_demand_block_ingest ) {
-    ingest_rocksdb( args->alloc, args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot, args->blockstore, 0, args->trash_hash );
+    ingest_rocksdb( args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot, args->blockstore, 0, args->trash_hash,
+                    args->ingest_tile_cnt, args->ingest_depth );
   }
 
   FD_LOG_WARNING(( "tvu main setup done" ));
 
   int ret = runtime_replay( &state, &runtime_args, args );
 
+  if( args->prof ) {
+    prof_report( args->prof, args->prof_top );
+    state.slot_ctx->prof = NULL;
+    fd_runtime_prof_leave( args->prof );
+    args->prof = NULL;
+  }
+
   if( tpool_scr_mem ) {
     fd_valloc_free( valloc, tpool_scr_mem );
   }
@@ -1104,7 +1302,7 @@ prune( fd_ledger_args_t * args ) {
 
   fd_valloc_t valloc = allocator_setup( args->wksp, runtime_args.allocator );
 
-  void * tpool_scr_mem = setup_tpool( &state, &runtime_args, valloc );
+  void * tpool_scr_mem = setup_tpool( &state, &runtime_args, valloc, args->ingest_tile_cnt );
 
   fd_tvu_main_setup( &state, &replay, &slot_ctx_unpruned, NULL, 0, unpruned_wksp, &runtime_args, gossip_deliver_arg, NULL, NULL );
 
@@ -1116,7 +1314,8 @@ prune( fd_ledger_args_t * args ) {
       args->end_slot = slot_ctx->slot_bank.slot + args->slot_history_max - 1;
     }
 
-    ingest_rocksdb( args->alloc, args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot, unpruned_blockstore, 0, args->trash_hash );
+    ingest_rocksdb( args->rocksdb_list[ 0UL ], args->start_slot, args->end_slot, unpruned_blockstore, 0, args->trash_hash,
+                    args->ingest_tile_cnt, args->ingest_depth );
     FD_LOG_NOTICE(( "imported unpruned rocksdb" ));
   }
 
@@ -1335,14 +1534,23 @@ initial_setup( int argc, char ** argv, fd_ledger_args_t * args ) {
   int          funk_only               = fd_env_strip_cmdline_int  ( &argc, &argv, "--funk-only",               NULL, 0         );
   char const * checkpt                 = fd_env_strip_cmdline_cstr ( &argc, &argv, "--checkpt",                 NULL, NULL      );
   char const * checkpt_funk            = fd_env_strip_cmdline_cstr ( &argc, &argv, "--checkpt-funk",            NULL, NULL      );
+  int          checkpt_style           = fd_env_strip_cmdline_int  ( &argc, &argv, "--checkpt-style",           NULL, 0         );
+  char const * checkpt_base            = fd_env_strip_cmdline_cstr ( &argc, &argv, "--checkpt-base",            NULL, NULL      );
+  char const * checkpt_funk_base       = fd_env_strip_cmdline_cstr ( &argc, &argv, "--checkpt-funk-base",       NULL, NULL      );
   char const * capture_fpath           = fd_env_strip_cmdline_cstr ( &argc, &argv, "--capture-solcap",          NULL, NULL      );
   int          capture_txns            = fd_env_strip_cmdline_int  ( &argc, &argv, "--capture-txns",            NULL, 1         );
+  int          capture_async           = fd_env_strip_cmdline_int  ( &argc, &argv, "--capture-async",           NULL, 0         );
+  ulong        capture_ring_sz         = fd_env_strip_cmdline_ulong( &argc, &argv, "--capture-ring-sz",         NULL, 0UL       );
+  ulong        capture_slot_stride     = fd_env_strip_cmdline_ulong( &argc, &argv, "--capture-slot-stride",     NULL, 1UL       );
+  char const * capture_accounts        = fd_env_strip_cmdline_cstr ( &argc, &argv, "--capture-accounts",        NULL, NULL      );
   char const * checkpt_path            = fd_env_strip_cmdline_cstr ( &argc, &argv, "--checkpt-path",            NULL, NULL      );
   ulong        checkpt_freq            = fd_env_strip_cmdline_ulong( &argc, &argv, "--checkpt-freq",            NULL, ULONG_MAX );
   int          checkpt_mismatch        = fd_env_strip_cmdline_int  ( &argc, &argv, "--checkpt-mismatch",        NULL, 0         );
   char const * allocator               = fd_env_strip_cmdline_cstr ( &argc, &argv, "--allocator",               NULL, "wksp"    );
   int          abort_on_mismatch       = fd_env_strip_cmdline_int  ( &argc, &argv, "--abort-on-mismatch",       NULL, 1         );
   int          on_demand_block_ingest  = fd_env_strip_cmdline_int  ( &argc, &argv, "--on-demand-block-ingest",  NULL, 0         );
+  ulong        ingest_tile_cnt         = fd_env_strip_cmdline_ulong( &argc, &argv, "--ingest-tile-cnt",         NULL, 0UL       );
+  ulong        ingest_depth            = fd_env_strip_cmdline_ulong( &argc, &argv, "--ingest-depth",            NULL, 8UL       );
   ulong        on_demand_block_history = fd_env_strip_cmdline_ulong( &argc, &argv, "--on-demand-block-history", NULL, 100       );
   int          dump_insn_to_pb         = fd_env_strip_cmdline_int  ( &argc, &argv, "--dump-insn-to-pb",         NULL, 0         );
   ulong        dump_insn_start_slot    = fd_env_strip_cmdline_ulong( &argc, &argv, "--dump-insn-start-slot",    NULL, 0         );
@@ -1351,6 +1559,10 @@ initial_setup( int argc, char ** argv, fd_ledger_args_t * args ) {
   ulong        vote_acct_max           = fd_env_strip_cmdline_ulong( &argc, &argv, "--vote_acct_max",           NULL, 2000000UL );
   int          use_funk_wksp           = fd_env_strip_cmdline_int  ( &argc, &argv, "--use-funk-wksp",           NULL, 1         );
   char const * rocksdb_list            = fd_env_strip_cmdline_cstr ( &argc, &argv, "--rocksdb",                 NULL, NULL      );
+  int          prof_enabled            = fd_env_strip_cmdline_int  ( &argc, &argv, "--prof",                    NULL, 0         );
+  ulong        prof_prog_max           = fd_env_strip_cmdline_ulong( &argc, &argv, "--prof-prog-max",           NULL, 4096UL    );
+  ulong        prof_slot_max           = fd_env_strip_cmdline_ulong( &argc, &argv, "--prof-slot-max",           NULL, 8192UL    );
+  ulong        prof_top                = fd_env_strip_cmdline_ulong( &argc, &argv, "--prof-top",                NULL, 20UL      );
 
   #ifdef _ENABLE_LTHASH
   char const * lthash             = fd_env_strip_cmdline_cstr ( &argc, &argv, "--lthash",           NULL, "false"   );
@@ -1383,6 +1595,14 @@ initial_setup( int argc, char ** argv, fd_ledger_args_t * args ) {
   }
   args->wksp = wksp;
 
+  /* prof only reads the profiler of a replay that may still be running,
+     so don't allocate anything from its workspace */
+  if( cmd && strcmp( cmd, "prof" ) == 0 ) {
+    args->cmd      = cmd;
+    args->prof_top = prof_top;
+    return 0;
+  }
+
   init_scratch( wksp );
 
   /* Setup funk workspace if specified. */
@@ -1419,6 +1639,9 @@ initial_setup( int argc, char ** argv, fd_ledger_args_t * args ) {
   args->end_slot                = end_slot;
   args->checkpt                 = checkpt;
   args->checkpt_funk            = checkpt_funk;
+  args->checkpt_style           = checkpt_style;
+  args->checkpt_base            = checkpt_base;
+  args->checkpt_funk_base       = checkpt_funk_base;
   args->shred_max               = shred_max;
   args->slot_history_max        = slot_history_max;
   args->txns_max                = txns_max;
@@ -1441,12 +1664,18 @@ initial_setup( int argc, char ** argv, fd_ledger_args_t * args ) {
   args->pages_pruned            = pages_pruned;
   args->capture_fpath           = capture_fpath;
   args->capture_txns            = capture_txns;
+  args->capture_async           = capture_async;
+  args->capture_ring_sz         = capture_ring_sz;
+  args->capture_slot_stride     = capture_slot_stride;
+  parse_capture_accounts( args, capture_accounts );
   args->checkpt_path            = checkpt_path;
   args->checkpt_freq            = checkpt_freq;
   args->checkpt_mismatch        = checkpt_mismatch;
   args->allocator               = allocator;
   args->abort_on_mismatch       = abort_on_mismatch;
   args->on_demand_block_ingest  = on_demand_block_ingest;
+  args->ingest_tile_cnt         = ingest_tile_cnt;
+  args->ingest_depth            = ingest_depth;
   args->on_demand_block_history = on_demand_block_history;
   args->dump_insn_to_pb         = dump_insn_to_pb;
   args->dump_insn_start_slot    = dump_insn_start_slot;
@@ -1455,6 +1684,26 @@ initial_setup( int argc, char ** argv, fd_ledger_args_t * args ) {
   args->vote_acct_max           = vote_acct_max;
   args->rocksdb_list_cnt        = 0UL;
   parse_rocksdb_list( args, rocksdb_list );
+  args->prof_enabled            = prof_enabled;
+  args->prof_prog_max           = prof_prog_max;
+  args->prof_slot_max           = prof_slot_max;
+  args->prof_top                = prof_top;
+
+  if( FD_UNLIKELY( ingest_tile_cnt>=fd_tile_cnt() ) ) {
+    FD_LOG_ERR(( "--ingest-tile-cnt %lu leaves no tiles for replay (%lu tiles)", ingest_tile_cnt, fd_tile_cnt() ));
+  }
+  if( FD_UNLIKELY( capture_async && ingest_tile_cnt+2UL>fd_tile_cnt() ) ) {
+    FD_LOG_ERR(( "--capture-async needs a tile besides replay and the %lu ingest tiles (%lu tiles)", ingest_tile_cnt, fd_tile_cnt() ));
+  }
+  if( FD_UNLIKELY( capture_ring_sz && ( capture_ring_sz<FD_SOLCAP_WRITER_ASYNC_RING_SZ_MIN || !fd_ulong_is_aligned( capture_ring_sz, 8UL ) ) ) ) {
+    FD_LOG_ERR(( "--capture-ring-sz should be a multiple of 8 of at least %lu", FD_SOLCAP_WRITER_ASYNC_RING_SZ_MIN ));
+  }
+  if( FD_UNLIKELY( prof_enabled && !fd_runtime_prof_footprint( fd_tile_cnt(), prof_prog_max, prof_slot_max ) ) ) {
+    FD_LOG_ERR(( "bad --prof-prog-max or --prof-slot-max" ));
+  }
+  if( FD_UNLIKELY( ingest_depth<fd_ulong_max( ingest_tile_cnt, 1UL ) ) ) {
+    FD_LOG_ERR(( "--ingest-depth should be at least max(--ingest-tile-cnt,1)" ));
+  }
 
   for( ulong i = 0; i < args->rocksdb_list_cnt; ++i ) {
     FD_LOG_NOTICE(( "rocksdb_list[%lu] = %s", i, args->rocksdb_list[i] ));
@@ -1481,6 +1730,8 @@ int main( int argc, char ** argv ) {
     minify( &args );
   } else if( strcmp( args.cmd, "prune" ) == 0 ) {
     prune( &args );
+  } else if( strcmp( args.cmd, "prof" ) == 0 ) {
+    prof( &args );
 
   } else {
     FD_LOG_ERR(( "unknown command=%s", args.cmd ));
@@ -0,0 +1,7 @@
+ifdef FD_HAS_DOUBLE
+ifdef FD_HAS_ROCKSDB
+$(call make-bin,fd_pack_sim,main,fd_flamenco fd_disco fd_ballet fd_funk fd_tango fd_util,$(ROCKSDB_LIBS))
+else
+$(call make-bin,fd_pack_sim,main,fd_disco fd_ballet fd_tango fd_util)
+endif
+endif
@@ -0,0 +1,628 @@
+/* fd_pack_sim replays a recorded stream of transactions through fd_pack
+   offline and reports how well the resulting blocks were packed.  It is
+   meant for tuning pack limits and evaluating scheduler changes without
+   running a leader.
+
+   Transactions are read either from a pcap of TPU traffic, in which
+   case each UDP payload is one transaction and it arrives at its
+   capture timestamp, or from a range of slots in a ledger (rocksdb or
+   shredcap), in which case the transactions of each block arrive spread
+   evenly over the slot they were originally included in.  An example
+   command is:
+
+     build/native/gcc/bin/fd_pack_sim --pcap tpu.pcap --bank-cnt 4
+
+   or
+
+     build/native/gcc/bin/fd_pack_sim --rocksdb /data/ledger/rocksdb
+         --start-slot 250553925 --end-slot 250554025
+
+   Time is simulated.  The pack side mirrors the pack tile: a bank is
+   scheduled only once it is idle and pack has waited the same delay
+   the tile would given the number of available transactions, blocks
+   end every --slot-ms and banks are drained between blocks.  A bank
+   tile is modeled as taking
+
+     --mb-overhead-ns + txn_cnt*--txn-overhead-ns + cus*--ns-per-cu
+
+   to execute a microblock, where cus is the CUs the microblock's
+   transactions actually consume, taken to be --cu-consumed-pct percent
+   of what they requested.  The difference is rebated to pack as the
+   bank tile would.  --lookahead is passed to fd_pack_set_lookahead, to
+   compare greedy scheduling against routing contended accounts, and
+   --fee-payer-cap is passed to fd_pack_set_fee_payer_cap.
+
+   The report covers block fill (the cost of the block after rebates
+   relative to the block limit), CU utilization (CUs consumed relative
+   to CUs requested, and how busy the banks were), fees captured, insert results, the simulated time
+   transactions waited in pack before being scheduled, the real time
+   spent in the pack calls, and conflict stalls, which are the times
+   pack had transactions available and an idle bank but could not
+   schedule any of them. */
+
+#include "../../ballet/pack/fd_pack.h"
+#include "../../ballet/pack/fd_pack_cost.h"
+#include "../../ballet/pack/fd_compute_budget_program.h"
+#include "../../ballet/txn/fd_txn.h"
+#include "../../disco/metrics/fd_metrics.h"
+#include "../../tango/tempo/fd_tempo.h"
+#include "../../util/net/fd_eth.h"
+#include "../../util/net/fd_ip4.h"
+#include "../../util/net/fd_pcap.h"
+#include "../../util/net/fd_udp.h"
+
+#if FD_HAS_ROCKSDB
+#include "../../flamenco/fd_flamenco.h"
+#include "../../flamenco/runtime/fd_blockstore.h"
+#include "../../flamenco/runtime/fd_rocksdb.h"
+#include "../../flamenco/shredcap/fd_shredcap.h"
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+
+#define CUS_PER_MICROBLOCK (1500000UL)
+#define VOTE_FRACTION      (0.75f)
+
+/* The same table the pack tile uses, see the comment there. */
+FD_IMPORT( wait_duration, "src/ballet/pack/pack_delay.bin", ulong, 6, "" );
+
+#define SORT_NAME        sort_latency
+#define SORT_KEY_T       long
+#define SORT_BEFORE(a,b) ((a)<(b))
+#include "../../util/tmpl/fd_sort.c"
+
+uchar metrics_scratch[ FD_METRICS_FOOTPRINT( 0, 0 ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
+
+struct sim_cfg {
+  ulong  bank_cnt;
+  long   slot_ns;
+  long   mb_overhead_ns;
+  long   txn_overhead_ns;
+  double ns_per_cu;
+  ulong  cu_consumed_pct;
+  long   txn_lifetime_ns;
+  ulong  max_microblocks;
+  ulong  max_cost_per_block;
+};
+typedef struct sim_cfg sim_cfg_t;
+
+struct sim_block {
+  ulong txn_cnt;
+  ulong vote_cnt;
+  ulong microblock_cnt;
+  ulong cus_scheduled;  /* CUs requested by scheduled transactions */
+  ulong cus_consumed;   /* CUs the bank model says the transactions used, i.e. the cost of the block after rebates */
+  ulong data_sz;
+  ulong fees;
+};
+typedef struct sim_block sim_block_t;
+
+struct sim_stats {
+  sim_block_t total;
+  ulong       block_cnt;
+  ulong       block_fill_min;  /* In hundredths of a percent */
+  ulong       block_fill_max;
+  ulong       insert_result[ FD_PACK_INSERT_RETVAL_CNT ];
+  ulong       expired_cnt;
+  ulong       schedule_cnt;
+  ulong       empty_schedule_cnt;
+  ulong       conflict_stall_cnt;
+  long        conflict_stall_ns;  /* Bank time spent idle with transactions available */
+  long        bank_busy_ns;
+  long        sim_ns;
+  long *      latency;            /* Per scheduled transaction, ns from arrival to scheduled */
+  ulong       latency_cnt;
+  fd_histf_t  insert_duration[1];
+  fd_histf_t  schedule_duration[1];
+};
+typedef struct sim_stats sim_stats_t;
+
+/* txn_fee returns the fee in lamports the leader would collect for the
+   transaction, the signature fee plus any priority fee requested with
+   the compute budget program. */
+
+static ulong
+txn_fee( fd_txn_p_t const * txnp ) {
+  fd_txn_t const * txn = TXN(txnp);
+  ulong sig_fee = FD_PACK_FEE_PER_SIGNATURE*(ulong)txn->signature_cnt;
+
+  fd_compute_budget_program_state_t cb_prog_st = {0};
+  fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, txnp->payload );
+  for( ulong i=0UL; i<(ulong)txn->instr_cnt; i++ ) {
+    if( FD_LIKELY( memcmp( accts+txn->instr[ i ].program_id, FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ) ) ) continue;
+    if( FD_UNLIKELY( !fd_compute_budget_program_parse( txnp->payload+txn->instr[ i ].data_off, txn->instr[ i ].data_sz, &cb_prog_st ) ) ) return sig_fee;
+  }
+  ulong priority_fee = 0UL;
+  uint  compute_max  = 0U;
+  fd_compute_budget_program_finalize( &cb_prog_st, txn->instr_cnt, &priority_fee, &compute_max );
+  return sig_fee + priority_fee;
+}
+
+/* add_txn parses payload into the next free spot of txns and records
+   its arrival time in meta.  Returns 1 if the transaction was added
+   and 0 if it did not parse. */
+
+static int
+add_txn( fd_txn_p_t *  txns,
+         ulong *       txn_cnt,
+         uchar const * payload,
+         ulong         payload_sz,
+         long          arrival ) {
+  if( FD_UNLIKELY( payload_sz>FD_TPU_MTU ) ) return 0;
+  fd_txn_p_t * txnp = txns + *txn_cnt;
+  if( FD_UNLIKELY( !fd_txn_parse( payload, payload_sz, TXN(txnp), NULL ) ) ) return 0;
+  fd_memcpy( txnp->payload, payload, payload_sz );
+  txnp->payload_sz = payload_sz;
+  txnp->meta       = (ulong)arrival;
+  txnp->flags      = 0U;
+  (*txn_cnt)++;
+  return 1;
+}
+
+/* load_pcap reads the UDP payloads of the packets in the pcap at path
+   as transactions.  Arrival times are relative to the first packet and
+   are made monotonic.  Returns the number of transactions loaded. */
+
+static ulong
+load_pcap( char const * path,
+           fd_txn_p_t * txns,
+           ulong        txn_max ) {
+  FILE * file = fopen( path, "r" );
+  if( FD_UNLIKELY( !file ) ) FD_LOG_ERR(( "fopen( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  fd_pcap_iter_t * iter = fd_pcap_iter_new( file );
+  if( FD_UNLIKELY( !iter ) ) FD_LOG_ERR(( "\"%s\" is not a pcap", path ));
+
+  ulong txn_cnt  = 0UL;
+  ulong skip_cnt = 0UL;
+  long  ts0      = LONG_MIN;
+  long  last     = 0L;
+  uchar pkt[ 2048UL ];
+  long  ts;
+  while( txn_cnt<txn_max ) {
+    ulong pkt_sz = fd_pcap_iter_next( iter, pkt, sizeof(pkt), &ts );
+    if( FD_UNLIKELY( !pkt_sz ) ) break;
+    if( FD_UNLIKELY( ts0==LONG_MIN ) ) ts0 = ts;
+
+    ulong off = sizeof(fd_eth_hdr_t);
+    if( FD_UNLIKELY( pkt_sz<off ) ) { skip_cnt++; continue; }
+    ushort net_type = fd_ushort_bswap( ((fd_eth_hdr_t const *)pkt)->net_type );
+    while( net_type==FD_ETH_HDR_TYPE_VLAN && pkt_sz>=off+sizeof(fd_vlan_tag_t) ) {
+      net_type = fd_ushort_bswap( ((fd_vlan_tag_t const *)(pkt+off))->net_type );
+      off += sizeof(fd_vlan_tag_t);
+    }
+    if( FD_UNLIKELY( net_type!=FD_ETH_HDR_TYPE_IP || pkt_sz<off+sizeof(fd_ip4_hdr_t) ) ) { skip_cnt++; continue; }
+    fd_ip4_hdr_t const * ip4 = (fd_ip4_hdr_t const *)(pkt+off);
+    if( FD_UNLIKELY( ip4->protocol!=FD_IP4_HDR_PROTOCOL_UDP ) ) { skip_cnt++; continue; }
+    off += FD_IP4_GET_LEN( *ip4 ) + sizeof(fd_udp_hdr_t);
+    if( FD_UNLIKELY( pkt_sz<=off ) ) { skip_cnt++; continue; }
+
+    last = fd_long_max( last, ts-ts0 );
+    if( FD_UNLIKELY( !add_txn( txns, &txn_cnt, pkt+off, pkt_sz-off, last ) ) ) skip_cnt++;
+  }
+
+  fclose( fd_pcap_iter_delete( iter ) );
+  FD_LOG_NOTICE(( "loaded %lu transactions from \"%s\" (%lu packets skipped)", txn_cnt, path, skip_cnt ));
+  return txn_cnt;
+}
+
+#if FD_HAS_ROCKSDB
+
+/* load_blockstore copies out the transactions of the blocks in
+   [start_slot, end_slot] from blockstore.  The transactions of each
+   block arrive spread evenly over the slot, with the slot of
+   start_slot beginning at time 0.  Returns the number of transactions
+   loaded. */
+
+static ulong
+load_blockstore( fd_blockstore_t * blockstore,
+                 ulong             start_slot,
+                 ulong             end_slot,
+                 long              slot_ns,
+                 fd_txn_p_t *      txns,
+                 ulong             txn_max ) {
+  ulong txn_cnt  = 0UL;
+  ulong skip_cnt = 0UL;
+  ulong blk_cnt  = 0UL;
+  for( ulong slot=start_slot; slot<=end_slot && txn_cnt<txn_max; slot++ ) {
+    fd_block_t * block = fd_blockstore_block_query( blockstore, slot );
+    if( FD_UNLIKELY( !block ) ) continue;
+    blk_cnt++;
+
+    uchar const *              data = fd_blockstore_block_data_laddr( blockstore, block );
+    fd_block_txn_ref_t const * refs = fd_wksp_laddr_fast( fd_blockstore_wksp( blockstore ), block->txns_gaddr );
+    long slot_start = (long)(slot-start_slot)*slot_ns;
+    for( ulong i=0UL; i<block->txns_cnt && txn_cnt<txn_max; i++ ) {
+      long arrival = slot_start + (long)(((ulong)slot_ns*i)/block->txns_cnt);
+      if( FD_UNLIKELY( !add_txn( txns, &txn_cnt, data+refs[ i ].txn_off, refs[ i ].sz, arrival ) ) ) skip_cnt++;
+    }
+  }
+  FD_LOG_NOTICE(( "loaded %lu transactions from %lu blocks (%lu skipped)", txn_cnt, blk_cnt, skip_cnt ));
+  return txn_cnt;
+}
+
+static void
+ingest_rocksdb( char const *      rocksdb_dir,
+                fd_blockstore_t * blockstore,
+                ulong             start_slot,
+                ulong             end_slot ) {
+  fd_valloc_t  valloc = fd_libc_alloc_virtual();
+  fd_rocksdb_t rocks_db;
+  char * err = fd_rocksdb_init( &rocks_db, rocksdb_dir );
+  if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_rocksdb_init returned %s", err ));
+
+  fd_rocksdb_root_iter_t iter;
+  fd_rocksdb_root_iter_new( &iter );
+
+  fd_slot_meta_t slot_meta;
+  fd_memset( &slot_meta, 0, sizeof(slot_meta) );
+  if( FD_UNLIKELY( fd_rocksdb_root_iter_seek( &iter, &rocks_db, start_slot, &slot_meta, valloc )<0 ) )
+    FD_LOG_ERR(( "unable to seek to slot %lu", start_slot ));
+
+  do {
+    ulong slot = slot_meta.slot;
+    if( slot>end_slot ) break;
+    if( FD_UNLIKELY( fd_rocksdb_import_block_blockstore( &rocks_db, &slot_meta, blockstore, 0, NULL ) ) )
+      FD_LOG_ERR(( "failed to import block %lu", slot ));
+
+    fd_bincode_destroy_ctx_t ctx = { .valloc = valloc };
+    fd_slot_meta_destroy( &slot_meta, &ctx );
+
+    if( fd_rocksdb_root_iter_next( &iter, &slot_meta, valloc )<0 &&
+        fd_rocksdb_get_meta( &rocks_db, slot+1UL, &slot_meta, valloc )<0 ) break;
+  } while( 1 );
+
+  fd_rocksdb_root_iter_destroy( &iter );
+  fd_rocksdb_destroy( &rocks_db );
+}
+
+#endif /* FD_HAS_ROCKSDB */
+
+static void
+record_block( sim_stats_t *       stats,
+              sim_block_t const * block,
+              ulong               max_cost_per_block ) {
+  ulong fill = (10000UL*block->cus_consumed)/max_cost_per_block;
+  FD_LOG_INFO(( "block %lu: %lu txns (%lu votes), %lu microblocks, fill %lu.%02lu%%, %lu CUs requested, %lu bytes, %lu lamports",
+                stats->block_cnt, block->txn_cnt, block->vote_cnt, block->microblock_cnt, fill/100UL, fill%100UL,
+                block->cus_scheduled, block->data_sz, block->fees ));
+
+  stats->block_fill_min        = fd_ulong_min( stats->block_fill_min, fill );
+  stats->block_fill_max        = fd_ulong_max( stats->block_fill_max, fill );
+  stats->total.txn_cnt        += block->txn_cnt;
+  stats->total.vote_cnt       += block->vote_cnt;
+  stats->total.microblock_cnt += block->microblock_cnt;
+  stats->total.cus_scheduled  += block->cus_scheduled;
+  stats->total.cus_consumed   += block->cus_consumed;
+  stats->total.data_sz        += block->data_sz;
+  stats->total.fees           += block->fees;
+  stats->block_cnt++;
+}
+
+/* simulate runs the transactions in txns, which must be sorted by
+   arrival time, through pack.  bank_txns has space for one microblock
+   per bank. */
+
+static void
+simulate( sim_cfg_t const * cfg,
+          fd_pack_t *       pack,
+          fd_txn_p_t const * txns,
+          ulong             txn_cnt,
+          fd_txn_p_t *      bank_txns,
+          sim_stats_t *     stats ) {
+  long  bank_ready_at  [ FD_PACK_MAX_BANK_TILES ];
+  ulong bank_txn_cnt   [ FD_PACK_MAX_BANK_TILES ];
+  ulong bank_block     [ FD_PACK_MAX_BANK_TILES ];
+  uint  bank_consumed  [ FD_PACK_MAX_BANK_TILES*MAX_TXN_PER_MICROBLOCK ];
+  ulong bank_idle_bitset = fd_ulong_mask_lsb( (int)cfg->bank_cnt );
+  ulong all_idle         = bank_idle_bitset;
+
+  double tick_per_ns = fd_tempo_tick_per_ns( NULL );
+  float  consumed    = (float)cfg->cu_consumed_pct/100.0f;
+
+  sim_block_t block[1]    = {{0}};
+  long        now         = 0L;
+  long        slot_end    = cfg->slot_ns;
+  long        last_insert = 0L;
+  ulong       next        = 0UL;
+  int         drain       = 0;
+
+  for(;;) {
+    /* Transactions that have arrived by now */
+    while( next<txn_cnt && (long)txns[ next ].meta<=now ) {
+      fd_txn_p_t const * txn  = txns + next++;
+      fd_txn_p_t *       spot = fd_pack_insert_txn_init( pack );
+      fd_memcpy( spot->payload, txn->payload, txn->payload_sz                                              );
+      fd_memcpy( TXN(spot),     TXN(txn),     fd_txn_footprint( TXN(txn)->instr_cnt, TXN(txn)->addr_table_lookup_cnt ) );
+      spot->payload_sz = txn->payload_sz;
+      spot->meta       = txn->meta;
+
+      long insert_duration = -fd_tickcount();
+      int  result          = fd_pack_insert_txn_fini( pack, spot, txn->meta );
+      insert_duration     += fd_tickcount();
+      fd_histf_sample( stats->insert_duration, (ulong)((double)insert_duration/tick_per_ns) );
+      stats->insert_result[ result + FD_PACK_INSERT_RETVAL_OFF ]++;
+      if( FD_LIKELY( result>=0 ) ) last_insert = now;
+    }
+
+    /* Banks that have finished their microblock report the CUs the
+       transactions did not use. */
+    for( ulong i=0UL; i<cfg->bank_cnt; i++ ) {
+      if( fd_ulong_extract_bit( bank_idle_bitset, (int)i ) || bank_ready_at[ i ]>now ) continue;
+      fd_pack_rebate_cus( pack, bank_txns+i*MAX_TXN_PER_MICROBLOCK, bank_consumed+i*MAX_TXN_PER_MICROBLOCK, bank_txn_cnt[ i ], bank_block[ i ]==stats->block_cnt );
+      bank_idle_bitset = fd_ulong_set_bit( bank_idle_bitset, (int)i );
+    }
+
+    if( FD_UNLIKELY( now>=slot_end ) ) {
+      record_block( stats, block, cfg->max_cost_per_block );
+      int stuck = !block->microblock_cnt && next>=txn_cnt && bank_idle_bitset==all_idle;
+      fd_memset( block, 0, sizeof(sim_block_t) );
+      fd_pack_end_block( pack );
+      slot_end += cfg->slot_ns;
+      drain     = 1;
+
+      if( FD_UNLIKELY( next>=txn_cnt && bank_idle_bitset==all_idle && !fd_pack_avail_txn_cnt( pack ) ) ) break;
+      if( FD_UNLIKELY( stuck ) ) {
+        FD_LOG_WARNING(( "%lu transactions could not be scheduled in an entire block, giving up", fd_pack_avail_txn_cnt( pack ) ));
+        break;
+      }
+    }
+
+    if( FD_UNLIKELY( drain && bank_idle_bitset==all_idle ) ) drain = 0;
+
+    int conflict = 0;
+    while( !drain && bank_idle_bitset && block->microblock_cnt<cfg->max_microblocks ) {
+      ulong avail = fd_pack_avail_txn_cnt( pack );
+      if( (ulong)(now-last_insert)<wait_duration[ fd_ulong_min( avail, MAX_TXN_PER_MICROBLOCK ) ] ) break;
+
+      ulong i = (ulong)fd_ulong_find_lsb( bank_idle_bitset );
+      fd_pack_microblock_complete( pack, i );
+      stats->expired_cnt += fd_pack_expire_before( pack, (ulong)fd_long_max( 0L, now-cfg->txn_lifetime_ns ) );
+
+      fd_txn_p_t * out = bank_txns + i*MAX_TXN_PER_MICROBLOCK;
+      long schedule_duration = -fd_tickcount();
+      ulong cnt = fd_pack_schedule_next_microblock( pack, CUS_PER_MICROBLOCK, VOTE_FRACTION, i, out );
+      schedule_duration     += fd_tickcount();
+      fd_histf_sample( stats->schedule_duration, (ulong)((double)schedule_duration/tick_per_ns) );
+      stats->schedule_cnt++;
+
+      if( FD_UNLIKELY( !cnt ) ) {
+        stats->empty_schedule_cnt++;
+        if( fd_pack_avail_txn_cnt( pack ) ) {
+          stats->conflict_stall_cnt++;
+          conflict = 1;
+        }
+        break;
+      }
+
+      ulong cus = 0UL;
+      for( ulong j=0UL; j<cnt; j++ ) {
+        fd_txn_p_t * txn   = out+j;
+        uint  flags         = txn->flags;
+        ulong requested     = 0UL;
+        ulong non_execution = fd_pack_compute_cost( txn, &flags, &requested ) - requested;
+        uint  actual        = (uint)((float)requested*consumed);
+        block->cus_scheduled += requested + non_execution;
+        block->data_sz       += txn->payload_sz;
+        block->fees          += txn_fee( txn );
+        block->vote_cnt      += !!(txn->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE);
+        cus                  += (ulong)actual + non_execution;
+        stats->latency[ stats->latency_cnt++ ] = now - (long)txn->meta;
+
+        txn->flags |= FD_TXN_P_FLAGS_EXECUTE_SUCCESS;
+        bank_consumed[ i*MAX_TXN_PER_MICROBLOCK+j ] = actual;
+      }
+      block->txn_cnt      += cnt;
+      block->cus_consumed += cus;
+      block->microblock_cnt++;
+
+      long duration = cfg->mb_overhead_ns + (long)cnt*cfg->txn_overhead_ns + (long)((double)cus*cfg->ns_per_cu);
+      stats->bank_busy_ns += duration;
+      bank_ready_at[ i ] = now + duration;
+      bank_txn_cnt [ i ] = cnt;
+      bank_block   [ i ] = stats->block_cnt;
+      bank_idle_bitset   = fd_ulong_clear_bit( bank_idle_bitset, (int)i );
+    }
+
+    /* Advance to whatever happens next */
+    long nxt = slot_end;
+    if( next<txn_cnt ) nxt = fd_long_min( nxt, (long)txns[ next ].meta );
+    for( ulong i=0UL; i<cfg->bank_cnt; i++ ) {
+      if( !fd_ulong_extract_bit( bank_idle_bitset, (int)i ) ) nxt = fd_long_min( nxt, bank_ready_at[ i ] );
+    }
+    ulong avail = fd_pack_avail_txn_cnt( pack );
+    if( !drain && !conflict && bank_idle_bitset && avail ) {
+      ulong wait = wait_duration[ fd_ulong_min( avail, MAX_TXN_PER_MICROBLOCK ) ];
+      if( wait<(ulong)LONG_MAX && last_insert+(long)wait>now ) nxt = fd_long_min( nxt, last_insert+(long)wait );
+    }
+    if( conflict ) stats->conflict_stall_ns += (long)fd_ulong_popcnt( bank_idle_bitset )*(nxt-now);
+    now = nxt;
+  }
+
+  stats->sim_ns = now;
+}
+
+static ulong
+histf_percentile( fd_histf_t const * hist,
+                  double             pct ) {
+  ulong cnt = 0UL;
+  for( ulong b=0UL; b<FD_HISTF_BUCKET_CNT; b++ ) cnt += fd_histf_cnt( hist, b );
+  ulong target = (ulong)(pct*(double)cnt);
+  ulong seen   = 0UL;
+  for( ulong b=0UL; b<FD_HISTF_BUCKET_CNT; b++ ) {
+    seen += fd_histf_cnt( hist, b );
+    if( seen>target ) return fd_histf_right( hist, b );
+  }
+  return fd_histf_right( hist, FD_HISTF_BUCKET_CNT-1UL );
+}
+
+static void
+report( sim_cfg_t const * cfg,
+        sim_stats_t *     stats,
+        ulong             txn_cnt ) {
+  sim_block_t const * total = &stats->total;
+  ulong block_cnt = fd_ulong_max( stats->block_cnt, 1UL );
+
+  ulong fill = (10000UL*total->cus_consumed)/(block_cnt*cfg->max_cost_per_block);
+  FD_LOG_NOTICE(( "simulated %lu blocks (%.3f s) with %lu banks", stats->block_cnt, (double)stats->sim_ns/1e9, cfg->bank_cnt ));
+  FD_LOG_NOTICE(( "scheduled %lu of %lu transactions (%lu votes) in %lu microblocks, %.2f txns/microblock",
+                  total->txn_cnt, txn_cnt, total->vote_cnt, total->microblock_cnt,
+                  (double)total->txn_cnt/(double)fd_ulong_max( total->microblock_cnt, 1UL ) ));
+  FD_LOG_NOTICE(( "block fill: mean %lu.%02lu%% min %lu.%02lu%% max %lu.%02lu%% of %lu CUs",
+                  fill/100UL, fill%100UL, stats->block_fill_min/100UL, stats->block_fill_min%100UL,
+                  stats->block_fill_max/100UL, stats->block_fill_max%100UL, cfg->max_cost_per_block ));
+
+  double capacity_ns = (double)cfg->bank_cnt*(double)block_cnt*(double)cfg->slot_ns;
+  FD_LOG_NOTICE(( "CU utilization: %lu CUs consumed of %lu requested, banks busy %.2f%% of the time",
+                  total->cus_consumed, total->cus_scheduled, 100.0*(double)stats->bank_busy_ns/capacity_ns ));
+  FD_LOG_NOTICE(( "fees: %lu lamports total, %lu lamports/block, %lu bytes/block",
+                  total->fees, total->fees/block_cnt, total->data_sz/block_cnt ));
+
+  static char const * insert_result_str[ FD_PACK_INSERT_RETVAL_CNT ] = {
+    "reject_fee_payer_cap", "reject_full", "reject_writes_sysvar", "reject_estimation_fail", "reject_too_large", "reject_expired",
+    "reject_addr_lut", "reject_unaffordable", "reject_duplicate", "reject_priority",
+    "accept_nonvote_add", "accept_vote_add", "accept_nonvote_replace", "accept_vote_replace"
+  };
+  for( ulong i=0UL; i<FD_PACK_INSERT_RETVAL_CNT; i++ ) {
+    if( stats->insert_result[ i ] ) FD_LOG_NOTICE(( "insert %-24s %lu", insert_result_str[ i ], stats->insert_result[ i ] ));
+  }
+  FD_LOG_NOTICE(( "expired %lu transactions", stats->expired_cnt ));
+
+  if( FD_LIKELY( stats->latency_cnt ) ) {
+    sort_latency_inplace( stats->latency, stats->latency_cnt );
+    FD_LOG_NOTICE(( "time in pack: p50 %.3f ms p99 %.3f ms max %.3f ms",
+                    (double)stats->latency[ stats->latency_cnt/2UL ]/1e6,
+                    (double)stats->latency[ (stats->latency_cnt*99UL)/100UL ]/1e6,
+                    (double)stats->latency[ stats->latency_cnt-1UL ]/1e6 ));
+  }
+  FD_LOG_NOTICE(( "insert cost:   p50 <%lu ns p99 <%lu ns",
+                  histf_percentile( stats->insert_duration, 0.5 ), histf_percentile( stats->insert_duration, 0.99 ) ));
+  FD_LOG_NOTICE(( "schedule cost: p50 <%lu ns p99 <%lu ns over %lu calls (%lu empty)",
+                  histf_percentile( stats->schedule_duration, 0.5 ), histf_percentile( stats->schedule_duration, 0.99 ),
+                  stats->schedule_cnt, stats->empty_schedule_cnt ));
+  FD_LOG_NOTICE(( "conflict stalls: %lu, %.3f ms of idle bank time with transactions available",
+                  stats->conflict_stall_cnt, (double)stats->conflict_stall_ns/1e6 ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+#if FD_HAS_ROCKSDB
+  fd_flamenco_boot( &argc, &argv );
+#endif
+
+  char const * pcap_path     = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--pcap",             NULL, NULL        );
+  char const * rocksdb_dir   = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--rocksdb",          NULL, NULL        );
+  char const * shredcap_dir  = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--shredcap",         NULL, NULL        );
+  ulong        start_slot    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--start-slot",       NULL, 0UL         );
+  ulong        end_slot      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--end-slot",         NULL, ULONG_MAX   );
+  char const * _page_sz      = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--page-sz",          NULL, "gigantic"  );
+  ulong        page_cnt      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--page-cnt",         NULL, 2UL         );
+  ulong        numa_idx      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--numa-idx",         NULL, fd_shmem_numa_idx( fd_log_cpu_id() ) );
+  ulong        txn_max       = fd_env_strip_cmdline_ulong ( &argc, &argv, "--txn-max",          NULL, 262144UL    );
+  ulong        depth         = fd_env_strip_cmdline_ulong ( &argc, &argv, "--depth",            NULL, 4096UL      );
+  ulong        seed          = fd_env_strip_cmdline_ulong ( &argc, &argv, "--seed",             NULL, 0UL         );
+  int          larger_limits = fd_env_strip_cmdline_int   ( &argc, &argv, "--larger-limits",    NULL, 0           );
+  ulong        lookahead     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--lookahead",        NULL, 0UL         );
+  ulong        fee_payer_cap = fd_env_strip_cmdline_ulong ( &argc, &argv, "--fee-payer-cap",    NULL, 0UL         );
+
+  sim_cfg_t cfg[1] = {{
+    .bank_cnt        = fd_env_strip_cmdline_ulong ( &argc, &argv, "--bank-cnt",        NULL, 4UL        ),
+    .slot_ns         = fd_env_strip_cmdline_long  ( &argc, &argv, "--slot-ms",         NULL, 400L       )*1000000L,
+    .mb_overhead_ns  = fd_env_strip_cmdline_long  ( &argc, &argv, "--mb-overhead-ns",  NULL, 20000L     ),
+    .txn_overhead_ns = fd_env_strip_cmdline_long  ( &argc, &argv, "--txn-overhead-ns", NULL, 5000L      ),
+    .ns_per_cu       = fd_env_strip_cmdline_double( &argc, &argv, "--ns-per-cu",       NULL, 1.0        ),
+    .cu_consumed_pct = fd_env_strip_cmdline_ulong ( &argc, &argv, "--cu-consumed-pct", NULL, 50UL       ),
+    .txn_lifetime_ns = fd_env_strip_cmdline_long  ( &argc, &argv, "--txn-lifetime-ms", NULL, 60000L     )*1000000L,
+    .max_microblocks = fd_env_strip_cmdline_ulong ( &argc, &argv, "--max-microblocks", NULL, 131072UL   ),
+  }};
+
+  if( FD_UNLIKELY( !cfg->bank_cnt || cfg->bank_cnt>FD_PACK_MAX_BANK_TILES ) ) FD_LOG_ERR(( "--bank-cnt must be in [1, %lu]", FD_PACK_MAX_BANK_TILES ));
+  if( FD_UNLIKELY( cfg->slot_ns<=0L ) ) FD_LOG_ERR(( "--slot-ms must be positive" ));
+  if( FD_UNLIKELY( cfg->cu_consumed_pct>100UL ) ) FD_LOG_ERR(( "--cu-consumed-pct must be in [0, 100]" ));
+  if( FD_UNLIKELY( !!pcap_path + !!rocksdb_dir + !!shredcap_dir!=1 ) ) FD_LOG_ERR(( "exactly one of --pcap, --rocksdb or --shredcap must be given" ));
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  fd_metrics_register( (ulong *)fd_metrics_new( metrics_scratch, 0UL, 0UL ) );
+
+  fd_pack_limits_t limits[1] = {{
+    .max_cost_per_block        = larger_limits ? 13UL*FD_PACK_MAX_COST_PER_BLOCK : FD_PACK_MAX_COST_PER_BLOCK,
+    .max_vote_cost_per_block   = FD_PACK_MAX_VOTE_COST_PER_BLOCK,
+    .max_write_cost_per_acct   = FD_PACK_MAX_WRITE_COST_PER_ACCT,
+    .max_data_bytes_per_block  = larger_limits ? LARGER_MAX_DATA_PER_BLOCK : FD_PACK_MAX_DATA_PER_BLOCK,
+    .max_txn_per_microblock    = MAX_TXN_PER_MICROBLOCK,
+    .max_microblocks_per_block = cfg->max_microblocks,
+  }};
+  cfg->max_cost_per_block = limits->max_cost_per_block;
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_txn_p_t * txns = fd_wksp_alloc_laddr( wksp, alignof(fd_txn_p_t), txn_max*sizeof(fd_txn_p_t), 1UL );
+  if( FD_UNLIKELY( !txns ) ) FD_LOG_ERR(( "workspace too small for --txn-max %lu, increase --page-cnt", txn_max ));
+
+  ulong txn_cnt = 0UL;
+  if( pcap_path ) {
+    txn_cnt = load_pcap( pcap_path, txns, txn_max );
+  } else {
+#if FD_HAS_ROCKSDB
+    if( FD_UNLIKELY( end_slot==ULONG_MAX ) ) FD_LOG_ERR(( "--end-slot is required with --rocksdb and --shredcap" ));
+    ulong slot_cnt = end_slot-start_slot+1UL;
+    ulong shred_max = 1UL<<20;
+    void * shmem = fd_wksp_alloc_laddr( wksp, fd_blockstore_align(), fd_blockstore_footprint(), FD_BLOCKSTORE_MAGIC );
+    if( FD_UNLIKELY( !shmem ) ) FD_LOG_ERR(( "failed to allocate a blockstore" ));
+    fd_blockstore_t * blockstore = fd_blockstore_join( fd_blockstore_new( shmem, 1UL, seed, shred_max, fd_ulong_pow2_up( slot_cnt ), fd_ulong_find_msb( shred_max )+1 ) );
+    if( FD_UNLIKELY( !blockstore ) ) FD_LOG_ERR(( "failed to create a blockstore" ));
+
+    if( rocksdb_dir ) ingest_rocksdb( rocksdb_dir, blockstore, start_slot, end_slot );
+    else              fd_shredcap_populate_blockstore( shredcap_dir, blockstore, start_slot, end_slot );
+    txn_cnt = load_blockstore( blockstore, start_slot, end_slot, cfg->slot_ns, txns, txn_max );
+#else
+    (void)start_slot; (void)end_slot;
+    FD_LOG_ERR(( "--rocksdb and --shredcap require building with rocksdb" ));
+#endif
+  }
+  if( FD_UNLIKELY( !txn_cnt ) ) FD_LOG_ERR(( "no transactions to simulate" ));
+
+  fd_rng_t _rng[1];
+  fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)seed, 0UL ) );
+
+  ulong footprint = fd_pack_footprint( depth, cfg->bank_cnt, limits );
+  if( FD_UNLIKELY( !footprint ) ) FD_LOG_ERR(( "invalid --depth or --bank-cnt" ));
+  void * pack_mem = fd_wksp_alloc_laddr( wksp, fd_pack_align(), footprint, 1UL );
+  if( FD_UNLIKELY( !pack_mem ) ) FD_LOG_ERR(( "workspace too small for pack, increase --page-cnt" ));
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_mem, depth, cfg->bank_cnt, limits, rng ) );
+  FD_TEST( pack );
+  fd_pack_set_lookahead( pack, lookahead );
+  fd_pack_set_fee_payer_cap( pack, fee_payer_cap );
+
+  fd_txn_p_t * bank_txns = fd_wksp_alloc_laddr( wksp, alignof(fd_txn_p_t), cfg->bank_cnt*MAX_TXN_PER_MICROBLOCK*sizeof(fd_txn_p_t), 1UL );
+  long *       latency   = fd_wksp_alloc_laddr( wksp, alignof(long), txn_cnt*sizeof(long), 1UL );
+  if( FD_UNLIKELY( !bank_txns || !latency ) ) FD_LOG_ERR(( "workspace too small, increase --page-cnt" ));
+
+  static sim_stats_t stats[1];
+  stats->block_fill_min = ULONG_MAX;
+  stats->latency        = latency;
+  fd_histf_join( fd_histf_new( stats->insert_duration,   10UL, 100000UL ) );
+  fd_histf_join( fd_histf_new( stats->schedule_duration, 10UL, 100000UL ) );
+
+  simulate( cfg, pack, txns, txn_cnt, bank_txns, stats );
+  report( cfg, stats, txn_cnt );
+
+  fd_wksp_free_laddr( latency   );
+  fd_wksp_free_laddr( bank_txns );
+  fd_wksp_free_laddr( fd_pack_delete( fd_pack_leave( pack ) ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_free_laddr( txns );
+  fd_wksp_delete_anonymous( wksp );
+
+#if FD_HAS_ROCKSDB
+  fd_flamenco_halt();
+#endif
+  fd_halt();
+  return 0;
+}
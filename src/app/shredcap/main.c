@@ -13,7 +13,10 @@
    
    The "populate" command populates a blockstore with a specified block range. It
    will also contain the bank hash information for each slot. frank_ledger can be 
-   used to generate checkpoints using a shredstore.  */
+   used to generate checkpoints using a shredstore.
+
+   --zstdlevel compresses each slot of an ingested capture with the given zstd
+   level (0, the default, leaves slots uncompressed).  */
 
 #define DEFAULT_SHREDCAP_FILE_SIZE (1737418240UL)
 #define DEFAULT_SLOT_HISTORY_MAX   (10000000UL)
@@ -36,6 +39,7 @@ main( int argc, char ** argv ) {
   ulong max_file_sz         = fd_env_strip_cmdline_ulong( &argc, &argv, "--maxfilesz",   NULL, DEFAULT_SHREDCAP_FILE_SIZE );
   ulong slot_history_max    = fd_env_strip_cmdline_ulong( &argc, &argv, "--slothistory", NULL, DEFAULT_SLOT_HISTORY_MAX   );
   char const * do_verify    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--doverify",    NULL, "true"                     );
+  int zstd_level            = fd_env_strip_cmdline_int  ( &argc, &argv, "--zstdlevel",   NULL, 0                          );
 
   fd_wksp_t * wksp;
   if ( wkspname == NULL ) {
@@ -101,7 +105,7 @@ main( int argc, char ** argv ) {
   if ( strcmp( cmd, "ingest" ) == 0 ) {
     if( rocksdb_dir ) {
       fd_shredcap_ingest_rocksdb_to_capture( rocksdb_dir, capture_path,
-                                               max_file_sz, start_slot, end_slot );
+                                               max_file_sz, start_slot, end_slot, zstd_level );
       if ( strcmp( do_verify, "true" ) == 0 ) {
         fd_shredcap_verify( capture_path, blockstore );
       }
@@ -3,6 +3,7 @@
 #include "fd_pack_cost.h"
 #include "fd_compute_budget_program.h"
 #include "fd_pack_bitset.h"
+#include "fd_est_tbl.h"
 #include <math.h> /* for sqrt */
 #include <stddef.h> /* for offsetof */
 #include "../../disco/metrics/fd_metrics.h"
@@ -46,6 +47,16 @@ struct fd_pack_private_ord_txn {
                rewards;     /* in Lamports */
   uint         compute_est; /* in compute units */
 
+  /* execution_est is the portion of compute_est that comes from the
+     requested compute budget for non-builtin execution.  compute_est is
+     what the block gets charged when the transaction is scheduled.
+     prio_est is compute_est, but with the requested execution CUs
+     replaced by the learned estimate of what the transaction will
+     actually consume (if lower), and is what the transaction is ordered
+     by.  prio_est is in [compute_est-execution_est, compute_est]. */
+  uint         execution_est;
+  uint         prio_est;
+
   /* The treap fields */
   ushort left;
   ushort right;
@@ -54,6 +65,15 @@ struct fd_pack_private_ord_txn {
   ushort prev;
   ushort next;
 
+  /* bundle_next and bundle_hdr link the elements of a bundle together.
+     For a bundle header, bundle_next is the pool index of the first
+     transaction in the bundle.  For a transaction in a bundle,
+     bundle_next is the pool index of the next transaction in the bundle
+     (or the pool's null index if it is the last one) and bundle_hdr is
+     the pool index of the header.  Unused otherwise. */
+  ushort bundle_next;
+  ushort bundle_hdr;
+
   FD_PACK_BITSET_DECLARE( rw_bitset ); /* all accts this txn references */
   FD_PACK_BITSET_DECLARE(  w_bitset ); /* accts this txn write-locks    */
 
@@ -74,6 +94,14 @@ FD_STATIC_ASSERT( offsetof( fd_pack_ord_txn_t, txn->payload )==0UL, fd_pack_ord_
 #define FD_ORD_TXN_ROOT_FREE            0
 #define FD_ORD_TXN_ROOT_PENDING         1
 #define FD_ORD_TXN_ROOT_PENDING_VOTE    2
+/* A pending bundle is represented by a header element, which is in the
+   pending_bundles treap and the expiration queue on behalf of the whole
+   bundle, and which carries the totals of the bundle's transactions in
+   rewards, compute_est, execution_est, and prio_est.  The header has no
+   payload.  The transactions in the bundle are in the signature map but
+   not in any treap or the expiration queue. */
+#define FD_ORD_TXN_ROOT_PENDING_BUNDLE  3
+#define FD_ORD_TXN_ROOT_BUNDLE_MEMBER   4
 
 #define FD_PACK_IN_USE_WRITABLE    (0x8000000000000000UL)
 #define FD_PACK_IN_USE_BIT_CLEARED (0x4000000000000000UL)
@@ -91,14 +119,34 @@ FD_STATIC_ASSERT( offsetof( fd_pack_ord_txn_t, txn->payload )==0UL, fd_pack_ord_
    writer cost map instead of only removing the elements we increased. */
 #define DEFAULT_WRITTEN_LIST_MAX 16384UL
 
-/* fd_pack_addr_use_t: Used for two distinct purposes:
+/* At most pack_depth elements of the pool are in use by pending
+   transactions and bundle headers.  The rest are handed out between
+   insert_init and cancel/fini: one for a transaction and
+   1+FD_PACK_MAX_TXN_PER_BUNDLE for a bundle (including its header),
+   and one of each may be in progress at the same time. */
+#define POOL_EXTRA (2UL+FD_PACK_MAX_TXN_PER_BUNDLE)
+
+/* Pack learns how many execution CUs transactions actually consume,
+   keyed by the first non-builtin program they invoke, from the
+   consumption reported to fd_pack_rebate_cus.
+   The estimation table uses CU_EST_TBL_BIN_CNT bins with a sliding
+   window of roughly CU_EST_TBL_HISTORY samples per bin.  A bin with no
+   samples returns CU_EST_TBL_NO_DATA, which is larger than any
+   requested compute budget, so the requested value gets used. */
+#define CU_EST_TBL_BIN_CNT (4096UL)
+#define CU_EST_TBL_HISTORY (1000UL)
+#define CU_EST_TBL_NO_DATA (UINT_MAX)
+
+/* fd_pack_addr_use_t: Used for three distinct purposes:
     -  to record that an address is in use and can't be used again until
          certain microblocks finish execution
     -  to keep track of the cost of all transactions that write to the
          specified account.
+    -  to count the pending transactions that the specified account
+         pays the fee for.
    Making these separate structs might make it more clear, but then
-   they'd have identical shape and result in two fd_map_dynamic sets of
-   functions with identical code.  It doesn't seem like the compiler is
+   they'd have identical shape and result in three fd_map_dynamic sets
+   of functions with identical code.  It doesn't seem like the compiler is
    very good at merging code like that, so in order to reduce code
    bloat, we'll just combine them. */
 struct fd_pack_private_addr_use_record {
@@ -106,6 +154,7 @@ struct fd_pack_private_addr_use_record {
   union {
     ulong          in_use_by;  /* Bitmask indicating which banks */
     ulong          total_cost; /* In cost units/CUs */
+    ulong          txn_cnt;    /* Pending transactions */
   };
 };
 typedef struct fd_pack_private_addr_use_record fd_pack_addr_use_t;
@@ -224,8 +273,9 @@ typedef struct fd_pack_bitset_acct_mapping fd_pack_bitset_acct_mapping_t;
 #include "../../util/tmpl/fd_map_perfect.c"
 
 
-/* Returns 1 if x.rewards/x.compute < y.rewards/y.compute. Not robust. */
-#define COMPARE_WORSE(x,y) ( ((ulong)((x)->rewards)*(ulong)((y)->compute_est)) < ((ulong)((y)->rewards)*(ulong)((x)->compute_est)) )
+/* Returns 1 if x.rewards/x.prio_est < y.rewards/y.prio_est. Not
+   robust. */
+#define COMPARE_WORSE(x,y) ( ((ulong)((x)->rewards)*(ulong)((y)->prio_est)) < ((ulong)((y)->rewards)*(ulong)((x)->prio_est)) )
 
 /* Declare all the data structures */
 
@@ -315,7 +365,11 @@ struct fd_pack_private {
 
   fd_pack_limits_t lim[1];
 
+  /* pending_txn_cnt counts every pending transaction, including the
+     ones in bundles.  pending_bundle_cnt counts the pending bundles,
+     each of which uses one more pool element for its header. */
   ulong      pending_txn_cnt;
+  ulong      pending_bundle_cnt;
   ulong      microblock_cnt; /* How many microblocks have we
                                 generated in this block? */
   ulong      data_bytes_consumed; /* How much data is in this block so
@@ -346,9 +400,11 @@ struct fd_pack_private {
   fd_pack_ord_txn_t * pool;
 
   /* Treaps (sorted by priority) of pending transactions.  We store the
-     pending simple votes separately. */
+     pending simple votes separately, and pending bundles are stored as
+     their header elements. */
   treap_t pending[1];
   treap_t pending_votes[1];
+  treap_t pending_bundles[1];
 
   /* expiration_q: At the same time that a transaction is in exactly one
      of the above treaps, it is also in the expiration queue, sorted by
@@ -368,6 +424,50 @@ struct fd_pack_private {
   FD_PACK_BITSET_DECLARE( bitset_rw_in_use );
   FD_PACK_BITSET_DECLARE( bitset_w_in_use  );
 
+  /* lookahead_cnt: if non-zero and there is more than one bank tile,
+     pack routes the writers of contended accounts so that all the
+     transactions that write a given contended account execute on the
+     same bank tile, instead of greedily handing them to whichever bank
+     tile asks first and leaving the others stalled behind the
+     conflict.  An account is contended if it is written by at least two
+     of the lookahead_cnt highest priority pending non-vote
+     transactions.  0 means pack schedules greedily.  See
+     fd_pack_route_chains. */
+  ulong      lookahead_cnt;
+
+  /* max_txn_per_fee_payer: the most pending transactions (including
+     ones in bundles) that may share a fee payer.  Transactions from a
+     fee payer at the limit are rejected with FEE_PAYER_CAP, so that a
+     single spammer can't fill the pool and push everyone else out by
+     eviction.  ULONG_MAX means no limit.  fee_payer_cnt maps each fee
+     payer with at least one pending transaction to its number of
+     pending transactions, and is maintained regardless of the limit so
+     that it can be changed at any time. */
+  ulong                max_txn_per_fee_payer;
+  fd_pack_addr_use_t * fee_payer_cnt;
+
+  /* chain_w_bitset[i]: the contended accounts whose writers are
+     currently routed to bank tile i (its "chain"), in the compressed
+     set format.  The sets are pairwise disjoint.  chain_cus[i] is the
+     cost of the transactions in bank tile i's chain that have been
+     scheduled in this block, which is used to balance new chains
+     across bank tiles.  Both are reset at the end of every block. */
+  FD_PACK_BITSET_DECLARE( chain_w_bitset[ FD_PACK_MAX_BANK_TILES ] );
+  ulong      chain_cus[ FD_PACK_MAX_BANK_TILES ];
+
+  /* route_{hot, avoid, claim}_w and route_can_claim are computed by
+     fd_pack_route_chains for the bank tile that is currently being
+     scheduled.  hot is the set of contended accounts, avoid is the
+     subset of hot routed to other bank tiles with outstanding
+     microblocks, and claim is the subset of hot that is not routed to
+     any busy bank tile.  Scheduling a transaction that writes to an
+     account in claim moves the account to this bank tile's chain,
+     which is only permitted if route_can_claim is non-zero. */
+  FD_PACK_BITSET_DECLARE( route_hot_w   );
+  FD_PACK_BITSET_DECLARE( route_avoid_w );
+  FD_PACK_BITSET_DECLARE( route_claim_w );
+  int        route_can_claim;
+
   /* writer_costs: Map from account addresses to the sum of costs of
      transactions that write to the account.  Used for enforcing limits
      on the max write cost per account per block. */
@@ -402,6 +502,15 @@ struct fd_pack_private {
 
   fd_histf_t txn_per_microblock [ 1 ];
   fd_histf_t vote_per_microblock[ 1 ];
+  fd_histf_t cu_est_error       [ 1 ];
+  fd_histf_t block_cost         [ 1 ];
+  fd_histf_t admitted_fee_per_cu[ 1 ];
+  fd_histf_t evicted_fee_per_cu [ 1 ];
+
+  /* cu_est_tbl: learned estimates of the execution CUs that
+     transactions consume, keyed by program.  See CU_EST_TBL_BIN_CNT. */
+  fd_est_tbl_t * cu_est_tbl;
+
   /* bitset_avail: a stack of which bits are not currently reserved and
      can be used to represent an account address.
      Indexed [0, bitset_avail_cnt].  Element 0 is fixed at
@@ -412,6 +521,22 @@ struct fd_pack_private {
   /* acct_to_bitset: an fd_map_dynamic that maps acct addresses to the
      reference count, which bit, etc. */
   fd_pack_bitset_acct_mapping_t * acct_to_bitset;
+
+  /* bundle_*: the transactions of a microblock must not conflict, so a
+     scheduled bundle whose transactions conflict with each other is
+     handed out as several consecutive microblocks, all to the same bank
+     tile.  bundle_bank_tile is that bank tile, or ULONG_MAX if no
+     bundle is being handed out.  bundle_txn[ i ] for i in
+     [bundle_next_idx, bundle_txn_cnt) are the transactions that haven't
+     been handed out yet, and bundle_mb_start[ i ] is non-zero if
+     bundle_txn[ i ] starts a new microblock.  The accounts of the whole
+     bundle stay in use by bundle_bank_tile until its last microblock
+     completes. */
+  ulong      bundle_bank_tile;
+  ulong      bundle_txn_cnt;
+  ulong      bundle_next_idx;
+  uchar      bundle_mb_start[ FD_PACK_MAX_TXN_PER_BUNDLE ];
+  fd_txn_p_t bundle_txn     [ FD_PACK_MAX_TXN_PER_BUNDLE ];
 };
 
 typedef struct fd_pack_private fd_pack_t;
@@ -438,14 +563,16 @@ fd_pack_footprint( ulong                    pack_depth,
 
   l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, FD_PACK_ALIGN,      sizeof(fd_pack_t)                               );
-  l = FD_LAYOUT_APPEND( l, trp_pool_align (),  trp_pool_footprint ( pack_depth+1UL           ) ); /* pool           */
+  l = FD_LAYOUT_APPEND( l, trp_pool_align (),  trp_pool_footprint ( pack_depth+POOL_EXTRA    ) ); /* pool           */
   l = FD_LAYOUT_APPEND( l, expq_align     (),  expq_footprint     ( pack_depth+1UL           ) ); /* expiration prq */
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz           ) ); /* acct_in_use    */
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_writers           ) ); /* writer_costs   */
   l = FD_LAYOUT_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t*)*written_list_max    ); /* written_list   */
   l = FD_LAYOUT_APPEND( l, sig2txn_align  (),  sig2txn_footprint  ( lg_depth                 ) ); /* signature_map  */
+  l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_depth                 ) ); /* fee_payer_cnt  */
   l = FD_LAYOUT_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t)*max_acct_in_flight   ); /* use_by_bank    */
   l = FD_LAYOUT_APPEND( l, bitset_map_align(), bitset_map_footprint( lg_acct_in_trp          ) ); /* acct_to_bitset */
+  l = FD_LAYOUT_APPEND( l, fd_est_tbl_align(), fd_est_tbl_footprint( CU_EST_TBL_BIN_CNT      ) ); /* cu_est_tbl     */
   return FD_LAYOUT_FINI( l, FD_PACK_ALIGN );
 }
 
@@ -470,21 +597,24 @@ fd_pack_new( void                   * mem,
 
   FD_SCRATCH_ALLOC_INIT( l, mem );
   fd_pack_t * pack    = FD_SCRATCH_ALLOC_APPEND( l,  FD_PACK_ALIGN,       sizeof(fd_pack_t)                             );
-  /* The pool has one extra element that is used between insert_init and
-     cancel/fini. */
-  void * _pool        = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),    trp_pool_footprint ( pack_depth+1UL         ) );
+  /* The pool has extra elements that are used between insert_init and
+     cancel/fini.  See POOL_EXTRA. */
+  void * _pool        = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),    trp_pool_footprint ( pack_depth+POOL_EXTRA  ) );
   void * _expq        = FD_SCRATCH_ALLOC_APPEND( l,  expq_align(),        expq_footprint     ( pack_depth+1UL         ) );
   void * _uses        = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_uses_tbl_sz         ) );
   void * _writer_cost = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_max_writers         ) );
   void * _written_lst = FD_SCRATCH_ALLOC_APPEND( l,  32UL,                sizeof(fd_pack_addr_use_t*)*written_list_max  );
   void * _sig_map     = FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),     sig2txn_footprint  ( lg_depth               ) );
+  void * _fee_payers  = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_depth               ) );
   void * _use_by_bank = FD_SCRATCH_ALLOC_APPEND( l,  32UL,                sizeof(fd_pack_addr_use_t)*max_acct_in_flight );
   void * _acct_bitset = FD_SCRATCH_ALLOC_APPEND( l,  bitset_map_align(),  bitset_map_footprint( lg_acct_in_trp        ) );
+  void * _cu_est_tbl  = FD_SCRATCH_ALLOC_APPEND( l,  fd_est_tbl_align(),  fd_est_tbl_footprint( CU_EST_TBL_BIN_CNT    ) );
 
   pack->pack_depth                  = pack_depth;
   pack->bank_tile_cnt               = bank_tile_cnt;
   pack->lim[0]                      = *limits;
   pack->pending_txn_cnt             = 0UL;
+  pack->pending_bundle_cnt          = 0UL;
   pack->microblock_cnt              = 0UL;
   pack->data_bytes_consumed         = 0UL;
   pack->rng                         = rng;
@@ -492,23 +622,31 @@ fd_pack_new( void                   * mem,
   pack->cumulative_vote_cost        = 0UL;
   pack->expire_before               = 0UL;
   pack->outstanding_microblock_mask = 0UL;
+  pack->bundle_bank_tile            = ULONG_MAX;
+  pack->bundle_txn_cnt              = 0UL;
+  pack->bundle_next_idx             = 0UL;
 
 
-  trp_pool_new(  _pool,        pack_depth+1UL );
+  trp_pool_new(  _pool,        pack_depth+POOL_EXTRA );
 
   fd_pack_ord_txn_t * pool = trp_pool_join( _pool );
-  treap_seed( pool, pack_depth+1UL, fd_rng_ulong( rng ) );
+  treap_seed( pool, pack_depth+POOL_EXTRA, fd_rng_ulong( rng ) );
   (void)trp_pool_leave( pool );
 
 
   treap_new( (void*)pack->pending,         pack_depth );
   treap_new( (void*)pack->pending_votes,   pack_depth );
+  treap_new( (void*)pack->pending_bundles, pack_depth );
 
   expq_new( _expq, pack_depth+1UL );
 
   FD_PACK_BITSET_CLEAR( pack->bitset_rw_in_use );
   FD_PACK_BITSET_CLEAR( pack->bitset_w_in_use  );
 
+  pack->lookahead_cnt = 0UL;
+  for( ulong i=0UL; i<bank_tile_cnt; i++ ) FD_PACK_BITSET_CLEAR( pack->chain_w_bitset[i] );
+  for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->chain_cus[i] = 0UL;
+
   acct_uses_new( _uses,        lg_uses_tbl_sz );
   acct_uses_new( _writer_cost, lg_max_writers );
 
@@ -518,6 +656,9 @@ fd_pack_new( void                   * mem,
 
   sig2txn_new(   _sig_map,     lg_depth       );
 
+  pack->max_txn_per_fee_payer = ULONG_MAX;
+  acct_uses_new( _fee_payers,  lg_depth       );
+
   fd_pack_addr_use_t * use_by_bank = (fd_pack_addr_use_t *)_use_by_bank;
   for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->use_by_bank[i]=use_by_bank + i*(FD_TXN_ACCT_ADDR_MAX*limits->max_txn_per_microblock+1UL);
   for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->use_by_bank_cnt[i]=0UL;
@@ -526,6 +667,14 @@ fd_pack_new( void                   * mem,
                                            FD_MHIST_MAX( PACK, TOTAL_TRANSACTIONS_PER_MICROBLOCK_COUNT ) );
   fd_histf_new( pack->vote_per_microblock, FD_MHIST_MIN( PACK, VOTES_PER_MICROBLOCK_COUNT ),
                                            FD_MHIST_MAX( PACK, VOTES_PER_MICROBLOCK_COUNT ) );
+  fd_histf_new( pack->cu_est_error,        FD_MHIST_MIN( PACK, CU_ESTIMATION_ERROR ),
+                                           FD_MHIST_MAX( PACK, CU_ESTIMATION_ERROR ) );
+  fd_histf_new( pack->block_cost,          FD_MHIST_MIN( PACK, BLOCK_COST ),
+                                           FD_MHIST_MAX( PACK, BLOCK_COST ) );
+  fd_histf_new( pack->admitted_fee_per_cu, FD_MHIST_MIN( PACK, ADMITTED_FEE_PER_CU ),
+                                           FD_MHIST_MAX( PACK, ADMITTED_FEE_PER_CU ) );
+  fd_histf_new( pack->evicted_fee_per_cu,  FD_MHIST_MIN( PACK, EVICTED_FEE_PER_CU ),
+                                           FD_MHIST_MAX( PACK, EVICTED_FEE_PER_CU ) );
 
   pack->bitset_avail[ 0 ] = FD_PACK_BITSET_SLOWPATH;
   for( ulong i=0UL; i<FD_PACK_BITSET_MAX; i++ ) pack->bitset_avail[ i+1UL ] = (ushort)i;
@@ -533,6 +682,8 @@ fd_pack_new( void                   * mem,
 
   bitset_map_new( _acct_bitset, lg_acct_in_trp );
 
+  fd_est_tbl_new( _cu_est_tbl, CU_EST_TBL_BIN_CNT, CU_EST_TBL_HISTORY, CU_EST_TBL_NO_DATA );
+
   return mem;
 }
 
@@ -556,14 +707,16 @@ fd_pack_join( void * mem ) {
   int lg_acct_in_trp = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_treap  ) );
 
 
-  pack->pool          = trp_pool_join(   FD_SCRATCH_ALLOC_APPEND( l, trp_pool_align(),   trp_pool_footprint ( pack_depth+1UL ) ) );
+  pack->pool          = trp_pool_join(   FD_SCRATCH_ALLOC_APPEND( l, trp_pool_align(),   trp_pool_footprint ( pack_depth+POOL_EXTRA ) ) );
   pack->expiration_q  = expq_join    (   FD_SCRATCH_ALLOC_APPEND( l, expq_align(),       expq_footprint     ( pack_depth+1UL ) ) );
   pack->acct_in_use   = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz ) ) );
   pack->writer_costs  = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_writers ) ) );
   /* */                                  FD_SCRATCH_ALLOC_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t*)*written_list_max  );
   pack->signature_map = sig2txn_join(    FD_SCRATCH_ALLOC_APPEND( l, sig2txn_align(),    sig2txn_footprint  ( lg_depth       ) ) );
+  pack->fee_payer_cnt = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_depth       ) ) );
   /* */                                  FD_SCRATCH_ALLOC_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t)*max_acct_in_flight );
   pack->acct_to_bitset= bitset_map_join( FD_SCRATCH_ALLOC_APPEND( l, bitset_map_align(), bitset_map_footprint( lg_acct_in_trp) ) );
+  pack->cu_est_tbl    = fd_est_tbl_join( FD_SCRATCH_ALLOC_APPEND( l, fd_est_tbl_align(), fd_est_tbl_footprint( CU_EST_TBL_BIN_CNT ) ) );
 
   FD_MGAUGE_SET( PACK, PENDING_TRANSACTIONS_HEAP_SIZE, pack_depth );
   return pack;
@@ -571,13 +724,37 @@ fd_pack_join( void * mem ) {
 
 
 
+/* fd_pack_cu_est_tag computes the tag under which the learned
+   execution CU estimate for the transaction is stored, which is a hash
+   of the program id of the first instruction that invokes a
+   non-builtin program.  Returns 1 and stores the tag in *tag on
+   success.  Returns 0 if the transaction only invokes builtins, in
+   which case there is nothing to estimate. */
+static inline int
+fd_pack_cu_est_tag( fd_txn_t const * txn,
+                    uchar    const * payload,
+                    ulong          * tag ) {
+  fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, payload );
+  for( ulong i=0UL; i<(ulong)txn->instr_cnt; i++ ) {
+    fd_acct_addr_t const * prog_id = accts + (ulong)txn->instr[ i ].program_id;
+    fd_pack_builtin_prog_cost_t null_row[1] = {{{ 0 }, 0UL }};
+    if( FD_LIKELY( !fd_pack_builtin_query( prog_id, null_row )->cost_per_instr ) ) {
+      *tag = fd_ulong_hash( fd_ulong_load_8( prog_id->b ) );
+      return 1;
+    }
+  }
+  return 0;
+}
+
 static int
-fd_pack_estimate_rewards_and_compute( fd_txn_p_t        * txnp,
+fd_pack_estimate_rewards_and_compute( fd_pack_t         * pack,
+                                      fd_txn_p_t        * txnp,
                                       fd_pack_ord_txn_t * out ) {
   fd_txn_t * txn = TXN(txnp);
   ulong sig_rewards = FD_PACK_FEE_PER_SIGNATURE * txn->signature_cnt;
 
-  ulong cost = fd_pack_compute_cost( txnp, &txnp->flags );
+  ulong execution_cost = 0UL;
+  ulong cost = fd_pack_compute_cost( txnp, &txnp->flags, &execution_cost );
 
   if( FD_UNLIKELY( !cost ) ) return 0;
 
@@ -593,15 +770,26 @@ fd_pack_estimate_rewards_and_compute( fd_txn_p_t        * txnp,
       /* Parse the compute budget program instruction */
       if( FD_UNLIKELY( !fd_compute_budget_program_parse( txnp->payload+txn->instr[ i ].data_off, txn->instr[ i ].data_sz, &cb_prog_st )))
         return 0;
-    } else {
-      /* No fancy CU estimation in this version of pack */
     }
   }
   ulong adtl_rewards = 0UL;
   uint  compute_max  = 0UL;
   fd_compute_budget_program_finalize( &cb_prog_st, txn->instr_cnt, &adtl_rewards, &compute_max );
-  out->rewards     = (adtl_rewards < (UINT_MAX - sig_rewards)) ? (uint)(sig_rewards + adtl_rewards) : UINT_MAX;
-  out->compute_est = (uint)cost;
+
+  /* Order by the learned estimate of the execution CUs rather than the
+     requested value, but never by more than the requested value, since
+     that's what the transaction can actually consume. */
+  ulong prio_execution = execution_cost;
+  ulong tag;
+  if( FD_LIKELY( fd_pack_cu_est_tag( txn, txnp->payload, &tag ) ) ) {
+    double est = fd_est_tbl_estimate( pack->cu_est_tbl, tag, NULL );
+    prio_execution = fd_ulong_min( execution_cost, (ulong)est );
+  }
+
+  out->rewards       = (adtl_rewards < (UINT_MAX - sig_rewards)) ? (uint)(sig_rewards + adtl_rewards) : UINT_MAX;
+  out->compute_est   = (uint)cost;
+  out->execution_est = (uint)execution_cost;
+  out->prio_est      = (uint)(cost - execution_cost + prio_execution);
 
   out->root = (txnp->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE) ? FD_ORD_TXN_ROOT_PENDING_VOTE : FD_ORD_TXN_ROOT_PENDING;
 
@@ -633,24 +821,47 @@ fd_pack_can_fee_payer_afford( fd_acct_addr_t const * acct_addr,
 fd_txn_p_t * fd_pack_insert_txn_init(   fd_pack_t * pack                   ) { return trp_pool_ele_acquire( pack->pool )->txn; }
 void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn ) { trp_pool_ele_release( pack->pool, (fd_pack_ord_txn_t*)txn ); }
 
-#define REJECT( reason ) do {                                       \
-                           trp_pool_ele_release( pack->pool, ord ); \
-                           return FD_PACK_INSERT_REJECT_ ## reason; \
-                         } while( 0 )
+/* fd_pack_fee_payer_txn_cnt returns the number of pending transactions
+   whose fee payer is accts[0]. */
+static inline ulong
+fd_pack_fee_payer_txn_cnt( fd_pack_t            * pack,
+                           fd_acct_addr_t const * accts ) {
+  fd_pack_addr_use_t const * q = acct_uses_query( pack->fee_payer_cnt, accts[0], NULL );
+  return q ? q->txn_cnt : 0UL;
+}
 
-int
-fd_pack_insert_txn_fini( fd_pack_t  * pack,
-                         fd_txn_p_t * txnp,
-                         ulong        expires_at ) {
+/* fd_pack_fee_payer_release records that a transaction paid for by
+   accts[0] is no longer pending. */
+static inline void
+fd_pack_fee_payer_release( fd_pack_t            * pack,
+                           fd_acct_addr_t const * accts ) {
+  fd_pack_addr_use_t * q = acct_uses_query( pack->fee_payer_cnt, accts[0], NULL );
+  if( FD_LIKELY( !--q->txn_cnt ) ) acct_uses_remove( pack->fee_payer_cnt, q );
+}
 
-  fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)txnp;
+/* fd_pack_fee_per_cu returns the fee per compute unit that ord pays,
+   in micro-lamports, which is the unit of the admission and eviction
+   histograms. */
+static inline ulong
+fd_pack_fee_per_cu( fd_pack_ord_txn_t const * ord ) {
+  return ((ulong)ord->rewards * 1000000UL) / fd_ulong_max( (ulong)ord->compute_est, 1UL );
+}
 
-  fd_txn_t * txn   = TXN(txnp);
-  uchar * payload  = txnp->payload;
+/* fd_pack_validate_txn computes the rewards and cost estimates for the
+   transaction in ord and checks whether it is acceptable, independent
+   of how full pack is.  Returns 0 if so and the appropriate
+   FD_PACK_INSERT_REJECT_* code otherwise. */
+static int
+fd_pack_validate_txn( fd_pack_t         * pack,
+                      fd_pack_ord_txn_t * ord,
+                      ulong               expires_at ) {
+  fd_txn_p_t * txnp = ord->txn;
+  fd_txn_t   * txn  = TXN(txnp);
+  uchar * payload   = txnp->payload;
 
   fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, payload );
 
-  if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( txnp, ord ) ) ) REJECT( ESTIMATION_FAIL );
+  if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( pack, txnp, ord ) ) ) return FD_PACK_INSERT_REJECT_ESTIMATION_FAIL;
 
   ord->expires_at = expires_at;
 
@@ -664,42 +875,32 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
 
   /* Throw out transactions ... */
   /*           ... that are unfunded */
-  if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( accts, ord->rewards ) ) ) REJECT( UNAFFORDABLE  );
+  if( FD_UNLIKELY( !fd_pack_can_fee_payer_afford( accts, ord->rewards ) ) ) return FD_PACK_INSERT_REJECT_UNAFFORDABLE;
   /*           ... that are so big they'll never run */
-  if( FD_UNLIKELY( ord->compute_est >= pack->lim->max_cost_per_block    ) ) REJECT( TOO_LARGE     );
+  if( FD_UNLIKELY( ord->compute_est >= pack->lim->max_cost_per_block    ) ) return FD_PACK_INSERT_REJECT_TOO_LARGE;
   /*           ... that try to write to a sysvar */
-  if( FD_UNLIKELY( writes_to_sysvar                                     ) ) REJECT( WRITES_SYSVAR );
+  if( FD_UNLIKELY( writes_to_sysvar                                     ) ) return FD_PACK_INSERT_REJECT_WRITES_SYSVAR;
   /*           ... that we already know about */
-  if( FD_UNLIKELY( sig2txn_query( pack->signature_map, sig, NULL )      ) ) REJECT( DUPLICATE     );
+  if( FD_UNLIKELY( sig2txn_query( pack->signature_map, sig, NULL )      ) ) return FD_PACK_INSERT_REJECT_DUPLICATE;
   /*           ... that have already expired */
-  if( FD_UNLIKELY( expires_at<pack->expire_before                       ) ) REJECT( EXPIRED       );
+  if( FD_UNLIKELY( expires_at<pack->expire_before                       ) ) return FD_PACK_INSERT_REJECT_EXPIRED;
   /*           ... that additional accounts from an ALT */
-  if( FD_UNLIKELY( txn->addr_table_adtl_cnt>0UL                         ) ) REJECT( ADDR_LUT      );
+  if( FD_UNLIKELY( txn->addr_table_adtl_cnt>0UL                         ) ) return FD_PACK_INSERT_REJECT_ADDR_LUT;
+  /*           ... whose fee payer already has too many pending */
+  if( FD_UNLIKELY( fd_pack_fee_payer_txn_cnt( pack, accts )>=pack->max_txn_per_fee_payer ) ) return FD_PACK_INSERT_REJECT_FEE_PAYER_CAP;
 
+  return 0;
+}
 
-  int replaces = 0;
-  if( FD_UNLIKELY( pack->pending_txn_cnt == pack->pack_depth ) ) {
-    /* If the tree is full, we'll double check to make sure this is
-       better than the worst element in the tree before inserting.  If
-       the new transaction is better than that one, we'll delete it and
-       insert the new transaction. Otherwise, we'll throw away this
-       transaction. */
-    fd_pack_ord_txn_t * worst = treap_fwd_iter_ele( treap_fwd_iter_init( pack->pending, pack->pool ), pack->pool );
-    if( FD_UNLIKELY( !worst ) ) {
-      /* We have nothing to sacrifice because they're all votes. */
-      REJECT( FULL );
-    }
-    else if( !COMPARE_WORSE( worst, ord ) ) {
-      /* What we have in the tree is better than this transaction, so just
-         pretend this transaction never happened */
-      REJECT( PRIORITY );
-    } else {
-      /* Remove the worst from the tree */
-      replaces = 1;
-      fd_ed25519_sig_t const * worst_sig = fd_txn_get_signatures( TXN( worst->txn ), worst->txn->payload );
-      fd_pack_delete_transaction( pack, worst_sig );
-    }
-  }
+/* fd_pack_register_accts takes a reference to each account the
+   transaction in ord uses, allocating bits for them as necessary, fills
+   in ord's bitsets, and counts the transaction against its fee
+   payer. */
+static void
+fd_pack_register_accts( fd_pack_t         * pack,
+                        fd_pack_ord_txn_t * ord ) {
+  fd_txn_t * txn = TXN(ord->txn);
+  fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, ord->txn->payload );
 
   FD_PACK_BITSET_CLEAR( ord->rw_bitset );
   FD_PACK_BITSET_CLEAR( ord->w_bitset  );
@@ -752,9 +953,60 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
     FD_PACK_BITSET_SETN( ord->rw_bitset, q->bit );
   }
 
+  fd_pack_addr_use_t * payer = acct_uses_query( pack->fee_payer_cnt, accts[0], NULL );
+  if( FD_UNLIKELY( !payer ) ) { payer = acct_uses_insert( pack->fee_payer_cnt, accts[0] ); payer->txn_cnt = 0UL; }
+  payer->txn_cnt++;
+}
+
+#define REJECT( reason ) do {                                       \
+                           trp_pool_ele_release( pack->pool, ord ); \
+                           return FD_PACK_INSERT_REJECT_ ## reason; \
+                         } while( 0 )
+
+int
+fd_pack_insert_txn_fini( fd_pack_t  * pack,
+                         fd_txn_p_t * txnp,
+                         ulong        expires_at ) {
+
+  fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)txnp;
+
+  int invalid = fd_pack_validate_txn( pack, ord, expires_at );
+  if( FD_UNLIKELY( invalid ) ) {
+    trp_pool_ele_release( pack->pool, ord );
+    return invalid;
+  }
+
+  int replaces = 0;
+  if( FD_UNLIKELY( pack->pending_txn_cnt+pack->pending_bundle_cnt >= pack->pack_depth ) ) {
+    /* If the tree is full, we'll double check to make sure this is
+       better than the worst element in the tree before inserting.  If
+       the new transaction is better than that one, we'll delete it and
+       insert the new transaction. Otherwise, we'll throw away this
+       transaction. */
+    fd_pack_ord_txn_t * worst = treap_fwd_iter_ele( treap_fwd_iter_init( pack->pending, pack->pool ), pack->pool );
+    if( FD_UNLIKELY( !worst ) ) {
+      /* We have nothing to sacrifice because they're all votes. */
+      REJECT( FULL );
+    }
+    else if( !COMPARE_WORSE( worst, ord ) ) {
+      /* What we have in the tree is better than this transaction, so just
+         pretend this transaction never happened */
+      REJECT( PRIORITY );
+    } else {
+      /* Remove the worst from the tree */
+      replaces = 1;
+      fd_histf_sample( pack->evicted_fee_per_cu, fd_pack_fee_per_cu( worst ) );
+      fd_ed25519_sig_t const * worst_sig = fd_txn_get_signatures( TXN( worst->txn ), worst->txn->payload );
+      fd_pack_delete_transaction( pack, worst_sig );
+    }
+  }
+
+  fd_pack_register_accts( pack, ord );
+  fd_histf_sample( pack->admitted_fee_per_cu, fd_pack_fee_per_cu( ord ) );
+
   pack->pending_txn_cnt++;
 
-  sig2txn_insert( pack->signature_map, fd_txn_get_signatures( txn, payload ) );
+  sig2txn_insert( pack->signature_map, fd_txn_get_signatures( TXN(txnp), txnp->payload ) );
 
   fd_pack_expq_t temp[ 1 ] = {{ .expires_at = expires_at, .txn = ord }};
   expq_insert( pack->expiration_q, temp );
@@ -769,6 +1021,146 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
 }
 #undef REJECT
 
+fd_txn_p_t * *
+fd_pack_insert_bundle_init( fd_pack_t   *   pack,
+                            fd_txn_p_t  * * bundle,
+                            ulong           txn_cnt ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  /* The header is acquired here as well so that _fini can't fail for
+     lack of pool elements.  We stash its index in the first
+     transaction until _fini or _cancel. */
+  ulong hdr_idx = trp_pool_idx_acquire( pool );
+  for( ulong i=0UL; i<txn_cnt; i++ ) bundle[ i ] = trp_pool_ele_acquire( pool )->txn;
+  ((fd_pack_ord_txn_t *)bundle[ 0 ])->bundle_hdr = (ushort)hdr_idx;
+  return bundle;
+}
+
+void
+fd_pack_insert_bundle_cancel( fd_pack_t          * pack,
+                              fd_txn_p_t * const * bundle,
+                              ulong                txn_cnt ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  trp_pool_idx_release( pool, ((fd_pack_ord_txn_t *)bundle[ 0 ])->bundle_hdr );
+  for( ulong i=0UL; i<txn_cnt; i++ ) trp_pool_ele_release( pool, (fd_pack_ord_txn_t *)bundle[ i ] );
+}
+
+int
+fd_pack_insert_bundle_fini( fd_pack_t          * pack,
+                            fd_txn_p_t * const * bundle,
+                            ulong                txn_cnt,
+                            ulong                expires_at ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  fd_pack_ord_txn_t * hdr  = pool + ((fd_pack_ord_txn_t *)bundle[ 0 ])->bundle_hdr;
+
+  ulong rewards       = 0UL;
+  ulong compute_est   = 0UL;
+  ulong execution_est = 0UL;
+  ulong prio_est      = 0UL;
+
+  int invalid = 0;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)bundle[ i ];
+    invalid = fd_pack_validate_txn( pack, ord, expires_at );
+    if( FD_UNLIKELY( invalid ) ) break;
+
+    fd_ed25519_sig_t const * sig = fd_txn_get_signatures( TXN(ord->txn), ord->txn->payload );
+    fd_acct_addr_t const * payer = fd_txn_get_acct_addrs( TXN(ord->txn), ord->txn->payload );
+    ulong same_payer_cnt = fd_pack_fee_payer_txn_cnt( pack, payer );
+    for( ulong j=0UL; j<i; j++ ) {
+      fd_txn_p_t const * other = bundle[ j ];
+      if( FD_UNLIKELY( !memcmp( sig, fd_txn_get_signatures( TXN(other), other->payload ), FD_TXN_SIGNATURE_SZ ) ) ) {
+        invalid = FD_PACK_INSERT_REJECT_DUPLICATE;
+        break;
+      }
+      same_payer_cnt += !memcmp( payer, fd_txn_get_acct_addrs( TXN(other), other->payload ), FD_TXN_ACCT_ADDR_SZ );
+    }
+    if( FD_UNLIKELY( invalid ) ) break;
+    /* The earlier transactions in the bundle count against the cap too */
+    if( FD_UNLIKELY( same_payer_cnt>=pack->max_txn_per_fee_payer ) ) {
+      invalid = FD_PACK_INSERT_REJECT_FEE_PAYER_CAP;
+      break;
+    }
+
+    rewards       += ord->rewards;
+    compute_est   += ord->compute_est;
+    execution_est += ord->execution_est;
+    prio_est      += ord->prio_est;
+  }
+
+  /* No microblock of the bundle can be larger than the whole bundle,
+     so the bundle has to fit in a single microblock */
+  if( FD_UNLIKELY( (!invalid) & ((compute_est>=pack->lim->max_cost_per_block) | (txn_cnt>pack->lim->max_txn_per_microblock)) ) ) {
+    invalid = FD_PACK_INSERT_REJECT_TOO_LARGE;
+  }
+
+  if( FD_UNLIKELY( invalid ) ) {
+    fd_pack_insert_bundle_cancel( pack, bundle, txn_cnt );
+    return invalid;
+  }
+
+  hdr->rewards       = (uint)fd_ulong_min( rewards, UINT_MAX );
+  hdr->compute_est   = (uint)compute_est;
+  hdr->execution_est = (uint)execution_est;
+  hdr->prio_est      = (uint)prio_est;
+  hdr->expires_at    = expires_at;
+  hdr->root          = FD_ORD_TXN_ROOT_PENDING_BUNDLE;
+  hdr->txn->payload_sz = 0UL;
+  hdr->txn->flags      = 0U;
+
+  /* The bundle needs txn_cnt+1 pool elements.  If pack is full, it can
+     only replace individual transactions, and only if each one of them
+     is worse than the bundle as a whole.  Check before deleting
+     anything so that a rejected bundle doesn't cause any evictions. */
+  ulong used = pack->pending_txn_cnt + pack->pending_bundle_cnt;
+  ulong need = txn_cnt + 1UL;
+  int replaces = 0;
+  if( FD_UNLIKELY( used+need > pack->pack_depth ) ) {
+    ulong evict_cnt = used + need - pack->pack_depth;
+    ulong checked   = 0UL;
+    for( treap_fwd_iter_t _cur=treap_fwd_iter_init( pack->pending, pool ); (checked<evict_cnt) & !treap_fwd_iter_done( _cur );
+        _cur=treap_fwd_iter_next( _cur, pool ) ) {
+      if( FD_UNLIKELY( !COMPARE_WORSE( treap_fwd_iter_ele_const( _cur, pool ), hdr ) ) ) {
+        fd_pack_insert_bundle_cancel( pack, bundle, txn_cnt );
+        return FD_PACK_INSERT_REJECT_PRIORITY;
+      }
+      checked++;
+    }
+    if( FD_UNLIKELY( checked<evict_cnt ) ) {
+      fd_pack_insert_bundle_cancel( pack, bundle, txn_cnt );
+      return FD_PACK_INSERT_REJECT_FULL;
+    }
+    for( ulong i=0UL; i<evict_cnt; i++ ) {
+      fd_pack_ord_txn_t * worst = treap_fwd_iter_ele( treap_fwd_iter_init( pack->pending, pool ), pool );
+      fd_histf_sample( pack->evicted_fee_per_cu, fd_pack_fee_per_cu( worst ) );
+      fd_pack_delete_transaction( pack, fd_txn_get_signatures( TXN( worst->txn ), worst->txn->payload ) );
+    }
+    replaces = 1;
+  }
+
+  ulong hdr_idx = trp_pool_idx( pool, hdr );
+  hdr->bundle_next = (ushort)trp_pool_idx( pool, (fd_pack_ord_txn_t *)bundle[ 0 ] );
+  hdr->bundle_hdr  = (ushort)hdr_idx;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)bundle[ i ];
+    ord->root        = FD_ORD_TXN_ROOT_BUNDLE_MEMBER;
+    ord->bundle_hdr  = (ushort)hdr_idx;
+    ord->bundle_next = (ushort)( i+1UL<txn_cnt ? trp_pool_idx( pool, (fd_pack_ord_txn_t *)bundle[ i+1UL ] ) : trp_pool_idx_null( pool ) );
+
+    fd_pack_register_accts( pack, ord );
+    sig2txn_insert( pack->signature_map, fd_txn_get_signatures( TXN(ord->txn), ord->txn->payload ) );
+  }
+
+  pack->pending_txn_cnt += txn_cnt;
+  pack->pending_bundle_cnt++;
+  fd_histf_sample( pack->admitted_fee_per_cu, fd_pack_fee_per_cu( hdr ) );
+
+  fd_pack_expq_t temp[ 1 ] = {{ .expires_at = expires_at, .txn = hdr }};
+  expq_insert( pack->expiration_q, temp );
+  treap_ele_insert( pack->pending_bundles, hdr, pool );
+
+  return replaces ? FD_PACK_INSERT_ACCEPT_NONVOTE_REPLACE : FD_PACK_INSERT_ACCEPT_NONVOTE_ADD;
+}
+
 typedef struct {
   ushort clear_rw_bit;
   ushort clear_w_bit;
@@ -788,6 +1180,12 @@ release_bit_reference( fd_pack_t            * pack,
     bitset_map_remove( pack->acct_to_bitset, q );
     if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
 
+    /* The bit may be reused for a different account, so it can't stay
+       in any chain. */
+    if( FD_UNLIKELY( pack->lookahead_cnt ) ) {
+      for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) FD_PACK_BITSET_CLEARN( pack->chain_w_bitset[i], bit );
+    }
+
     fd_pack_addr_use_t * use = acct_uses_query( pack->acct_in_use,  *acct, NULL );
     if( FD_LIKELY( use ) ) {
       use->in_use_by |= FD_PACK_IN_USE_BIT_CLEARED;
@@ -800,6 +1198,115 @@ release_bit_reference( fd_pack_t            * pack,
   return ret;
 }
 
+/* fd_pack_release_accts drops the references to accounts and the fee
+   payer count that the pending transaction in ord took in
+   fd_pack_register_accts. */
+static void
+fd_pack_release_accts( fd_pack_t         * pack,
+                       fd_pack_ord_txn_t * ord ) {
+  fd_txn_t * _txn = TXN( ord->txn );
+  fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( _txn, ord->txn->payload );
+  for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( _txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+      iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+    ulong i=fd_txn_acct_iter_idx( iter );
+
+    release_result_t ret = release_bit_reference( pack, accts+i );
+    FD_PACK_BITSET_CLEARN( pack->bitset_rw_in_use, ret.clear_rw_bit );
+    FD_PACK_BITSET_CLEARN( pack->bitset_w_in_use,  ret.clear_w_bit  );
+  }
+
+  for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( _txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
+      iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+    ulong i=fd_txn_acct_iter_idx( iter );
+    if( FD_UNLIKELY( fd_pack_unwritable_contains( accts+i ) ) ) continue;
+
+    release_result_t ret = release_bit_reference( pack, accts+i );
+    FD_PACK_BITSET_CLEARN( pack->bitset_rw_in_use, ret.clear_rw_bit );
+    FD_PACK_BITSET_CLEARN( pack->bitset_w_in_use,  ret.clear_w_bit  );
+  }
+
+  fd_pack_fee_payer_release( pack, accts );
+}
+
+/* fd_pack_delete_bundle deletes the pending bundle with header hdr and
+   all its transactions.  Returns the number of transactions deleted. */
+static ulong
+fd_pack_delete_bundle( fd_pack_t         * pack,
+                       fd_pack_ord_txn_t * hdr ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  ulong deleted_cnt = 0UL;
+  ulong next;
+  for( ulong idx=hdr->bundle_next; idx!=trp_pool_idx_null( pool ); idx=next ) {
+    fd_pack_ord_txn_t * ord = pool+idx;
+    next = ord->bundle_next;
+
+    fd_pack_release_accts( pack, ord );
+    fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, fd_txn_get_signatures( TXN( ord->txn ), ord->txn->payload ), NULL );
+    sig2txn_remove( pack->signature_map, in_tbl );
+    trp_pool_idx_release( pool, idx );
+    deleted_cnt++;
+  }
+  expq_remove( pack->expiration_q, hdr->expq_idx );
+  treap_ele_remove( pack->pending_bundles, hdr, pool );
+  trp_pool_ele_release( pool, hdr );
+
+  pack->pending_txn_cnt -= deleted_cnt;
+  pack->pending_bundle_cnt--;
+  return deleted_cnt;
+}
+
+/* fd_pack_route_chains computes route_{hot,avoid,claim}_w and
+   route_can_claim in preparation for scheduling a microblock for
+   bank_tile.
+
+   The idea is that when several high priority transactions write the
+   same account, they can only execute one after the other anyway, so
+   it's best to send all of them to one bank tile, where they execute
+   back to back, and keep the other bank tiles busy with transactions
+   that don't touch that account.  Greedy scheduling instead gives the
+   first such writer to whichever bank tile asks first, and then every
+   other bank tile skips the remaining writers until that microblock
+   completes, often leaving them with nothing useful to do.
+
+   A bank tile only starts a new chain if the CUs its chains have
+   consumed in this block are no more than the average across bank
+   tiles, which keeps the contended work spread evenly. */
+static inline void
+fd_pack_route_chains( fd_pack_t * pack,
+                      ulong       bank_tile ) {
+  FD_PACK_BITSET_DECLARE( seen_w );
+  FD_PACK_BITSET_DECLARE( dup_w  );
+  FD_PACK_BITSET_CLEAR( seen_w );
+  FD_PACK_BITSET_CLEAR( pack->route_hot_w );
+
+  ulong scanned = 0UL;
+  for( treap_rev_iter_t _cur=treap_rev_iter_init( pack->pending, pack->pool );
+      (scanned<pack->lookahead_cnt) & !treap_rev_iter_done( _cur ); _cur=treap_rev_iter_next( _cur, pack->pool ) ) {
+    fd_pack_ord_txn_t const * cur = treap_rev_iter_ele_const( _cur, pack->pool );
+    FD_PACK_BITSET_COPY( dup_w, cur->w_bitset );
+    FD_PACK_BITSET_AND ( dup_w, seen_w        );
+    FD_PACK_BITSET_OR  ( pack->route_hot_w, dup_w );
+    FD_PACK_BITSET_OR  ( seen_w, cur->w_bitset );
+    scanned++;
+  }
+
+  ulong total_chain_cus = 0UL;
+  FD_PACK_BITSET_CLEAR( pack->route_avoid_w );
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) {
+    total_chain_cus += pack->chain_cus[i];
+    /* A chain on a bank tile that is idle is up for grabs */
+    if( (i==bank_tile) | !(pack->outstanding_microblock_mask & (1UL<<i)) ) continue;
+    FD_PACK_BITSET_OR( pack->route_avoid_w, pack->chain_w_bitset[i] );
+  }
+  FD_PACK_BITSET_AND( pack->route_avoid_w, pack->route_hot_w );
+
+  FD_PACK_BITSET_COPY  ( pack->route_claim_w, pack->route_hot_w                 );
+  FD_PACK_BITSET_ANDNOT( pack->route_claim_w, pack->chain_w_bitset[ bank_tile ] );
+  FD_PACK_BITSET_ANDNOT( pack->route_claim_w, pack->route_avoid_w               );
+
+  pack->route_can_claim = pack->chain_cus[ bank_tile ]*pack->bank_tile_cnt <= total_chain_cus;
+}
+
 typedef struct {
   ulong cus_scheduled;
   ulong txns_scheduled;
@@ -813,6 +1320,7 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
                        ulong        txn_limit,
                        ulong        byte_limit,
                        ulong        bank_tile,
+                       int          route,
                        fd_txn_p_t * out ) {
 
   fd_pack_ord_txn_t  * pool         = pack->pool;
@@ -844,6 +1352,10 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
   ulong cu_limit_c    = 0UL;
   ulong byte_limit_c  = 0UL;
   ulong write_limit_c = 0UL;
+  ulong chain_c       = 0UL;
+
+  /* Only used if route is set.  See fd_pack_route_chains. */
+  FD_PACK_BITSET_DECLARE( claimed_w );
 
   if( FD_UNLIKELY( (cu_limit<FD_PACK_MIN_TXN_COST) | (txn_limit==0UL) | (byte_limit<FD_TXN_MIN_SERIALIZED_SZ) ) ) {
     sched_return_t to_return = { .cus_scheduled = 0UL, .txns_scheduled = 0UL, .bytes_scheduled = 0UL };
@@ -881,6 +1393,21 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
       continue;
     }
 
+    /* If this transaction writes a contended account, it may only go to
+       this bank tile if the account is in this bank tile's chain or if
+       this bank tile can start a new chain for it.  We start at most
+       one new chain per microblock. */
+    int claims = 0;
+    if( FD_UNLIKELY( route ) ) {
+      if( FD_UNLIKELY( !FD_PACK_BITSET_INTERSECT4_EMPTY( pack->route_avoid_w, pack->route_claim_w, cur->w_bitset, cur->w_bitset ) ) ) {
+        if( !FD_PACK_BITSET_INTERSECT4_EMPTY( pack->route_avoid_w, pack->route_avoid_w, cur->w_bitset, cur->w_bitset ) | !pack->route_can_claim ) {
+          chain_c++;
+          continue;
+        }
+        claims = 1;
+      }
+    }
+
     fd_txn_t const * txn = TXN(cur->txn);
     fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, cur->txn->payload );
     /* Check conflicts between this transaction's writable accounts and
@@ -932,6 +1459,20 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
     FD_PACK_BITSET_OR( bitset_rw_in_use, cur->rw_bitset );
     FD_PACK_BITSET_OR( bitset_w_in_use,  cur->w_bitset  );
 
+    if( FD_UNLIKELY( route ) ) {
+      /* This has to happen before the bit references are released
+         below, since that might free some of the bits. */
+      FD_PACK_BITSET_COPY( claimed_w, cur->w_bitset     );
+      FD_PACK_BITSET_AND ( claimed_w, pack->route_hot_w );
+      if( FD_UNLIKELY( claims ) ) {
+        for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) FD_PACK_BITSET_ANDNOT( pack->chain_w_bitset[i], claimed_w );
+        FD_PACK_BITSET_OR    ( pack->chain_w_bitset[ bank_tile ], claimed_w );
+        FD_PACK_BITSET_ANDNOT( pack->route_claim_w,               claimed_w );
+        pack->route_can_claim = 0;
+      }
+      if( !FD_PACK_BITSET_ISNULL( claimed_w ) ) pack->chain_cus[ bank_tile ] += cur->compute_est;
+    }
+
     fd_memcpy( out->payload, cur->txn->payload, cur->txn->payload_sz                                           );
     fd_memcpy( TXN(out),     txn,               fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
     out->payload_sz = cur->txn->payload_sz;
@@ -993,6 +1534,7 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
 
     fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
     sig2txn_remove( pack->signature_map, in_tbl );
+    fd_pack_fee_payer_release( pack, acct );
 
     expq_remove( pack->expiration_q, cur->expq_idx );
     treap_idx_remove( sched_from, _cur, pool );
@@ -1008,6 +1550,7 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
   FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_BYTE_LIMIT, byte_limit_c   );
   FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_WRITE_COST, write_limit_c  );
   FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_SLOW_PATH,  slow_path      );
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_CHAIN,      chain_c        );
 
 #if DETAILED_LOGGING
   FD_LOG_NOTICE(( "cu_limit: %lu, fast_path: %lu, slow_path: %lu", cu_limit_c, fast_path, slow_path ));
@@ -1023,9 +1566,322 @@ fd_pack_schedule_impl( fd_pack_t  * pack,
   return to_return;
 }
 
+/* fd_pack_bundle_txns_conflict returns 1 if a and b can't be in the
+   same microblock, because one of them writes an account that the
+   other one reads or writes, and 0 otherwise.  Bundles can't contain
+   address lookup tables, so only the accounts in the payload matter.
+   This is quadratic in the number of accounts, but with at most
+   FD_PACK_MAX_TXN_PER_BUNDLE transactions of a few dozen accounts each
+   in a bundle, it's cheaper than building a map. */
+static int
+fd_pack_bundle_txns_conflict( fd_txn_p_t const * a,
+                              fd_txn_p_t const * b ) {
+  fd_txn_t const * txn_a = TXN(a);
+  fd_txn_t const * txn_b = TXN(b);
+  fd_acct_addr_t const * accts_a = fd_txn_get_acct_addrs( txn_a, a->payload );
+  fd_acct_addr_t const * accts_b = fd_txn_get_acct_addrs( txn_b, b->payload );
+
+  for( fd_txn_acct_iter_t iter_a=fd_txn_acct_iter_init( txn_a, FD_TXN_ACCT_CAT_IMM );
+      iter_a!=fd_txn_acct_iter_end(); iter_a=fd_txn_acct_iter_next( iter_a ) ) {
+    ulong i = fd_txn_acct_iter_idx( iter_a );
+    int   w = fd_txn_is_writable( txn_a, (int)i );
+    /* Reads conflict only with writes */
+    for( fd_txn_acct_iter_t iter_b=fd_txn_acct_iter_init( txn_b, w ? FD_TXN_ACCT_CAT_IMM : (FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM) );
+        iter_b!=fd_txn_acct_iter_end(); iter_b=fd_txn_acct_iter_next( iter_b ) ) {
+      if( FD_UNLIKELY( !memcmp( accts_a+i, accts_b+fd_txn_acct_iter_idx( iter_b ), FD_TXN_ACCT_ADDR_SZ ) ) ) return 1;
+    }
+  }
+  return 0;
+}
+
+/* fd_pack_schedule_bundle tries to schedule the highest priority
+   pending bundle that fits in the provided limits and that doesn't
+   conflict with any microblock outstanding on another bank tile.  If
+   there is one, it marks the accounts of all of the bundle's
+   transactions in use by bank_tile, moves the transactions in order to
+   bundle_txn, splitting them into microblocks of consecutive
+   transactions that don't conflict with each other, removes the bundle
+   from pack, and returns the totals for the bundle, not including the
+   per microblock overhead.  The caller must account for all of the
+   bundle's microblocks and then hand them out with
+   fd_pack_bundle_next_microblock.  Otherwise, returns all zeros. */
+static sched_return_t
+fd_pack_schedule_bundle( fd_pack_t  * pack,
+                         ulong        cu_limit,
+                         ulong        vote_cu_limit,
+                         ulong        txn_limit,
+                         ulong        byte_limit,
+                         ulong        bank_tile ) {
+
+  fd_pack_ord_txn_t  * pool         = pack->pool;
+  fd_pack_addr_use_t * acct_in_use  = pack->acct_in_use;
+  fd_pack_addr_use_t * writer_costs = pack->writer_costs;
+  ulong                null_idx     = trp_pool_idx_null( pool );
+
+  ulong max_write_cost_per_acct = pack->lim->max_write_cost_per_acct;
+  ulong bank_tile_mask          = 1UL << bank_tile;
+
+  ulong fast_path     = 0UL;
+  ulong slow_path     = 0UL;
+  ulong cu_limit_c    = 0UL;
+  ulong byte_limit_c  = 0UL;
+  ulong write_limit_c = 0UL;
+  ulong mb_limit_c    = 0UL;
+
+  FD_PACK_BITSET_DECLARE( bundle_rw_bitset );
+  FD_PACK_BITSET_DECLARE( bundle_w_bitset  );
+
+  fd_pack_ord_txn_t * hdr = NULL;
+  ulong txn_cnt   = 0UL;
+  ulong bytes     = 0UL;
+  ulong vote_cus  = 0UL;
+  ulong mb_cnt    = 0UL;
+  uchar mb_start[ FD_PACK_MAX_TXN_PER_BUNDLE ];
+  fd_txn_p_t const * bundle[ FD_PACK_MAX_TXN_PER_BUNDLE ];
+
+  for( treap_rev_iter_t _cur=treap_rev_iter_init( pack->pending_bundles, pool ); !treap_rev_iter_done( _cur );
+      _cur=treap_rev_iter_next( _cur, pool ) ) {
+    fd_pack_ord_txn_t * cur = treap_rev_iter_ele( _cur, pool );
+
+    txn_cnt  = 0UL;
+    bytes    = 0UL;
+    vote_cus = 0UL;
+    FD_PACK_BITSET_CLEAR( bundle_rw_bitset );
+    FD_PACK_BITSET_CLEAR( bundle_w_bitset  );
+    for( ulong idx=cur->bundle_next; idx!=null_idx; idx=pool[ idx ].bundle_next ) {
+      fd_pack_ord_txn_t const * ord = pool+idx;
+      bundle[ txn_cnt++ ] = ord->txn;
+      bytes    += ord->txn->payload_sz;
+      vote_cus += fd_ulong_if( !!(ord->txn->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE), ord->compute_est, 0UL );
+      FD_PACK_BITSET_OR( bundle_rw_bitset, ord->rw_bitset );
+      FD_PACK_BITSET_OR( bundle_w_bitset,  ord->w_bitset  );
+    }
+
+    if( FD_UNLIKELY( (cur->compute_est>cu_limit) | (vote_cus>vote_cu_limit) | (txn_cnt>txn_limit) ) ) {
+      cu_limit_c++;
+      continue;
+    }
+
+    if( FD_LIKELY( !FD_PACK_BITSET_INTERSECT4_EMPTY( pack->bitset_rw_in_use, pack->bitset_w_in_use, bundle_w_bitset, bundle_rw_bitset ) ) ) {
+      fast_path++;
+      continue;
+    }
+
+    /* A transaction starts a new microblock if it conflicts with one of
+       the transactions in the current one */
+    mb_cnt = 0UL;
+    ulong mb_first = 0UL;
+    for( ulong i=0UL; i<txn_cnt; i++ ) {
+      int conflict = !i;
+      for( ulong j=mb_first; (j<i) & !conflict; j++ ) conflict = fd_pack_bundle_txns_conflict( bundle[ i ], bundle[ j ] );
+      mb_start[ i ] = (uchar)conflict;
+      mb_cnt       += (ulong)conflict;
+      mb_first      = fd_ulong_if( conflict, i, mb_first );
+    }
+
+    if( FD_UNLIKELY( bytes+(mb_cnt-1UL)*MICROBLOCK_DATA_OVERHEAD>byte_limit ) ) {
+      byte_limit_c++;
+      continue;
+    }
+
+    if( FD_UNLIKELY( pack->microblock_cnt+mb_cnt>pack->lim->max_microblocks_per_block ) ) {
+      mb_limit_c++;
+      continue;
+    }
+
+    /* Same as the checks in fd_pack_schedule_impl, but for every
+       transaction in the bundle.  The writer cost check is conservative:
+       it charges the cost of the whole bundle to each account any of its
+       transactions write. */
+    ulong conflicts = 0UL;
+    for( ulong idx=cur->bundle_next; (idx!=null_idx) & (conflicts!=ULONG_MAX); idx=pool[ idx ].bundle_next ) {
+      fd_txn_t const * txn = TXN( pool[ idx ].txn );
+      fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, pool[ idx ].txn->payload );
+
+      for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+          iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+        ulong i=fd_txn_acct_iter_idx( iter );
+
+        fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct[i], NULL );
+        if( FD_UNLIKELY( in_wcost_table && in_wcost_table->total_cost+cur->compute_est > max_write_cost_per_acct ) ) {
+          conflicts = ULONG_MAX;
+          break;
+        }
+
+        fd_pack_addr_use_t * use = acct_uses_query( acct_in_use, acct[i], NULL );
+        if( FD_UNLIKELY( use ) ) conflicts |= use->in_use_by;
+      }
+      if( FD_UNLIKELY( conflicts==ULONG_MAX ) ) break;
+
+      for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
+          iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+        ulong i=fd_txn_acct_iter_idx( iter );
+        if( fd_pack_unwritable_contains( acct+i ) ) continue;
+
+        fd_pack_addr_use_t * use = acct_uses_query( acct_in_use, acct[i], NULL );
+        if( use ) conflicts |= (use->in_use_by & FD_PACK_IN_USE_WRITABLE) ? use->in_use_by : 0UL;
+      }
+    }
+
+    if( FD_UNLIKELY( conflicts==ULONG_MAX ) ) {
+      write_limit_c++;
+      continue;
+    }
+    if( FD_UNLIKELY( conflicts ) ) {
+      slow_path++;
+      continue;
+    }
+
+    hdr = cur;
+    break;
+  }
+
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_CU_LIMIT,   cu_limit_c     );
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_FAST_PATH,  fast_path      );
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_BYTE_LIMIT, byte_limit_c   );
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_WRITE_COST, write_limit_c  );
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_SLOW_PATH,  slow_path      );
+  FD_MCNT_INC( PACK, MICROBLOCK_PER_BLOCK_LIMIT,      mb_limit_c     );
+
+  if( FD_LIKELY( !hdr ) ) {
+    sched_return_t to_return = { .cus_scheduled = 0UL, .txns_scheduled = 0UL, .bytes_scheduled = 0UL };
+    return to_return;
+  }
+
+  /* Include the bundle in the microblocks! */
+  FD_PACK_BITSET_OR( pack->bitset_rw_in_use, bundle_rw_bitset );
+  FD_PACK_BITSET_OR( pack->bitset_w_in_use,  bundle_w_bitset  );
+
+  fd_pack_addr_use_t ** written_list     = pack->written_list;
+  ulong                 written_list_cnt = pack->written_list_cnt;
+  ulong                 written_list_max = pack->written_list_max;
+
+  fd_pack_addr_use_t * use_by_bank     = pack->use_by_bank    [bank_tile];
+  ulong                use_by_bank_cnt = pack->use_by_bank_cnt[bank_tile];
+
+  ulong next;
+  ulong k = 0UL;
+  for( ulong idx=hdr->bundle_next; idx!=null_idx; idx=next ) {
+    fd_pack_ord_txn_t * cur = pool+idx;
+    next = cur->bundle_next;
+
+    fd_txn_t const * txn = TXN(cur->txn);
+    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, cur->txn->payload );
+
+    fd_txn_p_t * out = pack->bundle_txn+k;
+    fd_memcpy( out->payload, cur->txn->payload, cur->txn->payload_sz                                           );
+    fd_memcpy( TXN(out),     txn,               fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+    out->payload_sz = cur->txn->payload_sz;
+    out->meta       = cur->txn->meta;
+    out->flags      = cur->txn->flags | FD_TXN_P_FLAGS_BUNDLE | fd_uint_if( !k, FD_TXN_P_FLAGS_BUNDLE_START, 0U );
+    pack->bundle_mb_start[ k ] = mb_start[ k ];
+    k++;
+
+    /* Unlike in fd_pack_schedule_impl, an earlier transaction in the
+       bundle may already have marked an account in use, so we can't
+       assume it's absent from acct_in_use. */
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+      fd_acct_addr_t acct_addr = acct[fd_txn_acct_iter_idx( iter )];
+
+      fd_pack_addr_use_t * in_wcost_table = acct_uses_query( writer_costs, acct_addr, NULL );
+      if( !in_wcost_table ) {
+        in_wcost_table = acct_uses_insert( writer_costs, acct_addr );
+        in_wcost_table->total_cost = 0UL;
+        written_list[ written_list_cnt ] = in_wcost_table;
+        written_list_cnt = fd_ulong_min( written_list_cnt+1UL, written_list_max-1UL );
+      }
+      in_wcost_table->total_cost += cur->compute_est;
+
+      fd_pack_addr_use_t * use = acct_uses_query( acct_in_use, acct_addr, NULL );
+      if( !use ) { use = acct_uses_insert( acct_in_use, acct_addr ); use->in_use_by = 0UL; }
+
+      if( !(use->in_use_by & bank_tile_mask) ) use_by_bank[use_by_bank_cnt++] = *use;
+      use->in_use_by |= bank_tile_mask | FD_PACK_IN_USE_WRITABLE;
+      use->in_use_by &= ~FD_PACK_IN_USE_BIT_CLEARED;
+
+      release_result_t ret = release_bit_reference( pack, &acct_addr );
+      FD_PACK_BITSET_CLEARN( pack->bitset_rw_in_use, ret.clear_rw_bit );
+      FD_PACK_BITSET_CLEARN( pack->bitset_w_in_use,  ret.clear_w_bit  );
+    }
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+
+      fd_acct_addr_t acct_addr = acct[fd_txn_acct_iter_idx( iter )];
+
+      if( fd_pack_unwritable_contains( &acct_addr ) ) continue; /* No need to track sysvars because they can't be writable */
+
+      fd_pack_addr_use_t * use = acct_uses_query( acct_in_use,  acct_addr, NULL );
+      if( !use ) { use = acct_uses_insert( acct_in_use, acct_addr ); use->in_use_by = 0UL; }
+
+      if( !(use->in_use_by & bank_tile_mask) ) use_by_bank[use_by_bank_cnt++] = *use;
+      use->in_use_by |= bank_tile_mask;
+      use->in_use_by &= ~FD_PACK_IN_USE_BIT_CLEARED;
+
+      release_result_t ret = release_bit_reference( pack, &acct_addr );
+      FD_PACK_BITSET_CLEARN( pack->bitset_rw_in_use, ret.clear_rw_bit );
+      FD_PACK_BITSET_CLEARN( pack->bitset_w_in_use,  ret.clear_w_bit  );
+    }
+
+    fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, fd_txn_get_signatures( txn, cur->txn->payload ), NULL );
+    sig2txn_remove( pack->signature_map, in_tbl );
+    fd_pack_fee_payer_release( pack, acct );
+    trp_pool_idx_release( pool, idx );
+  }
+
+  pack->use_by_bank_cnt[bank_tile] = use_by_bank_cnt;
+  pack->written_list_cnt           = written_list_cnt;
+
+  pack->bundle_bank_tile = bank_tile;
+  pack->bundle_txn_cnt   = txn_cnt;
+  pack->bundle_next_idx  = 0UL;
+
+  ulong cus_scheduled = hdr->compute_est;
+  expq_remove( pack->expiration_q, hdr->expq_idx );
+  treap_ele_remove( pack->pending_bundles, hdr, pool );
+  trp_pool_ele_release( pool, hdr );
+  pack->pending_txn_cnt -= txn_cnt;
+  pack->pending_bundle_cnt--;
+  pack->cumulative_vote_cost += vote_cus;
+
+  FD_MCNT_INC( PACK, TRANSACTION_SCHEDULE_TAKEN, txn_cnt );
+
+  sched_return_t to_return = { .cus_scheduled=cus_scheduled, .txns_scheduled=txn_cnt, .bytes_scheduled=bytes };
+  return to_return;
+}
+
+/* fd_pack_bundle_next_microblock copies the next microblock of the
+   bundle being handed out to out and returns the number of
+   transactions in it. */
+static ulong
+fd_pack_bundle_next_microblock( fd_pack_t  * pack,
+                                ulong        bank_tile,
+                                fd_txn_p_t * out ) {
+  ulong i   = pack->bundle_next_idx;
+  ulong cnt = 0UL;
+  do {
+    out[ cnt++ ] = pack->bundle_txn[ i++ ];
+  } while( (i<pack->bundle_txn_cnt) && !pack->bundle_mb_start[ i ] );
+
+  pack->bundle_next_idx = i;
+  if( FD_LIKELY( i==pack->bundle_txn_cnt ) ) pack->bundle_bank_tile = ULONG_MAX;
+  pack->outstanding_microblock_mask |= 1UL << bank_tile;
+
+  fd_histf_sample( pack->txn_per_microblock,  cnt );
+  fd_histf_sample( pack->vote_per_microblock, 0UL );
+  return cnt;
+}
+
 void
 fd_pack_microblock_complete( fd_pack_t * pack,
                              ulong       bank_tile ) {
+  /* The accounts of a bundle stay in use until its last microblock
+     completes, so that nothing can get in between its microblocks. */
+  if( FD_UNLIKELY( pack->bundle_bank_tile==bank_tile ) ) {
+    pack->outstanding_microblock_mask &= ~(1UL<<bank_tile);
+    return;
+  }
+
   /* If the account is in use writably, and it's in use by this banking
      tile, then this banking tile must be the sole writer to it, so it's
      always okay to clear the writable bit. */
@@ -1098,6 +1954,11 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
                                   ulong        bank_tile,
                                   fd_txn_p_t * out ) {
 
+  /* A bank tile handed the first microblock of a bundle gets the rest
+     of it, and nothing else, next.  The block limits were already
+     charged for the whole bundle. */
+  if( FD_UNLIKELY( pack->bundle_bank_tile==bank_tile ) ) return fd_pack_bundle_next_microblock( pack, bank_tile, out );
+
   /* TODO: Decide if these are exactly how we want to handle limits */
   total_cus = fd_ulong_min( total_cus, pack->lim->max_cost_per_block - pack->cumulative_block_cost );
   ulong vote_cus = fd_ulong_min( (ulong)((float)total_cus * vote_fraction),
@@ -1122,8 +1983,31 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
 
   sched_return_t status, status1;
 
+  /* A bundle, if one can be scheduled, is one or more microblocks on
+     its own.  Only one bundle is handed out at a time. */
+  if( FD_UNLIKELY( pack->pending_bundle_cnt && pack->bundle_bank_tile==ULONG_MAX ) ) {
+    status = fd_pack_schedule_bundle( pack, total_cus, pack->lim->max_vote_cost_per_block - pack->cumulative_vote_cost,
+                                      pack->lim->max_txn_per_microblock, byte_limit, bank_tile );
+    if( FD_UNLIKELY( status.txns_scheduled ) ) {
+      ulong mb_cnt = 0UL;
+      for( ulong i=0UL; i<pack->bundle_txn_cnt; i++ ) mb_cnt += pack->bundle_mb_start[ i ];
+
+      pack->cumulative_block_cost += status.cus_scheduled;
+      pack->data_bytes_consumed   += status.bytes_scheduled + mb_cnt*MICROBLOCK_DATA_OVERHEAD;
+      pack->microblock_cnt        += mb_cnt;
+
+      FD_MGAUGE_SET( PACK, AVAILABLE_TRANSACTIONS,      pack->pending_txn_cnt                );
+      FD_MGAUGE_SET( PACK, AVAILABLE_VOTE_TRANSACTIONS, treap_ele_cnt( pack->pending_votes ) );
+
+      return fd_pack_bundle_next_microblock( pack, bank_tile, out );
+    }
+  }
+
+  int route = (pack->lookahead_cnt>0UL) & (pack->bank_tile_cnt>1UL);
+  if( FD_UNLIKELY( route ) ) fd_pack_route_chains( pack, bank_tile );
+
   /* Try to schedule non-vote transactions */
-  status = fd_pack_schedule_impl( pack, pack->pending,       cu_limit, txn_limit,          byte_limit, bank_tile, out+scheduled );
+  status = fd_pack_schedule_impl( pack, pack->pending,       cu_limit, txn_limit,          byte_limit, bank_tile, route, out+scheduled );
 
   scheduled                   += status.txns_scheduled;            txn_limit  -= status.txns_scheduled;
   pack->cumulative_block_cost += status.cus_scheduled;             cu_limit   -= status.cus_scheduled;
@@ -1131,7 +2015,7 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
 
 
   /* Schedule vote transactions */
-  status1= fd_pack_schedule_impl( pack, pack->pending_votes, vote_cus, vote_reserved_txns, byte_limit, bank_tile, out+scheduled );
+  status1= fd_pack_schedule_impl( pack, pack->pending_votes, vote_cus, vote_reserved_txns, byte_limit, bank_tile, 0,     out+scheduled );
 
   scheduled                   += status1.txns_scheduled;
   pack->cumulative_vote_cost  += status1.cus_scheduled;
@@ -1144,12 +2028,23 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
 
 
   /* Fill any remaining space with non-vote transactions */
-  status = fd_pack_schedule_impl( pack, pack->pending,       cu_limit, txn_limit,          byte_limit, bank_tile, out+scheduled );
+  status = fd_pack_schedule_impl( pack, pack->pending,       cu_limit, txn_limit,          byte_limit, bank_tile, route, out+scheduled );
 
   scheduled                   += status.txns_scheduled;
   pack->cumulative_block_cost += status.cus_scheduled;
   pack->data_bytes_consumed   += status.bytes_scheduled;
 
+  /* Routing is only worthwhile if it keeps the bank tiles busy.  If it
+     left this bank tile with nothing at all, fall back to scheduling
+     greedily rather than leaving it idle. */
+  if( FD_UNLIKELY( route & (scheduled==0UL) ) ) {
+    status = fd_pack_schedule_impl( pack, pack->pending,     cu_limit, txn_limit,          byte_limit, bank_tile, 0,     out+scheduled );
+
+    scheduled                   += status.txns_scheduled;
+    pack->cumulative_block_cost += status.cus_scheduled;
+    pack->data_bytes_consumed   += status.bytes_scheduled;
+  }
+
   ulong nonempty = (ulong)(scheduled>0UL);
   pack->microblock_cnt              += nonempty;
   pack->outstanding_microblock_mask |= nonempty << bank_tile;
@@ -1165,9 +2060,88 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
   return scheduled;
 }
 
-ulong fd_pack_avail_txn_cnt( fd_pack_t const * pack ) { return pack->pending_txn_cnt; }
-ulong fd_pack_bank_tile_cnt( fd_pack_t const * pack ) { return pack->bank_tile_cnt;   }
+void
+fd_pack_rebate_cus( fd_pack_t        * pack,
+                    fd_txn_p_t const * txns,
+                    uint       const * opt_consumed_cus,
+                    ulong              txn_cnt,
+                    int                same_block ) {
+  ulong cost_rebate = 0UL;
+  ulong vote_rebate = 0UL;
+
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_txn_p_t const * txnp = txns+i;
+    fd_txn_t   const * txn  = TXN(txnp);
+
+    /* Recompute what the block was charged rather than carrying it in
+       the transaction, so that the bank tile's output is unchanged. */
+    uint  flags          = txnp->flags;
+    ulong execution_cost = 0UL;
+    ulong cost           = fd_pack_compute_cost( txnp, &flags, &execution_cost );
+    if( FD_UNLIKELY( !cost ) ) continue; /* Not scheduled by pack */
+
+    ulong rebate;
+    if( FD_UNLIKELY( !(txnp->flags & FD_TXN_P_FLAGS_EXECUTE_SUCCESS) ) ) {
+      /* A transaction that doesn't execute doesn't get committed, so
+         all of its CUs get rebated. */
+      rebate = cost;
+    } else if( FD_LIKELY( opt_consumed_cus ) ) {
+      ulong actual = (ulong)opt_consumed_cus[ i ];
+      ulong tag;
+      if( FD_LIKELY( fd_pack_cu_est_tag( txn, txnp->payload, &tag ) ) ) {
+        double est = fd_est_tbl_estimate( pack->cu_est_tbl, tag, NULL );
+        if( FD_LIKELY( est<(double)CU_EST_TBL_NO_DATA ) ) {
+          ulong est_cus = (ulong)(est + 0.5);
+          fd_histf_sample( pack->cu_est_error, fd_ulong_if( est_cus>actual, est_cus-actual, actual-est_cus ) );
+        }
+        fd_est_tbl_update( pack->cu_est_tbl, tag, (uint)fd_ulong_min( actual, UINT_MAX ) );
+      }
+      rebate = execution_cost - fd_ulong_min( actual, execution_cost );
+    } else {
+      /* Without a measurement, keep the whole charge */
+      rebate = 0UL;
+    }
 
+    if( FD_UNLIKELY( (!same_block) | (!rebate) ) ) continue;
+
+    cost_rebate += rebate;
+    vote_rebate += fd_ulong_if( !!(txnp->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE), rebate, 0UL );
+
+    /* Updating total_cost in place is safe with respect to the
+       written_list unwinding in fd_pack_end_block, since it doesn't
+       insert or remove any elements. */
+    fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, txnp->payload );
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+      fd_pack_addr_use_t * in_wcost_table = acct_uses_query( pack->writer_costs, accts[ fd_txn_acct_iter_idx( iter ) ], NULL );
+      if( FD_LIKELY( in_wcost_table ) ) in_wcost_table->total_cost -= fd_ulong_min( in_wcost_table->total_cost, rebate );
+    }
+  }
+
+  pack->cumulative_block_cost -= fd_ulong_min( pack->cumulative_block_cost, cost_rebate );
+  pack->cumulative_vote_cost  -= fd_ulong_min( pack->cumulative_vote_cost,  vote_rebate );
+
+  FD_MCNT_INC( PACK, CUS_REBATED, cost_rebate );
+}
+
+ulong fd_pack_avail_txn_cnt   ( fd_pack_t const * pack ) { return pack->pending_txn_cnt + pack->bundle_txn_cnt - pack->bundle_next_idx; }
+ulong fd_pack_bank_tile_cnt   ( fd_pack_t const * pack ) { return pack->bank_tile_cnt;    }
+ulong fd_pack_bundle_bank_tile( fd_pack_t const * pack ) { return pack->bundle_bank_tile; }
+
+
+void
+fd_pack_set_lookahead( fd_pack_t * pack,
+                       ulong       lookahead_cnt ) {
+  pack->lookahead_cnt = lookahead_cnt;
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) FD_PACK_BITSET_CLEAR( pack->chain_w_bitset[i] );
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) pack->chain_cus[i] = 0UL;
+}
+
+void
+fd_pack_set_fee_payer_cap( fd_pack_t * pack,
+                           ulong       max_txn_per_fee_payer ) {
+  pack->max_txn_per_fee_payer = fd_ulong_if( !!max_txn_per_fee_payer, max_txn_per_fee_payer, ULONG_MAX );
+}
 
 void
 fd_pack_set_block_limits( fd_pack_t * pack,
@@ -1187,6 +2161,12 @@ fd_pack_expire_before( fd_pack_t * pack,
   while( (expq_cnt( prq )>0UL) & (prq->expires_at<expire_before) ) {
     fd_pack_ord_txn_t * expired = prq->txn;
 
+    if( FD_UNLIKELY( expired->root==FD_ORD_TXN_ROOT_PENDING_BUNDLE ) ) {
+      /* Bundle headers have no signature */
+      deleted_cnt += fd_pack_delete_bundle( pack, expired );
+      continue;
+    }
+
     fd_ed25519_sig_t const * expired_sig = fd_txn_get_signatures( TXN( expired->txn ), expired->txn->payload );
     /* fd_pack_delete_transaction also removes it from the heap */
     fd_pack_delete_transaction( pack, expired_sig );
@@ -1199,6 +2179,8 @@ fd_pack_expire_before( fd_pack_t * pack,
 
 void
 fd_pack_end_block( fd_pack_t * pack ) {
+  fd_histf_sample( pack->block_cost, pack->cumulative_block_cost );
+
   pack->microblock_cnt        = 0UL;
   pack->data_bytes_consumed   = 0UL;
   pack->cumulative_block_cost = 0UL;
@@ -1235,6 +2217,13 @@ fd_pack_end_block( fd_pack_t * pack ) {
   FD_PACK_BITSET_CLEAR( pack->bitset_w_in_use  );
 
   for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) pack->use_by_bank_cnt[i] = 0UL;
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) FD_PACK_BITSET_CLEAR( pack->chain_w_bitset[i] );
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) pack->chain_cus[i] = 0UL;
+
+  /* The rest of a bundle being handed out, if any, is dropped */
+  pack->bundle_bank_tile = ULONG_MAX;
+  pack->bundle_txn_cnt   = 0UL;
+  pack->bundle_next_idx  = 0UL;
 
   /* If our stake is low and we don't become leader often, end_block
      might get called on the order of O(1/hr), which feels too
@@ -1243,6 +2232,10 @@ fd_pack_end_block( fd_pack_t * pack ) {
      good place to copy them. */
   FD_MHIST_COPY( PACK, TOTAL_TRANSACTIONS_PER_MICROBLOCK_COUNT, pack->txn_per_microblock  );
   FD_MHIST_COPY( PACK, VOTES_PER_MICROBLOCK_COUNT,              pack->vote_per_microblock );
+  FD_MHIST_COPY( PACK, CU_ESTIMATION_ERROR,                     pack->cu_est_error        );
+  FD_MHIST_COPY( PACK, BLOCK_COST,                              pack->block_cost          );
+  FD_MHIST_COPY( PACK, ADMITTED_FEE_PER_CU,                     pack->admitted_fee_per_cu );
+  FD_MHIST_COPY( PACK, EVICTED_FEE_PER_CU,                      pack->evicted_fee_per_cu  );
 }
 
 static void
@@ -1260,12 +2253,25 @@ release_tree( treap_t           * treap,
 void
 fd_pack_clear_all( fd_pack_t * pack ) {
   pack->pending_txn_cnt       = 0UL;
+  pack->pending_bundle_cnt    = 0UL;
   pack->microblock_cnt        = 0UL;
   pack->cumulative_block_cost = 0UL;
   pack->cumulative_vote_cost  = 0UL;
 
+  /* The transactions in bundles aren't in any treap, so release them
+     before releasing the headers. */
+  for( treap_fwd_iter_t it=treap_fwd_iter_init( pack->pending_bundles, pack->pool ); !treap_fwd_iter_done( it );
+      it=treap_fwd_iter_next( it, pack->pool ) ) {
+    ulong next;
+    for( ulong idx=treap_fwd_iter_ele( it, pack->pool )->bundle_next; idx!=trp_pool_idx_null( pack->pool ); idx=next ) {
+      next = pack->pool[ idx ].bundle_next;
+      trp_pool_idx_release( pack->pool, idx );
+    }
+  }
+
   release_tree( pack->pending,         pack->pool );
   release_tree( pack->pending_votes,   pack->pool );
+  release_tree( pack->pending_bundles, pack->pool );
 
   expq_remove_all( pack->expiration_q );
 
@@ -1273,6 +2279,7 @@ fd_pack_clear_all( fd_pack_t * pack ) {
   acct_uses_clear( pack->writer_costs );
 
   sig2txn_clear( pack->signature_map );
+  acct_uses_clear( pack->fee_payer_cnt );
 
   FD_PACK_BITSET_CLEAR( pack->bitset_rw_in_use );
   FD_PACK_BITSET_CLEAR( pack->bitset_w_in_use  );
@@ -1282,6 +2289,13 @@ fd_pack_clear_all( fd_pack_t * pack ) {
   pack->bitset_avail_cnt = FD_PACK_BITSET_MAX;
 
   for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) pack->use_by_bank_cnt[i] = 0UL;
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) FD_PACK_BITSET_CLEAR( pack->chain_w_bitset[i] );
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) pack->chain_cus[i] = 0UL;
+
+  /* The rest of a bundle being handed out, if any, is dropped */
+  pack->bundle_bank_tile = ULONG_MAX;
+  pack->bundle_txn_cnt   = 0UL;
+  pack->bundle_next_idx  = 0UL;
 }
 
 int
@@ -1302,28 +2316,10 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
     case FD_ORD_TXN_ROOT_FREE:             /* Should be impossible */                                                return 0;
     case FD_ORD_TXN_ROOT_PENDING:          root = pack->pending;                                                     break;
     case FD_ORD_TXN_ROOT_PENDING_VOTE:     root = pack->pending_votes;                                               break;
+    case FD_ORD_TXN_ROOT_BUNDLE_MEMBER:    fd_pack_delete_bundle( pack, pack->pool+containing->bundle_hdr );         return 1;
   }
 
-  fd_txn_t * _txn = TXN( containing->txn );
-  fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( _txn, containing->txn->payload );
-  for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( _txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
-      iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
-    ulong i=fd_txn_acct_iter_idx( iter );
-
-    release_result_t ret = release_bit_reference( pack, accts+i );
-    FD_PACK_BITSET_CLEARN( pack->bitset_rw_in_use, ret.clear_rw_bit );
-    FD_PACK_BITSET_CLEARN( pack->bitset_w_in_use,  ret.clear_w_bit  );
-  }
-
-  for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( _txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
-      iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
-    ulong i=fd_txn_acct_iter_idx( iter );
-    if( FD_UNLIKELY( fd_pack_unwritable_contains( accts+i ) ) ) continue;
-
-    release_result_t ret = release_bit_reference( pack, accts+i );
-    FD_PACK_BITSET_CLEARN( pack->bitset_rw_in_use, ret.clear_rw_bit );
-    FD_PACK_BITSET_CLEARN( pack->bitset_w_in_use,  ret.clear_w_bit  );
-  }
+  fd_pack_release_accts( pack, containing );
   expq_remove( pack->expiration_q, containing->expq_idx );
   treap_ele_remove( root, containing, pack->pool );
   trp_pool_ele_release( pack->pool, containing );
@@ -1402,72 +2398,94 @@ fd_pack_verify( fd_pack_t * pack,
 
 
   fd_pack_ord_txn_t  * pool = pack->pool;
-  treap_t * treaps[ 2 ] = { pack->pending, pack->pending_votes };
-  ulong txn_cnt = 0UL;
+  treap_t * treaps[ 3 ] = { pack->pending, pack->pending_votes, pack->pending_bundles };
+  ulong txn_cnt    = 0UL;
+  ulong bundle_cnt = 0UL;
+  ulong null_idx   = trp_pool_idx_null( pool );
 
-  for( ulong k=0UL; k<2; k++ ) {
+  for( ulong k=0UL; k<3; k++ ) {
     treap_t * treap = treaps[ k ];
+    int is_bundle = (k==2UL);
 
     for( treap_rev_iter_t _cur=treap_rev_iter_init( treap, pool ); !treap_rev_iter_done( _cur );
         _cur=treap_rev_iter_next( _cur, pool ) ) {
-      txn_cnt++;
-      fd_pack_ord_txn_t const * cur = treap_rev_iter_ele_const( _cur, pool );
-      fd_txn_t const * txn = TXN(cur->txn);
-      fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, cur->txn->payload );
-
-      fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( txn, cur->txn->payload );
-
-      fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
-      VERIFY_TEST( in_tbl, "signature missing from sig2txn" );
-      VERIFY_TEST( in_tbl->key==sig0, "signature in sig2txn inconsistent" );
-      VERIFY_TEST( (ulong)(cur->root)==k+1, "treap element had bad root" );
-      VERIFY_TEST( cur->expires_at>=pack->expire_before, "treap element expired" );
-
-      fd_pack_expq_t const * eq = pack->expiration_q + cur->expq_idx;
-      VERIFY_TEST( eq->txn==cur, "expq inconsistent" );
-      VERIFY_TEST( eq->expires_at==cur->expires_at, "expq expires_at inconsistent" );
-
-      FD_PACK_BITSET_DECLARE( complement );
-      FD_PACK_BITSET_COPY( complement, full );
-      for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
-          iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
-        fd_acct_addr_t acct = accts[fd_txn_acct_iter_idx( iter )];
-
-        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( bitset_copy, acct, NULL );
-        VERIFY_TEST( q, "account in transaction missing from bitset mapping" );
-        VERIFY_TEST( q->ref_cnt>0UL, "account in transaction ref_cnt already 0" );
-        q->ref_cnt--;
-        total_references--;
-
-        FD_PACK_BITSET_CLEAR( bit );
-        FD_PACK_BITSET_SETN( bit, q->bit );
-        if( q->bit<FD_PACK_BITSET_MAX ) {
-          VERIFY_TEST( !FD_PACK_BITSET_INTERSECT4_EMPTY( bit, bit, cur->rw_bitset, cur->rw_bitset ), "missing from rw bitset" );
-          VERIFY_TEST( !FD_PACK_BITSET_INTERSECT4_EMPTY( bit, bit, cur->w_bitset,  cur->w_bitset ), "missing from w bitset" );
-        }
-        FD_PACK_BITSET_CLEARN( complement, q->bit );
+      fd_pack_ord_txn_t const * elem = treap_rev_iter_ele_const( _cur, pool );
+      VERIFY_TEST( (ulong)(elem->root)==k+1, "treap element had bad root" );
+      VERIFY_TEST( elem->expires_at>=pack->expire_before, "treap element expired" );
+
+      fd_pack_expq_t const * eq = pack->expiration_q + elem->expq_idx;
+      VERIFY_TEST( eq->txn==elem, "expq inconsistent" );
+      VERIFY_TEST( eq->expires_at==elem->expires_at, "expq expires_at inconsistent" );
+
+      /* For a bundle, check each of its transactions below.  Otherwise,
+         the treap element is the transaction. */
+      ulong bundle_txn_cnt = 0UL;
+      if( is_bundle ) {
+        VERIFY_TEST( elem->bundle_next!=null_idx, "empty bundle" );
+        VERIFY_TEST( elem->bundle_hdr==_cur, "bundle header index inconsistent" );
+        bundle_cnt++;
       }
-      VERIFY_TEST( FD_PACK_BITSET_INTERSECT4_EMPTY( complement, complement, cur->w_bitset,  cur->w_bitset ), "extra in w bitset" );
 
-      for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
-          iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
-
-        fd_acct_addr_t acct = accts[fd_txn_acct_iter_idx( iter )];
-        if( FD_UNLIKELY( fd_pack_unwritable_contains( &acct ) ) ) continue;
-        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( bitset_copy, acct, NULL );
-        VERIFY_TEST( q, "account in transaction missing from bitset mapping" );
-        VERIFY_TEST( q->ref_cnt>0UL, "account in transaction ref_cnt already 0" );
-        q->ref_cnt--;
-        total_references--;
-
-        FD_PACK_BITSET_CLEAR( bit );
-        FD_PACK_BITSET_SETN( bit, q->bit );
-        if( q->bit<FD_PACK_BITSET_MAX ) {
-          VERIFY_TEST( !FD_PACK_BITSET_INTERSECT4_EMPTY( bit, bit, cur->rw_bitset, cur->rw_bitset ), "missing from rw bitset" );
+      for( fd_pack_ord_txn_t const * cur = is_bundle ? pool+elem->bundle_next : elem; cur;
+          cur = (is_bundle & (cur->bundle_next!=null_idx)) ? pool+cur->bundle_next : NULL ) {
+        txn_cnt++;
+        if( is_bundle ) {
+          bundle_txn_cnt++;
+          VERIFY_TEST( bundle_txn_cnt<=FD_PACK_MAX_TXN_PER_BUNDLE, "bundle too long or has a cycle" );
+          VERIFY_TEST( cur->root==FD_ORD_TXN_ROOT_BUNDLE_MEMBER, "bundle transaction had bad root" );
+          VERIFY_TEST( cur->bundle_hdr==_cur, "bundle transaction has wrong header" );
+        }
+        fd_txn_t const * txn = TXN(cur->txn);
+        fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, cur->txn->payload );
+
+        fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( txn, cur->txn->payload );
+
+        fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
+        VERIFY_TEST( in_tbl, "signature missing from sig2txn" );
+        VERIFY_TEST( in_tbl->key==sig0, "signature in sig2txn inconsistent" );
+
+        FD_PACK_BITSET_DECLARE( complement );
+        FD_PACK_BITSET_COPY( complement, full );
+        for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+            iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+          fd_acct_addr_t acct = accts[fd_txn_acct_iter_idx( iter )];
+
+          fd_pack_bitset_acct_mapping_t * q = bitset_map_query( bitset_copy, acct, NULL );
+          VERIFY_TEST( q, "account in transaction missing from bitset mapping" );
+          VERIFY_TEST( q->ref_cnt>0UL, "account in transaction ref_cnt already 0" );
+          q->ref_cnt--;
+          total_references--;
+
+          FD_PACK_BITSET_CLEAR( bit );
+          FD_PACK_BITSET_SETN( bit, q->bit );
+          if( q->bit<FD_PACK_BITSET_MAX ) {
+            VERIFY_TEST( !FD_PACK_BITSET_INTERSECT4_EMPTY( bit, bit, cur->rw_bitset, cur->rw_bitset ), "missing from rw bitset" );
+            VERIFY_TEST( !FD_PACK_BITSET_INTERSECT4_EMPTY( bit, bit, cur->w_bitset,  cur->w_bitset ), "missing from w bitset" );
+          }
+          FD_PACK_BITSET_CLEARN( complement, q->bit );
         }
-        FD_PACK_BITSET_CLEARN( complement, q->bit );
+        VERIFY_TEST( FD_PACK_BITSET_INTERSECT4_EMPTY( complement, complement, cur->w_bitset,  cur->w_bitset ), "extra in w bitset" );
+
+        for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
+            iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+
+          fd_acct_addr_t acct = accts[fd_txn_acct_iter_idx( iter )];
+          if( FD_UNLIKELY( fd_pack_unwritable_contains( &acct ) ) ) continue;
+          fd_pack_bitset_acct_mapping_t * q = bitset_map_query( bitset_copy, acct, NULL );
+          VERIFY_TEST( q, "account in transaction missing from bitset mapping" );
+          VERIFY_TEST( q->ref_cnt>0UL, "account in transaction ref_cnt already 0" );
+          q->ref_cnt--;
+          total_references--;
+
+          FD_PACK_BITSET_CLEAR( bit );
+          FD_PACK_BITSET_SETN( bit, q->bit );
+          if( q->bit<FD_PACK_BITSET_MAX ) {
+            VERIFY_TEST( !FD_PACK_BITSET_INTERSECT4_EMPTY( bit, bit, cur->rw_bitset, cur->rw_bitset ), "missing from rw bitset" );
+          }
+          FD_PACK_BITSET_CLEARN( complement, q->bit );
+        }
+        VERIFY_TEST( FD_PACK_BITSET_INTERSECT4_EMPTY( complement, complement, cur->rw_bitset,  cur->rw_bitset ), "extra in rw bitset" );
       }
-      VERIFY_TEST( FD_PACK_BITSET_INTERSECT4_EMPTY( complement, complement, cur->rw_bitset,  cur->rw_bitset ), "extra in rw bitset" );
     }
   }
 
@@ -1475,6 +2493,19 @@ fd_pack_verify( fd_pack_t * pack,
 
   VERIFY_TEST( total_references==0UL, "extra references in bitset mapping" );
   VERIFY_TEST( txn_cnt==sig2txn_key_cnt( pack->signature_map ), "extra signatures in sig2txn" );
+  VERIFY_TEST( txn_cnt==pack->pending_txn_cnt, "pending_txn_cnt inconsistent" );
+  VERIFY_TEST( bundle_cnt==pack->pending_bundle_cnt, "pending_bundle_cnt inconsistent" );
+
+  ulong fee_payer_total = 0UL;
+  for( ulong i=0UL; i<acct_uses_slot_cnt( pack->fee_payer_cnt ); i++ ) {
+    fd_pack_addr_use_t const * payer = pack->fee_payer_cnt+i;
+    if( acct_uses_key_inval( payer->key ) ) continue;
+    VERIFY_TEST( payer->txn_cnt>0UL, "fee payer with no pending transactions" );
+    fee_payer_total += payer->txn_cnt;
+  }
+  VERIFY_TEST( fee_payer_total==pack->pending_txn_cnt, "fee_payer_cnt inconsistent" );
+  VERIFY_TEST( expq_cnt( pack->expiration_q )==treap_ele_cnt( pack->pending )+treap_ele_cnt( pack->pending_votes )+bundle_cnt,
+               "expq has extra elements" );
 
   bitset_map_join( _bitset_map_orig );
 
@@ -53,6 +53,13 @@
 #define FD_TXN_P_FLAGS_IS_SIMPLE_VOTE   (1U)
 #define FD_TXN_P_FLAGS_SANITIZE_SUCCESS (2U)
 #define FD_TXN_P_FLAGS_EXECUTE_SUCCESS  (4U)
+/* Set by pack on every transaction of a bundle, and additionally on
+   the first transaction of a bundle.  See fd_pack_insert_bundle_init. */
+#define FD_TXN_P_FLAGS_BUNDLE           (8U)
+#define FD_TXN_P_FLAGS_BUNDLE_START     (16U)
+
+/* The maximum number of transactions in a bundle */
+#define FD_PACK_MAX_TXN_PER_BUNDLE      (5UL)
 
 
 /* The Solana network and Firedancer implementation details impose
@@ -161,6 +168,12 @@ FD_FN_PURE ulong fd_pack_avail_txn_cnt( fd_pack_t const * pack );
    FD_PACK_MAX_BANK_TILES]. */
 FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t const * pack );
 
+/* fd_pack_bundle_bank_tile returns the index of the bank tile that the
+   rest of a partially handed out bundle must be scheduled to, or
+   ULONG_MAX if there is no such bundle.  See
+   fd_pack_insert_bundle_init.  pack must be a valid local join. */
+FD_FN_PURE ulong fd_pack_bundle_bank_tile( fd_pack_t const * pack );
+
 /* fd_pack_set_block_limits: Updates the limits provided fd_pack_new to
    the new values.  Future any future microblocks produced by this pack
    object will not cause a block to have more than
@@ -177,6 +190,34 @@ FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t const * pack );
    but the call is valid. */
 void fd_pack_set_block_limits( fd_pack_t * pack, ulong max_microblocks_per_block, ulong max_data_bytes_per_block );
 
+/* fd_pack_set_lookahead: Sets how many of the highest priority pending
+   transactions pack looks at when deciding which accounts are
+   contended.  If lookahead_cnt is non-zero and pack was created with
+   more than one bank tile, pack routes all the transactions that write
+   to a given contended account to the same bank tile, where they
+   execute one after another, and balances these chains of transactions
+   across bank tiles by CUs.  Other bank tiles skip those transactions
+   rather than stalling on the conflict, so a few hot accounts don't
+   leave most bank tiles idle.  Skipped transactions are counted in the
+   Chain variant of the TransactionSchedule metric.  If routing would
+   leave a bank tile with an empty microblock, pack schedules greedily
+   for that microblock instead.  lookahead_cnt==0 (the default) disables
+   routing.  Any existing routing decisions are forgotten.  pack must be
+   a valid local join. */
+void fd_pack_set_lookahead( fd_pack_t * pack, ulong lookahead_cnt );
+
+/* fd_pack_set_fee_payer_cap: Sets the maximum number of pending
+   transactions, including transactions in bundles, that may share a
+   fee payer.  Once a fee payer has max_txn_per_fee_payer pending
+   transactions, further transactions it pays for are rejected with
+   FEE_PAYER_CAP until some of its pending transactions are scheduled,
+   expire, or are deleted.  This keeps a single fee payer from filling
+   the pool and evicting everyone else's transactions.
+   max_txn_per_fee_payer==0 (the default) means no limit.  Lowering the
+   cap doesn't evict anything that is already pending.  pack must be a
+   valid local join. */
+void fd_pack_set_fee_payer_cap( fd_pack_t * pack, ulong max_txn_per_fee_payer );
+
 /* Return values for fd_pack_insert_txn_fini:  Non-negative values
    indicate the transaction was accepted and may be returned in a future
    microblock.  Negative values indicate that the transaction was
@@ -219,6 +260,9 @@ void fd_pack_set_block_limits( fd_pack_t * pack, ulong max_microblocks_per_block
       able to accept a transaction regardless of its priority because a
       transaction cannot be found to be replaced.  This mostly can
       happen if the whole heap is full of votes.
+    * FEE_PAYER_CAP: the transaction's fee payer already has the maximum
+      number of pending transactions allowed by
+      fd_pack_set_fee_payer_cap.
 
     NOTE: The corresponding enum in metrics.xml must be kept in sync
     with any changes to these return values. */
@@ -235,14 +279,15 @@ void fd_pack_set_block_limits( fd_pack_t * pack, ulong max_microblocks_per_block
 #define FD_PACK_INSERT_REJECT_ESTIMATION_FAIL (-7)
 #define FD_PACK_INSERT_REJECT_WRITES_SYSVAR   (-8)
 #define FD_PACK_INSERT_REJECT_FULL            (-9)
+#define FD_PACK_INSERT_REJECT_FEE_PAYER_CAP   (-10)
 
 /* The FD_PACK_INSERT_{ACCEPT, REJECT}_* values defined above are in the
    range [-FD_PACK_INSERT_RETVAL_OFF,
    -FD_PACK_INSERT_RETVAL_OFF+FD_PACK_INSERT_RETVAL_CNT ) */
-#define FD_PACK_INSERT_RETVAL_OFF  9
-#define FD_PACK_INSERT_RETVAL_CNT 13
+#define FD_PACK_INSERT_RETVAL_OFF 10
+#define FD_PACK_INSERT_RETVAL_CNT 14
 
-FD_STATIC_ASSERT( FD_PACK_INSERT_REJECT_FULL>=-FD_PACK_INSERT_RETVAL_OFF, pack_retval );
+FD_STATIC_ASSERT( FD_PACK_INSERT_REJECT_FEE_PAYER_CAP>=-FD_PACK_INSERT_RETVAL_OFF, pack_retval );
 FD_STATIC_ASSERT( FD_PACK_INSERT_ACCEPT_VOTE_REPLACE<FD_PACK_INSERT_RETVAL_CNT-FD_PACK_INSERT_RETVAL_OFF, pack_retval );
 
 /* fd_pack_insert_txn_{init,fini,cancel} execute the process of
@@ -281,6 +326,66 @@ fd_txn_p_t * fd_pack_insert_txn_init  ( fd_pack_t * pack
 int          fd_pack_insert_txn_fini  ( fd_pack_t * pack, fd_txn_p_t * txn, ulong expires_at );
 void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn                   );
 
+/* fd_pack_insert_bundle_{init,fini,cancel} are like the txn versions
+   above, but insert a bundle: an ordered group of txn_cnt transactions
+   that pack schedules all together or not at all.  txn_cnt must be in
+   [1, FD_PACK_MAX_TXN_PER_BUNDLE].
+
+   A bundle is always scheduled as consecutive microblocks of its own,
+   all to the same bank tile, containing exactly the transactions of
+   the bundle in the order they were inserted, with
+   FD_TXN_P_FLAGS_BUNDLE set on each and FD_TXN_P_FLAGS_BUNDLE_START on
+   the first one.  Transactions in a bundle may conflict with each
+   other.  Since the transactions of a microblock must not conflict, a
+   transaction that conflicts with one earlier in the same microblock
+   starts a new one, so a bundle without internal conflicts is a single
+   microblock.  The bundle is only scheduled when none of the accounts
+   of any of its transactions conflict with microblocks outstanding on
+   other bank tiles, and they stay in use until its last microblock
+   completes.  Once the first microblock of a bundle has been scheduled
+   to a bank tile, the next microblocks scheduled to that bank tile are
+   the rest of the bundle (see fd_pack_bundle_bank_tile), and the
+   block limits are charged for the whole bundle up front.  The bank
+   tile is expected to execute the transactions in order and stop at
+   the first one that fails: a microblock of a bundle is committed only
+   if all of its transactions succeed, and the rest of the bundle is
+   not executed.
+
+   Bundles are ordered amongst themselves by the total rewards of their
+   transactions divided by their total cost, and pack schedules the
+   best eligible bundle, if any, before considering individual
+   transactions for a microblock.  Only one bundle is handed out at a
+   time.
+
+   fd_pack_insert_bundle_init stores a pointer to memory for each of
+   the txn_cnt transactions in bundle[0], ..., bundle[txn_cnt-1], where
+   the caller should store the transactions, and returns bundle.  Every
+   call must be paired with a call to exactly one of _fini or _cancel
+   with the same bundle and txn_cnt, and there may be at most one
+   bundle insert in progress at a time, although it may be interleaved
+   with a single transaction insert.
+
+   fd_pack_insert_bundle_fini returns FD_PACK_INSERT_ACCEPT_NONVOTE_ADD
+   or _REPLACE if the bundle was accepted and one of the
+   FD_PACK_INSERT_REJECT_* codes otherwise.  A bundle is rejected if
+   any of its transactions would have been rejected individually (in
+   which case the return value is what that transaction would have
+   gotten), if two of its transactions have the same signature
+   (DUPLICATE), or if its total cost could never fit in a block or in a
+   microblock (TOO_LARGE).  If pack is full, the bundle replaces the
+   lowest priority individual transactions, provided all of them have
+   lower priority than the bundle; otherwise it is rejected with
+   PRIORITY, or FULL if there are not enough individual transactions to
+   replace.  Pending bundles are never replaced.
+
+   All the transactions in a bundle expire at expires_at, and deleting
+   any transaction of a pending bundle with fd_pack_delete_transaction
+   deletes the whole bundle.  fd_pack_avail_txn_cnt counts each
+   transaction of a pending bundle. */
+fd_txn_p_t * * fd_pack_insert_bundle_init  ( fd_pack_t * pack, fd_txn_p_t *       * bundle, ulong txn_cnt                   );
+int            fd_pack_insert_bundle_fini  ( fd_pack_t * pack, fd_txn_p_t * const * bundle, ulong txn_cnt, ulong expires_at );
+void           fd_pack_insert_bundle_cancel( fd_pack_t * pack, fd_txn_p_t * const * bundle, ulong txn_cnt                   );
+
 
 /* fd_pack_schedule_next_microblock schedules transactions to form a
    microblock, which is a set of non-conflicting transactions.
@@ -295,6 +400,12 @@ void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn
    vote_fraction*max_txn_per_microblock votes, and votes in total will
    not consume more than vote_fraction*total_cus of the microblock.
 
+   If a pending bundle can be scheduled, the microblock instead
+   consists of exactly the transactions of the first microblock of that
+   bundle, in order, and total_cus still bounds the cost of the whole
+   bundle.  If the rest of a bundle is pending for bank_tile, the
+   microblock is its next microblock.  See fd_pack_insert_bundle_init.
+
    Returns the number of transactions in the scheduled microblock.  The
    return value may be 0 if there are no eligible transactions at the
    moment. */
@@ -305,9 +416,35 @@ ulong fd_pack_schedule_next_microblock( fd_pack_t * pack, ulong total_cus, float
 /* fd_pack_microblock_complete signals that the bank_tile with index
    bank_tile has completed its previously scheduled microblock.  This
    permits the scheduling of transactions that conflict with the
-   previously scheduled microblock. */
+   previously scheduled microblock, except that the accounts of a
+   bundle stay in use until its last microblock completes. */
 void fd_pack_microblock_complete( fd_pack_t * pack, ulong bank_tile );
 
+/* fd_pack_rebate_cus processes the execution results the bank tile
+   reported for txn_cnt transactions starting at txns, which must be
+   transactions previously scheduled by this pack object, with
+   FD_TXN_P_FLAGS_EXECUTE_SUCCESS set by the bank tile on the ones that
+   executed (and hence got committed).  If opt_consumed_cus is non-NULL,
+   opt_consumed_cus[ i ] is the number of execution CUs the i-th
+   transaction actually consumed (ignored if it didn't execute).
+
+   A transaction that didn't execute gets all of its CUs rebated.  For
+   one that did and has a consumption report, pack records the number
+   of execution CUs it actually consumed, which pack uses to improve
+   the estimates by which it orders future transactions that invoke the
+   same program, and rebates the requested execution CUs it didn't
+   consume.  Without a report, nothing is rebated.  The bank tile
+   doesn't currently get consumed CUs back from the bank, so the pack
+   tile passes NULL.
+
+   If same_block is non-zero, the transactions must have been scheduled
+   in the current block (i.e. since the last call to
+   fd_pack_end_block), and the rebated CUs are returned to the
+   per-block and per-account limits, permitting pack to schedule more
+   transactions in this block.  If same_block is zero, limits are
+   unaffected. */
+void fd_pack_rebate_cus( fd_pack_t * pack, fd_txn_p_t const * txns, uint const * opt_consumed_cus, ulong txn_cnt, int same_block );
+
 /* fd_pack_expire_before deletes all available transactions with
    expires_at values strictly less than expire_before.  pack must be a
    local join of a pack object.  Retruns the number of transactions
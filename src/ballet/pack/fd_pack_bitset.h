@@ -99,6 +99,11 @@
    This is a statement and so does not return anything, not a value.
    Think of it like srcdest |= x.
 
+   FD_PACK_BITSET_AND and FD_PACK_BITSET_ANDNOT are likewise statements
+   that update srcdest with the intersection of srcdest and x, and with
+   the elements of srcdest not in x, respectively.  Think of them like
+   srcdest &= x and srcdest &= ~x.
+
    FD_PACK_BITSET_INTERSECT4_EMPTY returns whether (x1 & y1) and
    (x2 & y2) are both empty.  It is done this way because fd_set
    temporaries are a bit of a pain.  All 4 sets should be of type T.
@@ -134,6 +139,14 @@
                                           addr_bitset_t * __srcdest = (srcdest);          \
                                           addr_bitset_union( __srcdest, __srcdest, (x) ); \
                                         } while( 0 )
+#  define FD_PACK_BITSET_AND(srcdest, x) do {                                                 \
+                                           addr_bitset_t * __srcdest = (srcdest);             \
+                                           addr_bitset_intersect( __srcdest, __srcdest, (x) ); \
+                                         } while( 0 )
+#  define FD_PACK_BITSET_ANDNOT(srcdest, x) do {                                                \
+                                              addr_bitset_t * __srcdest = (srcdest);            \
+                                              addr_bitset_subtract( __srcdest, __srcdest, (x) ); \
+                                            } while( 0 )
 #  define FD_PACK_BITSET_INTERSECT4_EMPTY(x1, x2, y1, y2) (__extension__({                                                    \
                                                             addr_bitset_t __temp1[ addr_bitset_word_cnt ];                    \
                                                             addr_bitset_t __temp2[ addr_bitset_word_cnt ];                    \
@@ -168,6 +181,8 @@
                                          set = wv_andnot( wv_shl_vector( one, wv_sub( _n, shift_offset ) ), set ); \
                                        } while( 0 )
 #  define FD_PACK_BITSET_OR(srcdest, x) srcdest = wv_or( srcdest, x );
+#  define FD_PACK_BITSET_AND(srcdest, x) srcdest = wv_and( srcdest, x );
+#  define FD_PACK_BITSET_ANDNOT(srcdest, x) srcdest = wv_andnot( x, srcdest );
 #  define FD_PACK_BITSET_INTERSECT4_EMPTY(x1, x2, y1, y2) (__extension__({                                             \
                                                              wv_t _temp = wv_or( wv_and( x1, y1 ), wv_and( x2, y2 ) ); \
                                                              _mm256_testz_si256( _temp, _temp );                       \
@@ -196,6 +211,8 @@
                                            set = wwv_andnot( wwv_shl_vector( one, wwv_sub( _n, shift_offset ) ), set );     \
                                          } while( 0 )
 #  define FD_PACK_BITSET_OR(srcdest, x) srcdest = wwv_or( srcdest, x );
+#  define FD_PACK_BITSET_AND(srcdest, x) srcdest = wwv_and( srcdest, x );
+#  define FD_PACK_BITSET_ANDNOT(srcdest, x) srcdest = wwv_andnot( x, srcdest );
 #  define FD_PACK_BITSET_INTERSECT4_EMPTY(x1, x2, y1, y2) (__extension__({                                                 \
                                                              wwv_t _temp = wwv_or( wwv_and( x1, y1 ), wwv_and( x2, y2 ) ); \
                                                              _mm512_test_epi64_mask( _temp, _temp )==0;                    \
@@ -111,12 +111,17 @@ static const ulong FD_PACK_TYPICAL_VOTE_COST = ( FD_PACK_COST_PER_SIGNATURE
    transaction is a Simple Vote transaction.  On success, returns the
    cost, which is in [1020, FD_PACK_MAX_COST] and sets the value pointed to by
    is_simple_vote to nonzero/zero depending on if it is a simple vote
-   transaction.  On failure, returns 0 and does not modify the value
-   pointed to by is_simple_vote. */
+   transaction.  Additionally, if opt_execution_cost is non-NULL, sets
+   the value it points to to the portion of the cost that comes from
+   non-builtin (BPF) execution, i.e. the requested compute budget,
+   which is in [0, FD_COMPUTE_BUDGET_MAX_CU_LIMIT].  On failure,
+   returns 0 and does not modify the value pointed to by is_simple_vote
+   or opt_execution_cost. */
 static inline ulong
-fd_pack_compute_cost( fd_txn_p_t * txnp,
-                      uint       * flags ) {
-  fd_txn_t * txn = TXN(txnp);
+fd_pack_compute_cost( fd_txn_p_t const * txnp,
+                      uint             * flags,
+                      ulong            * opt_execution_cost ) {
+  fd_txn_t const * txn = (fd_txn_t const *)txnp->_;
 
 #define ROW(x) fd_pack_builtin_tbl + MAP_PERFECT_HASH_PP( x )
 
@@ -180,6 +185,8 @@ fd_pack_compute_cost( fd_txn_p_t * txnp,
   if( FD_LIKELY( (vote_instr_cnt==1UL) & (txn->instr_cnt==1UL) ) ) *flags |= FD_TXN_P_FLAGS_IS_SIMPLE_VOTE;
   else                                                             *flags &= ~FD_TXN_P_FLAGS_IS_SIMPLE_VOTE;
 
+  if( opt_execution_cost ) *opt_execution_cost = non_builtin_cost;
+
   /* <= FD_PACK_MAX_COST, so no overflow concerns */
   return signature_cost + writable_cost + builtin_cost + instr_data_cost + non_builtin_cost;
 }
@@ -194,6 +194,24 @@ insert( ulong i,
   fd_pack_insert_txn_fini( pack, slot, i );
 }
 
+/* Inserts transactions first, first+1, ..., first+cnt-1 as a bundle. */
+static int
+insert_bundle( ulong       first,
+               ulong       cnt,
+               fd_pack_t * pack,
+               ulong       expires_at ) {
+  fd_txn_p_t * bundle[ FD_PACK_MAX_TXN_PER_BUNDLE ];
+  fd_pack_insert_bundle_init( pack, bundle, cnt );
+  for( ulong j=0UL; j<cnt; j++ ) {
+    fd_txn_p_t * slot = bundle[ j ];
+    fd_txn_t   * txn  = (fd_txn_t*) txn_scratch[ first+j ];
+    slot->payload_sz  = payload_sz[ first+j ];
+    fd_memcpy( slot->payload, payload_scratch[ first+j ], payload_sz[ first+j ]                                          );
+    fd_memcpy( TXN(slot),     txn,                        fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+  }
+  return fd_pack_insert_bundle_fini( pack, bundle, cnt, expires_at );
+}
+
 static void
 schedule_validate_microblock( fd_pack_t * pack,
                               ulong total_cus,
@@ -464,6 +482,42 @@ test_expiration( void ) {
   FD_TEST( fd_pack_avail_txn_cnt( pack ) == 0UL );
 }
 
+/* Makes a transaction with a unique fee payer, no instructions, and no
+   other accounts, which is about the cheapest transaction pack will
+   accept, and stores it in txn_scratch[ i ] and payload_scratch[ i ]. */
+static void
+make_minimal_transaction( ulong i ) {
+  uchar    * p      = payload_scratch[ i ];
+  uchar    * p_base = p;
+  fd_txn_t * t      = (fd_txn_t*) txn_scratch[ i ];
+
+  *(p++) = (uchar)1;
+  fd_memcpy( p,                                   &i,               sizeof(ulong)                                    );
+  fd_memcpy( p+sizeof(ulong),                     SIGNATURE_SUFFIX, FD_TXN_SIGNATURE_SZ - sizeof(ulong)-sizeof(uint) );
+
+  /* Just enough of a transaction to satisfy pack */
+  p += FD_TXN_SIGNATURE_SZ;
+  t->transaction_version   = FD_TXN_VLEGACY;
+  t->signature_cnt         = 1;
+  t->signature_off         = 1;
+  t->message_off           = FD_TXN_SIGNATURE_SZ+1UL;
+  t->readonly_signed_cnt   = 0;
+  t->readonly_unsigned_cnt = 0;
+  t->acct_addr_cnt         = 1;
+  t->acct_addr_off         = FD_TXN_SIGNATURE_SZ+1UL;
+
+  t->recent_blockhash_off         = 0;
+  t->addr_table_lookup_cnt        = 0;
+  t->addr_table_adtl_writable_cnt = 0;
+  t->addr_table_adtl_cnt          = 0;
+  t->instr_cnt                    = 0;
+
+  /* Add the signer */
+  *p = 's' + 0x80; fd_memcpy( p+1, &i, sizeof(ulong) ); memset( p+9, 'S', 32-9 ); p += FD_TXN_ACCT_ADDR_SZ;
+
+  payload_sz[ i ] = (ulong)(p-p_base);
+}
+
 static void
 performance_test2( void ) {
   FD_LOG_NOTICE(( "TEST INDEPENDENT PERFORMANCE" ));
@@ -478,37 +532,7 @@ performance_test2( void ) {
   } };
   /* Make 1024 transaction with different fee payers, no instructions,
      no other accounts. */
-  for( ulong i=0UL; i<MAX_TEST_TXNS; i++ ) {
-    uchar    * p      = payload_scratch[ i ];
-    uchar    * p_base = p;
-    fd_txn_t * t      = (fd_txn_t*) txn_scratch[ i ];
-
-    *(p++) = (uchar)1;
-    fd_memcpy( p,                                   &i,               sizeof(ulong)                                    );
-    fd_memcpy( p+sizeof(ulong),                     SIGNATURE_SUFFIX, FD_TXN_SIGNATURE_SZ - sizeof(ulong)-sizeof(uint) );
-
-    /* Just enough of a transaction to satisfy pack */
-    p += FD_TXN_SIGNATURE_SZ;
-    t->transaction_version   = FD_TXN_VLEGACY;
-    t->signature_cnt         = 1;
-    t->signature_off         = 1;
-    t->message_off           = FD_TXN_SIGNATURE_SZ+1UL;
-    t->readonly_signed_cnt   = 0;
-    t->readonly_unsigned_cnt = 0;
-    t->acct_addr_cnt         = 1;
-    t->acct_addr_off         = FD_TXN_SIGNATURE_SZ+1UL;
-
-    t->recent_blockhash_off         = 0;
-    t->addr_table_lookup_cnt        = 0;
-    t->addr_table_adtl_writable_cnt = 0;
-    t->addr_table_adtl_cnt          = 0;
-    t->instr_cnt                    = 0;
-
-    /* Add the signer */
-    *p = 's' + 0x80; fd_memcpy( p+1, &i, sizeof(ulong) ); memset( p+9, 'S', 32-9 ); p += FD_TXN_ACCT_ADDR_SZ;
-
-    payload_sz[ i ] = (ulong)(p-p_base);
-  }
+  for( ulong i=0UL; i<MAX_TEST_TXNS; i++ ) make_minimal_transaction( i );
   FD_TEST( fd_pack_footprint( 1024UL, 4UL, limits )<PACK_SCRATCH_SZ );
 #define INNER_ROUNDS (FD_PACK_MAX_COST_PER_BLOCK/(1020UL * 1024UL))
 #define OUTER_ROUNDS 88
@@ -546,6 +570,53 @@ performance_test2( void ) {
 #undef INNER_ROUNDS
 }
 
+static void
+performance_test_bundle( void ) {
+  FD_LOG_NOTICE(( "TEST BUNDLE PERFORMANCE" ));
+
+  fd_pack_limits_t limits[ 1 ] = { {
+      .max_cost_per_block        = FD_PACK_MAX_COST_PER_BLOCK,
+      .max_vote_cost_per_block   = 0UL,
+      .max_write_cost_per_acct   = FD_PACK_MAX_WRITE_COST_PER_ACCT,
+      .max_data_bytes_per_block  = ULONG_MAX/2UL,
+      .max_txn_per_microblock    = MAX_TXN_PER_MICROBLOCK,
+      .max_microblocks_per_block = 10000000UL,
+  } };
+  for( ulong i=0UL; i<MAX_TEST_TXNS; i++ ) make_minimal_transaction( i );
+  /* Each bundle also takes up a slot for its header */
+  FD_TEST( fd_pack_footprint( 2048UL, 4UL, limits )<PACK_SCRATCH_SZ );
+
+#define ROUNDS      256UL
+#define BUNDLE_SZ     4UL
+  FD_LOG_NOTICE(( "Bundled txns (%%)\tMicroblocks/round\tTime (ns/txn)" ));
+  ulong bundle_pcts[ 4 ] = { 0UL, 25UL, 50UL, 100UL };
+  for( ulong k=0UL; k<4UL; k++ ) {
+    ulong bundled_cnt = 1024UL*bundle_pcts[ k ]/100UL;
+    fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, 2048UL, 4UL, limits, rng ) );
+
+    long  elapsed        = -fd_log_wallclock();
+    ulong microblock_cnt = 0UL;
+    for( ulong r=0UL; r<ROUNDS; r++ ) {
+      for( ulong i=0UL; i<bundled_cnt; i+=BUNDLE_SZ ) FD_TEST( insert_bundle( i, BUNDLE_SZ, pack, 0UL )>=0 );
+      for( ulong i=bundled_cnt; i<1024UL; i++ ) insert( i, pack );
+      FD_TEST( fd_pack_avail_txn_cnt( pack )==1024UL );
+
+      for( ulong i=0UL; fd_pack_avail_txn_cnt( pack ); i++ ) {
+        fd_pack_microblock_complete( pack, i&3UL );
+        microblock_cnt += !!fd_pack_schedule_next_microblock( pack, MAX_TXN_PER_MICROBLOCK*1200UL, 0.0f, i&3UL, outcome.results );
+      }
+      for( ulong i=0UL; i<4UL; i++ ) fd_pack_microblock_complete( pack, i );
+      fd_pack_end_block( pack );
+    }
+    elapsed += fd_log_wallclock();
+
+    FD_LOG_NOTICE(( "%16lu\t%17.1f\t%13.3f", bundle_pcts[ k ], (double)microblock_cnt/(double)ROUNDS,
+                                             (double)elapsed/(double)(ROUNDS*1024UL) ));
+  }
+#undef BUNDLE_SZ
+#undef ROUNDS
+}
+
 void performance_test( int extra_bench ) {
   ulong i = 0UL;
   FD_LOG_NOTICE(( "TEST PERFORMANCE" ));
@@ -840,6 +911,339 @@ test_gap( void ) {
   }
 }
 
+/* Checks that every transaction in the last scheduled microblock
+   writes to the account named by the character w. */
+static void
+check_writes( ulong txn_cnt,
+              char  w ) {
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_txn_p_t           * txnp = outcome.results+i;
+    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( TXN(txnp), txnp->payload );
+    FD_TEST( acct[1].b[0]==(uchar)w ); /* acct[0] is the signer */
+  }
+}
+
+static void
+test_lookahead( void ) {
+  FD_LOG_NOTICE(( "TEST LOOKAHEAD" ));
+  fd_pack_t * pack = init_all( 128UL, 2UL, 2UL, &outcome );
+  fd_pack_set_lookahead( pack, 16UL );
+
+  ulong i=0UL;
+  make_transaction( i, 500U, 13.0, "A", "" ); insert( i++, pack );
+  make_transaction( i, 500U, 12.5, "B", "" ); insert( i++, pack );
+  make_transaction( i, 500U, 12.0, "A", "" ); insert( i++, pack );
+  make_transaction( i, 500U, 11.5, "B", "" ); insert( i++, pack );
+  make_transaction( i, 500U, 11.0, "A", "" ); insert( i++, pack );
+  make_transaction( i, 500U, 10.5, "B", "" ); insert( i++, pack );
+
+  /* Greedily, bank 0 would get the best A and B writers, stalling bank
+     1 completely.  Instead, A's writers go to bank 0 and B's writers to
+     bank 1. */
+  for( ulong j=0UL; j<3UL; j++ ) {
+    schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, 0UL, 0UL, &outcome );  check_writes( 1UL, 'A' );
+    schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, 0UL, 1UL, &outcome );  check_writes( 1UL, 'B' );
+  }
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* Routing never leaves a bank tile empty handed if greedy scheduling
+     would find something for it.  Bank 0 still owns A's chain and is
+     busy, but once A is the only thing left and bank 0 is done, bank 1
+     can take it over. */
+  make_transaction( i, 500U, 13.0, "A", "" ); insert( i++, pack );
+  make_transaction( i, 500U, 12.0, "A", "" ); insert( i++, pack );
+  fd_pack_microblock_complete( pack, 0UL );
+  outcome.r_accts_in_use[ 0 ] = aset_null( );
+  outcome.w_accts_in_use[ 0 ] = aset_null( );
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 1UL, 0UL, 1UL, &outcome );  check_writes( 1UL, 'A' );
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 0UL, 0UL, 0UL, &outcome );  /* Conflicts with bank 1 */
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* The chains and accounts in use are forgotten at the end of the
+     block, so with A and B no longer contended, bank 0 takes both. */
+  fd_pack_end_block( pack );
+  for( ulong j=0UL; j<2UL; j++ ) {
+    outcome.r_accts_in_use[ j ] = aset_null( );
+    outcome.w_accts_in_use[ j ] = aset_null( );
+  }
+  make_transaction( i, 500U, 11.0, "B", "" ); insert( i++, pack );
+  schedule_validate_microblock( pack, 30000UL, 0.0f, 2UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
+/* Like schedule_validate_microblock, but expects the microblock to be
+   exactly the microblock of a bundle made of transactions first, ...,
+   first+cnt-1 in that order, which is the first microblock of the
+   bundle if start is non-zero.  The transactions in the microblock must
+   not conflict with each other or with microblocks on other bank
+   tiles. */
+static void
+schedule_validate_bundle( fd_pack_t      * pack,
+                          ulong            first,
+                          ulong            cnt,
+                          int              start,
+                          ulong            bank_tile,
+                          pack_outcome_t * outcome ) {
+  ulong pre_txn_cnt = fd_pack_avail_txn_cnt( pack );
+  fd_pack_microblock_complete( pack, bank_tile );
+  ulong txn_cnt = fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, bank_tile, outcome->results );
+  FD_TEST( txn_cnt==cnt );
+  FD_TEST( pre_txn_cnt-fd_pack_avail_txn_cnt( pack )==cnt );
+
+  aset_t  read_accts = aset_null( );
+  aset_t write_accts = aset_null( );
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_txn_p_t * txnp = outcome->results+i;
+    fd_txn_t   * txn  = TXN(txnp);
+    FD_TEST( txnp->flags & FD_TXN_P_FLAGS_BUNDLE );
+    FD_TEST( !!(txnp->flags & FD_TXN_P_FLAGS_BUNDLE_START)==(start && !i) );
+    FD_TEST( FD_LOAD( ulong, txnp->payload+1UL )==first+i );
+
+    aset_t  txn_read_accts = aset_null( );
+    aset_t txn_write_accts = aset_null( );
+    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, txnp->payload );
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE_NONSIGNER_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+      uchar b0 = acct[ fd_txn_acct_iter_idx( iter ) ].b[0];
+      txn_write_accts = aset_insert( txn_write_accts, (ulong)b0-0x30UL );
+    }
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY_NONSIGNER_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+      uchar b0 = acct[ fd_txn_acct_iter_idx( iter ) ].b[0];
+      if( (0x30UL<=b0) & (b0<0x70UL) ) txn_read_accts = aset_insert( txn_read_accts, (ulong)b0-0x30UL );
+    }
+
+    FD_TEST( aset_is_null( aset_intersect( txn_write_accts, read_accts  ) ) );
+    FD_TEST( aset_is_null( aset_intersect( txn_write_accts, write_accts ) ) );
+    FD_TEST( aset_is_null( aset_intersect( txn_read_accts,  write_accts ) ) );
+    read_accts  = aset_union( read_accts,  txn_read_accts  );
+    write_accts = aset_union( write_accts, txn_write_accts );
+  }
+
+  for( ulong i=0UL; i<fd_pack_bank_tile_cnt( pack ); i++ ) {
+    if( i==bank_tile ) continue;
+
+    FD_TEST( aset_is_null( aset_intersect( write_accts, outcome->r_accts_in_use[ i ] ) ) );
+    FD_TEST( aset_is_null( aset_intersect( write_accts, outcome->w_accts_in_use[ i ] ) ) );
+    FD_TEST( aset_is_null( aset_intersect( read_accts,  outcome->w_accts_in_use[ i ] ) ) );
+  }
+  /* The accounts of the earlier microblocks of the bundle are still in
+     use */
+  if( !start ) {
+    read_accts  = aset_union( read_accts,  outcome->r_accts_in_use[ bank_tile ] );
+    write_accts = aset_union( write_accts, outcome->w_accts_in_use[ bank_tile ] );
+  }
+  outcome->r_accts_in_use[ bank_tile ] =  read_accts;
+  outcome->w_accts_in_use[ bank_tile ] = write_accts;
+
+  outcome->microblock_cnt++;
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+}
+
+static void
+test_bundle( void ) {
+  FD_LOG_NOTICE(( "TEST BUNDLE" ));
+  fd_pack_t * pack = init_all( 128UL, 2UL, 8UL, &outcome );
+
+  /* The transactions in a bundle may conflict with each other, in which
+     case the bundle is split into consecutive microblocks on the same
+     bank tile.  Transaction 1 conflicts with transaction 0, but 2
+     conflicts with neither. */
+  ulong i=0UL;
+  make_transaction( i, 500U, 10.0, "A", "B" ); i++;
+  make_transaction( i, 500U, 10.0, "B", "A" ); i++;
+  make_transaction( i, 500U, 10.0, "C", ""  ); i++;
+  FD_TEST( insert_bundle( 0UL, 3UL, pack, 100UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_ADD );
+  /* Even though these two pay more individually, the bundle goes
+     first. */
+  make_transaction( i, 500U, 13.0, "D", ""  ); insert( i++, pack );
+  make_transaction( i, 500U, 12.0, "A", ""  ); insert( i++, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==5UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+
+  schedule_validate_bundle( pack, 0UL, 1UL, 1, 0UL, &outcome );
+  FD_TEST( fd_pack_bundle_bank_tile( pack )==0UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  /* Bank 1 gets D, but not the writer of A, which the bundle keeps in
+     use on bank 0 even between its microblocks */
+  fd_pack_microblock_complete( pack, 0UL );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, 0UL, 1UL, &outcome );
+  FD_TEST( !(outcome.results[0].flags & FD_TXN_P_FLAGS_BUNDLE) );
+  schedule_validate_bundle( pack, 1UL, 2UL, 0, 0UL, &outcome );
+  FD_TEST( fd_pack_bundle_bank_tile( pack )==ULONG_MAX );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* All or nothing: the bundle can't be scheduled while A is in use on
+     bank 0, even though E is available. */
+  make_transaction( i, 500U, 11.0, "E", ""  ); i++;
+  make_transaction( i, 500U, 11.0, "A", ""  ); i++;
+  FD_TEST( insert_bundle( 5UL, 2UL, pack, 100UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_ADD );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0UL, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+  schedule_validate_bundle( pack, 5UL, 2UL, 1, 0UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 0UL, 0UL, 1UL, &outcome );
+  fd_pack_microblock_complete( pack, 0UL );
+  outcome.r_accts_in_use[ 0 ] = aset_null( );
+  outcome.w_accts_in_use[ 0 ] = aset_null( );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, 0UL, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* Duplicates are rejected, whether within the bundle or with a
+     pending transaction, and a rejected bundle leaves nothing behind. */
+  make_transaction( i, 500U, 11.0, "F", ""  ); insert( i, pack );
+  FD_TEST( insert_bundle( i, 1UL, pack, 100UL )==FD_PACK_INSERT_REJECT_DUPLICATE );
+  i++;
+  make_transaction( i,   500U, 11.0, "G", ""  );
+  make_transaction( i+1, 500U, 11.0, "H", ""  );
+  fd_memcpy( payload_scratch[ i+2 ], payload_scratch[ i ], payload_sz[ i ] );
+  fd_memcpy( txn_scratch    [ i+2 ], txn_scratch    [ i ], FD_TXN_MAX_SZ   );
+  payload_sz[ i+2 ] = payload_sz[ i ];
+  FD_TEST( insert_bundle( i, 3UL, pack, 100UL )==FD_PACK_INSERT_REJECT_DUPLICATE );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+
+  /* Deleting any transaction in a bundle deletes the whole bundle */
+  FD_TEST( insert_bundle( i, 2UL, pack, 100UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_ADD );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+  fd_ed25519_sig_t const * sig_g = fd_txn_get_signatures( (fd_txn_t *)txn_scratch[ i   ], payload_scratch[ i   ] );
+  fd_ed25519_sig_t const * sig_h = fd_txn_get_signatures( (fd_txn_t *)txn_scratch[ i+1 ], payload_scratch[ i+1 ] );
+  FD_TEST(  fd_pack_delete_transaction( pack, sig_h ) );
+  FD_TEST( !fd_pack_delete_transaction( pack, sig_g ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+
+  /* Bundles expire as a whole */
+  FD_TEST( insert_bundle( i, 2UL, pack, 5UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_ADD );
+  FD_TEST( fd_pack_expire_before( pack, 6UL )==2UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( insert_bundle( i, 2UL, pack, 5UL )==FD_PACK_INSERT_REJECT_EXPIRED );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+
+  /* The rest of a bundle that doesn't make it into the block is
+     dropped */
+  i += 2UL;
+  make_transaction( i,   500U, 11.0, "I", ""  );
+  make_transaction( i+1, 500U, 11.0, "I", ""  );
+  FD_TEST( insert_bundle( i, 2UL, pack, 100UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_ADD );
+  schedule_validate_bundle( pack, i, 1UL, 1, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==2UL );
+  fd_pack_end_block( pack );
+  FD_TEST( fd_pack_bundle_bank_tile( pack )==ULONG_MAX );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+  i += 2UL;
+
+  /* A bundle that can never fit in a microblock is rejected */
+  pack = init_all( 128UL, 2UL, 2UL, &outcome );
+  i = 0UL;
+  make_transaction( i, 500U, 11.0, "A", ""  ); i++;
+  make_transaction( i, 500U, 11.0, "B", ""  ); i++;
+  make_transaction( i, 500U, 11.0, "C", ""  ); i++;
+  FD_TEST( insert_bundle( 0UL, 3UL, pack, 100UL )==FD_PACK_INSERT_REJECT_TOO_LARGE );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* When pack is full, a bundle replaces the worst individual
+     transactions, but only if they are all worse than the bundle. */
+  pack = init_all( 8UL, 2UL, 8UL, &outcome );
+  i = 0UL;
+  for( ; i<6UL; i++ ) { make_transaction( i, 500U, 3.0+0.1*(double)i, "", "" ); insert( i, pack ); }
+  make_transaction( i, 500U, 1.0, "A", "" ); i++;
+  make_transaction( i, 500U, 1.0, "B", "" ); i++;
+  make_transaction( i, 500U, 1.0, "C", "" ); i++;
+  FD_TEST( insert_bundle( 6UL, 3UL, pack, 100UL )==FD_PACK_INSERT_REJECT_PRIORITY );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==6UL );
+  make_transaction( i, 500U, 9.0, "A", "" ); i++;
+  make_transaction( i, 500U, 9.0, "B", "" ); i++;
+  make_transaction( i, 500U, 9.0, "C", "" ); i++;
+  FD_TEST( insert_bundle( 9UL, 3UL, pack, 100UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_REPLACE );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==7UL );
+  /* The two worst individual transactions, 0 and 1, are gone */
+  FD_TEST( !fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[ 0 ], payload_scratch[ 0 ] ) ) );
+  FD_TEST( !fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[ 1 ], payload_scratch[ 1 ] ) ) );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+  /* Only 4 individual transactions are left, so there's no room for a
+     bundle that needs 6 pool elements, and bundles don't replace
+     bundles. */
+  for( ulong j=0UL; j<5UL; j++ ) make_transaction( i+j, 500U, 12.0, "D", "" );
+  FD_TEST( insert_bundle( i, 5UL, pack, 100UL )==FD_PACK_INSERT_REJECT_FULL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==7UL );
+
+  schedule_validate_bundle( pack, 9UL, 3UL, 1, 0UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 4UL, 0UL, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
+/* Makes transaction i, which must have been made with make_transaction,
+   have the given fee payer instead of its own unique signer.  The
+   signature doesn't change, so it's still unique. */
+static void
+set_fee_payer( ulong i,
+               ulong payer ) {
+  fd_memcpy( payload_scratch[ i ]+FD_TXN_SIGNATURE_SZ+2UL, &payer, sizeof(ulong) );
+}
+
+static void
+test_fee_payer_cap( void ) {
+  FD_LOG_NOTICE(( "TEST FEE PAYER CAP" ));
+  fd_pack_t * pack = init_all( 128UL, 1UL, 128UL, &outcome );
+  fd_pack_set_fee_payer_cap( pack, 3UL );
+
+  /* Only 3 transactions from the same fee payer are accepted, no matter
+     how much they pay */
+  ulong i = 0UL;
+  for( ; i<5UL; i++ ) {
+    make_transaction( i, 500U, 5.0+(double)i, "", "" );
+    set_fee_payer( i, 1000UL );
+    insert( i, pack );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==fd_ulong_min( i+1UL, 3UL ) );
+  }
+  /* Other fee payers aren't affected */
+  make_transaction( i, 500U, 5.0, "", "" ); insert( i++, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+
+  /* Transactions in bundles count too, including the earlier ones in
+     the same bundle. */
+  for( ulong j=0UL; j<4UL; j++ ) { make_transaction( i+j, 500U, 10.0, "", "" ); set_fee_payer( i+j, 2000UL ); }
+  set_fee_payer( i, 1000UL );
+  FD_TEST( insert_bundle( i,     2UL, pack, 100UL )==FD_PACK_INSERT_REJECT_FEE_PAYER_CAP );
+  FD_TEST( insert_bundle( i+1UL, 3UL, pack, 100UL )==FD_PACK_INSERT_ACCEPT_NONVOTE_ADD   );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==7UL );
+  make_transaction( i+4UL, 500U, 10.0, "", "" ); set_fee_payer( i+4UL, 2000UL );
+  insert( i+4UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==7UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+
+  /* Deleting, scheduling, or expiring a transaction makes room for
+     another from the same fee payer */
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[ 0 ], payload_scratch[ 0 ] ) ) );
+  insert( 3UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==7UL );
+  /* The transactions of the bundle share a fee payer, so each one is a
+     microblock of its own */
+  schedule_validate_bundle( pack, i+1UL, 1UL, 1, 0UL, &outcome );
+  schedule_validate_bundle( pack, i+2UL, 1UL, 0, 0UL, &outcome );
+  schedule_validate_bundle( pack, i+3UL, 1UL, 0, 0UL, &outcome );
+  insert( i+4UL, pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==5UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+  /* The fee payer is writable, so its transactions conflict with each
+     other and go in separate microblocks. */
+  for( ulong j=0UL; j<3UL; j++ ) schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+  i += 5UL;
+  for( ulong j=0UL; j<3UL; j++ ) { make_transaction( i, 500U, 5.0, "", "" ); set_fee_payer( i, 1000UL ); insert( i++, pack ); }
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+
+  /* 0 removes the limit */
+  fd_pack_set_fee_payer_cap( pack, 0UL );
+  for( ulong j=0UL; j<10UL; j++ ) { make_transaction( i, 500U, 5.0, "", "" ); set_fee_payer( i, 1000UL ); insert( i++, pack ); }
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==13UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+  FD_TEST( fd_pack_expire_before( pack, ULONG_MAX )==13UL );
+  FD_TEST( !fd_pack_verify( pack, pack_verify_scratch ) );
+}
+
 static void
 test_limits( void ) {
   FD_LOG_NOTICE(( "TEST LIMITS" ));
@@ -979,6 +1383,72 @@ test_limits( void ) {
   }
 }
 
+static void
+test_rebate( void ) {
+  FD_LOG_NOTICE(( "TEST REBATE" ));
+  fd_pack_t * pack = init_all( 1024UL, 1UL, 1024UL, &outcome );
+
+  /* Fill the block as in the total cost block limit test */
+  ulong i=0UL;
+  for( ulong j=0UL; j<FD_PACK_MAX_COST_PER_BLOCK/4000004UL; j++ ) {
+    make_transaction( i, 1000001U, 11.0, "A", "B" );     insert( i++, pack );
+    make_transaction( i, 1000001U, 11.0, "C", "D" );     insert( i++, pack );
+    make_transaction( i, 1000001U, 11.0, "E", "F" );     insert( i++, pack );
+    make_transaction( i, 1000001U, 11.0, "G", "H" );     insert( i++, pack );
+    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 4UL, 0UL, 0UL, &outcome );
+  }
+
+  make_transaction( i, 1000001U, 11.0, "J", "K" );     insert( i++, pack );
+  make_transaction( i, 1000001U, 11.0, "L", "M" );     insert( i++, pack );
+  make_transaction( i, 1000001U, 11.0, "N", "P" );     insert( i++, pack );
+  make_transaction( i, 1000001U, 10.0, "Q", "R" );     insert( i++, pack );
+  schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 3UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* Executed transactions without a consumption report rebate
+     nothing */
+  for( ulong j=0UL; j<3UL; j++ ) outcome.results[ j ].flags |= FD_TXN_P_FLAGS_EXECUTE_SUCCESS;
+  fd_pack_rebate_cus( pack, outcome.results, NULL, 3UL, 1 );
+  schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* Pretend each transaction only consumed 100k of the CUs it
+     requested. */
+  uint consumed[ 3 ] = { 100000U, 100000U, 100000U };
+
+  /* Rebates for a different block don't affect the limits */
+  fd_pack_rebate_cus( pack, outcome.results, consumed, 3UL, 0 );
+  schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* But rebates for this block make room for the last transaction */
+  fd_pack_rebate_cus( pack, outcome.results, consumed, 3UL, 1 );
+  schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* Transactions that didn't execute weren't committed, so all their
+     CUs get rebated, even without a consumption report. */
+  fd_pack_end_block( pack );
+  for( ulong j=0UL; j<FD_PACK_MAX_COST_PER_BLOCK/4000004UL; j++ ) {
+    make_transaction( i, 1000001U, 11.0, "A", "B" );     insert( i++, pack );
+    make_transaction( i, 1000001U, 11.0, "C", "D" );     insert( i++, pack );
+    make_transaction( i, 1000001U, 11.0, "E", "F" );     insert( i++, pack );
+    make_transaction( i, 1000001U, 11.0, "G", "H" );     insert( i++, pack );
+    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 4UL, 0UL, 0UL, &outcome );
+  }
+  make_transaction( i, 1000001U, 11.0, "J", "K" );     insert( i++, pack );
+  make_transaction( i, 1000001U, 11.0, "L", "M" );     insert( i++, pack );
+  make_transaction( i, 1000001U, 11.0, "N", "P" );     insert( i++, pack );
+  make_transaction( i, 1000001U, 10.0, "Q", "R" );     insert( i++, pack );
+  schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 3UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  outcome.results[ 0 ].flags &= ~FD_TXN_P_FLAGS_EXECUTE_SUCCESS;
+  fd_pack_rebate_cus( pack, outcome.results, NULL, 1UL, 1 );
+  schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
 static inline void
 test_reject_writes_to_sysvars( void ) {
   FD_LOG_NOTICE(( "TEST SYSVARS" ));
@@ -1051,10 +1521,15 @@ main( int     argc,
   test_delete();
   test_expiration();
   test_gap();
+  test_lookahead();
+  test_bundle();
+  test_fee_payer_cap();
   test_limits();
+  test_rebate();
   test_reject_writes_to_sysvars();
   performance_test( extra_benchmark );
   performance_test2();
+  performance_test_bundle();
   performance_end_block();
 
   fd_rng_delete( fd_rng_leave( rng ) );
@@ -76,6 +76,27 @@ main( int     argc,
   }
   FD_PACK_BITSET_CLEARN( z, 0 ); FD_TEST(  FD_PACK_BITSET_ISNULL( z ) );
 
+  FD_PACK_BITSET_CLEAR  ( x );
+  FD_PACK_BITSET_CLEAR  ( y );
+  for( ulong i=0UL; i<FD_PACK_BITSET_MAX; i++ ) {
+    if( i%3UL==0UL ) FD_PACK_BITSET_SETN( x, i );
+    if( i%2UL==0UL ) FD_PACK_BITSET_SETN( y, i );
+  }
+
+  FD_PACK_BITSET_COPY  ( z, x );
+  FD_PACK_BITSET_AND   ( z, y ); /* z has multiples of 6 */
+  FD_PACK_BITSET_COPY  ( w, x );
+  FD_PACK_BITSET_ANDNOT( w, y ); /* w has odd multiples of 3 */
+  for( ulong i=0UL; i<FD_PACK_BITSET_MAX; i++ ) {
+    FD_PACK_BITSET_DECLARE( e );  FD_PACK_BITSET_CLEAR( e );
+    FD_PACK_BITSET_DECLARE( n );  FD_PACK_BITSET_CLEAR( n );
+    FD_PACK_BITSET_SETN( n, i );
+    FD_TEST( FD_PACK_BITSET_INTERSECT4_EMPTY( z, e, n, e )==(i%6UL!=0UL) );
+    FD_TEST( FD_PACK_BITSET_INTERSECT4_EMPTY( w, e, n, e )==(i%6UL!=3UL) );
+  }
+  FD_PACK_BITSET_ANDNOT( z, x );  FD_TEST(  FD_PACK_BITSET_ISNULL( z ) );
+  FD_PACK_BITSET_AND   ( w, y );  FD_TEST(  FD_PACK_BITSET_ISNULL( w ) );
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
   return 0;
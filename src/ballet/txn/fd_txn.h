@@ -666,6 +666,42 @@ fd_txn_parse_core( uchar const             * payload,
                    ulong *                   payload_sz_opt,
                    int                       allow_zero_signatures );
 
+/* fd_txn_parse_core_ref: Same as fd_txn_parse_core but never uses SIMD.
+   This is the reference the SIMD paths of fd_txn_parse_core and
+   fd_txn_parse_batch are tested and fuzzed against. */
+
+ulong
+fd_txn_parse_core_ref( uchar const             * payload,
+                       ulong                     payload_sz,
+                       void                    * out_buf,
+                       fd_txn_parse_counters_t * counters_opt,
+                       ulong *                   payload_sz_opt,
+                       int                       allow_zero_signatures );
+
+/* fd_txn_parse_batch: Parses txn_cnt independent transactions, the
+   j-th one occupying exactly [payload[ j ], payload[ j ]+payload_sz[ j ])
+   with the same rules as fd_txn_parse.  The parsed transactions are
+   packed into the out_sz byte region out_mem, which must be aligned to
+   fd_txn_align().  out_txn[ j ] is set to the location of the j-th
+   parsed transaction in out_mem, or NULL if it failed to parse.
+
+   Returns the number of payloads processed.  This is less than txn_cnt
+   only if out_mem ran out of space: a transaction is only parsed when at
+   least FD_TXN_MAX_SZ bytes are left.  out_sz>=txn_cnt*FD_TXN_MAX_SZ
+   is always enough.  Counters are accumulated into counters_opt as
+   with fd_txn_parse_core.
+
+   Accepts the same transactions and produces the same fd_txn_t as
+   fd_txn_parse and amortizes the call overhead over the batch. */
+
+ulong
+fd_txn_parse_batch( uchar const * const *     payload,
+                    ushort const *            payload_sz,
+                    ulong                     txn_cnt,
+                    void *                    out_mem,
+                    ulong                     out_sz,
+                    fd_txn_t **               out_txn,
+                    fd_txn_parse_counters_t * counters_opt );
 
 /* fd_txn_parse: Convenient wrapper around fd_txn_parse_core that eliminates some optional arguments */
 static inline ulong
@@ -2,14 +2,58 @@
 
 #include "fd_txn.h"
 #include "fd_compact_u16.h"
-
-ulong
-fd_txn_parse_core( uchar const             * payload,
-                   ulong                     payload_sz,
-                   void                    * out_buf,
-                   fd_txn_parse_counters_t * counters_opt,
-                   ulong *                   payload_sz_opt,
-                   int                       allow_zero_signatures ) {
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+
+#if FD_HAS_AVX
+/* fd_txn_parse_acct_max_avx accumulates the account indices
+   [payload+off,payload+off+cnt) into the lane-wise max max_v and
+   returns the scalar max of any indices it could not load as a vector.
+   Assumes off+cnt<=payload_sz.  Never reads outside
+   [payload,payload+payload_sz).  Indices past cnt in the last partial
+   vector are masked to 0, which can't raise the max. */
+
+static inline uchar
+fd_txn_parse_acct_max_avx( uchar const * payload,
+                           ulong         payload_sz,
+                           ulong         off,
+                           ulong         cnt,
+                           wb_t *        max_v ) {
+  wb_t  m = *max_v;
+  ulong k = 0UL;
+  for( ; k+32UL<=cnt; k+=32UL ) m = wb_max( m, wb_ldu( payload+off+k ) );
+  uchar max_acct = (uchar)0;
+  if( k<cnt ) {
+    if( FD_LIKELY( 32UL<=payload_sz-(off+k) ) ) {
+      wb_t lane = wb(  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+                      16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 );
+      wb_t keep = wb_lt( lane, wb_bcast( cnt-k ) );
+      m = wb_max( m, wb_and( wb_ldu( payload+off+k ), keep ) );
+    } else {
+      /* Too close to the end of the payload for a full load */
+      for( ; k<cnt; k++ ) max_acct = fd_uchar_max( max_acct, payload[ off+k ] );
+    }
+  }
+  *max_v = m;
+  return max_acct;
+}
+#endif
+
+/* fd_txn_parse_private is fd_txn_parse_core.  If vec is non-zero (a
+   compile time constant), it uses SIMD where available.  Both variants
+   accept and reject exactly the same payloads and produce the same
+   fd_txn_t. */
+
+static inline __attribute__((always_inline)) ulong
+fd_txn_parse_private( uchar const             * payload,
+                      ulong                     payload_sz,
+                      void                    * out_buf,
+                      fd_txn_parse_counters_t * counters_opt,
+                      ulong *                   payload_sz_opt,
+                      int                       allow_zero_signatures,
+                      int                       vec ) {
+  (void)vec;
   ulong i = 0UL;
   /* This code does non-trivial parsing of untrusted user input, which
      is a potentially dangerous thing.  The main invariants we need to
@@ -147,6 +191,9 @@ fd_txn_parse_core( uchar const             * payload,
   }
 
   uchar max_acct = 0UL;
+# if FD_HAS_AVX
+  wb_t max_acct_v = wb_zero();
+# endif
   for( ulong j=0UL; j<instr_cnt; j++ ) {
 
     /* Parsing instruction */
@@ -155,7 +202,15 @@ fd_txn_parse_core( uchar const             * payload,
     CHECK_LEFT( MIN_INSTR_SZ                    );   uchar program_id     = payload[ i ];     i++;
     READ_CHECKED_COMPACT_U16( bytes_consumed,             acct_cnt,                  i );     i+=bytes_consumed;
     CHECK_LEFT( acct_cnt                        );   ulong acct_off       =          i  ;
-    for( ulong k=0; k<acct_cnt; k++ ) { max_acct=fd_uchar_max( max_acct,  payload[ k+i ] ); } i+=acct_cnt;
+#   if FD_HAS_AVX
+    if( vec ) {
+      max_acct=fd_uchar_max( max_acct, fd_txn_parse_acct_max_avx( payload, payload_sz, i, acct_cnt, &max_acct_v ) );
+    } else
+#   endif
+    {
+      for( ulong k=0; k<acct_cnt; k++ ) { max_acct=fd_uchar_max( max_acct,  payload[ k+i ] ); }
+    }
+                                                                                              i+=acct_cnt;
     READ_CHECKED_COMPACT_U16( bytes_consumed,             data_sz,                   i );     i+=bytes_consumed;
     CHECK_LEFT( data_sz                         );   ulong data_off       =          i  ;     i+=data_sz;
 
@@ -224,6 +279,9 @@ fd_txn_parse_core( uchar const             * payload,
   CHECK( acct_addr_cnt+addr_table_adtl_cnt<=FD_TXN_ACCT_ADDR_MAX ); /* implies addr_table_adtl_cnt<256 */
 
   /* Final validation that all the account address indices are in range */
+# if FD_HAS_AVX
+  if( vec ) max_acct = fd_uchar_max( max_acct, wb_extract( wb_max_all( max_acct_v ), 0 ) );
+# endif
   CHECK( max_acct < acct_addr_cnt + addr_table_adtl_cnt );
 
   if( parsed ) {
@@ -242,3 +300,45 @@ fd_txn_parse_core( uchar const             * payload,
   #undef CHECK_LEFT
   #undef READ_CHECKED_COMPACT_U16
 }
+
+ulong
+fd_txn_parse_core( uchar const             * payload,
+                   ulong                     payload_sz,
+                   void                    * out_buf,
+                   fd_txn_parse_counters_t * counters_opt,
+                   ulong *                   payload_sz_opt,
+                   int                       allow_zero_signatures ) {
+  return fd_txn_parse_private( payload, payload_sz, out_buf, counters_opt, payload_sz_opt, allow_zero_signatures, 1 );
+}
+
+ulong
+fd_txn_parse_core_ref( uchar const             * payload,
+                       ulong                     payload_sz,
+                       void                    * out_buf,
+                       fd_txn_parse_counters_t * counters_opt,
+                       ulong *                   payload_sz_opt,
+                       int                       allow_zero_signatures ) {
+  return fd_txn_parse_private( payload, payload_sz, out_buf, counters_opt, payload_sz_opt, allow_zero_signatures, 0 );
+}
+
+ulong
+fd_txn_parse_batch( uchar const * const *     payload,
+                    ushort const *            payload_sz,
+                    ulong                     txn_cnt,
+                    void *                    out_mem,
+                    ulong                     out_sz,
+                    fd_txn_t **               out_txn,
+                    fd_txn_parse_counters_t * counters_opt ) {
+  ulong out_off = 0UL;
+  ulong j;
+  for( j=0UL; j<txn_cnt; j++ ) {
+    if( FD_UNLIKELY( out_off+FD_TXN_MAX_SZ>out_sz ) ) break;
+
+    fd_txn_t * txn = (fd_txn_t *)( (ulong)out_mem + out_off );
+    ulong      sz  = fd_txn_parse_private( payload[ j ], (ulong)payload_sz[ j ], txn, counters_opt, NULL, 0, 1 );
+
+    out_txn[ j ] = sz ? txn : NULL;
+    out_off       = fd_ulong_align_up( out_off+sz, alignof(fd_txn_t) );
+  }
+  return j;
+}
@@ -36,6 +36,46 @@ LLVMFuzzerTestOneInput( uchar const * data,
     FD_TEST( fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt )<=FD_TXN_MAX_SZ );
   }
 
+  /* Every account index of a parsed transaction must be in range */
+
+  if( FD_LIKELY( sz>0UL ) ) {
+    fd_txn_t * txn = (fd_txn_t *)txn_buf;
+    ulong total_accts = (ulong)txn->acct_addr_cnt + (ulong)txn->addr_table_adtl_cnt;
+    for( ulong j=0UL; j<txn->instr_cnt; j++ ) {
+      FD_TEST( txn->instr[ j ].acct_off+txn->instr[ j ].acct_cnt<=size );
+      for( ulong k=0UL; k<txn->instr[ j ].acct_cnt; k++ ) FD_TEST( data[ txn->instr[ j ].acct_off+k ]<total_accts );
+    }
+  }
+
+  /* The SIMD parser must agree with the scalar reference parser */
+
+  uchar __attribute__((aligned((alignof(fd_txn_t))))) ref_buf[ FD_TXN_MAX_SZ ];
+  fd_txn_parse_counters_t ref_counters = {0};
+
+  FD_TEST( fd_txn_parse_core_ref( data, size, ref_buf, &ref_counters, NULL, 0 )==sz );
+  if( sz>0UL ) {
+    FD_TEST( !memcmp( ref_buf, txn_buf, sz ) );
+  } else {
+    FD_TEST( ref_counters.failure_ring[ 0 ]==counters.failure_ring[ 0 ] );
+  }
+
+  /* So must the batch parser */
+
+  uchar __attribute__((aligned((alignof(fd_txn_t))))) batch_buf[ FD_TXN_MAX_SZ ];
+  fd_txn_parse_counters_t batch_counters = {0};
+  uchar const * payload    = data;
+  ushort        payload_sz = (ushort)size;
+  fd_txn_t *    batch_txn  = NULL;
+
+  FD_TEST( fd_txn_parse_batch( &payload, &payload_sz, 1UL, batch_buf, sizeof(batch_buf), &batch_txn, &batch_counters )==1UL );
+  if( sz>0UL ) {
+    FD_TEST( batch_txn==(fd_txn_t *)batch_buf );
+    FD_TEST( !memcmp( batch_buf, ref_buf, sz ) );
+  } else {
+    FD_TEST( !batch_txn );
+    FD_TEST( batch_counters.failure_ring[ 0 ]==ref_counters.failure_ring[ 0 ] );
+  }
+
   FD_FUZZ_MUST_BE_COVERED;
   return 0;
 }
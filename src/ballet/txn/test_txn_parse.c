@@ -26,6 +26,7 @@ FD_IMPORT_BINARY( transaction6, "src/ballet/txn/fixtures/transaction6.bin" );
 
 uchar out_buf[ FD_TXN_MAX_SZ+RED_ZONE_SZ ];
 uchar test_buf[ FD_TXN_MAX_SZ ];
+uchar __attribute__((aligned(alignof(fd_txn_t)))) ref_buf[ FD_TXN_MAX_SZ ];
 
 uchar payload_c[ FD_TXN_MTU ];
 uchar min_okay[  FD_TXN_MTU ];
@@ -221,6 +222,119 @@ void test_mutate( uchar const * payload,
 }
 
 
+/* test_acct_idx checks the account index validation on copies of
+   payload with several account indices randomly mutated at once (which
+   doesn't change the layout).  The copy must parse iff all its indices
+   are less than the number of account addresses, with the SIMD and the
+   reference parsers alike. */
+
+void test_acct_idx( uchar const * payload,
+                    ulong         len,
+                    fd_rng_t *    rng ) {
+  uchar payload_c[ FD_TXN_MTU ];
+  fd_txn_t * parsed = (fd_txn_t *)out_buf;
+  ulong footprint = fd_txn_parse( payload, len, out_buf, NULL );
+  FD_TEST( footprint );
+  ulong total_accts = (ulong)parsed->acct_addr_cnt + (ulong)parsed->addr_table_adtl_cnt;
+
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    fd_memcpy( payload_c, payload, len );
+    ulong mut_cnt = 1UL + fd_rng_ulong_roll( rng, 4UL );
+    for( ulong m=0UL; m<mut_cnt; m++ ) {
+      fd_txn_instr_t const * instr = parsed->instr + fd_rng_ulong_roll( rng, parsed->instr_cnt );
+      if( !instr->acct_cnt ) continue;
+      /* Mostly in range so that out of range ones are isolated */
+      uchar idx = fd_rng_uint_roll( rng, 4U ) ? (uchar)fd_rng_ulong_roll( rng, total_accts ) : fd_rng_uchar( rng );
+      payload_c[ instr->acct_off + fd_rng_ulong_roll( rng, instr->acct_cnt ) ] = idx;
+    }
+
+    uchar max_acct = 0;
+    for( ulong j=0UL; j<parsed->instr_cnt; j++ )
+      for( ulong k=0UL; k<parsed->instr[ j ].acct_cnt; k++ ) max_acct = fd_uchar_max( max_acct, payload_c[ parsed->instr[ j ].acct_off+k ] );
+
+    ulong mut_footprint = fd_txn_parse( payload_c, len, test_buf, NULL );
+    FD_TEST( fd_txn_parse_core_ref( payload_c, len, ref_buf, NULL, NULL, 0 )==mut_footprint );
+    if( max_acct<total_accts ) {
+      FD_TEST( mut_footprint==footprint );
+      FD_TEST( !memcmp( test_buf, out_buf, footprint ) );
+      FD_TEST( !memcmp( ref_buf,  out_buf, footprint ) );
+    } else {
+      FD_TEST( !mut_footprint );
+    }
+  }
+}
+
+/* test_batch checks that fd_txn_parse_batch and fd_txn_parse agree
+   with the scalar reference parser on randomly mutated and truncated
+   copies of payload.  Account index bytes are the most likely to be
+   mutated, as that's where the SIMD parsers differ. */
+
+#define BATCH_CNT (64UL)
+
+uchar batch_payload[ BATCH_CNT ][ FD_TXN_MTU ];
+uchar __attribute__((aligned(alignof(fd_txn_t)))) batch_out[ BATCH_CNT*FD_TXN_MAX_SZ ];
+
+void test_batch( uchar const * payload,
+                 ulong         len,
+                 fd_rng_t *    rng ) {
+  fd_txn_t * parsed = (fd_txn_t *)out_buf;
+  FD_TEST( fd_txn_parse( payload, len, out_buf, NULL ) );
+
+  uchar const * batch_ptr[ BATCH_CNT ];
+  ushort        batch_sz [ BATCH_CNT ];
+  fd_txn_t *    batch_txn[ BATCH_CNT ];
+
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    for( ulong j=0UL; j<BATCH_CNT; j++ ) {
+      fd_memcpy( batch_payload[ j ], payload, len );
+      ulong sz = len;
+      switch( fd_rng_uint_roll( rng, 4U ) ) {
+      case 0U: /* unmodified */
+        break;
+      case 1U: /* truncated */
+        sz = fd_rng_ulong_roll( rng, len );
+        break;
+      case 2U: { /* mutate an account index */
+        fd_txn_instr_t const * instr = parsed->instr + fd_rng_ulong_roll( rng, parsed->instr_cnt );
+        if( instr->acct_cnt ) batch_payload[ j ][ instr->acct_off + fd_rng_ulong_roll( rng, instr->acct_cnt ) ] = fd_rng_uchar( rng );
+        break;
+      }
+      default: /* mutate any byte */
+        batch_payload[ j ][ fd_rng_ulong_roll( rng, len ) ] = fd_rng_uchar( rng );
+        break;
+      }
+      batch_ptr[ j ] = batch_payload[ j ];
+      batch_sz [ j ] = (ushort)sz;
+    }
+
+    fd_txn_parse_counters_t counters       = {0};
+    fd_txn_parse_counters_t batch_counters = {0};
+    FD_TEST( fd_txn_parse_batch( batch_ptr, batch_sz, BATCH_CNT, batch_out, sizeof(batch_out), batch_txn, &batch_counters )==BATCH_CNT );
+    for( ulong j=0UL; j<BATCH_CNT; j++ ) {
+      ulong footprint = fd_txn_parse_core_ref( batch_ptr[ j ], batch_sz[ j ], ref_buf, &counters, NULL, 0 );
+      FD_TEST( fd_txn_parse( batch_ptr[ j ], batch_sz[ j ], test_buf, NULL )==footprint );
+      if( footprint ) {
+        FD_TEST( !memcmp( test_buf, ref_buf, footprint ) );
+        FD_TEST( batch_txn[ j ] );
+        FD_TEST( fd_ulong_is_aligned( (ulong)batch_txn[ j ], alignof(fd_txn_t) ) );
+        FD_TEST( !memcmp( batch_txn[ j ], ref_buf, footprint ) );
+      } else {
+        FD_TEST( !batch_txn[ j ] );
+      }
+    }
+    FD_TEST( counters.success_cnt==batch_counters.success_cnt );
+    FD_TEST( counters.failure_cnt==batch_counters.failure_cnt );
+    for( ulong i=0UL; i<fd_ulong_min( counters.failure_cnt, FD_TXN_PARSE_COUNTERS_RING_SZ ); i++ )
+      FD_TEST( counters.failure_ring[ i ]==batch_counters.failure_ring[ i ] );
+  }
+
+  /* Stops when out of space */
+
+  for( ulong j=0UL; j<BATCH_CNT; j++ ) { batch_ptr[ j ] = payload; batch_sz[ j ] = (ushort)len; }
+  FD_TEST( fd_txn_parse_batch( batch_ptr, batch_sz, BATCH_CNT, batch_out, 3UL*FD_TXN_MAX_SZ, batch_txn, NULL )>=3UL );
+  FD_TEST( fd_txn_parse_batch( batch_ptr, batch_sz, BATCH_CNT, batch_out, FD_TXN_MAX_SZ-1UL, batch_txn, NULL )==0UL );
+}
+
 void test_performance( uchar const * payload,
                        ulong sz ) {
   const ulong test_count = 10000000UL;
@@ -230,6 +344,17 @@ void test_performance( uchar const * payload,
   }
   long end = fd_log_wallclock( );
   FD_LOG_NOTICE(( "Average time per parse: %f ns", (double)(end-start)/(double)test_count ));
+
+  uchar const * batch_ptr[ BATCH_CNT ];
+  ushort        batch_sz [ BATCH_CNT ];
+  fd_txn_t *    batch_txn[ BATCH_CNT ];
+  for( ulong j=0UL; j<BATCH_CNT; j++ ) { batch_ptr[ j ] = payload; batch_sz[ j ] = (ushort)sz; }
+  start = fd_log_wallclock( );
+  for( ulong i = 0; i < test_count/BATCH_CNT; i++ ) {
+    FD_TEST( fd_txn_parse_batch( batch_ptr, batch_sz, BATCH_CNT, batch_out, sizeof(batch_out), batch_txn, NULL )==BATCH_CNT );
+  }
+  end = fd_log_wallclock( );
+  FD_LOG_NOTICE(( "Average time per batch parse: %f ns", (double)(end-start)/(double)((test_count/BATCH_CNT)*BATCH_CNT) ));
 }
 
 int
@@ -248,6 +373,14 @@ main( int     argc,
   test_mutate( transaction1, transaction1_sz );
   test_mutate( transaction2, transaction2_sz );
 
+  test_acct_idx( transaction1, transaction1_sz, rng );
+  test_acct_idx( transaction2, transaction2_sz, rng );
+  test_acct_idx( transaction6, transaction6_sz, rng );
+
+  test_batch( transaction1, transaction1_sz, rng );
+  test_batch( transaction2, transaction2_sz, rng );
+  test_batch( transaction6, transaction6_sz, rng );
+
   fd_memset( out_buf+FD_TXN_MAX_SZ, RED_ZONE_VAL, RED_ZONE_SZ );
   fd_asan_poison( out_buf+FD_TXN_MAX_SZ, RED_ZONE_SZ );
 
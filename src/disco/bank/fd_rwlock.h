@@ -21,11 +21,13 @@ fd_rwlock_write( fd_rwlock_t * lock ) {
   for(;;) {
     ushort value = lock->value;
     if( FD_LIKELY( !value ) ) {
-      if( FD_LIKELY( !FD_ATOMIC_CAS( &lock->value, 0, 0xFFFF ) ) ) return;
+      if( FD_LIKELY( !FD_ATOMIC_CAS( &lock->value, 0, 0xFFFF ) ) ) {
+        FD_COMPILER_MFENCE();
+        return;
+      }
     }
     FD_SPIN_PAUSE();
   }
-  FD_COMPILER_MFENCE();
 }
 
 static inline void
@@ -38,14 +40,14 @@ static inline void
 fd_rwlock_read( fd_rwlock_t * lock ) {
   for(;;) {
     ushort value = lock->value;
-    if( FD_UNLIKELY( value!=0xFFFE ) ) {
+    if( FD_LIKELY( value<0xFFFE ) ) { /* Not write locked and not saturated */
       if( FD_LIKELY( FD_ATOMIC_CAS( &lock->value, value, value+1 )==value ) ) {
+        FD_COMPILER_MFENCE();
         return;
       }
     }
     FD_SPIN_PAUSE();
   }
-  FD_COMPILER_MFENCE();
 }
 
 static inline void
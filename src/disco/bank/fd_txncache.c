@@ -24,6 +24,16 @@
 
 #define FD_TXNCACHE_SLOTCACHE_MAP_CNT (1024UL)
 
+/* The number of shards the cache is striped across.  Each blockhash
+   and each slot is owned by exactly one shard (picked from the low bits
+   of the blockhash and the slot respectively), and each shard has its
+   own lock, lookup tables, and pool of free txnpages.  A purge only
+   ever write locks one shard at a time, so inserts and queries against
+   the other shards keep going while it runs.  Must be a power of
+   two. */
+
+#define FD_TXNCACHE_SHARD_CNT (16UL)
+
 struct fd_txncache_private_txn {
   uint  blockcache_next; /* Pointer to the next element in the blockcache hash chain containing this entry from the pool. */
   uint  slotblockcache_next;  /* Pointer to the next element in the slotcache hash chain containing this entry from the pool. */
@@ -47,10 +57,9 @@ struct fd_txncache_private_txnpage {
 typedef struct fd_txncache_private_txnpage fd_txncache_private_txnpage_t;
 
 struct fd_txncache_private_blockcache {
-  uchar blockhash[ 32 ]; /* The actual blockhash of these transactions. */
   ulong lowest_slot;     /* The lowest slot we have seen that contains a transaction referencing this blockhash.
                             The blockhash entry will not be purged until the lowest rooted slot is at least 150
-                            slots higher than this. */
+                            slots higher than this.  ULONG_MAX if no transaction has been inserted yet. */
   ulong txnhash_offset;  /* To save memory, the Agave validator decided to truncate the hash of transactions stored in
                             this memory to 20 bytes rather than 32 bytes.  The bytes used are not the first 20 as you
                             might expect, but instead the first 20 starting at some random offset into the transaction
@@ -83,16 +92,59 @@ struct fd_txncache_private_slotblockcache {
 typedef struct fd_txncache_private_slotblockcache fd_txncache_private_slotblockcache_t;
 
 struct fd_txncache_private_slotcache {
-  ulong                                slot; /* The slot that this slotcache is for. */
   fd_txncache_private_slotblockcache_t blockcache[ 300UL ];
 };
 
 typedef struct fd_txncache_private_slotcache fd_txncache_private_slotcache_t;
 
+/* A blockmap is an entry in the linear probed hash table of a shard
+   that maps a blockhash to the blockcache holding its transactions.
+   The blockcache itself is acquired from a pool shared by all shards,
+   since there can be at most live_slots_max of them alive at once but
+   they need not be spread evenly among the shards. */
+
+struct fd_txncache_private_blockmap {
+  uchar blockhash[ 32 ]; /* The blockhash this entry is for. */
+  uint  blockcache_idx;  /* Index of the blockcache for this blockhash.  UINT_MAX if the entry is empty, and UINT_MAX-1
+                            while the entry is being created by an inserter. */
+};
+
+typedef struct fd_txncache_private_blockmap fd_txncache_private_blockmap_t;
+
+/* A slotmap is the same as a blockmap, but maps a slot to the
+   slotcache holding the transactions executed in that slot. */
+
+struct fd_txncache_private_slotmap {
+  ulong slot;            /* The slot this entry is for. */
+  uint  slotcache_idx;   /* Index of the slotcache for this slot, with the same sentinels as blockcache_idx above. */
+};
+
+typedef struct fd_txncache_private_slotmap fd_txncache_private_slotmap_t;
+
+struct __attribute__((aligned(FD_TXNCACHE_ALIGN))) fd_txncache_private_shard {
+  fd_rwlock_t lock[ 1 ];      /* Insertion, querying and snapshotting take a read lock on the shards they touch, and
+                                 purging takes a write lock on one shard at a time. */
+  fd_rwlock_t pool_lock[ 1 ]; /* Protects txnpages_free.  Only held for the duration of a push or pop, which happens
+                                 once every FD_TXNCACHE_TXNS_PER_PAGE inserts, so it is not contended. */
+
+  ushort   txnpages_free_cnt; /* The number of free pages in this shard's pool. */
+  ushort * txnpages_free;     /* The index in the txnpages array of each of the free pages.  Pages freed by a purge are
+                                 returned to the pool of the shard owning the blockhash, so pages can migrate between
+                                 shards and each pool has space for every page. */
+
+  fd_txncache_private_blockmap_t * blockmap; /* The blockhashes owned by this shard, a linear probed hash table
+                                                with live_slots_max entries. */
+  fd_txncache_private_slotmap_t *  slotmap;  /* The slots owned by this shard, a linear probed hash table with
+                                                live_slots_max entries. */
+};
+
+typedef struct fd_txncache_private_shard fd_txncache_private_shard_t;
+
 struct __attribute__((aligned(FD_TXNCACHE_ALIGN))) fd_txncache_private {
-  fd_rwlock_t lock[ 1 ]; /* The txncache is a concurrent structure and will be accessed by multiple threads
-                            concurrently.  Insertion and querying only take a read lock as they can be done
-                            lockless but all other operations will take a write lock internally. */
+  fd_rwlock_t root_lock[ 1 ]; /* Protects the root_slots list below.  It is only held while the list is updated or
+                                 read, and is not held while purging. */
+  fd_rwlock_t pool_lock[ 1 ]; /* Protects the blockcache and slotcache free lists below.  Only taken when a blockhash
+                                 or slot is first seen, or when purged. */
 
   ulong  root_slots_max;
   ulong  live_slots_max;
@@ -106,28 +158,28 @@ struct __attribute__((aligned(FD_TXNCACHE_ALIGN))) fd_txncache_private {
                          immediately following the struct.  I.e. these pointers point to
                          memory not far after the struct. */
 
-  fd_txncache_private_blockcache_t * blockcache; /* The actual cache of transactions.  This is a linear probed hash
-                                                    table that maps blockhashes to the transactions that reference them.
-                                                    The depth of the hash table is live_slots_max, since this is the
-                                                    maximum number of blockhashes that can be alive.  The loading factor
-                                                    if they were all alive would be 1.0, but this is rare because we
-                                                    will almost never fork repeatedly to hit this limit.  These
-                                                    blockcaches are just pointers to pages from the txnpages below, so
-                                                    they don't take up much memory. */
-
-  ulong * slotcache_slots; /* The slots that are being tracked in the below slotcache array.  Each slot occupies 300
-                              consecutive spaces in the slotcache. */
+  fd_txncache_private_shard_t shard[ FD_TXNCACHE_SHARD_CNT ];
+
+  ulong  blockcache_free_cnt; /* The number of blockcaches not currently in use. */
+  uint * blockcache_free;     /* The index in the blockcache array of each free blockcache. */
+  fd_txncache_private_blockcache_t * blockcache; /* The actual cache of transactions.  Each blockcache stores the
+                                                    transactions that reference one blockhash, and there can be at
+                                                    most live_slots_max of them alive.  These blockcaches are just
+                                                    pointers to pages from the txnpages below, so they don't take up
+                                                    much memory. */
+
+  ulong  slotcache_free_cnt; /* The number of slotcaches not currently in use. */
+  uint * slotcache_free;     /* The index in the slotcache array of each free slotcache. */
   fd_txncache_private_slotcache_t * slotcache; /* The cache of transactions by slot instead of by blockhash, so we
                                                   can quickly serialize the slot deltas for the root slots which are
                                                   served to peers in snapshots.  Similar to the above, it uses the
                                                   same underlying transaction storage, but different lookup tables. */
 
-  ushort   txnpages_free_cnt; /* The number of pages in the txnpages that are not currently in use. */
-  ushort * txnpages_free;     /* The index in the txnpages array that is free, for each of the free pages. */
   fd_txncache_private_txnpage_t * txnpages; /* The actual storage for the transactions.  The blockcache points to these
                                                pages when storing transactions.  Transaction are grouped into pages of
                                                size 16384 to make certain allocation and deallocation operations faster
-                                               (just the pages are acquired/released, rather than each txn). */
+                                               (just the pages are acquired/released, rather than each txn).  Each shard
+                                               initially owns a contiguous range of the pages. */
 
   ulong magic; /* ==FD_TXNCACHE_MAGIC */
 };
@@ -179,7 +231,7 @@ fd_txncache_max_txnpages( ulong max_live_slots,
      pages, and the other blockhashes need 1 page each. */
 
   ulong result = max_live_slots-1UL+max_live_slots*(1UL+(max_txn_per_slot-1UL)/FD_TXNCACHE_TXNS_PER_PAGE);
-  if( FD_UNLIKELY( result>USHORT_MAX ) ) return 0;
+  if( FD_UNLIKELY( result>=USHORT_MAX ) ) return 0;
   return (ushort)result;
 }
 
@@ -195,7 +247,7 @@ fd_txncache_footprint( ulong max_rooted_slots,
   if( FD_UNLIKELY( max_rooted_slots<1UL || max_live_slots<1UL ) ) return 0UL;
   if( FD_UNLIKELY( max_live_slots<max_rooted_slots ) ) return 0UL;
   if( FD_UNLIKELY( max_txn_per_slot<1UL ) ) return 0UL;
-  if( FD_UNLIKELY( !fd_ulong_is_pow2( max_live_slots || !fd_ulong_is_pow2( max_txn_per_slot ) ) ) ) return 0UL;
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( max_live_slots ) || !fd_ulong_is_pow2( max_txn_per_slot ) ) ) return 0UL;
 
   /* To save memory, txnpages are referenced as ushort which is enough
      to support mainnet parameters without overflow. */
@@ -207,14 +259,17 @@ fd_txncache_footprint( ulong max_rooted_slots,
 
   ulong l;
   l = FD_LAYOUT_INIT;
-  l = FD_LAYOUT_APPEND( l, FD_TXNCACHE_ALIGN,                         sizeof(fd_txncache_t)                                   );
-  l = FD_LAYOUT_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                          ); /* root_slots */
-  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_blockcache_t), max_live_slots*sizeof(fd_txncache_private_blockcache_t) ); /* blockcache */
-  l = FD_LAYOUT_APPEND( l, alignof(uint),                             max_live_slots*max_txnpages_per_blockhash*sizeof(uint)  ); /* blockcache->pages */
-  l = FD_LAYOUT_APPEND( l, alignof(ulong),                            max_live_slots                                          ); /* slotcache_slots */
-  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_slotcache_t),  max_live_slots*sizeof(fd_txncache_private_slotcache_t ) ); /* slotcache */
-  l = FD_LAYOUT_APPEND( l, alignof(ushort),                           max_txnpages                                            ); /* txnpages_free */
-  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_txnpage_t),    max_txnpages*sizeof(fd_txncache_private_txnpage_t)      ); /* txnpages */
+  l = FD_LAYOUT_APPEND( l, FD_TXNCACHE_ALIGN,                         sizeof(fd_txncache_t)                                                         );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                                                ); /* root_slots */
+  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_blockmap_t),   FD_TXNCACHE_SHARD_CNT*max_live_slots*sizeof(fd_txncache_private_blockmap_t)   ); /* shard->blockmap */
+  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_slotmap_t),    FD_TXNCACHE_SHARD_CNT*max_live_slots*sizeof(fd_txncache_private_slotmap_t)    ); /* shard->slotmap */
+  l = FD_LAYOUT_APPEND( l, alignof(ushort),                           FD_TXNCACHE_SHARD_CNT*max_txnpages*sizeof(ushort)                             ); /* shard->txnpages_free */
+  l = FD_LAYOUT_APPEND( l, alignof(uint),                             max_live_slots*sizeof(uint)                                                   ); /* blockcache_free */
+  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_blockcache_t), max_live_slots*sizeof(fd_txncache_private_blockcache_t)                       ); /* blockcache */
+  l = FD_LAYOUT_APPEND( l, alignof(uint),                             max_live_slots*max_txnpages_per_blockhash*sizeof(uint)                        ); /* blockcache->pages */
+  l = FD_LAYOUT_APPEND( l, alignof(uint),                             max_live_slots*sizeof(uint)                                                   ); /* slotcache_free */
+  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_slotcache_t),  max_live_slots*sizeof(fd_txncache_private_slotcache_t )                       ); /* slotcache */
+  l = FD_LAYOUT_APPEND( l, alignof(fd_txncache_private_txnpage_t),    max_txnpages*sizeof(fd_txncache_private_txnpage_t)                            ); /* txnpages */
   return FD_LAYOUT_FINI( l, FD_TXNCACHE_ALIGN );
 }
 
@@ -248,21 +303,27 @@ fd_txncache_new( void * shmem,
   if( FD_UNLIKELY( !max_txnpages_per_blockhash ) ) return NULL;
 
   FD_SCRATCH_ALLOC_INIT( l, shmem );
-  fd_txncache_t * txncache = FD_SCRATCH_ALLOC_APPEND( l,  FD_TXNCACHE_ALIGN,                        sizeof(fd_txncache_t)                                   );
-  void * _root_slots       = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                          );
-  void * _blockcache       = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_blockcache_t), max_live_slots*sizeof(fd_txncache_private_blockcache_t) );
-  void * _blockcache_pages = FD_SCRATCH_ALLOC_APPEND( l, alignof(uint),                             max_live_slots*max_txnpages_per_blockhash*sizeof(uint)  );
-  void * _slotcache        = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_slotcache_t),  max_live_slots*sizeof(fd_txncache_private_slotcache_t ) );
-  void * _txnpages_free    = FD_SCRATCH_ALLOC_APPEND( l, alignof(ushort),                           max_txnpages                                            );
-  void * _txnpages         = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_txnpage_t),    max_txnpages*sizeof(fd_txncache_private_txnpage_t)      );
+  fd_txncache_t * txncache = FD_SCRATCH_ALLOC_APPEND( l,  FD_TXNCACHE_ALIGN,                        sizeof(fd_txncache_t)                                                       );
+  void * _root_slots       = FD_SCRATCH_ALLOC_APPEND( l, alignof(ulong),                            max_rooted_slots*sizeof(ulong)                                              );
+  void * _blockmap         = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_blockmap_t),   FD_TXNCACHE_SHARD_CNT*max_live_slots*sizeof(fd_txncache_private_blockmap_t) );
+  void * _slotmap          = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_slotmap_t),    FD_TXNCACHE_SHARD_CNT*max_live_slots*sizeof(fd_txncache_private_slotmap_t)  );
+  void * _txnpages_free    = FD_SCRATCH_ALLOC_APPEND( l, alignof(ushort),                           FD_TXNCACHE_SHARD_CNT*max_txnpages*sizeof(ushort)                           );
+  void * _blockcache_free  = FD_SCRATCH_ALLOC_APPEND( l, alignof(uint),                             max_live_slots*sizeof(uint)                                                 );
+  void * _blockcache       = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_blockcache_t), max_live_slots*sizeof(fd_txncache_private_blockcache_t)                     );
+  void * _blockcache_pages = FD_SCRATCH_ALLOC_APPEND( l, alignof(uint),                             max_live_slots*max_txnpages_per_blockhash*sizeof(uint)                      );
+  void * _slotcache_free   = FD_SCRATCH_ALLOC_APPEND( l, alignof(uint),                             max_live_slots*sizeof(uint)                                                 );
+  void * _slotcache        = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_slotcache_t),  max_live_slots*sizeof(fd_txncache_private_slotcache_t )                     );
+  void * _txnpages         = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txncache_private_txnpage_t),    max_txnpages*sizeof(fd_txncache_private_txnpage_t)                          );
 
   txncache->root_slots      = _root_slots;
+  txncache->blockcache_free = _blockcache_free;
   txncache->blockcache      = _blockcache;
+  txncache->slotcache_free  = _slotcache_free;
   txncache->slotcache       = _slotcache;
-  txncache->txnpages_free   = _txnpages_free;
   txncache->txnpages        = _txnpages;
 
-  tc->lock->value = 0;
+  tc->root_lock->value = 0;
+  tc->pool_lock->value = 0;
   tc->root_slots_cnt = 0UL;
 
   tc->root_slots_max             = max_rooted_slots;
@@ -271,14 +332,36 @@ fd_txncache_new( void * shmem,
 
   memset( tc->root_slots, 0xFF, max_rooted_slots*sizeof(ulong) );
 
+  tc->blockcache_free_cnt = max_live_slots;
+  tc->slotcache_free_cnt  = max_live_slots;
   for( ulong i=0UL; i<max_live_slots; i++ ) {
-    tc->blockcache[ i ].lowest_slot = ULONG_MAX;
-    tc->blockcache[ i ].pages       = (uint *)_blockcache_pages + i*max_txnpages_per_blockhash;
-    tc->slotcache[ i ].slot         = ULONG_MAX;
+    tc->blockcache[ i ].pages = (uint *)_blockcache_pages + i*max_txnpages_per_blockhash;
+    tc->blockcache_free[ i ]  = (uint)i;
+    tc->slotcache_free[ i ]   = (uint)i;
   }
 
-  tc->txnpages_free_cnt = max_txnpages;
-  for( ushort i=0; i<max_txnpages; i++ ) tc->txnpages_free[ i ] = i;
+  /* Each shard starts out owning an equal contiguous range of the
+     txnpages, so a shard's pages stay close together in memory until
+     purges start shuffling them between shards. */
+
+  for( ulong i=0UL; i<FD_TXNCACHE_SHARD_CNT; i++ ) {
+    fd_txncache_private_shard_t * shard = &tc->shard[ i ];
+    shard->lock->value      = 0;
+    shard->pool_lock->value = 0;
+    shard->blockmap         = (fd_txncache_private_blockmap_t *)_blockmap + i*max_live_slots;
+    shard->slotmap          = (fd_txncache_private_slotmap_t  *)_slotmap  + i*max_live_slots;
+    shard->txnpages_free    = (ushort *)_txnpages_free + i*max_txnpages;
+
+    for( ulong j=0UL; j<max_live_slots; j++ ) {
+      shard->blockmap[ j ].blockcache_idx = UINT_MAX;
+      shard->slotmap [ j ].slotcache_idx  = UINT_MAX;
+    }
+
+    ulong page0 = (i*max_txnpages)/FD_TXNCACHE_SHARD_CNT;
+    ulong page1 = ((i+1UL)*max_txnpages)/FD_TXNCACHE_SHARD_CNT;
+    shard->txnpages_free_cnt = (ushort)(page1-page0);
+    for( ulong j=page0; j<page1; j++ ) shard->txnpages_free[ j-page0 ] = (ushort)j;
+  }
 
   FD_COMPILER_MFENCE();
   FD_VOLATILE( tc->magic ) = FD_TXNCACHE_MAGIC;
@@ -345,33 +428,181 @@ fd_txncache_delete( void * shtc ) {
   return (void *)tc;
 }
 
+/* Blockhashes and slots are assigned to a shard by their low bits, and
+   the remaining bits pick the starting position of the probe in the
+   lookup table of the shard. */
+
+FD_FN_PURE static inline ulong
+fd_txncache_blockhash_shard( uchar const blockhash[ static 32 ] ) {
+  return FD_LOAD( ulong, blockhash ) & (FD_TXNCACHE_SHARD_CNT-1UL);
+}
+
+FD_FN_PURE static inline ulong
+fd_txncache_blockhash_home( fd_txncache_t const * tc,
+                            uchar const           blockhash[ static 32 ] ) {
+  return (FD_LOAD( ulong, blockhash )/FD_TXNCACHE_SHARD_CNT) & (tc->live_slots_max-1UL);
+}
+
+FD_FN_CONST static inline ulong
+fd_txncache_slot_shard( ulong slot ) {
+  return slot & (FD_TXNCACHE_SHARD_CNT-1UL);
+}
+
+FD_FN_PURE static inline ulong
+fd_txncache_slot_home( fd_txncache_t const * tc,
+                       ulong                 slot ) {
+  return (slot/FD_TXNCACHE_SHARD_CNT) & (tc->live_slots_max-1UL);
+}
+
+/* fd_txncache_txnpage_{acquire,release} pop and push a txnpage from
+   and to the pool of the given shard.  Acquire steals from the pools of
+   the other shards if the shard has run out, and returns USHORT_MAX if
+   every pool is empty. */
+
+static ushort
+fd_txncache_txnpage_acquire( fd_txncache_t * tc,
+                             ulong           shard_idx ) {
+  for( ulong i=0UL; i<FD_TXNCACHE_SHARD_CNT; i++ ) {
+    fd_txncache_private_shard_t * shard = &tc->shard[ (shard_idx+i) & (FD_TXNCACHE_SHARD_CNT-1UL) ];
+    if( FD_UNLIKELY( !FD_VOLATILE_CONST( shard->txnpages_free_cnt ) ) ) continue;
+
+    fd_rwlock_write( shard->pool_lock );
+    ushort txnpage_idx = USHORT_MAX;
+    if( FD_LIKELY( shard->txnpages_free_cnt ) ) {
+      shard->txnpages_free_cnt--;
+      txnpage_idx = shard->txnpages_free[ shard->txnpages_free_cnt ];
+    }
+    fd_rwlock_unwrite( shard->pool_lock );
+
+    if( FD_LIKELY( txnpage_idx!=USHORT_MAX ) ) return txnpage_idx;
+  }
+  return USHORT_MAX;
+}
+
 static void
-fd_txncache_purge_slot( fd_txncache_t * tc,
-                        ulong           slot ) {
-  for( ulong i=0UL; i<tc->live_slots_max; i++ ) {
-    if( FD_LIKELY( tc->blockcache[ i ].lowest_slot==ULONG_MAX || (tc->blockcache[ i ].lowest_slot+150UL)>slot ) ) continue;
-    tc->blockcache[ i ].lowest_slot = ULONG_MAX;
-    memcpy( tc->txnpages_free+tc->txnpages_free_cnt, tc->blockcache[ i ].pages, tc->blockcache[ i ].pages_cnt*sizeof(ushort) );
+fd_txncache_txnpage_release( fd_txncache_private_shard_t * shard,
+                             uint const *                  txnpages,
+                             ulong                         txnpages_cnt ) {
+  fd_rwlock_write( shard->pool_lock );
+  for( ulong i=0UL; i<txnpages_cnt; i++ ) shard->txnpages_free[ shard->txnpages_free_cnt++ ] = (ushort)txnpages[ i ];
+  fd_rwlock_unwrite( shard->pool_lock );
+}
 
-    /* TODO: Hash was removed, so any map entries that could have been
-       here but were probed later in the list need to be moved to this
-       empty slot now as well. */
+/* fd_txncache_{blockcache,slotcache}_{acquire,release} pop and push a
+   cache from and to the shared pools.  Acquire returns UINT_MAX if the
+   pool is empty. */
+
+static uint
+fd_txncache_blockcache_acquire( fd_txncache_t * tc ) {
+  uint idx = UINT_MAX;
+  fd_rwlock_write( tc->pool_lock );
+  if( FD_LIKELY( tc->blockcache_free_cnt ) ) idx = tc->blockcache_free[ --tc->blockcache_free_cnt ];
+  fd_rwlock_unwrite( tc->pool_lock );
+  return idx;
+}
+
+static void
+fd_txncache_blockcache_release( fd_txncache_t * tc,
+                                uint            idx ) {
+  fd_rwlock_write( tc->pool_lock );
+  tc->blockcache_free[ tc->blockcache_free_cnt++ ] = idx;
+  fd_rwlock_unwrite( tc->pool_lock );
+}
+
+static uint
+fd_txncache_slotcache_acquire( fd_txncache_t * tc ) {
+  uint idx = UINT_MAX;
+  fd_rwlock_write( tc->pool_lock );
+  if( FD_LIKELY( tc->slotcache_free_cnt ) ) idx = tc->slotcache_free[ --tc->slotcache_free_cnt ];
+  fd_rwlock_unwrite( tc->pool_lock );
+  return idx;
+}
+
+static void
+fd_txncache_slotcache_release( fd_txncache_t * tc,
+                               uint            idx ) {
+  fd_rwlock_write( tc->pool_lock );
+  tc->slotcache_free[ tc->slotcache_free_cnt++ ] = idx;
+  fd_rwlock_unwrite( tc->pool_lock );
+}
+
+/* fd_txncache_purge_shard removes every blockhash and slot owned by the
+   shard that is too old to be needed once slot is purged.  Assumes the
+   caller holds a write lock on the shard, so nobody else is probing its
+   tables and entries can be removed with a backward shift, keeping the
+   probe sequences of the entries that follow intact. */
+
+static void
+fd_txncache_purge_shard( fd_txncache_t *               tc,
+                         fd_txncache_private_shard_t * shard,
+                         ulong                         slot ) {
+  ulong cnt = tc->live_slots_max;
+
+  for( ulong i=0UL; i<cnt; ) {
+    fd_txncache_private_blockmap_t * entry = &shard->blockmap[ i ];
+    if( FD_LIKELY( entry->blockcache_idx==UINT_MAX ) ) { i++; continue; }
+
+    fd_txncache_private_blockcache_t * blockcache = &tc->blockcache[ entry->blockcache_idx ];
+    if( FD_LIKELY( blockcache->lowest_slot==ULONG_MAX || (blockcache->lowest_slot+150UL)>slot ) ) { i++; continue; }
+
+    fd_txncache_txnpage_release( shard, blockcache->pages, blockcache->pages_cnt );
+    fd_txncache_blockcache_release( tc, entry->blockcache_idx );
+
+    ulong hole = i;
+    for( ulong j=(i+1UL)&(cnt-1UL); j!=i; j=(j+1UL)&(cnt-1UL) ) {
+      if( FD_UNLIKELY( shard->blockmap[ j ].blockcache_idx==UINT_MAX ) ) break;
+      ulong home = fd_txncache_blockhash_home( tc, shard->blockmap[ j ].blockhash );
+      /* The entry at j can move into the hole if its home is not
+         cyclically within (hole,j]. */
+      if( FD_LIKELY( ((j-home)&(cnt-1UL)) >= ((j-hole)&(cnt-1UL)) ) ) {
+        shard->blockmap[ hole ] = shard->blockmap[ j ];
+        hole = j;
+      }
+    }
+    shard->blockmap[ hole ].blockcache_idx = UINT_MAX;
+    /* Don't advance i, the entry shifted into it needs checking too. */
   }
 
-  for( ulong i=0UL; i<tc->live_slots_max; i++ ) {
-    if( FD_LIKELY( tc->slotcache[ i ].slot==ULONG_MAX || tc->slotcache[ i ].slot>slot ) ) continue;
-    tc->slotcache[ i ].slot = ULONG_MAX;
+  for( ulong i=0UL; i<cnt; ) {
+    fd_txncache_private_slotmap_t * entry = &shard->slotmap[ i ];
+    if( FD_LIKELY( entry->slotcache_idx==UINT_MAX || entry->slot>slot ) ) { i++; continue; }
+
+    fd_txncache_slotcache_release( tc, entry->slotcache_idx );
 
-    /* TODO: Hash was removed, so any map entries that could have been
-       here but were probed later in the list need to be moved to this
-       empty slot now as well. */
+    ulong hole = i;
+    for( ulong j=(i+1UL)&(cnt-1UL); j!=i; j=(j+1UL)&(cnt-1UL) ) {
+      if( FD_UNLIKELY( shard->slotmap[ j ].slotcache_idx==UINT_MAX ) ) break;
+      ulong home = fd_txncache_slot_home( tc, shard->slotmap[ j ].slot );
+      if( FD_LIKELY( ((j-home)&(cnt-1UL)) >= ((j-hole)&(cnt-1UL)) ) ) {
+        shard->slotmap[ hole ] = shard->slotmap[ j ];
+        hole = j;
+      }
+    }
+    shard->slotmap[ hole ].slotcache_idx = UINT_MAX;
+  }
+}
+
+/* fd_txncache_purge_slot purges the cache incrementally, one shard at a
+   time, so at most one shard is unavailable to inserters and queriers
+   at any point during the purge. */
+
+static void
+fd_txncache_purge_slot( fd_txncache_t * tc,
+                        ulong           slot ) {
+  for( ulong i=0UL; i<FD_TXNCACHE_SHARD_CNT; i++ ) {
+    fd_txncache_private_shard_t * shard = &tc->shard[ i ];
+    fd_rwlock_write( shard->lock );
+    fd_txncache_purge_shard( tc, shard, slot );
+    fd_rwlock_unwrite( shard->lock );
   }
 }
 
 void
 fd_txncache_register_root_slot( fd_txncache_t * tc,
                                 ulong           slot ) {
-  fd_rwlock_write( tc->lock );
+  ulong purge_slot = ULONG_MAX;
+
+  fd_rwlock_write( tc->root_lock );
 
   ulong idx;
   for( idx=0UL; idx<tc->root_slots_cnt; idx++ ) {
@@ -381,11 +612,11 @@ fd_txncache_register_root_slot( fd_txncache_t * tc,
 
   if( FD_UNLIKELY( tc->root_slots_cnt>=tc->root_slots_max ) ) {
     if( FD_LIKELY( idx ) ) {
-      fd_txncache_purge_slot( tc, tc->root_slots[ 0 ] );
+      purge_slot = tc->root_slots[ 0 ];
       memmove( tc->root_slots, tc->root_slots+1UL, (idx-1UL)*sizeof(ulong) );
       tc->root_slots[ (idx-1UL) ] = slot;
     } else {
-      fd_txncache_purge_slot( tc, slot );
+      purge_slot = slot;
     }
   } else {
     if( FD_UNLIKELY( idx<tc->root_slots_cnt ) ) {
@@ -396,40 +627,47 @@ fd_txncache_register_root_slot( fd_txncache_t * tc,
   }
 
 unlock:
-  fd_rwlock_unwrite( tc->lock );
+  fd_rwlock_unwrite( tc->root_lock );
+
+  if( FD_LIKELY( purge_slot!=ULONG_MAX ) ) fd_txncache_purge_slot( tc, purge_slot );
 }
 
 void
 fd_txncache_root_slots( fd_txncache_t * tc,
                         ulong *         out_slots ) {
-  fd_rwlock_write( tc->lock );
+  fd_rwlock_read( tc->root_lock );
   memcpy( out_slots, tc->root_slots, tc->root_slots_max*sizeof(ulong) );
-  fd_rwlock_unwrite( tc->lock );
+  fd_rwlock_unread( tc->root_lock );
 }
 
 #define FD_TXNCACHE_FIND_FOUND      (0)
 #define FD_TXNCACHE_FIND_FOUNDEMPTY (1)
 #define FD_TXNCACHE_FIND_FULL       (2)
 
+/* The find functions below assume the caller holds a read lock on the
+   shard being searched. */
+
 static int
 fd_txncache_find_blockhash( fd_txncache_t const *               tc,
+                            fd_txncache_private_shard_t const * shard,
                             uchar const                         blockhash[ static 32 ],
-                            fd_txncache_private_blockcache_t ** out_blockcache ) {
-  ulong hash = FD_LOAD( ulong, blockhash );
+                            fd_txncache_private_blockmap_t **   out_blockmap ) {
+  ulong home = fd_txncache_blockhash_home( tc, blockhash );
   for( ulong i=0UL; i<tc->live_slots_max; i++ ) {
-    ulong blockcache_idx = (hash+i)%tc->live_slots_max;
-    fd_txncache_private_blockcache_t * blockcache = &tc->blockcache[ blockcache_idx ];
-    if( FD_UNLIKELY( blockcache->lowest_slot==ULONG_MAX ) ) {
-      *out_blockcache = blockcache;
-      return FD_TXNCACHE_FIND_FOUNDEMPTY;
-    }
-    while( FD_UNLIKELY( blockcache->lowest_slot==ULONG_MAX-1UL ) ) {
+    fd_txncache_private_blockmap_t * blockmap = &shard->blockmap[ (home+i)&(tc->live_slots_max-1UL) ];
+    uint blockcache_idx = FD_VOLATILE_CONST( blockmap->blockcache_idx );
+    while( FD_UNLIKELY( blockcache_idx==UINT_MAX-1U ) ) {
       FD_SPIN_PAUSE();
+      blockcache_idx = FD_VOLATILE_CONST( blockmap->blockcache_idx );
+    }
+    if( FD_UNLIKELY( blockcache_idx==UINT_MAX ) ) {
+      *out_blockmap = blockmap;
+      return FD_TXNCACHE_FIND_FOUNDEMPTY;
     }
     FD_COMPILER_MFENCE(); /* Prevent reordering of the blockhash read to before the atomic lock
-                             (highest_slot) has been fully released by the writer. */
-    if( FD_LIKELY( !memcmp( blockcache->blockhash, blockhash, 32UL ) ) ) {
-      *out_blockcache = blockcache;
+                             (blockcache_idx) has been fully released by the writer. */
+    if( FD_LIKELY( !memcmp( blockmap->blockhash, blockhash, 32UL ) ) ) {
+      *out_blockmap = blockmap;
       return FD_TXNCACHE_FIND_FOUND;
     }
   }
@@ -437,23 +675,26 @@ fd_txncache_find_blockhash( fd_txncache_t const *               tc,
 }
 
 static int
-fd_txncache_find_slot( fd_txncache_t const *              tc,
-                       ulong                              slot,
-                       fd_txncache_private_slotcache_t ** out_slotcache ) {
+fd_txncache_find_slot( fd_txncache_t const *               tc,
+                       fd_txncache_private_shard_t const * shard,
+                       ulong                               slot,
+                       fd_txncache_private_slotmap_t **    out_slotmap ) {
+  ulong home = fd_txncache_slot_home( tc, slot );
   for( ulong i=0UL; i<tc->live_slots_max; i++ ) {
-    ulong slotcache_idx = (slot+i)%tc->live_slots_max;
-    fd_txncache_private_slotcache_t * slotcache = &tc->slotcache[ slotcache_idx ];
-    if( FD_UNLIKELY( slotcache->slot==ULONG_MAX ) ) {
-      *out_slotcache = slotcache;
-      return FD_TXNCACHE_FIND_FOUNDEMPTY;
-    }
-    while( FD_UNLIKELY( slotcache->slot==ULONG_MAX-1UL ) ) {
+    fd_txncache_private_slotmap_t * slotmap = &shard->slotmap[ (home+i)&(tc->live_slots_max-1UL) ];
+    uint slotcache_idx = FD_VOLATILE_CONST( slotmap->slotcache_idx );
+    while( FD_UNLIKELY( slotcache_idx==UINT_MAX-1U ) ) {
       FD_SPIN_PAUSE();
+      slotcache_idx = FD_VOLATILE_CONST( slotmap->slotcache_idx );
+    }
+    if( FD_UNLIKELY( slotcache_idx==UINT_MAX ) ) {
+      *out_slotmap = slotmap;
+      return FD_TXNCACHE_FIND_FOUNDEMPTY;
     }
     FD_COMPILER_MFENCE(); /* Prevent reordering of the slot read to before the atomic lock
-                             (slot) has been fully released by the writer. */
-    if( FD_LIKELY( slotcache->slot==slot ) ) {
-      *out_slotcache = slotcache;
+                             (slotcache_idx) has been fully released by the writer. */
+    if( FD_LIKELY( slotmap->slot==slot ) ) {
+      *out_slotmap = slotmap;
       return FD_TXNCACHE_FIND_FOUND;
     }
   }
@@ -487,21 +728,36 @@ fd_txncache_find_slot_blockhash( fd_txncache_private_slotcache_t *       slotcac
 
 static int
 fd_txncache_ensure_blockcache( fd_txncache_t *                     tc,
+                               fd_txncache_private_shard_t *       shard,
                                uchar const                         blockhash[ static 32 ],
                                fd_txncache_private_blockcache_t ** out_blockcache ) {
   for(;;) {
-    int blockcache_find = fd_txncache_find_blockhash( tc, blockhash, out_blockcache );
-    if( FD_LIKELY( blockcache_find==FD_TXNCACHE_FIND_FOUND ) ) return 1;
+    fd_txncache_private_blockmap_t * blockmap;
+    int blockcache_find = fd_txncache_find_blockhash( tc, shard, blockhash, &blockmap );
+    if( FD_LIKELY( blockcache_find==FD_TXNCACHE_FIND_FOUND ) ) {
+      *out_blockcache = &tc->blockcache[ blockmap->blockcache_idx ];
+      return 1;
+    }
     else if( FD_UNLIKELY( blockcache_find==FD_TXNCACHE_FIND_FULL ) ) return 0;
 
-    if( FD_LIKELY( FD_ATOMIC_CAS( &(*out_blockcache)->lowest_slot, ULONG_MAX, ULONG_MAX-1UL ) ) ) {
-      memcpy( (*out_blockcache)->blockhash, blockhash, 32UL );
-      memset( (*out_blockcache)->heads, 0xFF, FD_TXNCACHE_BLOCKCACHE_MAP_CNT*sizeof(uint) );
-      (*out_blockcache)->pages_cnt      = 0;
-      (*out_blockcache)->txnhash_offset = 0UL;
-      memset( (*out_blockcache)->pages, 0xFF, tc->txnpages_per_blockhash_max*sizeof(uint) );
+    if( FD_LIKELY( FD_ATOMIC_CAS( &blockmap->blockcache_idx, UINT_MAX, UINT_MAX-1U )==UINT_MAX ) ) {
+      uint blockcache_idx = fd_txncache_blockcache_acquire( tc );
+      if( FD_UNLIKELY( blockcache_idx==UINT_MAX ) ) {
+        FD_COMPILER_MFENCE();
+        blockmap->blockcache_idx = UINT_MAX;
+        return 0;
+      }
+
+      fd_txncache_private_blockcache_t * blockcache = &tc->blockcache[ blockcache_idx ];
+      memcpy( blockmap->blockhash, blockhash, 32UL );
+      memset( blockcache->heads, 0xFF, FD_TXNCACHE_BLOCKCACHE_MAP_CNT*sizeof(uint) );
+      blockcache->pages_cnt      = 0;
+      blockcache->txnhash_offset = 0UL;
+      blockcache->lowest_slot    = ULONG_MAX;
+      memset( blockcache->pages, 0xFF, tc->txnpages_per_blockhash_max*sizeof(uint) );
       FD_COMPILER_MFENCE();
-      (*out_blockcache)->lowest_slot    = ULONG_MAX-2UL;
+      blockmap->blockcache_idx   = blockcache_idx;
+      *out_blockcache = blockcache;
       return 1;
     }
     FD_SPIN_PAUSE();
@@ -510,19 +766,34 @@ fd_txncache_ensure_blockcache( fd_txncache_t *                     tc,
 
 static int
 fd_txncache_ensure_slotcache( fd_txncache_t *                    tc,
+                              fd_txncache_private_shard_t *      shard,
                               ulong                              slot,
                               fd_txncache_private_slotcache_t ** out_slotcache ) {
   for(;;) {
-    int slotcache_find = fd_txncache_find_slot( tc, slot, out_slotcache );
-    if( FD_LIKELY( slotcache_find==FD_TXNCACHE_FIND_FOUND ) ) return 1;
+    fd_txncache_private_slotmap_t * slotmap;
+    int slotcache_find = fd_txncache_find_slot( tc, shard, slot, &slotmap );
+    if( FD_LIKELY( slotcache_find==FD_TXNCACHE_FIND_FOUND ) ) {
+      *out_slotcache = &tc->slotcache[ slotmap->slotcache_idx ];
+      return 1;
+    }
     else if( FD_UNLIKELY( slotcache_find==FD_TXNCACHE_FIND_FULL ) ) return 0;
 
-    if( FD_LIKELY( FD_ATOMIC_CAS( &(*out_slotcache)->slot, ULONG_MAX, ULONG_MAX-1UL ) ) ) {
+    if( FD_LIKELY( FD_ATOMIC_CAS( &slotmap->slotcache_idx, UINT_MAX, UINT_MAX-1U )==UINT_MAX ) ) {
+      uint slotcache_idx = fd_txncache_slotcache_acquire( tc );
+      if( FD_UNLIKELY( slotcache_idx==UINT_MAX ) ) {
+        FD_COMPILER_MFENCE();
+        slotmap->slotcache_idx = UINT_MAX;
+        return 0;
+      }
+
+      fd_txncache_private_slotcache_t * slotcache = &tc->slotcache[ slotcache_idx ];
+      slotmap->slot = slot;
       for( ulong i=0UL; i<300UL; i++ ) {
-        (*out_slotcache)->blockcache[ i ].txnhash_offset = ULONG_MAX;
+        slotcache->blockcache[ i ].txnhash_offset = ULONG_MAX;
       }
       FD_COMPILER_MFENCE();
-      (*out_slotcache)->slot = slot;
+      slotmap->slotcache_idx = slotcache_idx;
+      *out_slotcache = slotcache;
       return 1;
     }
     FD_SPIN_PAUSE();
@@ -538,7 +809,7 @@ fd_txncache_ensure_slotblockcache( fd_txncache_private_slotcache_t *       slotc
     if( FD_LIKELY( slotblockcache_find==FD_TXNCACHE_FIND_FOUND ) ) return 1;
     else if( FD_UNLIKELY( slotblockcache_find==FD_TXNCACHE_FIND_FULL ) ) return 0;
 
-    if( FD_LIKELY( FD_ATOMIC_CAS( &(*out_slotblockcache)->txnhash_offset, ULONG_MAX, ULONG_MAX-1UL ) ) ) {
+    if( FD_LIKELY( FD_ATOMIC_CAS( &(*out_slotblockcache)->txnhash_offset, ULONG_MAX, ULONG_MAX-1UL )==ULONG_MAX ) ) {
       memcpy( (*out_slotblockcache)->blockhash, blockhash, 32UL );
       memset( (*out_slotblockcache)->heads, 0xFF, FD_TXNCACHE_SLOTCACHE_MAP_CNT*sizeof(uint) );
       FD_COMPILER_MFENCE();
@@ -551,6 +822,7 @@ fd_txncache_ensure_slotblockcache( fd_txncache_private_slotcache_t *       slotc
 
 static fd_txncache_private_txnpage_t *
 fd_txncache_ensure_txnpage( fd_txncache_t *                    tc,
+                            ulong                              shard_idx,
                             fd_txncache_private_blockcache_t * blockcache ) {
   ushort page_cnt = blockcache->pages_cnt;
   if( FD_UNLIKELY( page_cnt>tc->txnpages_per_blockhash_max ) ) return NULL;
@@ -563,16 +835,13 @@ fd_txncache_ensure_txnpage( fd_txncache_t *                    tc,
 
   if( FD_UNLIKELY( page_cnt==tc->txnpages_per_blockhash_max ) ) return NULL;
   if( FD_LIKELY( FD_ATOMIC_CAS( &blockcache->pages[ page_cnt ], UINT_MAX, UINT_MAX-1UL )==UINT_MAX ) ) {
-    ulong txnpages_free_cnt = tc->txnpages_free_cnt;
-    for(;;) {
-      if( FD_UNLIKELY( !txnpages_free_cnt ) ) return NULL;
-      ulong old_txnpages_free_cnt = FD_ATOMIC_CAS( &tc->txnpages_free_cnt, (ushort)txnpages_free_cnt, (ushort)(txnpages_free_cnt-1UL) );
-      if( FD_LIKELY( old_txnpages_free_cnt==txnpages_free_cnt ) ) break;
-      txnpages_free_cnt = old_txnpages_free_cnt;
-      FD_SPIN_PAUSE();
+    ushort txnpage_idx = fd_txncache_txnpage_acquire( tc, shard_idx );
+    if( FD_UNLIKELY( txnpage_idx==USHORT_MAX ) ) {
+      FD_COMPILER_MFENCE();
+      blockcache->pages[ page_cnt ] = UINT_MAX;
+      return NULL;
     }
 
-    ushort txnpage_idx = tc->txnpages_free[ txnpages_free_cnt-1UL ];
     fd_txncache_private_txnpage_t * txnpage = &tc->txnpages[ txnpage_idx ];
     txnpage->free = FD_TXNCACHE_TXNS_PER_PAGE;
     FD_COMPILER_MFENCE();
@@ -581,11 +850,12 @@ fd_txncache_ensure_txnpage( fd_txncache_t *                    tc,
     blockcache->pages_cnt = (ushort)(page_cnt+1);
     return txnpage;
   } else {
-    uint txnpage_idx = blockcache->pages[ page_cnt ];
-    while( FD_UNLIKELY( txnpage_idx>=UINT_MAX-1UL ) ) {
-      txnpage_idx = blockcache->pages[ page_cnt ];
+    uint txnpage_idx = FD_VOLATILE_CONST( blockcache->pages[ page_cnt ] );
+    while( FD_UNLIKELY( txnpage_idx==UINT_MAX-1UL ) ) {
       FD_SPIN_PAUSE();
+      txnpage_idx = FD_VOLATILE_CONST( blockcache->pages[ page_cnt ] );
     }
+    if( FD_UNLIKELY( txnpage_idx==UINT_MAX ) ) return NULL; /* The other inserter found the pools empty */
     return &tc->txnpages[ txnpage_idx ];
   }
 }
@@ -602,7 +872,7 @@ fd_txncache_insert_txn( fd_txncache_t *                        tc,
     ushort txnpage_free = txnpage->free;
     if( FD_UNLIKELY( !txnpage_free ) ) return 0;
     if( FD_UNLIKELY( FD_ATOMIC_CAS( &txnpage->free, txnpage_free, txnpage_free-1UL )!=txnpage_free ) ) continue;
-  
+
     ulong txn_idx = FD_TXNCACHE_TXNS_PER_PAGE-txnpage_free;
     ulong txnhash_offset = blockcache->txnhash_offset;
     ulong txnhash = FD_LOAD( ulong, txn->txnhash+txnhash_offset );
@@ -639,41 +909,61 @@ fd_txncache_insert_txn( fd_txncache_t *                        tc,
   }
 }
 
+/* fd_txncache_insert_one inserts txn into the cache.  Assumes the
+   caller holds a read lock on blockhash_shard (the shard owning the
+   blockhash of txn) and slot_shard (the shard owning the slot of txn). */
+
+static int
+fd_txncache_insert_one( fd_txncache_t *              tc,
+                        ulong                        blockhash_shard_idx,
+                        ulong                        slot_shard_idx,
+                        fd_txncache_insert_t const * txn ) {
+  fd_txncache_private_blockcache_t * blockcache;
+  if( FD_UNLIKELY( !fd_txncache_ensure_blockcache( tc, &tc->shard[ blockhash_shard_idx ], txn->blockhash, &blockcache ) ) ) return 0;
+
+  // TODO: We should turn this on to prevent corruption
+  // if( FD_UNLIKELY( txn->slot>=blockcache->lowest_slot+150UL ) ) return 0;
+
+  fd_txncache_private_slotcache_t * slotcache;
+  if( FD_UNLIKELY( !fd_txncache_ensure_slotcache( tc, &tc->shard[ slot_shard_idx ], txn->slot, &slotcache ) ) ) return 0;
+
+  fd_txncache_private_slotblockcache_t * slotblockcache;
+  if( FD_UNLIKELY( !fd_txncache_ensure_slotblockcache( slotcache, txn->blockhash, &slotblockcache ) ) ) return 0;
+
+  for(;;) {
+    fd_txncache_private_txnpage_t * txnpage = fd_txncache_ensure_txnpage( tc, blockhash_shard_idx, blockcache );
+    if( FD_UNLIKELY( !txnpage ) ) return 0;
+
+    int success = fd_txncache_insert_txn( tc, blockcache, slotblockcache, txnpage, txn );
+    if( FD_LIKELY( success ) ) return 1;
+    FD_SPIN_PAUSE();
+  }
+}
+
 int
 fd_txncache_insert_batch( fd_txncache_t *              tc,
                           fd_txncache_insert_t const * txns,
                           ulong                        txns_cnt ) {
-  fd_rwlock_read( tc->lock );
-
   for( ulong i=0UL; i<txns_cnt; i++ ) {
-    fd_txncache_private_blockcache_t * blockcache;
-    if( FD_UNLIKELY( !fd_txncache_ensure_blockcache( tc, txns[ i ].blockhash, &blockcache ) ) ) goto unlock_fail;
+    ulong blockhash_shard_idx = fd_txncache_blockhash_shard( txns[ i ].blockhash );
+    ulong slot_shard_idx      = fd_txncache_slot_shard( txns[ i ].slot );
 
-    // TODO: We should turn this on to prevent corruption
-    // if( FD_UNLIKELY( txns[ i ].slot>=blockcache->lowest_slot+150UL ) ) goto unlock_fail;
+    /* Readers never wait on a writer while holding the shard the writer
+       wants, since writers only ever hold one shard lock, so holding
+       two read locks here cannot deadlock. */
 
-    fd_txncache_private_slotcache_t * slotcache;
-    if( FD_UNLIKELY( !fd_txncache_ensure_slotcache( tc, txns[ i ].slot, &slotcache ) ) ) goto unlock_fail;
+    fd_rwlock_read( tc->shard[ blockhash_shard_idx ].lock );
+    if( FD_LIKELY( slot_shard_idx!=blockhash_shard_idx ) ) fd_rwlock_read( tc->shard[ slot_shard_idx ].lock );
 
-    fd_txncache_private_slotblockcache_t * slotblockcache;
-    if( FD_UNLIKELY( !fd_txncache_ensure_slotblockcache( slotcache, txns[ i ].blockhash, &slotblockcache ) ) ) goto unlock_fail;
+    int success = fd_txncache_insert_one( tc, blockhash_shard_idx, slot_shard_idx, &txns[ i ] );
 
-    for(;;) {
-      fd_txncache_private_txnpage_t * txnpage = fd_txncache_ensure_txnpage( tc, blockcache );
-      if( FD_UNLIKELY( !txnpage ) ) goto unlock_fail;
+    if( FD_LIKELY( slot_shard_idx!=blockhash_shard_idx ) ) fd_rwlock_unread( tc->shard[ slot_shard_idx ].lock );
+    fd_rwlock_unread( tc->shard[ blockhash_shard_idx ].lock );
 
-      int success = fd_txncache_insert_txn( tc, blockcache, slotblockcache, txnpage, &txns[ i ] );
-      if( FD_LIKELY( success ) ) break;
-      FD_SPIN_PAUSE();
-    }
+    if( FD_UNLIKELY( !success ) ) return 0;
   }
 
-  fd_rwlock_unread( tc->lock );
   return 1;
-
-unlock_fail:
-  fd_rwlock_unread( tc->lock );
-  return 0;
 }
 
 void
@@ -683,18 +973,21 @@ fd_txncache_query_batch( fd_txncache_t *             tc,
                          void *                      query_func_ctx,
                          int ( * query_func )( ulong slot, void * ctx ),
                          int *                       out_results ) {
-  fd_rwlock_read( tc->lock );
-
   for( ulong i=0UL; i<queries_cnt; i++ ) {
     out_results[ i ] = 0;
 
     fd_txncache_query_t const * query = &queries[ i ];
-    fd_txncache_private_blockcache_t * blockcache;
-    int result = fd_txncache_find_blockhash( tc, query->blockhash, &blockcache );
+    fd_txncache_private_shard_t * shard = &tc->shard[ fd_txncache_blockhash_shard( query->blockhash ) ];
+    fd_rwlock_read( shard->lock );
+
+    fd_txncache_private_blockmap_t * blockmap;
+    int result = fd_txncache_find_blockhash( tc, shard, query->blockhash, &blockmap );
     if( FD_UNLIKELY( result!=FD_TXNCACHE_FIND_FOUND ) ) {
+      fd_rwlock_unread( shard->lock );
       continue;
     }
 
+    fd_txncache_private_blockcache_t * blockcache = &tc->blockcache[ blockmap->blockcache_idx ];
     ulong txnhash_offset = blockcache->txnhash_offset;
     ulong head_hash = FD_LOAD( ulong, query->txnhash+txnhash_offset ) % FD_TXNCACHE_BLOCKCACHE_MAP_CNT;
     for( uint head=blockcache->heads[ head_hash ]; head!=UINT_MAX; head=tc->txnpages[ head/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ head%FD_TXNCACHE_TXNS_PER_PAGE ]->blockcache_next ) {
@@ -706,27 +999,46 @@ fd_txncache_query_batch( fd_txncache_t *             tc,
         }
       }
     }
-  }
 
-  fd_rwlock_unread( tc->lock );
+    fd_rwlock_unread( shard->lock );
+  }
 }
 
 int
 fd_txncache_snapshot( fd_txncache_t * tc,
                       void *          ctx,
                       int ( * write )( uchar const * data, ulong data_sz, void * ctx ) ) {
-  fd_rwlock_read( tc->lock );
+  /* The root lock is held for reading so the list of root slots can't
+     change under us, but purges triggered by earlier roots proceed
+     concurrently, so a root slot might have been purged by the time we
+     get to it, in which case it is skipped. */
+
+  fd_rwlock_read( tc->root_lock );
 
   for( ulong i=0UL; i<tc->root_slots_cnt; i++ ) {
     ulong slot = tc->root_slots[ i ];
 
-    fd_txncache_private_slotcache_t * slotcache;
-    if( FD_UNLIKELY( FD_TXNCACHE_FIND_FOUND!=fd_txncache_find_slot( tc, slot, &slotcache ) ) ) continue;
+    fd_txncache_private_shard_t * slot_shard = &tc->shard[ fd_txncache_slot_shard( slot ) ];
+    fd_rwlock_read( slot_shard->lock );
 
+    fd_txncache_private_slotmap_t * slotmap;
+    if( FD_UNLIKELY( FD_TXNCACHE_FIND_FOUND!=fd_txncache_find_slot( tc, slot_shard, slot, &slotmap ) ) ) {
+      fd_rwlock_unread( slot_shard->lock );
+      continue;
+    }
+
+    fd_txncache_private_slotcache_t * slotcache = &tc->slotcache[ slotmap->slotcache_idx ];
     for( ulong j=0UL; j<300UL; j++ ) {
       fd_txncache_private_slotblockcache_t * slotblockcache = &slotcache->blockcache[ j ];
       if( FD_UNLIKELY( slotblockcache->txnhash_offset>=ULONG_MAX-1UL ) ) continue;
 
+      /* The transactions live in pages owned by the blockhash, so that
+         shard is read locked too to keep them from being purged while
+         they are walked. */
+
+      fd_txncache_private_shard_t * blockhash_shard = &tc->shard[ fd_txncache_blockhash_shard( slotblockcache->blockhash ) ];
+      if( FD_LIKELY( blockhash_shard!=slot_shard ) ) fd_rwlock_read( blockhash_shard->lock );
+
       for( ulong k=0UL; k<FD_TXNCACHE_SLOTCACHE_MAP_CNT; k++ ) {
         uint head = slotblockcache->heads[ k ];
         for( ; head!=UINT_MAX; head=tc->txnpages[ head/FD_TXNCACHE_TXNS_PER_PAGE ].txns[ head%FD_TXNCACHE_TXNS_PER_PAGE ]->slotblockcache_next ) {
@@ -736,9 +1048,13 @@ fd_txncache_snapshot( fd_txncache_t * tc,
           (void)ctx;
         }
       }
+
+      if( FD_LIKELY( blockhash_shard!=slot_shard ) ) fd_rwlock_unread( blockhash_shard->lock );
     }
+
+    fd_rwlock_unread( slot_shard->lock );
   }
 
-  fd_rwlock_unread( tc->lock );
+  fd_rwlock_unread( tc->root_lock );
   return 0;
 }
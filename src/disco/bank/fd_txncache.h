@@ -20,8 +20,16 @@
 
    Both of these operations are concurrent and lockless, assuming there
    are no other (non-insert/query) operations occuring on the txn cache.
-   Most other operations lock the entire structure and will prevent both
-   insertion and query from proceeding.
+
+   To keep other operations from stalling inserts and queries, the
+   cache is striped across a fixed number of shards.  Each blockhash and
+   each slot is owned by one shard, which has its own lock, its own
+   lookup tables, and its own pool of transaction pages.  Inserts and
+   queries take a read lock on just the shards they touch (a shared
+   counter, so they don't block each other), purging old slots write
+   locks one shard at a time, and snapshotting only read locks, so a
+   purge pauses at most the fraction of operations that land on the
+   shard being purged, and snapshots run concurrently with inserts.
 
    The txn cache is both CPU and memory sensitive.  A transaction result
    is 40 bytes, and the stored transaction hashes are 20 bytes, so
@@ -74,10 +82,11 @@
        Removal of a blockhash from this structure is simple because it
        does not need to be concurrent (the caller will only remove
        between executing slots, so there's no contention and it can take
-       a full write lock).  We take a write lock, restore the pages in
-       the blockhash to the pool, and then mark the space in the
-       hash_map as empty.  This is fast since there are at most 4,800
-       pages to restore and restoration is a simple memcpy.
+       a write lock on the shard owning the blockhash).  We take the
+       write lock, restore the pages in the blockhash to the pool of the
+       shard, and then remove the entry from the hash_map of the shard.
+       This is fast since there are at most 4,800 pages to restore and
+       restoration is a simple memcpy.
       
      - Another structure is required to support serialization of
        snapshots from the cache.  Serialization must produce a binary
@@ -277,9 +286,9 @@ fd_txncache_delete( void * shtc );
    Transaction status is removed once all roots referencing the
    blockhash of the transaction are removed from the txn cache.
    
-   This is neither cheap or expensive, it will pause all insertion and
-   query operations but only momentarily until any old slots can be
-   purged from the cache. */
+   This is neither cheap or expensive.  Old slots are purged one shard
+   at a time, so it will momentarily pause insertion and query
+   operations against the shard being purged, but not the others. */
 
 void
 fd_txncache_register_root_slot( fd_txncache_t * tc,
@@ -293,8 +302,8 @@ fd_txncache_register_root_slot( fd_txncache_t * tc,
    in the cache, the front part of out_slots will be filled in, and all
    the remaining slots will be set to ULONG_MAX.
    
-   This is a fast operation, but it will lock the whole structure and
-   cause a temporary pause in insert and query operations. */
+   This is a fast operation and does not pause insert or query
+   operations. */
 
 void
 fd_txncache_root_slots( fd_txncache_t * tc,
@@ -316,7 +325,8 @@ fd_txncache_root_slots( fd_txncache_t * tc,
    ROOTED SLOT.
 
    This is a cheap operation and will not cause any pause in insertion
-   or query operations. */
+   or query operations, although purges of old slots will wait for it
+   to finish with the shards it is reading. */
 
 int
 fd_txncache_snapshot( fd_txncache_t * tc,
@@ -593,6 +593,120 @@ test_many_blockhashes_concurrent( void ) {
   }
 }
 
+/* The bench below has a group of inserter and querier threads hammer a
+   small cache, while an admin thread concurrently registers roots
+   (purging old slots out of the shards) and serializes snapshots, and
+   reports the aggregate insert and query throughput. */
+
+#define BENCH_BLOCKHASH_CNT (32UL)
+#define BENCH_TXN_CNT       (1UL<<20)
+#define BENCH_INSERT_CNT    (8UL)
+#define BENCH_QUERY_CNT     (8UL)
+
+static volatile int   bench_go;
+static volatile ulong bench_insert_done;
+
+static int
+bench_write( uchar const * data,
+             ulong         data_sz,
+             void *        ctx ) {
+  (void)data; (void)data_sz; (void)ctx;
+  return 0;
+}
+
+void *
+bench_insert_fn( void * arg ) {
+  while( !bench_go ) FD_SPIN_PAUSE();
+
+  ulong x = (ulong)arg;
+  for( ulong i=x; i<BENCH_TXN_CNT; i+=BENCH_INSERT_CNT ) insert( i%BENCH_BLOCKHASH_CNT, i, i%BENCH_BLOCKHASH_CNT );
+
+  FD_ATOMIC_FETCH_AND_ADD( &bench_insert_done, 1UL );
+  return NULL;
+}
+
+void *
+bench_query_fn( void * arg ) {
+  while( !bench_go ) FD_SPIN_PAUSE();
+
+  ulong x = (ulong)arg;
+  fd_rng_t rng[1];
+  FD_TEST( fd_rng_join( fd_rng_new( rng, (uint)x, x+10UL ) ) );
+
+  ulong query_cnt = 0UL;
+  while( bench_insert_done<BENCH_INSERT_CNT ) {
+    uchar blockhash[ 32 ] = {0};
+    uchar txnhash[ 32 ] = {0};
+    ulong i = fd_rng_ulong_roll( rng, BENCH_TXN_CNT );
+    FD_STORE( ulong, blockhash, i%BENCH_BLOCKHASH_CNT );
+    FD_STORE( ulong, txnhash,   i );
+
+    fd_txncache_query_t query = {
+      .blockhash = blockhash,
+      .txnhash   = txnhash,
+    };
+    int results[1];
+    fd_txncache_query_batch( (fd_txncache_t*)txncache_scratch, &query, 1UL, NULL, NULL, results );
+    query_cnt++;
+  }
+  return (void *)query_cnt;
+}
+
+void *
+bench_admin_fn( void * arg ) {
+  fd_txncache_t * tc = (fd_txncache_t *)arg;
+  while( !bench_go ) FD_SPIN_PAUSE();
+
+  /* Roots are registered beyond the inserted slots, so the slotcaches
+     of the inserted slots get purged (and recreated by the inserters)
+     but the blockhashes stay alive for the final check. */
+
+  ulong slot = BENCH_BLOCKHASH_CNT;
+  while( bench_insert_done<BENCH_INSERT_CNT ) {
+    if( FD_LIKELY( slot<150UL ) ) fd_txncache_register_root_slot( tc, slot++ );
+    FD_TEST( !fd_txncache_snapshot( tc, NULL, bench_write ) );
+  }
+  return NULL;
+}
+
+void
+test_bench_concurrent( void ) {
+  FD_LOG_NOTICE(( "TEST BENCH CONCURRENT" ));
+
+  fd_txncache_t * tc = init_all( BENCH_BLOCKHASH_CNT, 2UL*BENCH_BLOCKHASH_CNT, BENCH_TXN_CNT/BENCH_BLOCKHASH_CNT );
+
+  bench_go          = 0;
+  bench_insert_done = 0UL;
+
+  pthread_t insert_threads[ BENCH_INSERT_CNT ];
+  pthread_t query_threads[ BENCH_QUERY_CNT ];
+  pthread_t admin_thread;
+  for( ulong i=0UL; i<BENCH_INSERT_CNT; i++ ) FD_TEST( !pthread_create( insert_threads+i, NULL, bench_insert_fn, (void *)i ) );
+  for( ulong i=0UL; i<BENCH_QUERY_CNT;  i++ ) FD_TEST( !pthread_create( query_threads+i,  NULL, bench_query_fn,  (void *)i ) );
+  FD_TEST( !pthread_create( &admin_thread, NULL, bench_admin_fn, tc ) );
+
+  long dt = -fd_log_wallclock();
+  FD_COMPILER_MFENCE();
+  bench_go = 1;
+
+  for( ulong i=0UL; i<BENCH_INSERT_CNT; i++ ) FD_TEST( !pthread_join( insert_threads[i], NULL ) );
+  dt += fd_log_wallclock();
+
+  ulong query_cnt = 0UL;
+  for( ulong i=0UL; i<BENCH_QUERY_CNT; i++ ) {
+    void * ret;
+    FD_TEST( !pthread_join( query_threads[i], &ret ) );
+    query_cnt += (ulong)ret;
+  }
+  FD_TEST( !pthread_join( admin_thread, NULL ) );
+
+  FD_LOG_NOTICE(( "%lu inserter threads, %lu querier threads: %.3f Minsert/s, %.3f Mquery/s",
+                  BENCH_INSERT_CNT, BENCH_QUERY_CNT,
+                  1e3*(double)BENCH_TXN_CNT/(double)dt, 1e3*(double)query_cnt/(double)dt ));
+
+  for( ulong i=0UL; i<BENCH_TXN_CNT; i++ ) contains( i%BENCH_BLOCKHASH_CNT, i, i%BENCH_BLOCKHASH_CNT );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -618,6 +732,7 @@ main( int     argc,
   test_many_blockhashes();
   test_full_blockhash_concurrent();
   test_many_blockhashes_concurrent();
+  test_bench_concurrent();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
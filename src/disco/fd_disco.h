@@ -4,6 +4,7 @@
 //#include "fd_disco_base.h"    /* includes ../tango/fd_tango.h */
 #include "mux/fd_mux.h"         /* includes fd_disco_base.h */
 #include "metrics/fd_metrics.h" /* includes fd_disco_base.h */
+#include "trace/fd_trace.h"     /* includes fd_disco_base.h */
 #include "replay/fd_replay.h"   /* includes fd_disco_base.h */
 #include "../flamenco/types/fd_types_custom.h"
 
@@ -10,6 +10,7 @@
 #include "generated/fd_metrics_poh.h"
 #include "generated/fd_metrics_store.h"
 #include "generated/fd_metrics_shred.h"
+#include "generated/fd_metrics_metric.h"
 
 #include "../../tango/tempo/fd_tempo.h"
 
@@ -135,7 +135,8 @@ if __name__ == '__main__':
     os.makedirs('generated', exist_ok=True)  # Ensure the directory exists
 
     max_offset = 0
-    for tile in ['all', 'quic', 'pack', 'bank', 'poh', 'store', 'shred']:
+    TILES = ['all', 'quic', 'pack', 'bank', 'poh', 'store', 'shred', 'metric']
+    for tile in TILES:
         tile_metrics = [x for x in metrics if x.tile == tile]
         max_offset = max(max_offset, sum([OFFSETS[x.type] for x in metrics if x.tile == 'all' or x.tile == tile]))
 
@@ -222,3 +223,28 @@ if __name__ == '__main__':
     with open('generated/fd_metrics_all.h', 'a') as f:
         # Kind of a hack for now.  Different tiles should get a different size.
         f.write(f'\n#define FD_METRICS_TOTAL_SZ (8UL*{max_offset}UL)\n')
+
+        # Table of the tile specific metrics of each tile kind, so that
+        # consumers like the Prometheus endpoint don't need to list them.
+        kinds = TILES[1:]
+        f.write(f'\n#define FD_METRICS_TILE_KIND_CNT ({len(kinds)}UL)\n')
+        f.write(f'extern const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT];\n')
+        f.write(f'extern const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT];\n')
+        f.write(f'extern const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT];\n')
+
+    with open('generated/fd_metrics_all.c', 'a') as f:
+        f.write('\n')
+        for tile in kinds:
+            f.write(f'#include "fd_metrics_{tile}.h"\n')
+        f.write('\nconst char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT] = {\n')
+        for tile in kinds:
+            f.write(f'    "{tile}",\n')
+        f.write('};\n\n')
+        f.write('const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT] = {\n')
+        for tile in kinds:
+            f.write(f'    FD_METRICS_{tile.upper()}_TOTAL,\n')
+        f.write('};\n\n')
+        f.write('const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT] = {\n')
+        for tile in kinds:
+            f.write(f'    FD_METRICS_{tile.upper()},\n')
+        f.write('};\n')
@@ -29,3 +29,41 @@ const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_TOTAL] = {
 const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_TOTAL] = {
     DECLARE_METRIC_COUNTER( LINK, SLOW_COUNT ),
 };
+
+#include "fd_metrics_quic.h"
+#include "fd_metrics_pack.h"
+#include "fd_metrics_bank.h"
+#include "fd_metrics_poh.h"
+#include "fd_metrics_store.h"
+#include "fd_metrics_shred.h"
+#include "fd_metrics_metric.h"
+
+const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT] = {
+    "quic",
+    "pack",
+    "bank",
+    "poh",
+    "store",
+    "shred",
+    "metric",
+};
+
+const ulong FD_METRICS_TILE_KIND_SIZES[FD_METRICS_TILE_KIND_CNT] = {
+    FD_METRICS_QUIC_TOTAL,
+    FD_METRICS_PACK_TOTAL,
+    FD_METRICS_BANK_TOTAL,
+    FD_METRICS_POH_TOTAL,
+    FD_METRICS_STORE_TOTAL,
+    FD_METRICS_SHRED_TOTAL,
+    FD_METRICS_METRIC_TOTAL,
+};
+
+const fd_metrics_meta_t * FD_METRICS_TILE_KIND_METRICS[FD_METRICS_TILE_KIND_CNT] = {
+    FD_METRICS_QUIC,
+    FD_METRICS_PACK,
+    FD_METRICS_BANK,
+    FD_METRICS_POH,
+    FD_METRICS_STORE,
+    FD_METRICS_SHRED,
+    FD_METRICS_METRIC,
+};
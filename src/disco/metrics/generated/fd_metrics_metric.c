@@ -0,0 +1,10 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+#include "fd_metrics_metric.h"
+
+const fd_metrics_meta_t FD_METRICS_METRIC[FD_METRICS_METRIC_TOTAL] = {
+    DECLARE_METRIC_COUNTER( METRIC_TILE, SCRAPE_COUNT ),
+    DECLARE_METRIC_COUNTER( METRIC_TILE, RENDER_SKIPPED_COUNT ),
+    DECLARE_METRIC_COUNTER( METRIC_TILE, SCRAPE_TIMEOUT_COUNT ),
+    DECLARE_METRIC_HISTOGRAM_SECONDS( METRIC_TILE, RENDER_DURATION_SECONDS ),
+    DECLARE_METRIC_HISTOGRAM_NONE( METRIC_TILE, RENDER_SIZE_BYTES ),
+};
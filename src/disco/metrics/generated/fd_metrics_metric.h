@@ -0,0 +1,38 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+
+#include "../fd_metrics_base.h"
+
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_COUNT_OFF  (174UL)
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_COUNT_NAME "metric_tile_scrape_count"
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_COUNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_COUNT_DESC "Number of requests for the Prometheus metrics endpoint that were served"
+
+#define FD_METRICS_COUNTER_METRIC_TILE_RENDER_SKIPPED_COUNT_OFF  (175UL)
+#define FD_METRICS_COUNTER_METRIC_TILE_RENDER_SKIPPED_COUNT_NAME "metric_tile_render_skipped_count"
+#define FD_METRICS_COUNTER_METRIC_TILE_RENDER_SKIPPED_COUNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_METRIC_TILE_RENDER_SKIPPED_COUNT_DESC "Number of times a refresh of the cached Prometheus exposition was delayed because a slow scraper was still reading the prior one"
+
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_TIMEOUT_COUNT_OFF  (176UL)
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_TIMEOUT_COUNT_NAME "metric_tile_scrape_timeout_count"
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_TIMEOUT_COUNT_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_METRIC_TILE_SCRAPE_TIMEOUT_COUNT_DESC "Number of connections to the Prometheus metrics endpoint that were closed because they were still open after five seconds"
+
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_OFF  (177UL)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_NAME "metric_tile_render_duration_seconds"
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_DESC "Duration of rendering the Prometheus exposition for all tiles into the cache"
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_MIN  (1e-05)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_MAX  (0.1)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_DURATION_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_OFF  (194UL)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_NAME "metric_tile_render_size_bytes"
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_DESC "Size of the rendered Prometheus exposition, which is the response body for each scrape"
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_MIN  (4096UL)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_MAX  (16777216UL)
+#define FD_METRICS_HISTOGRAM_METRIC_TILE_RENDER_SIZE_BYTES_CVT  (FD_METRICS_CONVERTER_NONE)
+
+
+#define FD_METRICS_METRIC_TOTAL (5UL)
+extern const fd_metrics_meta_t FD_METRICS_METRIC[FD_METRICS_METRIC_TOTAL];
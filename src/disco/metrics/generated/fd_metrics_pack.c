@@ -8,6 +8,7 @@ const fd_metrics_meta_t FD_METRICS_PACK[FD_METRICS_PACK_TOTAL] = {
     DECLARE_METRIC_HISTOGRAM_NONE( PACK, VOTES_PER_MICROBLOCK_COUNT ),
     DECLARE_METRIC_COUNTER( PACK, GOSSIPED_VOTES_RECEIVED ),
     DECLARE_METRIC_COUNTER( PACK, NORMAL_TRANSACTION_RECEIVED ),
+    DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_FEE_PAYER_CAP ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_FULL ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_WRITE_SYSVAR ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_INSERTED_ESTIMATION_FAIL ),
@@ -51,6 +52,13 @@ const fd_metrics_meta_t FD_METRICS_PACK[FD_METRICS_PACK_TOTAL] = {
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_SCHEDULE_BYTE_LIMIT ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_SCHEDULE_WRITE_COST ),
     DECLARE_METRIC_COUNTER( PACK, TRANSACTION_SCHEDULE_SLOW_PATH ),
+    DECLARE_METRIC_COUNTER( PACK, TRANSACTION_SCHEDULE_CHAIN ),
+    DECLARE_METRIC_COUNTER( PACK, BANK_CONFLICT_IDLE_NANOS ),
     DECLARE_METRIC_COUNTER( PACK, DELETE_MISSED ),
     DECLARE_METRIC_COUNTER( PACK, DELETE_HIT ),
+    DECLARE_METRIC_HISTOGRAM_NONE( PACK, CU_ESTIMATION_ERROR ),
+    DECLARE_METRIC_HISTOGRAM_NONE( PACK, BLOCK_COST ),
+    DECLARE_METRIC_HISTOGRAM_NONE( PACK, ADMITTED_FEE_PER_CU ),
+    DECLARE_METRIC_HISTOGRAM_NONE( PACK, EVICTED_FEE_PER_CU ),
+    DECLARE_METRIC_COUNTER( PACK, CUS_REBATED ),
 };
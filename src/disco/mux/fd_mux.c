@@ -142,6 +142,9 @@ fd_mux_tile( fd_cnc_t *              cnc,
   fd_histf_t hist_fin_ticks[1];
   fd_histf_t hist_fin_frag_sz[1];
 
+  /* flight recorder state */
+  fd_trace_t * trace; /* trace to record sampled frags to, NULL if this tile is not tracing */
+
   do {
 
     FD_LOG_INFO(( "Booting mux (in-cnt %lu, out-cnt %lu)", in_cnt, out_cnt ));
@@ -378,6 +381,11 @@ fd_mux_tile( fd_cnc_t *              cnc,
     fd_histf_join( fd_histf_new( hist_fin_ticks,          FD_MHIST_SECONDS_MIN( STEM, LOOP_FINISH_DURATION_SECONDS),                 FD_MHIST_SECONDS_MAX( STEM, LOOP_FINISH_DURATION_SECONDS ) ) );
     fd_histf_join( fd_histf_new( hist_fin_frag_sz,        FD_MHIST_MIN( STEM, FRAGMENT_HANDLED_SIZE_BYTES),                          FD_MHIST_MAX( STEM, FRAGMENT_HANDLED_SIZE_BYTES ) ) );
 
+    /* flight recorder init */
+
+    trace = fd_trace_tl;
+    if( FD_UNLIKELY( trace ) ) FD_LOG_INFO(( "Tracing one in %lu frags", trace->sample_rate ));
+
   } while(0);
 
   FD_LOG_INFO(( "Running mux" ));
@@ -630,6 +638,7 @@ fd_mux_tile( fd_cnc_t *              cnc,
     ulong sz       = (ulong)this_in_mline->sz;
     ulong ctl      = (ulong)this_in_mline->ctl;
     ulong tsorig   = (ulong)this_in_mline->tsorig;
+    ulong tspub_in = (ulong)this_in_mline->tspub;
     FD_COMPILER_MFENCE();
     ulong seq_test =        this_in_mline->seq;
     FD_COMPILER_MFENCE();
@@ -647,6 +656,7 @@ fd_mux_tile( fd_cnc_t *              cnc,
       continue;
     }
 
+    ulong in_sig = sig;
     ulong out_sz = sz;
     ulong out_tsorig = tsorig;
     if( FD_LIKELY( !filter ) ) {
@@ -657,6 +667,11 @@ fd_mux_tile( fd_cnc_t *              cnc,
     }
 
     long next = fd_tickcount();
+    if( FD_UNLIKELY( trace && fd_trace_sampled( trace, tsorig ) ) ) {
+      fd_trace_write( trace, now, next-now, tsorig, tspub_in, sz, (ulong)this_in->idx,
+                      fd_int_if( filter, FD_TRACE_EVENT_FILTER, FD_TRACE_EVENT_PUBLISH ), in_sig );
+    }
+
     if( FD_UNLIKELY( filter ) ) {
       /* If there are any frags from this in that are currently exposed
          downstream, this frag needs to be taken into account in the flow
@@ -11,6 +11,7 @@
 #include "../fd_disco_base.h"
 
 #include "../metrics/fd_metrics.h"
+#include "../trace/fd_trace.h"
 
 /* Beyond the standard FD_CNC_SIGNAL_HALT, FD_MUX_CNC_SIGNAL_ACK can be
    raised by a cnc thread with an open command session while the mux is
@@ -233,7 +233,10 @@ fd_tpu_reasm_append( fd_tpu_reasm_t *      reasm,
 /* fd_tpu_reasm_publish completes a stream reassembly and publishes the
    message to an mcache for downstream consumption.  base is the address
    of the chunk whose index is 0 (chunk0 param of fd_chunk_to_laddr).
-   {seq,sig,tspub} are mcache frag params.  If slot does not have active
+   {seq,tspub} are mcache frag params.  The frag sig is set to the first
+   8 bytes of the first transaction signature in the message (zero if
+   the message does not start with one), so that consumers can shard
+   transactions without reading the payload.  If slot does not have active
    reassembly or txn parsing failed, returns NULL.  If base is not valid
    for tpu_reasm, aborts.  Final msg sz in [0,mtu+FD_CHUNK_SZ). */
 
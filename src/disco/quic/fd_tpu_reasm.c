@@ -228,9 +228,18 @@ fd_tpu_reasm_publish( fd_tpu_reasm_t *      reasm,
   ulong ctl    = fd_frag_meta_ctl( reasm->orig, 1, 1, 0 );
   ulong tsorig = slot->tsorig;
 
+  /* The sig is the first 8 bytes of the first signature, which is also
+     what verify passes on as the transaction tag.  If the signature
+     count is not a single byte compact-u16 in [1,127] the txn will not
+     parse anyway, so the sig is just zero. */
+  ulong sig = 0UL;
+  if( FD_LIKELY( ( sz>=1UL+FD_TXN_SIGNATURE_SZ ) &
+                 ( data[ 0 ]>0 ) & ( data[ 0 ]<0x80 ) ) ) sig = FD_LOAD( ulong, data+1UL );
+
   FD_COMPILER_MFENCE();
   meta->seq    = fd_seq_dec( seq, 1UL );
   FD_COMPILER_MFENCE();
+  meta->sig    = sig;
   meta->chunk  = (uint  )chunk;
   meta->sz     = (ushort)sz;
   meta->ctl    = (ushort)ctl;
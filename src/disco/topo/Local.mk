@@ -1,2 +1,2 @@
-$(call add-hdrs,fd_topo.h fd_pod_format.h)
-$(call add-objs,fd_topo fd_topob fd_topo_run,fd_disco)
+$(call add-hdrs,fd_topo.h fd_cpu_topo.h fd_pod_format.h)
+$(call add-objs,fd_topo fd_topob fd_topo_run fd_cpu_topo,fd_disco)
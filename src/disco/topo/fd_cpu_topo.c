@@ -0,0 +1,120 @@
+#include "fd_cpu_topo.h"
+
+#include "../../util/tile/fd_tile_private.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* read_cpu_list reads a sysfs CPU list like "0-3,8-11" from path into
+   cpus.  Returns the number of CPUs in the list, or 0 if the file does
+   not exist. */
+
+static ulong
+read_cpu_list( char const * path,
+               ushort *     cpus ) {
+  int fd = open( path, O_RDONLY );
+  if( FD_UNLIKELY( -1==fd ) ) {
+    if( FD_LIKELY( errno==ENOENT ) ) return 0UL;
+    FD_LOG_ERR(( "open( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  }
+
+  char buf[ 4096 ];
+  long sz = read( fd, buf, sizeof(buf)-1UL );
+  if( FD_UNLIKELY( -1L==sz ) ) FD_LOG_ERR(( "read( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( (ulong)sz==sizeof(buf)-1UL ) ) FD_LOG_ERR(( "CPU list in \"%s\" is too long", path ));
+  if( FD_UNLIKELY( -1==close( fd ) ) ) FD_LOG_ERR(( "close( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+
+  buf[ sz ] = '\0';
+  return fd_tile_private_cpus_parse( buf, cpus );
+}
+
+/* read_ulong reads a single decimal value from a sysfs file at path.
+   Returns ULONG_MAX if the file does not exist. */
+
+static ulong
+read_ulong( char const * path ) {
+  int fd = open( path, O_RDONLY );
+  if( FD_UNLIKELY( -1==fd ) ) {
+    if( FD_LIKELY( errno==ENOENT ) ) return ULONG_MAX;
+    FD_LOG_ERR(( "open( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  }
+
+  char buf[ 32 ];
+  long sz = read( fd, buf, sizeof(buf)-1UL );
+  if( FD_UNLIKELY( -1L==sz ) ) FD_LOG_ERR(( "read( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( -1==close( fd ) ) ) FD_LOG_ERR(( "close( \"%s\" ) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+
+  buf[ sz ] = '\0';
+  return fd_cstr_to_ulong( buf );
+}
+
+/* l3_id returns the smallest logical CPU sharing the L3 cache with
+   cpu_idx, or ULONG_MAX if sysfs does not describe an L3 cache for
+   it. */
+
+static ulong
+l3_id( ulong cpu_idx ) {
+  for( ulong i=0UL; i<16UL; i++ ) {
+    char path[ PATH_MAX ];
+    FD_TEST( fd_cstr_printf_check( path, sizeof(path), NULL, "/sys/devices/system/cpu/cpu%lu/cache/index%lu/level", cpu_idx, i ) );
+    ulong level = read_ulong( path );
+    if( FD_UNLIKELY( level==ULONG_MAX ) ) break;
+    if( FD_LIKELY( level!=3UL ) ) continue;
+
+    ushort shared[ FD_TILE_MAX ];
+    FD_TEST( fd_cstr_printf_check( path, sizeof(path), NULL, "/sys/devices/system/cpu/cpu%lu/cache/index%lu/shared_cpu_list", cpu_idx, i ) );
+    ulong shared_cnt = read_cpu_list( path, shared );
+    if( FD_UNLIKELY( !shared_cnt ) ) break;
+
+    ulong min = ULONG_MAX;
+    for( ulong j=0UL; j<shared_cnt; j++ ) min = fd_ulong_min( min, (ulong)shared[ j ] );
+    return min;
+  }
+  return ULONG_MAX;
+}
+
+void
+fd_topo_cpus_init( fd_topo_cpus_t * cpus ) {
+  cpus->numa_node_cnt = fd_shmem_numa_cnt();
+  cpus->cpu_cnt       = fd_shmem_cpu_cnt();
+  cpus->has_smt       = 0;
+
+  ushort online[ FD_TILE_MAX ];
+  ulong online_cnt = read_cpu_list( "/sys/devices/system/cpu/online", online );
+  if( FD_UNLIKELY( !online_cnt ) ) FD_LOG_ERR(( "no online CPUs found in /sys/devices/system/cpu/online" ));
+
+  FD_CPUSET_DECL( online_set );
+  for( ulong i=0UL; i<online_cnt; i++ ) fd_cpuset_insert( online_set, online[ i ] );
+
+  FD_CPUSET_DECL( affinity );
+  if( FD_UNLIKELY( fd_cpuset_getaffinity( 0UL, affinity ) ) )
+    FD_LOG_ERR(( "sched_getaffinity failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  for( ulong i=0UL; i<cpus->cpu_cnt; i++ ) {
+    fd_topo_cpu_t * cpu = &cpus->cpu[ i ];
+    cpu->idx       = i;
+    cpu->online    = fd_cpuset_test( online_set, i ) && fd_cpuset_test( affinity, i );
+    cpu->numa_node = fd_shmem_numa_idx( i );
+    cpu->core_id   = i;
+    cpu->sibling   = ULONG_MAX;
+    cpu->l3_id     = ULONG_MAX;
+    if( FD_UNLIKELY( !fd_cpuset_test( online_set, i ) ) ) continue;
+
+    char   path[ PATH_MAX ];
+    ushort siblings[ FD_TILE_MAX ];
+    FD_TEST( fd_cstr_printf_check( path, sizeof(path), NULL, "/sys/devices/system/cpu/cpu%lu/topology/thread_siblings_list", i ) );
+    ulong sibling_cnt = read_cpu_list( path, siblings );
+    for( ulong j=0UL; j<sibling_cnt; j++ ) {
+      cpu->core_id = fd_ulong_min( cpu->core_id, (ulong)siblings[ j ] );
+      if( FD_LIKELY( siblings[ j ]!=i && cpu->sibling==ULONG_MAX ) ) cpu->sibling = (ulong)siblings[ j ];
+    }
+    cpus->has_smt |= cpu->sibling!=ULONG_MAX;
+
+    cpu->l3_id = l3_id( i );
+    /* Without an L3 in sysfs (eg. some virtual machines), assume the
+       NUMA node is the cache domain.  Offset so these can't collide
+       with a CPU index. */
+    if( FD_UNLIKELY( cpu->l3_id==ULONG_MAX ) ) cpu->l3_id = FD_SHMEM_CPU_MAX + cpu->numa_node;
+  }
+}
@@ -0,0 +1,41 @@
+#ifndef HEADER_fd_src_disco_topo_fd_cpu_topo_h
+#define HEADER_fd_src_disco_topo_fd_cpu_topo_h
+
+/* fd_cpu_topo describes the logical CPUs of the machine, which of them
+   are hyperthreads of the same physical core, which share an L3 cache,
+   and which NUMA node they are on.  It is used to place tiles
+   automatically, see fd_topob_auto_layout. */
+
+#include "../../util/fd_util.h"
+
+typedef struct {
+  ulong idx;       /* The logical CPU index */
+  int   online;    /* If the CPU is online and in the affinity mask the process was started with */
+  ulong numa_node; /* The NUMA node the CPU is on */
+  ulong core_id;   /* The smallest logical CPU index on the same physical core.  Hyperthread siblings share a core_id. */
+  ulong sibling;   /* Another logical CPU on the same physical core, or ULONG_MAX if the core is not hyperthreaded */
+  ulong l3_id;     /* The smallest logical CPU index sharing the L3 cache.  If the L3 is not described by sysfs, CPUs on the same NUMA node are assumed to share one. */
+} fd_topo_cpu_t;
+
+typedef struct {
+  ulong numa_node_cnt;
+  ulong cpu_cnt;
+  int   has_smt;   /* If any physical core has more than one logical CPU */
+
+  fd_topo_cpu_t cpu[ FD_SHMEM_CPU_MAX ];
+} fd_topo_cpus_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_topo_cpus_init fills cpus with the topology of the machine, read
+   from sysfs.  Only CPUs in the affinity mask of the calling thread
+   are marked online, so it should be called before the thread is
+   pinned.  Logs an error and terminates the process if sysfs cannot
+   be read. */
+
+void
+fd_topo_cpus_init( fd_topo_cpus_t * cpus );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_disco_topo_fd_cpu_topo_h */
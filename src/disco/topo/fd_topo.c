@@ -167,6 +167,16 @@ fd_topo_workspace_fill( fd_topo_t *      topo,
       FD_TEST( tile->metrics );
     }
 
+    if( FD_LIKELY( topo->objs[ tile->trace_obj_id ].wksp_id==wksp->id ) ) {
+      tile->trace = fd_trace_join( fd_topo_obj_laddr( topo, tile->trace_obj_id ) );
+      FD_TEST( tile->trace );
+    }
+
+    if( FD_LIKELY( topo->objs[ tile->log_obj_id ].wksp_id==wksp->id ) ) {
+      tile->log_async = fd_log_async_join( fd_topo_obj_laddr( topo, tile->log_obj_id ) );
+      FD_TEST( tile->log_async );
+    }
+
     if( FD_LIKELY( topo->objs[ tile->cnc_obj_id ].wksp_id==wksp->id ) ) {
       tile->cnc = fd_cnc_join( fd_topo_obj_laddr( topo, tile->cnc_obj_id ) );
       FD_TEST( tile->cnc );
@@ -109,6 +109,8 @@ typedef struct {
   ulong tile_obj_id;
   ulong cnc_obj_id;
   ulong metrics_obj_id;
+  ulong trace_obj_id;
+  ulong log_obj_id;
   ulong in_link_fseq_obj_id[ FD_TOPO_MAX_TILE_IN_LINKS ];
 
   ulong uses_obj_cnt;
@@ -119,6 +121,8 @@ typedef struct {
   struct {
     fd_cnc_t * cnc;
     ulong *    metrics; /* The shared memory for metrics that this tile should write.  Consumer by monitoring and metrics writing tiles. */
+    fd_trace_t * trace;   /* The flight recorder that this tile should write sampled frag records to.  Consumed by fddev trace. */
+    fd_log_async_t * log_async; /* The ring this tile defers low priority log messages to, if enabled.  Drained by the metric tile. */
 
     /* The fseq of each link that this tile reads from.  Multiple fseqs
        may point to the link, if there are multiple consumers.  An fseq
@@ -166,12 +170,14 @@ typedef struct {
     } quic;
 
     struct {
-      ulong tcache_depth;
+      ulong sigcache_depth;
     } dedup;
 
     struct {
       ulong max_pending_transactions;
       ulong bank_tile_count;
+      ulong schedule_lookahead;
+      ulong max_pending_per_fee_payer;
       int   larger_max_cost_per_block;
       int   larger_shred_limits_per_block;
       char  identity_key_path[ PATH_MAX ];
@@ -111,6 +111,10 @@ fd_topo_run_tile( fd_topo_t *          topo,
   FD_TEST( tile->cnc );
   FD_TEST( tile->metrics );
   fd_metrics_register( tile->metrics );
+  FD_TEST( tile->trace );
+  fd_trace_register( tile->trace );
+  FD_TEST( tile->log_async );
+  fd_log_async_register( tile->log_async );
 
   FD_MGAUGE_SET( TILE, PID, pid );
   FD_MGAUGE_SET( TILE, TID, tid );
@@ -183,6 +183,18 @@ fd_topob_tile( fd_topo_t *    topo,
   FD_TEST( fd_pod_insertf_ulong( topo->props, 0UL, "obj.%lu.in_cnt",  obj->id ) );
   FD_TEST( fd_pod_insertf_ulong( topo->props, 0UL, "obj.%lu.out_cnt", obj->id ) );
 
+  obj = fd_topob_obj( topo, "trace", metrics_wksp );
+  tile->trace_obj_id = obj->id;
+  fd_topob_tile_uses( topo, tile, obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, FD_TRACE_DEPTH_DEFAULT, "obj.%lu.depth",       obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, 0UL,                    "obj.%lu.sample_rate", obj->id ) );
+
+  obj = fd_topob_obj( topo, "log", metrics_wksp );
+  tile->log_obj_id = obj->id;
+  fd_topob_tile_uses( topo, tile, obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, FD_LOG_ASYNC_DEPTH_DEFAULT, "obj.%lu.depth",   obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, 0UL,                        "obj.%lu.enabled", obj->id ) );
+
   if( FD_LIKELY( out_link ) ) {
     fd_topo_link_t * link = &topo->links[ tile->out_link_id_primary ];
     fd_topob_tile_uses( topo, tile, &topo->objs[ link->mcache_obj_id ], FD_SHMEM_JOIN_MODE_READ_WRITE );
@@ -241,7 +253,10 @@ fd_topob_tile_in( fd_topo_t *  topo,
     ulong producer_idx = fd_topo_find_link_producer( topo, link );
     if( FD_UNLIKELY( producer_idx!=ULONG_MAX ) ) {
       fd_topo_tile_t * producer = &topo->tiles[ producer_idx ];
-      if( FD_UNLIKELY( producer->out_link_id_primary!=link_id ) ) FD_LOG_ERR(( "reliable link is not produced by a primary out: %s:%lu %lu", link_name, link_kind_id, producer->out_link_id_primary ));
+      /* The mux only flow controls the reliable consumers of the primary
+         out.  A producer with reliable consumers of other outs has to
+         receive their credits itself, and they have no out metrics. */
+      if( FD_UNLIKELY( producer->out_link_id_primary!=link_id ) ) return;
 
       ulong out_cnt = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "obj.%lu.out_cnt", producer->metrics_obj_id );
       FD_TEST( out_cnt!=ULONG_MAX );
@@ -408,6 +423,105 @@ validate( fd_topo_t const * topo ) {
   }
 }
 
+/* tiles_communicate returns 1 if tile a produces a link that tile b
+   consumes, and 0 otherwise. */
+
+static int
+tiles_communicate( fd_topo_tile_t const * a,
+                   fd_topo_tile_t const * b ) {
+  for( ulong i=0UL; i<b->in_cnt; i++ ) {
+    if( FD_UNLIKELY( b->in_link_id[ i ]==a->out_link_id_primary ) ) return 1;
+    for( ulong j=0UL; j<a->out_cnt; j++ ) {
+      if( FD_UNLIKELY( b->in_link_id[ i ]==a->out_link_id[ j ] ) ) return 1;
+    }
+  }
+  return 0;
+}
+
+/* cpu_before returns 1 if CPU a should be assigned a tile before CPU
+   b, ordering by NUMA node, then L3 cache, then index. */
+
+static int
+cpu_before( fd_topo_cpu_t const * a,
+            fd_topo_cpu_t const * b ) {
+  if( a->numa_node!=b->numa_node ) return a->numa_node<b->numa_node;
+  if( a->l3_id    !=b->l3_id     ) return a->l3_id<b->l3_id;
+  return a->idx<b->idx;
+}
+
+void
+fd_topob_auto_layout( fd_topo_t *            topo,
+                      fd_topo_cpus_t const * cpus ) {
+  /* Order tiles breadth first along their links.  Tiles not reachable
+     from the first tile start a new search, in tile order. */
+
+  ulong order[ FD_TOPO_MAX_TILES ];
+  uchar visited[ FD_TOPO_MAX_TILES ] = {0};
+  ulong order_cnt = 0UL;
+  for( ulong root=0UL; root<topo->tile_cnt; root++ ) {
+    if( FD_LIKELY( visited[ root ] ) ) continue;
+    visited[ root ] = 1;
+    order[ order_cnt++ ] = root;
+    for( ulong head=order_cnt-1UL; head<order_cnt; head++ ) {
+      fd_topo_tile_t const * tile = &topo->tiles[ order[ head ] ];
+      for( ulong j=0UL; j<topo->tile_cnt; j++ ) {
+        if( FD_LIKELY( visited[ j ] ) ) continue;
+        if( FD_UNLIKELY( tiles_communicate( tile, &topo->tiles[ j ] ) || tiles_communicate( &topo->tiles[ j ], tile ) ) ) {
+          visited[ j ] = 1;
+          order[ order_cnt++ ] = j;
+        }
+      }
+    }
+  }
+
+  /* Find one online CPU per physical core, sorted.  If the lower
+     numbered sibling of a core is not online, the other is used. */
+
+  ulong cores[ FD_SHMEM_CPU_MAX ];
+  ulong core_cnt = 0UL;
+  ulong reserved = ULONG_MAX;
+  for( ulong i=0UL; i<cpus->cpu_cnt; i++ ) {
+    fd_topo_cpu_t const * cpu = &cpus->cpu[ i ];
+    if( FD_UNLIKELY( !cpu->online ) ) continue;
+    if( FD_UNLIKELY( cpu->sibling<i && cpus->cpu[ cpu->sibling ].online ) ) continue;
+    if( FD_UNLIKELY( cpu->core_id==cpus->cpu[ 0 ].core_id ) ) {
+      reserved = i;
+      continue;
+    }
+
+    ulong j = core_cnt++;
+    for( ; j>0UL && cpu_before( cpu, &cpus->cpu[ cores[ j-1UL ] ] ); j-- ) cores[ j ] = cores[ j-1UL ];
+    cores[ j ] = i;
+  }
+  if( FD_UNLIKELY( core_cnt<topo->tile_cnt && reserved!=ULONG_MAX ) ) cores[ core_cnt++ ] = reserved;
+
+  /* If there are not enough cores, put the remaining tiles on the
+     siblings of used cores, in the same order. */
+
+  ulong cpu_cnt = core_cnt;
+  for( ulong i=0UL; i<core_cnt && cpu_cnt<topo->tile_cnt; i++ ) {
+    ulong sibling = cpus->cpu[ cores[ i ] ].sibling;
+    if( FD_LIKELY( sibling!=ULONG_MAX && cpus->cpu[ sibling ].online ) ) cores[ cpu_cnt++ ] = sibling;
+  }
+
+  if( FD_UNLIKELY( cpu_cnt<topo->tile_cnt ) )
+    FD_LOG_ERR(( "The topology you are using has %lu tiles, but only %lu CPUs are online and available to Firedancer, so the "
+                 "tiles cannot be placed automatically with [layout.affinity] set to \"auto\". You should decrease the number of "
+                 "tiles by decreasing individual tile counts in the [layout] section of the configuration file.",
+                 topo->tile_cnt, cpu_cnt ));
+  if( FD_UNLIKELY( core_cnt<topo->tile_cnt ) )
+    FD_LOG_WARNING(( "The topology you are using has %lu tiles, but only %lu physical cores are available, so some tiles will "
+                     "share a core with another tile on its hyperthread sibling. This may degrade performance.",
+                     topo->tile_cnt, core_cnt ));
+
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t *      tile = &topo->tiles[ order[ i ] ];
+    fd_topo_cpu_t const * cpu  = &cpus->cpu[ cores[ i ] ];
+    tile->cpu_idx = cpu->idx;
+    FD_LOG_INFO(( "placing tile %s:%lu on cpu %lu (numa node %lu)", tile->name, tile->kind_id, cpu->idx, cpu->numa_node ));
+  }
+}
+
 void
 fd_topob_finish( fd_topo_t * topo,
                  ulong (* align    )( fd_topo_t const * topo, fd_topo_obj_t const * obj ),
@@ -5,6 +5,7 @@
    functions for creating a useful topology. */
 
 #include "../../disco/topo/fd_topo.h"
+#include "../../disco/topo/fd_cpu_topo.h"
 
 /* A link in the topology is either unpolled or polled.  Almost all
    links are polled, which means a tile which has this link as an in
@@ -154,6 +155,25 @@ fd_topob_tile_out( fd_topo_t *  topo,
                    char const * link_name,
                    ulong        link_kind_id );
 
+/* Automatically pin every tile in the topology to a CPU, replacing
+   whatever cpu_idx the tiles were created with.  Must be called after
+   all tiles and their in and out links have been added.
+
+   Tiles are ordered breadth first along the links between them, so
+   that a tile is placed next to the tiles it communicates with, and
+   are then assigned physical cores in order of NUMA node, then L3
+   cache, then CPU index.  Consecutive tiles in the ordering will share
+   an L3 cache where possible.  Each tile gets its own physical core
+   and the hyperthread sibling of that core is left idle, unless there
+   are not enough physical cores, in which case siblings are used and
+   a warning is logged.  The core of CPU 0 is kept free for the
+   operating system if possible.  Logs an error and terminates the
+   process if there are not enough online CPUs for every tile. */
+
+void
+fd_topob_auto_layout( fd_topo_t *            topo,
+                      fd_topo_cpus_t const * cpus );
+
 /* Finish creating the topology.  Lays out all the objects in the
    given workspaces, and sizes everything correctly.  Also validates
    the topology before returning.
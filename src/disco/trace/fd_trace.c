@@ -0,0 +1,137 @@
+#include "fd_trace.h"
+
+FD_TL fd_trace_t * fd_trace_tl;
+
+void *
+fd_trace_new( void * shmem,
+              ulong  depth,
+              ulong  sample_rate ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_trace_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_trace_footprint( depth ) ) ) {
+    FD_LOG_WARNING(( "bad depth (%lu)", depth ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( sample_rate && !fd_ulong_is_pow2( sample_rate ) ) ) {
+    FD_LOG_WARNING(( "bad sample_rate (%lu)", sample_rate ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, fd_trace_footprint( depth ) );
+
+  fd_trace_t * trace = (fd_trace_t *)shmem;
+  trace->depth       = depth;
+  trace->sample_rate = sample_rate;
+  trace->seq         = 0UL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trace->magic ) = FD_TRACE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_trace_t *
+fd_trace_join( void * shtrace ) {
+
+  if( FD_UNLIKELY( !shtrace ) ) {
+    FD_LOG_WARNING(( "NULL shtrace" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shtrace, fd_trace_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shtrace" ));
+    return NULL;
+  }
+
+  fd_trace_t * trace = (fd_trace_t *)shtrace;
+  if( FD_UNLIKELY( trace->magic!=FD_TRACE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return trace;
+}
+
+void *
+fd_trace_leave( fd_trace_t * trace ) {
+
+  if( FD_UNLIKELY( !trace ) ) {
+    FD_LOG_WARNING(( "NULL trace" ));
+    return NULL;
+  }
+
+  return (void *)trace;
+}
+
+void *
+fd_trace_delete( void * shtrace ) {
+
+  if( FD_UNLIKELY( !shtrace ) ) {
+    FD_LOG_WARNING(( "NULL shtrace" ));
+    return NULL;
+  }
+
+  fd_trace_t * trace = (fd_trace_t *)shtrace;
+  if( FD_UNLIKELY( trace->magic!=FD_TRACE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trace->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shtrace;
+}
+
+ulong
+fd_trace_snapshot( fd_trace_t const * trace,
+                   ulong *            _seq,
+                   fd_trace_rec_t *   out,
+                   ulong              out_max,
+                   ulong *            _lost ) {
+  ulong                  depth = trace->depth;
+  fd_trace_rec_t const * ring  = fd_trace_ring_const( trace );
+
+  ulong lost  = 0UL;
+  ulong start = *_seq;
+  ulong seq0  = FD_VOLATILE_CONST( trace->seq );
+  FD_COMPILER_MFENCE();
+
+  /* Anything more than depth behind is already gone */
+  if( FD_UNLIKELY( seq0-start>depth ) ) {
+    lost  += seq0 - depth - start;
+    start  = seq0 - depth;
+  }
+
+  ulong cnt = fd_ulong_min( seq0-start, out_max );
+  for( ulong i=0UL; i<cnt; i++ ) out[ i ] = ring[ (start+i) & (depth-1UL) ];
+
+  /* The producer might have lapped us while we were copying.  The
+     record at seq1 might also be partially written. */
+  FD_COMPILER_MFENCE();
+  ulong seq1        = FD_VOLATILE_CONST( trace->seq );
+  ulong valid_start = fd_ulong_if( seq1+1UL>depth, seq1+1UL-depth, 0UL );
+
+  ulong drop = 0UL;
+  if( FD_UNLIKELY( start<valid_start ) ) {
+    drop = fd_ulong_min( valid_start-start, cnt );
+    memmove( out, out+drop, (cnt-drop)*sizeof(fd_trace_rec_t) );
+    lost += drop;
+  }
+
+  *_seq = start + cnt;
+  if( _lost ) *_lost += lost;
+  return cnt - drop;
+}
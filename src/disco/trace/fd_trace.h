@@ -0,0 +1,167 @@
+#ifndef HEADER_fd_src_disco_trace_fd_trace_h
+#define HEADER_fd_src_disco_trace_fd_trace_h
+
+/* fd_trace is a flight recorder for the lifecycle of frags as they
+   move through the tile pipeline.  Each tile owns a trace, which is a
+   single producer ring of fixed size records in shared memory.  The mux
+   loop of the tile appends a record for a sampled subset of the frags
+   it processes, and an external observer (eg. `fddev trace`) can
+   snapshot the ring at any time without coordinating with the tile, to
+   reconstruct where frags spend their time.
+
+   Which frags are sampled is a function of the frag's tsorig only, so
+   tiles that pass tsorig through (most of the pipeline between net and
+   pack does) sample the same frags, and a sampled transaction can be
+   followed from one stage to the next.
+
+   Only frags that make it past before_frag are traced, filtering there
+   is cheap and uninteresting (eg. frags for another shard).
+
+   Records are written with plain stores and then published by bumping
+   the ring sequence number, so a reader might see a record that is
+   being overwritten.  fd_trace_snapshot handles this by discarding any
+   records that could have been overwritten while it was copying. */
+
+#include "../fd_disco_base.h"
+
+/* FD_TRACE_EVENT_* are the types of trace records */
+
+#define FD_TRACE_EVENT_PUBLISH (0) /* frag was processed and not filtered */
+#define FD_TRACE_EVENT_FILTER  (1) /* frag was filtered during or after reading it */
+
+/* FD_TRACE_DEPTH_DEFAULT is the default number of records in the trace
+   ring of each tile. */
+
+#define FD_TRACE_DEPTH_DEFAULT (8192UL)
+
+#define FD_TRACE_ALIGN (128UL)
+#define FD_TRACE_FOOTPRINT( depth ) (256UL + (depth)*sizeof(fd_trace_rec_t))
+
+#define FD_TRACE_MAGIC (0xf17eda2c37ace000UL) /* firedancer trace ver 0 */
+
+/* fd_trace_rec_t is one record in the trace.  Times are in ticks.
+   tsorig and tspub are compressed the same way as in fd_frag_meta_t and
+   can be recovered with fd_frag_meta_ts_decomp relative to ts. */
+
+struct fd_trace_rec {
+  long   ts;     /* fd_tickcount() when the tile started processing the frag */
+  uint   dur;    /* ticks spent processing the frag, saturated at UINT_MAX */
+  uint   tsorig; /* tsorig of the frag as received */
+  uint   tspub;  /* tspub of the frag as received, when the producer published it */
+  ushort sz;     /* sz of the frag as received */
+  uchar  in_idx; /* index of the tile's in link the frag was received on */
+  uchar  event;  /* one of FD_TRACE_EVENT_* */
+  ulong  sig;    /* sig of the frag as received */
+};
+
+typedef struct fd_trace_rec fd_trace_rec_t;
+
+struct __attribute__((aligned(FD_TRACE_ALIGN))) fd_trace_private {
+  ulong magic;       /* ==FD_TRACE_MAGIC */
+  ulong depth;       /* number of records in the ring, a power of 2 */
+  ulong sample_rate; /* one in sample_rate frags is traced, a power of 2, or 0 if tracing is disabled */
+
+  /* Written frequently by the producer, so on its own cache line */
+  __attribute__((aligned(128UL))) ulong seq; /* number of records ever written */
+
+  /* depth fd_trace_rec_t follow at offset 256 */
+};
+
+typedef struct fd_trace_private fd_trace_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_trace_tl is the trace of the tile running on this thread, or NULL
+   if this thread is not tracing.  Set by fd_trace_register. */
+
+extern FD_TL fd_trace_t * fd_trace_tl;
+
+FD_FN_CONST static inline ulong fd_trace_align    ( void        ) { return FD_TRACE_ALIGN; }
+FD_FN_CONST static inline ulong fd_trace_footprint( ulong depth ) { return fd_ulong_is_pow2( depth ) ? FD_TRACE_FOOTPRINT( depth ) : 0UL; }
+
+/* fd_trace_new formats shmem as a trace with depth records which traces
+   one in every sample_rate frags.  depth must be a power of 2 and
+   sample_rate must be zero (tracing disabled) or a power of 2.  Returns
+   shmem on success and NULL on failure (logs details). */
+
+void *
+fd_trace_new( void * shmem,
+              ulong  depth,
+              ulong  sample_rate );
+
+fd_trace_t * fd_trace_join  ( void *       shtrace );
+void *       fd_trace_leave ( fd_trace_t * trace   );
+void *       fd_trace_delete( void *       shtrace );
+
+FD_FN_CONST static inline fd_trace_rec_t *
+fd_trace_ring( fd_trace_t * trace ) {
+  return (fd_trace_rec_t *)((ulong)trace + 256UL);
+}
+
+FD_FN_CONST static inline fd_trace_rec_t const *
+fd_trace_ring_const( fd_trace_t const * trace ) {
+  return (fd_trace_rec_t const *)((ulong)trace + 256UL);
+}
+
+/* fd_trace_register sets the trace of the calling thread.  If tracing
+   is disabled in the trace, the thread is set to not trace. */
+
+static inline void
+fd_trace_register( fd_trace_t * trace ) {
+  fd_trace_tl = (trace && trace->sample_rate) ? trace : NULL;
+}
+
+/* fd_trace_sampled returns 1 if the frag with the given tsorig should
+   be traced and 0 otherwise.  Assumes trace is a registered trace. */
+
+FD_FN_PURE static inline int
+fd_trace_sampled( fd_trace_t const * trace,
+                  ulong              tsorig ) {
+  return !(fd_ulong_hash( tsorig ^ 0x5bd1e995UL ) & (trace->sample_rate-1UL));
+}
+
+/* fd_trace_write appends a record to the trace.  Only the tile owning
+   the trace may call this. */
+
+static inline void
+fd_trace_write( fd_trace_t * trace,
+                long         ts,
+                long         dur,
+                ulong        tsorig,
+                ulong        tspub,
+                ulong        sz,
+                ulong        in_idx,
+                int          event,
+                ulong        sig ) {
+  ulong seq = trace->seq;
+  fd_trace_rec_t * rec = fd_trace_ring( trace ) + (seq & (trace->depth-1UL));
+  rec->ts     = ts;
+  rec->dur    = (uint)fd_ulong_min( (ulong)fd_long_max( dur, 0L ), (ulong)UINT_MAX );
+  rec->tsorig = (uint)tsorig;
+  rec->tspub  = (uint)tspub;
+  rec->sz     = (ushort)fd_ulong_min( sz, USHORT_MAX );
+  rec->in_idx = (uchar)in_idx;
+  rec->event  = (uchar)event;
+  rec->sig    = sig;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trace->seq ) = seq+1UL;
+}
+
+/* fd_trace_snapshot copies the records of trace written at or after
+   sequence number *_seq into out, which has room for out_max records,
+   oldest first.  Records that have been overwritten in the ring are
+   skipped.  On return, *_seq is updated to the sequence number to pass
+   to the next call to pick up where this one left off, and the return
+   value is the number of records copied.  *_lost (if non-NULL) is
+   incremented by the number of records that were skipped. */
+
+ulong
+fd_trace_snapshot( fd_trace_t const * trace,
+                   ulong *            _seq,
+                   fd_trace_rec_t *   out,
+                   ulong              out_max,
+                   ulong *            _lost );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_disco_trace_fd_trace_h */
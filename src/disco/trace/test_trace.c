@@ -0,0 +1,97 @@
+#include "fd_trace.h"
+
+FD_STATIC_ASSERT( sizeof(fd_trace_rec_t)==32UL,                  unit_test );
+FD_STATIC_ASSERT( FD_TRACE_FOOTPRINT( 8UL )==256UL+8UL*32UL,     unit_test );
+FD_STATIC_ASSERT( offsetof(fd_trace_t, seq)==128UL,              unit_test );
+
+#define DEPTH (64UL)
+
+static uchar mem[ FD_TRACE_FOOTPRINT( DEPTH ) ] __attribute__((aligned(FD_TRACE_ALIGN)));
+
+static void
+write_n( fd_trace_t * trace,
+         ulong        seq0,
+         ulong        n ) {
+  for( ulong i=0UL; i<n; i++ ) fd_trace_write( trace, (long)(seq0+i), 1L, 2UL, 3UL, 4UL, 5UL, FD_TRACE_EVENT_PUBLISH, seq0+i );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( !fd_trace_footprint( 0UL  ) );
+  FD_TEST( !fd_trace_footprint( 3UL  ) );
+  FD_TEST(  fd_trace_footprint( DEPTH )==FD_TRACE_FOOTPRINT( DEPTH ) );
+
+  FD_TEST( !fd_trace_new( NULL,    DEPTH, 0UL ) );
+  FD_TEST( !fd_trace_new( mem+1UL, DEPTH, 0UL ) );
+  FD_TEST( !fd_trace_new( mem,     63UL,  0UL ) );
+  FD_TEST( !fd_trace_new( mem,     DEPTH, 3UL ) );
+
+  /* Tracing disabled */
+
+  fd_trace_t * trace = fd_trace_join( fd_trace_new( mem, DEPTH, 0UL ) ); FD_TEST( trace );
+  fd_trace_register( trace );
+  FD_TEST( !fd_trace_tl );
+  FD_TEST( fd_trace_delete( fd_trace_leave( trace ) )==mem );
+  FD_TEST( !fd_trace_join( mem ) );
+
+  /* Sampling */
+
+  trace = fd_trace_join( fd_trace_new( mem, DEPTH, 1UL ) ); FD_TEST( trace );
+  fd_trace_register( trace );
+  FD_TEST( fd_trace_tl==trace );
+  for( ulong i=0UL; i<1000UL; i++ ) FD_TEST( fd_trace_sampled( trace, i ) );
+  fd_trace_delete( fd_trace_leave( trace ) );
+
+  trace = fd_trace_join( fd_trace_new( mem, DEPTH, 16UL ) ); FD_TEST( trace );
+  ulong sampled = 0UL;
+  for( ulong i=0UL; i<1600000UL; i++ ) sampled += (ulong)fd_trace_sampled( trace, i );
+  FD_TEST( sampled>90000UL && sampled<110000UL );
+
+  /* Snapshot */
+
+  fd_trace_rec_t out[ 2UL*DEPTH ];
+  ulong seq  = 0UL;
+  ulong lost = 0UL;
+  FD_TEST( !fd_trace_snapshot( trace, &seq, out, 2UL*DEPTH, &lost ) );
+  FD_TEST( !seq && !lost );
+
+  write_n( trace, 0UL, 10UL );
+  FD_TEST( fd_trace_snapshot( trace, &seq, out, 2UL*DEPTH, &lost )==10UL );
+  FD_TEST( seq==10UL && !lost );
+  for( ulong i=0UL; i<10UL; i++ ) {
+    FD_TEST( out[ i ].sig==i && out[ i ].ts==(long)i );
+    FD_TEST( out[ i ].dur==1U && out[ i ].tsorig==2U && out[ i ].tspub==3U && out[ i ].sz==4U && out[ i ].in_idx==5U );
+  }
+
+  /* Limited by out_max */
+  write_n( trace, 10UL, 10UL );
+  FD_TEST( fd_trace_snapshot( trace, &seq, out, 4UL, &lost )==4UL );
+  FD_TEST( seq==14UL && out[ 0 ].sig==10UL && out[ 3 ].sig==13UL );
+  FD_TEST( fd_trace_snapshot( trace, &seq, out, 2UL*DEPTH, &lost )==6UL );
+  FD_TEST( seq==20UL && out[ 0 ].sig==14UL && !lost );
+
+  /* Lapped by the producer */
+  write_n( trace, 20UL, 3UL*DEPTH );
+  ulong cnt = fd_trace_snapshot( trace, &seq, out, 2UL*DEPTH, &lost );
+  FD_TEST( seq==20UL+3UL*DEPTH );
+  FD_TEST( cnt+lost==3UL*DEPTH );
+  FD_TEST( cnt==DEPTH-1UL ); /* The oldest record in the ring is conservatively discarded */
+  FD_TEST( out[ cnt-1UL ].sig==seq-1UL );
+  for( ulong i=1UL; i<cnt; i++ ) FD_TEST( out[ i ].sig==out[ i-1UL ].sig+1UL );
+
+  /* Saturation */
+  fd_trace_write( trace, 0L, LONG_MAX, 0UL, 0UL, ULONG_MAX, 0UL, FD_TRACE_EVENT_FILTER, 0UL );
+  fd_trace_write( trace, 0L, -1L,      0UL, 0UL, 0UL,       0UL, FD_TRACE_EVENT_FILTER, 0UL );
+  FD_TEST( fd_trace_snapshot( trace, &seq, out, 2UL*DEPTH, &lost )==2UL );
+  FD_TEST( out[ 0 ].dur==UINT_MAX && out[ 0 ].sz==USHORT_MAX && out[ 0 ].event==FD_TRACE_EVENT_FILTER );
+  FD_TEST( out[ 1 ].dur==0U );
+
+  fd_trace_delete( fd_trace_leave( trace ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -98,6 +98,9 @@
 
 #define FD_TVU_TILE_SLOT_DELAY 32
 
+/* Default size of the asynchronous capture ring (--capture-ring-sz) */
+#define FD_TVU_CAPTURE_RING_SZ_DEFAULT (64UL<<20)
+
 static int gossip_sockfd = -1;
 static int repair_clnt_sockfd = -1;
 static int repair_serv_sockfd = -1;
@@ -778,6 +781,15 @@ void fd_capture_ctx_setup( fd_capture_ctx_t ** capture_ctx_p, FILE ** capture_fi
     }
     fd_solcap_writer_init( capture_ctx->capture, capture_file );
     capture_ctx->capture_txns = args->capture_txns;
+    fd_solcap_writer_set_sample( capture_ctx->capture, args->capture_slot_stride, args->capture_accounts, args->capture_account_cnt );
+    if( args->capture_async_tile ) {
+      ulong ring_sz = args->capture_ring_sz ? args->capture_ring_sz : FD_TVU_CAPTURE_RING_SZ_DEFAULT;
+      void * ring = fd_valloc_malloc( valloc, FD_SOLCAP_WRITER_ASYNC_RING_ALIGN, ring_sz );
+      if( FD_UNLIKELY( !ring ) ) FD_LOG_ERR(( "failed to allocate %lu byte capture ring", ring_sz ));
+      if( FD_UNLIKELY( !fd_solcap_writer_async_init( capture_ctx->capture, ring, ring_sz, args->capture_async_tile ) ) ) {
+        FD_LOG_ERR(( "failed to start capture writer on tile %lu", args->capture_async_tile ));
+      }
+    }
   } else {
     capture_ctx->capture = NULL;
   }
@@ -1418,6 +1430,12 @@ fd_tvu_parse_args( fd_runtime_args_t * args, int argc, char ** argv ) {
   args->capture_fpath = fd_env_strip_cmdline_cstr( &argc, &argv, "--capture", NULL, NULL );
   /* Disabling capture_txns speeds up runtime and makes solcap captures significantly smaller */
   args->capture_txns  = fd_env_strip_cmdline_int( &argc, &argv, "--capture-txns", NULL, 0 );
+  /* Moves capture encoding and file I/O to the given tile (0 captures on the replay thread) */
+  args->capture_async_tile  = fd_env_strip_cmdline_ulong( &argc, &argv, "--capture-async", NULL, 0UL );
+  args->capture_ring_sz     = fd_env_strip_cmdline_ulong( &argc, &argv, "--capture-ring-sz", NULL, 0UL );
+  args->capture_slot_stride = fd_env_strip_cmdline_ulong( &argc, &argv, "--capture-slot-stride", NULL, 1UL );
+  args->capture_accounts    = NULL;
+  args->capture_account_cnt = 0UL;
   args->trace_fpath   = fd_env_strip_cmdline_cstr( &argc, &argv, "--trace", NULL, NULL );
   /* TODO @yunzhang: I added this to get the shred_cap file path,
    *  but shred_cap is now NULL despite there is such an entry in the toml config */
@@ -1443,6 +1461,8 @@ void
 fd_tvu_main_teardown( fd_runtime_ctx_t * tvu_args, fd_replay_t * replay ) {
   if( tvu_args->capture_file != NULL) {
     fd_solcap_writer_flush( tvu_args->capture_ctx->capture );
+    void * ring = fd_solcap_writer_async_fini( tvu_args->capture_ctx->capture );
+    if( ring ) fd_valloc_free( tvu_args->slot_ctx->valloc, ring );
     fd_valloc_free( tvu_args->slot_ctx->valloc, fd_capture_ctx_delete( tvu_args->capture_ctx ) );
     fclose( tvu_args->capture_file );
   }
@@ -51,8 +51,68 @@ struct fd_solcap_writer {
   ulong                   account_table_goff;
 
   ulong first_slot;
+
+  /* Sampling.  Only slots that are a multiple of slot_stride are
+     captured (every slot if slot_stride<=1), and if account_filter_cnt
+     is non-zero, only the accounts in account_filter are captured.
+     These are only accessed by the caller's thread. */
+
+  ulong               slot_stride;
+  fd_pubkey_t const * account_filter;
+  ulong               account_filter_cnt;
+  int                 skip_slot;
+  ulong               slot_account_cnt; /* Accounts captured in the current slot */
+
+  /* Asynchronous capture.  If async is set, the user API calls copy
+     their arguments into a single producer single consumer ring of
+     records, and a writer tile replays them against the synchronous
+     implementation below, so the encoding and file I/O are off the
+     caller's thread.  ring_head is the number of bytes ever published
+     by the caller and ring_tail the number of bytes ever consumed by
+     the writer tile. */
+
+  int              async;
+  uchar *          ring;
+  ulong            ring_sz;
+  ulong            ring_head;
+  ulong            ring_tail;
+  int              async_halt;
+  int              async_err;
+  fd_tile_exec_t * async_exec;
 };
 
+/* Async ring record types */
+
+#define FD_SOLCAP_ASYNC_REC_SLOT    (1U)
+#define FD_SOLCAP_ASYNC_REC_ACCOUNT (2U)
+#define FD_SOLCAP_ASYNC_REC_BANK    (3U)
+#define FD_SOLCAP_ASYNC_REC_TXN     (4U)
+#define FD_SOLCAP_ASYNC_REC_FLUSH   (5U)
+#define FD_SOLCAP_ASYNC_REC_PAD     (6U)
+
+/* fd_solcap_async_rec_t is the header of a record in the async ring.
+   Records are 8 byte aligned and never wrap around the end of the
+   ring.  If the space left before the end of the ring is too small for
+   a header, the consumer skips to the start of the ring, otherwise the
+   producer fills it with a PAD record. */
+
+struct fd_solcap_async_rec {
+  uint  type;
+  uint  data_sz; /* account data bytes following an ACCOUNT record */
+  ulong sz;      /* total size of the record, including the header */
+  union {
+    ulong                  slot;
+    struct {
+      fd_solcap_account_tbl_t tbl;
+      fd_solcap_AccountMeta   meta_pb;
+    } account;
+    fd_solcap_BankPreimage preimage;
+    fd_solcap_Transaction  txn;
+  };
+};
+
+typedef struct fd_solcap_async_rec fd_solcap_async_rec_t;
+
 /* FTELL_BAIL calls ftell on the given file, and bails the current
    function with return code EIO if it fails. */
 
@@ -161,6 +221,7 @@ fd_solcap_writer_delete( fd_solcap_writer_t * writer ) {
 
   if( FD_UNLIKELY( !writer ) ) return NULL;
 
+  if( FD_UNLIKELY( writer->async ) ) fd_solcap_writer_async_fini( writer );
   writer->file = NULL;
   return writer;
 }
@@ -205,12 +266,10 @@ fd_solcap_writer_init( fd_solcap_writer_t * writer,
   return writer;
 }
 
-/* fd_solcap_writer_flush writes the file header. */
+/* fd_solcap_writer_flush_sync writes the file header. */
 
-fd_solcap_writer_t *
-fd_solcap_writer_flush( fd_solcap_writer_t * writer ) {
-
-  if( FD_LIKELY( !writer ) ) return NULL;
+static fd_solcap_writer_t *
+fd_solcap_writer_flush_sync( fd_solcap_writer_t * writer ) {
 
   /* Flush stream */
   fflush( writer->file );
@@ -382,14 +441,12 @@ fd_solcap_write_account( fd_solcap_writer_t *             writer,
   return fd_solcap_write_account2( writer, rec, meta_pb, data, data_sz );
 }
 
-int
-fd_solcap_write_account2( fd_solcap_writer_t *             writer,
-                          fd_solcap_account_tbl_t const *  tbl,
-                          fd_solcap_AccountMeta *          meta_pb,
-                          void const *                     data,
-                          ulong                            data_sz ) {
-
-  if( FD_LIKELY( !writer ) ) return 0;
+static int
+fd_solcap_write_account_sync( fd_solcap_writer_t *             writer,
+                              fd_solcap_account_tbl_t const *  tbl,
+                              fd_solcap_AccountMeta *          meta_pb,
+                              void const *                     data,
+                              ulong                            data_sz ) {
 
   /* Locate chunk */
 
@@ -459,11 +516,9 @@ fd_solcap_write_account2( fd_solcap_writer_t *             writer,
   return 0;
 }
 
-void
-fd_solcap_writer_set_slot( fd_solcap_writer_t * writer,
-                          ulong                slot ) {
-
-  if( FD_LIKELY( !writer ) ) return;
+static void
+fd_solcap_writer_set_slot_sync( fd_solcap_writer_t * writer,
+                                ulong                slot ) {
 
   /* Discard account table buffer */
   writer->account_table_goff = 0UL;
@@ -483,7 +538,7 @@ fd_solcap_write_bank_preimage( fd_solcap_writer_t * writer,
 
   fd_solcap_BankPreimage preimage_pb[1] = {{0}};
   preimage_pb->signature_cnt = signature_cnt;
-  preimage_pb->account_cnt   = writer->account_idx;
+  preimage_pb->account_cnt   = writer->slot_account_cnt;
   memcpy( preimage_pb->bank_hash,          bank_hash,          32UL );
   memcpy( preimage_pb->prev_bank_hash,     prev_bank_hash,     32UL );
   memcpy( preimage_pb->account_delta_hash, account_delta_hash, 32UL );
@@ -492,12 +547,9 @@ fd_solcap_write_bank_preimage( fd_solcap_writer_t * writer,
   return fd_solcap_write_bank_preimage2( writer, preimage_pb );
 }
 
-
-int
-fd_solcap_write_bank_preimage2( fd_solcap_writer_t *     writer,
-                                fd_solcap_BankPreimage * preimage_pb ) {
-
-  if( FD_LIKELY( !writer ) ) return 0;
+static int
+fd_solcap_write_bank_preimage_sync( fd_solcap_writer_t *     writer,
+                                    fd_solcap_BankPreimage * preimage_pb ) {
 
   int err = fd_solcap_flush_account_table( writer );
   if( FD_UNLIKELY( err!=0 ) ) return err;
@@ -547,11 +599,10 @@ fd_solcap_write_bank_preimage2( fd_solcap_writer_t *     writer,
   return 0;
 }
 
-int fd_solcap_write_transaction2( fd_solcap_writer_t *    writer,
+static int
+fd_solcap_write_transaction_sync( fd_solcap_writer_t *    writer,
                                   fd_solcap_Transaction * txn ) {
 
-  if( FD_LIKELY( !writer ) ) return 0;
-
   /* Locate chunk */
   ulong chunk_goff = FTELL_BAIL( writer->file );
   FSKIP_BAIL( writer->file, sizeof(fd_solcap_chunk_t) );
@@ -583,3 +634,330 @@ int fd_solcap_write_transaction2( fd_solcap_writer_t *    writer,
 
   return 0;
 }
+
+/* Asynchronous capture ***********************************************/
+
+#define FD_SOLCAP_ASYNC_REC_HDR_SZ (offsetof( fd_solcap_async_rec_t, slot ))
+
+/* fd_solcap_async_task is the writer tile.  It replays the records
+   published to the ring against the synchronous implementation until
+   the ring is drained and the writer has been asked to halt. */
+
+static int
+fd_solcap_async_task( int     argc,
+                      char ** argv ) {
+  (void)argc;
+  fd_solcap_writer_t * writer = (fd_solcap_writer_t *)argv;
+
+  ulong tail = writer->ring_tail;
+  for(;;) {
+    ulong head = FD_VOLATILE_CONST( writer->ring_head );
+    if( FD_UNLIKELY( tail==head ) ) {
+      if( FD_UNLIKELY( FD_VOLATILE_CONST( writer->async_halt ) ) ) {
+        FD_COMPILER_MFENCE();
+        if( FD_LIKELY( tail==FD_VOLATILE_CONST( writer->ring_head ) ) ) break;
+      }
+      FD_SPIN_PAUSE();
+      continue;
+    }
+    FD_COMPILER_MFENCE();
+
+    ulong off = tail % writer->ring_sz;
+    if( FD_UNLIKELY( writer->ring_sz-off < FD_SOLCAP_ASYNC_REC_HDR_SZ ) ) {
+      tail += writer->ring_sz-off;
+      FD_VOLATILE( writer->ring_tail ) = tail;
+      continue;
+    }
+
+    fd_solcap_async_rec_t * rec = (fd_solcap_async_rec_t *)( writer->ring + off );
+    int err = 0;
+    switch( rec->type ) {
+    case FD_SOLCAP_ASYNC_REC_SLOT:
+      fd_solcap_writer_set_slot_sync( writer, rec->slot );
+      break;
+    case FD_SOLCAP_ASYNC_REC_ACCOUNT:
+      err = fd_solcap_write_account_sync( writer, &rec->account.tbl, &rec->account.meta_pb, rec+1, rec->data_sz );
+      break;
+    case FD_SOLCAP_ASYNC_REC_BANK:
+      err = fd_solcap_write_bank_preimage_sync( writer, &rec->preimage );
+      break;
+    case FD_SOLCAP_ASYNC_REC_TXN:
+      err = fd_solcap_write_transaction_sync( writer, &rec->txn );
+      break;
+    case FD_SOLCAP_ASYNC_REC_FLUSH:
+      /* Flushes are requested often, skip them if more records are
+         already queued, those will be followed by another flush. */
+      if( FD_LIKELY( tail+rec->sz==FD_VOLATILE_CONST( writer->ring_head ) ) ) {
+        if( FD_UNLIKELY( !fd_solcap_writer_flush_sync( writer ) ) ) err = EIO;
+      }
+      break;
+    default:
+      break;
+    }
+    if( FD_UNLIKELY( err && !writer->async_err ) ) FD_VOLATILE( writer->async_err ) = err;
+
+    FD_COMPILER_MFENCE();
+    tail += rec->sz;
+    FD_VOLATILE( writer->ring_tail ) = tail;
+  }
+
+  return 0;
+}
+
+/* fd_solcap_async_wait waits until at least sz bytes of the ring are
+   free. */
+
+static void
+fd_solcap_async_wait( fd_solcap_writer_t * writer,
+                      ulong                sz ) {
+  while( FD_UNLIKELY( writer->ring_head+sz-FD_VOLATILE_CONST( writer->ring_tail )>writer->ring_sz ) ) FD_SPIN_PAUSE();
+  FD_COMPILER_MFENCE();
+}
+
+/* fd_solcap_async_prepare returns the location in the ring of a new
+   record with data_sz trailing bytes, waiting for the writer tile to
+   free up space if needed.  Returns NULL if the record could never fit
+   in the ring. */
+
+static fd_solcap_async_rec_t *
+fd_solcap_async_prepare( fd_solcap_writer_t * writer,
+                         uint                 type,
+                         ulong                data_sz ) {
+  ulong sz = fd_ulong_align_up( sizeof(fd_solcap_async_rec_t)+data_sz, 8UL );
+  if( FD_UNLIKELY( sz>writer->ring_sz ) ) return NULL;
+
+  ulong off = writer->ring_head % writer->ring_sz;
+  ulong rem = writer->ring_sz - off;
+  if( FD_UNLIKELY( rem<sz ) ) {
+    /* Not enough space left before the end of the ring, skip to the
+       start (see fd_solcap_async_rec_t) */
+    fd_solcap_async_wait( writer, rem );
+    if( FD_LIKELY( rem>=FD_SOLCAP_ASYNC_REC_HDR_SZ ) ) {
+      fd_solcap_async_rec_t * pad = (fd_solcap_async_rec_t *)( writer->ring + off );
+      pad->type = FD_SOLCAP_ASYNC_REC_PAD;
+      pad->sz   = rem;
+    }
+    FD_COMPILER_MFENCE();
+    writer->ring_head += rem;
+    FD_VOLATILE( writer->ring_head ) = writer->ring_head;
+    off = 0UL;
+  }
+
+  fd_solcap_async_wait( writer, sz );
+  fd_solcap_async_rec_t * rec = (fd_solcap_async_rec_t *)( writer->ring + off );
+  rec->type    = type;
+  rec->data_sz = (uint)data_sz;
+  rec->sz      = sz;
+  return rec;
+}
+
+/* fd_solcap_async_publish makes the record most recently returned by
+   fd_solcap_async_prepare visible to the writer tile. */
+
+static void
+fd_solcap_async_publish( fd_solcap_writer_t *    writer,
+                         fd_solcap_async_rec_t * rec ) {
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( writer->ring_head ) = writer->ring_head + rec->sz;
+  FD_COMPILER_MFENCE();
+}
+
+/* fd_solcap_async_drain waits until the writer tile has consumed every
+   record published so far, after which the caller's thread has
+   exclusive access to the stream until it publishes another record. */
+
+static void
+fd_solcap_async_drain( fd_solcap_writer_t * writer ) {
+  while( FD_VOLATILE_CONST( writer->ring_tail )!=writer->ring_head ) FD_SPIN_PAUSE();
+  FD_COMPILER_MFENCE();
+}
+
+fd_solcap_writer_t *
+fd_solcap_writer_async_init( fd_solcap_writer_t * writer,
+                             void *               ring,
+                             ulong                ring_sz,
+                             ulong                tile_idx ) {
+
+  if( FD_UNLIKELY( !writer ) ) {
+    FD_LOG_WARNING(( "NULL writer" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( writer->async ) ) {
+    FD_LOG_WARNING(( "writer is already asynchronous" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !ring || !fd_ulong_is_aligned( (ulong)ring, FD_SOLCAP_WRITER_ASYNC_RING_ALIGN ) ) ) {
+    FD_LOG_WARNING(( "NULL or misaligned ring" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( ring_sz<FD_SOLCAP_WRITER_ASYNC_RING_SZ_MIN || !fd_ulong_is_aligned( ring_sz, 8UL ) ) ) {
+    FD_LOG_WARNING(( "ring_sz %lu should be a multiple of 8 of at least %lu", ring_sz, FD_SOLCAP_WRITER_ASYNC_RING_SZ_MIN ));
+    return NULL;
+  }
+
+  writer->ring       = (uchar *)ring;
+  writer->ring_sz    = ring_sz;
+  writer->ring_head  = 0UL;
+  writer->ring_tail  = 0UL;
+  writer->async_halt = 0;
+  writer->async_err  = 0;
+
+  writer->async_exec = fd_tile_exec_new( tile_idx, fd_solcap_async_task, 0, (char **)writer );
+  if( FD_UNLIKELY( !writer->async_exec ) ) {
+    FD_LOG_WARNING(( "fd_tile_exec_new(%lu) failed", tile_idx ));
+    writer->ring    = NULL;
+    writer->ring_sz = 0UL;
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  writer->async = 1;
+  return writer;
+}
+
+void *
+fd_solcap_writer_async_fini( fd_solcap_writer_t * writer ) {
+
+  if( FD_UNLIKELY( !writer || !writer->async ) ) return NULL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( writer->async_halt ) = 1;
+  FD_COMPILER_MFENCE();
+
+  int ret;
+  char const * fail = fd_tile_exec_delete( writer->async_exec, &ret );
+  if( FD_UNLIKELY( fail ) ) FD_LOG_WARNING(( "capture writer tile failed (%s)", fail ));
+  if( FD_UNLIKELY( writer->async_err ) ) {
+    FD_LOG_WARNING(( "asynchronous capture failed (%d-%s)", writer->async_err, fd_io_strerror( writer->async_err ) ));
+  }
+
+  void * ring = writer->ring;
+  writer->async      = 0;
+  writer->async_exec = NULL;
+  writer->ring       = NULL;
+  writer->ring_sz    = 0UL;
+  return ring;
+}
+
+void
+fd_solcap_writer_set_sample( fd_solcap_writer_t * writer,
+                             ulong                slot_stride,
+                             fd_pubkey_t const *  accounts,
+                             ulong                account_cnt ) {
+
+  if( FD_UNLIKELY( !writer ) ) return;
+
+  writer->slot_stride        = slot_stride;
+  writer->account_filter     = account_cnt ? accounts : NULL;
+  writer->account_filter_cnt = accounts ? account_cnt : 0UL;
+}
+
+/* fd_solcap_writer_t user API *****************************************
+
+   The functions below apply sampling, then either forward to the
+   synchronous implementation or queue a record for the writer tile. */
+
+fd_solcap_writer_t *
+fd_solcap_writer_flush( fd_solcap_writer_t * writer ) {
+
+  if( FD_LIKELY( !writer ) ) return NULL;
+
+  if( writer->async ) {
+    fd_solcap_async_rec_t * rec = fd_solcap_async_prepare( writer, FD_SOLCAP_ASYNC_REC_FLUSH, 0UL );
+    fd_solcap_async_publish( writer, rec );
+    return writer;
+  }
+
+  return fd_solcap_writer_flush_sync( writer );
+}
+
+void
+fd_solcap_writer_set_slot( fd_solcap_writer_t * writer,
+                           ulong                slot ) {
+
+  if( FD_LIKELY( !writer ) ) return;
+
+  writer->skip_slot        = writer->slot_stride>1UL && (slot % writer->slot_stride)!=0UL;
+  writer->slot_account_cnt = 0UL;
+  if( writer->skip_slot ) return;
+
+  if( writer->async ) {
+    fd_solcap_async_rec_t * rec = fd_solcap_async_prepare( writer, FD_SOLCAP_ASYNC_REC_SLOT, 0UL );
+    rec->slot = slot;
+    fd_solcap_async_publish( writer, rec );
+    return;
+  }
+
+  fd_solcap_writer_set_slot_sync( writer, slot );
+}
+
+int
+fd_solcap_write_account2( fd_solcap_writer_t *             writer,
+                          fd_solcap_account_tbl_t const *  tbl,
+                          fd_solcap_AccountMeta *          meta_pb,
+                          void const *                     data,
+                          ulong                            data_sz ) {
+
+  if( FD_LIKELY( !writer ) ) return 0;
+  if( writer->skip_slot ) return 0;
+
+  if( writer->account_filter_cnt ) {
+    ulong i;
+    for( i=0UL; i<writer->account_filter_cnt; i++ ) {
+      if( !memcmp( writer->account_filter[ i ].uc, tbl->key, 32UL ) ) break;
+    }
+    if( i==writer->account_filter_cnt ) return 0;
+  }
+
+  writer->slot_account_cnt++;
+
+  if( writer->async ) {
+    fd_solcap_async_rec_t * rec = fd_solcap_async_prepare( writer, FD_SOLCAP_ASYNC_REC_ACCOUNT, data_sz );
+    if( FD_LIKELY( rec ) ) {
+      rec->account.tbl     = *tbl;
+      rec->account.meta_pb = *meta_pb;
+      fd_memcpy( rec+1, data, data_sz );
+      fd_solcap_async_publish( writer, rec );
+      return writer->async_err;
+    }
+    /* Account too large for the ring, write it out from this thread
+       once the writer tile is idle. */
+    fd_solcap_async_drain( writer );
+  }
+
+  return fd_solcap_write_account_sync( writer, tbl, meta_pb, data, data_sz );
+}
+
+int
+fd_solcap_write_bank_preimage2( fd_solcap_writer_t *     writer,
+                                fd_solcap_BankPreimage * preimg ) {
+
+  if( FD_LIKELY( !writer ) ) return 0;
+  if( writer->skip_slot ) return 0;
+
+  if( writer->async ) {
+    fd_solcap_async_rec_t * rec = fd_solcap_async_prepare( writer, FD_SOLCAP_ASYNC_REC_BANK, 0UL );
+    rec->preimage = *preimg;
+    fd_solcap_async_publish( writer, rec );
+    return writer->async_err;
+  }
+
+  return fd_solcap_write_bank_preimage_sync( writer, preimg );
+}
+
+int
+fd_solcap_write_transaction2( fd_solcap_writer_t *    writer,
+                              fd_solcap_Transaction * txn ) {
+
+  if( FD_LIKELY( !writer ) ) return 0;
+  if( writer->skip_slot ) return 0;
+
+  if( writer->async ) {
+    fd_solcap_async_rec_t * rec = fd_solcap_async_prepare( writer, FD_SOLCAP_ASYNC_REC_TXN, 0UL );
+    rec->txn = *txn;
+    fd_solcap_async_publish( writer, rec );
+    return writer->async_err;
+  }
+
+  return fd_solcap_write_transaction_sync( writer, txn );
+}
@@ -71,6 +71,48 @@ fd_solcap_writer_init( fd_solcap_writer_t * writer,
 fd_solcap_writer_t *
 fd_solcap_writer_flush( fd_solcap_writer_t * writer );
 
+/* fd_solcap_writer_async_init moves the encoding and stream I/O of an
+   initialized writer off the caller's thread.  ring points to a
+   FD_SOLCAP_WRITER_ASYNC_RING_ALIGN aligned region of ring_sz bytes
+   (a multiple of 8 of at least FD_SOLCAP_WRITER_ASYNC_RING_SZ_MIN)
+   that the writer uses to queue copies of the arguments of the user
+   API calls below, which are replayed in order by a writer task
+   started on tile tile_idx.  The user API must then only be called
+   from a single thread.  Errors from the writer tile are reported by
+   subsequent user API calls.  Returns writer on success and NULL on
+   failure (logs details). */
+
+#define FD_SOLCAP_WRITER_ASYNC_RING_ALIGN  (128UL)
+#define FD_SOLCAP_WRITER_ASYNC_RING_SZ_MIN (1UL<<20)
+
+fd_solcap_writer_t *
+fd_solcap_writer_async_init( fd_solcap_writer_t * writer,
+                             void *               ring,
+                             ulong                ring_sz,
+                             ulong                tile_idx );
+
+/* fd_solcap_writer_async_fini waits for the writer tile to drain the
+   ring, stops it and returns writer to synchronous operation.  Returns
+   the ring passed to async_init (NULL if writer was not asynchronous).
+   fd_solcap_writer_flush should be called before to finish the
+   in-flight chunks. */
+
+void *
+fd_solcap_writer_async_fini( fd_solcap_writer_t * writer );
+
+/* fd_solcap_writer_set_sample restricts the capture to slots that are
+   a multiple of slot_stride (every slot if slot_stride<=1) and, if
+   account_cnt is non-zero, to the accounts in accounts[account_cnt].
+   accounts must remain valid while writer is in use.  Applies from the
+   next call to fd_solcap_writer_set_slot.  Should be called after
+   fd_solcap_writer_init. */
+
+void
+fd_solcap_writer_set_sample( fd_solcap_writer_t * writer,
+                             ulong                slot_stride,
+                             fd_pubkey_t const *  accounts,
+                             ulong                account_cnt );
+
 /* fd_solcap_writer_t user API *****************************************
 
    Before calling below functions, the object must have been initialized
@@ -35,6 +35,9 @@ typedef struct fd_acc_mgr fd_acc_mgr_t;
 struct fd_capture_ctx;
 typedef struct fd_capture_ctx fd_capture_ctx_t;
 
+struct fd_runtime_prof;
+typedef struct fd_runtime_prof fd_runtime_prof_t;
+
 /* fd_rawtxn_b_t is a convenience type to store a pointer to a
    serialized transaction.  Should probably be removed in the future. */
 
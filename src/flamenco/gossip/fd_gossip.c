@@ -5,6 +5,7 @@
 #include "../../ballet/base58/fd_base58.h"
 #include "../../util/net/fd_eth.h"
 #include "../../util/rng/fd_rng.h"
+#include "fd_gossip_bloom.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -23,6 +24,12 @@
 #define FD_ACTIVE_KEY_MAX (1<<8)
 /* Max number of values that can be remembered */
 #define FD_VALUE_KEY_MAX (1<<16)
+/* Number of high bits of the value hash used to shard the value index */
+#define FD_VALUE_INDEX_BITS 10U
+/* Max number of values run through a pull request bloom filter at once */
+#define FD_PULL_BATCH_MAX 64U
+/* Max number of received values whose signatures are verified together */
+#define FD_RECV_BATCH_MAX 32U
 /* Max number of pending timed events */
 #define FD_PENDING_MAX (1<<9)
 /* Number of bloom filter bits in an outgoing pull request packet */
@@ -139,10 +146,14 @@ void fd_hash_copy( fd_hash_t * keyd, const fd_hash_t * keys ) {
 }
 
 /* Value table element. This table stores all received crds
-   values. Keyed by the hash of the value data. */
+   values. Keyed by the hash of the value data. Values are also
+   threaded on the list of their index shard (see value_index) so that
+   pull requests only visit values that match their mask. */
 struct fd_value_elem {
     fd_hash_t key;
     ulong next;
+    ulong shard_prev; /* Previous value in the index shard, or ULONG_MAX */
+    ulong shard_next; /* Next value in the index shard, or ULONG_MAX */
     fd_pubkey_t origin; /* Where did this value originate */
     ulong wallclock; /* Original timestamp of value in millis */
     uchar data[PACKET_DATA_SIZE]; /* Serialized form of value (bincode) including signature */
@@ -275,6 +286,9 @@ struct fd_gossip {
 #define INACTIVES_MAX 1024U
     /* Table of crds values that we have received in the last 5 minutes, keys by hash */
     fd_value_elem_t * values;
+    /* Index of the values table by the high FD_VALUE_INDEX_BITS bits of
+       the hash. Each entry is the head of a list of values, or ULONG_MAX */
+    ulong * value_index;
     /* The last timestamp hash that we pushed our own contact info */
     long last_contact_time;
     fd_hash_t last_contact_info_key;
@@ -306,6 +320,14 @@ struct fd_gossip {
     ulong push_cnt;
     /* Count of values not pushed due to pruning */
     ulong not_push_cnt;
+    /* Count of pull requests served */
+    ulong pull_req_cnt;
+    /* Count of values sent in pull responses */
+    ulong pull_resp_value_cnt;
+    /* Count of value signatures verified */
+    ulong recv_verify_cnt;
+    /* Count of values with a bad signature */
+    ulong recv_verify_fail_cnt;
     /* Stake weights */
     fd_weights_elem_t * weights;
     /* List of added entrypoints at startup */
@@ -325,6 +347,7 @@ fd_gossip_footprint( void ) {
   l = FD_LAYOUT_APPEND( l, alignof(fd_gossip_peer_addr_t), INACTIVES_MAX*sizeof(fd_gossip_peer_addr_t) );
   l = FD_LAYOUT_APPEND( l, alignof(fd_hash_t), FD_NEED_PUSH_MAX*sizeof(fd_hash_t) );
   l = FD_LAYOUT_APPEND( l, fd_value_table_align(), fd_value_table_footprint(FD_VALUE_KEY_MAX) );
+  l = FD_LAYOUT_APPEND( l, alignof(ulong), (1UL<<FD_VALUE_INDEX_BITS)*sizeof(ulong) );
   l = FD_LAYOUT_APPEND( l, fd_pending_pool_align(), fd_pending_pool_footprint(FD_PENDING_MAX) );
   l = FD_LAYOUT_APPEND( l, fd_pending_heap_align(), fd_pending_heap_footprint(FD_PENDING_MAX) );
   l = FD_LAYOUT_APPEND( l, fd_stats_table_align(), fd_stats_table_footprint(FD_STATS_KEY_MAX) );
@@ -352,6 +375,9 @@ fd_gossip_new ( void * shmem, ulong seed ) {
 
   shm = FD_SCRATCH_ALLOC_APPEND(l, fd_value_table_align(), fd_value_table_footprint(FD_VALUE_KEY_MAX));
   glob->values = fd_value_table_join(fd_value_table_new(shm, FD_VALUE_KEY_MAX, seed));
+  glob->value_index = (ulong*)FD_SCRATCH_ALLOC_APPEND(l, alignof(ulong), (1UL<<FD_VALUE_INDEX_BITS)*sizeof(ulong));
+  for (ulong i = 0; i < (1UL<<FD_VALUE_INDEX_BITS); ++i)
+    glob->value_index[i] = ULONG_MAX;
 
   glob->last_contact_time = 0;
   shm = FD_SCRATCH_ALLOC_APPEND(l, fd_pending_pool_align(), fd_pending_pool_footprint(FD_PENDING_MAX));
@@ -748,14 +774,37 @@ fd_gossip_sign_crds_value( fd_gossip_t * glob, fd_crds_value_t * crd ) {
   (*glob->sign_fun)(glob->sign_arg, crd->signature.uc, buf, (ulong)((uchar*)ctx.data - buf));
 }
 
-/* Convert a hash to a bloom filter bit position */
-static ulong
-fd_gossip_bloom_pos( fd_hash_t * hash, ulong key, ulong nbits) {
-  for ( ulong i = 0; i < 32U; ++i) {
-    key ^= (ulong)(hash->uc[i]);
-    key *= 1099511628211UL;
-  }
-  return key % nbits;
+/* Index shard of a value hash */
+static inline ulong
+fd_gossip_value_shard( fd_hash_t const * hash ) {
+  return hash->ul[0] >> (64U - FD_VALUE_INDEX_BITS);
+}
+
+/* Insert a value into the value table and the index. The table must
+   not be full or already contain the key. */
+static fd_value_elem_t *
+fd_gossip_value_insert( fd_gossip_t * glob, fd_hash_t const * key ) {
+  fd_value_elem_t * ele = fd_value_table_insert(glob->values, key);
+  ulong idx = (ulong)(ele - glob->values);
+  ulong * head = glob->value_index + fd_gossip_value_shard(key);
+  ele->shard_prev = ULONG_MAX;
+  ele->shard_next = *head;
+  if (*head != ULONG_MAX)
+    glob->values[*head].shard_prev = idx;
+  *head = idx;
+  return ele;
+}
+
+/* Remove a value from the value table and the index */
+static void
+fd_gossip_value_remove( fd_gossip_t * glob, fd_value_elem_t * ele ) {
+  if (ele->shard_prev == ULONG_MAX)
+    glob->value_index[fd_gossip_value_shard(&ele->key)] = ele->shard_next;
+  else
+    glob->values[ele->shard_prev].shard_next = ele->shard_next;
+  if (ele->shard_next != ULONG_MAX)
+    glob->values[ele->shard_next].shard_prev = ele->shard_prev;
+  fd_value_table_remove( glob->values, &ele->key );
 }
 
 /* Choose a random active peer with good ping count */
@@ -861,7 +910,7 @@ fd_gossip_random_pull( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
     fd_hash_t * hash = &(ele->key);
     /* Purge expired values */
     if (ele->wallclock < expire) {
-      fd_value_table_remove( glob->values, hash );
+      fd_gossip_value_remove( glob, ele );
       continue;
     }
     /* Choose which filter packet based on the high bits in the hash */
@@ -1015,10 +1064,33 @@ fd_gossip_random_ping( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
   fd_gossip_make_ping(glob, &arg2);
 }
 
-/* Process an incoming crds value */
-static void
-fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_pubkey_t * pubkey, fd_crds_value_t* crd) {
-  /* Verify the signature */
+/* A received crds value waiting for its signature to be verified */
+struct fd_gossip_recv_value {
+    fd_crds_value_t * crd;
+    fd_pubkey_t * pubkey; /* Origin of the value */
+    ulong wallclock;      /* Timestamp of the value in millis */
+    fd_hash_t key;        /* Hash of the value */
+    uchar * data;         /* Serialized form of the value, points into the batch */
+    ulong datalen;
+};
+typedef struct fd_gossip_recv_value fd_gossip_recv_value_t;
+
+/* A batch of received crds values. The values of a message are parsed
+   and hashed first, so that duplicates (which are most of the traffic)
+   are dropped without checking the signature. The remaining signatures
+   are then verified together before anything is inserted. */
+struct fd_gossip_recv_batch {
+    ulong cnt;
+    ulong data_used;
+    fd_gossip_recv_value_t vals[FD_RECV_BATCH_MAX];
+    uchar data[2U*PACKET_DATA_SIZE];
+};
+typedef struct fd_gossip_recv_batch fd_gossip_recv_batch_t;
+
+/* Parse an incoming crds value and hash it. Returns 0 if it is a new
+   value that needs verification, which is then filled into val. */
+static int
+fd_gossip_recv_crds_prepare(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_pubkey_t * pubkey, fd_crds_value_t* crd, fd_gossip_recv_value_t * val, uchar * buf) {
   ulong wallclock;
   switch (crd->data.discriminant) {
   case fd_crds_data_enum_contact_info_v1:
@@ -1071,31 +1143,16 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   }
   if (memcmp(pubkey->uc, glob->public_key->uc, 32U) == 0)
     /* Ignore my own messages */
-    return;
-  uchar buf[PACKET_DATA_SIZE];
-  fd_bincode_encode_ctx_t ctx;
-  ctx.data = buf;
-  ctx.dataend = buf + PACKET_DATA_SIZE;
-  if ( fd_crds_data_encode( &crd->data, &ctx ) ) {
-    FD_LOG_ERR(("fd_crds_data_encode failed"));
-    return;
-  }
-  fd_sha512_t sha[1];
-  if (fd_ed25519_verify( /* msg */ buf,
-                         /* sz  */ (ulong)((uchar*)ctx.data - buf),
-                         /* sig */ crd->signature.uc,
-                         /* public_key */ pubkey->uc,
-                         sha )) {
-    FD_LOG_DEBUG(("received crds_value with invalid signature"));
-    return;
-  }
+    return -1;
 
-  /* Perform the value hash to get the value table key */
+  /* Perform the value hash to get the value table key. The value is
+     encoded as the signature followed by the signed data. */
+  fd_bincode_encode_ctx_t ctx;
   ctx.data = buf;
   ctx.dataend = buf + PACKET_DATA_SIZE;
   if ( fd_crds_value_encode( crd, &ctx ) ) {
     FD_LOG_ERR(("fd_crds_value_encode failed"));
-    return;
+    return -1;
   }
   fd_sha256_t sha2[1];
   fd_sha256_init( sha2 );
@@ -1104,6 +1161,8 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   fd_hash_t key;
   fd_sha256_fini( sha2, key.uc );
 
+  /* The key covers the signature, so a value we already have has
+     already been verified */
   fd_value_elem_t * msg = fd_value_table_query(glob->values, &key, NULL);
   if (msg != NULL) {
     /* Already have this value */
@@ -1132,6 +1191,28 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
         found_origin: ;
       }
     }
+    return -1;
+  }
+
+  val->crd = crd;
+  val->pubkey = pubkey;
+  val->wallclock = wallclock;
+  fd_hash_copy(&val->key, &key);
+  val->data = buf;
+  val->datalen = datalen;
+  return 0;
+}
+
+/* Insert a verified crds value */
+static void
+fd_gossip_recv_crds_insert(fd_gossip_t * glob, fd_gossip_recv_value_t * val) {
+  fd_crds_value_t * crd = val->crd;
+  fd_pubkey_t * pubkey = val->pubkey;
+  ulong wallclock = val->wallclock;
+
+  /* The same value might appear twice in a batch */
+  if (fd_value_table_query(glob->values, &val->key, NULL) != NULL) {
+    glob->recv_dup_cnt++;
     return;
   }
 
@@ -1141,18 +1222,18 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
     FD_LOG_DEBUG(("too many values"));
     return;
   }
-  msg = fd_value_table_insert(glob->values, &key);
+  fd_value_elem_t * msg = fd_gossip_value_insert(glob, &val->key);
   msg->wallclock = wallclock;
   fd_hash_copy(&msg->origin, pubkey);
 
   /* We store the serialized form for convenience */
-  fd_memcpy(msg->data, buf, datalen);
-  msg->datalen = datalen;
+  fd_memcpy(msg->data, val->data, val->datalen);
+  msg->datalen = val->datalen;
 
   if (glob->need_push_cnt < FD_NEED_PUSH_MAX) {
     /* Remember that I need to push this value */
     ulong i = ((glob->need_push_head + (glob->need_push_cnt++)) & (FD_NEED_PUSH_MAX-1U));
-    fd_hash_copy(glob->need_push + i, &key);
+    fd_hash_copy(glob->need_push + i, &val->key);
   }
 
   if (crd->data.discriminant == fd_crds_data_enum_contact_info_v1) {
@@ -1196,6 +1277,52 @@ fd_gossip_recv_crds_value(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   fd_gossip_lock( glob );
 }
 
+/* Verify the signatures of a batch of values and insert the good ones */
+static void
+fd_gossip_recv_batch_flush(fd_gossip_t * glob, fd_gossip_recv_batch_t * batch) {
+  ulong cnt = batch->cnt;
+  fd_sha512_t sha[1];
+  uchar ok[FD_RECV_BATCH_MAX];
+  for (ulong i = 0; i < cnt; ++i) {
+    fd_gossip_recv_value_t * val = batch->vals + i;
+    ok[i] = !fd_ed25519_verify( /* msg */ val->data + 64U,
+                                /* sz  */ val->datalen - 64U,
+                                /* sig */ val->data,
+                                /* public_key */ val->pubkey->uc,
+                                sha );
+  }
+  glob->recv_verify_cnt += cnt;
+  for (ulong i = 0; i < cnt; ++i) {
+    if (!ok[i]) {
+      FD_LOG_DEBUG(("received crds_value with invalid signature"));
+      glob->recv_verify_fail_cnt++;
+      continue;
+    }
+    fd_gossip_recv_crds_insert(glob, batch->vals + i);
+  }
+  batch->cnt = 0;
+  batch->data_used = 0;
+}
+
+/* Process the crds values of a push message or pull response */
+static void
+fd_gossip_recv_crds_values(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_pubkey_t * pubkey, fd_crds_value_t * crds, ulong crds_len) {
+  fd_gossip_recv_batch_t batch;
+  batch.cnt = 0;
+  batch.data_used = 0;
+  for (ulong i = 0; i < crds_len; ++i) {
+    if (batch.cnt == FD_RECV_BATCH_MAX || batch.data_used + PACKET_DATA_SIZE > sizeof(batch.data))
+      fd_gossip_recv_batch_flush(glob, &batch);
+    fd_gossip_recv_value_t * val = batch.vals + batch.cnt;
+    if (fd_gossip_recv_crds_prepare(glob, from, pubkey, crds + i, val, batch.data + batch.data_used))
+      continue;
+    batch.cnt++;
+    batch.data_used += val->datalen;
+  }
+  if (batch.cnt)
+    fd_gossip_recv_batch_flush(glob, &batch);
+}
+
 /* Handle a prune request from somebody else */
 static void
 fd_gossip_handle_prune(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_prune_msg_t * msg) {
@@ -1276,13 +1403,13 @@ fd_gossip_push_updated_contact(fd_gossip_t * glob) {
     /* Remove the old contact value */
     fd_value_elem_t * ele = fd_value_table_query(glob->values, &glob->last_contact_info_key, NULL);
     if (ele != NULL) {
-      fd_value_table_remove( glob->values, &glob->last_contact_info_key );
+      fd_gossip_value_remove( glob, ele );
     }
 
     /* Remove the old version value */
     ele = fd_value_table_query(glob->values, &glob->last_contact_version_key, NULL);
     if (ele != NULL) {
-      fd_value_table_remove( glob->values, &glob->last_contact_version_key );
+      fd_gossip_value_remove( glob, ele );
     }
 
   }
@@ -1343,59 +1470,89 @@ fd_gossip_handle_pull_req(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from
   /* Push an updated version of my contact info into values */
   fd_gossip_push_updated_contact(glob);
 
-  /* Apply the bloom filter to my table of values */
+  /* Sanity check the filter */
   fd_crds_filter_t * filter = &msg->filter;
   ulong nkeys = filter->filter.keys_len;
   ulong * keys = filter->filter.keys;
   fd_gossip_bitvec_u64_t * bitvec = &filter->filter.bits;
   ulong * bitvec2 = bitvec->bits.vec;
+  if (filter->mask_bits > 64U)
+    return;
+  if (nkeys > 0 && (!bitvec->has_bits || bitvec->len == 0 || bitvec->len > bitvec->bits.vec_len*64U))
+    return;
+  ulong m = fd_gossip_bloom_mask_ones(filter->mask_bits);
+
+  /* The mask selects a range of hash prefixes, so only the index
+     shards covering that range need to be visited. Without mask bits
+     (mask_bits of 0 or 64), every value passes the mask if it is all
+     ones. */
+  ulong shard0, nshards;
+  if (m == ~0UL) {
+    shard0 = 0;
+    nshards = 1UL<<FD_VALUE_INDEX_BITS;
+  } else if (filter->mask_bits <= FD_VALUE_INDEX_BITS) {
+    shard0 = (filter->mask >> (64U - filter->mask_bits)) << (FD_VALUE_INDEX_BITS - filter->mask_bits);
+    nshards = 1UL<<(FD_VALUE_INDEX_BITS - filter->mask_bits);
+  } else {
+    shard0 = filter->mask >> (64U - FD_VALUE_INDEX_BITS);
+    nshards = 1;
+  }
+
+  /* Apply the bloom filter to my table of values a batch at a time */
   ulong expire = FD_NANOSEC_TO_MILLI(glob->now) - FD_GOSSIP_PULL_TIMEOUT;
   ulong hits = 0;
   ulong misses = 0;
   uint npackets = 0;
-  for( fd_value_table_iter_t iter = fd_value_table_iter_init( glob->values );
-       !fd_value_table_iter_done( glob->values, iter );
-       iter = fd_value_table_iter_next( glob->values, iter ) ) {
-    fd_value_elem_t * ele = fd_value_table_iter_ele( glob->values, iter );
-    fd_hash_t * hash = &(ele->key);
-    if (ele->wallclock < expire)
-      continue;
-    /* Execute the bloom filter */
-    if (filter->mask_bits != 0U) {
-      ulong m = (~0UL >> filter->mask_bits);
-      if ((hash->ul[0] | m) != filter->mask)
+  fd_value_elem_t * batch[FD_PULL_BATCH_MAX];
+  fd_hash_t const * batch_keys[FD_PULL_BATCH_MAX];
+  ulong shard = shard0;
+  ulong idx = glob->value_index[shard];
+  while (1) {
+    /* Gather candidates which pass the mask */
+    ulong cnt = 0;
+    while (cnt < FD_PULL_BATCH_MAX) {
+      if (idx == ULONG_MAX) {
+        if (++shard == shard0 + nshards)
+          break;
+        idx = glob->value_index[shard];
         continue;
-    }
-    int miss = 0;
-    for (ulong i = 0; i < nkeys; ++i) {
-      ulong pos = fd_gossip_bloom_pos(hash, keys[i], bitvec->len);
-      ulong * j = bitvec2 + (pos>>6U); /* divide by 64 */
-      ulong bit = 1UL<<(pos & 63U);
-      if (!((*j) & bit)) {
-        miss = 1;
-        break;
       }
+      fd_value_elem_t * ele = glob->values + idx;
+      idx = ele->shard_next;
+      if (ele->wallclock < expire)
+        continue;
+      if ((ele->key.ul[0] | m) != filter->mask)
+        continue;
+      batch_keys[cnt] = &ele->key;
+      batch[cnt++] = ele;
     }
-    if (!miss) {
-      hits++;
-      continue;
-    }
-    misses++;
-    /* Add the value in already encoded form */
-    if (newend + ele->datalen - buf > PACKET_DATA_SIZE) {
-      /* Packet is getting too large. Flush it */
-      ulong sz = (ulong)(newend - buf);
-      fd_gossip_send_raw(glob, from, buf, sz);
-      char tmp[100];
-      FD_LOG_DEBUG(("sent msg type %d to %s size=%lu", gmsg.discriminant, fd_gossip_addr_str(tmp, sizeof(tmp), from), sz));
-      ++npackets;
-      newend = (uchar *)ctx.data;
-      *crds_len = 0;
+    if (cnt == 0)
+      break;
+
+    /* Execute the bloom filter */
+    ulong miss = (nkeys == 0 ? 0UL : fd_gossip_bloom_miss_batch(batch_keys, cnt, keys, nkeys, bitvec2, bitvec->len));
+    hits += cnt - (ulong)fd_ulong_popcnt(miss);
+    for ( ; miss; miss = fd_ulong_pop_lsb(miss)) {
+      fd_value_elem_t * ele = batch[fd_ulong_find_lsb(miss)];
+      misses++;
+      /* Add the value in already encoded form */
+      if (newend + ele->datalen - buf > PACKET_DATA_SIZE) {
+        /* Packet is getting too large. Flush it */
+        ulong sz = (ulong)(newend - buf);
+        fd_gossip_send_raw(glob, from, buf, sz);
+        char tmp[100];
+        FD_LOG_DEBUG(("sent msg type %d to %s size=%lu", gmsg.discriminant, fd_gossip_addr_str(tmp, sizeof(tmp), from), sz));
+        ++npackets;
+        newend = (uchar *)ctx.data;
+        *crds_len = 0;
+      }
+      fd_memcpy(newend, ele->data, ele->datalen);
+      newend += ele->datalen;
+      (*crds_len)++;
     }
-    fd_memcpy(newend, ele->data, ele->datalen);
-    newend += ele->datalen;
-    (*crds_len)++;
   }
+  glob->pull_req_cnt++;
+  glob->pull_resp_value_cnt += misses;
 
   /* Flush final packet */
   if (newend > (uchar *)ctx.data) {
@@ -1419,14 +1576,12 @@ fd_gossip_recv(fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip
     break;
   case fd_gossip_msg_enum_pull_resp: {
     fd_gossip_pull_resp_t * pull_resp = &gmsg->inner.pull_resp;
-    for (ulong i = 0; i < pull_resp->crds_len; ++i)
-      fd_gossip_recv_crds_value(glob, NULL, &pull_resp->pubkey, pull_resp->crds + i);
+    fd_gossip_recv_crds_values(glob, NULL, &pull_resp->pubkey, pull_resp->crds, pull_resp->crds_len);
     break;
   }
   case fd_gossip_msg_enum_push_msg: {
     fd_gossip_push_msg_t * push_msg = &gmsg->inner.push_msg;
-    for (ulong i = 0; i < push_msg->crds_len; ++i)
-      fd_gossip_recv_crds_value(glob, from, &push_msg->pubkey, push_msg->crds + i);
+    fd_gossip_recv_crds_values(glob, from, &push_msg->pubkey, push_msg->crds, push_msg->crds_len);
     break;
   }
   case fd_gossip_msg_enum_prune_msg:
@@ -1655,7 +1810,7 @@ fd_gossip_push_value_nolock( fd_gossip_t * glob, fd_crds_data_t * data, fd_hash_
     FD_LOG_DEBUG(("too many values"));
     return -1;
   }
-  msg = fd_value_table_insert(glob->values, &key);
+  msg = fd_gossip_value_insert(glob, &key);
   msg->wallclock = FD_NANOSEC_TO_MILLI(glob->now); /* convert to ms */
   fd_hash_copy(&msg->origin, glob->public_key);
 
@@ -1772,6 +1927,10 @@ fd_gossip_log_stats( fd_gossip_t * glob, fd_pending_event_arg_t * arg ) {
   glob->recv_dup_cnt = glob->recv_nondup_cnt = 0;
   FD_LOG_NOTICE(("pushed %lu values and filtered %lu", glob->push_cnt, glob->not_push_cnt));
   glob->push_cnt = glob->not_push_cnt = 0;
+  FD_LOG_NOTICE(("served %lu pull requests (%.1f/s) with %lu values", glob->pull_req_cnt, ((double)glob->pull_req_cnt)/60.0, glob->pull_resp_value_cnt));
+  glob->pull_req_cnt = glob->pull_resp_value_cnt = 0;
+  FD_LOG_NOTICE(("verified %lu values (%.1f/s) and rejected %lu", glob->recv_verify_cnt, ((double)glob->recv_verify_cnt)/60.0, glob->recv_verify_fail_cnt));
+  glob->recv_verify_cnt = glob->recv_verify_fail_cnt = 0;
 
   int need_inactive = (glob->inactives_cnt == 0);
 
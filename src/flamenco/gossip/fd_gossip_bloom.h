@@ -0,0 +1,100 @@
+#ifndef HEADER_fd_src_flamenco_gossip_fd_gossip_bloom_h
+#define HEADER_fd_src_flamenco_gossip_fd_gossip_bloom_h
+
+/* Bloom filters and masks of gossip pull requests and prunes */
+
+#include "../types/fd_types.h"
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+
+/* Convert a hash to a bloom filter bit position */
+static inline ulong
+fd_gossip_bloom_pos( fd_hash_t const * hash, ulong key, ulong nbits) {
+  for ( ulong i = 0; i < 32U; ++i) {
+    key ^= (ulong)(hash->uc[i]);
+    key *= 1099511628211UL;
+  }
+  return key % nbits;
+}
+
+/* Test if a bloom filter bit is set */
+static inline int
+fd_gossip_bloom_test( ulong const * bits, ulong pos ) {
+  return (int)((bits[pos>>6U] >> (pos & 63U)) & 1UL);
+}
+
+/* The bits of a hash prefix that a pull request mask with mask_bits
+   bits ignores, all set. A hash passes the mask if it is equal to the
+   mask with these bits set. Like Agave's checked_shr, a shift of 64 or
+   more ignores all the bits. */
+static inline ulong
+fd_gossip_bloom_mask_ones( ulong mask_bits ) {
+  return (mask_bits >= 64U ? ~0UL : (~0UL >> mask_bits));
+}
+
+#if FD_HAS_AVX
+/* Multiply the 4 lanes by the FNV prime 2^40+0x1b3. AVX2 has no
+   64-bit multiply, so this is done with 32x32 bit products. */
+static inline wv_t
+fd_gossip_fnv_mul4( wv_t x ) {
+  wv_t p = wv_bcast( 0x1b3UL );
+  return wv_add( wv_shl( x, 40 ), wv_add( wv_mul_ll( x, p ), wv_shl( wv_mul_ll( wv_shr( x, 32 ), p ), 32 ) ) );
+}
+
+/* fd_gossip_bloom_pos for 4 hashes at once. h0..h3 are the hashes
+   transposed, lane i of hj is the j-th ulong of hash i. Returns the
+   bloom hashes before the reduction modulo the number of bits. */
+static inline wv_t
+fd_gossip_bloom_hash4( wv_t h0, wv_t h1, wv_t h2, wv_t h3, ulong key ) {
+  wv_t k = wv_bcast( key );
+  wv_t m = wv_bcast( 0xffUL );
+  wv_t h[4] = { h0, h1, h2, h3 };
+  for ( ulong j = 0; j < 4U; ++j ) {
+    wv_t w = h[j];
+    for ( ulong b = 0; b < 8U; ++b ) {
+      k = fd_gossip_fnv_mul4( wv_xor( k, wv_and( w, m ) ) );
+      w = wv_shr( w, 8 );
+    }
+  }
+  return k;
+}
+#endif
+
+/* Run a batch of cnt (at most 64) hashes through a bloom filter with
+   nbits bits and the given keys. Returns a bit mask of the hashes that
+   are NOT in the filter. With AVX, the hashes are done 4 at a time,
+   and give the same result as fd_gossip_bloom_pos. */
+static inline ulong
+fd_gossip_bloom_miss_batch( fd_hash_t const * const * hashes, ulong cnt, ulong const * keys, ulong nkeys, ulong const * bits, ulong nbits ) {
+  ulong miss = 0;
+  ulong i = 0;
+#if FD_HAS_AVX
+  for ( ; i+4U <= cnt; i += 4U ) {
+    wv_t h0, h1, h2, h3;
+    wv_transpose_4x4( wv_ldu( hashes[i   ]->ul ), wv_ldu( hashes[i+1U]->ul ),
+                      wv_ldu( hashes[i+2U]->ul ), wv_ldu( hashes[i+3U]->ul ),
+                      h0, h1, h2, h3 );
+    ulong m4 = 0;
+    for ( ulong k = 0; k < nkeys && m4 != 0xfUL; ++k ) {
+      wv_t pos = fd_gossip_bloom_hash4( h0, h1, h2, h3, keys[k] );
+      m4 |= (ulong)!fd_gossip_bloom_test( bits, wv_extract( pos, 0 ) % nbits );
+      m4 |= (ulong)!fd_gossip_bloom_test( bits, wv_extract( pos, 1 ) % nbits ) << 1;
+      m4 |= (ulong)!fd_gossip_bloom_test( bits, wv_extract( pos, 2 ) % nbits ) << 2;
+      m4 |= (ulong)!fd_gossip_bloom_test( bits, wv_extract( pos, 3 ) % nbits ) << 3;
+    }
+    miss |= m4 << i;
+  }
+#endif
+  for ( ; i < cnt; ++i ) {
+    for ( ulong k = 0; k < nkeys; ++k ) {
+      if (!fd_gossip_bloom_test( bits, fd_gossip_bloom_pos( hashes[i], keys[k], nbits ) )) {
+        miss |= 1UL << i;
+        break;
+      }
+    }
+  }
+  return miss;
+}
+
+#endif /* HEADER_fd_src_flamenco_gossip_fd_gossip_bloom_h */
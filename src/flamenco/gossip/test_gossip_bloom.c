@@ -0,0 +1,70 @@
+#include "fd_gossip_bloom.h"
+
+/* Reference for fd_gossip_bloom_miss_batch, one hash and key at a time */
+
+static ulong
+miss_batch_ref( fd_hash_t const * const * hashes, ulong cnt, ulong const * keys, ulong nkeys, ulong const * bits, ulong nbits ) {
+  ulong miss = 0;
+  for ( ulong i = 0; i < cnt; ++i ) {
+    for ( ulong k = 0; k < nkeys; ++k ) {
+      if (!fd_gossip_bloom_test( bits, fd_gossip_bloom_pos( hashes[i], keys[k], nbits ) ))
+        miss |= 1UL << i;
+    }
+  }
+  return miss;
+}
+
+static fd_hash_t hash_mem[ 64 ];
+static ulong     bits    [ 64 ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 1234U, 0UL ) );
+
+  /* Masks */
+
+  FD_TEST( fd_gossip_bloom_mask_ones(  0UL )==~0UL       );
+  FD_TEST( fd_gossip_bloom_mask_ones(  1UL )==(~0UL>>1)  );
+  FD_TEST( fd_gossip_bloom_mask_ones( 63UL )==1UL        );
+  FD_TEST( fd_gossip_bloom_mask_ones( 64UL )==~0UL       );
+
+  /* Batched bloom filter tests match the scalar ones */
+
+  fd_hash_t const * hashes[ 64 ];
+  ulong keys[ 8 ];
+  uint  density[ 4 ] = { 64U, 128U, 192U, 248U }; /* of 256 */
+  ulong miss_tot = 0, test_tot = 0;
+  for ( ulong iter = 0; iter < 100000UL; ++iter ) {
+    ulong cnt   = fd_rng_ulong_roll( rng, 65UL );
+    ulong nkeys = 1UL + fd_rng_ulong_roll( rng, 8UL );
+    ulong nbits = 1UL + fd_rng_ulong_roll( rng, 4096UL );
+    uint  d     = density[ fd_rng_uint_roll( rng, 4U ) ];
+
+    for ( ulong i = 0; i < cnt; ++i ) {
+      for ( ulong j = 0; j < 4U; ++j ) hash_mem[i].ul[j] = fd_rng_ulong( rng );
+      /* Unaligned and repeated hashes too */
+      hashes[i] = &hash_mem[ fd_rng_ulong_roll( rng, cnt ) ];
+    }
+    for ( ulong k = 0; k < nkeys; ++k ) keys[k] = fd_rng_ulong( rng );
+    for ( ulong w = 0; w < (nbits+63UL)/64UL; ++w ) {
+      ulong x = 0;
+      for ( ulong b = 0; b < 64U; ++b ) x |= (ulong)((fd_rng_uint( rng ) & 255U) < d) << b;
+      bits[w] = x;
+    }
+
+    ulong miss = fd_gossip_bloom_miss_batch( hashes, cnt, keys, nkeys, bits, nbits );
+    FD_TEST( miss==miss_batch_ref( hashes, cnt, keys, nkeys, bits, nbits ) );
+    miss_tot += (ulong)fd_ulong_popcnt( miss );
+    test_tot += cnt;
+  }
+  FD_LOG_NOTICE(( "%lu of %lu hashes missed", miss_tot, test_tot ));
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
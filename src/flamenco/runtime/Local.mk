@@ -29,6 +29,11 @@ $(call add-hdrs,fd_runtime.h fd_runtime_err.h)
 $(call add-objs,fd_runtime,fd_flamenco)
 endif
 
+$(call add-hdrs,fd_runtime_prof.h)
+$(call add-objs,fd_runtime_prof,fd_flamenco)
+$(call make-unit-test,test_runtime_prof,test_runtime_prof,fd_flamenco fd_ballet fd_util)
+$(call run-unit-test,test_runtime_prof,)
+
 $(call add-hdrs,fd_system_ids.h)
 $(call add-objs,fd_system_ids,fd_flamenco)
 $(call make-unit-test,test_system_ids,test_system_ids,fd_flamenco fd_util fd_ballet)
@@ -37,4 +42,6 @@ $(call run-unit-test,test_system_ids,)
 ifdef FD_HAS_ROCKSDB
 $(call add-hdrs,fd_rocksdb.h)
 $(call add-objs,fd_rocksdb,fd_flamenco)
+$(call make-unit-test,test_rocksdb_prefetch,test_rocksdb_prefetch,fd_flamenco fd_ballet fd_reedsol fd_util,$(ROCKSDB_LIBS) $(SECP256K1_LIBS))
+$(call run-unit-test,test_rocksdb_prefetch,)
 endif
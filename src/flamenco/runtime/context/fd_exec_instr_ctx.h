@@ -49,7 +49,14 @@ fd_exec_instr_ctx_leave( fd_exec_instr_ctx_t * ctx );
 void *
 fd_exec_instr_ctx_delete( void * mem );
 
-/* Helpers for borrowing instruction accounts */
+/* Helpers for borrowing instruction accounts
+
+   Writable accounts are copy-on-write (see fd_borrowed_account_t).
+   fd_instr_borrowed_account_view returns the account as is, callers
+   must only read it through const_meta and const_data.
+   fd_instr_borrowed_account_view_idx makes writable accounts
+   modifiable, as native programs write through the meta of accounts
+   they viewed. */
 
 static inline int
 fd_instr_borrowed_account_view_idx( fd_exec_instr_ctx_t const * ctx,
@@ -60,6 +67,8 @@ fd_instr_borrowed_account_view_idx( fd_exec_instr_ctx_t const * ctx,
 
   fd_borrowed_account_t * instr_account = ctx->instr->borrowed_accounts[idx];
   FD_TEST( instr_account->const_meta != NULL );
+  if( instr_account->is_cow && fd_instr_acc_is_writable_idx( ctx->instr, idx ) )
+    fd_acc_mgr_make_modifiable( ctx->acc_mgr, instr_account, 0UL );
   *account = instr_account;
   return FD_ACC_MGR_SUCCESS;
 }
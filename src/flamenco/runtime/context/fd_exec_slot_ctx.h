@@ -70,6 +70,8 @@ struct __attribute__((aligned(8UL))) fd_exec_slot_ctx {
 
   fd_sysvar_cache_t *      sysvar_cache;
   fd_account_compute_elem_t * account_compute_table;
+
+  fd_runtime_prof_t *      prof; /* Replay profiler, NULL if not profiling */
 };
 
 #define FD_EXEC_SLOT_CTX_ALIGN     (alignof(fd_exec_slot_ctx_t))
@@ -148,13 +148,7 @@ fd_txn_borrowed_account_modify_idx( fd_exec_txn_ctx_t * ctx,
   }
 
   fd_borrowed_account_t * txn_account = &ctx->borrowed_accounts[idx];
-  if( min_data_sz > txn_account->meta->dlen ) {
-    void * new_txn_account_data = fd_valloc_malloc( ctx->valloc, 8UL, min_data_sz );
-    void * old_txn_account_data = fd_borrowed_account_resize( txn_account, new_txn_account_data, min_data_sz );
-    if( old_txn_account_data != NULL ) {
-      fd_valloc_free( ctx->valloc, old_txn_account_data );
-    }
-  }
+  fd_acc_mgr_make_modifiable( ctx->acc_mgr, txn_account, min_data_sz );
 
   // TODO: check if writable???
   *account = txn_account;
@@ -170,13 +164,7 @@ fd_txn_borrowed_account_modify( fd_exec_txn_ctx_t * ctx,
     if( memcmp( pubkey->uc, ctx->accounts[i].uc, sizeof(fd_pubkey_t) )==0 ) {
       // TODO: check if writable???
       fd_borrowed_account_t * txn_account = &ctx->borrowed_accounts[i];
-      if( min_data_sz > txn_account->const_meta->dlen ) {
-        void * new_txn_account_data = fd_valloc_malloc( ctx->valloc, 8UL, sizeof(fd_account_meta_t) + min_data_sz );
-        void * old_txn_account_data = fd_borrowed_account_resize( txn_account, new_txn_account_data, min_data_sz );
-        if( old_txn_account_data != NULL ) {
-          fd_valloc_free( ctx->valloc, old_txn_account_data );
-        }
-      }
+      fd_acc_mgr_make_modifiable( ctx->acc_mgr, txn_account, min_data_sz );
       *account = txn_account;
       return FD_ACC_MGR_SUCCESS;
     }
@@ -223,6 +211,9 @@ fd_exec_txn_ctx_setup( fd_exec_txn_ctx_t * txn_ctx,
   ) );
 
   txn_ctx->instr_trace_length      = 0;
+
+  txn_ctx->prof_child_ticks = 0L;
+  txn_ctx->prof_child_cus   = 0UL;
 }
 
 void
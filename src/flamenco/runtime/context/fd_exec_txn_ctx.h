@@ -111,6 +111,9 @@ struct __attribute__((aligned(8UL))) fd_exec_txn_ctx {
 
   fd_exec_instr_trace_entry_t instr_trace [FD_MAX_INSTRUCTION_TRACE_LENGTH]; /* Instruction trace */
   ulong instr_trace_length;                                                  /* Number of instructions in the trace */
+
+  long  prof_child_ticks;  /* Ticks spent in the nested instructions and syscalls of the executing instruction */
+  ulong prof_child_cus;    /* CUs consumed by the nested instructions and syscalls of the executing instruction */
 };
 
 #define FD_EXEC_TXN_CTX_ALIGN     (alignof(fd_exec_txn_ctx_t))
@@ -281,44 +281,143 @@ fd_acc_mgr_strerror( int err ) {
   }
 }
 
+void *
+fd_acc_mgr_cow_malloc( fd_acc_mgr_t * acc_mgr,
+                       ulong          sz ) {
+  fd_funk_t * funk = acc_mgr->funk;
+  return fd_alloc_malloc( fd_funk_alloc( funk, fd_funk_wksp( funk ) ), FD_FUNK_VAL_ALIGN, sz );
+}
+
+void
+fd_acc_mgr_cow_free( fd_acc_mgr_t * acc_mgr,
+                     void *         buf ) {
+  fd_funk_t * funk = acc_mgr->funk;
+  fd_alloc_free( fd_funk_alloc( funk, fd_funk_wksp( funk ) ), buf );
+}
+
+fd_borrowed_account_t *
+fd_acc_mgr_make_modifiable( fd_acc_mgr_t *          acc_mgr,
+                            fd_borrowed_account_t * account,
+                            ulong                   min_data_sz ) {
+  if( account->is_cow || !account->meta ) {
+    /* First write to the account, copy it out of the funk record.  If
+       the account does not exist, const_meta is at most a placeholder,
+       and the copy gets fresh metadata instead. */
+    if( !account->orig_meta ) account->const_meta = NULL;
+    ulong   dlen     = fd_borrowed_account_raw_size( account ) - sizeof(fd_account_meta_t);
+    ulong   new_dlen = fd_ulong_max( dlen, min_data_sz );
+    uchar * buf      = fd_acc_mgr_cow_malloc( acc_mgr, sizeof(fd_account_meta_t)+new_dlen );
+    if( FD_UNLIKELY( !buf ) ) FD_LOG_ERR(( "unable to allocate account %32J (%lu bytes)", account->pubkey, new_dlen ));
+
+    account->is_cow = 0;
+    fd_borrowed_account_make_modifiable( account, buf );
+    fd_memset( buf+sizeof(fd_account_meta_t)+dlen, 0, new_dlen-dlen );
+    account->meta->dlen    = new_dlen;
+    account->is_funk_alloc = 1;
+    return account;
+  }
+
+  if( min_data_sz > account->meta->dlen ) {
+    /* TODO expensive copy */
+    void * buf = fd_acc_mgr_cow_malloc( acc_mgr, sizeof(fd_account_meta_t)+min_data_sz );
+    if( FD_UNLIKELY( !buf ) ) FD_LOG_ERR(( "unable to allocate account %32J (%lu bytes)", account->pubkey, min_data_sz ));
+
+    void * old_buf = fd_borrowed_account_resize( account, buf, min_data_sz );
+    if( old_buf != NULL ) {
+      fd_acc_mgr_cow_free( acc_mgr, old_buf );
+    }
+    account->is_funk_alloc = 1;
+  }
+
+  return account;
+}
+
 int
 fd_acc_mgr_save( fd_acc_mgr_t *          acc_mgr,
                  fd_borrowed_account_t * account ) {
+  fd_wksp_t * wksp = fd_funk_wksp( acc_mgr->funk );
+
+  if( account->is_cow ) {
+    /* The account was never written to.  Copy it over if the record is
+       not the one it was read from, and mark it as touched. */
+    if( account->rec == NULL ) return FD_ACC_MGR_SUCCESS;
+    fd_account_meta_t * raw = fd_funk_val( account->rec, wksp );
+    if( raw != account->const_meta ) {
+      fd_memcpy( raw, account->const_meta, sizeof(fd_account_meta_t)+account->const_meta->dlen );
+    }
+    if( account->cow_slot != ULONG_MAX ) {
+      raw->slot = account->cow_slot;
+    }
+    return FD_ACC_MGR_SUCCESS;
+  }
+
   if( account->meta == NULL || account->rec == NULL ) {
     // The meta is NULL so the account is not writable.
     FD_LOG_DEBUG(( "fd_acc_mgr_save: account is not writable: %32J", account->pubkey ));
     return FD_ACC_MGR_SUCCESS;
   }
 
-  fd_wksp_t * wksp = fd_funk_wksp( acc_mgr->funk );
   ulong reclen = sizeof(fd_account_meta_t)+account->const_meta->dlen;
   uchar * raw = fd_funk_val( account->rec, wksp );
-  fd_memcpy( raw, account->meta, reclen );
+  if( raw != (uchar *)account->meta ) {
+    fd_memcpy( raw, account->meta, reclen );
+  }
 
   return FD_ACC_MGR_SUCCESS;
 }
 
-int
-fd_acc_mgr_save_non_tpool( fd_acc_mgr_t *          acc_mgr,
-                           fd_funk_txn_t *         txn,
-                           fd_borrowed_account_t * account ) {
-  fd_funk_rec_key_t key = fd_acc_funk_key( account->pubkey );
+/* fd_acc_mgr_save_prepare finds or creates the funk record of account
+   in txn and gets its value ready for fd_acc_mgr_save.  If the account
+   copy was allocated with fd_acc_mgr_cow_malloc, it becomes the record
+   value.  Not thread safe. */
+
+static void
+fd_acc_mgr_save_prepare( fd_acc_mgr_t *          acc_mgr,
+                         fd_funk_txn_t *         txn,
+                         fd_borrowed_account_t * account ) {
   fd_funk_t * funk = acc_mgr->funk;
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  fd_funk_rec_key_t key = fd_acc_funk_key( account->pubkey );
   fd_funk_rec_t * rec = (fd_funk_rec_t *)fd_funk_rec_query( funk, txn, &key );
   if( rec == NULL ) {
     int err;
     rec = (fd_funk_rec_t *)fd_funk_rec_insert( funk, txn, &key, &err );
-    if( rec == NULL ) FD_LOG_ERR(( "unable to insert a new record, error %s", err ));
+    if( rec == NULL ) FD_LOG_ERR(( "unable to insert a new record, error %d", err ));
   }
   account->rec = rec;
   if ( acc_mgr->slots_per_epoch != 0 )
     fd_funk_part_set(funk, rec, (uint)fd_rent_lists_key_to_bucket( acc_mgr, rec ));
+
+  /* Untouched account that was read from this record, saved in place */
+  if( account->is_cow && rec == account->const_rec ) return;
+
+  /* Untouched account that did not exist, saved with fresh metadata */
+  if( account->is_cow && !account->orig_meta ) fd_acc_mgr_make_modifiable( acc_mgr, account, 0UL );
+
   ulong reclen = sizeof(fd_account_meta_t)+account->const_meta->dlen;
-  fd_wksp_t * wksp = fd_funk_wksp( acc_mgr->funk );
   int err;
-  if( fd_funk_val_truncate( account->rec, reclen, fd_funk_alloc( acc_mgr->funk, wksp ), wksp, &err ) == NULL ) {
+  if( account->is_funk_alloc && account->meta != NULL ) {
+    if( fd_funk_val_install( rec, account->meta, reclen, fd_funk_alloc( funk, wksp ), wksp, &err ) == NULL ) {
+      FD_LOG_ERR(( "unable to install account value, err %d", err ));
+    }
+    /* The record owns the copy now */
+    account->is_funk_alloc = 0;
+    account->orig_rec  = account->const_rec = rec;
+    account->orig_meta = account->meta;
+    account->orig_data = account->data;
+    return;
+  }
+
+  if( fd_funk_val_truncate( rec, reclen, fd_funk_alloc( funk, wksp ), wksp, &err ) == NULL ) {
     FD_LOG_ERR(( "unable to allocate account value, err %d", err ));
   }
+}
+
+int
+fd_acc_mgr_save_non_tpool( fd_acc_mgr_t *          acc_mgr,
+                           fd_funk_txn_t *         txn,
+                           fd_borrowed_account_t * account ) {
+  fd_acc_mgr_save_prepare( acc_mgr, txn, account );
   return fd_acc_mgr_save( acc_mgr, account );
 }
 
@@ -417,21 +516,7 @@ fd_acc_mgr_save_many_tpool( fd_acc_mgr_t *          acc_mgr,
       ulong batch_idx = i & batch_mask;
       fd_acc_mgr_save_task_info_t * task_info = &task_infos[batch_idx];
       task_info->accounts[task_info->accounts_cnt++] = account;
-      fd_funk_rec_key_t key = fd_acc_funk_key( account->pubkey );
-      fd_funk_rec_t * rec = (fd_funk_rec_t *)fd_funk_rec_query( funk, txn, &key );
-      if( rec == NULL ) {
-        int err;
-        rec = (fd_funk_rec_t *)fd_funk_rec_insert( funk, txn, &key, &err );
-        if( rec == NULL ) FD_LOG_ERR(( "unable to insert a new record, error %s", err ));
-      }
-      account->rec = rec;
-      if ( acc_mgr->slots_per_epoch != 0 )
-        fd_funk_part_set(funk, rec, (uint)fd_rent_lists_key_to_bucket( acc_mgr, rec ));
-      ulong reclen = sizeof(fd_account_meta_t)+account->const_meta->dlen;
-      int err;
-      if( fd_funk_val_truncate( account->rec, reclen, fd_funk_alloc( acc_mgr->funk, wksp ), wksp, &err ) == NULL ) {
-        FD_LOG_ERR(( "unable to allocate account value, err %d", err ));
-      }
+      fd_acc_mgr_save_prepare( acc_mgr, txn, account );
     }
 
     fd_acc_mgr_save_task_args_t task_args = {
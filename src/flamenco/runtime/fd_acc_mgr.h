@@ -232,6 +232,14 @@ fd_acc_mgr_modify( fd_acc_mgr_t *          acc_mgr,
                    ulong                   min_data_sz,
                    fd_borrowed_account_t * account );
 
+/* fd_acc_mgr_save writes back the modifications of account to its funk
+   record, which must have been prepared by one of the functions
+   below.  Accounts that were never copied (still copy-on-write) are
+   written back in place if the record is the one they were read from.
+   Accounts whose copy was allocated with fd_acc_mgr_cow_malloc have
+   their copy installed as the record value without copying, after
+   which the account no longer owns it. */
+
 int
 fd_acc_mgr_save( fd_acc_mgr_t *          acc_mgr,
                  fd_borrowed_account_t * account );
@@ -251,6 +259,35 @@ fd_acc_mgr_save_many_tpool( fd_acc_mgr_t *           acc_mgr,
                             fd_tpool_t *             tpool,
                             ulong                    max_workers );
 
+/* Copy-on-write API **************************************************/
+
+/* fd_acc_mgr_cow_{malloc,free} allocate and free buffers for
+   modifiable copies of borrowed accounts.  Buffers come from the funk
+   allocator, so that fd_acc_mgr_save can hand them over to the funk
+   record without copying the account again.  fd_acc_mgr_cow_malloc
+   returns NULL on failure.  fd_acc_mgr_cow_free is a no-op for NULL. */
+
+void *
+fd_acc_mgr_cow_malloc( fd_acc_mgr_t * acc_mgr,
+                       ulong          sz );
+
+void
+fd_acc_mgr_cow_free( fd_acc_mgr_t * acc_mgr,
+                     void *         buf );
+
+/* fd_acc_mgr_make_modifiable ensures that account has a modifiable
+   copy with room for at least min_data_sz bytes of data.  If the
+   account is still copy-on-write (see fd_borrowed_account_t) or was
+   never made modifiable, it is copied now, or gets fresh metadata if
+   it does not exist.  If the account data is shorter than min_data_sz, the
+   account is grown to min_data_sz bytes, zero filled.  Otherwise, this
+   is a no-op.  Returns account.  Logs and aborts if out of memory. */
+
+fd_borrowed_account_t *
+fd_acc_mgr_make_modifiable( fd_acc_mgr_t *          acc_mgr,
+                            fd_borrowed_account_t * account,
+                            ulong                   min_data_sz );
+
 void
 fd_acc_mgr_lock( fd_acc_mgr_t * acc_mgr );
 
@@ -18,6 +18,7 @@ fd_borrowed_account_init( void * ptr ) {
   fd_borrowed_account_t * ret = (fd_borrowed_account_t *)ptr;
   ret->starting_dlen     = ULONG_MAX;
   ret->starting_lamports = ULONG_MAX;
+  ret->cow_slot          = ULONG_MAX;
 
   FD_COMPILER_MFENCE();
   ret->magic = FD_BORROWED_ACCOUNT_MAGIC;
@@ -94,5 +95,10 @@ fd_borrowed_account_restore( fd_borrowed_account_t * borrowed_account ) {
 
 void *
 fd_borrowed_account_destroy( fd_borrowed_account_t * borrowed_account ) {
-  return borrowed_account->meta;
+  fd_account_meta_t * meta = borrowed_account->meta;
+  if( meta != borrowed_account->orig_meta ) {
+    return meta;
+  }
+
+  return NULL;
 }
@@ -29,6 +29,23 @@ struct __attribute__((aligned(8UL))) fd_borrowed_account {
 
   ulong starting_owner_dlen;
 
+  /* Copy-on-write state.  While is_cow is set, the account is writable
+     but has not been written to yet: meta, data and rec are NULL and
+     the account is read through const_meta and const_data, which point
+     into the funk record (or at a placeholder with zero lamports and
+     no data if the account does not exist).  The first modify copies
+     the account or sets up fresh metadata for it (see
+     fd_acc_mgr_make_modifiable).  cow_slot is the slot the account was
+     last touched in if it is saved without ever being copied, or
+     ULONG_MAX to leave the slot as is.  is_funk_alloc is set when meta
+     was allocated from the funk allocator, in which case saving the
+     account hands the buffer over to the funk record instead of
+     copying it. */
+
+  uchar is_cow;
+  uchar is_funk_alloc;
+  ulong cow_slot;
+
   /* Provide read/write mutual exclusion semantics.
      Used for single-threaded logic only, thus not comparable to a
      data synchronization lock. */
@@ -66,6 +83,11 @@ fd_borrowed_account_make_modifiable( fd_borrowed_account_t * borrowed_account,
 void *
 fd_borrowed_account_restore( fd_borrowed_account_t * borrowed_account );
 
+/* fd_borrowed_account_destroy returns the buffer holding the modifiable
+   copy of the account, which the caller should free, or NULL if the
+   account does not own one (never made modifiable, or the copy was
+   handed over to funk on save). */
+
 void *
 fd_borrowed_account_destroy( fd_borrowed_account_t * borrowed_account );
 
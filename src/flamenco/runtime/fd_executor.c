@@ -2,6 +2,7 @@
 #include "fd_acc_mgr.h"
 #include "fd_hashes.h"
 #include "fd_runtime_err.h"
+#include "fd_runtime_prof.h"
 #include "context/fd_exec_slot_ctx.h"
 #include "context/fd_exec_txn_ctx.h"
 #include "context/fd_exec_instr_ctx.h"
@@ -702,9 +703,9 @@ dump_instr_to_protobuf( fd_exec_txn_ctx_t *txn_ctx,
   } FD_SCRATCH_SCOPE_END;
 }
 
-int
-fd_execute_instr( fd_exec_txn_ctx_t * txn_ctx,
-                  fd_instr_info_t *   instr ) {
+static int
+fd_execute_instr_private( fd_exec_txn_ctx_t * txn_ctx,
+                          fd_instr_info_t *   instr ) {
   FD_SCRATCH_SCOPE_BEGIN {
     ulong max_num_instructions = FD_FEATURE_ACTIVE( txn_ctx->slot_ctx, limit_max_instruction_trace_length ) ? FD_MAX_INSTRUCTION_TRACE_LENGTH : ULONG_MAX;
     if( txn_ctx->num_instructions >= max_num_instructions ) {
@@ -816,6 +817,36 @@ fd_execute_instr( fd_exec_txn_ctx_t * txn_ctx,
   } FD_SCRATCH_SCOPE_END;
 }
 
+int
+fd_execute_instr( fd_exec_txn_ctx_t * txn_ctx,
+                  fd_instr_info_t *   instr ) {
+  fd_runtime_prof_t * prof = txn_ctx->slot_ctx->prof;
+  if( FD_LIKELY( !prof ) ) return fd_execute_instr_private( txn_ctx, instr );
+
+  /* Nested instructions (CPI) and syscalls add their ticks and CUs to
+     txn_ctx->prof_child_*, so only the instruction's own share gets
+     charged to its program. */
+
+  long  parent_child_ticks = txn_ctx->prof_child_ticks;
+  ulong parent_child_cus   = txn_ctx->prof_child_cus;
+  txn_ctx->prof_child_ticks = 0L;
+  txn_ctx->prof_child_cus   = 0UL;
+
+  ulong cus   = txn_ctx->compute_meter;
+  long  ticks = -fd_tickcount();
+  int   err   = fd_execute_instr_private( txn_ctx, instr );
+  ticks += fd_tickcount();
+  cus    = fd_ulong_sat_sub( cus, txn_ctx->compute_meter );
+
+  ulong ix = instr->data_sz ? (ulong)instr->data[0] : FD_RUNTIME_PROF_IX_NONE;
+  fd_runtime_prof_instr( prof, &instr->program_id_pubkey, ix,
+                         fd_ulong_sat_sub( cus, txn_ctx->prof_child_cus ), ticks - txn_ctx->prof_child_ticks );
+
+  txn_ctx->prof_child_ticks = parent_child_ticks + ticks;
+  txn_ctx->prof_child_cus   = parent_child_cus   + cus;
+  return err;
+}
+
 void
 fd_executor_setup_borrowed_accounts_for_txn( fd_exec_txn_ctx_t * txn_ctx ) {
   ulong j = 0;
@@ -830,12 +861,14 @@ fd_executor_setup_borrowed_accounts_for_txn( fd_exec_txn_ctx_t * txn_ctx ) {
       // FD_LOG_WARNING(( "fd_acc_mgr_view(%32J) failed (%d-%s)", acc->uc, err, fd_acc_mgr_strerror( err ) ));
     }
 
+    /* Writable accounts are only copied out of funk (or, if they do not
+       exist yet, get their metadata set up) on first write, see
+       fd_acc_mgr_make_modifiable */
     if( fd_txn_account_is_writable_idx( txn_ctx->txn_descriptor, txn_ctx->accounts, (int)i ) ) {
-        void * borrowed_account_data = fd_valloc_malloc( txn_ctx->valloc, 8UL, fd_borrowed_account_raw_size( borrowed_account ) );
-        fd_borrowed_account_make_modifiable( borrowed_account, borrowed_account_data );
+      borrowed_account->is_cow = 1;
     }
 
-    fd_account_meta_t const * meta = borrowed_account->const_meta ? borrowed_account->const_meta : borrowed_account->meta;
+    fd_account_meta_t const * meta = borrowed_account->const_meta;
     if (meta == NULL) {
       static const fd_account_meta_t sentinel = { .magic = FD_ACCOUNT_META_MAGIC };
       borrowed_account->const_meta        = &sentinel;
@@ -970,7 +1003,7 @@ fd_execute_txn_prepare_phase3( fd_exec_slot_ctx_t * slot_ctx,
   txn_ctx->funk_txn = parent_txn;
 
   if (FD_FEATURE_ACTIVE( txn_ctx->slot_ctx, apply_cost_tracker_during_replay ) ) {
-    ulong est_cost = fd_pack_compute_cost( txn, &txn->flags );
+    ulong est_cost = fd_pack_compute_cost( txn, &txn->flags, NULL );
     if( slot_ctx->total_compute_units_requested + est_cost <= MAX_COMPUTE_UNITS_PER_BLOCK ) {
       slot_ctx->total_compute_units_requested += est_cost;
     } else {
@@ -1047,7 +1080,7 @@ fd_execute_txn_finalize( fd_exec_slot_ctx_t * slot_ctx,
       fd_borrowed_account_t * acc_rec = &txn_ctx->borrowed_accounts[i];
       void * acc_rec_data = fd_borrowed_account_destroy( acc_rec );
       if( acc_rec_data != NULL ) {
-        fd_valloc_free( txn_ctx->valloc, acc_rec_data );
+        fd_acc_mgr_cow_free( txn_ctx->acc_mgr, acc_rec_data );
       }
     }
 
@@ -1063,6 +1096,7 @@ fd_execute_txn_finalize( fd_exec_slot_ctx_t * slot_ctx,
     fd_borrowed_account_t * acc_rec = &txn_ctx->borrowed_accounts[i];
 
     if( txn_ctx->unknown_accounts[i] ) {
+      fd_acc_mgr_make_modifiable( txn_ctx->acc_mgr, acc_rec, 0UL );
       memset( acc_rec->meta->hash, 0xFF, sizeof(fd_hash_t) );
       if( FD_FEATURE_ACTIVE( slot_ctx, set_exempt_rent_epoch_max ) ) {
         fd_txn_set_exempt_rent_epoch_max( txn_ctx, &txn_ctx->accounts[i] );
@@ -1077,7 +1111,7 @@ fd_execute_txn_finalize( fd_exec_slot_ctx_t * slot_ctx,
 
     void * borrow_account_data = fd_borrowed_account_destroy( acc_rec );
     if( borrow_account_data != NULL ) {
-      fd_valloc_free( txn_ctx->valloc, borrow_account_data );
+      fd_acc_mgr_cow_free( txn_ctx->acc_mgr, borrow_account_data );
     }
   }
 
@@ -1206,6 +1240,14 @@ fd_execute_txn( fd_exec_txn_ctx_t * txn_ctx ) {
         continue;
       }
 
+      /* Stamp the slot on untouched accounts at save time, rather than
+         copying them just for that */
+      if( acc_rec->is_cow && acc_rec->const_meta->info.lamports != 0 ) {
+        acc_rec->cow_slot = txn_ctx->slot_ctx->slot_bank.slot;
+        continue;
+      }
+      fd_acc_mgr_make_modifiable( txn_ctx->acc_mgr, acc_rec, 0UL );
+
       acc_rec->meta->slot = txn_ctx->slot_ctx->slot_bank.slot;
 
       if( acc_rec->meta->info.lamports == 0 ) {
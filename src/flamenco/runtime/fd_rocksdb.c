@@ -507,162 +507,207 @@ fd_rocksdb_insert_entry( fd_rocksdb_t * db,
 }
 
 int
-fd_rocksdb_import_block_blockstore( fd_rocksdb_t *    db,
-                                    fd_slot_meta_t *  m,
-                                    fd_blockstore_t * blockstore,
-                                    int txnstatus,
-                                    const uchar *hash_override ) // How much effort should we go to here to confirm the size of the hash override?
-{
-  fd_blockstore_start_write( blockstore );
-
-  ulong slot = m->slot;
-  ulong start_idx = 0;
-  ulong end_idx = m->received;
+fd_rocksdb_block_read( fd_rocksdb_t *         db,
+                       fd_slot_meta_t const * m,
+                       uchar const *          hash_override,
+                       fd_rocksdb_block_t *   blk ) {
+  fd_memset( blk, 0, sizeof(fd_rocksdb_block_t) );
+  blk->db   = db;
+  blk->slot = m->slot;
+
+  ulong slot      = m->slot;
+  ulong shred_cnt = m->received;
+
+  /* Copy out the slot's data shreds (validating them on the way) */
+
+  ulong buf_max = 64UL*FD_SHRED_MAX_SZ;
+  blk->shred_off = (ulong *)malloc( (shred_cnt+1UL)*sizeof(ulong) );
+  blk->shred_buf = (uchar *)malloc( buf_max );
+  if( FD_UNLIKELY( !blk->shred_off || !blk->shred_buf ) ) {
+    FD_LOG_WARNING(( "malloc failed for slot %lu", slot ));
+    fd_rocksdb_block_destroy( blk );
+    return -1;
+  }
 
   rocksdb_iterator_t* iter = rocksdb_create_iterator_cf(db->db, db->ro, db->cf_handles[FD_ROCKSDB_CFIDX_DATA_SHRED]);
 
   char k[16];
   ulong slot_be = *((ulong *) &k[0]) = fd_ulong_bswap(slot);
-  *((ulong *) &k[8]) = fd_ulong_bswap(start_idx);
+  *((ulong *) &k[8]) = fd_ulong_bswap(0UL);
 
   rocksdb_iter_seek(iter, (const char *) k, sizeof(k));
 
-  for (ulong i = start_idx; i < end_idx; i++) {
-    ulong cur_slot, index;
-    uchar valid = rocksdb_iter_valid(iter);
+  ulong buf_sz = 0UL;
+  for( ulong i=0UL; i<shred_cnt; i++ ) {
+    blk->shred_off[ i ] = buf_sz;
 
-    if (valid) {
-      size_t klen = 0;
-      const char* key = rocksdb_iter_key(iter, &klen); // There is no need to free key
-      if (klen != 16)  // invalid key
-        continue;
-      cur_slot = fd_ulong_bswap(*((ulong *) &key[0]));
-      index = fd_ulong_bswap(*((ulong *) &key[8]));
+    if( FD_UNLIKELY( !rocksdb_iter_valid( iter ) ) ) {
+      FD_LOG_WARNING(("missing shreds for slot %ld", slot));
+      goto fail;
+    }
+
+    size_t klen = 0;
+    const char* key = rocksdb_iter_key(iter, &klen); // There is no need to free key
+    if( FD_UNLIKELY( klen!=16 ) ) {
+      FD_LOG_WARNING(("invalid shred key for slot %ld", slot));
+      goto fail;
     }
+    ulong cur_slot = fd_ulong_bswap(*((ulong *) &key[0]));
+    ulong index    = fd_ulong_bswap(*((ulong *) &key[8]));
 
-    if (!valid || cur_slot != slot) {
+    if( FD_UNLIKELY( cur_slot!=slot ) ) {
       FD_LOG_WARNING(("missing shreds for slot %ld", slot));
-      rocksdb_iter_destroy(iter);
-      fd_blockstore_end_write(blockstore);
-      return -1;
+      goto fail;
     }
 
-    if (index != i) {
+    if( FD_UNLIKELY( index!=i ) ) {
       FD_LOG_WARNING(("missing shred %ld at index %ld for slot %ld", i, index, slot));
-      rocksdb_iter_destroy(iter);
-      fd_blockstore_end_write(blockstore);
-      return -1;
+      goto fail;
     }
 
     size_t dlen = 0;
     // Data was first copied from disk into memory to make it available to this API
     const unsigned char *data = (const unsigned char *) rocksdb_iter_value(iter, &dlen);
-    if (data == NULL) {
+    if( FD_UNLIKELY( !data ) ) {
       FD_LOG_WARNING(("failed to read shred %ld/%ld", slot, i));
-      rocksdb_iter_destroy(iter);
-      fd_blockstore_end_write(blockstore);
-      return -1;
+      goto fail;
     }
 
-    // This just correctly selects from inside the data pointer to the
-    // actual data without a memory copy
-    fd_shred_t const * shred = fd_shred_parse( data, (ulong) dlen );
-    if (shred == NULL) {
+    if( FD_UNLIKELY( !fd_shred_parse( data, (ulong) dlen ) ) ) {
       FD_LOG_WARNING(("failed to parse shred %ld/%ld", slot, i));
-      rocksdb_iter_destroy(iter);
-      fd_blockstore_end_write(blockstore);
-      return -1;
+      goto fail;
     }
-    int rc = fd_buf_shred_insert( blockstore, shred );
-    if (rc != FD_BLOCKSTORE_OK_SLOT_COMPLETE && rc != FD_BLOCKSTORE_OK) {
-      FD_LOG_WARNING(("failed to store shred %ld/%ld", slot, i));
-      rocksdb_iter_destroy(iter);
-      fd_blockstore_end_write(blockstore);
-      return -1;
+
+    if( FD_UNLIKELY( buf_sz+dlen>buf_max ) ) {
+      buf_max = fd_ulong_max( 2UL*buf_max, buf_sz+dlen );
+      uchar * buf = (uchar *)realloc( blk->shred_buf, buf_max );
+      if( FD_UNLIKELY( !buf ) ) {
+        FD_LOG_WARNING(( "realloc failed for slot %lu", slot ));
+        goto fail;
+      }
+      blk->shred_buf = buf;
     }
+    fd_memcpy( blk->shred_buf + buf_sz, data, dlen );
+    buf_sz += dlen;
 
     rocksdb_iter_next(iter);
   }
+  blk->shred_off[ shred_cnt ] = buf_sz;
+  blk->shred_cnt              = shred_cnt;
 
   rocksdb_iter_destroy(iter);
 
-  fd_wksp_t * wksp = fd_wksp_containing( blockstore );
-  fd_blockstore_slot_map_t * block_map = fd_blockstore_slot_map( blockstore );
-  fd_blockstore_slot_map_t * block_entry = fd_blockstore_slot_map_query( block_map, &slot, NULL );
-  if( FD_LIKELY( block_entry && block_entry->block_gaddr ) ) {
-    fd_block_t * blk = fd_wksp_laddr_fast( wksp, block_entry->block_gaddr );
-    size_t vallen = 0;
-    char * err = NULL;
-    char * res = rocksdb_get_cf(
-      db->db,
-      db->ro,
-      db->cf_handles[ FD_ROCKSDB_CFIDX_BLOCKTIME ],
-      (char const *)&slot_be, sizeof(ulong),
-      &vallen,
-      &err );
-    if( FD_UNLIKELY( err ) ) {
-      FD_LOG_WARNING(( "rocksdb: %s", err ));
-      free( err );
-    } else if(vallen == sizeof(ulong)) {
-      blk->ts = (*(long*)res)*((long)1e9); /* Convert to nanos */
-      free(res);
-    }
+  /* Block metadata */
+
+  size_t vallen = 0;
+  char * err = NULL;
+  char * res = rocksdb_get_cf(
+    db->db,
+    db->ro,
+    db->cf_handles[ FD_ROCKSDB_CFIDX_BLOCKTIME ],
+    (char const *)&slot_be, sizeof(ulong),
+    &vallen,
+    &err );
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "rocksdb: %s", err ));
+    free( err );
+  } else if(vallen == sizeof(ulong)) {
+    blk->ts     = (*(long*)res)*((long)1e9); /* Convert to nanos */
+    blk->has_ts = 1;
+  }
+  free( res );
+
+  vallen = 0;
+  err = NULL;
+  res = rocksdb_get_cf(
+    db->db,
+    db->ro,
+    db->cf_handles[ FD_ROCKSDB_CFIDX_BLOCK_HEIGHT ],
+    (char const *)&slot_be, sizeof(ulong),
+    &vallen,
+    &err );
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "rocksdb: %s", err ));
+    free( err );
+  } else if(vallen == sizeof(ulong)) {
+    blk->height = *(ulong*)res;
+  }
+  free( res );
 
+  if( hash_override ) {
+    fd_memcpy( blk->bank_hash.hash, hash_override, 32UL );
+    blk->has_bank_hash = 1;
+  } else {
     vallen = 0;
     err = NULL;
     res = rocksdb_get_cf(
       db->db,
       db->ro,
-      db->cf_handles[ FD_ROCKSDB_CFIDX_BLOCK_HEIGHT ],
+      db->cf_handles[ FD_ROCKSDB_CFIDX_BANK_HASHES ],
       (char const *)&slot_be, sizeof(ulong),
       &vallen,
       &err );
-    blk->height = 0;
     if( FD_UNLIKELY( err ) ) {
       FD_LOG_WARNING(( "rocksdb: %s", err ));
       free( err );
-    } else if(vallen == sizeof(ulong)) {
-      blk->height = *(ulong*)res;
-      free(res);
-    }
-
-    vallen = 0;
-    err = NULL;
-    if (NULL != hash_override)
-      fd_memcpy( blk->bank_hash.hash, hash_override, 32UL );
-    else {
-      res = rocksdb_get_cf(
-        db->db,
-          db->ro,
-          db->cf_handles[ FD_ROCKSDB_CFIDX_BANK_HASHES ],
-          (char const *)&slot_be, sizeof(ulong),
-          &vallen,
-          &err );
-      if( FD_UNLIKELY( err ) ) {
-        FD_LOG_WARNING(( "rocksdb: %s", err ));
-        free( err );
-      } else {
-        fd_scratch_push();
-        fd_bincode_decode_ctx_t decode = {
-          .data    = res,
-          .dataend = res + vallen,
-          .valloc  = fd_scratch_virtual(),
-        };
-        fd_frozen_hash_versioned_t versioned;
-        int decode_err = fd_frozen_hash_versioned_decode( &versioned, &decode );
-        if( FD_UNLIKELY( decode_err!=FD_BINCODE_SUCCESS ) ) goto cleanup;
-        if( FD_UNLIKELY( decode.data!=decode.dataend    ) ) goto cleanup;
-        if( FD_UNLIKELY( versioned.discriminant !=fd_frozen_hash_versioned_enum_current ) ) goto cleanup;
-        /* Success */
+    } else if( res ) {
+      /* Not scratch backed as this can run on threads without scratch */
+      fd_bincode_decode_ctx_t decode = {
+        .data    = res,
+        .dataend = res + vallen,
+        .valloc  = fd_libc_alloc_virtual(),
+      };
+      fd_frozen_hash_versioned_t versioned;
+      int decode_err = fd_frozen_hash_versioned_decode( &versioned, &decode );
+      if( FD_LIKELY( decode_err==FD_BINCODE_SUCCESS                                 &&
+                     decode.data==decode.dataend                                    &&
+                     versioned.discriminant==fd_frozen_hash_versioned_enum_current ) ) {
         fd_memcpy( blk->bank_hash.hash, versioned.inner.current.frozen_hash.hash, 32UL );
-      cleanup:
-        free( res );
-        fd_scratch_pop();
+        blk->has_bank_hash = 1;
       }
+      free( res );
+    }
+  }
+
+  return 0;
+
+fail:
+  rocksdb_iter_destroy(iter);
+  fd_rocksdb_block_destroy( blk );
+  return -1;
+}
+
+int
+fd_rocksdb_block_insert( fd_rocksdb_block_t const * rblk,
+                         fd_blockstore_t *          blockstore,
+                         int                        txnstatus ) {
+  fd_blockstore_start_write( blockstore );
+
+  ulong slot = rblk->slot;
+
+  for( ulong i=0UL; i<rblk->shred_cnt; i++ ) {
+    /* Validated by fd_rocksdb_block_read */
+    fd_shred_t const * shred = fd_shred_parse( rblk->shred_buf + rblk->shred_off[ i ], rblk->shred_off[ i+1UL ] - rblk->shred_off[ i ] );
+    int rc = fd_buf_shred_insert( blockstore, shred );
+    if (rc != FD_BLOCKSTORE_OK_SLOT_COMPLETE && rc != FD_BLOCKSTORE_OK) {
+      FD_LOG_WARNING(("failed to store shred %ld/%ld", slot, i));
+      fd_blockstore_end_write(blockstore);
+      return -1;
     }
   }
 
+  fd_wksp_t * wksp = fd_wksp_containing( blockstore );
+  fd_blockstore_slot_map_t * block_map = fd_blockstore_slot_map( blockstore );
+  fd_blockstore_slot_map_t * block_entry = fd_blockstore_slot_map_query( block_map, &slot, NULL );
+  if( FD_LIKELY( block_entry && block_entry->block_gaddr ) ) {
+    fd_block_t * blk = fd_wksp_laddr_fast( wksp, block_entry->block_gaddr );
+    if( rblk->has_ts        ) blk->ts = rblk->ts;
+    blk->height = rblk->height;
+    if( rblk->has_bank_hash ) fd_memcpy( blk->bank_hash.hash, rblk->bank_hash.hash, 32UL );
+  }
+
   if( txnstatus ) {
+    fd_rocksdb_t * db = rblk->db;
     fd_alloc_t * alloc = fd_wksp_laddr_fast( wksp, blockstore->alloc_gaddr );
     fd_blockstore_txn_map_t *   txn_map   = fd_wksp_laddr_fast( wksp, blockstore->txn_map_gaddr );
     if( FD_LIKELY( block_entry && block_entry->block_gaddr ) ) {
@@ -712,38 +757,352 @@ fd_rocksdb_import_block_blockstore( fd_rocksdb_t *    db,
   return 0;
 }
 
+void
+fd_rocksdb_block_destroy( fd_rocksdb_block_t * blk ) {
+  free( blk->shred_buf );
+  free( blk->shred_off );
+  blk->shred_buf = NULL;
+  blk->shred_off = NULL;
+  blk->shred_cnt = 0UL;
+}
+
 int
-fd_rocksdb_import_block_shredcap( fd_rocksdb_t *             db,
-                                    fd_slot_meta_t *           metadata,
-                                    fd_io_buffered_ostream_t * ostream,
-                                    fd_io_buffered_ostream_t * bank_hash_ostream ) {
-  ulong slot = metadata->slot;
+fd_rocksdb_import_block_blockstore( fd_rocksdb_t *    db,
+                                    fd_slot_meta_t *  m,
+                                    fd_blockstore_t * blockstore,
+                                    int txnstatus,
+                                    const uchar *hash_override ) // How much effort should we go to here to confirm the size of the hash override?
+{
+  fd_rocksdb_block_t blk[1];
+  if( FD_UNLIKELY( fd_rocksdb_block_read( db, m, hash_override, blk ) ) ) return -1;
+  int err = fd_rocksdb_block_insert( blk, blockstore, txnstatus );
+  fd_rocksdb_block_destroy( blk );
+  return err;
+}
 
-  /* pre_slot_hdr_file_offset is the current offset within the file, but
-     pre_slot_hdr_file_offset_real accounts for the size of the buffer that has
-     been filled but not flushed. This value is used to jump back into the file to
-     populate the payload_sz for the slot header */
-  long pre_slot_hdr_file_offset      = lseek( ostream->fd, 0, SEEK_CUR );
-  long pre_slot_hdr_file_offset_real = pre_slot_hdr_file_offset + (long)ostream->wbuf_used;
-  if ( FD_UNLIKELY( pre_slot_hdr_file_offset == -1 ) ) {
-    FD_LOG_ERR(( "lseek error while seeking to current location" ));
-  }
-
-  /* Write slot specific header */
-  fd_shredcap_slot_hdr_t slot_hdr;
-  slot_hdr.magic                 = FD_SHREDCAP_SLOT_HDR_MAGIC;
-  slot_hdr.version               = FD_SHREDCAP_SLOT_HDR_VERSION;
-  slot_hdr.payload_sz            = ULONG_MAX; /* This value is populated after slot is processed */
-  slot_hdr.slot                  = metadata->slot;
-  slot_hdr.consumed              = metadata->consumed;
-  slot_hdr.received              = metadata->received;
-  slot_hdr.first_shred_timestamp = metadata->first_shred_timestamp;
-  slot_hdr.last_index            = metadata->last_index;
-  slot_hdr.parent_slot           = metadata->parent_slot;
-  fd_io_buffered_ostream_write( ostream, &slot_hdr, FD_SHREDCAP_SLOT_HDR_FOOTPRINT );
+/* Prefetching ********************************************************/
+
+/* fd_rocksdb_prefetch_cursor_restore positions cur at pos, the position
+   where the walk of the previous range stopped.  cur->valid is 0 if the
+   walk has no slots left. */
+
+static void
+fd_rocksdb_prefetch_cursor_restore( fd_rocksdb_prefetch_t *           pf,
+                                    fd_rocksdb_prefetch_cursor_t *    cur,
+                                    fd_rocksdb_prefetch_pos_t const * pos ) {
+  fd_rocksdb_root_iter_new( &cur->iter );
+  cur->valid  = 0;
+  cur->db_idx = pos->db_idx;
+  if( FD_UNLIKELY( !pos->valid ) ) return;
+
+  /* Past the end of the root column, leave the iterator unopened (the
+     walk only falls back to metas and the next rocksdb from there) */
+
+  fd_rocksdb_t * db = &pf->db[ cur->db_idx ];
+  if( pos->iter_slot!=ULONG_MAX ) {
+    ulong ks = fd_ulong_bswap( pos->iter_slot );
+    cur->iter.db   = db;
+    cur->iter.iter = rocksdb_create_iterator_cf( db->db, db->ro, db->cf_handles[ FD_ROCKSDB_CFIDX_ROOT ] );
+    rocksdb_iter_seek( cur->iter.iter, (char const *)&ks, sizeof(ulong) );
+  }
 
-  /* We need to track the payload size */
-  ulong payload_sz = 0;
+  if( FD_UNLIKELY( fd_rocksdb_get_meta( db, pos->slot, &cur->meta, fd_libc_alloc_virtual() ) ) ) {
+    FD_LOG_WARNING(( "slot %lu meta disappeared from rocksdb %lu", pos->slot, cur->db_idx ));
+    return;
+  }
+  cur->valid = 1;
+}
+
+/* fd_rocksdb_prefetch_cursor_save stores where cur is into pos. */
+
+static void
+fd_rocksdb_prefetch_cursor_save( fd_rocksdb_prefetch_cursor_t * cur,
+                                 fd_rocksdb_prefetch_pos_t *    pos ) {
+  ulong iter_slot;
+  pos->valid     = cur->valid;
+  pos->db_idx    = cur->db_idx;
+  pos->slot      = cur->valid ? cur->meta.slot : ULONG_MAX;
+  pos->iter_slot = fd_rocksdb_root_iter_slot( &cur->iter, &iter_slot ) ? ULONG_MAX : iter_slot;
+}
+
+/* fd_rocksdb_prefetch_cursor_next advances cur to the next rooted slot.
+   This follows the root column and falls back to the next slot's meta
+   and then to the next rocksdb in the list like on demand ingest always
+   has.  The caller owns (and destroys) the meta of the slot cur was
+   at. */
+
+static void
+fd_rocksdb_prefetch_cursor_next( fd_rocksdb_prefetch_t *        pf,
+                                 fd_rocksdb_prefetch_cursor_t * cur ) {
+  if( FD_UNLIKELY( !cur->valid ) ) return;
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  ulong       slot   = cur->meta.slot;
+
+  int ret = fd_rocksdb_root_iter_next( &cur->iter, &cur->meta, valloc );
+  if( ret<0 ) ret = fd_rocksdb_get_meta( &pf->db[ cur->db_idx ], slot+1UL, &cur->meta, valloc );
+  while( ret<0 && cur->db_idx+1UL<pf->db_cnt ) {
+    /* If slot doesn't exist try to look in the next indexed rocksdb */
+    cur->db_idx++;
+    fd_rocksdb_root_iter_destroy( &cur->iter );
+    fd_rocksdb_root_iter_new( &cur->iter );
+    ret = fd_rocksdb_root_iter_seek( &cur->iter, &pf->db[ cur->db_idx ], slot+1UL, &cur->meta, valloc );
+  }
+  cur->valid = !ret;
+}
+
+static void
+fd_rocksdb_prefetch_cursor_destroy( fd_rocksdb_prefetch_cursor_t * cur ) {
+  if( cur->valid ) {
+    fd_bincode_destroy_ctx_t ctx = { .valloc = fd_libc_alloc_virtual() };
+    fd_slot_meta_destroy( &cur->meta, &ctx );
+    cur->valid = 0;
+  }
+  fd_rocksdb_root_iter_destroy( &cur->iter );
+}
+
+/* fd_rocksdb_prefetch_fill reads the blocks of range seq (the slots
+   [start_slot+seq*RANGE_SZ,start_slot+(seq+1)*RANGE_SZ) up to
+   end_slot) into range, or marks range done if there are no blocks at
+   or after it.  The walk of the range starts where the walk of range
+   seq-1 stopped, so fill waits for that walk (but not for that range's
+   block reads) to finish and then hands its own stopping point to range
+   seq+1.  Returns 0 on success and -1 if pf was halted while waiting
+   (range is not filled then). */
+
+static int
+fd_rocksdb_prefetch_fill( fd_rocksdb_prefetch_t *       pf,
+                          fd_rocksdb_prefetch_range_t * range,
+                          ulong                         seq ) {
+  ulong lo = pf->start_slot + seq*FD_ROCKSDB_PREFETCH_RANGE_SZ;
+
+  range->blk_cnt = 0UL;
+  range->done    = pf->end_slot<pf->start_slot || seq>(pf->end_slot-pf->start_slot)/FD_ROCKSDB_PREFETCH_RANGE_SZ;
+  if( FD_UNLIKELY( range->done ) ) return 0;
+
+  while( FD_VOLATILE_CONST( pf->walk_seq )!=seq ) {
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( pf->halt ) ) ) return -1;
+    FD_SPIN_PAUSE();
+  }
+  FD_COMPILER_MFENCE();
+
+  /* Walk the range, taking the metas of its slots */
+
+  fd_rocksdb_prefetch_cursor_t cur[1];
+  fd_slot_meta_t               meta  [ FD_ROCKSDB_PREFETCH_RANGE_SZ ];
+  ulong                        db_idx[ FD_ROCKSDB_PREFETCH_RANGE_SZ ];
+  fd_rocksdb_prefetch_cursor_restore( pf, cur, &pf->walk_pos );
+  range->done = !cur->valid;
+
+  while( cur->valid && cur->meta.slot-lo<FD_ROCKSDB_PREFETCH_RANGE_SZ && cur->meta.slot<=pf->end_slot ) {
+    ulong idx = range->blk_cnt++;
+    meta  [ idx ] = cur->meta;
+    db_idx[ idx ] = cur->db_idx;
+    fd_rocksdb_prefetch_cursor_next( pf, cur );
+  }
+
+  fd_rocksdb_prefetch_cursor_save( cur, &pf->walk_pos );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( pf->walk_seq ) = seq+1UL;
+  FD_COMPILER_MFENCE();
+  fd_rocksdb_prefetch_cursor_destroy( cur );
+
+  /* Read the blocks, concurrently with the walks of later ranges */
+
+  fd_bincode_destroy_ctx_t ctx = { .valloc = fd_libc_alloc_virtual() };
+  for( ulong idx=0UL; idx<range->blk_cnt; idx++ ) {
+    ulong                slot = meta[ idx ].slot;
+    fd_rocksdb_block_t * blk  = &range->blk[ idx ];
+    range->err[ idx ] = fd_rocksdb_block_read( &pf->db[ db_idx[ idx ] ], &meta[ idx ], slot==pf->trash_slot ? pf->trash_hash : NULL, blk );
+    if( FD_UNLIKELY( range->err[ idx ] ) ) blk->slot = slot;
+    fd_slot_meta_destroy( &meta[ idx ], &ctx );
+  }
+  return 0;
+}
+
+/* fd_rocksdb_prefetch_tile is run by prefetch tile argc.  Tile i of n
+   reads ranges i, i+n, i+2n, ... into the ring, staying at most depth
+   ranges ahead of the consumer. */
+
+static int
+fd_rocksdb_prefetch_tile( int     argc,
+                          char ** argv ) {
+  fd_rocksdb_prefetch_t * pf       = (fd_rocksdb_prefetch_t *)argv;
+  ulong                   tile_cnt = pf->tile_cnt;
+  ulong                   depth    = pf->depth;
+
+  for( ulong seq=(ulong)argc;; seq+=tile_cnt ) {
+    while( seq>=FD_VOLATILE_CONST( pf->cons_seq )+depth ) {
+      if( FD_UNLIKELY( FD_VOLATILE_CONST( pf->halt ) ) ) return 0;
+      FD_SPIN_PAUSE();
+    }
+
+    fd_rocksdb_prefetch_range_t * range = pf->ring + (seq % depth);
+    if( FD_UNLIKELY( fd_rocksdb_prefetch_fill( pf, range, seq ) ) ) return 0;
+    FD_COMPILER_MFENCE();
+    FD_VOLATILE( range->seq ) = seq;
+    FD_COMPILER_MFENCE();
+    if( range->done ) return 0;
+  }
+}
+
+fd_rocksdb_prefetch_t *
+fd_rocksdb_prefetch_init( fd_rocksdb_prefetch_t * pf,
+                          char const * const *    path,
+                          ulong                   path_cnt,
+                          ulong                   start_slot,
+                          ulong                   end_slot,
+                          ulong                   trash_slot,
+                          ulong                   depth,
+                          ulong                   tile0,
+                          ulong                   tile_cnt ) {
+  if( FD_UNLIKELY( !pf ) ) {
+    FD_LOG_WARNING(( "NULL pf" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( !path_cnt || path_cnt>FD_ROCKSDB_PREFETCH_DB_MAX ) ) {
+    FD_LOG_WARNING(( "bad path_cnt" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( tile_cnt>FD_ROCKSDB_PREFETCH_TILE_MAX || depth<fd_ulong_max( tile_cnt, 1UL ) ) ) {
+    FD_LOG_WARNING(( "bad tile_cnt / depth" ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( tile_cnt && ( !tile0 || tile0+tile_cnt>fd_tile_cnt() ) ) ) {
+    FD_LOG_WARNING(( "bad prefetch tile range [%lu,%lu)", tile0, tile0+tile_cnt ));
+    return NULL;
+  }
+
+  fd_memset( pf, 0, sizeof(fd_rocksdb_prefetch_t) );
+  pf->walk_pos.valid     = 1;
+  pf->walk_pos.db_idx    = 0UL;
+  pf->walk_pos.slot      = start_slot;
+  pf->walk_pos.iter_slot = start_slot;
+  pf->start_slot = start_slot;
+  pf->end_slot   = end_slot;
+  pf->trash_slot = trash_slot;
+  pf->depth      = depth;
+  pf->tile_cnt   = tile_cnt;
+  memset( pf->trash_hash, 0xFE, sizeof(pf->trash_hash) );
+
+  for( ulong i=0UL; i<path_cnt; i++ ) {
+    char * err = fd_rocksdb_init( &pf->db[ i ], path[ i ] );
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "fd_rocksdb_init(%s) returned %s", path[ i ], err ));
+      fd_rocksdb_destroy( &pf->db[ i ] );
+      goto fail;
+    }
+    pf->db_cnt = i+1UL;
+  }
+
+  pf->ring = (fd_rocksdb_prefetch_range_t *)malloc( depth*sizeof(fd_rocksdb_prefetch_range_t) );
+  if( FD_UNLIKELY( !pf->ring ) ) {
+    FD_LOG_WARNING(( "malloc failed" ));
+    goto fail;
+  }
+  for( ulong i=0UL; i<depth; i++ ) pf->ring[ i ].seq = ULONG_MAX;
+
+  fd_rocksdb_root_iter_t iter[1];
+  fd_slot_meta_t         meta[1];
+  fd_rocksdb_root_iter_new( iter );
+  int seek_err = fd_rocksdb_root_iter_seek( iter, &pf->db[ 0 ], start_slot, meta, fd_libc_alloc_virtual() );
+  fd_rocksdb_root_iter_destroy( iter );
+  if( FD_UNLIKELY( seek_err ) ) {
+    FD_LOG_WARNING(( "unable to seek to slot %lu", start_slot ));
+    goto fail;
+  }
+  fd_bincode_destroy_ctx_t ctx = { .valloc = fd_libc_alloc_virtual() };
+  fd_slot_meta_destroy( meta, &ctx );
+
+  for( ulong i=0UL; i<tile_cnt; i++ ) {
+    pf->exec[ i ] = fd_tile_exec_new( tile0+i, fd_rocksdb_prefetch_tile, (int)i, (char **)pf );
+    if( FD_UNLIKELY( !pf->exec[ i ] ) ) {
+      FD_LOG_WARNING(( "fd_tile_exec_new(%lu) failed", tile0+i ));
+      goto fail;
+    }
+  }
+
+  return pf;
+
+fail:
+  fd_rocksdb_prefetch_fini( pf );
+  return NULL;
+}
+
+fd_rocksdb_block_t *
+fd_rocksdb_prefetch_next( fd_rocksdb_prefetch_t * pf,
+                          int *                   _err ) {
+  for(;;) {
+    ulong                         seq   = pf->cons_seq;
+    fd_rocksdb_prefetch_range_t * range = pf->ring + (seq % pf->depth);
+
+    if( !pf->tile_cnt ) {
+      if( range->seq!=seq ) {
+        fd_rocksdb_prefetch_fill( pf, range, seq ); /* Never waits, ranges are filled in order */
+        range->seq = seq;
+      }
+    } else {
+      while( FD_VOLATILE_CONST( range->seq )!=seq ) FD_SPIN_PAUSE();
+      FD_COMPILER_MFENCE();
+    }
+
+    if( range->done ) return NULL;
+
+    ulong idx = pf->cons_idx;
+    if( FD_LIKELY( idx<range->blk_cnt ) ) {
+      *_err = range->err[ idx ];
+      return &range->blk[ idx ];
+    }
+
+    /* Range fully consumed (or empty), hand it back to the tiles */
+
+    pf->cons_idx = 0UL;
+    FD_COMPILER_MFENCE();
+    FD_VOLATILE( pf->cons_seq ) = seq+1UL;
+    FD_COMPILER_MFENCE();
+  }
+}
+
+void
+fd_rocksdb_prefetch_release( fd_rocksdb_prefetch_t * pf ) {
+  fd_rocksdb_prefetch_range_t * range = pf->ring + (pf->cons_seq % pf->depth);
+  fd_rocksdb_block_destroy( &range->blk[ pf->cons_idx ] );
+  pf->cons_idx++;
+}
+
+void
+fd_rocksdb_prefetch_fini( fd_rocksdb_prefetch_t * pf ) {
+  FD_VOLATILE( pf->halt ) = 1;
+  FD_COMPILER_MFENCE();
+  for( ulong i=0UL; i<pf->tile_cnt; i++ ) {
+    if( !pf->exec[ i ] ) break;
+    char const * fail = fd_tile_exec_delete( pf->exec[ i ], NULL );
+    if( FD_UNLIKELY( fail ) ) FD_LOG_WARNING(( "prefetch tile %lu failed (%s)", i, fail ));
+    pf->exec[ i ] = NULL;
+  }
+
+  if( pf->ring ) {
+    for( ulong i=0UL; i<pf->depth; i++ ) {
+      fd_rocksdb_prefetch_range_t * range = pf->ring + i;
+      if( range->seq==ULONG_MAX || range->seq<pf->cons_seq ) continue;
+      for( ulong idx=( range->seq==pf->cons_seq ? pf->cons_idx : 0UL ); idx<range->blk_cnt; idx++ )
+        fd_rocksdb_block_destroy( &range->blk[ idx ] );
+    }
+    free( pf->ring );
+    pf->ring = NULL;
+  }
+
+  for( ulong i=0UL; i<pf->db_cnt; i++ ) fd_rocksdb_destroy( &pf->db[ i ] );
+  pf->db_cnt = 0UL;
+}
+
+int
+fd_rocksdb_import_block_shredcap( fd_rocksdb_t *             db,
+                                  fd_slot_meta_t *           metadata,
+                                  uchar *                    payload,
+                                  ulong *                    payload_sz,
+                                  fd_io_buffered_ostream_t * bank_hash_ostream ) {
+  ulong slot = metadata->slot;
 
   rocksdb_iterator_t* iter = rocksdb_create_iterator_cf( db->db, db->ro, db->cf_handles[FD_ROCKSDB_CFIDX_DATA_SHRED] );
 
@@ -755,6 +1114,14 @@ fd_rocksdb_import_block_shredcap( fd_rocksdb_t *             db,
 
   ulong start_idx = 0;
   ulong end_idx   = metadata->received;
+  if ( FD_UNLIKELY( end_idx > FD_SHREDCAP_SLOT_SHRED_MAX ) ) {
+    FD_LOG_WARNING(( "too many shreds=%lu for slot %lu", end_idx, slot ));
+    rocksdb_iter_destroy( iter );
+    return -1;
+  }
+
+  /* We need to track the payload size */
+  ulong sz = 0;
   for ( ulong i = start_idx; i < end_idx; i++ ) {
     ulong cur_slot, index;
     uchar valid = rocksdb_iter_valid( iter );
@@ -797,71 +1164,27 @@ fd_rocksdb_import_block_shredcap( fd_rocksdb_t *             db,
       return -1;
     }
 
-    /* Write a shred header and shred. Each shred and it's header will be aligned */
-    char shred_buf[ FD_SHREDCAP_SHRED_MAX ];
-    char * shred_buf_ptr = shred_buf;
+    /* Append a shred header and shred. Each shred and it's header will be aligned */
+    uchar * shred_buf_ptr = payload + sz;
     ushort shred_sz = (ushort)fd_shred_sz( shred );
     uint shred_boundary_sz = (uint)fd_uint_align_up( shred_sz + FD_SHREDCAP_SHRED_HDR_FOOTPRINT,
                                                      FD_SHREDCAP_ALIGN ) - FD_SHREDCAP_SHRED_HDR_FOOTPRINT;
 
-    fd_memset( shred_buf_ptr, 0, shred_boundary_sz );
+    fd_memset( shred_buf_ptr, 0, shred_boundary_sz + FD_SHREDCAP_SHRED_HDR_FOOTPRINT );
     /* Populate start of buffer with header */
     fd_shredcap_shred_hdr_t * shred_hdr = (fd_shredcap_shred_hdr_t*)shred_buf_ptr;
     shred_hdr->hdr_sz            = FD_SHREDCAP_SHRED_HDR_FOOTPRINT;
     shred_hdr->shred_sz          = shred_sz;
     shred_hdr->shred_boundary_sz = shred_boundary_sz;
 
-    /* Skip ahead and populate rest of buffer with shred and write out */
-    fd_memcpy( shred_buf_ptr + FD_SHREDCAP_SHRED_HDR_FOOTPRINT, shred, shred_boundary_sz );
-    fd_io_buffered_ostream_write( ostream, shred_buf_ptr,
-                                  shred_boundary_sz + FD_SHREDCAP_SHRED_HDR_FOOTPRINT );
+    /* Skip ahead and populate rest of buffer with shred */
+    fd_memcpy( shred_buf_ptr + FD_SHREDCAP_SHRED_HDR_FOOTPRINT, shred, shred_sz );
 
-    payload_sz += shred_boundary_sz + FD_SHREDCAP_SHRED_HDR_FOOTPRINT;
+    sz += shred_boundary_sz + FD_SHREDCAP_SHRED_HDR_FOOTPRINT;
     rocksdb_iter_next( iter );
   }
-
-  /* Update file size */
-  long pre_slot_processed_file_offset = lseek( ostream->fd, 0, SEEK_CUR );
-  if ( FD_UNLIKELY( pre_slot_processed_file_offset == -1 ) ) {
-    FD_LOG_ERR(( "lseek error when seeking to current position" ));
-  }
-
-  if ( FD_UNLIKELY( pre_slot_processed_file_offset == pre_slot_hdr_file_offset ) ) {
-    /* This case is when the payload from the shreds is smaller than the free
-       space from the write buffer. This means that the buffer was not flushed
-       at any point. This case is highly unlikely */
-    fd_io_buffered_ostream_flush( ostream );
-  }
-
-  /* Safely assume that the buffer was flushed to the file at least once. Store
-     original seek position, skip to position with payload_sz in header, write
-     updated payload sz, and then reset seek position. */
-  long original_offset = lseek( ostream->fd, 0, SEEK_CUR );
-  if ( FD_UNLIKELY( original_offset == -1 ) ) {
-    FD_LOG_ERR(( "lseek error when seeking to current position" ));
-  }
-  long payload_sz_file_offset = pre_slot_hdr_file_offset_real +
-                                (long)FD_SHREDCAP_SLOT_HDR_PAYLOAD_SZ_OFFSET;
-
-  long offset;
-  offset = lseek( ostream->fd, payload_sz_file_offset, SEEK_SET );
-  if ( FD_UNLIKELY( offset == -1 ) ) {
-    FD_LOG_ERR(( "lseek error when seeking to offset=%ld", payload_sz_file_offset ));
-  }
-  ulong to_write;
-  fd_io_write( ostream->fd, &payload_sz, sizeof(ulong), sizeof(ulong), &to_write );
-
-  offset = lseek( ostream->fd, original_offset, SEEK_SET );
-  if ( FD_UNLIKELY( offset == -1 ) ) {
-    FD_LOG_ERR(( "lseek error when seeking to offset=%ld", original_offset ));
-  }
-
-  /* Write slot footer */
-  fd_shredcap_slot_ftr_t slot_ftr;
-  slot_ftr.magic      = FD_SHREDCAP_SLOT_FTR_MAGIC;
-  slot_ftr.payload_sz = payload_sz;
-  fd_io_buffered_ostream_write( ostream, &slot_ftr, FD_SHREDCAP_SLOT_FTR_FOOTPRINT );
   rocksdb_iter_destroy( iter );
+  *payload_sz = sz;
 
   /* Get and write bank hash information to respective file */
   size_t vallen = 0;
@@ -57,6 +57,90 @@ typedef struct fd_rocksdb_root_iter fd_rocksdb_root_iter_t;
 #define FD_ROCKSDB_ROOT_ITER_FOOTPRINT sizeof(fd_rocksdb_root_iter_t)
 #define FD_ROCKSDB_ROOT_ITER_ALIGN (8UL)
 
+/* fd_rocksdb_block_t is a block read out of rocksdb by
+   fd_rocksdb_block_read that has not been inserted into a blockstore
+   yet.  Reading (the rocksdb lookups and copying and validating the
+   shreds) only reads from the rocksdb and can be done for different
+   blocks concurrently.  Inserting (deshredding into the blockstore)
+   takes the blockstore write lock. */
+
+struct fd_rocksdb_block {
+  fd_rocksdb_t * db;            /* rocksdb the block was read from (for txn status lookups) */
+  ulong          slot;
+  ulong          shred_cnt;
+  uchar *        shred_buf;     /* malloc backed, shreds stored back to back */
+  ulong *        shred_off;     /* malloc backed, shred i is [shred_off[i],shred_off[i+1]) of shred_buf */
+  int            has_ts;
+  long           ts;            /* block time in ns, valid if has_ts */
+  ulong          height;        /* 0 if unknown */
+  int            has_bank_hash;
+  fd_hash_t      bank_hash;     /* valid if has_bank_hash */
+};
+typedef struct fd_rocksdb_block fd_rocksdb_block_t;
+
+/* fd_rocksdb_prefetch_t reads the blocks of rooted slots
+   [start_slot,end_slot] out of a list of rocksdbs ahead of a consumer.
+   The slots are split into ranges of FD_ROCKSDB_PREFETCH_RANGE_SZ
+   slots.  Prefetch tile i of n reads ranges i, i+n, i+2n, ... into a
+   ring of depth ranges, so up to depth ranges are read concurrently with
+   the consumer inserting (and replaying) blocks of earlier ranges.  With
+   no tiles, the consumer reads each range on demand.
+
+   Which slots a range holds depends on the walk of all earlier slots
+   (which rocksdb it is in, where that rocksdb's root column iterator is).
+   So the walk itself is done range by range in order: each range starts
+   from the position where the walk of the previous range stopped and
+   hands its own stopping position to the next.  Only the block reads of
+   the ranges (the expensive part) run concurrently. */
+
+#define FD_ROCKSDB_PREFETCH_DB_MAX   (32UL)
+#define FD_ROCKSDB_PREFETCH_TILE_MAX (64UL)
+#define FD_ROCKSDB_PREFETCH_RANGE_SZ (16UL)
+
+struct fd_rocksdb_prefetch_cursor {
+  ulong                  db_idx;
+  fd_rocksdb_root_iter_t iter;
+  fd_slot_meta_t         meta;
+  int                    valid; /* 1 if meta holds the cursor's slot */
+};
+typedef struct fd_rocksdb_prefetch_cursor fd_rocksdb_prefetch_cursor_t;
+
+struct fd_rocksdb_prefetch_pos {
+  int   valid;     /* 0 if the walk has no slots left */
+  ulong db_idx;    /* rocksdb the walk is in */
+  ulong slot;      /* Slot the walk is at */
+  ulong iter_slot; /* Root the root column iterator is at, ULONG_MAX if past the end */
+};
+typedef struct fd_rocksdb_prefetch_pos fd_rocksdb_prefetch_pos_t;
+
+struct fd_rocksdb_prefetch_range {
+  ulong              seq;     /* Index of the range held, ULONG_MAX if never filled */
+  int                done;    /* 1 if there are no blocks at or after the range */
+  ulong              blk_cnt;
+  int                err[ FD_ROCKSDB_PREFETCH_RANGE_SZ ]; /* fd_rocksdb_block_read results */
+  fd_rocksdb_block_t blk[ FD_ROCKSDB_PREFETCH_RANGE_SZ ]; /* Blocks in slot order */
+};
+typedef struct fd_rocksdb_prefetch_range fd_rocksdb_prefetch_range_t;
+
+struct fd_rocksdb_prefetch {
+  fd_rocksdb_t                  db[ FD_ROCKSDB_PREFETCH_DB_MAX ];
+  ulong                         db_cnt;
+  ulong                         start_slot;
+  ulong                         end_slot;
+  ulong                         trash_slot;
+  uchar                         trash_hash[ 32 ];
+  ulong                         depth;
+  fd_rocksdb_prefetch_range_t * ring;     /* malloc backed, indexed by seq % depth */
+  ulong                         cons_seq; /* Range of the next block for the consumer */
+  ulong                         cons_idx; /* Index of the next block for the consumer in its range */
+  ulong                         walk_seq; /* Range whose walk starts at walk_pos next */
+  fd_rocksdb_prefetch_pos_t     walk_pos;
+  int                           halt;
+  ulong                         tile_cnt;
+  fd_tile_exec_t *              exec[ FD_ROCKSDB_PREFETCH_TILE_MAX ];
+};
+typedef struct fd_rocksdb_prefetch fd_rocksdb_prefetch_t;
+
 FD_PROTOTYPES_BEGIN
 
 void *
@@ -226,6 +310,31 @@ fd_rocksdb_insert_entry( fd_rocksdb_t * db,
                          const char *   value,
                          ulong          value_len );
 
+/* fd_rocksdb_block_read reads the data shreds and metadata of the slot
+   described by m into blk.  If hash_override is non-NULL, it is used as
+   the block's bank hash.  Returns 0 on success and -1 on failure (logs
+   details, blk holds nothing on failure).  On success, the caller should
+   fd_rocksdb_block_destroy blk when done with it.  Safe to call
+   concurrently from multiple threads on the same db. */
+
+int
+fd_rocksdb_block_read( fd_rocksdb_t *         db,
+                       fd_slot_meta_t const * m,
+                       uchar const *          hash_override,
+                       fd_rocksdb_block_t *   blk );
+
+/* fd_rocksdb_block_insert inserts a block read by fd_rocksdb_block_read
+   into blockstore (and, if txnstatus, looks up its transaction statuses
+   in blk->db).  Returns 0 on success and -1 on failure (logs details). */
+
+int
+fd_rocksdb_block_insert( fd_rocksdb_block_t const * blk,
+                         fd_blockstore_t *          blockstore,
+                         int                        txnstatus );
+
+void
+fd_rocksdb_block_destroy( fd_rocksdb_block_t * blk );
+
 /* Import from rocksdb into blockstore */
 
 int
@@ -235,12 +344,61 @@ fd_rocksdb_import_block_blockstore( fd_rocksdb_t *    db,
                                     int txnstatus,
                                     const uchar *hash_override );
 
+/* fd_rocksdb_import_block_shredcap copies the shreds of the block
+   described by metadata into payload in the shredcap slot payload
+   format (payload should have room for FD_SHREDCAP_SLOT_PAYLOAD_MAX
+   bytes), sets *payload_sz to the payload size and appends the bank
+   hash of the block to bank_hash_ostream.  Returns 0 on success and -1
+   on failure (logs details). */
+
 int
 fd_rocksdb_import_block_shredcap( fd_rocksdb_t *             db,
                                   fd_slot_meta_t *           metadata,
-                                  fd_io_buffered_ostream_t * ostream,
+                                  uchar *                    payload,
+                                  ulong *                    payload_sz,
                                   fd_io_buffered_ostream_t * bank_hash_ostream );
 
+/* fd_rocksdb_prefetch_init opens the rocksdbs at path[0,path_cnt)
+   (blocks missing from one rocksdb are looked for in the next) and
+   starts prefetching blocks from start_slot on tiles
+   [tile0,tile0+tile_cnt), at most depth ranges ahead of the consumer.
+   The block at trash_slot gets a bank hash of all 0xFE bytes.  depth
+   should be at least tile_cnt.  Returns pf on success and NULL on
+   failure (logs details, including start_slot not being a rooted
+   slot). */
+
+fd_rocksdb_prefetch_t *
+fd_rocksdb_prefetch_init( fd_rocksdb_prefetch_t * pf,
+                          char const * const *    path,
+                          ulong                   path_cnt,
+                          ulong                   start_slot,
+                          ulong                   end_slot,
+                          ulong                   trash_slot,
+                          ulong                   depth,
+                          ulong                   tile0,
+                          ulong                   tile_cnt );
+
+/* fd_rocksdb_prefetch_next returns the next block in slot order,
+   waiting for it to be read if necessary, or NULL once the range is
+   exhausted.  *_err is set to the fd_rocksdb_block_read result for the
+   block (on failure, only the returned block's slot is valid).  The
+   block is owned by pf and is valid until the matching
+   fd_rocksdb_prefetch_release.  Calling next again before release
+   returns the same block. */
+
+fd_rocksdb_block_t *
+fd_rocksdb_prefetch_next( fd_rocksdb_prefetch_t * pf,
+                          int *                   _err );
+
+void
+fd_rocksdb_prefetch_release( fd_rocksdb_prefetch_t * pf );
+
+/* fd_rocksdb_prefetch_fini stops and joins the prefetch tiles, frees
+   unconsumed blocks and closes the rocksdbs. */
+
+void
+fd_rocksdb_prefetch_fini( fd_rocksdb_prefetch_t * pf );
+
 FD_PROTOTYPES_END
 
 #endif
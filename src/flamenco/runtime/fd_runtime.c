@@ -1,5 +1,6 @@
 #include "fd_acc_mgr.h"
 #include "fd_runtime.h"
+#include "fd_runtime_prof.h"
 #include "fd_account.h"
 #include "fd_hashes.h"
 #include "sysvar/fd_sysvar_cache.h"
@@ -1312,7 +1313,7 @@ fd_runtime_finalize_txns_tpool( fd_exec_slot_ctx_t * slot_ctx,
         fd_borrowed_account_t * acc_rec = &txn_ctx->borrowed_accounts[i];
         void * acc_rec_data = fd_borrowed_account_destroy( acc_rec );
         if( acc_rec_data != NULL ) {
-          fd_valloc_free( txn_ctx->valloc, acc_rec_data );
+          fd_acc_mgr_cow_free( txn_ctx->acc_mgr, acc_rec_data );
         }
       }
     }
@@ -1487,6 +1488,8 @@ fd_runtime_execute_txns_in_waves_tpool( fd_exec_slot_ctx_t * slot_ctx,
     fd_execute_txn_task_info_t * wave_task_infos = fd_scratch_alloc( 8, txn_cnt * sizeof(fd_execute_txn_task_info_t));
     ulong wave_task_infos_cnt = 0;
 
+    fd_runtime_prof_t * prof = slot_ctx->prof;
+    long phase_start = fd_tickcount();
     int res = fd_runtime_prepare_txns_phase1( slot_ctx, task_infos, txns, txn_cnt );
     if( res != 0 ) {
       FD_LOG_WARNING(("Fail prep 1"));
@@ -1504,6 +1507,7 @@ fd_runtime_execute_txns_in_waves_tpool( fd_exec_slot_ctx_t * slot_ctx,
 
       txns[i].flags = FD_TXN_P_FLAGS_SANITIZE_SUCCESS;
     }
+    fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_PREPARE, phase_start );
 
     ulong * next_incomplete_txn_idxs = fd_scratch_alloc( 8UL, txn_cnt * sizeof(ulong) );
     ulong next_incomplete_txn_idxs_cnt = 0;
@@ -1512,6 +1516,7 @@ fd_runtime_execute_txns_in_waves_tpool( fd_exec_slot_ctx_t * slot_ctx,
     double cum_wave_time_ms = 0.0;
     while( incomplete_txn_idxs_cnt > 0 ) {
       long wave_time = -fd_log_wallclock();
+      phase_start = fd_tickcount();
       fd_runtime_generate_wave( task_infos, incomplete_txn_idxs, incomplete_txn_idxs_cnt, incomplete_accounts_cnt,
                                 next_incomplete_txn_idxs, &next_incomplete_txn_idxs_cnt, &next_incomplete_accounts_cnt,
                                 wave_task_infos, &wave_task_infos_cnt );
@@ -1519,19 +1524,29 @@ fd_runtime_execute_txns_in_waves_tpool( fd_exec_slot_ctx_t * slot_ctx,
       incomplete_txn_idxs = next_incomplete_txn_idxs;
       next_incomplete_txn_idxs = temp_incomplete_txn_idxs;
       incomplete_txn_idxs_cnt = next_incomplete_txn_idxs_cnt;
+      fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_PREPARE, phase_start );
 
+      phase_start = fd_tickcount();
       res |= fd_runtime_prepare_txns_phase2_tpool( slot_ctx, wave_task_infos, wave_task_infos_cnt, tpool, max_workers );
       if( res != 0 ) {
         FD_LOG_WARNING(("Fail prep 2"));
       }
+      fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_LOAD, phase_start );
 
+      phase_start = fd_tickcount();
       res |= fd_runtime_prepare_txns_phase3( slot_ctx, wave_task_infos, wave_task_infos_cnt );
       if( res != 0 ) {
         FD_LOG_WARNING(("Fail prep 3"));
       }
+      fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_PREPARE, phase_start );
 
+      phase_start = fd_tickcount();
       fd_tpool_exec_all_taskq( tpool, 0, max_workers, fd_runtime_execute_txn_task, wave_task_infos, NULL, NULL, 1, 0, wave_task_infos_cnt );
+      fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_EXECUTE, phase_start );
+
+      phase_start = fd_tickcount();
       res |= fd_runtime_finalize_txns_tpool( slot_ctx, capture_ctx, wave_task_infos, wave_task_infos_cnt, tpool, max_workers );
+      fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_FINALIZE, phase_start );
       if( res != 0 ) {
         return res;
       }
@@ -1731,12 +1746,6 @@ int fd_runtime_block_execute_finalize(fd_exec_slot_ctx_t *slot_ctx,
     return result;
   }
 
-  fd_bincode_destroy_ctx_t destroy_sysvar_ctx = {
-    .valloc = slot_ctx->valloc,
-  };
-
-  // Clean up sysvar cache
-  fd_slot_hashes_destroy( slot_ctx->sysvar_cache_old.slot_hashes, &destroy_sysvar_ctx );
 
   return FD_RUNTIME_EXECUTE_SUCCESS;
 }
@@ -1784,12 +1793,6 @@ fd_runtime_block_execute_finalize_tpool( fd_exec_slot_ctx_t * slot_ctx,
 
   fd_funk_end_write( slot_ctx->acc_mgr->funk );
 
-  fd_bincode_destroy_ctx_t destroy_sysvar_ctx = {
-    .valloc = slot_ctx->valloc,
-  };
-
-  // Clean up sysvar cache
-  fd_slot_hashes_destroy( slot_ctx->sysvar_cache_old.slot_hashes, &destroy_sysvar_ctx );
   slot_ctx->total_compute_units_requested = 0;
   for ( fd_account_compute_table_iter_t iter = fd_account_compute_table_iter_init( slot_ctx->account_compute_table );
         !fd_account_compute_table_iter_done( slot_ctx->account_compute_table, iter );
@@ -1874,6 +1877,7 @@ int fd_runtime_block_execute_tpool_v2( fd_exec_slot_ctx_t * slot_ctx,
 
     long block_execute_time = -fd_log_wallclock();
 
+    long phase_start = fd_tickcount();
     int res = fd_runtime_block_execute_prepare( slot_ctx );
     if( res != FD_RUNTIME_EXECUTE_SUCCESS ) {
       return res;
@@ -1883,6 +1887,7 @@ int fd_runtime_block_execute_tpool_v2( fd_exec_slot_ctx_t * slot_ctx,
     fd_txn_p_t * txn_ptrs = fd_scratch_alloc( alignof(fd_txn_p_t), txn_cnt * sizeof(fd_txn_p_t) );
 
     fd_runtime_block_collect_txns( block_info, txn_ptrs );
+    fd_runtime_prof_phase( slot_ctx->prof, FD_RUNTIME_PROF_PHASE_PREPARE, phase_start );
 
     res = fd_runtime_execute_txns_in_waves_tpool( slot_ctx, capture_ctx, txn_ptrs, txn_cnt, tpool, max_workers );
     if( res != FD_RUNTIME_EXECUTE_SUCCESS ) {
@@ -1890,10 +1895,12 @@ int fd_runtime_block_execute_tpool_v2( fd_exec_slot_ctx_t * slot_ctx,
     }
 
     long block_finalize_time = -fd_log_wallclock();
+    phase_start = fd_tickcount();
     res = fd_runtime_block_execute_finalize_tpool( slot_ctx, capture_ctx, block_info, tpool, max_workers );
     if( res != FD_RUNTIME_EXECUTE_SUCCESS ) {
       return res;
     }
+    fd_runtime_prof_phase( slot_ctx->prof, FD_RUNTIME_PROF_PHASE_HASH, phase_start );
 
     slot_ctx->slot_bank.transaction_count += txn_cnt;
 
@@ -2289,7 +2296,9 @@ fd_runtime_checkpt( fd_capture_ctx_t * capture_ctx,
 
 int
 fd_runtime_publish_old_txns( fd_exec_slot_ctx_t * slot_ctx,
-                             fd_capture_ctx_t * capture_ctx ) {
+                             fd_capture_ctx_t * capture_ctx,
+                             fd_tpool_t * tpool,
+                             ulong max_workers ) {
   /* Publish any transaction older than 31 slots */
   fd_funk_t * funk = slot_ctx->acc_mgr->funk;
   fd_funk_txn_t * txnmap = fd_funk_txn_map(funk, fd_funk_wksp(funk));
@@ -2300,11 +2309,14 @@ fd_runtime_publish_old_txns( fd_exec_slot_ctx_t * slot_ctx,
       FD_LOG_DEBUG(("publishing %32J (slot %ld)", &txn->xid, txn->xid.ul[0]));
 
       fd_funk_start_write(funk);
-      ulong publish_err = fd_funk_txn_publish(funk, txn, 1);
+      long  publish_start = fd_tickcount();
+      ulong publish_rec_cnt;
+      ulong publish_err = fd_funk_txn_publish_par( funk, txn, max_workers>1UL ? tpool : NULL, 0UL, max_workers, &publish_rec_cnt, 1 );
       if (publish_err == 0) {
         FD_LOG_ERR(("publish err"));
         return -1;
       }
+      fd_runtime_prof_publish( slot_ctx->prof, publish_rec_cnt, publish_start );
 
       if (FD_FEATURE_ACTIVE(slot_ctx, epoch_accounts_hash)) {
         fd_epoch_bank_t * epoch_bank = fd_exec_epoch_ctx_epoch_bank( slot_ctx->epoch_ctx );
@@ -2338,17 +2350,21 @@ fd_runtime_block_eval_tpool(fd_exec_slot_ctx_t *slot_ctx,
                                 ulong * txn_cnt ) {
   (void)scheduler;
 
-  int err = fd_runtime_publish_old_txns( slot_ctx, capture_ctx );
+  long phase_start = fd_tickcount();
+  int err = fd_runtime_publish_old_txns( slot_ctx, capture_ctx, tpool, max_workers );
   if( err != 0 ) {
     return err;
   }
+  fd_runtime_prof_phase( slot_ctx->prof, FD_RUNTIME_PROF_PHASE_PUBLISH, phase_start );
 
   fd_funk_t * funk = slot_ctx->acc_mgr->funk;
 
   long block_eval_time = -fd_log_wallclock();
   fd_block_info_t block_info;
+  phase_start = fd_tickcount();
   int ret = fd_runtime_block_prepare(block, blocklen, slot_ctx->valloc, &block_info);
   *txn_cnt = block_info.txn_cnt;
+  fd_runtime_prof_phase( slot_ctx->prof, FD_RUNTIME_PROF_PHASE_PREPARE, phase_start );
 
   /* Use the blockhash as the funk xid */
   fd_funk_txn_xid_t xid;
@@ -2370,7 +2386,9 @@ fd_runtime_block_eval_tpool(fd_exec_slot_ctx_t *slot_ctx,
   fd_blockstore_end_read(slot_ctx->blockstore);
 
   if( FD_RUNTIME_EXECUTE_SUCCESS == ret ) {
+    phase_start = fd_tickcount();
     ret = fd_runtime_block_verify_tpool(&block_info, &slot_ctx->slot_bank.poh, &slot_ctx->slot_bank.poh, slot_ctx->valloc, tpool, max_workers);
+    fd_runtime_prof_phase( slot_ctx->prof, FD_RUNTIME_PROF_PHASE_VERIFY, phase_start );
   }
   if( FD_RUNTIME_EXECUTE_SUCCESS == ret ) {
     ret = fd_runtime_block_execute_tpool_v2(slot_ctx, capture_ctx, &block_info, tpool, max_workers);
@@ -2378,6 +2396,10 @@ fd_runtime_block_eval_tpool(fd_exec_slot_ctx_t *slot_ctx,
 
   fd_runtime_block_destroy( slot_ctx->valloc, &block_info );
 
+  if( slot_ctx->prof ) {
+    fd_runtime_prof_slot_end( slot_ctx->prof, slot, block_info.txn_cnt );
+  }
+
   // FIXME: better way of using starting slot
   if( FD_UNLIKELY( FD_RUNTIME_EXECUTE_SUCCESS != ret ) ) {
     FD_LOG_WARNING(("execution failure, code %d", ret));
@@ -3827,23 +3849,18 @@ int fd_runtime_sysvar_cache_load( fd_exec_slot_ctx_t * slot_ctx ) {
 
   fd_sysvar_cache_restore( slot_ctx->sysvar_cache, slot_ctx->acc_mgr, slot_ctx->funk_txn );
 
-  fd_slot_hashes_new( slot_ctx->sysvar_cache_old.slot_hashes );
-  if( FD_UNLIKELY( !fd_sysvar_slot_hashes_read( slot_ctx->sysvar_cache_old.slot_hashes, slot_ctx ) ) ) {
-    FD_LOG_WARNING(("reading sysvars failed"));
-    return -1;
-  }
+  /* The slot hashes, rent and clock sysvars are required.  Rent is
+     copied out of the cache rather than decoded a second time. */
 
-  fd_rent_new( slot_ctx->sysvar_cache_old.rent );
-  if( FD_UNLIKELY( !fd_sysvar_rent_read( slot_ctx->sysvar_cache_old.rent, slot_ctx ) ) ) {
+  fd_sysvar_cache_t const * cache = slot_ctx->sysvar_cache;
+  if( FD_UNLIKELY( !fd_sysvar_cache_slot_hashes( cache ) ||
+                   !fd_sysvar_cache_rent       ( cache ) ||
+                   !fd_sysvar_cache_clock      ( cache ) ) ) {
     FD_LOG_WARNING(("reading sysvars failed"));
     return -1;
   }
 
-  fd_sol_sysvar_clock_new( slot_ctx->sysvar_cache_old.clock );
-  if( FD_UNLIKELY( !fd_sysvar_clock_read( slot_ctx->sysvar_cache_old.clock, slot_ctx ) ) ) {
-    FD_LOG_WARNING(("reading sysvars failed"));
-    return -1;
-  }
+  *slot_ctx->sysvar_cache_old.rent = *fd_sysvar_cache_rent( cache );
 
   return FD_RUNTIME_EXECUTE_SUCCESS;
 }
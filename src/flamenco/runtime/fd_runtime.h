@@ -98,6 +98,11 @@ struct fd_runtime_args {
   char const * validate_snapshot;
   char const * capture_fpath;
   int          capture_txns;
+  ulong        capture_async_tile;  /* 0 captures on the replay thread */
+  ulong        capture_ring_sz;
+  ulong        capture_slot_stride;
+  fd_pubkey_t const * capture_accounts;
+  ulong        capture_account_cnt;
   char const * shred_cap;
   char const * trace_fpath;
   char const * check_hash;
@@ -186,9 +191,15 @@ ulong
 fd_runtime_block_collect_txns( fd_block_info_t const * block_info,
                                fd_txn_p_t * out_txns );
 
+/* fd_runtime_publish_old_txns publishes the funk transaction of the
+   slot FD_RUNTIME_NUM_ROOT_BLOCKS-1 back from slot_ctx's.  If tpool is
+   non-NULL and max_workers>1, the records are merged using tpool
+   threads [0,max_workers). */
 int
 fd_runtime_publish_old_txns( fd_exec_slot_ctx_t * slot_ctx,
-                             fd_capture_ctx_t * capture_ctx );
+                             fd_capture_ctx_t * capture_ctx,
+                             fd_tpool_t * tpool,
+                             ulong max_workers );
 
 int
 fd_runtime_block_eval_tpool( fd_exec_slot_ctx_t * slot_ctx,
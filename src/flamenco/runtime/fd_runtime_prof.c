@@ -0,0 +1,382 @@
+#include "fd_runtime_prof.h"
+
+static const fd_runtime_prof_prog_key_t prog_key_null = { .ix = ULONG_MAX };
+
+#define MAP_NAME              fd_runtime_prof_prog_map
+#define MAP_T                 fd_runtime_prof_prog_t
+#define MAP_KEY_T             fd_runtime_prof_prog_key_t
+#define MAP_KEY_NULL          prog_key_null
+#define MAP_KEY_INVAL(k)      ((k).ix==ULONG_MAX)
+#define MAP_KEY_EQUAL(k0,k1)  (((k0).ix==(k1).ix) && !memcmp( (k0).id.uc, (k1).id.uc, sizeof(fd_pubkey_t) ))
+#define MAP_KEY_EQUAL_IS_SLOW 1
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(k)       ((uint)fd_ulong_hash( (k).id.ul[0] ^ (k).id.ul[3] ^ (k).ix ))
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+#define MAP_NAME              fd_runtime_prof_syscall_map
+#define MAP_T                 fd_runtime_prof_syscall_t
+#define MAP_KEY_T             uint
+#define MAP_KEY_NULL          0U
+#define MAP_KEY_INVAL(k)      !(k)
+#define MAP_KEY_EQUAL(k0,k1)  (k0)==(k1)
+#define MAP_KEY_EQUAL_IS_SLOW 0
+#define MAP_MEMOIZE           0
+#define MAP_KEY_HASH(k)       (k)
+#include "../../util/tmpl/fd_map_dynamic.c"
+
+#define SORT_NAME        fd_runtime_prof_prog_sort
+#define SORT_KEY_T       fd_runtime_prof_prog_t
+#define SORT_BEFORE(a,b) ((a).ticks>(b).ticks)
+#include "../../util/tmpl/fd_sort.c"
+
+#define SORT_NAME        fd_runtime_prof_syscall_sort
+#define SORT_KEY_T       fd_runtime_prof_syscall_t
+#define SORT_BEFORE(a,b) ((a).ticks>(b).ticks)
+#include "../../util/tmpl/fd_sort.c"
+
+/* There are less than 100 syscalls */
+
+#define SYSCALL_LG_SLOT_CNT (8)
+
+static int
+fd_runtime_prof_prog_lg_slot_cnt( ulong prog_max ) {
+  /* At most half full */
+  return fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*prog_max ) );
+}
+
+static inline fd_runtime_prof_shard_t *
+fd_runtime_prof_shards( fd_runtime_prof_t * prof ) {
+  return (fd_runtime_prof_shard_t *)fd_ulong_align_up( (ulong)(prof+1), alignof(fd_runtime_prof_shard_t) );
+}
+
+static inline fd_runtime_prof_shard_t const *
+fd_runtime_prof_shards_const( fd_runtime_prof_t const * prof ) {
+  return (fd_runtime_prof_shard_t const *)fd_ulong_align_up( (ulong)(prof+1), alignof(fd_runtime_prof_shard_t) );
+}
+
+FD_FN_CONST ulong
+fd_runtime_prof_align( void ) {
+  return FD_RUNTIME_PROF_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_runtime_prof_footprint( ulong shard_cnt,
+                           ulong prog_max,
+                           ulong slot_max ) {
+  if( FD_UNLIKELY( (!shard_cnt) | (shard_cnt>FD_TILE_MAX) ) ) return 0UL;
+  if( FD_UNLIKELY( (!prog_max ) | (prog_max >(1UL<<20)  ) ) ) return 0UL;
+  if( FD_UNLIKELY( (!slot_max ) | (slot_max >(1UL<<24)  ) ) ) return 0UL;
+
+  int lg_slot_cnt = fd_runtime_prof_prog_lg_slot_cnt( prog_max );
+
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, FD_RUNTIME_PROF_ALIGN,           sizeof(fd_runtime_prof_t)                  );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_runtime_prof_shard_t), shard_cnt*sizeof(fd_runtime_prof_shard_t) );
+  for( ulong i=0UL; i<shard_cnt; i++ ) {
+    l = FD_LAYOUT_APPEND( l, fd_runtime_prof_prog_map_align(),    fd_runtime_prof_prog_map_footprint( lg_slot_cnt )            );
+    l = FD_LAYOUT_APPEND( l, fd_runtime_prof_syscall_map_align(), fd_runtime_prof_syscall_map_footprint( SYSCALL_LG_SLOT_CNT ) );
+  }
+  l = FD_LAYOUT_APPEND( l, alignof(fd_runtime_prof_slot_t), slot_max*sizeof(fd_runtime_prof_slot_t) );
+  return FD_LAYOUT_FINI( l, FD_RUNTIME_PROF_ALIGN );
+}
+
+void *
+fd_runtime_prof_new( void * shmem,
+                     ulong  shard_cnt,
+                     ulong  prog_max,
+                     ulong  slot_max ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_runtime_prof_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_runtime_prof_footprint( shard_cnt, prog_max, slot_max );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad shard_cnt, prog_max or slot_max" ));
+    return NULL;
+  }
+
+  /* Map entry counters are never cleared, so they must start at 0 */
+  fd_memset( shmem, 0, footprint );
+
+  int lg_slot_cnt = fd_runtime_prof_prog_lg_slot_cnt( prog_max );
+
+  FD_SCRATCH_ALLOC_INIT( l, shmem );
+  fd_runtime_prof_t *       prof   = FD_SCRATCH_ALLOC_APPEND( l, FD_RUNTIME_PROF_ALIGN,           sizeof(fd_runtime_prof_t)                  );
+  fd_runtime_prof_shard_t * shards = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_runtime_prof_shard_t), shard_cnt*sizeof(fd_runtime_prof_shard_t) );
+  for( ulong i=0UL; i<shard_cnt; i++ ) {
+    void * prog_mem    = FD_SCRATCH_ALLOC_APPEND( l, fd_runtime_prof_prog_map_align(),    fd_runtime_prof_prog_map_footprint( lg_slot_cnt )            );
+    void * syscall_mem = FD_SCRATCH_ALLOC_APPEND( l, fd_runtime_prof_syscall_map_align(), fd_runtime_prof_syscall_map_footprint( SYSCALL_LG_SLOT_CNT ) );
+    shards[i].prog_off    = (ulong)fd_runtime_prof_prog_map_join   ( fd_runtime_prof_prog_map_new   ( prog_mem,    lg_slot_cnt         ) ) - (ulong)shmem;
+    shards[i].syscall_off = (ulong)fd_runtime_prof_syscall_map_join( fd_runtime_prof_syscall_map_new( syscall_mem, SYSCALL_LG_SLOT_CNT ) ) - (ulong)shmem;
+  }
+  void * slot_mem = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_runtime_prof_slot_t), slot_max*sizeof(fd_runtime_prof_slot_t) );
+  FD_TEST( FD_SCRATCH_ALLOC_FINI( l, FD_RUNTIME_PROF_ALIGN )==(ulong)shmem + footprint );
+  FD_TEST( shards==fd_runtime_prof_shards( prof ) );
+
+  prof->shard_cnt = shard_cnt;
+  prof->prog_max  = prog_max;
+  prof->slot_max  = slot_max;
+  prof->slot_off  = (ulong)slot_mem - (ulong)shmem;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( prof->magic ) = FD_RUNTIME_PROF_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_runtime_prof_t *
+fd_runtime_prof_join( void * shprof ) {
+
+  if( FD_UNLIKELY( !shprof ) ) {
+    FD_LOG_WARNING(( "NULL shprof" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shprof, fd_runtime_prof_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shprof" ));
+    return NULL;
+  }
+
+  fd_runtime_prof_t * prof = (fd_runtime_prof_t *)shprof;
+
+  if( FD_UNLIKELY( prof->magic!=FD_RUNTIME_PROF_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return prof;
+}
+
+void *
+fd_runtime_prof_leave( fd_runtime_prof_t * prof ) {
+
+  if( FD_UNLIKELY( !prof ) ) {
+    FD_LOG_WARNING(( "NULL prof" ));
+    return NULL;
+  }
+
+  return (void *)prof;
+}
+
+void *
+fd_runtime_prof_delete( void * shprof ) {
+
+  if( FD_UNLIKELY( !shprof ) ) {
+    FD_LOG_WARNING(( "NULL shprof" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shprof, fd_runtime_prof_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shprof" ));
+    return NULL;
+  }
+
+  fd_runtime_prof_t * prof = (fd_runtime_prof_t *)shprof;
+
+  if( FD_UNLIKELY( prof->magic!=FD_RUNTIME_PROF_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( prof->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shprof;
+}
+
+/* fd_runtime_prof_shard returns the shard of the caller's tile, NULL if
+   the profiler has no shard for it. */
+
+static inline fd_runtime_prof_shard_t *
+fd_runtime_prof_shard( fd_runtime_prof_t * prof ) {
+  ulong tile_idx = fd_tile_idx();
+  if( FD_UNLIKELY( tile_idx>=prof->shard_cnt ) ) return NULL;
+  return fd_runtime_prof_shards( prof ) + tile_idx;
+}
+
+void
+fd_runtime_prof_instr( fd_runtime_prof_t * prof,
+                       fd_pubkey_t const * id,
+                       ulong               ix,
+                       ulong               cus,
+                       long                ticks ) {
+  fd_runtime_prof_shard_t * shard = fd_runtime_prof_shard( prof );
+  if( FD_UNLIKELY( !shard ) ) return;
+
+  shard->instr_cnt++;
+  shard->cus += cus;
+
+  fd_runtime_prof_prog_t * map = (fd_runtime_prof_prog_t *)( (ulong)prof + shard->prog_off );
+  fd_runtime_prof_prog_key_t key = { .id = *id, .ix = ix };
+  fd_runtime_prof_prog_t * entry = fd_runtime_prof_prog_map_query( map, key, NULL );
+  if( FD_UNLIKELY( !entry ) ) {
+    entry = fd_runtime_prof_prog_map_insert( map, key );
+    if( FD_UNLIKELY( !entry ) ) {
+      shard->drop_cnt++;
+      return;
+    }
+  }
+  entry->cnt++;
+  entry->cus   += cus;
+  entry->ticks += (ulong)fd_long_max( ticks, 0L );
+}
+
+void
+fd_runtime_prof_syscall( fd_runtime_prof_t * prof,
+                         uint                key,
+                         char const *        name,
+                         ulong               cus,
+                         long                ticks ) {
+  fd_runtime_prof_shard_t * shard = fd_runtime_prof_shard( prof );
+  if( FD_UNLIKELY( !shard ) ) return;
+
+  shard->cus += cus;
+
+  fd_runtime_prof_syscall_t * map = (fd_runtime_prof_syscall_t *)( (ulong)prof + shard->syscall_off );
+  fd_runtime_prof_syscall_t * entry = fd_runtime_prof_syscall_map_query( map, key, NULL );
+  if( FD_UNLIKELY( !entry ) ) {
+    entry = fd_runtime_prof_syscall_map_insert( map, key );
+    if( FD_UNLIKELY( !entry ) ) {
+      shard->drop_cnt++;
+      return;
+    }
+    fd_cstr_printf( entry->name, FD_RUNTIME_PROF_SYSCALL_NAME_MAX, NULL, "%s", name ? name : "?" );
+  }
+  entry->cnt++;
+  entry->cus   += cus;
+  entry->ticks += (ulong)fd_long_max( ticks, 0L );
+}
+
+void
+fd_runtime_prof_totals( fd_runtime_prof_t const * prof,
+                        ulong *                   instr_cnt,
+                        ulong *                   cus,
+                        ulong *                   drop_cnt ) {
+  fd_runtime_prof_shard_t const * shards = fd_runtime_prof_shards_const( prof );
+  ulong _instr_cnt = 0UL;
+  ulong _cus       = 0UL;
+  ulong _drop_cnt  = 0UL;
+  for( ulong i=0UL; i<prof->shard_cnt; i++ ) {
+    _instr_cnt += FD_VOLATILE_CONST( shards[i].instr_cnt );
+    _cus       += FD_VOLATILE_CONST( shards[i].cus       );
+    _drop_cnt  += FD_VOLATILE_CONST( shards[i].drop_cnt  );
+  }
+  if( instr_cnt ) *instr_cnt = _instr_cnt;
+  if( cus       ) *cus       = _cus;
+  if( drop_cnt  ) *drop_cnt  = _drop_cnt;
+}
+
+void
+fd_runtime_prof_slot_end( fd_runtime_prof_t * prof,
+                          ulong               slot,
+                          ulong               txn_cnt ) {
+  ulong instr_cnt;
+  ulong cus;
+  fd_runtime_prof_totals( prof, &instr_cnt, &cus, NULL );
+
+  fd_runtime_prof_slot_t * cur = &prof->cur;
+  cur->slot      = slot;
+  cur->txn_cnt   = txn_cnt;
+  cur->instr_cnt = instr_cnt - prof->instr_cnt_mark;
+  cur->cus       = cus       - prof->cus_mark;
+  prof->instr_cnt_mark = instr_cnt;
+  prof->cus_mark       = cus;
+
+  fd_runtime_prof_slot_t * ring = (fd_runtime_prof_slot_t *)( (ulong)prof + prof->slot_off );
+  ring[ prof->slot_cnt % prof->slot_max ] = *cur;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( prof->slot_cnt ) = prof->slot_cnt + 1UL;
+  FD_COMPILER_MFENCE();
+
+  fd_memset( cur, 0, sizeof(fd_runtime_prof_slot_t) );
+}
+
+fd_runtime_prof_slot_t const *
+fd_runtime_prof_slot( fd_runtime_prof_t const * prof,
+                      ulong                     i ) {
+  ulong slot_cnt = FD_VOLATILE_CONST( prof->slot_cnt );
+  if( FD_UNLIKELY( i>=fd_ulong_min( slot_cnt, prof->slot_max ) ) ) return NULL;
+  fd_runtime_prof_slot_t const * ring = (fd_runtime_prof_slot_t const *)( (ulong)prof + prof->slot_off );
+  return ring + ( (slot_cnt-1UL-i) % prof->slot_max );
+}
+
+ulong
+fd_runtime_prof_prog_top( fd_runtime_prof_t const * prof,
+                          fd_runtime_prof_prog_t *  out,
+                          ulong                     out_max ) {
+  fd_runtime_prof_shard_t const * shards = fd_runtime_prof_shards_const( prof );
+  ulong out_cnt = 0UL;
+  for( ulong i=0UL; i<prof->shard_cnt; i++ ) {
+    fd_runtime_prof_prog_t const * map = (fd_runtime_prof_prog_t const *)( (ulong)prof + shards[i].prog_off );
+    ulong slot_cnt = fd_runtime_prof_prog_map_slot_cnt( map );
+    for( ulong j=0UL; j<slot_cnt; j++ ) {
+      fd_runtime_prof_prog_t const * e = map + j;
+      if( fd_runtime_prof_prog_map_key_inval( e->key ) ) continue;
+      ulong k;
+      for( k=0UL; k<out_cnt; k++ ) if( fd_runtime_prof_prog_map_key_equal( out[k].key, e->key ) ) break;
+      if( k==out_cnt ) {
+        if( FD_UNLIKELY( out_cnt==out_max ) ) continue;
+        out[ out_cnt++ ] = (fd_runtime_prof_prog_t){ .key = e->key };
+      }
+      out[k].cnt   += e->cnt;
+      out[k].cus   += e->cus;
+      out[k].ticks += e->ticks;
+    }
+  }
+  fd_runtime_prof_prog_sort_inplace( out, out_cnt );
+  return out_cnt;
+}
+
+ulong
+fd_runtime_prof_syscall_top( fd_runtime_prof_t const *   prof,
+                             fd_runtime_prof_syscall_t * out,
+                             ulong                       out_max ) {
+  fd_runtime_prof_shard_t const * shards = fd_runtime_prof_shards_const( prof );
+  ulong out_cnt = 0UL;
+  for( ulong i=0UL; i<prof->shard_cnt; i++ ) {
+    fd_runtime_prof_syscall_t const * map = (fd_runtime_prof_syscall_t const *)( (ulong)prof + shards[i].syscall_off );
+    ulong slot_cnt = fd_runtime_prof_syscall_map_slot_cnt( map );
+    for( ulong j=0UL; j<slot_cnt; j++ ) {
+      fd_runtime_prof_syscall_t const * e = map + j;
+      if( fd_runtime_prof_syscall_map_key_inval( e->key ) ) continue;
+      ulong k;
+      for( k=0UL; k<out_cnt; k++ ) if( out[k].key==e->key ) break;
+      if( k==out_cnt ) {
+        if( FD_UNLIKELY( out_cnt==out_max ) ) continue;
+        out[ out_cnt ] = (fd_runtime_prof_syscall_t){ .key = e->key };
+        fd_memcpy( out[ out_cnt ].name, e->name, FD_RUNTIME_PROF_SYSCALL_NAME_MAX );
+        out[ out_cnt ].name[ FD_RUNTIME_PROF_SYSCALL_NAME_MAX-1UL ] = '\0';
+        out_cnt++;
+      }
+      out[k].cnt   += e->cnt;
+      out[k].cus   += e->cus;
+      out[k].ticks += e->ticks;
+    }
+  }
+  fd_runtime_prof_syscall_sort_inplace( out, out_cnt );
+  return out_cnt;
+}
+
+char const *
+fd_runtime_prof_phase_name( int phase ) {
+  switch( phase ) {
+  case FD_RUNTIME_PROF_PHASE_PUBLISH:  return "publish";
+  case FD_RUNTIME_PROF_PHASE_PREPARE:  return "prepare";
+  case FD_RUNTIME_PROF_PHASE_VERIFY:   return "verify";
+  case FD_RUNTIME_PROF_PHASE_LOAD:     return "load";
+  case FD_RUNTIME_PROF_PHASE_EXECUTE:  return "execute";
+  case FD_RUNTIME_PROF_PHASE_FINALIZE: return "finalize";
+  case FD_RUNTIME_PROF_PHASE_HASH:     return "hash";
+  default: break;
+  }
+  return "unknown";
+}
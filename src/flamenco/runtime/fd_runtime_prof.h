@@ -0,0 +1,270 @@
+#ifndef HEADER_fd_src_flamenco_runtime_fd_runtime_prof_h
+#define HEADER_fd_src_flamenco_runtime_fd_runtime_prof_h
+
+/* fd_runtime_prof_t is a replay profiler living in shared memory.  It
+   attributes wall time (in ticks) and compute units to:
+
+   - each (program id, instruction type) pair, where the instruction
+     type is the first byte of the instruction data (the discriminant
+     of the native and SPL programs),
+   - each syscall,
+   - each runtime phase of block replay (see FD_RUNTIME_PROF_PHASE_*),
+   - each publish of rooted funk txns, bucketed by the number of records
+     published (see fd_runtime_prof_publish).
+
+   Instruction and syscall costs are exclusive: an instruction is not
+   charged for the syscalls it makes nor for the instructions it
+   invokes via CPI, so the costs sum to the total.
+
+   Instructions and syscalls run on the tpool workers, so every tile
+   records into its own shard (indexed by fd_tile_idx) and readers sum
+   the shards.  Phases and per-slot records are only written by the
+   tile replaying the block.  Readers can join the profiler from
+   another process while replay is running; they get a consistent
+   enough view for profiling (counters are read racily). */
+
+#include "../fd_flamenco_base.h"
+
+#define FD_RUNTIME_PROF_ALIGN (128UL)
+#define FD_RUNTIME_PROF_MAGIC (0xf17eda2ce7a50f17UL) /* random */
+
+/* Runtime phases of fd_runtime_block_eval_tpool */
+
+#define FD_RUNTIME_PROF_PHASE_PUBLISH  (0) /* publishing rooted funk txns */
+#define FD_RUNTIME_PROF_PHASE_PREPARE  (1) /* block parse, sysvar update, txn setup and scheduling */
+#define FD_RUNTIME_PROF_PHASE_VERIFY   (2) /* PoH and signature verification */
+#define FD_RUNTIME_PROF_PHASE_LOAD     (3) /* fee payer load and fee collection */
+#define FD_RUNTIME_PROF_PHASE_EXECUTE  (4) /* txn execution */
+#define FD_RUNTIME_PROF_PHASE_FINALIZE (5) /* txn account writeback */
+#define FD_RUNTIME_PROF_PHASE_HASH     (6) /* block finalize (account and bank hash) */
+#define FD_RUNTIME_PROF_PHASE_CNT      (7)
+
+/* Publishes of rooted funk txns are bucketed by the number of records
+   published.  Bucket 0 has the publishes of no records, bucket i in
+   [1,FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT-1) the publishes of
+   [2^(i-1),2^i) records and the last bucket the larger ones. */
+
+#define FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT (24UL)
+
+/* FD_RUNTIME_PROF_IX_NONE is the instruction type of instructions
+   without data */
+
+#define FD_RUNTIME_PROF_IX_NONE (256UL)
+
+#define FD_RUNTIME_PROF_SYSCALL_NAME_MAX (48UL)
+
+struct fd_runtime_prof_prog_key {
+  fd_pubkey_t id;
+  ulong       ix;  /* in [0,FD_RUNTIME_PROF_IX_NONE] */
+};
+typedef struct fd_runtime_prof_prog_key fd_runtime_prof_prog_key_t;
+
+struct fd_runtime_prof_prog {
+  fd_runtime_prof_prog_key_t key;
+  ulong                      cnt;
+  ulong                      cus;
+  ulong                      ticks;
+};
+typedef struct fd_runtime_prof_prog fd_runtime_prof_prog_t;
+
+struct fd_runtime_prof_syscall {
+  uint  key;  /* murmur3 hash of the syscall name, as in fd_sbpf_syscalls_t */
+  char  name[ FD_RUNTIME_PROF_SYSCALL_NAME_MAX ];
+  ulong cnt;
+  ulong cus;
+  ulong ticks;
+};
+typedef struct fd_runtime_prof_syscall fd_runtime_prof_syscall_t;
+
+/* fd_runtime_prof_publish_t is a bucket of the publish latency
+   histogram */
+
+struct fd_runtime_prof_publish {
+  ulong cnt;       /* publishes */
+  ulong rec_cnt;   /* records published */
+  long  ticks;     /* total latency */
+  long  ticks_max; /* worst latency */
+};
+typedef struct fd_runtime_prof_publish fd_runtime_prof_publish_t;
+
+/* fd_runtime_prof_slot_t summarizes one replayed slot */
+
+struct fd_runtime_prof_slot {
+  ulong slot;
+  ulong txn_cnt;
+  ulong instr_cnt;
+  ulong cus;
+  long  ticks[ FD_RUNTIME_PROF_PHASE_CNT ];
+};
+typedef struct fd_runtime_prof_slot fd_runtime_prof_slot_t;
+
+struct __attribute__((aligned(FD_RUNTIME_PROF_ALIGN))) fd_runtime_prof_shard {
+  ulong prog_off;     /* offset of this shard's program map from the profiler */
+  ulong syscall_off;  /* offset of this shard's syscall map from the profiler */
+  ulong instr_cnt;
+  ulong cus;
+  ulong drop_cnt;     /* instructions and syscalls not recorded as the maps were full */
+};
+typedef struct fd_runtime_prof_shard fd_runtime_prof_shard_t;
+
+struct __attribute__((aligned(FD_RUNTIME_PROF_ALIGN))) fd_runtime_prof {
+  ulong magic;        /* ==FD_RUNTIME_PROF_MAGIC */
+  ulong shard_cnt;
+  ulong prog_max;
+  ulong slot_max;
+  ulong slot_off;     /* offset of the slot ring from the profiler */
+
+  ulong slot_cnt;     /* number of slots recorded, the last min(slot_cnt,slot_max) are in the ring */
+  ulong phase_cnt  [ FD_RUNTIME_PROF_PHASE_CNT ];
+  long  phase_ticks[ FD_RUNTIME_PROF_PHASE_CNT ];
+
+  fd_runtime_prof_publish_t publish[ FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT ];
+
+  /* Replay tile private */
+
+  fd_runtime_prof_slot_t cur;  /* slot being replayed */
+  ulong                  instr_cnt_mark;
+  ulong                  cus_mark;
+
+  /* shard_cnt fd_runtime_prof_shard_t follow */
+};
+typedef struct fd_runtime_prof fd_runtime_prof_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST ulong
+fd_runtime_prof_align( void );
+
+/* fd_runtime_prof_footprint returns the footprint of a profiler with
+   shard_cnt shards (should be at least the number of tiles executing
+   transactions), room for prog_max distinct (program id, instruction
+   type) pairs per shard and a history of the last slot_max slots.
+   Returns 0 on bad args. */
+
+FD_FN_CONST ulong
+fd_runtime_prof_footprint( ulong shard_cnt,
+                           ulong prog_max,
+                           ulong slot_max );
+
+void *
+fd_runtime_prof_new( void * shmem,
+                     ulong  shard_cnt,
+                     ulong  prog_max,
+                     ulong  slot_max );
+
+fd_runtime_prof_t *
+fd_runtime_prof_join( void * shprof );
+
+void *
+fd_runtime_prof_leave( fd_runtime_prof_t * prof );
+
+void *
+fd_runtime_prof_delete( void * shprof );
+
+/* fd_runtime_prof_instr charges an instruction of program id executed
+   on the caller's tile.  cus and ticks exclude nested instructions and
+   syscalls. */
+
+void
+fd_runtime_prof_instr( fd_runtime_prof_t * prof,
+                       fd_pubkey_t const * id,
+                       ulong               ix,
+                       ulong               cus,
+                       long                ticks );
+
+/* fd_runtime_prof_syscall charges a syscall executed on the caller's
+   tile. */
+
+void
+fd_runtime_prof_syscall( fd_runtime_prof_t * prof,
+                         uint                key,
+                         char const *        name,
+                         ulong               cus,
+                         long                ticks );
+
+/* fd_runtime_prof_phase charges the time since tick t0 (as returned by
+   fd_tickcount) to phase.  prof can be NULL (no-op).  Should only be
+   called by the replay tile. */
+
+static inline void
+fd_runtime_prof_phase( fd_runtime_prof_t * prof,
+                       int                 phase,
+                       long                t0 ) {
+  if( FD_LIKELY( !prof ) ) return;
+  long dt = fd_tickcount() - t0;
+  prof->phase_cnt  [ phase ]++;
+  prof->phase_ticks[ phase ] += dt;
+  prof->cur.ticks  [ phase ] += dt;
+}
+
+/* fd_runtime_prof_publish_bucket returns the publish histogram bucket
+   of a publish of rec_cnt records. */
+
+FD_FN_CONST static inline ulong
+fd_runtime_prof_publish_bucket( ulong rec_cnt ) {
+  return rec_cnt ? fd_ulong_min( (ulong)fd_ulong_find_msb( rec_cnt )+1UL, FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT-1UL ) : 0UL;
+}
+
+/* fd_runtime_prof_publish charges the time since tick t0 (as returned
+   by fd_tickcount) to a publish of rec_cnt records.  prof can be NULL
+   (no-op).  Should only be called by the replay tile. */
+
+static inline void
+fd_runtime_prof_publish( fd_runtime_prof_t * prof,
+                         ulong               rec_cnt,
+                         long                t0 ) {
+  if( FD_LIKELY( !prof ) ) return;
+  long dt = fd_tickcount() - t0;
+  fd_runtime_prof_publish_t * bucket = prof->publish + fd_runtime_prof_publish_bucket( rec_cnt );
+  bucket->cnt++;
+  bucket->rec_cnt  += rec_cnt;
+  bucket->ticks    += dt;
+  bucket->ticks_max = fd_long_max( bucket->ticks_max, dt );
+}
+
+/* fd_runtime_prof_slot_end appends the slot that was just replayed
+   (with txn_cnt transactions) to the slot history.  Should only be
+   called by the replay tile. */
+
+void
+fd_runtime_prof_slot_end( fd_runtime_prof_t * prof,
+                          ulong               slot,
+                          ulong               txn_cnt );
+
+/* fd_runtime_prof_slot returns the i-th most recent slot record (0 is
+   the most recent), NULL if not in the history. */
+
+fd_runtime_prof_slot_t const *
+fd_runtime_prof_slot( fd_runtime_prof_t const * prof,
+                      ulong                     i );
+
+/* fd_runtime_prof_prog_top sums the program entries of all shards
+   into out (up to out_max distinct entries) ordered by decreasing
+   ticks.  Returns the number of entries in out.  Similarly for
+   fd_runtime_prof_syscall_top. */
+
+ulong
+fd_runtime_prof_prog_top( fd_runtime_prof_t const * prof,
+                          fd_runtime_prof_prog_t *  out,
+                          ulong                     out_max );
+
+ulong
+fd_runtime_prof_syscall_top( fd_runtime_prof_t const *   prof,
+                             fd_runtime_prof_syscall_t * out,
+                             ulong                       out_max );
+
+/* fd_runtime_prof_totals returns the instructions, CUs and dropped
+   records summed over all shards. */
+
+void
+fd_runtime_prof_totals( fd_runtime_prof_t const * prof,
+                        ulong *                   instr_cnt,
+                        ulong *                   cus,
+                        ulong *                   drop_cnt );
+
+char const *
+fd_runtime_prof_phase_name( int phase );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_flamenco_runtime_fd_runtime_prof_h */
@@ -7,6 +7,7 @@
 #include "../fd_account.h"
 #include "../sysvar/fd_sysvar_clock.h"
 #include "../sysvar/fd_sysvar_slot_hashes.h"
+#include "../sysvar/fd_sysvar_cache.h"
 #include "../../../ballet/ed25519/fd_curve25519.h"
 #include "../../vm/fd_vm_syscalls.h"
 #include "../../vm/fd_vm_cpi.h"
@@ -252,8 +253,8 @@ create_lookup_table( fd_exec_instr_ctx_t *       ctx,
   ulong derivation_slot = 1UL;
 
   do {
-    fd_slot_hashes_t slot_hashes[1];
-    if( FD_UNLIKELY( !fd_sysvar_slot_hashes_read( slot_hashes, ctx->slot_ctx ) ) )
+    fd_slot_hashes_t const * slot_hashes = fd_sysvar_cache_slot_hashes( ctx->slot_ctx->sysvar_cache );
+    if( FD_UNLIKELY( !slot_hashes ) )
       return FD_EXECUTOR_INSTR_ERR_UNSUPPORTED_SYSVAR;
 
     /* https://github.com/solana-labs/solana/blob/v1.17.4/programs/address-lookup-table/src/processor.rs#L97 */
@@ -269,9 +270,6 @@ create_lookup_table( fd_exec_instr_ctx_t *       ctx,
       }
     }
 
-    fd_bincode_destroy_ctx_t destroy = { .valloc = ctx->slot_ctx->valloc };
-    fd_slot_hashes_destroy( slot_hashes, &destroy );
-
     if( FD_UNLIKELY( !is_recent_slot ) ) {
       /* https://github.com/solana-labs/solana/blob/v1.17.4/programs/address-lookup-table/src/processor.rs#L100-L105 */
       FD_LOG_WARNING(("%lu is not a recent slot", create->recent_slot));
@@ -954,18 +952,14 @@ close_lookup_table( fd_exec_instr_ctx_t * ctx ) {
 
     int status;
     do {
-      /* https://github.com/solana-labs/solana/blob/v1.17.4/programs/address-lookup-table/src/processor.rs#L438
-         TODO THIS SHOULD BE A SCRATCH ALLOC */
-      fd_slot_hashes_t slot_hashes[1];
-      if( FD_UNLIKELY( !fd_sysvar_slot_hashes_read( slot_hashes, ctx->slot_ctx ) ) )
+      /* https://github.com/solana-labs/solana/blob/v1.17.4/programs/address-lookup-table/src/processor.rs#L438 */
+      fd_slot_hashes_t const * slot_hashes = fd_sysvar_cache_slot_hashes( ctx->slot_ctx->sysvar_cache );
+      if( FD_UNLIKELY( !slot_hashes ) )
         { err = FD_EXECUTOR_INSTR_ERR_UNSUPPORTED_SYSVAR; break; }
 
       /* https://github.com/solana-labs/solana/blob/v1.17.4/programs/address-lookup-table/src/processor.rs#L440 */
       ulong remaining_blocks = 0UL;
       status = fd_addrlut_status( &state->meta, clock->slot, slot_hashes, &remaining_blocks );
-
-      fd_bincode_destroy_ctx_t destroy = { .valloc = ctx->slot_ctx->valloc };
-      fd_slot_hashes_destroy( slot_hashes, &destroy );
     } while(0);
     if( FD_UNLIKELY( err!=FD_EXECUTOR_INSTR_SUCCESS ) ) break;
 
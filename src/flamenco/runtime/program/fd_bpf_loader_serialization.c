@@ -203,6 +203,25 @@ fd_bpf_loader_input_serialize_aligned( fd_exec_instr_ctx_t ctx,
   return serialized_params_start;
 }
 
+/* fd_bpf_loader_input_acc_is_unchanged returns 1 if acc is still copy
+   on write and the program left its lamports, owner and data as they
+   were serialized, in which case deserializing it is a no-op and the
+   account does not need to be copied. */
+
+static int
+fd_bpf_loader_input_acc_is_unchanged( fd_borrowed_account_t const * acc,
+                                      fd_pubkey_t const *           owner,
+                                      ulong                         lamports,
+                                      ulong                         post_data_len,
+                                      uchar const *                 post_data ) {
+  fd_account_meta_t const * meta = acc->const_meta;
+  return acc->is_cow &&
+         lamports==meta->info.lamports &&
+         post_data_len==meta->dlen &&
+         !memcmp( meta->info.owner, owner, sizeof(fd_pubkey_t) ) &&
+         !memcmp( acc->const_data, post_data, post_data_len );
+}
+
 int
 fd_bpf_loader_input_deserialize_aligned( fd_exec_instr_ctx_t ctx,
                                          ulong const *       pre_lens,
@@ -277,6 +296,14 @@ fd_bpf_loader_input_deserialize_aligned( fd_exec_instr_ctx_t ctx,
           return -1;
         }
 
+        if( fd_bpf_loader_input_acc_is_unchanged( view_acc, owner, lamports, post_data_len, post_data ) ) {
+          view_acc->cow_slot = ctx.slot_ctx->slot_bank.slot;
+          input_cursor += fd_ulong_align_up( pre_lens[i], 8 );
+          input_cursor += MAX_PERMITTED_DATA_INCREASE;
+          input_cursor += sizeof(ulong);
+          continue;
+        }
+
         fd_borrowed_account_t * modify_acc = NULL;
         int modify_err = fd_instr_borrowed_account_modify(&ctx, acc, acc_sz, &modify_acc);
         if ( modify_err != FD_ACC_MGR_SUCCESS ) {
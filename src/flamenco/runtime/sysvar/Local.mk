@@ -4,6 +4,8 @@ $(call add-objs,fd_sysvar,fd_flamenco)
 
 $(call add-hdrs,fd_sysvar_cache.h)
 $(call add-objs,fd_sysvar_cache,fd_flamenco)
+$(call make-unit-test,test_sysvar_cache,test_sysvar_cache,fd_flamenco fd_funk fd_ballet fd_util)
+$(call run-unit-test,test_sysvar_cache)
 
 $(call add-hdrs,fd_sysvar_clock.h)
 $(call add-objs,fd_sysvar_clock,fd_flamenco)
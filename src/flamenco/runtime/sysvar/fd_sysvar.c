@@ -2,6 +2,7 @@
 #include "../context/fd_exec_epoch_ctx.h"
 #include "../context/fd_exec_slot_ctx.h"
 #include "fd_sysvar_rent.h"
+#include "fd_sysvar_cache.h"
 
 int
 fd_sysvar_set( fd_exec_slot_ctx_t * slot_ctx,
@@ -39,5 +40,9 @@ fd_sysvar_set( fd_exec_slot_ctx_t * slot_ctx,
   rec->meta->dlen = sz;
   fd_memcpy(rec->meta->info.owner, owner, 32);
   rec->meta->slot = slot;
+
+  /* Keep the sysvar cache in sync without re-reading the account */
+  if( FD_LIKELY( slot_ctx->sysvar_cache ) )
+    fd_sysvar_cache_update( slot_ctx->sysvar_cache, pubkey, data, sz );
   return 0;
 }
@@ -70,6 +70,11 @@ fd_sysvar_cache_delete( fd_sysvar_cache_t * cache ) {
   FD_SYSVAR_CACHE_ITER(X)
 # undef X
 
+# define X( _type, name ) \
+  if( cache->data_##name->mem ) fd_valloc_free( cache->valloc, cache->data_##name->mem );
+  FD_SYSVAR_CACHE_ITER(X)
+# undef X
+
   return (void *)cache;
 }
 
@@ -84,6 +89,73 @@ fd_sysvar_cache_delete( fd_sysvar_cache_t * cache ) {
 FD_SYSVAR_CACHE_ITER(X)
 #undef X
 
+#define X( _type, name )                                               \
+  uchar const *                                                        \
+  fd_sysvar_cache_data_##name( fd_sysvar_cache_t const * cache,        \
+                               ulong *                   sz ) {        \
+    if( !cache->has_##name ) return NULL;                              \
+    *sz = cache->data_##name->sz;                                      \
+    return cache->data_##name->mem;                                    \
+  }
+FD_SYSVAR_CACHE_ITER(X)
+#undef X
+
+/* fd_sysvar_cache_data_set copies [data,data+sz) into the serialized
+   form d, growing its buffer if needed.  On allocation failure, leaves
+   d empty, so that the next refresh decodes the sysvar again. */
+
+static void
+fd_sysvar_cache_data_set( fd_sysvar_cache_t *      cache,
+                          fd_sysvar_cache_data_t * d,
+                          uchar const *            data,
+                          ulong                    sz ) {
+  if( FD_UNLIKELY( sz>d->max ) ) {
+    if( d->mem ) fd_valloc_free( cache->valloc, d->mem );
+    d->mem = fd_valloc_malloc( cache->valloc, 1UL, sz );
+    d->max = d->mem ? sz : 0UL;
+  }
+  if( FD_UNLIKELY( !d->mem && sz ) ) {
+    FD_LOG_WARNING(( "fd_valloc_malloc(%lu) failed", sz ));
+    d->sz = 0UL;
+    return;
+  }
+  if( FD_LIKELY( sz ) ) fd_memcpy( d->mem, data, sz );
+  d->sz = sz;
+}
+
+/* fd_sysvar_cache_refresh_{...} updates a cache entry from the sysvar
+   account data [data,data+sz).  Skips the decode if the data matches
+   the serialized form of the cached value. */
+
+#define X( type, name )                                                \
+  static void                                                          \
+  fd_sysvar_cache_refresh_##name( fd_sysvar_cache_t * cache,           \
+                                  uchar const *       data,            \
+                                  ulong               sz ) {           \
+    fd_sysvar_cache_data_t * d = cache->data_##name;                   \
+    if( cache->has_##name && d->sz==sz && 0==memcmp( d->mem, data, sz ) ) \
+      return;                                                          \
+                                                                       \
+    /* Destroy previous value */                                       \
+                                                                       \
+    fd_bincode_destroy_ctx_t destroy = { .valloc = cache->valloc };    \
+    type##_destroy( cache->val_##name, &destroy );                     \
+                                                                       \
+    /* Decode new value                                                \
+      type##_decode() does not do heap allocations on failure */       \
+                                                                       \
+    fd_bincode_decode_ctx_t decode =                                   \
+      { .data    = data,                                               \
+        .dataend = data + sz,                                          \
+        .valloc  = cache->valloc };                                    \
+    int err = type##_decode( cache->val_##name, &decode );             \
+    cache->has_##name = (err==FD_BINCODE_SUCCESS);                     \
+    if( cache->has_##name ) fd_sysvar_cache_data_set( cache, d, data, sz ); \
+    else                    d->sz = 0UL;                               \
+  }
+FD_SYSVAR_CACHE_ITER(X)
+#undef X
+
 /* Restore sysvars */
 
 void
@@ -107,26 +179,29 @@ fd_sysvar_cache_restore( fd_sysvar_cache_t * cache,
                                                                        \
     if( account->const_meta->info.lamports == 0UL ) break;             \
                                                                        \
-    /* Destroy previous value */                                       \
-                                                                       \
-    fd_bincode_destroy_ctx_t destroy = { .valloc = cache->valloc };    \
-    type##_destroy( cache->val_##name, &destroy );                     \
-                                                                       \
-    /* Decode new value                                                \
-      type##_decode() does not do heap allocations on failure */       \
-                                                                       \
-    fd_bincode_decode_ctx_t decode =                                   \
-      { .data    = account->const_data,                                \
-        .dataend = account->const_data + account->const_meta->dlen,    \
-        .valloc  = cache->valloc };                                    \
-    int err = type##_decode( cache->val_##name, &decode );             \
-    cache->has_##name = (err==FD_BINCODE_SUCCESS);                     \
+    fd_sysvar_cache_refresh_##name( cache, account->const_data,        \
+                                    account->const_meta->dlen );       \
   } while(0);
 
   FD_SYSVAR_CACHE_ITER(X)
 # undef X
 }
 
+void
+fd_sysvar_cache_update( fd_sysvar_cache_t * cache,
+                        fd_pubkey_t const * pubkey,
+                        uchar const *       data,
+                        ulong               sz ) {
+
+# define X( _type, name )                                              \
+  if( 0==memcmp( pubkey, &fd_sysvar_##name##_id, sizeof(fd_pubkey_t) ) ) { \
+    fd_sysvar_cache_refresh_##name( cache, data, sz );                 \
+    return;                                                            \
+  }
+  FD_SYSVAR_CACHE_ITER(X)
+# undef X
+}
+
 # define X( type, name )                                               \
   type##_t const *                                                     \
   fd_sysvar_from_instr_acct_##name( fd_exec_instr_ctx_t const * ctx,   \
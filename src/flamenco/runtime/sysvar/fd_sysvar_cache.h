@@ -20,6 +20,13 @@
    a sysvar account fails to parse, the corresponding cache entry will
    be NULL.
 
+   Alongside the parsed version, the cache keeps a copy of the account
+   data it was parsed from.  Restoring the cache only decodes sysvars
+   whose account data changed since the last restore (SlotHashes and
+   StakeHistory are large and rarely all change in the same slot).
+   When the runtime writes a sysvar account (fd_sysvar_set), the cache
+   entry is refreshed from the written data right away.
+
    ### Write back
 
    The sysvar cache can be modified directly by native programs.  There
@@ -46,6 +53,17 @@
   X( fd_stake_history,                stake_history       ) \
   X( fd_sol_sysvar_last_restart_slot, last_restart_slot   )
 
+/* fd_sysvar_cache_data_t is the serialized form of a cached sysvar
+   (the account data it was decoded from).  mem is heap allocated and
+   has room for max bytes. */
+
+struct fd_sysvar_cache_data {
+  uchar * mem;
+  ulong   sz;
+  ulong   max;
+};
+typedef struct fd_sysvar_cache_data fd_sysvar_cache_data_t;
+
 /* The memory of fd_sysvar_cache_t fits as much sysvar information into
    the struct as possible.  Unfortunately some parts of the sysvar
    spill out onto the heap due to how the type generator works.
@@ -53,7 +71,9 @@
    The has_{...} bits specify whether a sysvar logically exists.
    The val_{...} structs contain the top-level struct of each sysvar.
    If has_{...}==0 then any heap pointers in val_{...} are NULL,
-   allowing for safe idempotent calls to fd_sol_sysvar_{...}_destroy() */
+   allowing for safe idempotent calls to fd_sol_sysvar_{...}_destroy()
+   The data_{...} structs contain the serialized form of val_{...}.
+   data_{...}->sz==0 if has_{...}==0. */
 
 struct __attribute__((aligned(16UL))) fd_sysvar_cache_private {
   ulong       magic;  /* ==FD_SYSVAR_CACHE_MAGIC */
@@ -65,6 +85,12 @@ struct __attribute__((aligned(16UL))) fd_sysvar_cache_private {
   FD_SYSVAR_CACHE_ITER(X)
 # undef X
 
+  /* Declare the data_{...} values */
+# define X( _type, name ) \
+  fd_sysvar_cache_data_t data_##name[1];
+  FD_SYSVAR_CACHE_ITER(X)
+# undef X
+
   /* Declare the has_{...} bits */
 # define X( _type, name ) \
   ulong has_##name : 1;
@@ -116,6 +142,18 @@ fd_sysvar_cache_restore( fd_sysvar_cache_t * cache,
                          fd_acc_mgr_t *      acc_mgr,
                          fd_funk_txn_t *     funk_txn );
 
+/* fd_sysvar_cache_update refreshes the cache entry of the sysvar at
+   address pubkey with the account data [data,data+sz) that was just
+   written to the accounts DB.  The entry is only decoded if data
+   differs from the cached serialized form.  No-op if pubkey is not a
+   cached sysvar. */
+
+void
+fd_sysvar_cache_update( fd_sysvar_cache_t * cache,
+                        fd_pubkey_t const * pubkey,
+                        uchar const *       data,
+                        ulong               sz );
+
 /* Accessors for sysvars.  May return NULL. */
 
 FD_FN_PURE fd_sol_sysvar_clock_t             const * fd_sysvar_cache_clock              ( fd_sysvar_cache_t const * cache );
@@ -128,6 +166,20 @@ FD_FN_PURE fd_recent_block_hashes_t          const * fd_sysvar_cache_recent_bloc
 FD_FN_PURE fd_stake_history_t                const * fd_sysvar_cache_stake_history      ( fd_sysvar_cache_t const * cache );
 FD_FN_PURE fd_sol_sysvar_last_restart_slot_t const * fd_sysvar_cache_last_restart_slot  ( fd_sysvar_cache_t const * cache );
 
+/* Accessors for the serialized form of sysvars, i.e. the account data
+   the cached value was decoded from.  Return NULL if the sysvar is not
+   cached.  On non-NULL return, *sz is the size of the data. */
+
+uchar const * fd_sysvar_cache_data_clock              ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_epoch_schedule     ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_epoch_rewards      ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_fees               ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_rent               ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_slot_hashes        ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_recent_block_hashes( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_stake_history      ( fd_sysvar_cache_t const * cache, ulong * sz );
+uchar const * fd_sysvar_cache_data_last_restart_slot  ( fd_sysvar_cache_t const * cache, ulong * sz );
+
 /* fd_sysvar_from_instr_acct_{...} pretends to read a sysvar from an
    instruction account.  Checks that a given instruction account has
    an address matching the sysvar.  Returns the sysvar from the sysvar
@@ -0,0 +1,97 @@
+#include "fd_sysvar_cache.h"
+#include "../fd_system_ids.h"
+
+/* Encodes a slot hashes sysvar with cnt entries, the i-th entry being
+   (slot0-i, hash filled with (uchar)(slot0-i)).  Returns the encoded
+   size. */
+
+static ulong
+encode_slot_hashes( uchar * buf,
+                    ulong   slot0,
+                    ulong   cnt ) {
+  uchar * p = buf;
+  FD_STORE( ulong, p, cnt ); p += 8UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    FD_STORE( ulong, p, slot0-i ); p += 8UL;
+    fd_memset( p, (int)(uchar)(slot0-i), 32UL ); p += 32UL;
+  }
+  return (ulong)( p-buf );
+}
+
+static uchar buf[ 8UL + 512UL*40UL ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_valloc_t valloc = fd_libc_alloc_virtual();
+  void * mem = fd_valloc_malloc( valloc, fd_sysvar_cache_align(), fd_sysvar_cache_footprint() );
+  fd_sysvar_cache_t * cache = fd_sysvar_cache_new( mem, valloc );
+  FD_TEST( cache );
+
+  ulong sz;
+  FD_TEST( !fd_sysvar_cache_slot_hashes     ( cache      ) );
+  FD_TEST( !fd_sysvar_cache_data_slot_hashes( cache, &sz ) );
+
+  /* Runtime writes slot hashes */
+
+  ulong enc_sz = encode_slot_hashes( buf, 1000UL, 512UL );
+  fd_sysvar_cache_update( cache, &fd_sysvar_slot_hashes_id, buf, enc_sz );
+
+  fd_slot_hashes_t const * slot_hashes = fd_sysvar_cache_slot_hashes( cache );
+  FD_TEST( slot_hashes );
+  FD_TEST( deq_fd_slot_hash_t_cnt( slot_hashes->hashes )==512UL );
+  FD_TEST( deq_fd_slot_hash_t_peek_head_const( slot_hashes->hashes )->slot==1000UL );
+  FD_TEST( deq_fd_slot_hash_t_peek_tail_const( slot_hashes->hashes )->slot== 489UL );
+
+  uchar const * data = fd_sysvar_cache_data_slot_hashes( cache, &sz );
+  FD_TEST( data && sz==enc_sz && 0==memcmp( data, buf, enc_sz ) );
+
+  /* Unchanged data is not decoded again */
+
+  fd_slot_hash_t * hashes = slot_hashes->hashes;
+  fd_sysvar_cache_update( cache, &fd_sysvar_slot_hashes_id, buf, enc_sz );
+  FD_TEST( slot_hashes->hashes==hashes );
+
+  /* Changed data is */
+
+  FD_TEST( encode_slot_hashes( buf, 1001UL, 512UL )==enc_sz );
+  fd_sysvar_cache_update( cache, &fd_sysvar_slot_hashes_id, buf, enc_sz );
+  FD_TEST( deq_fd_slot_hash_t_peek_head_const( slot_hashes->hashes )->slot==1001UL );
+  data = fd_sysvar_cache_data_slot_hashes( cache, &sz );
+  FD_TEST( data && sz==enc_sz && 0==memcmp( data, buf, enc_sz ) );
+
+  /* Clock */
+
+  fd_sol_sysvar_clock_t clock = {
+    .slot                  = 1001UL,
+    .epoch_start_timestamp = 1700000000L,
+    .epoch                 = 2UL,
+    .leader_schedule_epoch = 3UL,
+    .unix_timestamp        = 1700000400L
+  };
+  uchar clock_enc[ 40 ];
+  fd_bincode_encode_ctx_t encode = { .data = clock_enc, .dataend = clock_enc+sizeof(clock_enc) };
+  FD_TEST( fd_sol_sysvar_clock_encode( &clock, &encode )==FD_BINCODE_SUCCESS );
+  fd_sysvar_cache_update( cache, &fd_sysvar_clock_id, clock_enc, sizeof(clock_enc) );
+  FD_TEST( fd_sysvar_cache_clock( cache ) );
+  FD_TEST( 0==memcmp( fd_sysvar_cache_clock( cache ), &clock, sizeof(fd_sol_sysvar_clock_t) ) );
+
+  /* Bad data clears the entry */
+
+  fd_sysvar_cache_update( cache, &fd_sysvar_clock_id, clock_enc, 8UL );
+  FD_TEST( !fd_sysvar_cache_clock     ( cache      ) );
+  FD_TEST( !fd_sysvar_cache_data_clock( cache, &sz ) );
+
+  /* Sysvars that are not cached are ignored */
+
+  fd_sysvar_cache_update( cache, &fd_sysvar_slot_history_id, buf, enc_sz );
+  FD_TEST( fd_sysvar_cache_slot_hashes( cache ) );
+
+  fd_valloc_free( valloc, fd_sysvar_cache_delete( cache ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,200 @@
+#include "fd_rocksdb.h"
+
+#include <ftw.h>
+#include <stdio.h>
+
+/* Tests fd_rocksdb_prefetch_t against two small rocksdbs.  The first
+   has roots with gaps (including gaps longer than a range), a meta
+   chain past the end of its root column (that crosses a range boundary
+   while the root column iterator is on roots without metas) and a slot
+   whose shreds are missing.  The second continues where the chain ends
+   (and also has roots that a walk ignores as the first rocksdb covers
+   them).  The first also has stale roots past where the walk leaves it,
+   which the walk never gets back to.  The prefetched blocks must be the
+   walk's, in slot order and read from the right rocksdb, whatever the
+   number of tiles and the depth. */
+
+#define START_SLOT (1000UL)
+#define BAD_SLOT   (1020UL) /* meta says it has a shred but it is missing */
+#define TRASH_SLOT (1009UL)
+#define SLOT_MAX   (512UL)
+
+static ulong expected_slot[ SLOT_MAX ];
+static long  expected_ts  [ SLOT_MAX ];
+static ulong expected_cnt;
+
+static void
+put_root( fd_rocksdb_t * db,
+          ulong          slot ) {
+  ulong key = fd_ulong_bswap( slot );
+  uchar one = 1;
+  FD_TEST( !fd_rocksdb_insert_entry( db, FD_ROCKSDB_CFIDX_ROOT, (char const *)&key, sizeof(ulong), (char const *)&one, 1UL ) );
+}
+
+static void
+put_slot( fd_rocksdb_t * db,
+          ulong          slot,
+          int            root,
+          long           ts,
+          ulong          received ) {
+  ulong key = fd_ulong_bswap( slot );
+
+  fd_slot_meta_t meta[1];
+  fd_slot_meta_new( meta );
+  meta->slot     = slot;
+  meta->received = received;
+  uchar buf[ 256 ];
+  fd_bincode_encode_ctx_t encode = { .data = buf, .dataend = buf+sizeof(buf) };
+  FD_TEST( fd_slot_meta_encode( meta, &encode )==FD_BINCODE_SUCCESS );
+  ulong meta_sz = (ulong)((uchar *)encode.data - buf);
+
+  FD_TEST( !fd_rocksdb_insert_entry( db, FD_ROCKSDB_CFIDX_META, (char const *)&key, sizeof(ulong), (char const *)buf, meta_sz ) );
+  if( root ) put_root( db, slot );
+  FD_TEST( !fd_rocksdb_insert_entry( db, FD_ROCKSDB_CFIDX_BLOCKTIME, (char const *)&key, sizeof(ulong), (char const *)&ts, sizeof(long) ) );
+}
+
+static void
+expect( ulong slot,
+        long  ts ) {
+  FD_TEST( expected_cnt<SLOT_MAX );
+  expected_slot[ expected_cnt ] = slot;
+  expected_ts  [ expected_cnt ] = ts;
+  expected_cnt++;
+}
+
+static void
+populate( char const * path0,
+          char const * path1 ) {
+  fd_rocksdb_t db[1];
+
+  fd_rocksdb_new( db, path0 );
+  for( ulong slot=START_SLOT; slot<1199UL; slot++ ) {
+    if( slot%3UL==2UL || (1050UL<=slot && slot<1090UL) ) continue;
+    put_slot( db, slot, 1, (long)slot, slot==BAD_SLOT ? 1UL : 0UL );
+    expect( slot, (long)slot );
+  }
+  for( ulong slot=1199UL; slot<1212UL; slot++ ) { /* not rooted, crosses the range boundary at 1208 */
+    put_slot( db, slot, 0, (long)slot, 0UL );
+    expect( slot, (long)slot );
+  }
+  /* Roots without metas, each step of the chain above (and the step to
+     path1) moves the root column iterator past one of them */
+  for( ulong slot=1250UL; slot<1264UL; slot++ ) put_root( db, slot );
+  /* Stale roots, the walk is in path1 by now */
+  for( ulong slot=1264UL; slot<1280UL; slot++ ) put_slot( db, slot, 1, -2L, 0UL );
+  fd_rocksdb_destroy( db );
+
+  fd_rocksdb_new( db, path1 );
+  for( ulong slot=1100UL; slot<1212UL; slot++ ) put_slot( db, slot, 1, -1L, 0UL ); /* covered by path0 */
+  for( ulong slot=1212UL; slot<1300UL; slot++ ) {
+    if( slot%5UL==1UL ) continue;
+    put_slot( db, slot, 1, (long)slot+1000000L, 0UL );
+    expect( slot, (long)slot+1000000L );
+  }
+  fd_rocksdb_destroy( db );
+}
+
+static int
+rm_cb( char const *        path,
+       struct stat const * sb,
+       int                 type,
+       struct FTW *        ftw ) {
+  (void)sb; (void)type; (void)ftw;
+  return remove( path );
+}
+
+static void
+rm_rf( char const * path ) {
+  nftw( path, rm_cb, 16, FTW_DEPTH | FTW_PHYS );
+}
+
+/* check prefetches [START_SLOT,end_slot] and checks the blocks against
+   the expected ones.  If stop_cnt is non-zero, stops (without releasing
+   the last block) after stop_cnt blocks. */
+
+static void
+check( char const * const * path,
+       ulong                end_slot,
+       ulong                depth,
+       ulong                tile_cnt,
+       ulong                stop_cnt ) {
+  static fd_rocksdb_prefetch_t pf[1];
+  FD_TEST( fd_rocksdb_prefetch_init( pf, path, 2UL, START_SLOT, end_slot, TRASH_SLOT, depth, fd_tile_cnt()-tile_cnt, tile_cnt )==pf );
+
+  ulong cnt = 0UL;
+  for(;;) {
+    int err = -2;
+    fd_rocksdb_block_t * blk = fd_rocksdb_prefetch_next( pf, &err );
+    if( !blk ) break;
+    FD_TEST( fd_rocksdb_prefetch_next( pf, &err )==blk ); /* same block until released */
+
+    FD_TEST( cnt<expected_cnt );
+    FD_TEST( blk->slot==expected_slot[ cnt ] );
+    FD_TEST( blk->slot<=end_slot );
+    if( blk->slot==BAD_SLOT ) {
+      FD_TEST( err );
+    } else {
+      FD_TEST( !err );
+      FD_TEST( !blk->shred_cnt );
+      FD_TEST( blk->has_ts && blk->ts==expected_ts[ cnt ]*(long)1e9 );
+      FD_TEST( blk->has_bank_hash==(blk->slot==TRASH_SLOT) );
+      if( blk->slot==TRASH_SLOT ) for( ulong i=0UL; i<32UL; i++ ) FD_TEST( blk->bank_hash.hash[ i ]==0xFE );
+    }
+    cnt++;
+    if( cnt==stop_cnt ) break;
+    fd_rocksdb_prefetch_release( pf );
+  }
+
+  if( !stop_cnt ) {
+    ulong want = 0UL;
+    while( want<expected_cnt && expected_slot[ want ]<=end_slot ) want++;
+    FD_TEST( cnt==want );
+    int err;
+    FD_TEST( !fd_rocksdb_prefetch_next( pf, &err ) ); /* stays at the end */
+  }
+
+  fd_rocksdb_prefetch_fini( pf );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * dir = fd_env_strip_cmdline_cstr( &argc, &argv, "--dir", NULL, "/tmp" );
+
+  char path0[ PATH_MAX ]; FD_TEST( fd_cstr_printf_check( path0, PATH_MAX, NULL, "%s/test_rocksdb_prefetch.%lu.0", dir, fd_log_group_id() ) );
+  char path1[ PATH_MAX ]; FD_TEST( fd_cstr_printf_check( path1, PATH_MAX, NULL, "%s/test_rocksdb_prefetch.%lu.1", dir, fd_log_group_id() ) );
+  char const * path[2] = { path0, path1 };
+  rm_rf( path0 ); rm_rf( path1 );
+
+  populate( path0, path1 );
+  FD_LOG_NOTICE(( "%lu blocks", expected_cnt ));
+
+  /* Bad args */
+
+  static fd_rocksdb_prefetch_t pf[1];
+  FD_TEST( !fd_rocksdb_prefetch_init( NULL, path, 2UL, START_SLOT,  ULONG_MAX, TRASH_SLOT, 1UL, 0UL, 0UL ) );
+  FD_TEST( !fd_rocksdb_prefetch_init( pf,   path, 0UL, START_SLOT,  ULONG_MAX, TRASH_SLOT, 1UL, 0UL, 0UL ) );
+  FD_TEST( !fd_rocksdb_prefetch_init( pf,   path, 2UL, START_SLOT,  ULONG_MAX, TRASH_SLOT, 0UL, 0UL, 0UL ) );
+  FD_TEST( !fd_rocksdb_prefetch_init( pf,   path, 2UL, 1060UL,      ULONG_MAX, TRASH_SLOT, 1UL, 0UL, 0UL ) ); /* not a root */
+
+  ulong tile_max = fd_ulong_min( fd_tile_cnt()-1UL, 3UL );
+  FD_LOG_NOTICE(( "Testing with up to %lu prefetch tiles", tile_max ));
+
+  for( ulong tile_cnt=0UL; tile_cnt<=tile_max; tile_cnt++ ) {
+    ulong depth_min = fd_ulong_max( tile_cnt, 1UL );
+    check( path, ULONG_MAX,  depth_min,     tile_cnt, 0UL  );
+    check( path, ULONG_MAX,  depth_min+7UL, tile_cnt, 0UL  );
+    check( path, 1250UL,     depth_min,     tile_cnt, 0UL  ); /* ends mid range */
+    check( path, 1198UL,     depth_min+1UL, tile_cnt, 0UL  ); /* ends before the meta chain */
+    check( path, START_SLOT, depth_min,     tile_cnt, 0UL  );
+    check( path, ULONG_MAX,  depth_min+3UL, tile_cnt, 40UL ); /* fini with blocks in flight */
+  }
+
+  rm_rf( path0 ); rm_rf( path1 );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -0,0 +1,146 @@
+#include "fd_runtime_prof.h"
+
+#define SHARD_MAX (64UL)
+#define PROG_MAX  (8UL)
+#define SLOT_MAX  (4UL)
+
+static uchar mem[ 1UL<<20 ] __attribute__((aligned(FD_RUNTIME_PROF_ALIGN)));
+
+static fd_pubkey_t *
+key_set( fd_pubkey_t * key,
+         ulong         i ) {
+  memset( key, 0, sizeof(fd_pubkey_t) );
+  key->ul[1] = i;
+  return key;
+}
+
+/* Each tile charges i+1 instructions of ix type i of program i for
+   i in [0,PROG_MAX) and one syscall */
+
+static int
+tile_main( int     argc,
+           char ** argv ) {
+  (void)argc;
+  fd_runtime_prof_t * prof = (fd_runtime_prof_t *)argv;
+  fd_pubkey_t key[1];
+  for( ulong i=0UL; i<PROG_MAX; i++ ) {
+    for( ulong j=0UL; j<=i; j++ ) fd_runtime_prof_instr( prof, key_set( key, i ), i, 10UL, (long)(100UL*(i+1UL)) );
+  }
+  fd_runtime_prof_syscall( prof, 0x1234U, "sol_log_", 100UL, 7L );
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong tile_cnt  = fd_tile_cnt();
+  ulong shard_cnt = fd_ulong_min( tile_cnt, SHARD_MAX );
+
+  FD_TEST( !fd_runtime_prof_footprint( 0UL, PROG_MAX, SLOT_MAX ) );
+  FD_TEST( !fd_runtime_prof_footprint( 1UL, 0UL,      SLOT_MAX ) );
+  FD_TEST( !fd_runtime_prof_footprint( 1UL, PROG_MAX, 0UL      ) );
+
+  ulong footprint = fd_runtime_prof_footprint( shard_cnt, PROG_MAX, SLOT_MAX );
+  FD_TEST( footprint && footprint<=sizeof(mem) );
+  FD_TEST( fd_ulong_is_aligned( footprint, fd_runtime_prof_align() ) );
+
+  FD_TEST( !fd_runtime_prof_new( NULL,    shard_cnt, PROG_MAX, SLOT_MAX ) );
+  FD_TEST( !fd_runtime_prof_new( mem+1UL, shard_cnt, PROG_MAX, SLOT_MAX ) );
+  FD_TEST( !fd_runtime_prof_join( mem ) );
+
+  fd_runtime_prof_t * prof = fd_runtime_prof_join( fd_runtime_prof_new( mem, shard_cnt, PROG_MAX, SLOT_MAX ) );
+  FD_TEST( prof );
+
+  /* Record from every tile that has a shard */
+
+  ulong rec_cnt = fd_ulong_min( tile_cnt, shard_cnt );
+  for( ulong t=1UL; t<rec_cnt; t++ ) {
+    fd_tile_exec_t * exec = fd_tile_exec_new( t, tile_main, 0, (char **)prof );
+    FD_TEST( exec );
+    FD_TEST( !fd_tile_exec_delete( exec, NULL ) );
+  }
+  tile_main( 0, (char **)prof );
+
+  ulong instr_cnt; ulong cus; ulong drop_cnt;
+  fd_runtime_prof_totals( prof, &instr_cnt, &cus, &drop_cnt );
+  ulong per_tile = PROG_MAX*(PROG_MAX+1UL)/2UL;
+  FD_TEST( instr_cnt==rec_cnt*per_tile );
+  FD_TEST( cus==rec_cnt*(10UL*per_tile + 100UL) );
+  FD_TEST( !drop_cnt );
+
+  /* Programs are ordered by decreasing time and summed over shards */
+
+  fd_runtime_prof_prog_t prog[ PROG_MAX ];
+  FD_TEST( fd_runtime_prof_prog_top( prof, prog, PROG_MAX )==PROG_MAX );
+  for( ulong i=0UL; i<PROG_MAX; i++ ) {
+    ulong p = PROG_MAX-1UL-i;
+    fd_pubkey_t key[1];
+    FD_TEST( !memcmp( prog[i].key.id.uc, key_set( key, p )->uc, sizeof(fd_pubkey_t) ) );
+    FD_TEST( prog[i].key.ix==p );
+    FD_TEST( prog[i].cnt==rec_cnt*(p+1UL) );
+    FD_TEST( prog[i].cus==rec_cnt*(p+1UL)*10UL );
+    FD_TEST( prog[i].ticks==rec_cnt*(p+1UL)*(p+1UL)*100UL );
+  }
+  FD_TEST( fd_runtime_prof_prog_top( prof, prog, 3UL )==3UL );
+
+  fd_runtime_prof_syscall_t syscall[ 4 ];
+  FD_TEST( fd_runtime_prof_syscall_top( prof, syscall, 4UL )==1UL );
+  FD_TEST( syscall[0].key==0x1234U && !strcmp( syscall[0].name, "sol_log_" ) );
+  FD_TEST( syscall[0].cnt==rec_cnt && syscall[0].cus==100UL*rec_cnt && syscall[0].ticks==7UL*rec_cnt );
+
+  /* Full program maps drop records */
+
+  fd_pubkey_t key[1];
+  for( ulong i=0UL; i<4UL*PROG_MAX; i++ ) fd_runtime_prof_instr( prof, key_set( key, 1000UL+i ), FD_RUNTIME_PROF_IX_NONE, 0UL, 0L );
+  fd_runtime_prof_totals( prof, NULL, NULL, &drop_cnt );
+  FD_TEST( drop_cnt );
+
+  /* Slot history keeps the last SLOT_MAX slots */
+
+  FD_TEST( !fd_runtime_prof_slot( prof, 0UL ) );
+  for( ulong slot=100UL; slot<110UL; slot++ ) {
+    fd_runtime_prof_phase( prof, FD_RUNTIME_PROF_PHASE_EXECUTE, fd_tickcount() );
+    fd_runtime_prof_instr( prof, key_set( key, 0UL ), 0UL, slot, 0L );
+    fd_runtime_prof_slot_end( prof, slot, slot-100UL );
+  }
+  FD_TEST( prof->phase_cnt[ FD_RUNTIME_PROF_PHASE_EXECUTE ]==10UL );
+  FD_TEST( !fd_runtime_prof_slot( prof, SLOT_MAX ) );
+  for( ulong i=0UL; i<SLOT_MAX; i++ ) {
+    fd_runtime_prof_slot_t const * s = fd_runtime_prof_slot( prof, i );
+    FD_TEST( s );
+    FD_TEST( s->slot==109UL-i );
+    FD_TEST( s->txn_cnt==9UL-i );
+    FD_TEST( s->instr_cnt==1UL );
+    FD_TEST( s->cus==109UL-i );
+    FD_TEST( s->ticks[ FD_RUNTIME_PROF_PHASE_EXECUTE ]>=0L );
+    FD_TEST( !s->ticks[ FD_RUNTIME_PROF_PHASE_HASH ] );
+  }
+
+  FD_TEST( !strcmp( fd_runtime_prof_phase_name( FD_RUNTIME_PROF_PHASE_HASH ), "hash" ) );
+
+  /* Publishes are bucketed by record count */
+
+  FD_TEST( fd_runtime_prof_publish_bucket( 0UL       )==0UL );
+  FD_TEST( fd_runtime_prof_publish_bucket( 1UL       )==1UL );
+  FD_TEST( fd_runtime_prof_publish_bucket( 2UL       )==2UL );
+  FD_TEST( fd_runtime_prof_publish_bucket( 3UL       )==2UL );
+  FD_TEST( fd_runtime_prof_publish_bucket( 4096UL    )==13UL );
+  FD_TEST( fd_runtime_prof_publish_bucket( ULONG_MAX )==FD_RUNTIME_PROF_PUBLISH_BUCKET_CNT-1UL );
+  fd_runtime_prof_publish( NULL, 1UL, fd_tickcount() );
+  for( ulong i=0UL; i<3UL; i++ ) fd_runtime_prof_publish( prof, 5000UL+i, fd_tickcount() );
+  fd_runtime_prof_publish( prof, 0UL, fd_tickcount() );
+  FD_TEST( prof->publish[ 13 ].cnt==3UL && prof->publish[ 13 ].rec_cnt==15003UL );
+  FD_TEST( prof->publish[ 13 ].ticks>=prof->publish[ 13 ].ticks_max && prof->publish[ 13 ].ticks_max>=0L );
+  FD_TEST( prof->publish[ 0 ].cnt==1UL && !prof->publish[ 0 ].rec_cnt );
+  FD_TEST( !prof->publish[ 12 ].cnt && !prof->publish[ 14 ].cnt );
+
+  FD_TEST( fd_runtime_prof_leave( prof )==mem );
+  FD_TEST( fd_runtime_prof_delete( mem )==mem );
+  FD_TEST( !fd_runtime_prof_join( mem ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -1,10 +1,15 @@
 #include "fd_shredcap.h"
 
+#include <sys/mman.h>
+
+#if FD_HAS_ZSTD
+#include <zstd.h>
+#endif
+
 #define BUF_ALIGN               (16UL)
 #define WBUF_FOOTPRINT          (65536UL)
 #define MANIFEST_BUF_FOOTPRINT  (512UL)
 #define BANK_HASH_BUF_FOOTPRINT (64UL)
-#define RBUF_FOOTPRINT          (65536UL)
 #define FILE_SLOT_NUM_DIGITS    (20UL) /* Max number of digits in a ulong */
 
 /**** Helpers *****************************************************************/
@@ -25,13 +30,83 @@ fd_shredcap_concat( char * buf, const char * dir, const char * file ) {
   fd_cstr_append_cstr( buf + strlen( dir ), file );
 }
 
+FD_STATIC_ASSERT( sizeof(fd_shredcap_file_hdr_t)==FD_SHREDCAP_FILE_HDR_FOOTPRINT,             file_hdr );
+FD_STATIC_ASSERT( sizeof(fd_shredcap_slot_hdr_t)==FD_SHREDCAP_SLOT_HDR_FOOTPRINT,             slot_hdr );
+FD_STATIC_ASSERT( sizeof(fd_shredcap_slot_idx_entry_t)==FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT, slot_idx );
+
+/* fd_shredcap_write_slot writes the slot header, payload (compressed
+   if zstd_level is non-zero and it makes the payload smaller) and slot
+   footer of the block described by metadata to ostream. */
+static void
+fd_shredcap_write_slot( fd_io_buffered_ostream_t * ostream,
+                        fd_slot_meta_t const *     metadata,
+                        uchar const *              payload,
+                        ulong                      payload_sz,
+                        uchar *                    zbuf,
+                        ulong                      zbuf_sz,
+                        int                        zstd_level ) {
+  uchar const * data    = payload;
+  ulong         data_sz = payload_sz;
+  uint          codec   = FD_SHREDCAP_CODEC_RAW;
+
+# if FD_HAS_ZSTD
+  if ( zstd_level ) {
+    size_t zsz = ZSTD_compress( zbuf, zbuf_sz, payload, payload_sz, zstd_level );
+    if ( FD_UNLIKELY( ZSTD_isError( zsz ) ) ) {
+      FD_LOG_ERR(( "ZSTD_compress failed for slot=%lu (%s)", metadata->slot, ZSTD_getErrorName( zsz ) ));
+    }
+    ulong padded_sz = fd_ulong_align_up( (ulong)zsz, FD_SHREDCAP_ALIGN );
+    if ( padded_sz < payload_sz ) {
+      fd_memset( zbuf + zsz, 0, padded_sz - (ulong)zsz );
+      data    = zbuf;
+      data_sz = padded_sz;
+      codec   = FD_SHREDCAP_CODEC_ZSTD;
+    }
+  }
+# else
+  (void)zbuf; (void)zbuf_sz; (void)zstd_level;
+# endif
+
+  fd_shredcap_slot_hdr_t slot_hdr;
+  fd_memset( &slot_hdr, 0, sizeof(slot_hdr) );
+  slot_hdr.magic                 = FD_SHREDCAP_SLOT_HDR_MAGIC;
+  slot_hdr.version               = FD_SHREDCAP_SLOT_HDR_VERSION;
+  slot_hdr.payload_sz            = data_sz;
+  slot_hdr.slot                  = metadata->slot;
+  slot_hdr.consumed              = metadata->consumed;
+  slot_hdr.received              = metadata->received;
+  slot_hdr.first_shred_timestamp = metadata->first_shred_timestamp;
+  slot_hdr.last_index            = metadata->last_index;
+  slot_hdr.parent_slot           = metadata->parent_slot;
+  slot_hdr.raw_payload_sz        = payload_sz;
+  slot_hdr.codec                 = codec;
+
+  fd_shredcap_slot_ftr_t slot_ftr;
+  slot_ftr.magic      = FD_SHREDCAP_SLOT_FTR_MAGIC;
+  slot_ftr.payload_sz = data_sz;
+
+  int err = fd_io_buffered_ostream_write( ostream, &slot_hdr, FD_SHREDCAP_SLOT_HDR_FOOTPRINT );
+  if ( FD_LIKELY( !err ) ) err = fd_io_buffered_ostream_write( ostream, data, data_sz );
+  if ( FD_LIKELY( !err ) ) err = fd_io_buffered_ostream_write( ostream, &slot_ftr, FD_SHREDCAP_SLOT_FTR_FOOTPRINT );
+  if ( FD_UNLIKELY( err ) ) {
+    FD_LOG_ERR(( "error writing slot=%lu (%i-%s)", metadata->slot, err, fd_io_strerror( err ) ));
+  }
+}
+
 /**** Ingest ******************************************************************/
 void
 fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
                                          const char * capture_dir,
                                          ulong        max_file_sz,
                                          ulong        start_slot,
-                                         ulong        end_slot ) {
+                                         ulong        end_slot,
+                                         int          zstd_level ) {
+# if !FD_HAS_ZSTD
+  if ( FD_UNLIKELY( zstd_level ) ) {
+    FD_LOG_ERR(( "zstd compression requested but this build does not have zstd support" ));
+  }
+# endif
+
   /* Setup and start rocksdb ingest */
   fd_rocksdb_t rocks_db;
   char * rocksdb_err = fd_rocksdb_init( &rocks_db, rocksdb_dir );
@@ -128,6 +203,28 @@ fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
   fd_shredcap_concat( tmp_path_buf, capture_dir, "temp" );
   uchar wbuf[ WBUF_FOOTPRINT ] __attribute__((aligned(BUF_ALIGN)));
 
+  /* Each slot is staged in payload (and compressed into zbuf) before it
+     is written out so the slot header can be written in one go */
+  uchar * payload = fd_valloc_malloc( valloc, BUF_ALIGN, FD_SHREDCAP_SLOT_PAYLOAD_MAX );
+  ulong   zbuf_sz = 0UL;
+  uchar * zbuf    = NULL;
+# if FD_HAS_ZSTD
+  if ( zstd_level ) {
+    zbuf_sz = fd_ulong_align_up( (ulong)ZSTD_compressBound( FD_SHREDCAP_SLOT_PAYLOAD_MAX ), FD_SHREDCAP_ALIGN );
+    zbuf    = fd_valloc_malloc( valloc, BUF_ALIGN, zbuf_sz );
+  }
+# endif
+  if ( FD_UNLIKELY( !payload || ( zbuf_sz && !zbuf ) ) ) {
+    FD_LOG_ERR(( "unable to allocate slot buffers" ));
+  }
+
+  /* Slot index of the current file */
+  ulong                          idx_max = 1024UL;
+  fd_shredcap_slot_idx_entry_t * idx     = fd_valloc_malloc( valloc, BUF_ALIGN, idx_max * sizeof(fd_shredcap_slot_idx_entry_t) );
+  if ( FD_UNLIKELY( !idx ) ) {
+    FD_LOG_ERR(( "unable to allocate slot index" ));
+  }
+
   ulong sz;
   long file_start_offset;
 
@@ -152,6 +249,7 @@ fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
     file_hdr.start_slot = metadata.slot;
     file_hdr.end_slot   = ULONG_MAX; /* This is updated after file is populated */
     file_hdr.num_blocks = ULONG_MAX; /* This is updated after file is populated */
+    file_hdr.idx_off    = ULONG_MAX; /* This is updated after file is populated */
     err = fd_io_buffered_ostream_write( ostream, &file_hdr, FD_SHREDCAP_FILE_HDR_FOOTPRINT );
     if ( FD_UNLIKELY( err ) ) {
       FD_LOG_ERR(( "error writing capture file header" ));
@@ -167,11 +265,33 @@ fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
       ulong cur_slot = metadata.slot;
       /* Import shreds for entire slot */
 
-      int err = fd_rocksdb_import_block_shredcap( &rocks_db, &metadata, ostream, bank_hash_ostream );
+      ulong payload_sz;
+      int err = fd_rocksdb_import_block_shredcap( &rocks_db, &metadata, payload, &payload_sz, bank_hash_ostream );
       if( FD_UNLIKELY( err ) ) {
         FD_LOG_ERR(( "fd_rocksdb_get_block failed at slot=%lu", cur_slot ));
       }
 
+      /* Index the slot at its offset in the file (including the part of
+         the stream that is still buffered) */
+      long slot_off = lseek( ostream->fd, 0, SEEK_CUR );
+      if ( FD_UNLIKELY( slot_off == -1 ) ) {
+        FD_LOG_ERR(( "lseek error while seeking to current location" ));
+      }
+      if ( FD_UNLIKELY( file_block_count == idx_max ) ) {
+        fd_shredcap_slot_idx_entry_t * new_idx = fd_valloc_malloc( valloc, BUF_ALIGN, 2UL * idx_max * sizeof(fd_shredcap_slot_idx_entry_t) );
+        if ( FD_UNLIKELY( !new_idx ) ) {
+          FD_LOG_ERR(( "unable to grow slot index" ));
+        }
+        fd_memcpy( new_idx, idx, idx_max * sizeof(fd_shredcap_slot_idx_entry_t) );
+        fd_valloc_free( valloc, idx );
+        idx      = new_idx;
+        idx_max *= 2UL;
+      }
+      idx[ file_block_count ].slot = cur_slot;
+      idx[ file_block_count ].off  = (ulong)slot_off + ostream->wbuf_used;
+
+      fd_shredcap_write_slot( ostream, &metadata, payload, payload_sz, zbuf, zbuf_sz, zstd_level );
+
       file_end_slot = metadata.slot;
       ++file_block_count;
 
@@ -190,6 +310,17 @@ fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
     }
     block_count += file_block_count;
 
+    /* Write out the slot index */
+    long idx_off = lseek( ostream->fd, 0, SEEK_CUR );
+    if ( FD_UNLIKELY( idx_off == -1 ) ) {
+      FD_LOG_ERR(( "lseek error while seeking to current location" ));
+    }
+    file_hdr.idx_off = (ulong)idx_off + ostream->wbuf_used;
+    err = fd_io_buffered_ostream_write( ostream, idx, file_block_count * FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT );
+    if ( FD_UNLIKELY( err ) ) {
+      FD_LOG_ERR(( "error writing slot index" ));
+    }
+
     /* To finish out writing to capture file, copy the header into the footer,
        flush the buffer. The header needs to be updated to include the payload
        size. Clear any fd_io and close the fd. Rename the file. */
@@ -298,97 +429,285 @@ fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
     FD_LOG_ERR(( "unable to close the bank_hash file" ));
   }
 
+  fd_valloc_free( valloc, idx );
+  if ( zbuf ) fd_valloc_free( valloc, zbuf );
+  fd_valloc_free( valloc, payload );
+
   fd_rocksdb_root_iter_destroy( &iter );
   fd_rocksdb_destroy( &rocks_db );
 }
 
-/***************** Verify Helpers *********************************************/
-void
-fd_shredcap_verify_slot( fd_shredcap_slot_hdr_t * slot_hdr,
-                           fd_blockstore_t *          blockstore,
-                           int                        fd,
-                           char *                     rbuf ) {
+/***************** Reader *****************************************************/
+fd_shredcap_file_t *
+fd_shredcap_file_open( fd_shredcap_file_t * file, const char * path ) {
+  fd_memset( file, 0, sizeof(fd_shredcap_file_t) );
 
+  file->fd = open( path, O_RDONLY, (mode_t)0 );
+  if( FD_UNLIKELY( file->fd == -1 ) ) {
+    FD_LOG_WARNING(( "open(\"%s\",O_RDONLY,0) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    FD_LOG_ERR(( "can't read capture file, may not exist" ));
+  }
 
-  if ( FD_UNLIKELY( slot_hdr->magic != FD_SHREDCAP_SLOT_HDR_MAGIC ) ) {
-    FD_LOG_ERR(( "slot header magic=%lu doesn't match expected magic=%lu",
-                  slot_hdr->magic, FD_SHREDCAP_SLOT_HDR_MAGIC ));
+  struct stat st;
+  if ( FD_UNLIKELY( fstat( file->fd, &st ) ) ) {
+    FD_LOG_ERR(( "fstat(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
   }
-  if ( FD_UNLIKELY( slot_hdr->version != FD_SHREDCAP_SLOT_HDR_VERSION ) ) {
-    FD_LOG_ERR(( "slot header version=%u doesn't match expected version=%lu",
-                  slot_hdr->version, FD_SHREDCAP_SLOT_HDR_VERSION ));
+  ulong map_sz = (ulong)st.st_size;
+  if ( FD_UNLIKELY( map_sz < FD_SHREDCAP_FILE_HDR_FOOTPRINT + FD_SHREDCAP_FILE_FTR_FOOTPRINT ) ) {
+    FD_LOG_ERR(( "capture file=%s size=%lu is too small", path, map_sz ));
   }
-  if ( FD_UNLIKELY( slot_hdr->payload_sz == ULONG_MAX ) ) {
-    FD_LOG_ERR(( "slot payload_sz=%lu is at default value", slot_hdr->payload_sz ));
+
+  void * map = mmap( NULL, map_sz, PROT_READ, MAP_SHARED, file->fd, 0 );
+  if ( FD_UNLIKELY( map == MAP_FAILED ) ) {
+    FD_LOG_ERR(( "mmap(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
   }
+  file->map    = (uchar const *)map;
+  file->map_sz = map_sz;
 
-  ulong slot       = slot_hdr->slot;
-  ulong max_idx    = slot_hdr->received;
-  ulong payload_sz = slot_hdr->payload_sz;
+  /* Verifying file header and footer */
+  fd_memcpy( &file->hdr, file->map, FD_SHREDCAP_FILE_HDR_FOOTPRINT );
+  fd_shredcap_file_hdr_t const * file_hdr = &file->hdr;
+  fd_shredcap_file_ftr_t const * file_ftr =
+      (fd_shredcap_file_ftr_t const *)( file->map + map_sz - FD_SHREDCAP_FILE_FTR_FOOTPRINT );
 
-  int err;
-  ulong sz;
-  for ( ulong idx = 0; idx < max_idx; ++idx ) {
-    /* Read shred header */
-    err = fd_io_read( fd, rbuf, FD_SHREDCAP_SHRED_HDR_FOOTPRINT,
-                      FD_SHREDCAP_SHRED_HDR_FOOTPRINT, &sz );
-    if ( FD_UNLIKELY( err != 0 ) ) {
-      FD_LOG_ERR(( "unable to read shred hdr" ));
-    }
-    if ( FD_UNLIKELY( sz != FD_SHREDCAP_SHRED_HDR_FOOTPRINT ) ) {
-      FD_LOG_ERR(( "read in size=%lu not equal to shred header footprint=%u",
-                   sz, FD_SHREDCAP_SHRED_HDR_FOOTPRINT ));
-    }
+  if ( FD_UNLIKELY( file_hdr->magic != FD_SHREDCAP_FILE_MAGIC ) ) {
+    FD_LOG_ERR(( "file header magic=%lu doesn't match expected magic=%lu",
+                 file_hdr->magic, FD_SHREDCAP_FILE_MAGIC ));
+  }
+  if ( FD_UNLIKELY( file_hdr->version < 1U || file_hdr->version > FD_SHREDCAP_FILE_VERSION ) ) {
+    FD_LOG_ERR(( "file header version=%u is not supported (max version=%lu)",
+                 file_hdr->version, FD_SHREDCAP_FILE_VERSION ));
+  }
+  if ( FD_UNLIKELY( file_hdr->magic != file_ftr->magic ) ) {
+    FD_LOG_ERR(( "file header magic=%lu doesn't match file footer magic=%lu",
+                 file_hdr->magic, file_ftr->magic ));
+  }
+  if ( FD_UNLIKELY( file_hdr->version != file_ftr->version ) ) {
+    FD_LOG_ERR(( "file header version=%u doesn't match file footer version=%u",
+                 file_hdr->version, file_ftr->version ));
+  }
+  if ( FD_UNLIKELY( file_hdr->start_slot != file_ftr->start_slot ) ) {
+    FD_LOG_ERR(( "file header start_slot=%lu doesn't match file footer start_slot=%lu",
+                 file_hdr->start_slot, file_ftr->start_slot ));
+  }
+  if ( FD_UNLIKELY( file_hdr->end_slot != file_ftr->end_slot ) ) {
+    FD_LOG_ERR(( "file header end_slot=%lu doesn't match file footer end_slot=%lu",
+                 file_hdr->end_slot, file_ftr->end_slot ));
+  }
+  if ( FD_UNLIKELY( file_hdr->num_blocks != file_ftr->num_blocks ) ) {
+    FD_LOG_ERR(( "file header num_blocks=%lu doesn't match file footer num_blocks=%lu",
+                 file_hdr->num_blocks, file_ftr->num_blocks ));
+  }
 
-    fd_shredcap_shred_hdr_t * shred_hdr = (fd_shredcap_shred_hdr_t*)rbuf;
+  ulong num_blocks = file_hdr->num_blocks;
+  if ( FD_UNLIKELY( num_blocks > map_sz / FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT ) ) {
+    FD_LOG_ERR(( "file header num_blocks=%lu is too large for capture file=%s", num_blocks, path ));
+  }
 
-    /* Read shred body and verify slot number */
-    ulong shred_boundary_sz = shred_hdr->shred_boundary_sz;
-    err = fd_io_read( fd, rbuf, shred_boundary_sz, shred_boundary_sz, &sz );
-    if ( FD_UNLIKELY( err != 0 ) ) {
-      FD_LOG_ERR(( "unable to read shred" ));
+  if ( file_hdr->version >= 2U ) {
+    /* The slot index sits right before the footer */
+    if ( FD_UNLIKELY( file_hdr->idx_off != file_ftr->idx_off ) ) {
+      FD_LOG_ERR(( "file header idx_off=%lu doesn't match file footer idx_off=%lu",
+                   file_hdr->idx_off, file_ftr->idx_off ));
+    }
+    if ( FD_UNLIKELY( file_hdr->idx_off < FD_SHREDCAP_FILE_HDR_FOOTPRINT ||
+                      file_hdr->idx_off + num_blocks * FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT +
+                      FD_SHREDCAP_FILE_FTR_FOOTPRINT != map_sz ) ) {
+      FD_LOG_ERR(( "file header idx_off=%lu is inconsistent with num_blocks=%lu and file size=%lu",
+                   file_hdr->idx_off, num_blocks, map_sz ));
     }
-    if ( FD_UNLIKELY( sz != shred_boundary_sz ) ) {
-      FD_LOG_ERR(( "read in size=%lu not equal to shred footprint=%lu", sz, shred_boundary_sz ));
+    file->idx = (fd_shredcap_slot_idx_entry_t const *)( file->map + file_hdr->idx_off );
+  } else {
+    /* Version 1 files have no index, walk the slot headers to build one */
+    file->idx_mem = fd_valloc_malloc( fd_libc_alloc_virtual(), BUF_ALIGN,
+                                      fd_ulong_max( num_blocks, 1UL ) * sizeof(fd_shredcap_slot_idx_entry_t) );
+    if ( FD_UNLIKELY( !file->idx_mem ) ) {
+      FD_LOG_ERR(( "unable to allocate slot index for capture file=%s", path ));
     }
+    ulong off = FD_SHREDCAP_FILE_HDR_FOOTPRINT;
+    ulong end = map_sz - FD_SHREDCAP_FILE_FTR_FOOTPRINT;
+    for ( ulong i = 0; i < num_blocks; ++i ) {
+      if ( FD_UNLIKELY( end - off < FD_SHREDCAP_SLOT_HDR_FOOTPRINT + FD_SHREDCAP_SLOT_FTR_FOOTPRINT ) ) {
+        FD_LOG_ERR(( "capture file=%s is truncated at slot index=%lu", path, i ));
+      }
+      fd_shredcap_slot_hdr_t const * slot_hdr = (fd_shredcap_slot_hdr_t const *)( file->map + off );
+      if ( FD_UNLIKELY( slot_hdr->magic != FD_SHREDCAP_SLOT_HDR_MAGIC ) ) {
+        FD_LOG_ERR(( "slot header magic=%lu doesn't match expected magic=%lu",
+                     slot_hdr->magic, FD_SHREDCAP_SLOT_HDR_MAGIC ));
+      }
+      if ( FD_UNLIKELY( slot_hdr->payload_sz > end - off - FD_SHREDCAP_SLOT_HDR_FOOTPRINT - FD_SHREDCAP_SLOT_FTR_FOOTPRINT ) ) {
+        FD_LOG_ERR(( "slot payload_sz=%lu runs past the end of capture file=%s", slot_hdr->payload_sz, path ));
+      }
+      file->idx_mem[ i ].slot = slot_hdr->slot;
+      file->idx_mem[ i ].off  = off;
+      off += FD_SHREDCAP_SLOT_HDR_FOOTPRINT + slot_hdr->payload_sz + FD_SHREDCAP_SLOT_FTR_FOOTPRINT;
+    }
+    if ( FD_UNLIKELY( off != end ) ) {
+      FD_LOG_ERR(( "capture file=%s has %lu unexpected bytes after the last slot", path, end - off ));
+    }
+    file->idx = file->idx_mem;
+  }
+  file->idx_cnt = num_blocks;
 
-    fd_shred_t * shred = (fd_shred_t*)rbuf;
-    if ( FD_UNLIKELY( blockstore != NULL ) ) {
-      fd_buf_shred_insert( blockstore, shred );
+  /* Slots are stored in increasing order */
+  for ( ulong i = 1; i < num_blocks; ++i ) {
+    if ( FD_UNLIKELY( file->idx[ i ].slot <= file->idx[ i - 1 ].slot ) ) {
+      FD_LOG_ERR(( "slot index of capture file=%s is not sorted at index=%lu", path, i ));
     }
-    if ( FD_UNLIKELY( slot != shred->slot ) ) {
-      FD_LOG_ERR(( "slot header's slot=%lu doesn't match shred's slot=%lu", slot, shred->slot ));
+  }
+
+  return file;
+}
+
+void
+fd_shredcap_file_close( fd_shredcap_file_t * file ) {
+  if ( FD_UNLIKELY( munmap( (void *)file->map, file->map_sz ) ) ) {
+    FD_LOG_WARNING(( "munmap failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  }
+  if ( FD_UNLIKELY( close( file->fd ) ) ) {
+    FD_LOG_ERR(( "unable to close capture file" ));
+  }
+  if ( file->idx_mem ) fd_valloc_free( fd_libc_alloc_virtual(), file->idx_mem );
+  if ( file->zbuf    ) fd_valloc_free( fd_libc_alloc_virtual(), file->zbuf    );
+  fd_memset( file, 0, sizeof(fd_shredcap_file_t) );
+  file->fd = -1;
+}
+
+ulong
+fd_shredcap_file_seek( fd_shredcap_file_t const * file, ulong slot ) {
+  /* Binary search through the slot index */
+  ulong left  = 0;
+  ulong right = file->idx_cnt;
+  while ( left < right ) {
+    ulong middle = ( left + right ) / 2;
+    if ( file->idx[ middle ].slot >= slot ) {
+      right = middle;
+    }
+    else {
+      left = middle + 1;
     }
   }
+  return left;
+}
 
-  /* Ensure that a block exists for the given slot */
-  fd_block_t * block = fd_blockstore_block_query( blockstore, slot );
-  if ( FD_UNLIKELY( block == NULL) ) {
-    FD_LOG_ERR(( "block doesn't exist for slot=%lu", slot ));
+fd_shredcap_slot_hdr_t const *
+fd_shredcap_file_insert( fd_shredcap_file_t * file,
+                         ulong                idx,
+                         fd_blockstore_t *    blockstore ) {
+  fd_shredcap_slot_idx_entry_t const * entry = file->idx + idx;
+
+  /* Slots end where the index (or the footer of a version 1 file) starts */
+  ulong end = file->hdr.version >= 2U ? file->hdr.idx_off : file->map_sz - FD_SHREDCAP_FILE_FTR_FOOTPRINT;
+  ulong off = entry->off;
+  if ( FD_UNLIKELY( off < FD_SHREDCAP_FILE_HDR_FOOTPRINT || off > end ||
+                    end - off < FD_SHREDCAP_SLOT_HDR_FOOTPRINT + FD_SHREDCAP_SLOT_FTR_FOOTPRINT ) ) {
+    FD_LOG_ERR(( "slot index entry for slot=%lu has invalid offset=%lu", entry->slot, off ));
   }
 
-  /* Validate slot footer */
-  err = fd_io_read( fd, rbuf, 0, FD_SHREDCAP_SLOT_FTR_FOOTPRINT, &sz );
-  if ( FD_UNLIKELY( err != 0 ) ) {
-    FD_LOG_ERR(( "unable to read slot footer" ));
+  fd_shredcap_slot_hdr_t const * slot_hdr = (fd_shredcap_slot_hdr_t const *)( file->map + off );
+  if ( FD_UNLIKELY( slot_hdr->magic != FD_SHREDCAP_SLOT_HDR_MAGIC ) ) {
+    FD_LOG_ERR(( "slot header magic=%lu doesn't match expected magic=%lu",
+                  slot_hdr->magic, FD_SHREDCAP_SLOT_HDR_MAGIC ));
+  }
+  if ( FD_UNLIKELY( slot_hdr->version < 1U || slot_hdr->version > FD_SHREDCAP_SLOT_HDR_VERSION ) ) {
+    FD_LOG_ERR(( "slot header version=%u is not supported (max version=%lu)",
+                  slot_hdr->version, FD_SHREDCAP_SLOT_HDR_VERSION ));
+  }
+  if ( FD_UNLIKELY( slot_hdr->payload_sz == ULONG_MAX ) ) {
+    FD_LOG_ERR(( "slot payload_sz=%lu is at default value", slot_hdr->payload_sz ));
   }
-  if ( FD_UNLIKELY( sz != FD_SHREDCAP_SLOT_FTR_FOOTPRINT ) ) {
-    FD_LOG_ERR(( "read in size=%lu not equal to slot footer footprint=%lu",
-                  sz, FD_SHREDCAP_SLOT_FTR_FOOTPRINT ));
+  if ( FD_UNLIKELY( slot_hdr->slot != entry->slot ) ) {
+    FD_LOG_ERR(( "slot header's slot=%lu doesn't match slot index's slot=%lu", slot_hdr->slot, entry->slot ));
   }
 
-  fd_shredcap_slot_ftr_t * slot_ftr = (fd_shredcap_slot_ftr_t*)rbuf;
+  ulong slot       = slot_hdr->slot;
+  ulong payload_sz = slot_hdr->payload_sz;
+  if ( FD_UNLIKELY( payload_sz > end - off - FD_SHREDCAP_SLOT_HDR_FOOTPRINT - FD_SHREDCAP_SLOT_FTR_FOOTPRINT ) ) {
+    FD_LOG_ERR(( "slot=%lu payload_sz=%lu runs past the end of the slots", slot, payload_sz ));
+  }
+  uchar const * payload = file->map + off + FD_SHREDCAP_SLOT_HDR_FOOTPRINT;
 
+  /* Validate slot footer */
+  fd_shredcap_slot_ftr_t const * slot_ftr = (fd_shredcap_slot_ftr_t const *)( payload + payload_sz );
   if ( FD_UNLIKELY( slot_ftr->magic != FD_SHREDCAP_SLOT_FTR_MAGIC ) ) {
     FD_LOG_ERR(( "slot footer's magic=%lu doesn't match expected magic=%lu",
                  slot_ftr->magic, FD_SHREDCAP_SLOT_FTR_MAGIC ));
   }
   if ( FD_UNLIKELY( slot_ftr->payload_sz != payload_sz ) ) {
     FD_LOG_ERR(( "slot header's payload_sz=%lu doesn't match block footers's payload_sz=%lu",
-                 slot_hdr->payload_sz, slot_ftr->payload_sz ));
+                 payload_sz, slot_ftr->payload_sz ));
+  }
+
+  /* Decompress the payload if needed */
+  ulong raw_payload_sz = payload_sz;
+  uint  codec          = FD_SHREDCAP_CODEC_RAW;
+  if ( slot_hdr->version >= 2U ) {
+    raw_payload_sz = slot_hdr->raw_payload_sz;
+    codec          = slot_hdr->codec;
   }
+  if ( codec == FD_SHREDCAP_CODEC_ZSTD ) {
+#   if FD_HAS_ZSTD
+    if ( FD_UNLIKELY( raw_payload_sz > FD_SHREDCAP_SLOT_PAYLOAD_MAX ) ) {
+      FD_LOG_ERR(( "slot=%lu raw_payload_sz=%lu is too large", slot, raw_payload_sz ));
+    }
+    if ( FD_UNLIKELY( !file->zbuf ) ) {
+      file->zbuf = fd_valloc_malloc( fd_libc_alloc_virtual(), BUF_ALIGN, FD_SHREDCAP_SLOT_PAYLOAD_MAX );
+      if ( FD_UNLIKELY( !file->zbuf ) ) {
+        FD_LOG_ERR(( "unable to allocate decompression buffer" ));
+      }
+    }
+    /* The frame is padded to FD_SHREDCAP_ALIGN */
+    size_t zsz = ZSTD_findFrameCompressedSize( payload, payload_sz );
+    if ( FD_UNLIKELY( ZSTD_isError( zsz ) ) ) {
+      FD_LOG_ERR(( "slot=%lu payload is not a zstd frame (%s)", slot, ZSTD_getErrorName( zsz ) ));
+    }
+    size_t dsz = ZSTD_decompress( file->zbuf, FD_SHREDCAP_SLOT_PAYLOAD_MAX, payload, zsz );
+    if ( FD_UNLIKELY( ZSTD_isError( dsz ) ) ) {
+      FD_LOG_ERR(( "unable to decompress slot=%lu (%s)", slot, ZSTD_getErrorName( dsz ) ));
+    }
+    if ( FD_UNLIKELY( (ulong)dsz != raw_payload_sz ) ) {
+      FD_LOG_ERR(( "slot=%lu decompressed to size=%lu, expected raw_payload_sz=%lu", slot, (ulong)dsz, raw_payload_sz ));
+    }
+    payload = file->zbuf;
+#   else
+    FD_LOG_ERR(( "slot=%lu is zstd compressed and this build does not have zstd support", slot ));
+#   endif
+  } else if ( FD_UNLIKELY( codec != FD_SHREDCAP_CODEC_RAW ) ) {
+    FD_LOG_ERR(( "slot=%lu has unknown codec=%u", slot, codec ));
+  } else if ( FD_UNLIKELY( raw_payload_sz != payload_sz ) ) {
+    FD_LOG_ERR(( "slot=%lu raw_payload_sz=%lu doesn't match payload_sz=%lu", slot, raw_payload_sz, payload_sz ));
+  }
+
+  /* Insert the shreds straight from the payload */
+  ulong shred_off = 0;
+  ulong max_idx   = slot_hdr->received;
+  for ( ulong idx = 0; idx < max_idx; ++idx ) {
+    if ( FD_UNLIKELY( raw_payload_sz - shred_off < FD_SHREDCAP_SHRED_HDR_FOOTPRINT ) ) {
+      FD_LOG_ERR(( "slot=%lu payload is truncated at shred index=%lu", slot, idx ));
+    }
+    fd_shredcap_shred_hdr_t const * shred_hdr = (fd_shredcap_shred_hdr_t const *)( payload + shred_off );
+    ulong shred_boundary_sz = shred_hdr->shred_boundary_sz;
+    if ( FD_UNLIKELY( shred_hdr->hdr_sz != FD_SHREDCAP_SHRED_HDR_FOOTPRINT ||
+                      shred_hdr->shred_sz < fd_ulong_min( FD_SHRED_DATA_HEADER_SZ, FD_SHRED_CODE_HEADER_SZ ) ||
+                      shred_hdr->shred_sz > shred_boundary_sz ||
+                      shred_boundary_sz > raw_payload_sz - shred_off - FD_SHREDCAP_SHRED_HDR_FOOTPRINT ) ) {
+      FD_LOG_ERR(( "slot=%lu has a corrupt shred header at shred index=%lu", slot, idx ));
+    }
+
+    fd_shred_t const * shred = (fd_shred_t const *)( payload + shred_off + FD_SHREDCAP_SHRED_HDR_FOOTPRINT );
+    if ( FD_UNLIKELY( slot != shred->slot ) ) {
+      FD_LOG_ERR(( "slot header's slot=%lu doesn't match shred's slot=%lu", slot, shred->slot ));
+    }
+    if ( FD_LIKELY( blockstore != NULL ) ) {
+      fd_buf_shred_insert( blockstore, shred );
+    }
+    shred_off += FD_SHREDCAP_SHRED_HDR_FOOTPRINT + shred_boundary_sz;
+  }
+
+  return slot_hdr;
 }
 
+/***************** Verify Helpers *********************************************/
 void
 fd_shredcap_verify_capture_file( const char *      capture_dir,
                                    const char *      capture_file,
@@ -402,65 +721,37 @@ fd_shredcap_verify_capture_file( const char *      capture_dir,
   char capture_file_buf[ FD_SHREDCAP_CAPTURE_PATH_NAME_LENGTH ];
   fd_shredcap_concat( capture_file_buf, capture_dir, capture_file );
 
-  int capture_fd = open( capture_file_buf, O_RDONLY, (mode_t)0 );
-  if( FD_UNLIKELY( capture_fd == -1 ) ) {
-    FD_LOG_WARNING(( "open(\"%s\",O_RDONLY,0) failed (%i-%s)", capture_file_buf, errno, fd_io_strerror( errno ) ));
-    FD_LOG_ERR(( "can't read capture file, may not exist" ));
-  }
-
-  char rbuf[ RBUF_FOOTPRINT ] __attribute__((aligned(BUF_ALIGN)));
+  /* Opening the file verifies the file header, footer and slot index */
+  fd_shredcap_file_t file[1];
+  fd_shredcap_file_open( file, capture_file_buf );
 
-  /* Restore Header */
-  ulong sz;
-  int err = fd_io_read( capture_fd, &rbuf, 0, FD_SHREDCAP_FILE_HDR_FOOTPRINT, &sz );
-  if ( FD_UNLIKELY( err != 0 ) ) {
-    FD_LOG_ERR(( "unable to read file header" ));
-  }
-  if ( FD_UNLIKELY( sz != FD_SHREDCAP_FILE_HDR_FOOTPRINT ) ) {
-    FD_LOG_ERR(( "read in size=%lu not equal to file header footprint=%lu",
-                  sz, FD_SHREDCAP_FILE_HDR_FOOTPRINT ));
-  }
-  fd_shredcap_file_hdr_t * file_hdr_ptr = (fd_shredcap_file_hdr_t*)rbuf;
-
-  /* Verifying file header */
-  if ( FD_UNLIKELY( file_hdr_ptr->magic != FD_SHREDCAP_FILE_MAGIC ) ) {
-    FD_LOG_ERR(( "file header magic=%lu doesn't match expected magic=%lu",
-                 file_hdr_ptr->magic, FD_SHREDCAP_FILE_MAGIC ));
-  }
-  if ( FD_UNLIKELY( file_hdr_ptr->version != FD_SHREDCAP_FILE_VERSION ) ) {
-    FD_LOG_ERR(( "file header version=%u doesn't match expected version=%lu",
-                 file_hdr_ptr->version, FD_SHREDCAP_FILE_VERSION ));
-  }
-  if ( FD_UNLIKELY( file_hdr_ptr->start_slot != expected_start_slot ) ) {
+  if ( FD_UNLIKELY( file->hdr.start_slot != expected_start_slot ) ) {
     FD_LOG_ERR(( "file header start_slot=%lu doesn't match manifest entry's start_slot=%lu",
-                 file_hdr_ptr->start_slot, expected_start_slot ));
+                 file->hdr.start_slot, expected_start_slot ));
   }
-  if ( FD_UNLIKELY( file_hdr_ptr->end_slot != expected_end_slot ) ) {
+  if ( FD_UNLIKELY( file->hdr.end_slot != expected_end_slot ) ) {
     FD_LOG_ERR(( "file header end_slot=%lu doesn't match manifest entry's end_slot=%lu",
-                 file_hdr_ptr->end_slot, expected_end_slot ));
+                 file->hdr.end_slot, expected_end_slot ));
+  }
+  if ( FD_UNLIKELY( !file->idx_cnt || file->idx[ file->idx_cnt - 1 ].slot != expected_end_slot ) ) {
+    FD_LOG_ERR(( "last slot of capture file=%s doesn't match manifest entry's end_slot=%lu",
+                 capture_file, expected_end_slot ));
   }
 
-  fd_shredcap_file_hdr_t file_hdr;
-  fd_memcpy( &file_hdr, file_hdr_ptr, FD_SHREDCAP_FILE_HDR_FOOTPRINT );
-
-  /* Want to create a loop here for the slot_hdr */
-  ulong cur_slot = 0;
-  while( cur_slot < expected_end_slot ) {
+  ulong sz;
+  int err;
+  for ( ulong i = 0; i < file->idx_cnt; ++i ) {
     ++(*slots_seen);
-    err = fd_io_read( capture_fd, rbuf, FD_SHREDCAP_SLOT_HDR_FOOTPRINT,
-                      FD_SHREDCAP_SLOT_HDR_FOOTPRINT, &sz );
-    if ( FD_UNLIKELY( err != 0 ) ) {
-      FD_LOG_ERR(( "unable to read slot header" ));
-    }
-    if ( FD_UNLIKELY( sz != FD_SHREDCAP_SLOT_HDR_FOOTPRINT ) ) {
-      FD_LOG_ERR(( "read in size=%lu not equal to slot header footprint=%lu",
-                    sz, FD_SHREDCAP_SLOT_HDR_FOOTPRINT ));
-    }
 
     /* Verify header contents and assemble blocks from shreds */
-    fd_shredcap_slot_hdr_t * slot_hdr = (fd_shredcap_slot_hdr_t*)rbuf;
-    cur_slot = slot_hdr->slot;
-    fd_shredcap_verify_slot( slot_hdr, blockstore, capture_fd, rbuf );
+    fd_shredcap_slot_hdr_t const * slot_hdr = fd_shredcap_file_insert( file, i, blockstore );
+    ulong cur_slot = slot_hdr->slot;
+
+    /* Ensure that a block exists for the given slot */
+    fd_block_t * block = fd_blockstore_block_query( blockstore, cur_slot );
+    if ( FD_UNLIKELY( block == NULL) ) {
+      FD_LOG_ERR(( "block doesn't exist for slot=%lu", cur_slot ));
+    }
 
     err = fd_io_read( bank_hash_fd, bank_hash_buf, FD_SHREDCAP_BANK_HASH_ENTRY_FOOTPRINT,
                       FD_SHREDCAP_BANK_HASH_ENTRY_FOOTPRINT, &sz );
@@ -479,47 +770,12 @@ fd_shredcap_verify_capture_file( const char *      capture_dir,
   }
 
   /* Verify num blocks */
-  if ( FD_UNLIKELY( file_hdr.num_blocks != *slots_seen ) ) {
+  if ( FD_UNLIKELY( file->hdr.num_blocks != *slots_seen ) ) {
     FD_LOG_ERR(( "file header num_blocks=%lu not equal to number of seen slots=%lu",
-                 file_hdr.num_blocks, *slots_seen ));
-  }
-
-  /* Verify file footer */
-  err = fd_io_read( capture_fd, &rbuf, 0, FD_SHREDCAP_FILE_FTR_FOOTPRINT, &sz );
-  if ( FD_UNLIKELY( err != 0 ) ) {
-    FD_LOG_ERR(( "unable to read file footer" ));
-  }
-  if ( FD_UNLIKELY( sz != FD_SHREDCAP_FILE_FTR_FOOTPRINT ) ) {
-    FD_LOG_ERR(( "read in size=%lu not equal to file footer footprint=%lu",
-                  sz, FD_SHREDCAP_FILE_FTR_FOOTPRINT ));
+                 file->hdr.num_blocks, *slots_seen ));
   }
 
-  fd_shredcap_file_ftr_t * file_ftr = (fd_shredcap_file_ftr_t*)rbuf;
-
-  if ( FD_UNLIKELY( file_hdr.magic != file_ftr->magic ) ) {
-    FD_LOG_ERR(( "file header magic=%lu doesn't match file footer magic=%lu",
-                 file_hdr.magic, file_ftr->magic ));
-  }
-  if ( FD_UNLIKELY( file_hdr.version != file_ftr->version ) ) {
-    FD_LOG_ERR(( "file header version=%u doesn't match file footer version=%u",
-                 file_hdr.version, file_ftr->version ));
-  }
-  if ( FD_UNLIKELY( file_hdr.start_slot != file_ftr->start_slot ) ) {
-    FD_LOG_ERR(( "file header start_slot=%lu doesn't match file footer start_slot=%lu",
-                 file_hdr.start_slot, file_ftr->start_slot ));
-  }
-  if ( FD_UNLIKELY( file_hdr.end_slot != file_ftr->end_slot ) ) {
-    FD_LOG_ERR(( "file header end_slot=%lu doesn't match file footer end_slot=%lu",
-                 file_hdr.end_slot, file_ftr->end_slot ));
-  }
-  if ( FD_UNLIKELY( file_hdr.num_blocks != file_ftr->num_blocks ) ) {
-    FD_LOG_ERR(( "file header num_blocks=%lu doesn't match file footer num_blocks=%lu",
-                 file_hdr.num_blocks, file_ftr->num_blocks ));
-  }
-
-  if ( FD_UNLIKELY( close( capture_fd ) ) ) {
-    FD_LOG_ERR(( "unable to close capture file=%s", capture_file ));
-  }
+  fd_shredcap_file_close( file );
 }
 
 void
@@ -654,9 +910,9 @@ fd_shredcap_verify( const char * capture_dir, fd_blockstore_t * blockstore ) {
     FD_LOG_ERR(( "manifest footer magic=%lu doesn't match expected value=%lu",
                  manifest_ftr->magic, FD_SHREDCAP_MANIFEST_MAGIC ));
   }
-  if ( FD_UNLIKELY( manifest_ftr->version != FD_SHREDCAP_SLOT_HDR_VERSION ) ) {
+  if ( FD_UNLIKELY( manifest_ftr->version != FD_SHREDCAP_MANIFEST_VERSION ) ) {
     FD_LOG_ERR(( "manifest footer version=%lu doesn't match expected version=%lu",
-                 manifest_ftr->magic, FD_SHREDCAP_SLOT_HDR_VERSION ));
+                 manifest_ftr->magic, FD_SHREDCAP_MANIFEST_VERSION ));
   }
   if ( FD_UNLIKELY( start_slot != manifest_ftr->start_slot ) ) {
     FD_LOG_ERR(( "manifest footer start_slot=%lu doesn't match manifest footer start_slot=%lu",
@@ -942,8 +1198,6 @@ fd_shredcap_populate_blockstore( const char *      capture_dir,
                                     &first_slot_idx, &bank_hash_fd );
   ulong cur_bank_hash_slot_idx = first_slot_idx;
 
-  char capture_buf[ RBUF_FOOTPRINT ];
-
   ulong sz;
   int err;
   long offset;
@@ -973,85 +1227,19 @@ fd_shredcap_populate_blockstore( const char *      capture_dir,
     fd_cstr_append_text( file_path_buf, capture_dir, strlen( capture_dir ) );
     fd_cstr_append_cstr( file_path_buf + strlen( capture_dir ), entry->path );
 
-    int capture_fd = open( file_path_buf, O_RDONLY, (mode_t)0 );
-    if( FD_UNLIKELY( capture_fd == -1 ) ) {
-      FD_LOG_WARNING(( "open(\"%s\",O_RDONLY,0) failed (%i-%s)",
-                       file_path_buf, errno, fd_io_strerror( errno ) ));
-      FD_LOG_ERR(( "unable to open capture file for blockstore range" ));
-    }
-
-    err = fd_io_read( capture_fd, capture_buf, FD_SHREDCAP_FILE_HDR_FOOTPRINT,
-                      FD_SHREDCAP_FILE_HDR_FOOTPRINT, &sz );
-    if ( FD_UNLIKELY( err ) ) {
-      FD_LOG_ERR(( "error when reading shredcap file header" ));
-    }
-    if ( FD_UNLIKELY( sz != FD_SHREDCAP_FILE_HDR_FOOTPRINT ) ) {
-      FD_LOG_ERR(( "unexpected size read=%lu for capture file header", sz ));
-    }
-    fd_shredcap_file_hdr_t * file_hdr = (fd_shredcap_file_hdr_t*)capture_buf;
-    FD_TEST((file_hdr->magic == FD_SHREDCAP_FILE_MAGIC));
-
-    ulong cur_slot      = file_hdr->start_slot;
-    ulong file_end_slot = file_hdr->end_slot;
-
-    while ( cur_slot < file_end_slot ) {
-      /* Read in block header */
-      err = fd_io_read( capture_fd, capture_buf, FD_SHREDCAP_SLOT_HDR_FOOTPRINT,
-                        FD_SHREDCAP_SLOT_HDR_FOOTPRINT, &sz );
-      if ( FD_UNLIKELY( err ) ) {
-        FD_LOG_ERR(( "error when reading shredcap slot header" ));
-      }
-      if ( FD_UNLIKELY( sz != FD_SHREDCAP_SLOT_HDR_FOOTPRINT ) ) {
-        FD_LOG_ERR(( "unexpected size read=%lu for capture slot header", sz ));
-      }
+    /* Jump straight to the first slot of the range using the slot index */
+    fd_shredcap_file_t file[1];
+    fd_shredcap_file_open( file, file_path_buf );
 
-      fd_shredcap_slot_hdr_t * slot_hdr = (fd_shredcap_slot_hdr_t*)capture_buf;
-      cur_slot = slot_hdr->slot;
-      ulong max_idx = slot_hdr->received;
-      FD_TEST((slot_hdr->magic == FD_SHREDCAP_SLOT_HDR_MAGIC));
+    ulong cur_slot = 0;
+    for ( ulong slot_idx = fd_shredcap_file_seek( file, start_slot ); slot_idx < file->idx_cnt; ++slot_idx ) {
+      cur_slot = file->idx[ slot_idx ].slot;
       if ( cur_slot > end_slot ) {
         break;
       }
 
-      if ( cur_slot < start_slot ) {
-        /* Skip forward to next slot*/
-        offset = lseek( capture_fd, (long)(slot_hdr->payload_sz + FD_SHREDCAP_SLOT_FTR_FOOTPRINT), SEEK_CUR );
-        if ( FD_UNLIKELY( offset == -1 ) ) {
-          FD_LOG_ERR(( "unable to lseek to next slot entry from slot=%lu", cur_slot ));
-        }
-        continue;
-      }
-
-      /* Read in shreds and assemble */
-      for ( ulong shred_idx = 0; shred_idx < max_idx; ++shred_idx ) {
-        err = fd_io_read( capture_fd, capture_buf, FD_SHREDCAP_SHRED_HDR_FOOTPRINT,
-                          FD_SHREDCAP_SHRED_HDR_FOOTPRINT, &sz );
-        if ( FD_UNLIKELY( err ) ) {
-          FD_LOG_ERR(( "error when reading shredcap shred header" ));
-        }
-        if ( FD_UNLIKELY( sz != FD_SHREDCAP_SHRED_HDR_FOOTPRINT ) ) {
-          FD_LOG_ERR(( "unexpected size read=%lu for shred header", sz ));
-        }
-
-        fd_shredcap_shred_hdr_t * shred_hdr = (fd_shredcap_shred_hdr_t*)capture_buf;
-        ulong shred_boundary_sz = shred_hdr->shred_boundary_sz;
-        FD_TEST((shred_hdr->hdr_sz == FD_SHREDCAP_SHRED_HDR_FOOTPRINT));
-        err = fd_io_read( capture_fd, capture_buf, shred_boundary_sz, shred_boundary_sz, &sz );
-        if ( FD_UNLIKELY( err ) ) {
-          FD_LOG_ERR(( "error when reading shredcap shred for slot=%lu", cur_slot ));
-        }
-        if ( FD_UNLIKELY( sz != shred_boundary_sz ) ) {
-          FD_LOG_ERR(( "unexpected size read=%lu for shred", sz ));
-        }
-
-        fd_shred_t * shred = (fd_shred_t*)capture_buf;
-        fd_buf_shred_insert( blockstore, shred );
-      }
-
-      offset = lseek( capture_fd, (long)FD_SHREDCAP_SLOT_FTR_FOOTPRINT, SEEK_CUR );
-      if ( FD_UNLIKELY( offset == -1 ) ) {
-        FD_LOG_ERR(( "unable to lseek past slot footer for slot=%lu", cur_slot ));
-      }
+      /* Insert shreds and assemble */
+      fd_shredcap_file_insert( file, slot_idx, blockstore );
 
       /* Populate bank hash for each slot */
       ulong cur_bank_hash_slot_offset = cur_bank_hash_slot_idx * FD_SHREDCAP_BANK_HASH_ENTRY_FOOTPRINT +
@@ -1079,9 +1267,7 @@ fd_shredcap_populate_blockstore( const char *      capture_dir,
       ++cur_bank_hash_slot_idx;
     }
 
-    if ( FD_UNLIKELY( close( capture_fd ) ) ) {
-      FD_LOG_ERR(( "unable to close the capture file=%s", file_path_buf ));
-    }
+    fd_shredcap_file_close( file );
     if ( cur_slot > end_slot ) {
       break;
     }
@@ -69,10 +69,25 @@
    |---------------------------------|
    |///// More Slots ////////////////|
    |---------------------------------|
+   |**** Slot Index *****************|
+   | Slot + Slot Header Offset       |
+   |*********************************|
+   |////// Each Slot In File ////////|
+   |---------------------------------|
    |**** File Footer ****************|
    | Copy of File Header             |
    |---------------------------------|
 
+   The slot index (version 2 files) lets a reader jump straight to the
+   first slot of a range instead of walking every slot header before
+   it.  The file header holds the offset of the index.  Version 1 files
+   have no index, readers rebuild it by walking the slot headers.
+
+   In version 2 slot headers, the slot payload can be compressed as a
+   single zstd frame (padded to FD_SHREDCAP_ALIGN).  payload_sz is then
+   the size of the payload in the file and raw_payload_sz the size of
+   the decompressed shreds.
+
    Shredcap also supports other column families available in rocksdb. Notably,
    the bank hashes are used during replay. This can be easily extended to
    support other column families. The general format is as follows:
@@ -125,7 +140,7 @@ typedef struct fd_shredcap_manifest_entry_V1 fd_shredcap_manifest_entry_t;
 
 /****************************** File Header/Footer ****************************/
 #define FD_SHREDCAP_FILE_MAGIC   (0x1738173817381738UL)
-#define FD_SHREDCAP_FILE_VERSION (1UL)
+#define FD_SHREDCAP_FILE_VERSION (2UL)
 
 #define FD_SHREDCAP_FILE_CAP_FOOTPRINT_V1 (48UL)
 #define FD_SHREDCAP_FILE_HDR_FOOTPRINT    (FD_SHREDCAP_FILE_CAP_FOOTPRINT_V1)
@@ -136,13 +151,18 @@ struct __attribute__((packed,aligned(FD_SHREDCAP_ALIGN))) fd_shredcap_file_cap_V
   ulong start_slot;
   ulong end_slot;
   ulong num_blocks;
+  ulong idx_off; /* Offset of the slot index (version>=2 only) */
 };
 typedef struct fd_shredcap_file_cap_V1 fd_shredcap_file_hdr_t;
 typedef struct fd_shredcap_file_cap_V1 fd_shredcap_file_ftr_t;
 
 /***************************** Slot Header/Footer *****************************/
 #define FD_SHREDCAP_SLOT_HDR_MAGIC   (0x8108108108108108UL)
-#define FD_SHREDCAP_SLOT_HDR_VERSION (1UL)
+#define FD_SHREDCAP_SLOT_HDR_VERSION (2UL)
+
+/* Slot payload codecs (version>=2 only) */
+#define FD_SHREDCAP_CODEC_RAW  (0U)
+#define FD_SHREDCAP_CODEC_ZSTD (1U)
 
 #define FD_SHREDCAP_SLOT_HDR_FOOTPRINT_V1 (80UL)
 #define FD_SHREDCAP_SLOT_HDR_FOOTPRINT    (FD_SHREDCAP_SLOT_HDR_FOOTPRINT_V1)
@@ -159,6 +179,8 @@ struct __attribute__((packed,aligned(FD_SHREDCAP_ALIGN))) fd_shredcap_slot_hdr_V
   ulong first_shred_timestamp;
   ulong last_index;
   ulong parent_slot;
+  ulong raw_payload_sz; /* version>=2 only */
+  uint  codec;          /* version>=2 only */
 };
 typedef struct fd_shredcap_slot_hdr_V1 fd_shredcap_slot_hdr_t;
 
@@ -172,6 +194,15 @@ struct __attribute((packed,aligned(FD_SHREDCAP_ALIGN))) fd_shredcap_slot_ftr_V1
 };
 typedef struct fd_shredcap_slot_ftr_V1 fd_shredcap_slot_ftr_t;
 
+/***************************** Slot Index *************************************/
+#define FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT_V2 (16UL)
+#define FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT    (FD_SHREDCAP_SLOT_IDX_ENTRY_FOOTPRINT_V2)
+struct __attribute__((packed,aligned(FD_SHREDCAP_ALIGN))) fd_shredcap_slot_idx_entry_V2 {
+  ulong slot;
+  ulong off; /* File offset of the slot header */
+};
+typedef struct fd_shredcap_slot_idx_entry_V2 fd_shredcap_slot_idx_entry_t;
+
 /***************************** Shreds *****************************************/
 /* 1228 is the max shred sz and the footprint for the shred header is 8. For the 
    total shred to have an alignment of FD_SHREDCAP_ALIGN the max footprint must
@@ -222,18 +253,58 @@ typedef struct fd_shredcap_bank_hash_entry_V1 fd_shredcap_bank_hash_entry_t;
    where there there are the max number of shreds per block in addition to each 
    shred being as large as possible. The block header and footer also need to be
    added to this footprint. */
-#define FD_SHREDCAP_MAX_BLOCK_STORAGE_FOOTPRINT (((1 << 15UL) * FD_SHREDCAP_SHRED_MAX) + \
+#define FD_SHREDCAP_SLOT_SHRED_MAX   (1UL << 15)
+#define FD_SHREDCAP_SLOT_PAYLOAD_MAX (FD_SHREDCAP_SLOT_SHRED_MAX * FD_SHREDCAP_SHRED_MAX)
+#define FD_SHREDCAP_MAX_BLOCK_STORAGE_FOOTPRINT (FD_SHREDCAP_SLOT_PAYLOAD_MAX + \
                                                    FD_SHREDCAP_SLOT_HDR_FOOTPRINT + \
                                                    FD_SHREDCAP_SLOT_FTR_FOOTPRINT)
 
 /* Take in rocksdb path and output shredcap capture to specified capture_dir.
    The resulting directory will include a manifest, bank_hash file, and the 
-   set of capture files  */
+   set of capture files. If zstd_level is non-zero, slot payloads are
+   compressed with the given zstd level (requires FD_HAS_ZSTD). */
 void fd_shredcap_ingest_rocksdb_to_capture( const char * rocksdb_dir,
                                               const char * capture_dir,
                                               ulong        max_file_sz,
                                               ulong        start_slot,
-                                              ulong        end_slot );
+                                              ulong        end_slot,
+                                              int          zstd_level );
+
+/* fd_shredcap_file_t is a read-only view of a memory mapped capture
+   file.  idx[i] is the slot index entry of the i-th slot of the file,
+   i in [0,idx_cnt). */
+
+struct fd_shredcap_file {
+  int                                  fd;
+  uchar const *                        map;
+  ulong                                map_sz;
+  fd_shredcap_file_hdr_t               hdr;
+  fd_shredcap_slot_idx_entry_t const * idx;
+  ulong                                idx_cnt;
+  fd_shredcap_slot_idx_entry_t *       idx_mem; /* Rebuilt index of a version 1 file */
+  uchar *                              zbuf;    /* Decompression buffer, allocated on first use */
+};
+typedef struct fd_shredcap_file fd_shredcap_file_t;
+
+/* fd_shredcap_file_open maps the capture file at path, checks its
+   header, footer and slot index and returns file.  Logs error and
+   terminates on failure. */
+fd_shredcap_file_t * fd_shredcap_file_open( fd_shredcap_file_t * file, const char * path );
+
+/* fd_shredcap_file_close unmaps file and frees its buffers. */
+void fd_shredcap_file_close( fd_shredcap_file_t * file );
+
+/* fd_shredcap_file_seek returns the index of the first slot of file that
+   is greater than or equal to slot (file->idx_cnt if none). */
+ulong fd_shredcap_file_seek( fd_shredcap_file_t const * file, ulong slot );
+
+/* fd_shredcap_file_insert checks the idx-th slot of file and inserts
+   its shreds directly from the mapping (or the decompression buffer)
+   into blockstore (only checks if blockstore is NULL).  Returns the
+   slot header.  Logs error and terminates if the slot is corrupt. */
+fd_shredcap_slot_hdr_t const * fd_shredcap_file_insert( fd_shredcap_file_t * file,
+                                                        ulong                idx,
+                                                        fd_blockstore_t *    blockstore );
 
 /* Iterate through manifest and seek out number of files in capture as well as
    the start/end file indicies based on the slot range [start_slot, end_slot]. */
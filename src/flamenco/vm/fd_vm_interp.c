@@ -5,6 +5,9 @@
 
 #include "fd_vm_context.h"
 #include "../runtime/fd_runtime.h"
+#include "../runtime/fd_runtime_prof.h"
+#include "../runtime/context/fd_exec_txn_ctx.h"
+#include "../runtime/context/fd_exec_instr_ctx.h"
 
 #include <stdio.h>
 
@@ -128,6 +131,39 @@ fd_vm_mem_map_write_ulong( fd_vm_exec_context_t *  ctx,
   return FD_VM_MEM_MAP_SUCCESS;
 }
 
+/* Helper function for calling a syscall. Charges the syscall's ticks and CUs (excluding
+ * any instructions it invokes) to the runtime profiler when one is attached.
+ */
+static inline ulong
+fd_vm_interp_syscall( fd_vm_exec_context_t *     ctx,
+                      fd_sbpf_syscalls_t const * syscall,
+                      ulong *                    register_file ) {
+  fd_vm_syscall_fn_ptr_t fn_ptr = (fd_vm_syscall_fn_ptr_t)syscall->func_ptr;
+  fd_runtime_prof_t * prof = ctx->instr_ctx ? ctx->instr_ctx->slot_ctx->prof : NULL;
+  if( FD_LIKELY( !prof ) ) {
+    return fn_ptr( ctx, register_file[1], register_file[2], register_file[3], register_file[4], register_file[5], &register_file[0] );
+  }
+
+  fd_exec_txn_ctx_t * txn_ctx = ctx->instr_ctx->txn_ctx;
+  long  parent_child_ticks = txn_ctx->prof_child_ticks;
+  ulong parent_child_cus   = txn_ctx->prof_child_cus;
+  txn_ctx->prof_child_ticks = 0L;
+  txn_ctx->prof_child_cus   = 0UL;
+
+  ulong cus   = ctx->compute_meter;
+  long  ticks = -fd_tickcount();
+  ulong fault = fn_ptr( ctx, register_file[1], register_file[2], register_file[3], register_file[4], register_file[5], &register_file[0] );
+  ticks += fd_tickcount();
+  cus    = fd_ulong_sat_sub( cus, ctx->compute_meter );
+
+  fd_runtime_prof_syscall( prof, syscall->key, syscall->name,
+                           fd_ulong_sat_sub( cus, txn_ctx->prof_child_cus ), ticks - txn_ctx->prof_child_ticks );
+
+  txn_ctx->prof_child_ticks = parent_child_ticks + ticks;
+  txn_ctx->prof_child_cus   = parent_child_cus   + cus;
+  return fault;
+}
+
 ulong
 fd_vm_interp_instrs( fd_vm_exec_context_t * ctx ) {
   long pc = ctx->entrypoint;
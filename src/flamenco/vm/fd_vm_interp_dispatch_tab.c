@@ -379,7 +379,7 @@ BRANCH_PRE_CODE
   } else {
     ctx->compute_meter = compute_meter;
     //FD_LOG_WARNING(("CUs! (TAB21) consumed %lu", ctx->compute_meter));
-    cond_fault = ((fd_vm_syscall_fn_ptr_t)( syscall_entry_imm->func_ptr ))(ctx, register_file[1], register_file[2], register_file[3], register_file[4], register_file[5], &register_file[0]);
+    cond_fault = fd_vm_interp_syscall( ctx, syscall_entry_imm, register_file );
     compute_meter = ctx->compute_meter;
     //FD_LOG_WARNING(("CUs! (TAB22) consumed %lu", ctx->compute_meter));
   }
@@ -11,6 +11,7 @@
 #include "../runtime/sysvar/fd_sysvar_clock.h"
 #include "../runtime/sysvar/fd_sysvar_epoch_schedule.h"
 #include "../runtime/sysvar/fd_sysvar_fees.h"
+#include "../runtime/sysvar/fd_sysvar_cache.h"
 #include "../runtime/fd_account.h"
 #include "../runtime/context/fd_exec_txn_ctx.h"
 #include "../runtime/context/fd_exec_instr_ctx.h"
@@ -2040,9 +2041,14 @@ fd_vm_syscall_sol_get_clock_sysvar(
   ulong err = fd_vm_consume_compute_meter( ctx, fd_ulong_sat_add( vm_compute_budget.sysvar_base_cost, sizeof(fd_sol_sysvar_clock_t) ) );
   if ( FD_UNLIKELY( err ) ) return err;
 
-  fd_sol_sysvar_clock_t clock;
-  fd_sol_sysvar_clock_new( &clock );
-  fd_sysvar_clock_read( &clock, ctx->instr_ctx->slot_ctx );
+  fd_sol_sysvar_clock_t const * clock = fd_sysvar_cache_clock( ctx->instr_ctx->slot_ctx->sysvar_cache );
+  fd_sol_sysvar_clock_t clock_acc;
+  if( FD_UNLIKELY( !clock ) ) {
+    /* Not cached, fall back to the accounts DB */
+    fd_sol_sysvar_clock_new( &clock_acc );
+    fd_sysvar_clock_read( &clock_acc, ctx->instr_ctx->slot_ctx );
+    clock = &clock_acc;
+  }
 
   void * out = fd_vm_translate_vm_to_host(
       ctx,
@@ -2050,7 +2056,7 @@ fd_vm_syscall_sol_get_clock_sysvar(
       sizeof(fd_sol_sysvar_clock_t),
       FD_SOL_SYSVAR_CLOCK_ALIGN );
   if( FD_UNLIKELY( !out ) ) return FD_VM_MEM_MAP_ERR_ACC_VIO;
-  memcpy( out, &clock, sizeof(fd_sol_sysvar_clock_t ) );
+  memcpy( out, clock, sizeof(fd_sol_sysvar_clock_t) );
 
   *pr0 = 0UL;
   return FD_VM_SYSCALL_SUCCESS;
@@ -2072,9 +2078,14 @@ fd_vm_syscall_sol_get_epoch_schedule_sysvar(
   ulong err = fd_vm_consume_compute_meter( ctx, fd_ulong_sat_add( vm_compute_budget.sysvar_base_cost, sizeof(fd_epoch_schedule_t) ) );
   if ( FD_UNLIKELY( err ) ) return err;
 
-  fd_epoch_schedule_t schedule;
-  fd_epoch_schedule_new( &schedule );
-  fd_sysvar_epoch_schedule_read( &schedule, ctx->instr_ctx->slot_ctx );
+  fd_epoch_schedule_t const * schedule = fd_sysvar_cache_epoch_schedule( ctx->instr_ctx->slot_ctx->sysvar_cache );
+  fd_epoch_schedule_t schedule_acc;
+  if( FD_UNLIKELY( !schedule ) ) {
+    /* Not cached, fall back to the accounts DB */
+    fd_epoch_schedule_new( &schedule_acc );
+    fd_sysvar_epoch_schedule_read( &schedule_acc, ctx->instr_ctx->slot_ctx );
+    schedule = &schedule_acc;
+  }
 
   void * out = fd_vm_translate_vm_to_host(
       ctx,
@@ -2082,7 +2093,7 @@ fd_vm_syscall_sol_get_epoch_schedule_sysvar(
       sizeof(fd_epoch_schedule_t),
       FD_EPOCH_SCHEDULE_ALIGN );
   if( FD_UNLIKELY( !out ) ) return FD_VM_MEM_MAP_ERR_ACC_VIO;
-  memcpy( out, &schedule, sizeof(fd_epoch_schedule_t) );
+  memcpy( out, schedule, sizeof(fd_epoch_schedule_t) );
 
   *pr0 = 0UL;
   return FD_VM_SYSCALL_SUCCESS;
@@ -2104,9 +2115,14 @@ fd_vm_syscall_sol_get_fees_sysvar(
   ulong err = fd_vm_consume_compute_meter( ctx, fd_ulong_sat_add( vm_compute_budget.sysvar_base_cost, sizeof(fd_sysvar_fees_t) ) );
   if ( FD_UNLIKELY( err ) ) return err;
 
-  fd_sysvar_fees_t fees;
-  fd_sysvar_fees_new( &fees );
-  fd_sysvar_fees_read( &fees, ctx->instr_ctx->slot_ctx );
+  fd_sysvar_fees_t const * fees = fd_sysvar_cache_fees( ctx->instr_ctx->slot_ctx->sysvar_cache );
+  fd_sysvar_fees_t fees_acc;
+  if( FD_UNLIKELY( !fees ) ) {
+    /* Not cached, fall back to the accounts DB */
+    fd_sysvar_fees_new( &fees_acc );
+    fd_sysvar_fees_read( &fees_acc, ctx->instr_ctx->slot_ctx );
+    fees = &fees_acc;
+  }
 
   void * out = fd_vm_translate_vm_to_host(
       ctx,
@@ -2114,7 +2130,7 @@ fd_vm_syscall_sol_get_fees_sysvar(
       sizeof(fd_sysvar_fees_t),
       FD_SYSVAR_FEES_ALIGN );
   if( FD_UNLIKELY( !out ) ) return FD_VM_MEM_MAP_ERR_ACC_VIO;
-  memcpy( out, &fees, sizeof(fd_sysvar_fees_t) );
+  memcpy( out, fees, sizeof(fd_sysvar_fees_t) );
 
   *pr0 = 0UL;
   return FD_VM_SYSCALL_SUCCESS;
@@ -2136,9 +2152,14 @@ fd_vm_syscall_sol_get_rent_sysvar(
   ulong err = fd_vm_consume_compute_meter( ctx, fd_ulong_sat_add( vm_compute_budget.sysvar_base_cost, sizeof(fd_rent_t) ) );
   if ( FD_UNLIKELY( err ) ) return err;
 
-  fd_rent_t rent;
-  fd_rent_new( &rent );
-  fd_sysvar_rent_read( &rent, ctx->instr_ctx->slot_ctx );
+  fd_rent_t const * rent = fd_sysvar_cache_rent( ctx->instr_ctx->slot_ctx->sysvar_cache );
+  fd_rent_t rent_acc;
+  if( FD_UNLIKELY( !rent ) ) {
+    /* Not cached, fall back to the accounts DB */
+    fd_rent_new( &rent_acc );
+    fd_sysvar_rent_read( &rent_acc, ctx->instr_ctx->slot_ctx );
+    rent = &rent_acc;
+  }
 
   void * out = fd_vm_translate_vm_to_host(
       ctx,
@@ -2146,7 +2167,7 @@ fd_vm_syscall_sol_get_rent_sysvar(
       sizeof(fd_rent_t),
       FD_RENT_ALIGN );
   if( FD_UNLIKELY( !out ) ) return FD_VM_MEM_MAP_ERR_ACC_VIO;
-  memcpy( out, &rent, sizeof(fd_rent_t) );
+  memcpy( out, rent, sizeof(fd_rent_t) );
 
   *pr0 = 0UL;
   return FD_VM_SYSCALL_SUCCESS;
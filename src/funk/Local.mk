@@ -7,8 +7,12 @@ $(call make-unit-test,test_funk_txn,test_funk_txn,fd_funk fd_util)
 $(call run-unit-test,test_funk_txn)
 $(call make-unit-test,test_funk_txn2,test_funk_txn2,fd_funk fd_util)
 $(call run-unit-test,test_funk_txn2)
+$(call make-unit-test,test_funk_txn_par,test_funk_txn_par,fd_funk fd_util)
+$(call run-unit-test,test_funk_txn_par)
 $(call make-unit-test,test_funk_rec,test_funk_rec test_funk_common,fd_funk fd_util)
 $(call run-unit-test,test_funk_rec)
+$(call make-unit-test,test_funk_rec_global,test_funk_rec_global,fd_funk fd_util)
+$(call run-unit-test,test_funk_rec_global)
 $(call make-unit-test,test_funk_val,test_funk_val test_funk_common,fd_funk fd_util)
 $(call run-unit-test,test_funk_val)
 $(call make-unit-test,test_funk_part,test_funk_part test_funk_common,fd_funk fd_util)
@@ -63,11 +63,20 @@ fd_funk_rec_query_global( fd_funk_t *               funk,
     if( FD_UNLIKELY( (txn_idx>=txn_max) /* Out of map (incl NULL) */ | (txn!=(txn_map+txn_idx)) /* Bad alignment */ ) )
       return NULL;
 
+    /* Only probe the record map for ancestors whose key filter says
+       they might have key (see fd_funk_txn_key_filter_test).  This
+       keeps the number of probes O(1) expected regardless of how deep
+       the in-prep history is. */
+
+    ulong key_hash = fd_funk_rec_key_hash( key, funk->seed );
+
     /* TODO: const correct and/or fortify? */
     do {
-      fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
-      fd_funk_rec_t const * rec = fd_funk_rec_map_query_const( rec_map, pair, NULL );
-      if( FD_LIKELY( rec ) ) return rec;
+      if( fd_funk_txn_key_filter_test( txn, key_hash, wksp ) ) {
+        fd_funk_xid_key_pair_t pair[1]; fd_funk_xid_key_pair_init( pair, fd_funk_txn_xid( txn ), key );
+        fd_funk_rec_t const * rec = fd_funk_rec_map_query_const( rec_map, pair, NULL );
+        if( FD_LIKELY( rec ) ) return rec;
+      }
       txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
     } while( FD_UNLIKELY( txn ) );
 
@@ -383,6 +392,9 @@ fd_funk_rec_insert( fd_funk_t *               funk,
   rec->tag      = 0U;
   rec->flags    = 0UL;
 
+  if( txn ) fd_funk_txn_key_filter_insert( txn, fd_funk_rec_key_hash( key, funk->seed ), rec_map, funk->seed,
+                                           fd_funk_alloc( funk, wksp ), wksp );
+
   if( first_born ) *_rec_head_idx                   = rec_idx;
   else             rec_map[ rec_prev_idx ].next_idx = rec_idx;
 
@@ -721,6 +733,7 @@ fd_funk_rec_verify( fd_funk_t * funk ) {
       ulong rec_idx = txn->rec_head_idx;
       while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
         TEST( (rec_idx<rec_max) && (fd_funk_txn_idx( rec_map[ rec_idx ].txn_cidx )==txn_idx) && rec_map[ rec_idx ].tag==0U );
+        TEST( fd_funk_txn_key_filter_test( txn, fd_funk_rec_key_hash( fd_funk_rec_key( rec_map + rec_idx ), funk->seed ), wksp ) );
         rec_map[ rec_idx ].tag = 1U;
         cnt++;
         ulong next_idx = rec_map[ rec_idx ].next_idx;
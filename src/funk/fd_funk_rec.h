@@ -165,7 +165,10 @@ FD_FN_PURE static inline int fd_funk_rec_is_full( fd_funk_rec_t const * map ) {
    discard an erase for an unfrozen in-preparation transaction.)  In
    such cases, the record will have no value resources in use.
 
-   These are a reasonably fast O(in_prep_ancestor_cnt). */
+   These are a reasonably fast O(in_prep_ancestor_cnt).  The per
+   ancestor cost is a bit test on the ancestor's key filter, the record
+   map is only probed for ancestors that might have key (O(1) expected
+   probes). */
 
 FD_FN_PURE fd_funk_rec_t const *
 fd_funk_rec_query( fd_funk_t *               funk,
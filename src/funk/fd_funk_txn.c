@@ -65,6 +65,68 @@
       FD_LOG_CRIT(( "memory corruption detected (cycle)" )); \
   } while(0)
 
+/* fd_funk_txn_key_filter_rebuild reinserts the keys of all of txn's
+   records into a filter of word_cnt words at filter.  Returns the
+   number of keys. */
+
+static ulong
+fd_funk_txn_key_filter_rebuild( fd_funk_txn_t const * txn,
+                                ulong *               filter,
+                                ulong                 word_cnt,
+                                fd_funk_rec_t const * rec_map,
+                                ulong                 seed ) {
+  for( ulong word_idx=0UL; word_idx<word_cnt; word_idx++ ) filter[ word_idx ] = 0UL;
+  ulong key_cnt = 0UL;
+  for( ulong rec_idx=txn->rec_head_idx; !fd_funk_rec_idx_is_null( rec_idx ); rec_idx=rec_map[ rec_idx ].next_idx ) {
+    ulong key_hash = fd_funk_rec_key_hash( fd_funk_rec_key( rec_map + rec_idx ), seed );
+    filter[ fd_funk_txn_key_filter_word_idx( key_hash, word_cnt ) ] |= fd_funk_txn_key_filter_mask( key_hash );
+    key_cnt++;
+  }
+  return key_cnt;
+}
+
+void
+fd_funk_txn_key_filter_insert( fd_funk_txn_t *       txn,
+                               ulong                 key_hash,
+                               fd_funk_rec_t const * rec_map,
+                               ulong                 seed,
+                               fd_alloc_t *          alloc,
+                               fd_wksp_t *           wksp ) {
+
+  /* If the filter is too full, rebuild it from txn's records at the
+     next size up.  The record being inserted might not be in txn's
+     record list yet, so it is always inserted below.  If the allocation
+     fails, keep using the current filter (if any). */
+
+  ulong word_cnt = txn->key_filter_word_cnt;
+  if( FD_UNLIKELY( txn->key_cnt>=word_cnt*FD_FUNK_TXN_KEY_FILTER_KEYS_PER_WORD ) ) {
+    ulong   new_word_cnt = fd_ulong_if( !!word_cnt, 2UL*word_cnt, FD_FUNK_TXN_KEY_FILTER_WORD_MIN );
+    ulong * new_filter   = (ulong *)fd_alloc_malloc( alloc, alignof(ulong), new_word_cnt*sizeof(ulong) );
+    if( FD_LIKELY( new_filter ) ) {
+      ulong key_cnt = fd_funk_txn_key_filter_rebuild( txn, new_filter, new_word_cnt, rec_map, seed );
+      fd_funk_txn_key_filter_free( txn, alloc, wksp );
+      txn->key_cnt             = key_cnt;
+      txn->key_filter_gaddr    = fd_wksp_gaddr_fast( wksp, new_filter );
+      txn->key_filter_word_cnt = new_word_cnt;
+      word_cnt                 = new_word_cnt;
+    }
+  }
+
+  txn->key_cnt++;
+  if( FD_UNLIKELY( !word_cnt ) ) return; /* No filter, every test will pass */
+  ulong * filter = (ulong *)fd_wksp_laddr_fast( wksp, txn->key_filter_gaddr );
+  filter[ fd_funk_txn_key_filter_word_idx( key_hash, word_cnt ) ] |= fd_funk_txn_key_filter_mask( key_hash );
+}
+
+void
+fd_funk_txn_key_filter_free( fd_funk_txn_t * txn,
+                             fd_alloc_t *    alloc,
+                             fd_wksp_t *     wksp ) {
+  if( FD_LIKELY( txn->key_filter_gaddr ) ) fd_alloc_free( alloc, fd_wksp_laddr_fast( wksp, txn->key_filter_gaddr ) );
+  txn->key_filter_gaddr    = 0UL;
+  txn->key_filter_word_cnt = 0UL;
+}
+
 fd_funk_txn_t *
 fd_funk_txn_prepare( fd_funk_t *               funk,
                      fd_funk_txn_t *           parent,
@@ -160,6 +222,8 @@ fd_funk_txn_prepare( fd_funk_t *               funk,
   txn->rec_head_idx = FD_FUNK_REC_IDX_NULL;
   txn->rec_tail_idx = FD_FUNK_REC_IDX_NULL;
 
+  fd_funk_txn_key_filter_clear( txn );
+
   /* TODO: consider branchless impl */
   if( FD_LIKELY( first_born ) ) *_child_head_cidx                         = fd_funk_txn_cidx( txn_idx ); /* opt for non-compete */
   else                          map[ sibling_prev_idx ].sibling_next_cidx = fd_funk_txn_cidx( txn_idx );
@@ -246,6 +310,7 @@ fd_funk_txn_cancel_childless( fd_funk_t *     funk,
     map[ sibling_next_idx ].sibling_prev_cidx = fd_funk_txn_cidx( sibling_prev_idx );
   }
 
+  fd_funk_txn_key_filter_free( &map[ txn_idx ], alloc, wksp );
   fd_funk_txn_map_remove( map, fd_funk_txn_xid( &map[ txn_idx ] ) );
 }
 
@@ -478,6 +543,171 @@ fd_funk_txn_cancel_all( fd_funk_t *     funk,
   return fd_funk_txn_cancel_children( funk, NULL, verbose );
 }
 
+/* fd_funk_txn_val_detach sets rec to the NULL value like
+   fd_funk_val_flush but, instead of freeing the value, returns the
+   gaddr of the value the caller should free (0 if there is nothing to
+   free).  This lets fd_funk_txn_update_par free values on tpool
+   workers. */
+
+static inline ulong
+fd_funk_txn_val_detach( fd_funk_rec_t * rec ) {
+  ulong val_gaddr = fd_ulong_if( rec->val_no_free, 0UL, rec->val_gaddr );
+  fd_funk_val_init( rec );
+  return val_gaddr;
+}
+
+/* fd_funk_txn_update_rec applies the update in record rec_idx to the
+   destination records as described in fd_funk_txn_update.  dst_rec is
+   the result of querying the map for (dst_xid,key), NULL if not
+   present.  rec_idx has already been validated and unlinked from its
+   transaction.  Returns the gaddr of a value that was discarded by the
+   update and that the caller should free, 0 if none. */
+
+static inline ulong
+fd_funk_txn_update_rec( ulong *                   _dst_rec_head_idx,
+                        ulong *                   _dst_rec_tail_idx,
+                        ulong                     dst_txn_idx,
+                        fd_funk_txn_xid_t const * dst_xid,
+                        ulong                     rec_idx,
+                        fd_funk_rec_t *           dst_rec,
+                        fd_funk_rec_t *           rec_map,
+                        fd_funk_partvec_t *       partvec ) {
+  ulong free_gaddr = 0UL;
+
+  fd_funk_xid_key_pair_t dst_pair[1];
+  fd_funk_xid_key_pair_init( dst_pair, dst_xid, fd_funk_rec_key( &rec_map[ rec_idx ] ) );
+
+  if( FD_UNLIKELY( rec_map[ rec_idx ].flags & FD_FUNK_REC_FLAG_ERASE ) ) { /* Erase a published key */
+
+    /* Remove from partition */
+    fd_funk_part_set_intern( partvec, rec_map, &rec_map[rec_idx], FD_FUNK_PART_NULL );
+
+    if( FD_UNLIKELY( !dst_rec ) ) {
+
+      /* Note that we only set the erase flag if there is was ancestor
+         to this transaction with the key in it.  So if are merging
+         into the last published transaction and we didn't find a
+         record there, we have a memory corruption problem. */
+
+      if( FD_UNLIKELY( fd_funk_txn_idx_is_null( dst_txn_idx ) ) ) {
+        FD_LOG_CRIT(( "memory corruption detected (bad ancestor)" ));
+      }
+
+      /* Otherwise, txn is an erase of this record from one of
+         dst's ancestors.  So we move the erase from (src_xid,key) and
+         to (dst_xid,key).  We need to do this by a map remove / map
+         insert to keep map queries working correctly.  Note that
+         value metadata was flushed when erase was first set on
+         (src_xid,key). */
+
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
+
+      dst_rec = fd_funk_rec_map_insert( rec_map, dst_pair ); /* Guaranteed to succeed at this point due to above remove */
+
+      ulong dst_rec_idx  = (ulong)(dst_rec - rec_map);
+
+      ulong dst_prev_idx = *_dst_rec_tail_idx;
+
+      dst_rec->prev_idx         = dst_prev_idx;
+      dst_rec->next_idx         = FD_FUNK_REC_IDX_NULL;
+      dst_rec->txn_cidx         = fd_funk_txn_cidx( dst_txn_idx );
+      dst_rec->tag              = 0U;
+
+      if( fd_funk_rec_idx_is_null( dst_prev_idx ) ) *_dst_rec_head_idx               = dst_rec_idx;
+      else                                          rec_map[ dst_prev_idx ].next_idx = dst_rec_idx;
+
+      *_dst_rec_tail_idx = dst_rec_idx;
+
+      fd_funk_val_init( dst_rec );
+      fd_funk_part_init( dst_rec );
+      dst_rec->flags |= FD_FUNK_REC_FLAG_ERASE;
+
+    } else {
+
+      /* The erase in rec_idx erases this transaction.  Unmap
+         (src_xid,key) (note that value was flushed when erase was
+         first set), flush dst xid's value, remove dst it from the dst
+         sequence and unmap (dst_xid,key) */
+
+      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
+
+      free_gaddr = fd_funk_txn_val_detach( dst_rec );
+      fd_funk_part_set_intern( partvec, rec_map, dst_rec, FD_FUNK_PART_NULL );
+
+      ulong prev_idx = dst_rec->prev_idx;
+      ulong next_idx = dst_rec->next_idx;
+
+      if( FD_UNLIKELY( fd_funk_rec_idx_is_null( prev_idx ) ) ) *_dst_rec_head_idx           = next_idx;
+      else                                                     rec_map[ prev_idx ].next_idx = next_idx;
+
+      if( FD_UNLIKELY( fd_funk_rec_idx_is_null( next_idx ) ) ) *_dst_rec_tail_idx           = prev_idx;
+      else                                                     rec_map[ next_idx ].prev_idx = prev_idx;
+
+      fd_funk_rec_map_remove( rec_map, dst_pair );
+
+    }
+
+  } else {
+
+    /* At this point, we are either creating a new record or updating
+       an existing one.  In either case, we are going to be keeping
+       around the src's value for later use and for speed, we do this
+       zero-copy / in-place.  So we stash record value in stack
+       temporaries and unmap (xid,key).  Note this strictly frees 1
+       record from the rec_map, guaranteeing at least 1 record free in
+       the record map below.  Note that we can't just reuse rec_idx in
+       the update case because that could break map queries. */
+
+    ulong val_sz    = (ulong)rec_map[ rec_idx ].val_sz;
+    ulong val_max   = (ulong)rec_map[ rec_idx ].val_max;
+    ulong val_gaddr = rec_map[ rec_idx ].val_gaddr;
+    int val_no_free = rec_map[ rec_idx ].val_no_free;
+    uint part       = rec_map[ rec_idx ].part;
+
+    fd_funk_part_set_intern( partvec, rec_map, &rec_map[ rec_idx ], FD_FUNK_PART_NULL );
+    fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
+
+    if( FD_UNLIKELY( !dst_rec ) ) { /* Create a published key */
+
+      dst_rec = fd_funk_rec_map_insert( rec_map, dst_pair ); /* Guaranteed to succeed at this point due to above remove */
+
+      ulong dst_rec_idx  = (ulong)(dst_rec - rec_map);
+      ulong dst_prev_idx = *_dst_rec_tail_idx;
+
+      dst_rec->prev_idx         = dst_prev_idx;
+      dst_rec->next_idx         = FD_FUNK_REC_IDX_NULL;
+      dst_rec->txn_cidx         = fd_funk_txn_cidx( dst_txn_idx );
+      dst_rec->tag              = 0U;
+
+      fd_funk_part_init( dst_rec );
+
+      if( fd_funk_rec_idx_is_null( dst_prev_idx ) ) *_dst_rec_head_idx               = dst_rec_idx;
+      else                                          rec_map[ dst_prev_idx ].next_idx = dst_rec_idx;
+
+      *_dst_rec_tail_idx = dst_rec_idx;
+
+    } else { /* Update a published key */
+
+      free_gaddr = fd_funk_txn_val_detach( dst_rec ); /* Free up any preexisting value resources */
+
+    }
+
+    /* Unstash value metadata from stack temporaries into dst_rec */
+
+    dst_rec->val_sz    = (uint)val_sz;
+    dst_rec->val_max   = (uint)val_max;
+    dst_rec->val_gaddr = val_gaddr;
+    dst_rec->val_no_free = val_no_free;
+    dst_rec->flags    &= ~FD_FUNK_REC_FLAG_ERASE;
+
+    /* Use the new partition */
+
+    fd_funk_part_set_intern( partvec, rec_map, dst_rec, part );
+  }
+
+  return free_gaddr;
+}
+
 /* fd_funk_txn_update applies the record updates in transaction txn_idx
    to another transaction or the parent transaction.  Callers have
    already validated our input arguments.
@@ -503,9 +733,10 @@ fd_funk_txn_cancel_all( fd_funk_t *     funk,
    existing values as youngest without changing the order of existing
    values.  If an update erases a record in an in-prep parent, the
    erasure will be moved into the parent as the youngest without
-   changing the order of existing values. */
+   changing the order of existing values.  Returns the number of
+   records merged. */
 
-static void
+static ulong
 fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to the dst list head */
                     ulong *                   _dst_rec_tail_idx, /* Pointer to the dst list tail */
                     ulong                     dst_txn_idx,       /* Transaction index of the merge destination */
@@ -516,12 +747,14 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
                     fd_funk_rec_t *           rec_map,           /* ==fd_funk_rec_map( funk, wksp ) */
                     fd_funk_partvec_t *       partvec,           /* ==fd_funk_get_partvec( funk, wksp ) */
                     fd_alloc_t *              alloc,             /* ==fd_funk_alloc( funk, wksp ) */
-                    fd_wksp_t *               wksp ) {           /* ==fd_funk_wksp( funk ) */
+                    fd_wksp_t *               wksp,              /* ==fd_funk_wksp( funk ) */
+                    ulong                     seed ) {           /* ==funk->seed */
   /* We don't need to to do all the individual removal pointer updates
      as we are removing the whole list from txn_idx.  Likewise, we
      temporarily repurpose txn_cidx as a loop detector for additional
      corruption protection.  */
 
+  ulong rec_cnt = 0UL;
   ulong rec_idx = txn_map[ txn_idx ].rec_head_idx;
   while( !fd_funk_rec_idx_is_null( rec_idx ) ) {
 
@@ -534,171 +767,544 @@ fd_funk_txn_update( ulong *                   _dst_rec_head_idx, /* Pointer to t
 
     ulong next_idx = rec_map[ rec_idx ].next_idx;
 
-    /* See if (dst_xid,key) already exists */
+    /* See if (dst_xid,key) already exists and apply the update */
 
     fd_funk_xid_key_pair_t dst_pair[1];
     fd_funk_xid_key_pair_init( dst_pair, dst_xid, fd_funk_rec_key( &rec_map[ rec_idx ] ) );
 
     fd_funk_rec_t * dst_rec = fd_funk_rec_map_query( rec_map, dst_pair, NULL );
 
-    if( FD_UNLIKELY( rec_map[ rec_idx ].flags & FD_FUNK_REC_FLAG_ERASE ) ) { /* Erase a published key */
+    /* If dst is in-prep and didn't have the key, it does now */
 
-      /* Remove from partition */
-      fd_funk_part_set_intern( partvec, rec_map, &rec_map[rec_idx], FD_FUNK_PART_NULL );
+    if( !fd_funk_txn_idx_is_null( dst_txn_idx ) & !dst_rec )
+      fd_funk_txn_key_filter_insert( txn_map + dst_txn_idx, fd_funk_rec_key_hash( fd_funk_rec_key( &rec_map[ rec_idx ] ), seed ),
+                                     rec_map, seed, alloc, wksp );
 
-      if( FD_UNLIKELY( !dst_rec ) ) {
+    ulong free_gaddr = fd_funk_txn_update_rec( _dst_rec_head_idx, _dst_rec_tail_idx, dst_txn_idx, dst_xid, rec_idx, dst_rec,
+                                               rec_map, partvec );
+    if( free_gaddr ) fd_alloc_free( alloc, fd_wksp_laddr_fast( wksp, free_gaddr ) );
 
-        /* Note that we only set the erase flag if there is was ancestor
-           to this transaction with the key in it.  So if are merging
-           into the last published transaction and we didn't find a
-           record there, we have a memory corruption problem. */
+    /* Advance to the next record */
 
-        if( FD_UNLIKELY( fd_funk_txn_idx_is_null( dst_txn_idx ) ) ) {
-          FD_LOG_CRIT(( "memory corruption detected (bad ancestor)" ));
-        }
+    rec_idx = next_idx;
+    rec_cnt++;
+  }
 
-        /* Otherwise, txn is an erase of this record from one of
-           dst's ancestors.  So we move the erase from (src_xid,key) and
-           to (dst_xid,key).  We need to do this by a map remove / map
-           insert to keep map queries working correctly.  Note that
-           value metadata was flushed when erase was first set on
-           (src_xid,key). */
+  txn_map[ txn_idx ].rec_head_idx = FD_FUNK_REC_IDX_NULL;
+  txn_map[ txn_idx ].rec_tail_idx = FD_FUNK_REC_IDX_NULL;
 
-        fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
+  fd_funk_txn_key_filter_free( txn_map + txn_idx, alloc, wksp );
 
-        dst_rec = fd_funk_rec_map_insert( rec_map, dst_pair ); /* Guaranteed to succeed at this point due to above remove */
+  return rec_cnt;
+}
 
-        ulong dst_rec_idx  = (ulong)(dst_rec - rec_map);
+/* fd_funk_txn_par_rec_t holds the scratch state of a record merged by
+   fd_funk_txn_update_par.  See fd_funk_txn_update_par for the use of
+   each field. */
+
+#define FD_FUNK_TXN_PAR_OP_CREATE        (0U) /* (root,key) is absent, src becomes it */
+#define FD_FUNK_TXN_PAR_OP_UPDATE        (1U) /* (root,key) gets src's value, src is freed */
+#define FD_FUNK_TXN_PAR_OP_ERASE         (2U) /* src and (root,key) are freed */
+#define FD_FUNK_TXN_PAR_OP_ERASE_MISSING (3U) /* erase of an absent (root,key), corruption */
+
+struct fd_funk_txn_par_rec {
+  ulong  src_idx;    /* Record to merge */
+  ulong  dst_idx;    /* Map idx of (root,key) at the start of the merge, FD_FUNK_REC_IDX_NULL if absent */
+  ulong  dst_hash;   /* Map hash of (root,key) */
+  ulong  link;       /* Create: prev_idx of the created record, update/erase: map_next of src once freed */
+  ulong  link2;      /* Create: next_idx of the created record, erase: map_next of dst once freed */
+  ulong  free_gaddr; /* Value discarded by the merge to free, 0 if none */
+  uint   src_part;   /* Partition of src */
+  uint   dst_part;   /* Partition of (root,key), FD_FUNK_PART_NULL if absent */
+  ushort src_owner;  /* Worker owning the map chain of src */
+  ushort dst_owner;  /* Worker owning the map chain of (root,key) */
+  uint   op;         /* FD_FUNK_TXN_PAR_OP_* */
+};
+
+typedef struct fd_funk_txn_par_rec fd_funk_txn_par_rec_t;
+
+/* fd_funk_txn_par_t holds the state shared by the tpool tasks of
+   fd_funk_txn_update_par.  rec has an entry per record to merge, in
+   list order.  src_order[ src_beg[o], src_beg[o+1] ) indexes the
+   entries whose src lives in a map chain owned by worker o, in list
+   order, and similarly dst_order / dst_beg for the entries that create
+   or erase (root,key).  src_cnt / dst_cnt are worker_cnt x worker_cnt
+   matrices indexed [block*worker_cnt+owner] used to build them. */
+
+struct fd_funk_txn_par {
+  fd_funk_txn_par_rec_t *   rec;
+  ulong                     rec_cnt;
+  ulong *                   src_order;
+  ulong *                   dst_order;
+  ulong *                   src_cnt;
+  ulong *                   dst_cnt;
+  ulong *                   src_beg;
+  ulong *                   dst_beg;
+  ulong                     worker_cnt;
+  fd_funk_rec_t *           rec_map;
+  ulong *                   chain;      /* The map chain heads */
+  ulong                     chain_mask; /* Map chain count - 1 */
+  ulong                     seed;
+  fd_funk_txn_xid_t const * dst_xid;
+  fd_alloc_t *              alloc;
+  fd_wksp_t *               wksp;
+};
+
+typedef struct fd_funk_txn_par fd_funk_txn_par_t;
+
+/* fd_funk_txn_par_query_task classifies entries [m0,m1) (the block of
+   worker n0) and counts them by the workers owning their map chains.
+   Note that fd_funk_rec_map_query moves what it finds to the front of
+   its chain, so it can't be used concurrently.  query_const doesn't
+   modify the map, so any number of workers can use it at once as long
+   as nobody modifies the map. */
 
-        ulong dst_prev_idx = *_dst_rec_tail_idx;
+static void
+fd_funk_txn_par_query_task( void * tpool,
+                            ulong  t0,                     ulong t1 FD_PARAM_UNUSED,
+                            void * args   FD_PARAM_UNUSED,
+                            void * reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                            ulong  l0     FD_PARAM_UNUSED, ulong l1 FD_PARAM_UNUSED,
+                            ulong  m0,                     ulong m1,
+                            ulong  n0,                     ulong n1 FD_PARAM_UNUSED ) {
+  fd_funk_txn_par_t *     par        = (fd_funk_txn_par_t *)tpool;
+  fd_funk_rec_t const *   rec_map    = par->rec_map;
+  fd_funk_txn_par_rec_t * rec        = par->rec;
+  ulong                   worker_cnt = par->worker_cnt;
+  ulong *                 src_cnt    = par->src_cnt + (n0-t0)*worker_cnt;
+  ulong *                 dst_cnt    = par->dst_cnt + (n0-t0)*worker_cnt;
+
+  for( ulong o=0UL; o<worker_cnt; o++ ) src_cnt[ o ] = dst_cnt[ o ] = 0UL;
+
+  for( ulong i=m0; i<m1; i++ ) {
+    fd_funk_rec_t const * src = rec_map + rec[ i ].src_idx;
 
-        dst_rec->prev_idx         = dst_prev_idx;
-        dst_rec->next_idx         = FD_FUNK_REC_IDX_NULL;
-        dst_rec->txn_cidx         = fd_funk_txn_cidx( dst_txn_idx );
-        dst_rec->tag              = 0U;
+    fd_funk_xid_key_pair_t dst_pair[1];
+    fd_funk_xid_key_pair_init( dst_pair, par->dst_xid, fd_funk_rec_key( src ) );
+    fd_funk_rec_t const * dst = fd_funk_rec_map_query_const( rec_map, dst_pair, NULL );
+
+    uint op;
+    if( FD_UNLIKELY( src->flags & FD_FUNK_REC_FLAG_ERASE ) ) op = dst ? FD_FUNK_TXN_PAR_OP_ERASE  : FD_FUNK_TXN_PAR_OP_ERASE_MISSING;
+    else                                                     op = dst ? FD_FUNK_TXN_PAR_OP_UPDATE : FD_FUNK_TXN_PAR_OP_CREATE;
+
+    ulong dst_hash  = fd_funk_xid_key_pair_hash( dst_pair, par->seed );
+    ulong src_owner = (src->map_hash & par->chain_mask) % worker_cnt;
+    ulong dst_owner = (dst_hash      & par->chain_mask) % worker_cnt;
+
+    rec[ i ].dst_idx   = dst ? (ulong)(dst - rec_map) : FD_FUNK_REC_IDX_NULL;
+    rec[ i ].dst_hash  = dst_hash;
+    rec[ i ].src_part  = src->part;
+    rec[ i ].dst_part  = dst ? dst->part : FD_FUNK_PART_NULL;
+    rec[ i ].src_owner = (ushort)src_owner;
+    rec[ i ].dst_owner = (ushort)dst_owner;
+    rec[ i ].op        = op;
+
+    src_cnt[ src_owner ]++;
+    dst_cnt[ dst_owner ] += (ulong)( (op==FD_FUNK_TXN_PAR_OP_CREATE) | (op==FD_FUNK_TXN_PAR_OP_ERASE) );
+  }
+}
 
-        if( fd_funk_rec_idx_is_null( dst_prev_idx ) ) *_dst_rec_head_idx               = dst_rec_idx;
-        else                                          rec_map[ dst_prev_idx ].next_idx = dst_rec_idx;
+/* fd_funk_txn_par_order_task scatters entries [m0,m1) into src_order
+   and dst_order.  On entry, src_cnt / dst_cnt of worker n0's block
+   hold where its entries for each owner go. */
 
-        *_dst_rec_tail_idx = dst_rec_idx;
+static void
+fd_funk_txn_par_order_task( void * tpool,
+                            ulong  t0,                     ulong t1 FD_PARAM_UNUSED,
+                            void * args   FD_PARAM_UNUSED,
+                            void * reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                            ulong  l0     FD_PARAM_UNUSED, ulong l1 FD_PARAM_UNUSED,
+                            ulong  m0,                     ulong m1,
+                            ulong  n0,                     ulong n1 FD_PARAM_UNUSED ) {
+  fd_funk_txn_par_t *           par     = (fd_funk_txn_par_t *)tpool;
+  fd_funk_txn_par_rec_t const * rec     = par->rec;
+  ulong *                       src_off = par->src_cnt + (n0-t0)*par->worker_cnt;
+  ulong *                       dst_off = par->dst_cnt + (n0-t0)*par->worker_cnt;
+
+  for( ulong i=m0; i<m1; i++ ) {
+    uint op = rec[ i ].op;
+    par->src_order[ src_off[ rec[ i ].src_owner ]++ ] = i;
+    if( (op==FD_FUNK_TXN_PAR_OP_CREATE) | (op==FD_FUNK_TXN_PAR_OP_ERASE) ) par->dst_order[ dst_off[ rec[ i ].dst_owner ]++ ] = i;
+  }
+}
 
-        fd_funk_val_init( dst_rec );
-        fd_funk_part_init( dst_rec );
-        dst_rec->flags |= FD_FUNK_REC_FLAG_ERASE;
+/* fd_funk_txn_par_unlink removes record rec_idx from map chain
+   chain_idx without freeing it. */
 
-      } else {
+static inline void
+fd_funk_txn_par_unlink( fd_funk_txn_par_t * par,
+                        ulong               chain_idx,
+                        ulong               rec_idx ) {
+  fd_funk_rec_t * rec_map = par->rec_map;
+  ulong *         cur     = par->chain + chain_idx;
+  for(;;) {
+    ulong idx = fd_funk_rec_map_private_unbox_idx( *cur );
+    if( FD_UNLIKELY( fd_funk_rec_map_private_is_null( idx ) ) ) FD_LOG_CRIT(( "memory corruption detected (bad map chain)" ));
+    if( idx==rec_idx ) break;
+    cur = &rec_map[ idx ].map_next;
+  }
+  *cur = rec_map[ rec_idx ].map_next; /* already tagged used */
+}
 
-        /* The erase in rec_idx erases this transaction.  Unmap
-           (src_xid,key) (note that value was flushed when erase was
-           first set), flush dst xid's value, remove dst it from the dst
-           sequence and unmap (dst_xid,key) */
+/* fd_funk_txn_par_remove_task does, for the map chains owned by worker
+   n0, the map removes of the merge and the value moves of the records
+   in those chains.  Each map chain is modified by exactly one worker,
+   so this is safe to run concurrently. */
 
-        fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
+static void
+fd_funk_txn_par_remove_task( void * tpool,
+                             ulong  t0,                     ulong t1 FD_PARAM_UNUSED,
+                             void * args   FD_PARAM_UNUSED,
+                             void * reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                             ulong  l0     FD_PARAM_UNUSED, ulong l1 FD_PARAM_UNUSED,
+                             ulong  m0     FD_PARAM_UNUSED, ulong m1 FD_PARAM_UNUSED,
+                             ulong  n0,                     ulong n1 FD_PARAM_UNUSED ) {
+  fd_funk_txn_par_t *     par     = (fd_funk_txn_par_t *)tpool;
+  fd_funk_rec_t *         rec_map = par->rec_map;
+  fd_funk_txn_par_rec_t * rec     = par->rec;
+  ulong                   o       = n0-t0;
+
+  for( ulong k=par->src_beg[ o ]; k<par->src_beg[ o+1UL ]; k++ ) {
+    fd_funk_txn_par_rec_t * r   = rec + par->src_order[ k ];
+    fd_funk_rec_t *         src = rec_map + r->src_idx;
+
+    fd_funk_txn_par_unlink( par, src->map_hash & par->chain_mask, r->src_idx );
+
+    if( r->op==FD_FUNK_TXN_PAR_OP_UPDATE ) {
+      fd_funk_rec_t * dst = rec_map + r->dst_idx;
+      r->free_gaddr    = fd_funk_txn_val_detach( dst );
+      dst->val_sz      = src->val_sz;
+      dst->val_max     = src->val_max;
+      dst->val_gaddr   = src->val_gaddr;
+      dst->val_no_free = src->val_no_free;
+      dst->flags      &= ~FD_FUNK_REC_FLAG_ERASE;
+    }
 
-        fd_funk_val_flush( dst_rec, alloc, wksp );
-        fd_funk_part_set_intern( partvec, rec_map, dst_rec, FD_FUNK_PART_NULL );
+    if( r->op!=FD_FUNK_TXN_PAR_OP_CREATE ) src->map_next = r->link; /* Push to the free stack */
+  }
 
-        ulong prev_idx = dst_rec->prev_idx;
-        ulong next_idx = dst_rec->next_idx;
+  for( ulong k=par->dst_beg[ o ]; k<par->dst_beg[ o+1UL ]; k++ ) {
+    fd_funk_txn_par_rec_t * r = rec + par->dst_order[ k ];
+    if( r->op!=FD_FUNK_TXN_PAR_OP_ERASE ) continue;
+    fd_funk_rec_t * dst = rec_map + r->dst_idx;
+    fd_funk_txn_par_unlink( par, r->dst_hash & par->chain_mask, r->dst_idx );
+    r->free_gaddr = fd_funk_txn_val_detach( dst );
+    dst->map_next = r->link2; /* Push to the free stack */
+  }
+}
 
-        if( FD_UNLIKELY( fd_funk_rec_idx_is_null( prev_idx ) ) ) *_dst_rec_head_idx           = next_idx;
-        else                                                     rec_map[ prev_idx ].next_idx = next_idx;
+/* fd_funk_txn_par_insert_task does, for the map chains owned by worker
+   n0, the map inserts of the merge.  Like fd_funk_rec_map_remove
+   followed by fd_funk_rec_map_insert does in fd_funk_txn_update, the
+   record of a created key reuses the element of src.  Records are
+   inserted in list order so each chain ends up as in a serial merge
+   (modulo fd_funk_rec_map_query's move to front). */
 
-        if( FD_UNLIKELY( fd_funk_rec_idx_is_null( next_idx ) ) ) *_dst_rec_tail_idx           = prev_idx;
-        else                                                     rec_map[ next_idx ].prev_idx = prev_idx;
+static void
+fd_funk_txn_par_insert_task( void * tpool,
+                             ulong  t0,                     ulong t1 FD_PARAM_UNUSED,
+                             void * args   FD_PARAM_UNUSED,
+                             void * reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                             ulong  l0     FD_PARAM_UNUSED, ulong l1 FD_PARAM_UNUSED,
+                             ulong  m0     FD_PARAM_UNUSED, ulong m1 FD_PARAM_UNUSED,
+                             ulong  n0,                     ulong n1 FD_PARAM_UNUSED ) {
+  fd_funk_txn_par_t *           par     = (fd_funk_txn_par_t *)tpool;
+  fd_funk_rec_t *               rec_map = par->rec_map;
+  fd_funk_txn_par_rec_t const * rec     = par->rec;
+  ulong                         o       = n0-t0;
+
+  for( ulong k=par->dst_beg[ o ]; k<par->dst_beg[ o+1UL ]; k++ ) {
+    fd_funk_txn_par_rec_t const * r = rec + par->dst_order[ k ];
+    if( r->op!=FD_FUNK_TXN_PAR_OP_CREATE ) continue;
+
+    fd_funk_rec_t * dst  = rec_map + r->src_idx;
+    ulong *         head = par->chain + (r->dst_hash & par->chain_mask);
+    fd_funk_txn_xid_copy( dst->pair.xid, par->dst_xid );
+    dst->map_hash = r->dst_hash;
+    dst->map_next = fd_funk_rec_map_private_box_next( fd_funk_rec_map_private_unbox_idx( *head ), 0 );
+    *head         = fd_funk_rec_map_private_box_next( r->src_idx, 0 );
+
+    dst->prev_idx = r->link;
+    dst->next_idx = r->link2;
+    dst->txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+    dst->tag      = 0U;
+    dst->flags   &= ~FD_FUNK_REC_FLAG_ERASE;
+    fd_funk_part_init( dst );
+  }
+}
 
-        fd_funk_rec_map_remove( rec_map, dst_pair );
+/* fd_funk_txn_par_free_task frees the values discarded by entries
+   [m0,m1).  fd_alloc is safe for concurrent use.  Each worker uses its
+   own concurrency group to reduce contention. */
 
-      }
+static void
+fd_funk_txn_par_free_task( void * tpool,
+                           ulong  t0     FD_PARAM_UNUSED, ulong t1 FD_PARAM_UNUSED,
+                           void * args   FD_PARAM_UNUSED,
+                           void * reduce FD_PARAM_UNUSED, ulong stride FD_PARAM_UNUSED,
+                           ulong  l0     FD_PARAM_UNUSED, ulong l1 FD_PARAM_UNUSED,
+                           ulong  m0,                     ulong m1,
+                           ulong  n0,                     ulong n1 FD_PARAM_UNUSED ) {
+  fd_funk_txn_par_t *     par   = (fd_funk_txn_par_t *)tpool;
+  fd_funk_txn_par_rec_t * rec   = par->rec;
+  fd_alloc_t *            alloc = fd_alloc_join_cgroup_hint_set( par->alloc, n0 );
+
+  for( ulong i=m0; i<m1; i++ ) {
+    ulong free_gaddr = rec[ i ].free_gaddr;
+    if( free_gaddr ) fd_alloc_free( alloc, fd_wksp_laddr_fast( par->wksp, free_gaddr ) );
+  }
+}
 
-    } else {
+/* fd_funk_txn_update_par does the same thing as fd_funk_txn_update for
+   a merge into the last published transaction, using tpool threads
+   [t0,t1).  Returns the number of records merged.  It goes as follows:
 
-      /* At this point, we are either creating a new record or updating
-         an existing one.  In either case, we are going to be keeping
-         around the src's value for later use and for speed, we do this
-         zero-copy / in-place.  So we stash record value in stack
-         temporaries and unmap (xid,key).  Note this strictly frees 1
-         record from the rec_map, guaranteeing at least 1 record free in
-         the record map below.  Note that we can't just reuse rec_idx in
-         the update case because that could break map queries. */
-
-      ulong val_sz    = (ulong)rec_map[ rec_idx ].val_sz;
-      ulong val_max   = (ulong)rec_map[ rec_idx ].val_max;
-      ulong val_gaddr = rec_map[ rec_idx ].val_gaddr;
-      int val_no_free = rec_map[ rec_idx ].val_no_free;
-      uint part       = rec_map[ rec_idx ].part;
-
-      fd_funk_part_set_intern( partvec, rec_map, &rec_map[ rec_idx ], FD_FUNK_PART_NULL );
-      fd_funk_rec_map_remove( rec_map, fd_funk_rec_pair( &rec_map[ rec_idx ] ) );
+   - query (parallel over records): look up (root,key) for each record
+     and classify it as a create, update or erase.  Nothing is modified
+     so query_const can be used concurrently.  Each key appears at most
+     once in a transaction, so merging one record never adds or removes
+     the destination of another and these stay valid throughout.
 
-      if( FD_UNLIKELY( !dst_rec ) ) { /* Create a published key */
+   - bookkeeping (serial, over the scratch array): work out, in list
+     order, how the free stack, the record list and the partitions
+     change, as fd_funk_txn_update would.  Only erases and records in
+     partitions touch the records themselves here, and those are rare.
 
-        dst_rec = fd_funk_rec_map_insert( rec_map, dst_pair ); /* Guaranteed to succeed at this point due to above remove */
+   - order (parallel over records): group the records by the worker
+     that owns their map chains.  Worker o owns the chains whose index
+     is o mod the worker count.
 
-        ulong dst_rec_idx  = (ulong)(dst_rec - rec_map);
-        ulong dst_prev_idx = *_dst_rec_tail_idx;
+   - remove then insert (parallel over chains): unlink the records
+     leaving the map, move the updated values, then link the created
+     records.  Every chain is only touched by its owner.  The two are
+     separate passes so a created record is never relinked while
+     another worker unlinks it.
 
-        dst_rec->prev_idx         = dst_prev_idx;
-        dst_rec->next_idx         = FD_FUNK_REC_IDX_NULL;
-        dst_rec->txn_cidx         = fd_funk_txn_cidx( dst_txn_idx );
-        dst_rec->tag              = 0U;
+   - free (parallel over records): free the discarded values.
 
-        fd_funk_part_init( dst_rec );
+   The result is identical to fd_funk_txn_update except for the order
+   of records within map chains.  Falls back to fd_funk_txn_update if
+   there is only one thread, there are fewer than
+   FD_FUNK_TXN_PUBLISH_PAR_MIN records or the scratch space for the
+   update can't be allocated. */
 
-        if( fd_funk_rec_idx_is_null( dst_prev_idx ) ) *_dst_rec_head_idx               = dst_rec_idx;
-        else                                          rec_map[ dst_prev_idx ].next_idx = dst_rec_idx;
+static ulong
+fd_funk_txn_update_par( ulong *                   _dst_rec_head_idx,
+                        ulong *                   _dst_rec_tail_idx,
+                        fd_funk_txn_xid_t const * dst_xid,
+                        ulong                     txn_idx,
+                        ulong                     rec_max,
+                        fd_funk_txn_t *           txn_map,
+                        fd_funk_rec_t *           rec_map,
+                        fd_funk_partvec_t *       partvec,
+                        fd_alloc_t *              alloc,
+                        fd_wksp_t *               wksp,
+                        ulong                     seed,
+                        fd_tpool_t *              tpool,
+                        ulong                     t0,
+                        ulong                     t1 ) {
+
+  /* Count the records, bounding by rec_max to detect cycles */
+
+  ulong worker_cnt = t1-t0;
+  ulong rec_cnt    = 0UL;
+  if( FD_LIKELY( worker_cnt>1UL ) ) {
+    for( ulong rec_idx=txn_map[ txn_idx ].rec_head_idx; !fd_funk_rec_idx_is_null( rec_idx ); rec_idx=rec_map[ rec_idx ].next_idx ) {
+      if( FD_UNLIKELY( (rec_idx>=rec_max) | (rec_cnt>=rec_max) ) ) FD_LOG_CRIT(( "memory corruption detected (bad idx)" ));
+      rec_cnt++;
+    }
+  }
 
-        *_dst_rec_tail_idx = dst_rec_idx;
+  void * scratch = NULL;
+  if( FD_LIKELY( rec_cnt>=FD_FUNK_TXN_PUBLISH_PAR_MIN ) ) {
+    scratch = fd_alloc_malloc( alloc, alignof(fd_funk_txn_par_rec_t),
+                               rec_cnt*(sizeof(fd_funk_txn_par_rec_t) + 2UL*sizeof(ulong)) +
+                               2UL*(worker_cnt*worker_cnt + worker_cnt+1UL)*sizeof(ulong) );
+  }
+  if( FD_UNLIKELY( !scratch ) ) {
+    return fd_funk_txn_update( _dst_rec_head_idx, _dst_rec_tail_idx, FD_FUNK_TXN_IDX_NULL, dst_xid, txn_idx, rec_max, txn_map,
+                               rec_map, partvec, alloc, wksp, seed );
+  }
 
-      } else { /* Update a published key */
+  fd_funk_rec_map_private_t * map = fd_funk_rec_map_private( rec_map );
+
+  fd_funk_txn_par_t par[1];
+  par->rec        = (fd_funk_txn_par_rec_t *)scratch;
+  par->rec_cnt    = rec_cnt;
+  par->src_order  = (ulong *)(par->rec + rec_cnt);
+  par->dst_order  = par->src_order + rec_cnt;
+  par->src_cnt    = par->dst_order + rec_cnt;
+  par->dst_cnt    = par->src_cnt   + worker_cnt*worker_cnt;
+  par->src_beg    = par->dst_cnt   + worker_cnt*worker_cnt;
+  par->dst_beg    = par->src_beg   + worker_cnt+1UL;
+  par->worker_cnt = worker_cnt;
+  par->rec_map    = rec_map;
+  par->chain      = fd_funk_rec_map_private_list( map );
+  par->chain_mask = map->list_cnt-1UL;
+  par->seed       = seed;
+  par->dst_xid    = dst_xid;
+  par->alloc      = alloc;
+  par->wksp       = wksp;
+
+  fd_funk_txn_par_rec_t * rec = par->rec;
+
+  /* Validate and unlink the records as in fd_funk_txn_update */
 
-        fd_funk_val_flush( dst_rec, alloc, wksp ); /* Free up any preexisting value resources */
+  ulong rec_idx = txn_map[ txn_idx ].rec_head_idx;
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    if( FD_UNLIKELY( fd_funk_txn_idx( rec_map[ rec_idx ].txn_cidx )!=txn_idx ) )
+      FD_LOG_CRIT(( "memory corruption detected (cycle or bad idx)" ));
+    rec_map[ rec_idx ].txn_cidx = fd_funk_txn_cidx( FD_FUNK_TXN_IDX_NULL );
+    rec[ i ].src_idx    = rec_idx;
+    rec[ i ].free_gaddr = 0UL;
+    rec_idx = rec_map[ rec_idx ].next_idx;
+  }
 
-      }
+  fd_tpool_exec_all_batch( tpool, t0, t1, fd_funk_txn_par_query_task, par, NULL, NULL, 1UL, 0UL, rec_cnt );
 
-      /* Unstash value metadata from stack temporaries into dst_rec */
+  /* Lay out src_order and dst_order by owner, then by block, which
+     keeps each owner's records in list order */
 
-      dst_rec->val_sz    = (uint)val_sz;
-      dst_rec->val_max   = (uint)val_max;
-      dst_rec->val_gaddr = val_gaddr;
-      dst_rec->val_no_free = val_no_free;
-      dst_rec->flags    &= ~FD_FUNK_REC_FLAG_ERASE;
+  ulong src_off = 0UL;
+  ulong dst_off = 0UL;
+  for( ulong o=0UL; o<worker_cnt; o++ ) {
+    par->src_beg[ o ] = src_off;
+    par->dst_beg[ o ] = dst_off;
+    for( ulong b=0UL; b<worker_cnt; b++ ) {
+      ulong src_cnt = par->src_cnt[ b*worker_cnt+o ]; par->src_cnt[ b*worker_cnt+o ] = src_off; src_off += src_cnt;
+      ulong dst_cnt = par->dst_cnt[ b*worker_cnt+o ]; par->dst_cnt[ b*worker_cnt+o ] = dst_off; dst_off += dst_cnt;
+    }
+  }
+  par->src_beg[ worker_cnt ] = src_off;
+  par->dst_beg[ worker_cnt ] = dst_off;
+
+  fd_tpool_exec_all_batch( tpool, t0, t1, fd_funk_txn_par_order_task, par, NULL, NULL, 1UL, 0UL, rec_cnt );
+
+  /* Records leaving partitions, records erased from the destination
+     list and the free stack, in list order.  Freed records are pushed
+     in the same order as fd_funk_rec_map_remove would. */
+
+  ulong free_top = map->free_stack;
+  ulong free_cnt = 0UL;
+  ulong dst_head = *_dst_rec_head_idx;
+  ulong dst_tail = *_dst_rec_tail_idx;
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    fd_funk_txn_par_rec_t * r = rec + i;
+    if( FD_UNLIKELY( r->src_part!=FD_FUNK_PART_NULL ) )
+      fd_funk_part_set_intern( partvec, rec_map, rec_map + r->src_idx, FD_FUNK_PART_NULL );
+
+    switch( r->op ) {
+    case FD_FUNK_TXN_PAR_OP_ERASE_MISSING:
+      /* See fd_funk_txn_update_rec */
+      FD_LOG_CRIT(( "memory corruption detected (bad ancestor)" ));
+      break;
+    case FD_FUNK_TXN_PAR_OP_ERASE: {
+      r->link  = free_top; free_top = fd_funk_rec_map_private_box_next( r->src_idx, 1 );
+      r->link2 = free_top; free_top = fd_funk_rec_map_private_box_next( r->dst_idx, 1 );
+      free_cnt += 2UL;
+
+      fd_funk_rec_t * dst = rec_map + r->dst_idx;
+      if( FD_UNLIKELY( r->dst_part!=FD_FUNK_PART_NULL ) ) fd_funk_part_set_intern( partvec, rec_map, dst, FD_FUNK_PART_NULL );
+
+      ulong prev_idx = dst->prev_idx;
+      ulong next_idx = dst->next_idx;
+
+      if( FD_UNLIKELY( fd_funk_rec_idx_is_null( prev_idx ) ) ) dst_head                     = next_idx;
+      else                                                     rec_map[ prev_idx ].next_idx = next_idx;
+
+      if( FD_UNLIKELY( fd_funk_rec_idx_is_null( next_idx ) ) ) dst_tail                     = prev_idx;
+      else                                                     rec_map[ next_idx ].prev_idx = prev_idx;
+      break;
+    }
+    case FD_FUNK_TXN_PAR_OP_UPDATE:
+      r->link = free_top; free_top = fd_funk_rec_map_private_box_next( r->src_idx, 1 );
+      free_cnt++;
+      break;
+    default:
+      break;
+    }
+  }
 
-      /* Use the new partition */
+  map->free_stack = free_top;
+  fd_funk_rec_map_set_key_cnt( rec_map, fd_funk_rec_map_key_cnt( rec_map ) - free_cnt );
+
+  /* Created records are appended to the destination list in list
+     order.  The links of the created records themselves are set by the
+     insert task. */
+
+  ulong last = ULONG_MAX; /* Entry of the last created record so far */
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    fd_funk_txn_par_rec_t * r = rec + i;
+    if( r->op!=FD_FUNK_TXN_PAR_OP_CREATE ) continue;
+    r->link  = dst_tail;
+    r->link2 = FD_FUNK_REC_IDX_NULL;
+    if(      fd_funk_rec_idx_is_null( dst_tail ) ) dst_head                     = r->src_idx;
+    else if( last!=ULONG_MAX                   ) rec[ last ].link2            = r->src_idx;
+    else                                         rec_map[ dst_tail ].next_idx = r->src_idx;
+    dst_tail = r->src_idx;
+    last     = i;
+  }
 
-      fd_funk_part_set_intern( partvec, rec_map, dst_rec, part );
-    }
+  *_dst_rec_head_idx = dst_head;
+  *_dst_rec_tail_idx = dst_tail;
 
-    /* Advance to the next record */
+  fd_tpool_exec_all_raw( tpool, t0, t1, fd_funk_txn_par_remove_task, par, NULL, NULL, 1UL, 0UL, 0UL );
+  fd_tpool_exec_all_raw( tpool, t0, t1, fd_funk_txn_par_insert_task, par, NULL, NULL, 1UL, 0UL, 0UL );
 
-    rec_idx = next_idx;
+  /* Records joining partitions, in list order */
+
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    fd_funk_txn_par_rec_t const * r = rec + i;
+    if( FD_LIKELY( r->src_part==r->dst_part ) ) continue;
+    if(      r->op==FD_FUNK_TXN_PAR_OP_UPDATE ) fd_funk_part_set_intern( partvec, rec_map, rec_map + r->dst_idx, r->src_part );
+    else if( r->op==FD_FUNK_TXN_PAR_OP_CREATE ) fd_funk_part_set_intern( partvec, rec_map, rec_map + r->src_idx, r->src_part );
   }
 
+  fd_tpool_exec_all_batch( tpool, t0, t1, fd_funk_txn_par_free_task, par, NULL, NULL, 1UL, 0UL, rec_cnt );
+
+  fd_alloc_free( alloc, scratch );
+
   txn_map[ txn_idx ].rec_head_idx = FD_FUNK_REC_IDX_NULL;
   txn_map[ txn_idx ].rec_tail_idx = FD_FUNK_REC_IDX_NULL;
+
+  fd_funk_txn_key_filter_free( txn_map + txn_idx, alloc, wksp );
+
+  return rec_cnt;
 }
 
 /* fd_funk_txn_publish_funk_child publishes a transaction that is known
    to be a child of funk.  Callers have already validated our input
    arguments.  Returns FD_FUNK_SUCCESS on success and an FD_FUNK_ERR_*
    code on failure.  (There are currently no failure cases but the
-   plumbing is there if value handling requires it at some point.) */
+   plumbing is there if value handling requires it at some point.)  If
+   tpool is non-NULL, the records are merged using tpool threads
+   [t0,t1).  The number of records merged is added to *rec_cnt. */
 
 static int
 fd_funk_txn_publish_funk_child( fd_funk_t *     funk,
                                 fd_funk_txn_t * map,
                                 ulong           txn_max,
                                 ulong           tag,
-                                ulong           txn_idx ) {
+                                ulong           txn_idx,
+                                fd_tpool_t *    tpool,
+                                ulong           t0,
+                                ulong           t1,
+                                ulong *         rec_cnt ) {
 
   fd_funk_check_write( funk );
 
   /* Apply the updates in txn to the last published transactions */
 
   fd_wksp_t * wksp = fd_funk_wksp( funk );
-  fd_funk_txn_update( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
-                      txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
-                      fd_funk_alloc( funk, wksp ), wksp );
+  if( tpool ) {
+    *rec_cnt += fd_funk_txn_update_par( &funk->rec_head_idx, &funk->rec_tail_idx, fd_funk_root( funk ),
+                                        txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
+                                        fd_funk_alloc( funk, wksp ), wksp, funk->seed, tpool, t0, t1 );
+  } else {
+    *rec_cnt += fd_funk_txn_update( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
+                                    txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
+                                    fd_funk_alloc( funk, wksp ), wksp, funk->seed );
+  }
 
   /* Cancel all competing transaction histories */
 
@@ -734,10 +1340,14 @@ fd_funk_txn_publish_funk_child( fd_funk_t *     funk,
   return FD_FUNK_SUCCESS;
 }
 
-ulong
-fd_funk_txn_publish( fd_funk_t *     funk,
-                     fd_funk_txn_t * txn,
-                     int             verbose ) {
+static ulong
+fd_funk_txn_publish_impl( fd_funk_t *     funk,
+                          fd_funk_txn_t * txn,
+                          fd_tpool_t *    tpool,
+                          ulong           t0,
+                          ulong           t1,
+                          ulong *         rec_cnt,
+                          int             verbose ) {
 
   if( FD_UNLIKELY( !funk ) ) {
     if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "NULL funk" ));
@@ -798,7 +1408,7 @@ fd_funk_txn_publish( fd_funk_t *     funk,
        each publish as txn and its siblings we potentially visited in a
        previous iteration of this loop. */
 
-    if( FD_UNLIKELY( fd_funk_txn_publish_funk_child( funk, map, txn_max, funk->cycle_tag++, txn_idx ) ) ) break;
+    if( FD_UNLIKELY( fd_funk_txn_publish_funk_child( funk, map, txn_max, funk->cycle_tag++, txn_idx, tpool, t0, t1, rec_cnt ) ) ) break;
     publish_cnt++;
 
     txn_idx = publish_stack_idx;
@@ -809,6 +1419,33 @@ fd_funk_txn_publish( fd_funk_t *     funk,
   return publish_cnt;
 }
 
+ulong
+fd_funk_txn_publish( fd_funk_t *     funk,
+                     fd_funk_txn_t * txn,
+                     int             verbose ) {
+  ulong rec_cnt = 0UL;
+  return fd_funk_txn_publish_impl( funk, txn, NULL, 0UL, 1UL, &rec_cnt, verbose );
+}
+
+ulong
+fd_funk_txn_publish_par( fd_funk_t *     funk,
+                         fd_funk_txn_t * txn,
+                         fd_tpool_t *    tpool,
+                         ulong           t0,
+                         ulong           t1,
+                         ulong *         opt_rec_cnt,
+                         int             verbose ) {
+  ulong rec_cnt = 0UL;
+  if( opt_rec_cnt ) *opt_rec_cnt = 0UL;
+  if( FD_UNLIKELY( (!!tpool) & (t0>=t1) ) ) {
+    if( FD_UNLIKELY( verbose ) ) FD_LOG_WARNING(( "bad thread range" ));
+    return 0UL;
+  }
+  ulong publish_cnt = fd_funk_txn_publish_impl( funk, txn, tpool, t0, t1, &rec_cnt, verbose );
+  if( opt_rec_cnt ) *opt_rec_cnt = rec_cnt;
+  return publish_cnt;
+}
+
 int
 fd_funk_txn_publish_into_parent( fd_funk_t *     funk,
                                  fd_funk_txn_t * txn,
@@ -835,7 +1472,7 @@ fd_funk_txn_publish_into_parent( fd_funk_t *     funk,
       FD_LOG_CRIT(( "memory corruption detected (cycle or bad idx)" ));
     fd_funk_txn_update( &funk->rec_head_idx, &funk->rec_tail_idx, FD_FUNK_TXN_IDX_NULL, fd_funk_root( funk ),
                         txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
-                        fd_funk_alloc( funk, wksp ), wksp );
+                        fd_funk_alloc( funk, wksp ), wksp, funk->seed );
     /* Inherit the children */
     funk->child_head_cidx = txn->child_head_cidx;
     funk->child_tail_cidx = txn->child_tail_cidx;
@@ -845,7 +1482,7 @@ fd_funk_txn_publish_into_parent( fd_funk_t *     funk,
       FD_LOG_CRIT(( "memory corruption detected (cycle or bad idx)" ));
     fd_funk_txn_update( &parent_txn->rec_head_idx, &parent_txn->rec_tail_idx, parent_idx, &parent_txn->xid,
                         txn_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
-                        fd_funk_alloc( funk, wksp ), wksp );
+                        fd_funk_alloc( funk, wksp ), wksp, funk->seed );
     /* Inherit the children */
     parent_txn->child_head_cidx = txn->child_head_cidx;
     parent_txn->child_tail_cidx = txn->child_tail_cidx;
@@ -897,7 +1534,7 @@ fd_funk_txn_merge_all_children( fd_funk_t *     funk,
 
     fd_funk_txn_update( &parent_txn->rec_head_idx, &parent_txn->rec_tail_idx, parent_idx, &parent_txn->xid,
                         child_idx, funk->rec_max, map, fd_funk_rec_map( funk, wksp ), fd_funk_get_partvec( funk, wksp ),
-                        fd_funk_alloc( funk, wksp ), wksp );
+                        fd_funk_alloc( funk, wksp ), wksp, funk->seed );
 
     child_idx = fd_funk_txn_idx( txn->sibling_next_cidx );
     fd_funk_txn_map_remove( map, fd_funk_txn_xid( txn ) );
@@ -999,6 +1636,13 @@ fd_funk_txn_verify( fd_funk_t * funk ) {
       ulong txn_idx = stack_idx;
       stack_idx = fd_funk_txn_idx( map[ txn_idx ].stack_cidx );
 
+      /* Make sure the key filter is well formed (its contents are
+         tested by fd_funk_rec_verify) */
+
+      ulong key_filter_word_cnt = map[ txn_idx ].key_filter_word_cnt;
+      TEST( !key_filter_word_cnt==!map[ txn_idx ].key_filter_gaddr );
+      TEST( !key_filter_word_cnt || (fd_ulong_is_pow2( key_filter_word_cnt ) & (key_filter_word_cnt>=FD_FUNK_TXN_KEY_FILTER_WORD_MIN)) );
+
       /* Push all children of txn to the stack */
 
       ulong child_idx = fd_funk_txn_idx( map[ txn_idx ].child_head_cidx );
@@ -13,7 +13,17 @@
    declarations. */
 
 #define FD_FUNK_TXN_ALIGN     (32UL)
-#define FD_FUNK_TXN_FOOTPRINT (96UL)
+#define FD_FUNK_TXN_FOOTPRINT (128UL)
+
+/* FD_FUNK_TXN_KEY_FILTER_WORD_MIN gives the number of 64-bit words in
+   a transaction's key filter when it is first allocated.  The filter
+   doubles whenever it holds more than FD_FUNK_TXN_KEY_FILTER_KEYS_PER_WORD
+   keys per word, so it always has at least 64/KEYS_PER_WORD bits per
+   key.  WORD_MIN must be a power of 2.  See fd_funk_txn_key_filter_test
+   for details. */
+
+#define FD_FUNK_TXN_KEY_FILTER_WORD_MIN      (8UL)
+#define FD_FUNK_TXN_KEY_FILTER_KEYS_PER_WORD (4UL)
 
 /* FD_FUNK_TXN_IDX_NULL gives the map transaction idx value used to
    represent NULL.  It also is the maximum value for txn_max in a funk
@@ -48,6 +58,10 @@ struct fd_funk_txn_private {
 
   ulong  rec_head_idx;      /* Record map index of the first record, FD_FUNK_REC_IDX_NULL if none (from oldest to youngest) */
   ulong  rec_tail_idx;      /* "                       last          " */
+
+  ulong  key_cnt;           /* Number of keys inserted into the key filter, see fd_funk_txn_key_filter_test */
+  ulong  key_filter_gaddr;  /* wksp gaddr of the key filter words, 0 if none */
+  ulong  key_filter_word_cnt; /* Number of words in the key filter, a power of 2, 0 if none */
 };
 
 typedef struct fd_funk_txn_private fd_funk_txn_t;
@@ -197,6 +211,85 @@ fd_funk_txn_is_only_child( fd_funk_txn_t const * txn ) {
 
 typedef struct fd_funk_rec fd_funk_rec_t;
 
+/* fd_funk_txn_key_filter_{clear,insert,test,free} manage the key
+   membership filter of an in-preparation transaction.  key_hash is
+   fd_funk_rec_key_hash( key, fd_funk_seed( funk ) ) for the record key
+   of interest.
+
+   Every key with a record in txn (including erase records) has been
+   inserted into txn's filter.  Thus, if fd_funk_txn_key_filter_test
+   returns 0, the key definitely has no record in txn and a query for it
+   can skip txn without probing the record map.  A return of 1 means the
+   key may have a record in txn (false positives are possible, e.g. the
+   record was since removed or other keys set the same bits).
+
+   This lets fd_funk_rec_query_global walk deep in-preparation ancestor
+   histories (e.g. during a long consensus stall) with a cheap filter
+   test per ancestor and O(1) expected record map probes instead of one
+   probe per ancestor.
+
+   The filter is a blocked bloom filter: a key sets 3 bits in a single
+   64-bit word, so a test is one load.  The words are allocated from
+   the funk's alloc on the first insert, and the filter is rebuilt from
+   txn's records at twice the size when it gets too full, so the false
+   positive rate stays around 1% no matter how many records txn has
+   (see FD_FUNK_TXN_KEY_FILTER_KEYS_PER_WORD).  If an allocation fails,
+   the filter keeps working at a higher false positive rate, or, if txn
+   has no filter at all, every test returns 1.
+
+   clear resets txn's filter to empty without freeing anything (used at
+   prepare).  insert inserts a key into txn's filter, growing it as
+   necessary.  rec_map is the funk's record map, used to find txn's
+   records if the filter needs to be rebuilt.  free frees txn's filter
+   (used when txn is removed from the txn map). */
+
+static inline void
+fd_funk_txn_key_filter_clear( fd_funk_txn_t * txn ) {
+  txn->key_cnt             = 0UL;
+  txn->key_filter_gaddr    = 0UL;
+  txn->key_filter_word_cnt = 0UL;
+}
+
+void
+fd_funk_txn_key_filter_insert( fd_funk_txn_t *       txn,
+                               ulong                 key_hash,
+                               fd_funk_rec_t const * rec_map,
+                               ulong                 seed,
+                               fd_alloc_t *          alloc,
+                               fd_wksp_t *           wksp );
+
+/* fd_funk_txn_key_filter_mask returns the bits key_hash sets in its
+   word of a key filter, and fd_funk_txn_key_filter_word_idx returns
+   the index of that word in a filter of word_cnt words.  These use
+   disjoint bits of key_hash. */
+
+FD_FN_CONST static inline ulong
+fd_funk_txn_key_filter_mask( ulong key_hash ) {
+  return (1UL << (key_hash & 63UL)) | (1UL << ((key_hash>>6) & 63UL)) | (1UL << ((key_hash>>12) & 63UL));
+}
+
+FD_FN_CONST static inline ulong
+fd_funk_txn_key_filter_word_idx( ulong key_hash,
+                                 ulong word_cnt ) {
+  return (key_hash>>32) & (word_cnt-1UL);
+}
+
+FD_FN_PURE static inline int
+fd_funk_txn_key_filter_test( fd_funk_txn_t const * txn,
+                             ulong                 key_hash,
+                             fd_wksp_t *           wksp ) {
+  if( FD_UNLIKELY( !txn->key_filter_word_cnt ) ) return !!txn->key_cnt;
+  ulong const * filter = (ulong const *)fd_wksp_laddr_fast( wksp, txn->key_filter_gaddr );
+  ulong         mask   = fd_funk_txn_key_filter_mask( key_hash );
+  return (filter[ fd_funk_txn_key_filter_word_idx( key_hash, txn->key_filter_word_cnt ) ] & mask)==mask;
+}
+
+void
+fd_funk_txn_key_filter_free( fd_funk_txn_t * txn,
+                             fd_alloc_t *    alloc,
+                             fd_wksp_t *     wksp );
+
+
 /* Return the first record in a transaction. Returns NULL if the
    transaction has no records yet. */
 
@@ -416,6 +509,36 @@ fd_funk_txn_publish( fd_funk_t *     funk,
                      fd_funk_txn_t * txn,
                      int             verbose );
 
+/* fd_funk_txn_publish_par is the same as fd_funk_txn_publish but
+   merges the records of each published transaction into the last
+   published transaction using tpool threads [t0,t1).  The result is
+   identical, except for the order of records within the record map's
+   hash chains.  The caller masquerades as thread t0 and threads
+   (t0,t1) should be idle.  The map chains are split among the threads
+   so each chain is only modified by one of them, and the map lookups,
+   map removes and inserts, value moves and value frees of the merge
+   are all done in parallel.  The caller only does the O(records)
+   bookkeeping for the record list, the map's free stack and
+   partitions.  Transactions with fewer than
+   FD_FUNK_TXN_PUBLISH_PAR_MIN records are merged serially since the
+   dispatch overhead would dominate.  The merge needs a scratch array of
+   80 bytes per record (plus O((t1-t0)^2)) from the funk's allocator and
+   falls back to a serial merge if that allocation fails.  If
+   opt_rec_cnt is non-NULL, *opt_rec_cnt is set to the number of records
+   merged.  tpool==NULL is equivalent to fd_funk_txn_publish.
+   Additional reasons for failure are tpool is non-NULL and t0>=t1. */
+
+#define FD_FUNK_TXN_PUBLISH_PAR_MIN (4096UL)
+
+ulong
+fd_funk_txn_publish_par( fd_funk_t *     funk,
+                         fd_funk_txn_t * txn,
+                         fd_tpool_t *    tpool,
+                         ulong           t0,
+                         ulong           t1,
+                         ulong *         opt_rec_cnt,
+                         int             verbose );
+
 /* This version of publish just combines the transaction with its
    immediate parent. Ancestors will remain unpublished. Any competing
    histories (siblings of the given transaction) are still cancelled.
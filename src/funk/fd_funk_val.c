@@ -1,7 +1,5 @@
 #include "fd_funk.h"
 
-#define FD_FUNK_VAL_ALIGN 8UL
-
 fd_funk_rec_t *
 fd_funk_val_copy( fd_funk_rec_t * rec,
                   void const *    data,
@@ -270,6 +268,40 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,
   return rec;
 }
 
+fd_funk_rec_t *
+fd_funk_val_install( fd_funk_rec_t * rec,
+                     void *          val,
+                     ulong           val_sz,
+                     fd_alloc_t *    alloc,
+                     fd_wksp_t *     wksp,
+                     int *           opt_err ) {
+
+  /* Check input args */
+
+  if( FD_UNLIKELY( (!rec) | (!val) | (!val_sz) | (val_sz>FD_FUNK_REC_VAL_MAX) | (!alloc) | (!wksp) ) || /* NULL rec,NULL val,bad sz,NULL alloc,NULL wksp */
+      FD_UNLIKELY( rec->flags & FD_FUNK_REC_FLAG_ERASE                                               ) || /* Marked erase */
+      FD_UNLIKELY( rec->val_max && fd_wksp_laddr_fast( wksp, rec->val_gaddr )==val                   ) ) { /* Already the value */
+    fd_int_store_if( !!opt_err, opt_err, FD_FUNK_ERR_INVAL );
+    return NULL;
+  }
+
+  ulong   val_gaddr   = rec->val_gaddr;
+  int     val_no_free = rec->val_no_free;
+  uchar * old_val     = val_gaddr ? fd_wksp_laddr_fast( wksp, val_gaddr ) : NULL;
+
+  /* Order of updates is important for fd_funk_val_safe.  val_max is
+     val_sz as the caller does not tell how big the allocation is. */
+  rec->val_gaddr   = fd_wksp_gaddr_fast( wksp, val );
+  rec->val_sz      = (uint)val_sz;
+  rec->val_max     = (uint)val_sz;
+  rec->val_no_free = 0;
+
+  if( old_val && !val_no_free ) fd_alloc_free( alloc, old_val ); /* Free the old value (if any) */
+
+  fd_int_store_if( !!opt_err, opt_err, FD_FUNK_SUCCESS );
+  return rec;
+}
+
 fd_funk_rec_t *
 fd_funk_val_speed_load( fd_funk_t *     funk,
                         fd_funk_rec_t * rec,        /* Assumed in caller's address space to a live funk record (NULL returns NULL) */
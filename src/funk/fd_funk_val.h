@@ -10,6 +10,10 @@
 
 #define FD_FUNK_REC_VAL_MAX UINT_MAX
 
+/* FD_FUNK_VAL_ALIGN is the alignment of record value allocations. */
+
+#define FD_FUNK_VAL_ALIGN 8UL
+
 FD_PROTOTYPES_BEGIN
 
 /* Accessors */
@@ -244,6 +248,38 @@ fd_funk_val_truncate( fd_funk_rec_t * rec,        /* Assumed in caller's address
                       fd_wksp_t *     wksp,       /* ==fd_funk_wksp( funk ) where funk is current local join */
                       int *           opt_err );  /* If non-NULL, *opt_err returns operation error code */
 
+/* fd_funk_val_install sets the value of rec to the val_sz bytes at val
+   without copying them.  val should be a pointer in the caller's
+   address space to an allocation from alloc (with alignment
+   FD_FUNK_VAL_ALIGN and at least val_sz bytes) that is not in use by
+   any other record.  On success, the record owns val (it will be freed
+   when the record value is next resized, flushed or the record is
+   removed) and the caller should not free it.  The previous value of
+   the record (if any) is freed, so this function should be assumed to
+   kill any existing pointers into this record's value storage.
+
+   This is meant for users that build a new value in an allocation of
+   their own and would otherwise copy it into the record with
+   fd_funk_val_truncate followed by a memcpy.
+
+   Returns rec on success and NULL on failure.  If opt_err is non-NULL,
+   on return, *opt_err will hold FD_FUNK_SUCCESS if successful or a
+   FD_FUNK_ERR_* code on failure.  Reasons for failure include
+   FD_FUNK_ERR_INVAL (NULL rec, NULL val, val_sz zero or too large, NULL
+   alloc, NULL wksp, rec is marked ERASE, val is the current value of
+   rec).  On failure, the current value is unchanged and the caller
+   retains ownership of val.
+
+   Assumes no concurrent operations on rec. */
+
+fd_funk_rec_t *                                /* Returns rec on success, NULL on failure */
+fd_funk_val_install( fd_funk_rec_t * rec,      /* Assumed in caller's address space to a live funk record (NULL returns NULL) */
+                     void *          val,      /* Allocation from alloc in caller's address space, NULL returns NULL */
+                     ulong           val_sz,   /* Should be in [1,FD_FUNK_REC_VAL_MAX] (returns NULL otherwise) */
+                     fd_alloc_t *    alloc,    /* ==fd_funk_alloc( funk, wksp ) */
+                     fd_wksp_t *     wksp,     /* ==fd_funk_wksp( funk ) where funk is current local join */
+                     int *           opt_err ); /* If non-NULL, *opt_err returns operation error code */
+
 /* fd_funk_val_speed_load sets the record value to space allocated
    from the funk speed bump. This space is never freed. This function
    is used when loading large snapshots.
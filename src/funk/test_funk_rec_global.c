@@ -0,0 +1,202 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+/* Tests that fd_funk_rec_query_global finds the same records as a
+   probe of every in-preparation ancestor and benchmarks the query
+   throughput of both at various fork depths and numbers of writes per
+   transaction.  Also measures the false positive rate of the key
+   filters. */
+
+static fd_funk_rec_key_t *
+key_set( fd_funk_rec_key_t * key,
+         ulong               i ) {
+  memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = i;
+  key->ul[1] = fd_ulong_hash( i );
+  return key;
+}
+
+static fd_funk_txn_xid_t *
+xid_set( fd_funk_txn_xid_t * xid,
+         ulong               i ) {
+  memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = i;
+  return xid;
+}
+
+/* query_ref is fd_funk_rec_query_global without the key filters (i.e.
+   probes the record map for every in-prep ancestor) */
+
+static fd_funk_rec_t const *
+query_ref( fd_funk_t *               funk,
+           fd_funk_txn_t const *     txn,
+           fd_funk_rec_key_t const * key ) {
+  fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, fd_funk_wksp( funk ) );
+  while( txn ) {
+    fd_funk_rec_t const * rec = fd_funk_rec_query( funk, txn, key );
+    if( rec ) return rec;
+    txn = fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map );
+  }
+  return fd_funk_rec_query( funk, NULL, key );
+}
+
+static void
+write( fd_funk_t *     funk,
+       fd_funk_txn_t * txn,
+       ulong           i,
+       ulong           val ) {
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  fd_funk_rec_key_t key[1];
+  fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key_set( key, i ), sizeof(ulong), 1, NULL, NULL );
+  FD_TEST( rec );
+  FD_TEST( fd_funk_val_copy( rec, &val, sizeof(ulong), 0UL, fd_funk_alloc( funk, wksp ), wksp, NULL ) );
+}
+
+/* fp_rate returns the fraction of the queries for keys in [0,key_cnt)
+   that txn and its in-prep ancestors don't have where the key filter
+   still says they might */
+
+static double
+fp_rate( fd_funk_t *           funk,
+         fd_funk_txn_t const * txn,
+         ulong                 key_cnt ) {
+  fd_wksp_t *     wksp    = fd_funk_wksp( funk );
+  fd_funk_txn_t * txn_map = fd_funk_txn_map( funk, wksp );
+  ulong fp_cnt = 0UL;
+  ulong neg_cnt = 0UL;
+  for( ; txn; txn=fd_funk_txn_parent( (fd_funk_txn_t *)txn, txn_map ) ) {
+    fd_funk_rec_key_t key[1];
+    for( ulong i=0UL; i<key_cnt; i++ ) {
+      if( fd_funk_rec_query( funk, txn, key_set( key, i ) ) ) continue;
+      neg_cnt++;
+      fp_cnt += (ulong)fd_funk_txn_key_filter_test( txn, fd_funk_rec_key_hash( key, fd_funk_seed( funk ) ), wksp );
+    }
+  }
+  return (double)fp_cnt / (double)fd_ulong_max( neg_cnt, 1UL );
+}
+
+/* check queries key_cnt keys from txn and checks the results match
+   query_ref */
+
+static void
+check( fd_funk_t *           funk,
+       fd_funk_txn_t const * txn,
+       ulong                 key_cnt ) {
+  fd_funk_rec_key_t key[1];
+  for( ulong i=0UL; i<key_cnt; i++ ) {
+    key_set( key, i );
+    FD_TEST( fd_funk_rec_query_global( funk, txn, key )==query_ref( funk, txn, key ) );
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",     NULL,      "gigantic" );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",    NULL,             1UL );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",    NULL, fd_log_cpu_id() );
+  ulong        wksp_tag  = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag",    NULL,          1234UL );
+  ulong        seed      = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",        NULL,          5678UL );
+  ulong        rec_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",     NULL,         65536UL );
+  ulong        query_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--query-cnt",   NULL,         65536UL );
+
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --seed %lu --rec-cnt %lu --query-cnt %lu",
+                  _page_sz, page_cnt, seed, rec_cnt, query_cnt ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)seed, 0UL ) );
+
+  /* Keys [0,rec_cnt) are in the last published transaction and each
+     in-prep transaction updates txn_rec random keys in
+     [0,key_cnt), so some queries hit an in-prep ancestor, some hit the
+     last published transaction and some miss.  The last cases have
+     about as many writes per transaction as busy mainnet slots. */
+
+  ulong key_cnt = rec_cnt + rec_cnt/4UL;
+
+  ulong depth_list  [5] = {    1UL,   32UL, 512UL,   32UL,    32UL };
+  ulong txn_rec_list[5] = {  256UL,  256UL, 256UL, 4096UL, 16384UL };
+
+  FD_LOG_NOTICE(( "depth\twrites/txn\tfiltered (Mq/s)\tunfiltered (Mq/s)\tfalse positives (%%)" ));
+  for( ulong j=0UL; j<5UL; j++ ) {
+    ulong depth   = depth_list  [ j ];
+    ulong txn_rec = txn_rec_list[ j ];
+    ulong txn_max = depth + 1UL;
+    ulong rec_max = rec_cnt + depth*txn_rec + 1024UL;
+
+    fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                  wksp_tag, seed, txn_max, rec_max ) );
+    FD_TEST( funk );
+    fd_funk_start_write( funk );
+
+    fd_funk_txn_xid_t xid[1];
+    fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid_set( xid, 1UL ), 1 ); FD_TEST( txn );
+    for( ulong i=0UL; i<rec_cnt; i++ ) write( funk, txn, i, i );
+    FD_TEST( fd_funk_txn_publish( funk, txn, 1 )==1UL );
+
+    txn = NULL;
+    for( ulong d=0UL; d<depth; d++ ) {
+      txn = fd_funk_txn_prepare( funk, txn, xid_set( xid, d+2UL ), 1 ); FD_TEST( txn );
+      for( ulong i=0UL; i<txn_rec; i++ ) write( funk, txn, fd_rng_ulong_roll( rng, key_cnt ), d );
+    }
+    FD_TEST( !fd_funk_verify( funk ) );
+    check( funk, txn, key_cnt );
+
+    fd_funk_rec_key_t * key = fd_wksp_alloc_laddr( wksp, alignof(fd_funk_rec_key_t), query_cnt*sizeof(fd_funk_rec_key_t), wksp_tag );
+    FD_TEST( key );
+    for( ulong i=0UL; i<query_cnt; i++ ) key_set( key + i, fd_rng_ulong_roll( rng, key_cnt ) );
+
+    ulong hit = 0UL;
+    long dt0 = -fd_log_wallclock();
+    for( ulong i=0UL; i<query_cnt; i++ ) hit += !!fd_funk_rec_query_global( funk, txn, key + i );
+    dt0 += fd_log_wallclock();
+
+    ulong hit_ref = 0UL;
+    long dt1 = -fd_log_wallclock();
+    for( ulong i=0UL; i<query_cnt; i++ ) hit_ref += !!query_ref( funk, txn, key + i );
+    dt1 += fd_log_wallclock();
+
+    FD_TEST( hit==hit_ref );
+    FD_LOG_NOTICE(( "%lu\t%lu\t%.3f\t%.3f\t%.2f", depth, txn_rec, 1e3*(double)query_cnt/(double)dt0,
+                    1e3*(double)query_cnt/(double)dt1, 100.*fp_rate( funk, txn, fd_ulong_min( key_cnt, 8192UL ) ) ));
+
+    /* Merging a transaction into its parent keeps its keys findable */
+
+    if( depth>1UL ) {
+      fd_funk_txn_t * parent = fd_funk_txn_parent( txn, fd_funk_txn_map( funk, wksp ) );
+      FD_TEST( !fd_funk_txn_publish_into_parent( funk, txn, 1 ) );
+      FD_TEST( !fd_funk_verify( funk ) );
+      check( funk, parent, key_cnt );
+    }
+
+    fd_wksp_free_laddr( key );
+    fd_funk_end_write( funk );
+    fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+    fd_wksp_tag_free( wksp, &wksp_tag, 1UL );
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -0,0 +1,256 @@
+#include "fd_funk.h"
+
+#if FD_HAS_HOSTED
+
+/* Tests that fd_funk_txn_publish_par gives the same result as
+   fd_funk_txn_publish and benchmarks the publish latency of both as a
+   function of the number of records published.  Run with --tile-cpus
+   to give the tpool workers. */
+
+static fd_funk_rec_key_t *
+key_set( fd_funk_rec_key_t * key,
+         ulong               i ) {
+  memset( key, 0, sizeof(fd_funk_rec_key_t) );
+  key->ul[0] = i;
+  key->ul[1] = fd_ulong_hash( i );
+  return key;
+}
+
+static fd_funk_txn_xid_t *
+xid_set( fd_funk_txn_xid_t * xid,
+         ulong               i ) {
+  memset( xid, 0, sizeof(fd_funk_txn_xid_t) );
+  xid->ul[0] = i;
+  return xid;
+}
+
+/* write sets key i to val in txn, copying the record from an ancestor
+   if needed */
+
+static void
+write( fd_funk_t *     funk,
+       fd_funk_txn_t * txn,
+       ulong           i,
+       ulong           val ) {
+  fd_wksp_t * wksp = fd_funk_wksp( funk );
+  fd_funk_rec_key_t key[1];
+  fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key_set( key, i ), sizeof(ulong), 1, NULL, NULL );
+  FD_TEST( rec );
+  FD_TEST( fd_funk_val_copy( rec, &val, sizeof(ulong), 0UL, fd_funk_alloc( funk, wksp ), wksp, NULL ) );
+}
+
+/* erase erases key i, which must exist in an ancestor of txn */
+
+static void
+erase( fd_funk_t *     funk,
+       fd_funk_txn_t * txn,
+       ulong           i ) {
+  fd_funk_rec_key_t key[1];
+  fd_funk_rec_t * rec = fd_funk_rec_write_prepare( funk, txn, key_set( key, i ), 0UL, 0, NULL, NULL );
+  FD_TEST( rec );
+  FD_TEST( !fd_funk_rec_remove( funk, rec, 1 ) );
+}
+
+/* build creates keys [0,rec_cnt) in the last published transaction,
+   then prepares a child that updates, erases and creates keys, and a
+   grandchild that does the same to the child.  Which keys are updated
+   depends only on seed, so calling build on two funks with the same
+   seed makes identical histories.  Returns the grandchild. */
+
+static fd_funk_txn_t *
+build( fd_funk_t * funk,
+       ulong       rec_cnt,
+       ulong       seed ) {
+  fd_funk_txn_xid_t xid[1];
+
+  fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid_set( xid, 1UL ), 1 ); FD_TEST( txn );
+  for( ulong i=0UL; i<rec_cnt; i++ ) write( funk, txn, i, i );
+  FD_TEST( fd_funk_txn_publish( funk, txn, 1 )==1UL );
+
+  fd_funk_txn_t * child = fd_funk_txn_prepare( funk, NULL, xid_set( xid, 2UL ), 1 ); FD_TEST( child );
+  for( ulong i=0UL; i<rec_cnt; i++ ) {
+    switch( fd_ulong_hash( i^seed )%6UL ) {
+    case 0UL: case 1UL: write( funk, child, i, i*seed+1UL ); break;
+    case 2UL:           erase( funk, child, i );             break;
+    default:                                                 break;
+    }
+  }
+  for( ulong i=rec_cnt; i<rec_cnt+rec_cnt/4UL; i++ ) write( funk, child, i, i );
+
+  fd_funk_txn_t * grandchild = fd_funk_txn_prepare( funk, child, xid_set( xid, 3UL ), 1 ); FD_TEST( grandchild );
+  for( ulong i=0UL; i<rec_cnt+rec_cnt/4UL; i++ ) {
+    ulong op = fd_ulong_hash( i^seed )%6UL;
+    if( op==2UL ) continue; /* erased in child */
+    switch( fd_ulong_hash( i+seed )%4UL ) {
+    case 0UL: write( funk, grandchild, i, i*seed+2UL ); break;
+    case 1UL: erase( funk, grandchild, i );             break;
+    default:                                            break;
+    }
+  }
+  return grandchild;
+}
+
+/* part_cb puts about 3 in 4 records in one of 4 partitions, so merges
+   move records into, out of and between partitions */
+
+static uint
+part_cb( fd_funk_rec_t * rec,
+         uint            num_part,
+         void *          cb_arg ) {
+  ulong h = fd_ulong_hash( rec->pair.key->ul[0] ^ rec->pair.xid->ul[0] ^ *(ulong *)cb_arg );
+  return (h%(num_part+1U))==num_part ? FD_FUNK_PART_NULL : (uint)(h%num_part);
+}
+
+/* Checks the last published records of a and b are the same, in the
+   same order */
+
+static void
+compare( fd_funk_t * a,
+         fd_funk_t * b ) {
+  fd_wksp_t *           wksp_a = fd_funk_wksp( a );
+  fd_wksp_t *           wksp_b = fd_funk_wksp( b );
+  fd_funk_rec_t const * map_a  = fd_funk_rec_map( a, wksp_a );
+  fd_funk_rec_t const * map_b  = fd_funk_rec_map( b, wksp_b );
+
+  fd_funk_rec_t const * rec_a = fd_funk_last_publish_rec_head( a, map_a );
+  fd_funk_rec_t const * rec_b = fd_funk_last_publish_rec_head( b, map_b );
+  ulong cnt = 0UL;
+  while( rec_a ) {
+    FD_TEST( rec_b );
+    FD_TEST( fd_funk_rec_key_eq( rec_a->pair.key, rec_b->pair.key ) );
+    FD_TEST( rec_a->flags==rec_b->flags );
+    FD_TEST( rec_a->part==rec_b->part );
+    FD_TEST( fd_funk_val_sz( rec_a )==fd_funk_val_sz( rec_b ) );
+    FD_TEST( !memcmp( fd_funk_val_const( rec_a, wksp_a ), fd_funk_val_const( rec_b, wksp_b ), fd_funk_val_sz( rec_a ) ) );
+    rec_a = fd_funk_rec_next( rec_a, map_a );
+    rec_b = fd_funk_rec_next( rec_b, map_b );
+    cnt++;
+  }
+  FD_TEST( !rec_b );
+  FD_TEST( cnt==fd_funk_rec_cnt( map_a ) );
+  FD_TEST( cnt==fd_funk_rec_cnt( map_b ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        wksp_tag = fd_env_strip_cmdline_ulong( &argc, &argv, "--wksp-tag",  NULL,          1234UL );
+  ulong        seed     = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",      NULL,          5678UL );
+  ulong        rec_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--rec-cnt",   NULL,         65536UL );
+  ulong        bench    = fd_env_strip_cmdline_ulong( &argc, &argv, "--bench-max", NULL,         65536UL );
+
+  ulong tile_cnt = fd_tile_cnt();
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --seed %lu --rec-cnt %lu --bench-max %lu, %lu tiles",
+                  _page_sz, page_cnt, seed, rec_cnt, bench, tile_cnt ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  static uchar tpool_mem[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  fd_tpool_t * tpool = fd_tpool_init( tpool_mem, tile_cnt ); FD_TEST( tpool );
+  for( ulong worker_idx=1UL; worker_idx<tile_cnt; worker_idx++ ) FD_TEST( fd_tpool_worker_push( tpool, worker_idx, NULL, 0UL ) );
+
+  ulong txn_max = 4UL;
+  ulong rec_max = 4UL*rec_cnt + 1024UL;
+
+  /* Publishing the same history serially and in parallel gives the
+     same result, both below and above FD_FUNK_TXN_PUBLISH_PAR_MIN. */
+
+  ulong test_cnt[2] = { FD_FUNK_TXN_PUBLISH_PAR_MIN/4UL, rec_cnt };
+  for( ulong j=0UL; j<2UL; j++ ) {
+    fd_funk_t * a = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                               wksp_tag,     seed, txn_max, rec_max ) );
+    fd_funk_t * b = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag+1UL ),
+                                               wksp_tag+1UL, seed, txn_max, rec_max ) );
+    FD_TEST( a && b );
+    fd_funk_start_write( a );
+    fd_funk_start_write( b );
+
+    fd_funk_txn_t * txn_a = build( a, test_cnt[ j ], seed );
+    fd_funk_txn_t * txn_b = build( b, test_cnt[ j ], seed );
+    fd_funk_repartition( a, 4U, part_cb, &seed );
+    fd_funk_repartition( b, 4U, part_cb, &seed );
+    FD_TEST( !fd_funk_verify( a ) );
+    FD_TEST( !fd_funk_verify( b ) );
+
+    /* Both the child and the grandchild are merged */
+
+    ulong merge_cnt = 0UL;
+    for( fd_funk_txn_t * txn=txn_a; txn; txn=fd_funk_txn_parent( txn, fd_funk_txn_map( a, fd_funk_wksp( a ) ) ) ) {
+      for( fd_funk_rec_t const * rec=fd_funk_txn_first_rec( a, txn ); rec; rec=fd_funk_txn_next_rec( a, rec ) ) merge_cnt++;
+    }
+
+    ulong rec_cnt_b;
+    FD_TEST( fd_funk_txn_publish    ( a, txn_a,                                    1 )==2UL );
+    FD_TEST( fd_funk_txn_publish_par( b, txn_b, tpool, 0UL, tile_cnt, &rec_cnt_b, 1 )==2UL );
+    FD_TEST( rec_cnt_b==merge_cnt );
+    FD_TEST( !fd_funk_verify( a ) );
+    FD_TEST( !fd_funk_verify( b ) );
+    compare( a, b );
+
+    fd_funk_end_write( a );
+    fd_funk_end_write( b );
+    fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( a ) ) );
+    fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( b ) ) );
+    fd_wksp_tag_free( wksp, &wksp_tag, 1UL );
+    ulong tag_b = wksp_tag+1UL; fd_wksp_tag_free( wksp, &tag_b, 1UL );
+  }
+
+  FD_TEST( !fd_funk_txn_publish_par( NULL, NULL, tpool, 0UL, tile_cnt, NULL, 0 ) ); /* NULL funk */
+
+  /* Publish latency of a transaction that updates cnt records in the
+     last published transaction, by cnt */
+
+  FD_LOG_NOTICE(( "records\tserial (us)\tparallel (us)\t(%lu threads)", tile_cnt ));
+  for( ulong cnt=1024UL; cnt<=bench; cnt<<=1 ) {
+    long dt[2];
+    for( ulong par=0UL; par<2UL; par++ ) {
+      fd_funk_t * funk = fd_funk_join( fd_funk_new( fd_wksp_alloc_laddr( wksp, fd_funk_align(), fd_funk_footprint(), wksp_tag ),
+                                                    wksp_tag, seed, txn_max, 2UL*cnt+1024UL ) );
+      FD_TEST( funk );
+      fd_funk_start_write( funk );
+
+      fd_funk_txn_xid_t xid[1];
+      fd_funk_txn_t * txn = fd_funk_txn_prepare( funk, NULL, xid_set( xid, 1UL ), 1 );
+      for( ulong i=0UL; i<cnt; i++ ) write( funk, txn, i, i );
+      FD_TEST( fd_funk_txn_publish( funk, txn, 1 )==1UL );
+      txn = fd_funk_txn_prepare( funk, NULL, xid_set( xid, 2UL ), 1 );
+      for( ulong i=0UL; i<cnt; i++ ) write( funk, txn, i, i+1UL );
+
+      dt[ par ] = -fd_log_wallclock();
+      FD_TEST( fd_funk_txn_publish_par( funk, txn, par ? tpool : NULL, 0UL, tile_cnt, NULL, 1 )==1UL );
+      dt[ par ] += fd_log_wallclock();
+
+      fd_funk_end_write( funk );
+      fd_wksp_free_laddr( fd_funk_delete( fd_funk_leave( funk ) ) );
+      fd_wksp_tag_free( wksp, &wksp_tag, 1UL );
+    }
+    FD_LOG_NOTICE(( "%lu\t%.1f\t%.1f", cnt, (double)dt[0]/1e3, (double)dt[1]/1e3 ));
+  }
+
+  for( ulong worker_idx=tile_cnt-1UL; worker_idx>0UL; worker_idx-- ) FD_TEST( fd_tpool_worker_pop( tpool ) );
+  fd_tpool_fini( tpool );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
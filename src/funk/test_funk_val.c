@@ -452,6 +452,25 @@ main( int     argc,
       FD_TEST( !fd_funk_val      ( mrec, wksp ) );
       TEST_TAIL_PADDING( 0UL );
 
+      /* install a value built outside the record */
+      ulong * inst = (ulong *)fd_alloc_malloc( alloc, FD_FUNK_VAL_ALIGN, sizeof(ulong) ); FD_TEST( inst );
+      *inst = bigval;
+      err = 1; FD_TEST( fd_funk_val_install( mrec, inst, sizeof(ulong), alloc, wksp, &err )==mrec && !err );
+      FD_TEST( fd_funk_val_sz   ( mrec       )==sizeof(ulong)        );
+      FD_TEST( fd_funk_val_max  ( mrec       )==sizeof(ulong)        );
+      FD_TEST( fd_funk_val_const( mrec, wksp )==(void const *)inst   );
+      FD_TEST( FD_LOAD( ulong, fd_funk_val( mrec, wksp ) )==bigval   );
+
+      /* install over an installed value, then flush it */
+      inst = (ulong *)fd_alloc_malloc( alloc, FD_FUNK_VAL_ALIGN, sizeof(ulong) ); FD_TEST( inst );
+      *inst = ~bigval;
+      FD_TEST( fd_funk_val_install( mrec, inst, sizeof(ulong), alloc, wksp, NULL )==mrec );
+      FD_TEST( fd_funk_val_const( mrec, wksp )==(void const *)inst   );
+      FD_TEST( FD_LOAD( ulong, fd_funk_val( mrec, wksp ) )==~bigval  );
+      FD_TEST( fd_funk_val_truncate( mrec, 0UL, alloc, wksp, NULL )==mrec );
+      FD_TEST( !fd_funk_val_sz( mrec ) );
+      TEST_TAIL_PADDING( 0UL );
+
       /* Prep for later iter ******************************************/
 
       FD_TEST( fd_funk_val_copy( mrec, &val, sizeof(uint), 0UL, alloc, wksp, NULL )==mrec );
@@ -505,6 +524,24 @@ main( int     argc,
       err = 1; FD_TEST( !fd_funk_val_truncate( mrec, 0UL,     NULL,  wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* NULL alloc */
       err = 1; FD_TEST( !fd_funk_val_truncate( mrec, 0UL,     alloc, NULL, &err ) && err==FD_FUNK_ERR_INVAL ); /* NULL wksp */
 
+      void * cur = fd_funk_val( mrec, wksp );
+      FD_TEST( !fd_funk_val_install( NULL, &val, sizeof(uint), alloc, wksp, NULL ) ); /* NULL rec */
+      FD_TEST( !fd_funk_val_install( mrec, NULL, sizeof(uint), alloc, wksp, NULL ) ); /* NULL val */
+      FD_TEST( !fd_funk_val_install( mrec, &val, 0UL,          alloc, wksp, NULL ) ); /* zero val sz */
+      FD_TEST( !fd_funk_val_install( mrec, &val, too_big,      alloc, wksp, NULL ) ); /* too big val sz */
+      FD_TEST( !fd_funk_val_install( mrec, &val, sizeof(uint), NULL,  wksp, NULL ) ); /* NULL alloc */
+      FD_TEST( !fd_funk_val_install( mrec, &val, sizeof(uint), alloc, NULL, NULL ) ); /* NULL wksp */
+      FD_TEST( !fd_funk_val_install( mrec, cur,  sizeof(uint), alloc, wksp, NULL ) ); /* already the value */
+
+      err = 1; FD_TEST( !fd_funk_val_install( NULL, &val, sizeof(uint), alloc, wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* NULL rec */
+      err = 1; FD_TEST( !fd_funk_val_install( mrec, NULL, sizeof(uint), alloc, wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* NULL val */
+      err = 1; FD_TEST( !fd_funk_val_install( mrec, &val, 0UL,          alloc, wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* zero val sz */
+      err = 1; FD_TEST( !fd_funk_val_install( mrec, &val, too_big,      alloc, wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* too big val sz */
+      err = 1; FD_TEST( !fd_funk_val_install( mrec, &val, sizeof(uint), NULL,  wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* NULL alloc */
+      err = 1; FD_TEST( !fd_funk_val_install( mrec, &val, sizeof(uint), alloc, NULL, &err ) && err==FD_FUNK_ERR_INVAL ); /* NULL wksp */
+      err = 1; FD_TEST( !fd_funk_val_install( mrec, cur,  sizeof(uint), alloc, wksp, &err ) && err==FD_FUNK_ERR_INVAL ); /* already the value */
+      FD_TEST( fd_funk_val( mrec, wksp )==cur );
+
     } else if( op>=18UL ) { /* Remove and insert at same rate */
 
       if( FD_UNLIKELY( !ref->rec_cnt ) ) continue;
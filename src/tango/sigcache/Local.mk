@@ -0,0 +1,5 @@
+$(call add-hdrs,fd_sigcache.h)
+$(call add-objs,fd_sigcache,fd_tango)
+$(call make-unit-test,test_sigcache,test_sigcache,fd_tango fd_util)
+$(call run-unit-test,test_sigcache)
+$(call make-unit-test,bench_sigcache,bench_sigcache,fd_tango fd_util)
@@ -0,0 +1,143 @@
+#include "../fd_tango.h"
+
+#if FD_HAS_HOSTED
+
+/* bench_sigcache measures the throughput of deduplicating a stream of
+   tags with fd_tcache (64-bit tags) and with fd_sigcache (128-bit tags,
+   one at a time and batched) at the same depth.  A fraction of the
+   stream, --dup-frac, are duplicates of recently inserted tags. */
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 1UL                          );
+  ulong        numa_idx = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        depth    = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",    NULL, 4194302UL                    );
+  ulong        op_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--op-cnt",   NULL, 1UL<<24                      );
+  float        dup_frac = fd_env_strip_cmdline_float( &argc, &argv, "--dup-frac", NULL, 0.1f                         );
+  ulong        batch    = fd_env_strip_cmdline_ulong( &argc, &argv, "--batch",    NULL, 32UL                         );
+
+  if( FD_UNLIKELY( !batch ) ) FD_LOG_ERR(( "--batch must be positive" ));
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp =
+    fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Generate the stream of tags up front so tag generation isn't
+     included in the timings. */
+
+  fd_sigcache_tag_t * tags = fd_wksp_alloc_laddr( wksp, alignof(fd_sigcache_tag_t), op_cnt*sizeof(fd_sigcache_tag_t), 1UL );
+  FD_TEST( tags );
+  uint dup_thresh = (uint)(0.5f + dup_frac*(float)(1UL<<32));
+  ulong exp_dup_cnt = 0UL;
+  for( ulong i=0UL; i<op_cnt; i++ ) {
+    if( i && fd_rng_uint( rng )<dup_thresh ) {
+      tags[ i ] = tags[ i - 1UL - fd_rng_ulong_roll( rng, fd_ulong_min( i, 1024UL ) ) ];
+    } else {
+      tags[ i ].lo = fd_rng_ulong( rng ) | 1UL; /* Never FD_TCACHE_TAG_NULL */
+      tags[ i ].hi = fd_rng_ulong( rng );
+    }
+  }
+
+  int * out = fd_wksp_alloc_laddr( wksp, alignof(int), batch*sizeof(int), 1UL ); FD_TEST( out );
+
+  FD_LOG_NOTICE(( "Benchmarking fd_tcache (--depth %lu, --op-cnt %lu, --dup-frac %e)", depth, op_cnt, (double)dup_frac ));
+
+  do {
+    ulong map_cnt = fd_tcache_map_cnt_default( depth );
+    void * mem = fd_wksp_alloc_laddr( wksp, fd_tcache_align(), fd_tcache_footprint( depth, map_cnt ), 1UL ); FD_TEST( mem );
+    fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( mem, depth, map_cnt ) ); FD_TEST( tcache );
+
+    ulong * _oldest = fd_tcache_oldest_laddr( tcache );
+    ulong * ring    = fd_tcache_ring_laddr  ( tcache );
+    ulong * map     = fd_tcache_map_laddr   ( tcache );
+    ulong   oldest  = *_oldest;
+
+    ulong dup_cnt = 0UL;
+    long dt = -fd_log_wallclock();
+    for( ulong i=0UL; i<op_cnt; i++ ) {
+      int dup;
+      FD_TCACHE_INSERT( dup, oldest, ring, depth, map, map_cnt, tags[ i ].lo );
+      dup_cnt += (ulong)dup;
+    }
+    dt += fd_log_wallclock();
+    *_oldest = oldest;
+    exp_dup_cnt = dup_cnt;
+
+    FD_LOG_NOTICE(( "fd_tcache:          %.3f Mops/s (dup_cnt %lu)", 1e3*(double)op_cnt/(double)dt, dup_cnt ));
+
+    fd_wksp_free_laddr( fd_tcache_delete( fd_tcache_leave( tcache ) ) );
+  } while(0);
+
+  ulong bucket_cnt = fd_sigcache_bucket_cnt_default( depth );
+  void * mem = fd_wksp_alloc_laddr( wksp, fd_sigcache_align(), fd_sigcache_footprint( bucket_cnt ), 1UL ); FD_TEST( mem );
+
+  FD_LOG_NOTICE(( "Benchmarking fd_sigcache (bucket_cnt %lu, --batch %lu)", bucket_cnt, batch ));
+
+  /* Use the op index as time with a TTL of depth so the expiration
+     policy is comparable to the tcache's. */
+
+  do {
+    fd_sigcache_t * cache = fd_sigcache_join( fd_sigcache_new( mem, bucket_cnt, fd_rng_ulong( rng ), (uint)depth ) ); FD_TEST( cache );
+
+    ulong dup_cnt = 0UL;
+    long dt = -fd_log_wallclock();
+    for( ulong i=0UL; i<op_cnt; i++ ) dup_cnt += (ulong)fd_sigcache_insert( cache, tags[ i ], (uint)i );
+    dt += fd_log_wallclock();
+
+    FD_LOG_NOTICE(( "fd_sigcache:        %.3f Mops/s (dup_cnt %lu)", 1e3*(double)op_cnt/(double)dt, dup_cnt ));
+    FD_TEST( dup_cnt==exp_dup_cnt );
+
+    fd_sigcache_delete( fd_sigcache_leave( cache ) );
+  } while(0);
+
+  do {
+    fd_sigcache_t * cache = fd_sigcache_join( fd_sigcache_new( mem, bucket_cnt, fd_rng_ulong( rng ), (uint)depth ) ); FD_TEST( cache );
+
+    ulong dup_cnt = 0UL;
+    long dt = -fd_log_wallclock();
+    for( ulong i=0UL; i<op_cnt; i+=batch ) {
+      ulong cnt = fd_ulong_min( batch, op_cnt-i );
+      fd_sigcache_insert_batch( cache, tags+i, cnt, (uint)i, out );
+      for( ulong j=0UL; j<cnt; j++ ) dup_cnt += (ulong)out[ j ];
+    }
+    dt += fd_log_wallclock();
+
+    FD_LOG_NOTICE(( "fd_sigcache batch:  %.3f Mops/s (dup_cnt %lu)", 1e3*(double)op_cnt/(double)dt, dup_cnt ));
+    FD_TEST( dup_cnt==exp_dup_cnt );
+
+    fd_sigcache_delete( fd_sigcache_leave( cache ) );
+  } while(0);
+
+  fd_wksp_free_laddr( mem  );
+  fd_wksp_free_laddr( out  );
+  fd_wksp_free_laddr( tags );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include "fd_sigcache.h"
+
+/* FD_SIGCACHE_PREFETCH_DIST is how many operations ahead the batch APIs
+   prefetch buckets. */
+
+#define FD_SIGCACHE_PREFETCH_DIST (8UL)
+
+ulong
+fd_sigcache_align( void ) {
+  return FD_SIGCACHE_ALIGN;
+}
+
+ulong
+fd_sigcache_footprint( ulong bucket_cnt ) {
+  if( FD_UNLIKELY( (!bucket_cnt) | (!fd_ulong_is_pow2( bucket_cnt )) ) ) return 0UL;
+  if( FD_UNLIKELY( bucket_cnt>((ULONG_MAX-2UL*FD_SIGCACHE_ALIGN)/sizeof(fd_sigcache_bucket_t)) ) ) return 0UL; /* overflow */
+  return FD_SIGCACHE_FOOTPRINT( bucket_cnt );
+}
+
+void *
+fd_sigcache_new( void * shmem,
+                 ulong  bucket_cnt,
+                 ulong  seed,
+                 uint   ttl ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_sigcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_sigcache_footprint( bucket_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad bucket_cnt (%lu)", bucket_cnt ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( (!ttl) | (ttl>FD_SIGCACHE_TTL_MAX) ) ) {
+    FD_LOG_WARNING(( "bad ttl (%u)", ttl ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_sigcache_t * cache = (fd_sigcache_t *)shmem;
+
+  cache->bucket_cnt = bucket_cnt;
+  cache->seed       = seed;
+  cache->ttl        = ttl;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_SIGCACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_sigcache_t *
+fd_sigcache_join( void * _cache ) {
+
+  if( FD_UNLIKELY( !_cache ) ) {
+    FD_LOG_WARNING(( "NULL _cache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_cache, fd_sigcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _cache" ));
+    return NULL;
+  }
+
+  fd_sigcache_t * cache = (fd_sigcache_t *)_cache;
+  if( FD_UNLIKELY( cache->magic!=FD_SIGCACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_sigcache_leave( fd_sigcache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+void *
+fd_sigcache_delete( void * _cache ) {
+
+  if( FD_UNLIKELY( !_cache ) ) {
+    FD_LOG_WARNING(( "NULL _cache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_cache, fd_sigcache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _cache" ));
+    return NULL;
+  }
+
+  fd_sigcache_t * cache = (fd_sigcache_t *)_cache;
+  if( FD_UNLIKELY( cache->magic!=FD_SIGCACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return _cache;
+}
+
+void
+fd_sigcache_query_batch( fd_sigcache_t const *     cache,
+                         fd_sigcache_tag_t const * tag,
+                         ulong                     cnt,
+                         uint                      now,
+                         int *                     out ) {
+  fd_sigcache_bucket_t const * buckets = fd_sigcache_private_buckets_const( cache );
+  ulong                        mask    = cache->bucket_cnt-1UL;
+  ulong                        seed    = cache->seed;
+  uint                         ttl     = cache->ttl;
+
+  ulong pre = fd_ulong_min( cnt, FD_SIGCACHE_PREFETCH_DIST );
+  for( ulong i=0UL; i<pre; i++ ) __builtin_prefetch( buckets + (fd_ulong_hash( tag[ i ].lo ^ seed ) & mask), 0 );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( FD_LIKELY( i+FD_SIGCACHE_PREFETCH_DIST<cnt ) ) {
+      __builtin_prefetch( buckets + (fd_ulong_hash( tag[ i+FD_SIGCACHE_PREFETCH_DIST ].lo ^ seed ) & mask), 0 );
+    }
+    fd_sigcache_bucket_t const * bucket = buckets + (fd_ulong_hash( tag[ i ].lo ^ seed ) & mask);
+    uint live;
+    out[ i ] = !!fd_sigcache_private_match( bucket, tag[ i ].lo, tag[ i ].hi, now, ttl, &live );
+  }
+}
+
+void
+fd_sigcache_insert_batch( fd_sigcache_t *           cache,
+                          fd_sigcache_tag_t const * tag,
+                          ulong                     cnt,
+                          uint                      now,
+                          int *                     out ) {
+  fd_sigcache_bucket_t * buckets = fd_sigcache_private_buckets( cache );
+  ulong                  mask    = cache->bucket_cnt-1UL;
+  ulong                  seed    = cache->seed;
+
+  ulong pre = fd_ulong_min( cnt, FD_SIGCACHE_PREFETCH_DIST );
+  for( ulong i=0UL; i<pre; i++ ) __builtin_prefetch( buckets + (fd_ulong_hash( tag[ i ].lo ^ seed ) & mask), 1 );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( FD_LIKELY( i+FD_SIGCACHE_PREFETCH_DIST<cnt ) ) {
+      __builtin_prefetch( buckets + (fd_ulong_hash( tag[ i+FD_SIGCACHE_PREFETCH_DIST ].lo ^ seed ) & mask), 1 );
+    }
+    out[ i ] = fd_sigcache_insert( cache, tag[ i ], now );
+  }
+}
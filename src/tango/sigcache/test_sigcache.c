@@ -0,0 +1,204 @@
+#include "../fd_tango.h"
+
+#if FD_HAS_HOSTED
+
+FD_STATIC_ASSERT( FD_SIGCACHE_ALIGN==128UL,               unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_BUCKET_WIDTH==8UL,          unit_test );
+FD_STATIC_ASSERT( sizeof(fd_sigcache_bucket_t)==128UL,    unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_FOOTPRINT(1UL)==256UL,      unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_FOOTPRINT(4UL)==640UL,      unit_test );
+FD_STATIC_ASSERT( FD_SIGCACHE_SPARSE_DEFAULT==1,          unit_test );
+
+#define BUCKET_CNT_MAX (1UL<<12)
+
+static uchar mem[ FD_SIGCACHE_FOOTPRINT( BUCKET_CNT_MAX ) ] __attribute__((aligned(FD_SIGCACHE_ALIGN)));
+
+static fd_sigcache_tag_t
+rand_tag( fd_rng_t * rng ) {
+  fd_sigcache_tag_t tag = { .lo = fd_rng_ulong( rng ), .hi = fd_rng_ulong( rng ) };
+  return tag;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_sigcache_align()==FD_SIGCACHE_ALIGN );
+  FD_TEST( !fd_sigcache_footprint( 0UL       ) );
+  FD_TEST( !fd_sigcache_footprint( 3UL       ) );
+  FD_TEST( !fd_sigcache_footprint( ULONG_MAX ) );
+  FD_TEST( !fd_sigcache_footprint( 1UL<<63   ) );
+  for( ulong lg=0UL; lg<20UL; lg++ ) FD_TEST( fd_sigcache_footprint( 1UL<<lg )==FD_SIGCACHE_FOOTPRINT( 1UL<<lg ) );
+
+  FD_TEST( fd_sigcache_bucket_cnt_default(       0UL )==     0UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default(       1UL )==     1UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default(       4UL )==     1UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default(       5UL )==     2UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default( 4194302UL )==1048576UL );
+  FD_TEST( fd_sigcache_bucket_cnt_default( ULONG_MAX )==     0UL );
+
+  FD_TEST( !fd_sigcache_new( NULL,      16UL, 0UL, 1U ) ); /* NULL shmem */
+  FD_TEST( !fd_sigcache_new( mem+1UL,   16UL, 0UL, 1U ) ); /* misaligned shmem */
+  FD_TEST( !fd_sigcache_new( mem,       15UL, 0UL, 1U ) ); /* bad bucket_cnt */
+  FD_TEST( !fd_sigcache_new( mem,       16UL, 0UL, 0U ) ); /* bad ttl */
+  FD_TEST( !fd_sigcache_new( mem,       16UL, 0UL, FD_SIGCACHE_TTL_MAX+1U ) ); /* bad ttl */
+  FD_TEST( !fd_sigcache_join( NULL    ) );
+  FD_TEST( !fd_sigcache_join( mem+1UL ) );
+
+  ulong seed = fd_rng_ulong( rng );
+
+  /* Single bucket cache, so every tag collides */
+
+  fd_sigcache_t * cache = fd_sigcache_join( fd_sigcache_new( mem, 1UL, seed, 100U ) ); FD_TEST( cache );
+  FD_TEST( fd_sigcache_bucket_cnt( cache )==1UL  );
+  FD_TEST( fd_sigcache_seed      ( cache )==seed );
+  FD_TEST( fd_sigcache_ttl       ( cache )==100U );
+
+  FD_LOG_NOTICE(( "Testing insert and query" ));
+
+  fd_sigcache_tag_t tags[ 16 ];
+  for( ulong i=0UL; i<16UL; i++ ) tags[ i ] = rand_tag( rng );
+
+  /* The zero tag is a valid tag */
+  fd_sigcache_tag_t zero = { .lo = 0UL, .hi = 0UL };
+  FD_TEST( !fd_sigcache_query ( cache, zero, 1U ) );
+  FD_TEST( !fd_sigcache_insert( cache, zero, 1U ) );
+  FD_TEST(  fd_sigcache_query ( cache, zero, 1U ) );
+  FD_TEST(  fd_sigcache_insert( cache, zero, 2U ) );
+
+  /* Tags that only differ in one half are distinct */
+  fd_sigcache_tag_t lo_only = { .lo = 0UL, .hi = 1UL };
+  fd_sigcache_tag_t hi_only = { .lo = 1UL, .hi = 0UL };
+  FD_TEST( !fd_sigcache_query( cache, lo_only, 1U ) );
+  FD_TEST( !fd_sigcache_query( cache, hi_only, 1U ) );
+
+  /* But only the low 32 bits of the high half are kept */
+  fd_sigcache_tag_t hi_hi = { .lo = 0UL, .hi = 1UL<<32 };
+  FD_TEST(  fd_sigcache_query( cache, hi_hi, 1U ) );
+
+  /* Expired tags are absent, and the dup above did not extend the
+     expiration of zero */
+  FD_TEST(  fd_sigcache_query( cache, zero, 100U ) );
+  FD_TEST( !fd_sigcache_query( cache, zero, 101U ) );
+  FD_TEST( !fd_sigcache_insert( cache, zero, 101U ) );
+  FD_TEST(  fd_sigcache_query( cache, zero, 150U ) );
+
+  FD_LOG_NOTICE(( "Testing eviction" ));
+
+  /* Fill the bucket with tags inserted at increasing times.  With zero
+     (expiring at 201) still live, the next 7 fill the bucket. */
+
+  for( uint i=0U; i<7U; i++ ) FD_TEST( !fd_sigcache_insert( cache, tags[ i ], 150U+i ) );
+  FD_TEST( fd_sigcache_query( cache, zero, 160U ) );
+  for( ulong i=0UL; i<7UL; i++ ) FD_TEST( fd_sigcache_query( cache, tags[ i ], 160U ) );
+
+  /* Inserting into the full bucket evicts the oldest */
+  FD_TEST( !fd_sigcache_insert( cache, tags[ 7 ], 160U ) );
+  FD_TEST( !fd_sigcache_query( cache, zero,      160U ) );
+  FD_TEST(  fd_sigcache_query( cache, tags[ 7 ], 160U ) );
+  FD_TEST( !fd_sigcache_insert( cache, tags[ 8 ], 160U ) );
+  FD_TEST( !fd_sigcache_query( cache, tags[ 0 ], 160U ) );
+  for( ulong i=1UL; i<9UL; i++ ) FD_TEST( fd_sigcache_query( cache, tags[ i ], 160U ) );
+
+  /* Once tags expire, their slots are reused before evicting */
+  FD_TEST( !fd_sigcache_insert( cache, tags[ 9 ], 253U ) ); /* tags 1,2,3 expired */
+  for( ulong i=4UL; i<10UL; i++ ) FD_TEST( fd_sigcache_query( cache, tags[ i ], 253U ) );
+  FD_TEST( !fd_sigcache_insert( cache, tags[ 10 ], 253U ) );
+  FD_TEST( !fd_sigcache_insert( cache, tags[ 11 ], 253U ) );
+  for( ulong i=4UL; i<12UL; i++ ) FD_TEST( fd_sigcache_query( cache, tags[ i ], 253U ) );
+
+  FD_LOG_NOTICE(( "Testing wraparound" ));
+
+  /* Time can wrap around while a tag is live */
+  FD_TEST( !fd_sigcache_insert( cache, tags[ 12 ], UINT_MAX-10U ) );
+  FD_TEST(  fd_sigcache_query( cache, tags[ 12 ], UINT_MAX ) );
+  FD_TEST(  fd_sigcache_query( cache, tags[ 12 ], 88U      ) );
+  FD_TEST( !fd_sigcache_query( cache, tags[ 12 ], 89U      ) );
+  FD_TEST( !fd_sigcache_query( cache, tags[ 12 ], UINT_MAX-11U ) );
+
+  /* The other tags expired long ago (they are not live again until
+     time 2^32+150 or so) */
+  for( ulong i=4UL; i<12UL; i++ ) FD_TEST( !fd_sigcache_query( cache, tags[ i ], 88U ) );
+
+  FD_TEST( fd_sigcache_leave( cache )==mem );
+  FD_TEST( fd_sigcache_delete( mem )==mem );
+  FD_TEST( !fd_sigcache_join( mem ) );
+
+  FD_LOG_NOTICE(( "Testing batch" ));
+
+  ulong bucket_cnt = BUCKET_CNT_MAX;
+  ulong depth      = bucket_cnt*FD_SIGCACHE_BUCKET_WIDTH >> FD_SIGCACHE_SPARSE_DEFAULT;
+  FD_TEST( fd_sigcache_bucket_cnt_default( depth )==bucket_cnt );
+
+  cache = fd_sigcache_join( fd_sigcache_new( mem, bucket_cnt, seed, 1000U ) ); FD_TEST( cache );
+
+# define BATCH_MAX (64UL)
+  fd_sigcache_tag_t batch[ BATCH_MAX ];
+  int               out  [ BATCH_MAX ];
+  int               out2 [ BATCH_MAX ];
+
+  for( ulong iter=0UL; iter<10000UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, BATCH_MAX+1UL );
+    for( ulong i=0UL; i<cnt; i++ ) batch[ i ] = rand_tag( rng );
+    /* Make some of them duplicates within the batch */
+    for( ulong i=1UL; i<cnt; i++ ) if( !fd_rng_uint_roll( rng, 8U ) ) batch[ i ] = batch[ fd_rng_ulong_roll( rng, i ) ];
+
+    uint now = (uint)(1UL+iter);
+    fd_sigcache_query_batch( cache, batch, cnt, now, out );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( out[ i ]==fd_sigcache_query( cache, batch[ i ], now ) );
+
+    fd_sigcache_insert_batch( cache, batch, cnt, now, out2 );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      int dup_in_batch = 0;
+      for( ulong j=0UL; j<i; j++ ) dup_in_batch |= (batch[ j ].lo==batch[ i ].lo) & (batch[ j ].hi==batch[ i ].hi);
+      FD_TEST( out2[ i ]==(out[ i ] | dup_in_batch) );
+    }
+    fd_sigcache_query_batch( cache, batch, cnt, now, out );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( out[ i ] );
+  }
+
+  FD_LOG_NOTICE(( "Testing capacity" ));
+
+  /* Insert 2*depth unique tags, each at a later time than the last so
+     that eviction removes the oldest tag in a bucket, and verify that
+     the most recent depth/4 are all still present.  A bucket would need
+     more than 8 of the most recent depth/4 tags (on average 1) to have
+     evicted one of them. */
+
+  FD_TEST( fd_sigcache_join( fd_sigcache_new( fd_sigcache_delete( fd_sigcache_leave( cache ) ), bucket_cnt, seed, FD_SIGCACHE_TTL_MAX ) )==cache );
+
+  uint now = 1U;
+  for( ulong i=0UL; i<2UL*depth; i++ ) FD_TEST( !fd_sigcache_insert( cache, rand_tag( rng ), now++ ) );
+  fd_rng_t _rng2[1];
+  fd_rng_t * rng2 = fd_rng_join( fd_rng_new( _rng2, 1U, 0UL ) );
+  for( ulong i=0UL; i<depth/4UL; i++ ) FD_TEST( !fd_sigcache_insert( cache, rand_tag( rng2 ), now++ ) );
+  fd_rng_delete( fd_rng_leave( rng2 ) );
+  rng2 = fd_rng_join( fd_rng_new( _rng2, 1U, 0UL ) );
+  for( ulong i=0UL; i<depth/4UL; i++ ) FD_TEST( fd_sigcache_query( cache, rand_tag( rng2 ), now ) );
+  fd_rng_delete( fd_rng_leave( rng2 ) );
+
+  FD_TEST( fd_sigcache_leave( cache )==mem );
+  FD_TEST( fd_sigcache_delete( mem )==mem );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
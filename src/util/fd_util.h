@@ -23,6 +23,7 @@
 #include "tpool/fd_tpool.h"         /* includes tile/fd_tile.h and scratch/fd_scratch.h */
 #include "alloc/fd_alloc.h"         /* includes wksp/fd_wksp.h */
 #include "sandbox/fd_sandbox.h"
+#include "log/fd_log_async.h"         /* includes log/fd_log.h */
 
 /* Additional fd_util APIs that are not included by default */
 
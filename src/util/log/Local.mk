@@ -1,4 +1,6 @@
-$(call add-hdrs,fd_log.h)
-$(call add-objs,fd_log,fd_util)
+$(call add-hdrs,fd_log.h fd_log_async.h)
+$(call add-objs,fd_log fd_log_async,fd_util)
 $(call make-unit-test,test_log,test_log,fd_util)
-
+$(call make-unit-test,test_log_async,test_log_async,fd_util)
+$(call run-unit-test,test_log_async)
+$(call make-unit-test,bench_log,bench_log,fd_util)
@@ -0,0 +1,115 @@
+#include "../fd_util.h"
+
+/* bench_log measures the latency of an FD_LOG_INFO call in a tight
+   loop, written synchronously and deferred to an fd_log_async ring.
+   For the synchronous numbers to include the write to the permanent
+   log, run with a --log-path (and --log-level-logfile INFO or lower).
+   If a second tile is available, it drains the ring concurrently,
+   otherwise the ring is drained inline between timed calls. */
+
+#define SORT_NAME  sort_lat
+#define SORT_KEY_T long
+#include "../tmpl/fd_sort.c"
+
+#define DEPTH (4096UL)
+
+static uchar mem[ FD_LOG_ASYNC_FOOTPRINT( DEPTH ) ] __attribute__((aligned(FD_LOG_ASYNC_ALIGN)));
+
+static int volatile drain_done;
+
+static int
+drain_main( int     argc,
+            char ** argv ) {
+  (void)argc;
+  fd_log_async_t * async = (fd_log_async_t *)argv;
+  while( !FD_VOLATILE_CONST( drain_done ) ) {
+    if( !fd_log_async_drain( async, ULONG_MAX ) ) FD_SPIN_PAUSE();
+  }
+  fd_log_async_drain( async, ULONG_MAX );
+  return 0;
+}
+
+/* tick_per_ns estimates the fd_tickcount rate against
+   fd_log_wallclock (fd_tempo lives above util). */
+
+static double
+tick_per_ns( void ) {
+  long w0 = fd_log_wallclock(); long t0 = fd_tickcount();
+  fd_log_sleep( (long)50e6 );
+  long w1 = fd_log_wallclock(); long t1 = fd_tickcount();
+  return (double)(t1-t0) / (double)(w1-w0);
+}
+
+static void
+report( char const * name,
+        long *       lat,
+        ulong        cnt,
+        double       ns_per_tick ) {
+  double sum = 0.;
+  for( ulong i=0UL; i<cnt; i++ ) sum += (double)lat[ i ];
+  sort_lat_inplace( lat, cnt );
+  FD_LOG_NOTICE(( "%-6s mean %8.1f ns  p50 %8.1f ns  p99 %8.1f ns  max %10.1f ns", name,
+                  ns_per_tick*sum/(double)cnt,
+                  ns_per_tick*(double)lat[ cnt/2UL ],
+                  ns_per_tick*(double)lat[ (cnt*99UL)/100UL ],
+                  ns_per_tick*(double)lat[ cnt-1UL ] ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong iter_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL, 100000UL );
+  if( FD_UNLIKELY( !iter_cnt ) ) FD_LOG_ERR(( "--iter-cnt must be positive" ));
+
+  long * lat = (long *)malloc( iter_cnt*sizeof(long) );
+  FD_TEST( lat );
+
+  double ns_per_tick = 1./tick_per_ns();
+
+  FD_LOG_NOTICE(( "Benchmarking %lu FD_LOG_INFO calls (log level %i, log file %s)",
+                  iter_cnt, fd_log_level_logfile(), fd_log_private_logfile_fd()==-1 ? "disabled" : "enabled" ));
+
+  /* Synchronous */
+
+  for( ulong i=0UL; i<iter_cnt; i++ ) {
+    long t0 = fd_tickcount();
+    FD_LOG_INFO(( "bench iter %lu of %lu, value %.3f, tag %s", i, iter_cnt, (double)i*0.5, "sync" ));
+    lat[ i ] = fd_tickcount() - t0;
+  }
+  report( "sync", lat, iter_cnt, ns_per_tick );
+
+  /* Deferred */
+
+  fd_log_async_t * async = fd_log_async_join( fd_log_async_new( mem, DEPTH, 1 ) );
+  FD_TEST( async );
+  fd_log_async_register( async );
+
+  fd_tile_exec_t * exec = NULL;
+  if( fd_tile_cnt()>1UL ) exec = fd_tile_exec_new( 1UL, drain_main, 0, (char **)async );
+
+  for( ulong i=0UL; i<iter_cnt; i++ ) {
+    long t0 = fd_tickcount();
+    FD_LOG_INFO(( "bench iter %lu of %lu, value %.3f, tag %s", i, iter_cnt, (double)i*0.5, "async" ));
+    lat[ i ] = fd_tickcount() - t0;
+    if( !exec && (i & (DEPTH/2UL-1UL))==DEPTH/2UL-1UL ) fd_log_async_drain( async, ULONG_MAX );
+  }
+
+  if( exec ) {
+    FD_VOLATILE( drain_done ) = 1;
+    fd_tile_exec_delete( exec, NULL );
+  } else {
+    fd_log_async_drain( async, ULONG_MAX );
+  }
+  fd_log_async_register( NULL );
+  report( "async", lat, iter_cnt, ns_per_tick );
+  FD_LOG_NOTICE(( "async dropped %lu messages", fd_log_async_drop_cnt( async ) ));
+
+  fd_log_async_delete( fd_log_async_leave( async ) );
+  free( lat );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -719,6 +719,22 @@ fd_log_private_1( int          level,
   char const * cpu    = fd_log_cpu();
   ulong        tid    = fd_log_tid();
 
+  fd_log_private_emit( level, now, file, line, func, msg, thread, cpu, tid );
+}
+
+void
+fd_log_private_emit( int          level,
+                     long         now,
+                     char const * file,
+                     int          line,
+                     char const * func,
+                     char const * msg,
+                     char const * thread,
+                     char const * cpu,
+                     ulong        tid ) {
+
+  if( level<fd_log_level_logfile() ) return;
+
   int log_fileno = FD_VOLATILE_CONST( fd_log_private_fileno );
   int to_logfile = (log_fileno!=-1);
   int to_stderr  = (level>=fd_log_level_stderr());
@@ -860,6 +876,8 @@ fd_log_private_2( int          level,
                   int          line,
                   char const * func,
                   char const * msg ) {
+  /* Write out the messages that led up to this one before exiting */
+  fd_log_private_async_flush();
   fd_log_private_1( level, now, file, line, func, msg );
 
 # if FD_LOG_UNCLEAN_EXIT
@@ -214,11 +214,20 @@
    This family of functions is not async-signal safe. Do not call log functions from
    a signal handler, it may deadlock or corrupt the log. If you wish to write
    emergency diagnostics, you can call `write(2)` directly to stderr or the log file,
-   which is safe. */
+   which is safe.
 
-#define FD_LOG_DEBUG(a)           do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_1( 0, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0           a ); } while(0)
-#define FD_LOG_INFO(a)            do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_1( 1, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0           a ); } while(0)
-#define FD_LOG_NOTICE(a)          do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_1( 2, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0           a ); } while(0)
+   If the calling thread has registered an fd_log_async ring (see
+   fd_log_async.h), DEBUG, INFO and NOTICE messages are not formatted
+   or written by the caller.  Instead, the format string and arguments
+   are appended to the ring in binary form and formatted later by
+   whoever drains it.  WARNING and above are always written
+   synchronously. */
+
+#define FD_LOG_PRIVATE_ARGS(...) __VA_ARGS__
+
+#define FD_LOG_DEBUG(a)           do { long _fd_log_msg_now = fd_log_wallclock(); if( FD_LIKELY( !fd_log_private_async_tl ) ) fd_log_private_1( 0, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0 a ); else fd_log_private_async_1( 0, _fd_log_msg_now, __FILE__, __LINE__, __func__, FD_LOG_PRIVATE_ARGS a ); } while(0)
+#define FD_LOG_INFO(a)            do { long _fd_log_msg_now = fd_log_wallclock(); if( FD_LIKELY( !fd_log_private_async_tl ) ) fd_log_private_1( 1, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0 a ); else fd_log_private_async_1( 1, _fd_log_msg_now, __FILE__, __LINE__, __func__, FD_LOG_PRIVATE_ARGS a ); } while(0)
+#define FD_LOG_NOTICE(a)          do { long _fd_log_msg_now = fd_log_wallclock(); if( FD_LIKELY( !fd_log_private_async_tl ) ) fd_log_private_1( 2, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0 a ); else fd_log_private_async_1( 2, _fd_log_msg_now, __FILE__, __LINE__, __func__, FD_LOG_PRIVATE_ARGS a ); } while(0)
 #define FD_LOG_WARNING(a)         do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_1( 3, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0           a ); } while(0)
 #define FD_LOG_ERR(a)             do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_2( 4, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0           a ); } while(0)
 #define FD_LOG_CRIT(a)            do { long _fd_log_msg_now = fd_log_wallclock(); fd_log_private_2( 5, _fd_log_msg_now, __FILE__, __LINE__, __func__, fd_log_private_0           a ); } while(0)
@@ -609,6 +618,41 @@ fd_log_private_2( int          level,
                   char const * func,
                   char const * msg ) __attribute__((noreturn)); /* Let compiler know this will not be returning */
 
+/* fd_log_private_emit is fd_log_private_1 on behalf of another thread,
+   identified by thread, cpu and tid.  Used to write out messages
+   deferred by fd_log_async. */
+
+void
+fd_log_private_emit( int          level,
+                     long         now,
+                     char const * file,
+                     int          line,
+                     char const * func,
+                     char const * msg,
+                     char const * thread,
+                     char const * cpu,
+                     ulong        tid );
+
+/* fd_log_private_async_tl is the async log ring registered by the
+   calling thread, NULL if none.  fd_log_private_async_1 appends a
+   message to it.  fd_log_private_async_flush writes out whatever the
+   calling thread still has in its ring and stops deferring its
+   messages, used before it logs a fatal error.  All are defined in
+   fd_log_async.c. */
+
+extern FD_TL struct fd_log_async_private * fd_log_private_async_tl;
+
+void
+fd_log_private_async_1( int          level,
+                        long         now,
+                        char const * file,
+                        int          line,
+                        char const * func,
+                        char const * fmt, ... ) __attribute__((format(printf,6,7))); /* Type check the fmt string at compile time */
+
+void
+fd_log_private_async_flush( void );
+
 void
 fd_log_private_raw_2( char const * file,
                       int          line,
@@ -0,0 +1,493 @@
+#include "fd_log_async.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+
+FD_STATIC_ASSERT( sizeof(fd_log_async_rec_t)==256UL, layout );
+FD_STATIC_ASSERT( sizeof(fd_log_async_t)<=512UL,     layout );
+
+FD_TL fd_log_async_t * fd_log_private_async_tl;
+
+/* Bounds of the executable image, provided by the linker.  Pointers
+   into the image are stored as offsets from its start, which is the
+   same in every process running the executable. */
+
+extern char __executable_start[];
+extern char _end[];
+
+static inline int
+fd_log_async_in_image( char const * s ) {
+  return ((ulong)s>=(ulong)__executable_start) & ((ulong)s<(ulong)_end);
+}
+
+static inline long         fd_log_async_off( char const * s ) { return (long)((ulong)s - (ulong)__executable_start); }
+static inline char const * fd_log_async_ptr( long off       ) { return (char const *)((ulong)__executable_start + (ulong)off); }
+
+void *
+fd_log_async_new( void * shmem,
+                  ulong  depth,
+                  int    enabled ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_log_async_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_log_async_footprint( depth ) ) ) {
+    FD_LOG_WARNING(( "bad depth (%lu)", depth ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, fd_log_async_footprint( depth ) );
+
+  fd_log_async_t * async = (fd_log_async_t *)shmem;
+  async->depth   = depth;
+  async->enabled = !!enabled;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( async->magic ) = FD_LOG_ASYNC_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_log_async_t *
+fd_log_async_join( void * shasync ) {
+
+  if( FD_UNLIKELY( !shasync ) ) {
+    FD_LOG_WARNING(( "NULL shasync" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shasync, fd_log_async_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shasync" ));
+    return NULL;
+  }
+
+  fd_log_async_t * async = (fd_log_async_t *)shasync;
+  if( FD_UNLIKELY( async->magic!=FD_LOG_ASYNC_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return async;
+}
+
+void *
+fd_log_async_leave( fd_log_async_t * async ) {
+
+  if( FD_UNLIKELY( !async ) ) {
+    FD_LOG_WARNING(( "NULL async" ));
+    return NULL;
+  }
+
+  return (void *)async;
+}
+
+void *
+fd_log_async_delete( void * shasync ) {
+
+  if( FD_UNLIKELY( !shasync ) ) {
+    FD_LOG_WARNING(( "NULL shasync" ));
+    return NULL;
+  }
+
+  fd_log_async_t * async = (fd_log_async_t *)shasync;
+  if( FD_UNLIKELY( async->magic!=FD_LOG_ASYNC_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( async->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shasync;
+}
+
+void
+fd_log_async_register( fd_log_async_t * async ) {
+  if( FD_UNLIKELY( !async || !async->enabled ) ) {
+    fd_log_private_async_tl = NULL;
+    return;
+  }
+
+  async->tid = fd_log_tid();
+  fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( async->thread ), fd_log_thread(), FD_LOG_NAME_MAX-1UL ) );
+  fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( async->cpu    ), fd_log_cpu(),    FD_LOG_NAME_MAX-1UL ) );
+  fd_log_private_async_tl = async;
+}
+
+/* The caller is about to exit, so it drains its own ring rather than
+   leave the messages leading up to the error for a drainer that might
+   never get to them.  If a drainer is running concurrently, a few
+   records might be written twice, which is preferable to losing them. */
+
+void
+fd_log_private_async_flush( void ) {
+  fd_log_async_t * async = fd_log_private_async_tl;
+  if( FD_LIKELY( !async ) ) return;
+  fd_log_private_async_tl = NULL;
+  fd_log_async_drain( async, ULONG_MAX );
+}
+
+/* Format conversion parsing.  fd_log_async_spec_t describes one
+   conversion in a printf format string.  The producer and the drainer
+   walk the format string with the same parser, so they agree on what
+   is in the record. */
+
+#define FD_LOG_ASYNC_TYPE_INT  (0) /* signed integer, stored as a long */
+#define FD_LOG_ASYNC_TYPE_UINT (1) /* unsigned integer, stored as a ulong */
+#define FD_LOG_ASYNC_TYPE_CHAR (2) /* %c, stored as a long */
+#define FD_LOG_ASYNC_TYPE_DBL  (3) /* floating point, stored as a double */
+#define FD_LOG_ASYNC_TYPE_STR  (4) /* %s, stored inline and '\0' terminated */
+#define FD_LOG_ASYNC_TYPE_PTR  (5) /* %p, stored as a ulong */
+#define FD_LOG_ASYNC_TYPE_BAD  (6) /* unsupported conversion */
+
+#define FD_LOG_ASYNC_LEN_HH   (0)
+#define FD_LOG_ASYNC_LEN_H    (1)
+#define FD_LOG_ASYNC_LEN_NONE (2)
+#define FD_LOG_ASYNC_LEN_LONG (3) /* l, ll, j, z, t: all 64-bit here */
+#define FD_LOG_ASYNC_LEN_LDBL (4)
+
+typedef struct {
+  char const * start;    /* the '%' */
+  char const * end;      /* one past the conversion character */
+  char const * len_pos;  /* first length modifier character (or the conversion if none) */
+  int          star_cnt; /* number of '*' in the width and precision */
+  int          prec_star;/* 1 if the precision is given by the last '*' argument */
+  long         prec;     /* literal precision, -1 if none (or given by '*') */
+  int          len;      /* one of FD_LOG_ASYNC_LEN_* */
+  int          type;     /* one of FD_LOG_ASYNC_TYPE_* */
+} fd_log_async_spec_t;
+
+/* fd_log_async_next finds the next conversion in the format string at
+   p.  Returns 0 if there is none, and skips over any "%%". */
+
+static int
+fd_log_async_next( char const *          p,
+                   fd_log_async_spec_t * spec ) {
+  for(;;) {
+    p = strchr( p, '%' );
+    if( !p ) return 0;
+    if( p[1]!='%' ) break;
+    p += 2;
+  }
+
+  spec->start     = p++;
+  spec->star_cnt  = 0;
+  spec->prec_star = 0;
+  spec->prec      = -1L;
+
+  while( *p=='-' || *p=='+' || *p==' ' || *p=='#' || *p=='0' || *p=='\'' ) p++;
+  if( *p=='*' ) { spec->star_cnt++; p++; } else while( *p>='0' && *p<='9' ) p++;
+  if( *p=='.' ) {
+    p++;
+    if( *p=='*' ) { spec->star_cnt++; spec->prec_star = 1; p++; }
+    else {
+      spec->prec = 0L;
+      while( *p>='0' && *p<='9' ) { spec->prec = fd_long_min( spec->prec*10L + (long)(*p-'0'), (long)INT_MAX ); p++; }
+    }
+  }
+
+  spec->len_pos = p;
+  switch( *p ) {
+  case 'h': if( p[1]=='h' ) { spec->len = FD_LOG_ASYNC_LEN_HH; p += 2; } else { spec->len = FD_LOG_ASYNC_LEN_H; p++; } break;
+  case 'l': spec->len = FD_LOG_ASYNC_LEN_LONG; p += (p[1]=='l') ? 2 : 1; break;
+  case 'j': case 'z': case 't': spec->len = FD_LOG_ASYNC_LEN_LONG; p++; break;
+  case 'L': spec->len = FD_LOG_ASYNC_LEN_LDBL; p++; break;
+  default:  spec->len = FD_LOG_ASYNC_LEN_NONE; break;
+  }
+
+  switch( *p ) {
+  case 'd': case 'i':                     spec->type = FD_LOG_ASYNC_TYPE_INT;  break;
+  case 'u': case 'o': case 'x': case 'X': spec->type = FD_LOG_ASYNC_TYPE_UINT; break;
+  case 'c':                               spec->type = FD_LOG_ASYNC_TYPE_CHAR; break;
+  case 'e': case 'E': case 'f': case 'F':
+  case 'g': case 'G': case 'a': case 'A': spec->type = FD_LOG_ASYNC_TYPE_DBL;  break;
+  case 's':                               spec->type = FD_LOG_ASYNC_TYPE_STR;  break;
+  case 'p':                               spec->type = FD_LOG_ASYNC_TYPE_PTR;  break;
+  default:                                spec->type = FD_LOG_ASYNC_TYPE_BAD;  break;
+  }
+  if( FD_LIKELY( *p ) ) p++;
+  spec->end = p;
+
+  /* Length modifiers that do not apply to the conversion, and wide
+     characters, are not supported */
+  if( FD_UNLIKELY( spec->len==FD_LOG_ASYNC_LEN_LDBL && spec->type!=FD_LOG_ASYNC_TYPE_DBL ) )
+    spec->type = FD_LOG_ASYNC_TYPE_BAD;
+  if( FD_UNLIKELY( (spec->type==FD_LOG_ASYNC_TYPE_CHAR || spec->type==FD_LOG_ASYNC_TYPE_STR) && spec->len!=FD_LOG_ASYNC_LEN_NONE ) )
+    spec->type = FD_LOG_ASYNC_TYPE_BAD;
+  return 1;
+}
+
+/* fd_log_async_encode encodes the arguments for fmt into rec.  Returns
+   0 on success and -1 if fmt has a conversion that cannot be
+   deferred. */
+
+static int
+fd_log_async_encode( fd_log_async_rec_t * rec,
+                     char const *         fmt,
+                     va_list              ap ) {
+  uchar * arg     = rec->arg;
+  ulong   arg_sz  = 0UL;
+  int     trunc   = 0;
+
+# define ENCODE_8( v ) do {                                                    \
+    ulong _v = (v);                                                            \
+    if( FD_LIKELY( arg_sz+8UL<=FD_LOG_ASYNC_ARG_MAX ) ) {                      \
+      FD_STORE( ulong, arg+arg_sz, _v ); arg_sz += 8UL;                        \
+    } else trunc = 1;                                                          \
+  } while(0)
+
+  fd_log_async_spec_t spec[1];
+  for( char const * p=fmt; fd_log_async_next( p, spec ); p=spec->end ) {
+    if( FD_UNLIKELY( spec->type==FD_LOG_ASYNC_TYPE_BAD ) ) return -1;
+
+    /* A negative '*' precision is as if there were none */
+    long prec = spec->prec;
+    for( int i=0; i<spec->star_cnt; i++ ) {
+      int v = va_arg( ap, int );
+      if( spec->prec_star & (i==spec->star_cnt-1) ) prec = (long)v;
+      ENCODE_8( (ulong)(long)v );
+    }
+
+    switch( spec->type ) {
+    case FD_LOG_ASYNC_TYPE_INT: {
+      long v;
+      switch( spec->len ) {
+      case FD_LOG_ASYNC_LEN_HH:   v = (long)(schar)va_arg( ap, int ); break;
+      case FD_LOG_ASYNC_LEN_H:    v = (long)(short)va_arg( ap, int ); break;
+      case FD_LOG_ASYNC_LEN_NONE: v = (long)va_arg( ap, int );        break;
+      default:                    v = va_arg( ap, long );             break;
+      }
+      ENCODE_8( (ulong)v );
+      break;
+    }
+    case FD_LOG_ASYNC_TYPE_UINT: {
+      ulong v;
+      switch( spec->len ) {
+      case FD_LOG_ASYNC_LEN_HH:   v = (ulong)(uchar) va_arg( ap, uint ); break;
+      case FD_LOG_ASYNC_LEN_H:    v = (ulong)(ushort)va_arg( ap, uint ); break;
+      case FD_LOG_ASYNC_LEN_NONE: v = (ulong)va_arg( ap, uint );         break;
+      default:                    v = va_arg( ap, ulong );               break;
+      }
+      ENCODE_8( v );
+      break;
+    }
+    case FD_LOG_ASYNC_TYPE_CHAR:
+      ENCODE_8( (ulong)(long)va_arg( ap, int ) );
+      break;
+    case FD_LOG_ASYNC_TYPE_DBL: {
+      double v = spec->len==FD_LOG_ASYNC_LEN_LDBL ? (double)va_arg( ap, long double ) : va_arg( ap, double );
+      ulong  u; memcpy( &u, &v, sizeof(ulong) );
+      ENCODE_8( u );
+      break;
+    }
+    case FD_LOG_ASYNC_TYPE_PTR:
+      ENCODE_8( (ulong)va_arg( ap, void * ) );
+      break;
+    case FD_LOG_ASYNC_TYPE_STR: {
+      char const * s = va_arg( ap, char const * );
+      if( FD_UNLIKELY( !s ) ) s = "(null)";
+      if( FD_UNLIKELY( arg_sz>=FD_LOG_ASYNC_ARG_MAX ) ) { trunc = 1; break; }
+      /* s need not be '\0' terminated if there is a precision, so do
+         not look past it */
+      ulong room = FD_LOG_ASYNC_ARG_MAX - arg_sz - 1UL;
+      ulong max  = prec<0L ? room+1UL : fd_ulong_min( (ulong)prec, room+1UL );
+      ulong len  = strnlen( s, max );
+      if( FD_UNLIKELY( len>room ) ) { len = room; trunc = 1; }
+      memcpy( arg+arg_sz, s, len );
+      arg[ arg_sz+len ] = '\0';
+      arg_sz += len+1UL;
+      break;
+    }
+    default: break;
+    }
+  }
+
+# undef ENCODE_8
+
+  rec->arg_sz    = (uint)arg_sz;
+  rec->truncated = trunc;
+  return 0;
+}
+
+void
+fd_log_private_async_1( int          level,
+                        long         now,
+                        char const * file,
+                        int          line,
+                        char const * func,
+                        char const * fmt, ... ) {
+
+  /* Same filtering as fd_log_private_1, done here so that messages
+     nobody will see do not take space in the ring */
+
+  if( level<fd_log_level_logfile() ) return;
+  if( (level<fd_log_level_stderr()) & (fd_log_private_logfile_fd()==-1) ) return;
+
+  fd_log_async_t * async = fd_log_private_async_tl;
+
+  va_list ap;
+  va_start( ap, fmt );
+
+  if( FD_UNLIKELY( !(fd_log_async_in_image( fmt ) & fd_log_async_in_image( file ) & fd_log_async_in_image( func )) ) ) goto sync;
+
+  ulong seq = async->seq;
+  if( FD_UNLIKELY( seq-FD_VOLATILE_CONST( async->drain_seq )>=async->depth ) ) {
+    async->drop_cnt++;
+    va_end( ap );
+    return;
+  }
+
+  fd_log_async_rec_t * rec = fd_log_async_ring( async ) + (seq & (async->depth-1UL));
+  if( FD_UNLIKELY( fd_log_async_encode( rec, fmt, ap ) ) ) goto sync;
+  rec->now   = now;
+  rec->file  = fd_log_async_off( file );
+  rec->func  = fd_log_async_off( func );
+  rec->fmt   = fd_log_async_off( fmt  );
+  rec->line  = line;
+  rec->level = level;
+  va_end( ap );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( async->seq ) = seq+1UL;
+  return;
+
+sync:
+  va_end( ap );
+  va_start( ap, fmt );
+  char msg[ 4096 ];
+  int len = vsnprintf( msg, sizeof(msg), fmt, ap );
+  (void)len;
+  va_end( ap );
+  fd_log_private_1( level, now, file, line, func, msg );
+}
+
+char *
+fd_log_async_render( fd_log_async_rec_t const * rec,
+                     char *                     buf,
+                     ulong                      buf_sz ) {
+  char const *  fmt    = fd_log_async_ptr( rec->fmt );
+  uchar const * arg    = rec->arg;
+  ulong         arg_sz = fd_ulong_min( (ulong)rec->arg_sz, FD_LOG_ASYNC_ARG_MAX );
+  ulong         off    = 0UL;
+  char *        out    = buf;
+  ulong         rem    = buf_sz;
+
+  /* Appends n bytes (or as many as fit) */
+# define APPEND( src, n ) do {                                                 \
+    ulong _n = fd_ulong_min( (ulong)(n), rem-1UL );                            \
+    memcpy( out, (src), _n ); out += _n; rem -= _n;                            \
+  } while(0)
+
+  char const * p       = fmt;
+  int          stopped = 0;
+  fd_log_async_spec_t spec[1];
+  while( fd_log_async_next( p, spec ) ) {
+    /* Literal text before the conversion, with "%%" unescaped */
+    for( char const * q=p; q<spec->start; q++ ) {
+      if( FD_UNLIKELY( q[0]=='%' && q[1]=='%' ) ) q++;
+      APPEND( q, 1UL );
+    }
+    p = spec->end;
+
+    /* Pull the arguments out of the record.  Stop at the first one
+       that did not fit. */
+    int   star[ 2 ];
+    ulong need = 8UL*(ulong)spec->star_cnt + (spec->type==FD_LOG_ASYNC_TYPE_STR ? 1UL : 8UL);
+    if( FD_UNLIKELY( off+need>arg_sz ) ) { stopped = 1; break; }
+    for( int i=0; i<spec->star_cnt; i++ ) { star[ i ] = (int)FD_LOAD( long, arg+off ); off += 8UL; }
+
+    /* Rebuild the conversion with a length modifier matching how the
+       argument was stored */
+    char  conv[ 64 ];
+    ulong conv_len = fd_ulong_min( (ulong)(spec->len_pos - spec->start), sizeof(conv)-4UL );
+    memcpy( conv, spec->start, conv_len );
+    if( spec->type==FD_LOG_ASYNC_TYPE_INT || spec->type==FD_LOG_ASYNC_TYPE_UINT ) conv[ conv_len++ ] = 'l';
+    conv[ conv_len++ ] = spec->end[ -1 ];
+    conv[ conv_len   ] = '\0';
+
+    int n = 0;
+#   define FMT( v ) do {                                                        \
+      switch( spec->star_cnt ) {                                               \
+      case 0:  n = snprintf( out, rem, conv,                     (v) ); break; \
+      case 1:  n = snprintf( out, rem, conv, star[0],            (v) ); break; \
+      default: n = snprintf( out, rem, conv, star[0], star[1],   (v) ); break; \
+      }                                                                        \
+    } while(0)
+
+    switch( spec->type ) {
+    case FD_LOG_ASYNC_TYPE_INT:  FMT( FD_LOAD( long,  arg+off ) );                   off += 8UL; break;
+    case FD_LOG_ASYNC_TYPE_UINT: FMT( FD_LOAD( ulong, arg+off ) );                   off += 8UL; break;
+    case FD_LOG_ASYNC_TYPE_CHAR: FMT( (int)FD_LOAD( long, arg+off ) );               off += 8UL; break;
+    case FD_LOG_ASYNC_TYPE_DBL:  FMT( FD_LOAD( double, arg+off ) );                  off += 8UL; break;
+    case FD_LOG_ASYNC_TYPE_PTR:  FMT( (void *)FD_LOAD( ulong, arg+off ) );           off += 8UL; break;
+    case FD_LOG_ASYNC_TYPE_STR: {
+      char const * s = (char const *)(arg+off);
+      FMT( s );
+      off += strnlen( s, arg_sz-off-1UL )+1UL;
+      break;
+    }
+    default: break;
+    }
+#   undef FMT
+
+    if( FD_UNLIKELY( n<0 ) ) n = 0;
+    ulong adv = fd_ulong_min( (ulong)n, rem-1UL );
+    out += adv; rem -= adv;
+  }
+
+  if( FD_LIKELY( !stopped ) ) {
+    for( char const * q=p; *q; q++ ) {
+      if( FD_UNLIKELY( q[0]=='%' && q[1]=='%' ) ) q++;
+      APPEND( q, 1UL );
+    }
+  }
+  if( FD_UNLIKELY( rec->truncated ) ) APPEND( "...", 3UL );
+
+# undef APPEND
+
+  *out = '\0';
+  return buf;
+}
+
+ulong
+fd_log_async_drain( fd_log_async_t * async,
+                    ulong            max ) {
+  ulong                      depth = async->depth;
+  fd_log_async_rec_t const * ring  = fd_log_async_ring_const( async );
+
+  ulong drop_cnt = FD_VOLATILE_CONST( async->drop_cnt );
+  ulong seq      = FD_VOLATILE_CONST( async->seq );
+  FD_COMPILER_MFENCE();
+
+  ulong drain_seq = async->drain_seq;
+  ulong cnt       = fd_ulong_min( seq-drain_seq, max );
+
+  char msg[ 1024 ];
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_log_async_rec_t const * rec = ring + ((drain_seq+i) & (depth-1UL));
+    fd_log_async_render( rec, msg, sizeof(msg) );
+    fd_log_private_emit( rec->level, rec->now, fd_log_async_ptr( rec->file ), rec->line, fd_log_async_ptr( rec->func ),
+                         msg, async->thread, async->cpu, async->tid );
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( async->drain_seq ) = drain_seq+cnt;
+
+  if( FD_UNLIKELY( drop_cnt!=async->drop_seen ) ) {
+    char tmp[ 128 ];
+    snprintf( tmp, sizeof(tmp), "async log ring full, dropped %lu messages", drop_cnt-async->drop_seen );
+    fd_log_private_emit( 3, fd_log_wallclock(), __FILE__, __LINE__, __func__, tmp, async->thread, async->cpu, async->tid );
+    async->drop_seen = drop_cnt;
+  }
+
+  return cnt;
+}
@@ -0,0 +1,152 @@
+#ifndef HEADER_fd_src_util_log_fd_log_async_h
+#define HEADER_fd_src_util_log_fd_log_async_h
+
+/* fd_log_async defers the formatting and writing of low priority log
+   messages away from latency sensitive threads.  A thread registers a
+   ring, which is a single producer ring of fixed size records typically
+   in shared memory.  While registered, FD_LOG_{DEBUG,INFO,NOTICE} on
+   that thread append a binary record (the format string, the arguments
+   and a timestamp) to the ring instead of calling vsnprintf and
+   write(2).  Some other thread or process periodically calls
+   fd_log_async_drain, which formats the records and writes them to the
+   log on behalf of the producer as though it had logged them itself.
+
+   The producer never blocks.  If the ring is full the message is
+   dropped and counted, and the next drain logs how many were lost.
+
+   Format strings and the file and function names are stored as offsets
+   into the executable image, not copied, so the drainer must be running
+   the same executable as the producer (it need not share the address
+   space, eg. a tile draining the rings of tiles in other processes).
+   Messages with a format string outside the executable image are
+   written synchronously.  String arguments are copied into the record
+   and truncated if they do not fit.  %n is not supported.
+
+   Because WARNING and above are still written synchronously, they can
+   appear in the log ahead of lower priority messages from the same
+   thread that were logged earlier but not drained yet.  Messages still
+   in the ring when the producer dies are written if the ring is
+   drained afterward. */
+
+#include "fd_log.h"
+
+/* FD_LOG_ASYNC_DEPTH_DEFAULT is the default number of records in a
+   ring. */
+
+#define FD_LOG_ASYNC_DEPTH_DEFAULT (1024UL)
+
+/* FD_LOG_ASYNC_ARG_MAX is the number of bytes of encoded arguments that
+   fit in a record.  Scalars take 8 bytes and strings their length plus
+   one. */
+
+#define FD_LOG_ASYNC_ARG_MAX (208UL)
+
+#define FD_LOG_ASYNC_ALIGN (128UL)
+#define FD_LOG_ASYNC_FOOTPRINT( depth ) (512UL + (depth)*sizeof(fd_log_async_rec_t))
+
+#define FD_LOG_ASYNC_MAGIC (0xf17eda2c37a5c000UL) /* firedancer async log ver 0 */
+
+/* fd_log_async_rec_t is one deferred message.  file, func and fmt are
+   offsets of the cstrs from the start of the executable image. */
+
+struct fd_log_async_rec {
+  long  now;       /* fd_log_wallclock() when the message was logged */
+  long  file;
+  long  func;
+  long  fmt;
+  int   line;
+  int   level;
+  uint  arg_sz;    /* bytes of arg in use */
+  int   truncated; /* non-zero if the arguments did not all fit */
+  uchar arg[ FD_LOG_ASYNC_ARG_MAX ];
+};
+
+typedef struct fd_log_async_rec fd_log_async_rec_t;
+
+struct __attribute__((aligned(FD_LOG_ASYNC_ALIGN))) fd_log_async_private {
+  ulong magic;     /* ==FD_LOG_ASYNC_MAGIC */
+  ulong depth;     /* number of records in the ring, a power of 2 */
+  int   enabled;   /* if zero, registering the ring does nothing */
+
+  /* Identity of the producer, set by fd_log_async_register */
+  ulong tid;
+  char  thread[ FD_LOG_NAME_MAX ];
+  char  cpu   [ FD_LOG_NAME_MAX ];
+
+  /* Written by the producer */
+  __attribute__((aligned(128UL))) ulong seq; /* number of records ever written */
+  ulong drop_cnt;                            /* number of messages dropped because the ring was full */
+
+  /* Written by the consumer */
+  __attribute__((aligned(128UL))) ulong drain_seq; /* number of records ever drained */
+  ulong drop_seen;                                 /* drop_cnt as of the last drain */
+
+  /* depth fd_log_async_rec_t follow at offset 512 */
+};
+
+typedef struct fd_log_async_private fd_log_async_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong fd_log_async_align    ( void        ) { return FD_LOG_ASYNC_ALIGN; }
+FD_FN_CONST static inline ulong fd_log_async_footprint( ulong depth ) { return fd_ulong_is_pow2( depth ) ? FD_LOG_ASYNC_FOOTPRINT( depth ) : 0UL; }
+
+/* fd_log_async_new formats shmem as a ring with depth records.  depth
+   must be a power of 2.  If enabled is zero, fd_log_async_register
+   will leave the thread logging synchronously, so a ring can always be
+   provisioned and deferred logging turned on by configuration.
+   Returns shmem on success and NULL on failure (logs details). */
+
+void *
+fd_log_async_new( void * shmem,
+                  ulong  depth,
+                  int    enabled );
+
+fd_log_async_t * fd_log_async_join  ( void *           shasync );
+void *           fd_log_async_leave ( fd_log_async_t * async   );
+void *           fd_log_async_delete( void *           shasync );
+
+FD_FN_CONST static inline fd_log_async_rec_t *
+fd_log_async_ring( fd_log_async_t * async ) {
+  return (fd_log_async_rec_t *)((ulong)async + 512UL);
+}
+
+FD_FN_CONST static inline fd_log_async_rec_t const *
+fd_log_async_ring_const( fd_log_async_t const * async ) {
+  return (fd_log_async_rec_t const *)((ulong)async + 512UL);
+}
+
+/* fd_log_async_drop_cnt returns the number of messages the producer
+   has dropped because the ring was full. */
+
+FD_FN_PURE static inline ulong fd_log_async_drop_cnt( fd_log_async_t const * async ) { return FD_VOLATILE_CONST( async->drop_cnt ); }
+
+/* fd_log_async_register makes the calling thread the producer of
+   async, and defers its DEBUG, INFO and NOTICE messages to it.  A
+   thread can only have one ring, and a ring only one producer.  If
+   async is NULL or not enabled, the thread logs synchronously. */
+
+void
+fd_log_async_register( fd_log_async_t * async );
+
+/* fd_log_async_render formats rec into the cstr buf of buf_sz bytes
+   (buf_sz>0), truncating if necessary.  Returns buf. */
+
+char *
+fd_log_async_render( fd_log_async_rec_t const * rec,
+                     char *                     buf,
+                     ulong                      buf_sz );
+
+/* fd_log_async_drain writes out up to max of the oldest records in
+   async, as if the producer had logged them.  Also logs a warning if
+   the producer dropped messages since the last drain.  Returns the
+   number of records written.  Only one thread may drain a ring, but it
+   need not be the same one each time. */
+
+ulong
+fd_log_async_drain( fd_log_async_t * async,
+                    ulong            max );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_util_log_fd_log_async_h */
@@ -0,0 +1,160 @@
+#include "../fd_util.h"
+
+#include <stdio.h>  /* snprintf */
+#include <stdint.h> /* intmax_t */
+
+FD_STATIC_ASSERT( sizeof(fd_log_async_rec_t)==256UL,                   unit_test );
+FD_STATIC_ASSERT( FD_LOG_ASYNC_FOOTPRINT( 8UL )==512UL+8UL*256UL,      unit_test );
+FD_STATIC_ASSERT( offsetof(fd_log_async_t, seq      )==128UL,          unit_test );
+FD_STATIC_ASSERT( offsetof(fd_log_async_t, drain_seq)==256UL,          unit_test );
+
+#define DEPTH (16UL)
+
+static uchar mem[ FD_LOG_ASYNC_FOOTPRINT( DEPTH ) ] __attribute__((aligned(FD_LOG_ASYNC_ALIGN)));
+
+/* check_rec tests that the i-th record in the ring renders to the
+   expected cstr */
+
+static void
+check_rec( fd_log_async_t * async,
+           ulong            i,
+           char const *     expected ) {
+  char buf[ 1024 ];
+  fd_log_async_rec_t const * rec = fd_log_async_ring_const( async ) + (i & (async->depth-1UL));
+  fd_log_async_render( rec, buf, sizeof(buf) );
+  if( FD_UNLIKELY( strcmp( buf, expected ) ) ) FD_LOG_ERR(( "record %lu: got \"%s\", expected \"%s\"", i, buf, expected ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  int level_logfile = fd_log_level_logfile();
+  int level_stderr  = fd_log_level_stderr();
+  fd_log_level_logfile_set( 2 );
+  fd_log_level_stderr_set ( 2 );
+
+  FD_TEST( !fd_log_async_footprint( 0UL   ) );
+  FD_TEST( !fd_log_async_footprint( 3UL   ) );
+  FD_TEST(  fd_log_async_footprint( DEPTH )==FD_LOG_ASYNC_FOOTPRINT( DEPTH ) );
+
+  FD_TEST( !fd_log_async_new( NULL,    DEPTH, 1 ) );
+  FD_TEST( !fd_log_async_new( mem+1UL, DEPTH, 1 ) );
+  FD_TEST( !fd_log_async_new( mem,     15UL,  1 ) );
+
+  /* Disabled */
+
+  fd_log_async_t * async = fd_log_async_join( fd_log_async_new( mem, DEPTH, 0 ) ); FD_TEST( async );
+  fd_log_async_register( async );
+  FD_TEST( !fd_log_private_async_tl );
+  FD_LOG_NOTICE(( "synchronous" ));
+  FD_TEST( !async->seq );
+  FD_TEST( fd_log_async_delete( fd_log_async_leave( async ) )==mem );
+  FD_TEST( !fd_log_async_join( mem ) );
+
+  /* Formatting */
+
+  async = fd_log_async_join( fd_log_async_new( mem, DEPTH, 1 ) ); FD_TEST( async );
+  fd_log_async_register( async );
+  FD_TEST( fd_log_private_async_tl==async );
+
+  char transient[ 16 ]; strcpy( transient, "transient" );
+  FD_LOG_NOTICE(( "no arguments, 100%% literal" ));
+  FD_LOG_NOTICE(( "ints %d %i %u %x %X %o %5d|%-5d|%05d", -1, 2, 3U, 0xabU, 0xcdU, 8U, 42, 42, 42 ));
+  FD_LOG_NOTICE(( "widths %hhd %hhu %hd %hu %ld %lu %lld %llu %zu %jd %td", (schar)-1, (uchar)255, (short)-2, (ushort)65535,
+                  LONG_MIN, ULONG_MAX, -3LL, 4ULL, (size_t)5, (intmax_t)-6, (ptrdiff_t)7 ));
+  FD_LOG_NOTICE(( "floats %f %.3e %g %10.2f %Lf", 1.5, 12345.678, 0.0001, -3.14159, (long double)2.5 ));
+  FD_LOG_NOTICE(( "strings %s %.3s %10s|%-10s| %s %c", "hello", "abcdef", "right", "left", transient, 'z' ));
+  FD_LOG_NOTICE(( "stars %*d|%-*d|%.*f|%*.*s|", 6, 1, 6, 2, 2, 3.14159, 6, 2, "xyz" ));
+  FD_LOG_NOTICE(( "pointer %p", (void *)0x1234UL ));
+
+  /* Strings are copied at log time */
+  strcpy( transient, "clobbered" );
+
+  FD_TEST( async->seq==7UL );
+  check_rec( async, 0UL, "no arguments, 100% literal" );
+  check_rec( async, 1UL, "ints -1 2 3 ab CD 10    42|42   |00042" );
+  char expected[ 256 ];
+  snprintf( expected, sizeof(expected), "widths -1 255 -2 65535 %ld %lu -3 4 5 -6 7", LONG_MIN, ULONG_MAX );
+  check_rec( async, 2UL, expected );
+  snprintf( expected, sizeof(expected), "floats %f %.3e %g %10.2f %Lf", 1.5, 12345.678, 0.0001, -3.14159, (long double)2.5 );
+  check_rec( async, 3UL, expected );
+  check_rec( async, 4UL, "strings hello abc      right|left      | transient z" );
+  check_rec( async, 5UL, "stars      1|2     |3.14|    xy|" );
+  snprintf( expected, sizeof(expected), "pointer %p", (void *)0x1234UL );
+  check_rec( async, 6UL, expected );
+
+  FD_TEST( fd_log_async_drain( async, 3UL )==3UL );
+  FD_TEST( async->drain_seq==3UL );
+  FD_TEST( fd_log_async_drain( async, ULONG_MAX )==4UL );
+  FD_TEST( async->drain_seq==7UL );
+  FD_TEST( !fd_log_async_drain( async, ULONG_MAX ) );
+
+  /* Arguments that do not fit */
+
+  char big[ 512 ];
+  memset( big, 'a', sizeof(big)-1UL ); big[ sizeof(big)-1UL ] = '\0';
+  FD_LOG_NOTICE(( "big %s %d", big, 5 ));
+  fd_log_async_rec_t const * rec = fd_log_async_ring_const( async ) + 7UL;
+  FD_TEST( rec->truncated && rec->arg_sz==FD_LOG_ASYNC_ARG_MAX );
+  char buf[ 1024 ];
+  fd_log_async_render( rec, buf, sizeof(buf) );
+  FD_TEST( strlen( buf )==4UL+(FD_LOG_ASYNC_ARG_MAX-1UL)+1UL+3UL ); /* "big ", the string, " ", "..." */
+  FD_TEST( !strcmp( buf+strlen( buf )-3UL, "..." ) );
+
+  /* Small output buffer */
+  fd_log_async_render( fd_log_async_ring_const( async ) + 1UL, buf, 8UL );
+  FD_TEST( !strcmp( buf, "ints -1" ) );
+
+  /* Format strings outside the executable image are written
+     synchronously */
+  char fmt[ 16 ]; strcpy( fmt, "stack %d" );
+  FD_LOG_NOTICE(( fmt, 1 ));
+  FD_TEST( async->seq==8UL );
+
+  /* Filtered by level */
+  FD_LOG_INFO(( "filtered" ));
+  FD_TEST( async->seq==8UL );
+
+  /* Overflow drops and counts */
+
+  FD_TEST( fd_log_async_drain( async, ULONG_MAX )==1UL );
+  for( ulong i=0UL; i<DEPTH+5UL; i++ ) FD_LOG_NOTICE(( "overflow %lu", i ));
+  FD_TEST( async->seq==8UL+DEPTH );
+  FD_TEST( fd_log_async_drop_cnt( async )==5UL );
+  FD_TEST( fd_log_async_drain( async, ULONG_MAX )==DEPTH );
+  FD_TEST( async->drop_seen==5UL );
+  FD_LOG_NOTICE(( "after drain" ));
+  FD_TEST( async->seq==9UL+DEPTH );
+  FD_TEST( fd_log_async_drain( async, ULONG_MAX )==1UL );
+
+  /* Strings with a precision need not be '\0' terminated */
+
+  char unterminated[ 4 ] = { 'a', 'b', 'c', 'd' };
+  FD_LOG_NOTICE(( "precision %.*s|%.2s|%.*s|%.0s|", 4, unterminated, unterminated, -1, "negative", unterminated ));
+  rec = fd_log_async_ring_const( async ) + ((9UL+DEPTH) & (DEPTH-1UL));
+  FD_TEST( !rec->truncated && rec->arg_sz==8UL+5UL+3UL+8UL+9UL+1UL );
+  check_rec( async, 9UL+DEPTH, "precision abcd|ab|negative||" );
+
+  /* Flushing writes out the pending records and goes back to logging
+     synchronously */
+
+  FD_LOG_NOTICE(( "pending" ));
+  fd_log_private_async_flush();
+  FD_TEST( !fd_log_private_async_tl );
+  FD_TEST( async->drain_seq==11UL+DEPTH );
+  FD_LOG_NOTICE(( "synchronous" ));
+  FD_TEST( async->seq==11UL+DEPTH );
+
+  fd_log_async_register( NULL );
+  FD_TEST( !fd_log_private_async_tl );
+  fd_log_async_delete( fd_log_async_leave( async ) );
+
+  fd_log_level_logfile_set( level_logfile );
+  fd_log_level_stderr_set ( level_stderr  );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -1,5 +1,5 @@
 $(call add-hdrs,fd_wksp.h)
-$(call add-objs,fd_wksp_admin fd_wksp_user fd_wksp_helper fd_wksp_used_treap fd_wksp_free_treap fd_wksp_io,fd_util)
+$(call add-objs,fd_wksp_admin fd_wksp_user fd_wksp_helper fd_wksp_used_treap fd_wksp_free_treap fd_wksp_io fd_wksp_io_frame,fd_util)
 $(call make-bin,fd_wksp_ctl,fd_wksp_ctl,fd_util) # Just a stub on HAS_HOSTED
 
 ifdef FD_HAS_HOSTED # This tests need fd_shmem API support currently only available on hosted targets
@@ -15,6 +15,8 @@ $(call run-unit-test,test_wksp_user)
 $(call make-unit-test,test_wksp_helper,test_wksp_helper,fd_util)
 $(call make-unit-test,test_wksp,test_wksp,fd_util)
 $(call run-unit-test,test_wksp)
+$(call make-unit-test,test_wksp_checkpt_frame,test_wksp_checkpt_frame,fd_util)
+$(call run-unit-test,test_wksp_checkpt_frame)
 $(call add-test-scripts,test_wksp_ctl)
 
 endif
@@ -145,11 +145,26 @@
            by the used workspace partitions.  No compression or
            hashing is done of the workspace partitions.
 
+     FRAME - the stream will have the same workspace metadata followed
+           by the used workspace partitions split into independent
+           frames of at most FD_WKSP_CHECKPT_FRAME_SZ_MAX bytes and an
+           index of the frames.  Frames can be written and read in
+           parallel, are individually hashed and, if built with zstd
+           support, individually compressed.  A FRAME checkpt can be
+           incremental (i.e. only hold the frames that differ from a
+           previous full FRAME checkpt).
+
      DEFAULT - the style to use when not specified by user. */
 
 #define FD_WKSP_CHECKPT_STYLE_RAW     (1)
+#define FD_WKSP_CHECKPT_STYLE_FRAME   (2)
 #define FD_WKSP_CHECKPT_STYLE_DEFAULT FD_WKSP_CHECKPT_STYLE_RAW
 
+/* FD_WKSP_CHECKPT_FRAME_SZ_MAX is the maximum number of workspace bytes
+   in a FRAME style checkpt frame. */
+
+#define FD_WKSP_CHECKPT_FRAME_SZ_MAX (8UL<<20)
+
 /* A fd_wksp_t * is an opaque handle of a workspace */
 
 struct fd_wksp_private;
@@ -987,6 +1002,37 @@ fd_wksp_checkpt( fd_wksp_t *  wksp,
                  int          style,
                  char const * uinfo );
 
+/* Forward declaration (see util/tpool/fd_tpool.h) */
+
+struct fd_tpool_private;
+typedef struct fd_tpool_private fd_tpool_t;
+
+/* fd_wksp_checkpt_tpool is the same as fd_wksp_checkpt but, for FRAME
+   style checkpts, the frames are hashed, compressed and written by tpool
+   threads [t0,t1) in parallel.  tpool NULL writes the checkpt with the
+   caller only.  The caller is assumed to be thread t0 and threads
+   (t0,t1) are assumed to be idle.
+
+   If base is non-NULL, base should be the path of a full (i.e. not
+   incremental) FRAME style checkpt of the same wksp and style must be
+   FRAME.  The checkpt written to path will then be incremental: frames
+   whose contents match the frame at the same location in base are not
+   written and are instead restored from base.  base's path is recorded
+   in the checkpt and base must remain available at that path for the
+   checkpt to be restored.  Frames are matched by a 64-bit hash of their
+   contents. */
+
+int
+fd_wksp_checkpt_tpool( fd_tpool_t * tpool,
+                       ulong        t0,
+                       ulong        t1,
+                       fd_wksp_t *  wksp,
+                       char const * path,
+                       ulong        mode,
+                       int          style,
+                       char const * uinfo,
+                       char const * base );
+
 /* fd_wksp_restore will replace all allocations in the current workspace
    with the allocations from the checkpt at path.  The restored
    workspace will use the given seed.
@@ -1014,6 +1060,20 @@ fd_wksp_restore( fd_wksp_t *  wksp,
                  char const * path,
                  uint         seed );
 
+/* fd_wksp_restore_tpool is the same as fd_wksp_restore but, for FRAME
+   style checkpts, the frames are read, decompressed and verified by
+   tpool threads [t0,t1) in parallel.  tpool NULL restores with the
+   caller only.  The caller is assumed to be thread t0 and threads
+   (t0,t1) are assumed to be idle. */
+
+int
+fd_wksp_restore_tpool( fd_tpool_t * tpool,
+                       ulong        t0,
+                       ulong        t1,
+                       fd_wksp_t *  wksp,
+                       char const * path,
+                       uint         seed );
+
 /* fd_wksp_restore_preview extracts key parameters from a checkpoint
    file. These can be used with fd_funk_new for a correct restore. */
 int
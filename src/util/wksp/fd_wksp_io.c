@@ -5,12 +5,59 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 
+int
+fd_wksp_private_checkpt_header( fd_io_buffered_ostream_t * checkpt,
+                                ulong                      wbuf_sz,
+                                fd_wksp_t *                wksp,
+                                int                        style,
+                                char const *               uinfo ) {
+  int     err;
+  uchar * prep = fd_wksp_private_checkpt_prepare( checkpt, wbuf_sz, &err ); if( FD_UNLIKELY( !prep ) ) return err;
+  prep = fd_wksp_private_checkpt_ulong( prep, wksp->magic                                                          );
+  prep = fd_wksp_private_checkpt_ulong( prep, (ulong)(uint)style                                                   );
+  prep = fd_wksp_private_checkpt_ulong( prep, (ulong)wksp->seed                                                    );
+  prep = fd_wksp_private_checkpt_ulong( prep, wksp->part_max                                                       );
+  prep = fd_wksp_private_checkpt_ulong( prep, wksp->data_max                                                       );
+  prep = fd_wksp_private_checkpt_ulong( prep, (ulong)fd_log_wallclock()                                            );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_app_id()                                                      );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_thread_id()                                                   );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_host_id()                                                     );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_cpu_id()                                                      );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_group_id()                                                    );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_tid()                                                         );
+  prep = fd_wksp_private_checkpt_ulong( prep, fd_log_user_id()                                                     );
+  prep = fd_wksp_private_checkpt_buf  ( prep, wksp->name,        strlen( wksp->name      )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_app(),      strlen( fd_log_app()    )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_thread(),   strlen( fd_log_thread() )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_host(),     strlen( fd_log_host()   )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_cpu(),      strlen( fd_log_cpu()    )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_group(),    strlen( fd_log_group()  )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_user(),     strlen( fd_log_user()   )                         );
+  prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_build_info, fd_ulong_min( fd_log_build_info_sz-1UL, 16383UL ) );
+  prep = fd_wksp_private_checkpt_buf  ( prep, uinfo,             fd_cstr_nlen( uinfo, 16383UL )                    );
+  fd_wksp_private_checkpt_publish( checkpt, prep );
+  return 0;
+}
+
 int
 fd_wksp_checkpt( fd_wksp_t *  wksp,
                  char const * path,
                  ulong        mode,
                  int          style,
-                 char const * uinfo ) { /* TODO: CONSIDER ALLOWING SUBSET OF TAGS */
+                 char const * uinfo ) {
+  return fd_wksp_checkpt_tpool( NULL, 0UL, 1UL, wksp, path, mode, style, uinfo, NULL );
+}
+
+int
+fd_wksp_checkpt_tpool( fd_tpool_t * tpool,
+                       ulong        t0,
+                       ulong        t1,
+                       fd_wksp_t *  wksp,
+                       char const * path,
+                       ulong        mode,
+                       int          style,
+                       char const * uinfo,
+                       char const * base ) { /* TODO: CONSIDER ALLOWING SUBSET OF TAGS */
 
   if( FD_UNLIKELY( !wksp ) ) {
     FD_LOG_WARNING(( "NULL wksp" ));
@@ -27,12 +74,25 @@ fd_wksp_checkpt( fd_wksp_t *  wksp,
     return FD_WKSP_ERR_INVAL;
   }
 
+  if( FD_UNLIKELY( tpool && (t0>=t1) ) ) {
+    FD_LOG_WARNING(( "bad thread range" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
   style = fd_int_if( !!style, style, FD_WKSP_CHECKPT_STYLE_DEFAULT );
 
+  if( FD_UNLIKELY( base && style!=FD_WKSP_CHECKPT_STYLE_FRAME ) ) {
+    FD_LOG_WARNING(( "incremental checkpt requires FD_WKSP_CHECKPT_STYLE_FRAME" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
   if( FD_UNLIKELY( !uinfo ) ) uinfo = "";
 
   switch( style ) {
 
+  case FD_WKSP_CHECKPT_STYLE_FRAME:
+    return fd_wksp_private_checkpt_frame( tpool, t0, t1, wksp, path, mode, uinfo, base ); /* logs details */
+
   case FD_WKSP_CHECKPT_STYLE_RAW: {
 
   //FD_LOG_INFO(( "Checkpt wksp \"%s\" to \"%s\" (mode 0%03lo), style %i, uinfo \"%s\"", wksp->name, path, mode, style, uinfo ));
@@ -66,30 +126,7 @@ fd_wksp_checkpt( fd_wksp_t *  wksp,
 
   //FD_LOG_INFO(( "Checkpt header and metadata" ));
 
-    prep = fd_wksp_private_checkpt_prepare( checkpt, WBUF_FOOTPRINT, &err ); if( FD_UNLIKELY( !prep ) ) goto io_err;
-    prep = fd_wksp_private_checkpt_ulong( prep, wksp->magic                                                          );
-    prep = fd_wksp_private_checkpt_ulong( prep, (ulong)(uint)style                                                   );
-    prep = fd_wksp_private_checkpt_ulong( prep, (ulong)wksp->seed                                                    );
-    prep = fd_wksp_private_checkpt_ulong( prep, wksp->part_max                                                       );
-    prep = fd_wksp_private_checkpt_ulong( prep, wksp->data_max                                                       );
-    prep = fd_wksp_private_checkpt_ulong( prep, (ulong)fd_log_wallclock()                                            );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_app_id()                                                      );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_thread_id()                                                   );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_host_id()                                                     );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_cpu_id()                                                      );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_group_id()                                                    );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_tid()                                                         );
-    prep = fd_wksp_private_checkpt_ulong( prep, fd_log_user_id()                                                     );
-    prep = fd_wksp_private_checkpt_buf  ( prep, wksp->name,        strlen( wksp->name      )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_app(),      strlen( fd_log_app()    )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_thread(),   strlen( fd_log_thread() )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_host(),     strlen( fd_log_host()   )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_cpu(),      strlen( fd_log_cpu()    )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_group(),    strlen( fd_log_group()  )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_user(),     strlen( fd_log_user()   )                         );
-    prep = fd_wksp_private_checkpt_buf  ( prep, fd_log_build_info, fd_ulong_min( fd_log_build_info_sz-1UL, 16383UL ) );
-    prep = fd_wksp_private_checkpt_buf  ( prep, uinfo,             fd_cstr_nlen( uinfo, 16383UL )                    );
-    fd_wksp_private_checkpt_publish( checkpt, prep );
+    err = fd_wksp_private_checkpt_header( checkpt, WBUF_FOOTPRINT, wksp, style, uinfo ); if( FD_UNLIKELY( err ) ) goto io_err;
 
   //FD_LOG_INFO(( "Checkpt allocations" ));
 
@@ -249,6 +286,21 @@ int
 fd_wksp_restore( fd_wksp_t *  wksp,
                  char const * path,
                  uint         new_seed ) {
+  return fd_wksp_restore_tpool( NULL, 0UL, 1UL, wksp, path, new_seed );
+}
+
+int
+fd_wksp_restore_tpool( fd_tpool_t * tpool,
+                       ulong        t0,
+                       ulong        t1,
+                       fd_wksp_t *  wksp,
+                       char const * path,
+                       uint         new_seed ) {
+
+  if( FD_UNLIKELY( tpool && (t0>=t1) ) ) {
+    FD_LOG_WARNING(( "bad thread range" ));
+    return FD_WKSP_ERR_INVAL;
+  }
 
   if( FD_UNLIKELY( !wksp ) ) {
     FD_LOG_WARNING(( "NULL wksp" ));
@@ -311,7 +363,8 @@ fd_wksp_restore( fd_wksp_t *  wksp,
 
   switch( style ) {
 
-  case FD_WKSP_CHECKPT_STYLE_RAW: {
+  case FD_WKSP_CHECKPT_STYLE_RAW:
+  case FD_WKSP_CHECKPT_STYLE_FRAME: {
 
     FD_LOG_INFO(( "Restore metadata" ));
 
@@ -369,7 +422,16 @@ fd_wksp_restore( fd_wksp_t *  wksp,
 
     ulong wksp_part_cnt = 0UL;
 
-    for(;;) {
+    if( style==FD_WKSP_CHECKPT_STYLE_FRAME ) {
+      err = fd_wksp_private_restore_frame( tpool, t0, t1, wksp, path, fd, restore, data_lo, data_hi,
+                                           &wksp_part_cnt, &wksp_dirty ); /* logs details */
+      if( FD_UNLIKELY( err ) ) {
+        err = FD_WKSP_ERR_FAIL;
+        goto unlock;
+      }
+    }
+
+    while( style==FD_WKSP_CHECKPT_STYLE_RAW ) {
 
       /* Restore the allocation header */
 
@@ -441,7 +503,7 @@ fd_wksp_restore( fd_wksp_t *  wksp,
     FD_LOG_INFO(( "Restore successful" ));
     break;
 
-  } /* FD_WKSP_CHECKPT_STYLE_RAW */
+  } /* FD_WKSP_CHECKPT_STYLE_RAW, FD_WKSP_CHECKPT_STYLE_FRAME */
 
   default:
     err_info = "unsupported style";
@@ -531,12 +593,13 @@ fd_wksp_restore_preview( char const * path,
   ulong style_ul; RESTORE_ULONG( style_ul ); int style = (int)(uint)style_ul;
 
   switch( style ) {
-  case FD_WKSP_CHECKPT_STYLE_RAW: {
+  case FD_WKSP_CHECKPT_STYLE_RAW:
+  case FD_WKSP_CHECKPT_STYLE_FRAME: {
     ulong tseed_ul;   RESTORE_ULONG( tseed_ul  ); *out_seed = (uint)tseed_ul;
     ulong tpart_max;  RESTORE_ULONG( tpart_max ); *out_part_max = tpart_max;
     ulong tdata_max;  RESTORE_ULONG( tdata_max ); *out_data_max = tdata_max;
     break;
-  } /* FD_WKSP_CHECKPT_STYLE_RAW */
+  } /* FD_WKSP_CHECKPT_STYLE_RAW, FD_WKSP_CHECKPT_STYLE_FRAME */
 
   default:
     err = FD_WKSP_ERR_FAIL;
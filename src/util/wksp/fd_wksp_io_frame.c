@@ -0,0 +1,912 @@
+#define _GNU_SOURCE /* MAP_ANONYMOUS */
+#include "fd_wksp_private.h"
+#include "../tpool/fd_tpool.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#if FD_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+/* A FRAME style checkpt is laid out as:
+
+     header - the metadata common to all styles (see
+              fd_wksp_private_checkpt_header) followed by the cstr path
+              of the base checkpt ("" if not incremental)
+     frames - the frame payloads in arbitrary order (threads append
+              frames as they finish them)
+     index  - part_cnt, part_cnt (tag,gaddr_lo,sz) tuples, frame_cnt and
+              frame_cnt (gaddr_lo,sz,codec,off,csz,hash) tuples, svw
+              encoded like the header, partitions and frames ordered by
+              gaddr_lo
+     footer - the file offset of the index and FD_WKSP_MAGIC as two
+              ulongs in host byte order
+
+   A frame covers [gaddr_lo,gaddr_lo+sz) of a single partition and the
+   frames of a partition exactly tile it.  The frame payload is the csz
+   bytes at file offset off, encoded with codec.  If codec has the REF
+   bit set, the payload is instead at file offset off of the base
+   checkpt.  hash is the fd_hash of the frame's decoded bytes.
+
+   hash is only used to detect corruption.  It is not collision
+   resistant so an incremental checkpt only references a base frame
+   after comparing the base frame's decoded bytes with the wksp. */
+
+#define FD_WKSP_PRIVATE_FRAME_CODEC_RAW  (0UL)
+#define FD_WKSP_PRIVATE_FRAME_CODEC_ZSTD (1UL)
+#define FD_WKSP_PRIVATE_FRAME_CODEC_REF  (256UL)
+
+#define FD_WKSP_PRIVATE_FRAME_HASH_SEED  (0xf17eda2c3731c592UL) /* Arbitrary but must not change between checkpts */
+#define FD_WKSP_PRIVATE_FRAME_ZSTD_LEVEL (1)
+
+#define FD_WKSP_PRIVATE_FRAME_BUF_ALIGN     (4096UL)
+#define FD_WKSP_PRIVATE_FRAME_BUF_FOOTPRINT (65536UL)
+
+struct fd_wksp_private_frame_part {
+  ulong tag;
+  ulong gaddr_lo;
+  ulong sz;
+};
+
+typedef struct fd_wksp_private_frame_part fd_wksp_private_frame_part_t;
+
+struct fd_wksp_private_frame {
+  ulong gaddr_lo;
+  ulong sz;
+  ulong codec;
+  ulong off;
+  ulong csz;
+  ulong hash;
+  ulong base_idx; /* Not stored, checkpt only: index of the base frame with the same range, ULONG_MAX if none */
+};
+
+typedef struct fd_wksp_private_frame fd_wksp_private_frame_t;
+
+/* fd_wksp_private_frame_ctx_t holds the state shared by the threads
+   checkpointing / restoring frames */
+
+struct fd_wksp_private_frame_ctx {
+  fd_wksp_t *                     wksp;
+  fd_wksp_private_frame_t *       frame;
+  fd_wksp_private_frame_t const * base_frame; /* checkpt only */
+  int                             fd;
+  int                             base_fd;    /* -1 if not incremental */
+  ulong                           cursor;     /* checkpt only: file offset of the next frame payload */
+  uchar *                         buf;        /* Thread t's scratch is at buf + (t-t0)*buf_sz */
+  ulong                           buf_sz;
+  uchar *                         cmp;        /* checkpt only: thread t's decoded base frame is at cmp + (t-t0)*FD_WKSP_CHECKPT_FRAME_SZ_MAX */
+  ulong                           t0;
+  int                             err;        /* First error (errno compat) encountered, 0 if none */
+  ulong                           err_idx;    /* Frame that encountered err */
+};
+
+typedef struct fd_wksp_private_frame_ctx fd_wksp_private_frame_ctx_t;
+
+/* fd_wksp_private_frame_{mmap,munmap} allocate / free scratch memory
+   for frame handling.  This memory can't come from the wksp being
+   checkpointed or restored. */
+
+static void *
+fd_wksp_private_frame_mmap( ulong sz ) {
+  void * mem = mmap( NULL, fd_ulong_max( sz, 1UL ), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, (off_t)0 );
+  if( FD_UNLIKELY( mem==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(NULL,%lu KiB,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0) failed (%i-%s)",
+                     sz>>10, errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  return mem;
+}
+
+static void
+fd_wksp_private_frame_munmap( void * mem,
+                              ulong  sz ) {
+  if( FD_UNLIKELY( mem && munmap( mem, fd_ulong_max( sz, 1UL ) ) ) )
+    FD_LOG_WARNING(( "munmap failed (%i-%s); attempting to continue", errno, fd_io_strerror( errno ) ));
+}
+
+/* fd_wksp_private_frame_{pwrite,pread} write / read sz bytes at file
+   offset off of fd.  Safe to call concurrently on the same fd.  Returns
+   0 on success and an errno compat error code on failure (EPROTO if the
+   file ended early). */
+
+static int
+fd_wksp_private_frame_pwrite( int          fd,
+                              void const * buf,
+                              ulong        sz,
+                              ulong        off ) {
+  while( sz ) {
+    long wsz = (long)pwrite( fd, buf, fd_ulong_min( sz, 1UL<<30 ), (off_t)off );
+    if( FD_UNLIKELY( wsz<=0L ) ) {
+      if( FD_LIKELY( (wsz<0L) & (errno==EINTR) ) ) continue;
+      return wsz<0L ? errno : EIO;
+    }
+    buf  = (uchar const *)buf + wsz;
+    sz  -= (ulong)wsz;
+    off += (ulong)wsz;
+  }
+  return 0;
+}
+
+static int
+fd_wksp_private_frame_pread( int    fd,
+                             void * buf,
+                             ulong  sz,
+                             ulong  off ) {
+  while( sz ) {
+    long rsz = (long)pread( fd, buf, fd_ulong_min( sz, 1UL<<30 ), (off_t)off );
+    if( FD_UNLIKELY( rsz<=0L ) ) {
+      if( FD_LIKELY( (rsz<0L) & (errno==EINTR) ) ) continue;
+      return rsz<0L ? errno : EPROTO;
+    }
+    buf  = (uchar *)buf + rsz;
+    sz  -= (ulong)rsz;
+    off += (ulong)rsz;
+  }
+  return 0;
+}
+
+/* fd_wksp_private_frame_buf_sz returns the per thread scratch needed to
+   encode / decode a frame (0 if frames are never compressed). */
+
+static inline ulong
+fd_wksp_private_frame_buf_sz( void ) {
+# if FD_HAS_ZSTD
+  return fd_ulong_align_up( (ulong)ZSTD_compressBound( FD_WKSP_CHECKPT_FRAME_SZ_MAX ), FD_WKSP_PRIVATE_FRAME_BUF_ALIGN );
+# else
+  return 0UL;
+# endif
+}
+
+/* fd_wksp_private_frame_exec runs task over frames [0,frame_cnt) with
+   tpool threads [t0,t1) (or the caller if tpool is NULL). */
+
+static void
+fd_wksp_private_frame_exec( fd_tpool_t *                  tpool,
+                            ulong                         t0,
+                            ulong                         t1,
+                            fd_tpool_task_t               task,
+                            fd_wksp_private_frame_ctx_t * ctx,
+                            ulong                         frame_cnt ) {
+# if FD_HAS_ATOMIC
+  if( tpool && (t1-t0)>1UL ) {
+    fd_tpool_exec_all_taskq( tpool, t0, t1, task, tpool, ctx, NULL, 1UL, 0UL, frame_cnt );
+    return;
+  }
+# else
+  (void)t1;
+# endif
+  task( tpool, t0, t0+1UL, ctx, NULL, 1UL, 0UL, frame_cnt, 0UL, frame_cnt, t0, t0+1UL );
+}
+
+/* fd_wksp_private_frame_index_read reads the index of the FRAME style
+   checkpt open as fd (path is used for diagnostics).  On success,
+   returns 0 and *_part and *_frame point to fd_wksp_private_frame_mmap
+   allocated arrays holding the *_part_cnt partitions and *_frame_cnt
+   frames of the checkpt (caller is responsible for unmapping them).  On
+   failure, returns an errno compat error code (logs details) and the
+   outputs are NULL / 0. */
+
+static int
+fd_wksp_private_frame_index_read( int                             fd,
+                                  char const *                    path,
+                                  ulong *                         _part_cnt,
+                                  fd_wksp_private_frame_part_t ** _part,
+                                  ulong *                         _frame_cnt,
+                                  fd_wksp_private_frame_t **      _frame ) {
+  *_part_cnt  = 0UL; *_part  = NULL;
+  *_frame_cnt = 0UL; *_frame = NULL;
+
+  struct stat st[1];
+  if( FD_UNLIKELY( fstat( fd, st ) ) ) {
+    FD_LOG_WARNING(( "fstat(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    return errno;
+  }
+  ulong file_sz = (ulong)st->st_size;
+
+  ulong footer[2];
+  int   err = file_sz>=sizeof(footer) ? fd_wksp_private_frame_pread( fd, footer, sizeof(footer), file_sz-sizeof(footer) ) : EPROTO;
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "checkpt \"%s\" footer read failed (%i-%s)", path, err, fd_io_strerror( err ) ));
+    return err;
+  }
+  ulong index_off = footer[0];
+  if( FD_UNLIKELY( (footer[1]!=FD_WKSP_MAGIC) | (index_off>file_sz-sizeof(footer)) ) ) {
+    FD_LOG_WARNING(( "checkpt \"%s\" has a bad footer (not a FRAME style checkpt or truncated?)", path ));
+    return EPROTO;
+  }
+
+  if( FD_UNLIKELY( lseek( fd, (off_t)index_off, SEEK_SET )!=(off_t)index_off ) ) {
+    FD_LOG_WARNING(( "lseek(\"%s\",%lu,SEEK_SET) failed (%i-%s)", path, index_off, errno, fd_io_strerror( errno ) ));
+    return errno;
+  }
+
+  uchar                    rbuf[ FD_WKSP_PRIVATE_FRAME_BUF_FOOTPRINT ] __attribute__((aligned( FD_WKSP_PRIVATE_FRAME_BUF_ALIGN )));
+  fd_io_buffered_istream_t in[1];
+  fd_io_buffered_istream_init( in, fd, rbuf, FD_WKSP_PRIVATE_FRAME_BUF_FOOTPRINT );
+
+  ulong                          part_cnt  = 0UL;
+  fd_wksp_private_frame_part_t * part      = NULL;
+  ulong                          frame_cnt = 0UL;
+  fd_wksp_private_frame_t *      frame     = NULL;
+
+  /* Each index entry takes at least 1 byte per field so the counts are
+     bounded by the index size (protects against huge allocations from
+     corrupt checkpts). */
+
+  ulong index_sz = file_sz - sizeof(footer) - index_off;
+
+# define RESTORE_ULONG(v) do {                                  \
+    err = fd_wksp_private_restore_ulong( in, &(v) );            \
+    if( FD_UNLIKELY( err ) ) goto fail;                         \
+  } while(0)
+
+  RESTORE_ULONG( part_cnt );
+  if( FD_UNLIKELY( part_cnt>index_sz/3UL ) ) { err = EPROTO; goto fail; }
+  part = fd_wksp_private_frame_mmap( part_cnt*sizeof(fd_wksp_private_frame_part_t) );
+  if( FD_UNLIKELY( !part ) ) { err = ENOMEM; goto fail; }
+  for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) {
+    RESTORE_ULONG( part[ part_idx ].tag      );
+    RESTORE_ULONG( part[ part_idx ].gaddr_lo );
+    RESTORE_ULONG( part[ part_idx ].sz       );
+  }
+
+  RESTORE_ULONG( frame_cnt );
+  if( FD_UNLIKELY( frame_cnt>index_sz/6UL ) ) { err = EPROTO; goto fail; }
+  frame = fd_wksp_private_frame_mmap( frame_cnt*sizeof(fd_wksp_private_frame_t) );
+  if( FD_UNLIKELY( !frame ) ) { err = ENOMEM; goto fail; }
+  for( ulong frame_idx=0UL; frame_idx<frame_cnt; frame_idx++ ) {
+    RESTORE_ULONG( frame[ frame_idx ].gaddr_lo );
+    RESTORE_ULONG( frame[ frame_idx ].sz       );
+    RESTORE_ULONG( frame[ frame_idx ].codec    );
+    RESTORE_ULONG( frame[ frame_idx ].off      );
+    RESTORE_ULONG( frame[ frame_idx ].csz      );
+    RESTORE_ULONG( frame[ frame_idx ].hash     );
+    frame[ frame_idx ].base_idx = ULONG_MAX;
+  }
+
+# undef RESTORE_ULONG
+
+  fd_io_buffered_istream_fini( in );
+
+  *_part_cnt  = part_cnt;  *_part  = part;
+  *_frame_cnt = frame_cnt; *_frame = frame;
+  return 0;
+
+fail:
+  fd_io_buffered_istream_fini( in );
+  FD_LOG_WARNING(( "checkpt \"%s\" index read failed (%i-%s)", path, err, fd_io_strerror( err ) ));
+  fd_wksp_private_frame_munmap( frame, frame_cnt*sizeof(fd_wksp_private_frame_t)      );
+  fd_wksp_private_frame_munmap( part,  part_cnt *sizeof(fd_wksp_private_frame_part_t) );
+  return err;
+}
+
+/* checkpt ************************************************************/
+
+/* fd_wksp_private_checkpt_frame_base_eq returns 1 if base_frame of the
+   base checkpt decodes to the sz bytes at data and 0 otherwise
+   (including if base_frame can't be read or decoded).  Uses thread t's
+   scratch. */
+
+static int
+fd_wksp_private_checkpt_frame_base_eq( fd_wksp_private_frame_ctx_t const * ctx,
+                                       fd_wksp_private_frame_t const *     base_frame,
+                                       uchar const *                       data,
+                                       ulong                               sz,
+                                       ulong                               t ) {
+  uchar * cmp = ctx->cmp + (t-ctx->t0)*FD_WKSP_CHECKPT_FRAME_SZ_MAX;
+
+  switch( base_frame->codec ) {
+
+  case FD_WKSP_PRIVATE_FRAME_CODEC_RAW:
+    if( FD_UNLIKELY( base_frame->csz!=sz ) ) return 0;
+    if( FD_UNLIKELY( fd_wksp_private_frame_pread( ctx->base_fd, cmp, sz, base_frame->off ) ) ) return 0;
+    break;
+
+# if FD_HAS_ZSTD
+  case FD_WKSP_PRIVATE_FRAME_CODEC_ZSTD: {
+    uchar * buf = ctx->buf + (t-ctx->t0)*ctx->buf_sz;
+    if( FD_UNLIKELY( base_frame->csz>ctx->buf_sz ) ) return 0;
+    if( FD_UNLIKELY( fd_wksp_private_frame_pread( ctx->base_fd, buf, base_frame->csz, base_frame->off ) ) ) return 0;
+    size_t dsz = ZSTD_decompress( cmp, sz, buf, base_frame->csz );
+    if( FD_UNLIKELY( ZSTD_isError( dsz ) || ((ulong)dsz!=sz) ) ) return 0;
+    break;
+  }
+# endif
+
+  default:
+    return 0;
+  }
+
+  return !memcmp( cmp, data, sz );
+}
+
+static void
+fd_wksp_private_checkpt_frame_task( void * tpool,
+                                    ulong  t0,     ulong t1,
+                                    void * args,
+                                    void * reduce, ulong stride,
+                                    ulong  l0,     ulong l1,
+                                    ulong  m0,     ulong m1,
+                                    ulong  n0,     ulong n1 ) {
+  (void)tpool; (void)t0; (void)t1; (void)reduce; (void)stride; (void)l0; (void)l1; (void)n1;
+
+  fd_wksp_private_frame_ctx_t * ctx = (fd_wksp_private_frame_ctx_t *)args;
+
+  for( ulong frame_idx=m0; frame_idx<m1; frame_idx++ ) {
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( ctx->err ) ) ) return;
+
+    fd_wksp_private_frame_t * frame = ctx->frame + frame_idx;
+    ulong                     sz    = frame->sz;
+    uchar const *             data  = (uchar const *)fd_wksp_laddr_fast( ctx->wksp, frame->gaddr_lo );
+
+    frame->hash = fd_hash( FD_WKSP_PRIVATE_FRAME_HASH_SEED, data, sz );
+
+    /* If the base checkpt has the same bytes here, reference them (the
+       hash match only tells us which base frames are worth comparing) */
+
+    ulong base_idx = frame->base_idx;
+    if( base_idx!=ULONG_MAX && ctx->base_frame[ base_idx ].hash==frame->hash &&
+        fd_wksp_private_checkpt_frame_base_eq( ctx, ctx->base_frame + base_idx, data, sz, n0 ) ) {
+      frame->codec = ctx->base_frame[ base_idx ].codec | FD_WKSP_PRIVATE_FRAME_CODEC_REF;
+      frame->off   = ctx->base_frame[ base_idx ].off;
+      frame->csz   = ctx->base_frame[ base_idx ].csz;
+      continue;
+    }
+
+    /* Otherwise, encode the frame and append it to the checkpt */
+
+    void const * payload = data;
+    ulong        csz     = sz;
+    ulong        codec   = FD_WKSP_PRIVATE_FRAME_CODEC_RAW;
+
+#   if FD_HAS_ZSTD
+    uchar * buf = ctx->buf + (n0-ctx->t0)*ctx->buf_sz;
+    size_t  zsz = ZSTD_compress( buf, ctx->buf_sz, data, sz, FD_WKSP_PRIVATE_FRAME_ZSTD_LEVEL );
+    if( FD_LIKELY( (!ZSTD_isError( zsz )) && ((ulong)zsz<sz) ) ) {
+      payload = buf;
+      csz     = (ulong)zsz;
+      codec   = FD_WKSP_PRIVATE_FRAME_CODEC_ZSTD;
+    }
+#   endif
+
+#   if FD_HAS_ATOMIC
+    ulong off = FD_ATOMIC_FETCH_AND_ADD( &ctx->cursor, csz );
+#   else
+    ulong off = ctx->cursor; ctx->cursor = off + csz; /* only run single threaded */
+#   endif
+
+    int err = fd_wksp_private_frame_pwrite( ctx->fd, payload, csz, off );
+    if( FD_UNLIKELY( err ) ) {
+      ctx->err_idx = frame_idx;
+      FD_COMPILER_MFENCE();
+      FD_VOLATILE( ctx->err ) = err;
+      return;
+    }
+
+    frame->codec = codec;
+    frame->off   = off;
+    frame->csz   = csz;
+  }
+}
+
+int
+fd_wksp_private_checkpt_frame( fd_tpool_t * tpool,
+                               ulong        t0,
+                               ulong        t1,
+                               fd_wksp_t *  wksp,
+                               char const * path,
+                               ulong        mode,
+                               char const * uinfo,
+                               char const * base ) {
+
+  ulong base_len = base ? fd_cstr_nlen( base, PATH_MAX ) : 0UL;
+  if( FD_UNLIKELY( base_len>=PATH_MAX ) ) {
+    FD_LOG_WARNING(( "base path too long" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  /* Load the base's index (before creating the checkpt so a bad base
+     doesn't leave a partial checkpt behind).  The base is kept open to
+     compare its frames with the wksp. */
+
+  ulong                          base_part_cnt  = 0UL;
+  fd_wksp_private_frame_part_t * base_part      = NULL;
+  ulong                          base_frame_cnt = 0UL;
+  fd_wksp_private_frame_t *      base_frame     = NULL;
+  int                            base_fd        = -1;
+
+  if( base ) {
+    base_fd = open( base, O_RDONLY, (mode_t)0 );
+    if( FD_UNLIKELY( base_fd==-1 ) ) {
+      FD_LOG_WARNING(( "open(\"%s\",O_RDONLY,0) failed (%i-%s)", base, errno, fd_io_strerror( errno ) ));
+      return FD_WKSP_ERR_FAIL;
+    }
+    int err = fd_wksp_private_frame_index_read( base_fd, base, &base_part_cnt, &base_part, &base_frame_cnt, &base_frame );
+    if( FD_LIKELY( !err ) ) {
+      fd_wksp_private_frame_munmap( base_part, base_part_cnt*sizeof(fd_wksp_private_frame_part_t) );
+      for( ulong frame_idx=0UL; frame_idx<base_frame_cnt; frame_idx++ ) {
+        if( FD_UNLIKELY( base_frame[ frame_idx ].codec & FD_WKSP_PRIVATE_FRAME_CODEC_REF ) ) {
+          FD_LOG_WARNING(( "base \"%s\" is itself incremental; use a full checkpt as the base", base ));
+          fd_wksp_private_frame_munmap( base_frame, base_frame_cnt*sizeof(fd_wksp_private_frame_t) );
+          err = EINVAL;
+          break;
+        }
+      }
+    }
+    if( FD_UNLIKELY( err ) ) {
+      if( FD_UNLIKELY( close( base_fd ) ) )
+        FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", base, errno, fd_io_strerror( errno ) ));
+      return err==EINVAL ? FD_WKSP_ERR_INVAL : FD_WKSP_ERR_FAIL; /* logs details */
+    }
+  }
+
+  mode_t old_mask = umask( (mode_t)0 );
+  int fd = open( path, O_CREAT|O_EXCL|O_WRONLY, (mode_t)mode );
+  umask( old_mask );
+  if( FD_UNLIKELY( fd==-1 ) ) {
+    FD_LOG_WARNING(( "open(\"%s\",O_CREAT|O_EXCL|O_WRONLY,0%03lo) failed (%i-%s)", path, mode, errno, fd_io_strerror( errno ) ));
+    fd_wksp_private_frame_munmap( base_frame, base_frame_cnt*sizeof(fd_wksp_private_frame_t) );
+    if( FD_UNLIKELY( base && close( base_fd ) ) )
+      FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", base, errno, fd_io_strerror( errno ) ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  uchar                    wbuf[ FD_WKSP_PRIVATE_FRAME_BUF_FOOTPRINT ] __attribute__((aligned( FD_WKSP_PRIVATE_FRAME_BUF_ALIGN )));
+  fd_io_buffered_ostream_t checkpt[ 1 ];
+  fd_io_buffered_ostream_init( checkpt, fd, wbuf, FD_WKSP_PRIVATE_FRAME_BUF_FOOTPRINT );
+
+  ulong                          part_cnt  = 0UL;
+  fd_wksp_private_frame_part_t * part      = NULL;
+  ulong                          frame_cnt = 0UL;
+  fd_wksp_private_frame_t *      frame     = NULL;
+  ulong                          buf_sz    = fd_wksp_private_frame_buf_sz();
+  ulong                          thread_cnt = tpool ? t1-t0 : 1UL;
+  uchar *                        buf       = NULL;
+  ulong                          cmp_sz    = base ? thread_cnt*FD_WKSP_CHECKPT_FRAME_SZ_MAX : 0UL;
+  uchar *                        cmp       = NULL;
+
+  int     err;
+  uchar * prep;
+
+  err = fd_wksp_private_lock( wksp ); if( FD_UNLIKELY( err ) ) goto fini; /* logs details */
+
+  ulong data_lo = wksp->gaddr_lo;
+  ulong data_hi = wksp->gaddr_hi;
+  if( FD_UNLIKELY( !((0UL<data_lo) & (data_lo<=data_hi)) ) ) goto corrupt_wksp;
+
+  /* Checkpt header and metadata */
+
+  err = fd_wksp_private_checkpt_header( checkpt, FD_WKSP_PRIVATE_FRAME_BUF_FOOTPRINT, wksp, FD_WKSP_CHECKPT_STYLE_FRAME, uinfo );
+  if( FD_UNLIKELY( err ) ) goto io_err;
+
+  prep = fd_wksp_private_checkpt_prepare( checkpt, 9UL+base_len, &err ); if( FD_UNLIKELY( !prep ) ) goto io_err;
+  prep = fd_wksp_private_checkpt_buf( prep, base ? base : "", base_len );
+  fd_wksp_private_checkpt_publish( checkpt, prep );
+
+  err = fd_io_buffered_ostream_flush( checkpt ); if( FD_UNLIKELY( err ) ) goto io_err;
+
+  off_t header_sz = lseek( fd, (off_t)0, SEEK_CUR );
+  if( FD_UNLIKELY( header_sz<(off_t)0 ) ) { err = errno; goto io_err; }
+
+  /* Count the allocated partitions and frames (validating the
+     partitioning like the RAW style) */
+
+  ulong                     part_max = wksp->part_max;
+  fd_wksp_private_pinfo_t * pinfo    = fd_wksp_private_pinfo( wksp );
+
+  ulong cycle_tag  = wksp->cycle_tag++;
+  ulong gaddr_last = data_lo;
+
+  ulong i = fd_wksp_private_pinfo_idx( wksp->part_head_cidx );
+  while( !fd_wksp_private_pinfo_idx_is_null( i ) ) {
+    if( FD_UNLIKELY( i>=part_max ) || FD_UNLIKELY( pinfo[ i ].cycle_tag==cycle_tag ) ) goto corrupt_wksp;
+    pinfo[ i ].cycle_tag = cycle_tag; /* mark i as visited */
+
+    ulong gaddr_lo = pinfo[ i ].gaddr_lo;
+    ulong gaddr_hi = pinfo[ i ].gaddr_hi;
+
+    if( FD_UNLIKELY( !((gaddr_last==gaddr_lo) & (gaddr_lo<gaddr_hi) & (gaddr_hi<=data_hi)) ) ) goto corrupt_wksp;
+    gaddr_last = gaddr_hi;
+
+    if( pinfo[ i ].tag ) {
+      part_cnt++;
+      frame_cnt += (gaddr_hi - gaddr_lo + FD_WKSP_CHECKPT_FRAME_SZ_MAX - 1UL) / FD_WKSP_CHECKPT_FRAME_SZ_MAX;
+    }
+
+    i = fd_wksp_private_pinfo_idx( pinfo[ i ].next_cidx );
+  }
+
+  part  = fd_wksp_private_frame_mmap( part_cnt *sizeof(fd_wksp_private_frame_part_t) );
+  frame = fd_wksp_private_frame_mmap( frame_cnt*sizeof(fd_wksp_private_frame_t)      );
+  if( FD_LIKELY( buf_sz ) ) buf = fd_wksp_private_frame_mmap( thread_cnt*buf_sz );
+  if( cmp_sz              ) cmp = fd_wksp_private_frame_mmap( cmp_sz            );
+  if( FD_UNLIKELY( (!part) | (!frame) | ((!!buf_sz) & (!buf)) | ((!!cmp_sz) & (!cmp)) ) ) { err = ENOMEM; goto io_err; }
+
+  /* Split the allocated partitions into frames (the list was validated
+     above and we hold the lock so it is safe to walk again) */
+
+  ulong part_idx  = 0UL;
+  ulong frame_idx = 0UL;
+  i = fd_wksp_private_pinfo_idx( wksp->part_head_cidx );
+  while( !fd_wksp_private_pinfo_idx_is_null( i ) ) {
+    ulong tag = pinfo[ i ].tag;
+    if( tag ) {
+      ulong gaddr_lo = pinfo[ i ].gaddr_lo;
+      ulong gaddr_hi = pinfo[ i ].gaddr_hi;
+      part[ part_idx ].tag      = tag;
+      part[ part_idx ].gaddr_lo = gaddr_lo;
+      part[ part_idx ].sz       = gaddr_hi - gaddr_lo;
+      part_idx++;
+      for( ulong frame_lo=gaddr_lo; frame_lo<gaddr_hi; frame_lo+=FD_WKSP_CHECKPT_FRAME_SZ_MAX ) {
+        frame[ frame_idx ].gaddr_lo = frame_lo;
+        frame[ frame_idx ].sz       = fd_ulong_min( gaddr_hi-frame_lo, FD_WKSP_CHECKPT_FRAME_SZ_MAX );
+        frame[ frame_idx ].base_idx = ULONG_MAX;
+        frame_idx++;
+      }
+    }
+    i = fd_wksp_private_pinfo_idx( pinfo[ i ].next_cidx );
+  }
+
+  /* Match frames to base frames covering the same range (both are
+     sorted by gaddr_lo) */
+
+  for( ulong frame_idx=0UL, base_idx=0UL; (frame_idx<frame_cnt) & (base_idx<base_frame_cnt); ) {
+    ulong frame_lo = frame[ frame_idx ].gaddr_lo;
+    ulong base_lo  = base_frame[ base_idx ].gaddr_lo;
+    if(      frame_lo<base_lo ) frame_idx++;
+    else if( base_lo<frame_lo ) base_idx++;
+    else {
+      if( frame[ frame_idx ].sz==base_frame[ base_idx ].sz ) frame[ frame_idx ].base_idx = base_idx;
+      frame_idx++;
+      base_idx++;
+    }
+  }
+
+  /* Hash, encode and write the frames */
+
+  fd_wksp_private_frame_ctx_t ctx[1] = {{
+    .wksp       = wksp,
+    .frame      = frame,
+    .base_frame = base_frame,
+    .fd         = fd,
+    .base_fd    = base_fd,
+    .cursor     = (ulong)header_sz,
+    .buf        = buf,
+    .buf_sz     = buf_sz,
+    .cmp        = cmp,
+    .t0         = t0,
+    .err        = 0,
+    .err_idx    = ULONG_MAX
+  }};
+
+  fd_wksp_private_frame_exec( tpool, t0, t1, fd_wksp_private_checkpt_frame_task, ctx, frame_cnt );
+
+  err = ctx->err;
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "Checkpt frame [0x%016lx,0x%016lx) failed", frame[ ctx->err_idx ].gaddr_lo,
+                     frame[ ctx->err_idx ].gaddr_lo + frame[ ctx->err_idx ].sz ));
+    goto io_err;
+  }
+
+  /* Checkpt the index and footer after the frames */
+
+  ulong index_off = ctx->cursor;
+  if( FD_UNLIKELY( lseek( fd, (off_t)index_off, SEEK_SET )!=(off_t)index_off ) ) { err = errno; goto io_err; }
+
+  prep = fd_wksp_private_checkpt_prepare( checkpt, 9UL, &err ); if( FD_UNLIKELY( !prep ) ) goto io_err;
+  prep = fd_wksp_private_checkpt_ulong( prep, part_cnt );
+  fd_wksp_private_checkpt_publish( checkpt, prep );
+  for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) {
+    prep = fd_wksp_private_checkpt_prepare( checkpt, 3UL*9UL, &err ); if( FD_UNLIKELY( !prep ) ) goto io_err;
+    prep = fd_wksp_private_checkpt_ulong( prep, part[ part_idx ].tag      );
+    prep = fd_wksp_private_checkpt_ulong( prep, part[ part_idx ].gaddr_lo );
+    prep = fd_wksp_private_checkpt_ulong( prep, part[ part_idx ].sz       );
+    fd_wksp_private_checkpt_publish( checkpt, prep );
+  }
+
+  ulong raw_sz = 0UL;
+  ulong csz    = 0UL;
+  ulong ref_sz = 0UL;
+
+  prep = fd_wksp_private_checkpt_prepare( checkpt, 9UL, &err ); if( FD_UNLIKELY( !prep ) ) goto io_err;
+  prep = fd_wksp_private_checkpt_ulong( prep, frame_cnt );
+  fd_wksp_private_checkpt_publish( checkpt, prep );
+  for( ulong frame_idx=0UL; frame_idx<frame_cnt; frame_idx++ ) {
+    fd_wksp_private_frame_t const * f = frame + frame_idx;
+    prep = fd_wksp_private_checkpt_prepare( checkpt, 6UL*9UL, &err ); if( FD_UNLIKELY( !prep ) ) goto io_err;
+    prep = fd_wksp_private_checkpt_ulong( prep, f->gaddr_lo );
+    prep = fd_wksp_private_checkpt_ulong( prep, f->sz       );
+    prep = fd_wksp_private_checkpt_ulong( prep, f->codec    );
+    prep = fd_wksp_private_checkpt_ulong( prep, f->off      );
+    prep = fd_wksp_private_checkpt_ulong( prep, f->csz      );
+    prep = fd_wksp_private_checkpt_ulong( prep, f->hash     );
+    fd_wksp_private_checkpt_publish( checkpt, prep );
+
+    raw_sz += f->sz;
+    if( f->codec & FD_WKSP_PRIVATE_FRAME_CODEC_REF ) ref_sz += f->sz;
+    else                                             csz    += f->csz;
+  }
+
+  ulong footer[2] = { index_off, FD_WKSP_MAGIC };
+  err = fd_wksp_private_checkpt_write( checkpt, footer, sizeof(footer) ); if( FD_UNLIKELY( err ) ) goto io_err;
+  err = fd_io_buffered_ostream_flush( checkpt );                         if( FD_UNLIKELY( err ) ) goto io_err;
+
+  fd_wksp_private_unlock( wksp );
+
+  FD_LOG_INFO(( "Checkpt wksp \"%s\" to \"%s\": %lu partitions, %lu frames, %lu bytes, %lu written as %lu, %lu in base",
+                wksp->name, path, part_cnt, frame_cnt, raw_sz, raw_sz-ref_sz, csz, ref_sz ));
+
+  /* note: err == 0 at this point */
+
+fini: /* note: wksp unlocked at this point */
+  fd_wksp_private_frame_munmap( cmp,        cmp_sz                                             );
+  fd_wksp_private_frame_munmap( buf,        thread_cnt*buf_sz                                  );
+  fd_wksp_private_frame_munmap( frame,      frame_cnt*sizeof(fd_wksp_private_frame_t)          );
+  fd_wksp_private_frame_munmap( part,       part_cnt *sizeof(fd_wksp_private_frame_part_t)     );
+  fd_wksp_private_frame_munmap( base_frame, base_frame_cnt*sizeof(fd_wksp_private_frame_t)     );
+  fd_io_buffered_ostream_fini( checkpt );
+  if( FD_UNLIKELY( base && close( base_fd ) ) )
+    FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", base, errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( err ) && FD_UNLIKELY( unlink( path ) ) )
+    FD_LOG_WARNING(( "unlink(\"%s\") failed (%i-%s); attempting to continue", path, errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( close( fd ) ) )
+    FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", path, errno, fd_io_strerror( errno ) ));
+  return err;
+
+io_err: /* Failed due to I/O error ... clean up and log (note: wksp locked at this point) */
+  fd_wksp_private_unlock( wksp );
+  FD_LOG_WARNING(( "Checkpt wksp \"%s\" to \"%s\" failed due to I/O error (%i-%s)",
+                   wksp->name, path, err, fd_io_strerror( err ) ));
+  err = FD_WKSP_ERR_FAIL;
+  goto fini;
+
+corrupt_wksp: /* Failed due to wksp corruption ... clean up and log (note: wksp locked at this point) */
+  fd_wksp_private_unlock( wksp );
+  FD_LOG_WARNING(( "Checkpt wksp \"%s\" to \"%s\" failed due to wksp corruption", wksp->name, path ));
+  err = FD_WKSP_ERR_CORRUPT;
+  goto fini;
+}
+
+/* restore ************************************************************/
+
+static void
+fd_wksp_private_restore_frame_task( void * tpool,
+                                    ulong  t0,     ulong t1,
+                                    void * args,
+                                    void * reduce, ulong stride,
+                                    ulong  l0,     ulong l1,
+                                    ulong  m0,     ulong m1,
+                                    ulong  n0,     ulong n1 ) {
+  (void)tpool; (void)t0; (void)t1; (void)reduce; (void)stride; (void)l0; (void)l1; (void)n1;
+
+  fd_wksp_private_frame_ctx_t * ctx = (fd_wksp_private_frame_ctx_t *)args;
+
+  for( ulong frame_idx=m0; frame_idx<m1; frame_idx++ ) {
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( ctx->err ) ) ) return;
+
+    fd_wksp_private_frame_t const * frame = ctx->frame + frame_idx;
+    ulong                           sz    = frame->sz;
+    uchar *                         data  = (uchar *)fd_wksp_laddr_fast( ctx->wksp, frame->gaddr_lo );
+    int                             fd    = (frame->codec & FD_WKSP_PRIVATE_FRAME_CODEC_REF) ? ctx->base_fd : ctx->fd;
+
+    int err;
+    switch( frame->codec & ~FD_WKSP_PRIVATE_FRAME_CODEC_REF ) {
+
+    case FD_WKSP_PRIVATE_FRAME_CODEC_RAW:
+      err = fd_wksp_private_frame_pread( fd, data, sz, frame->off );
+      break;
+
+#   if FD_HAS_ZSTD
+    case FD_WKSP_PRIVATE_FRAME_CODEC_ZSTD: {
+      uchar * buf = ctx->buf + (n0-ctx->t0)*ctx->buf_sz;
+      err = fd_wksp_private_frame_pread( fd, buf, frame->csz, frame->off );
+      if( FD_UNLIKELY( err ) ) break;
+      size_t dsz = ZSTD_decompress( data, sz, buf, frame->csz );
+      if( FD_UNLIKELY( ZSTD_isError( dsz ) || ((ulong)dsz!=sz) ) ) err = EPROTO;
+      break;
+    }
+#   endif
+
+    default: /* validated by caller */
+      (void)n0;
+      err = EPROTO;
+      break;
+    }
+
+    if( FD_LIKELY( !err ) && FD_UNLIKELY( fd_hash( FD_WKSP_PRIVATE_FRAME_HASH_SEED, data, sz )!=frame->hash ) ) err = EPROTO;
+
+    if( FD_UNLIKELY( err ) ) {
+      ctx->err_idx = frame_idx;
+      FD_COMPILER_MFENCE();
+      FD_VOLATILE( ctx->err ) = err;
+      return;
+    }
+  }
+}
+
+int
+fd_wksp_private_restore_frame( fd_tpool_t *               tpool,
+                               ulong                      t0,
+                               ulong                      t1,
+                               fd_wksp_t *                wksp,
+                               char const *               path,
+                               int                        fd,
+                               fd_io_buffered_istream_t * restore,
+                               ulong                      data_lo,
+                               ulong                      data_hi,
+                               ulong *                    _part_cnt,
+                               int *                      _dirty ) {
+
+  *_part_cnt = 0UL;
+
+  char  base[ PATH_MAX ];
+  ulong base_len;
+  int   err = fd_wksp_private_restore_buf( restore, base, PATH_MAX-1UL, &base_len );
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed (base) due to I/O error (%i-%s)",
+                     path, wksp->name, err, fd_io_strerror( err ) ));
+    return err;
+  }
+  base[ base_len ] = '\0';
+  if( base_len ) FD_LOG_INFO(( "checkpt_base   \"%s\"", base ));
+
+  ulong                          part_cnt;
+  fd_wksp_private_frame_part_t * part;
+  ulong                          frame_cnt;
+  fd_wksp_private_frame_t *      frame;
+  err = fd_wksp_private_frame_index_read( fd, path, &part_cnt, &part, &frame_cnt, &frame );
+  if( FD_UNLIKELY( err ) ) return err; /* logs details */
+
+  ulong   buf_sz     = fd_wksp_private_frame_buf_sz();
+  ulong   thread_cnt = tpool ? t1-t0 : 1UL;
+  uchar * buf        = NULL;
+  int     base_fd    = -1;
+
+  /* Validate the partitions */
+
+  ulong wksp_data_lo = wksp->gaddr_lo;
+  ulong wksp_data_hi = wksp->gaddr_hi;
+
+  if( FD_UNLIKELY( part_cnt>wksp->part_max ) ) {
+    FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed because too few wksp partitions (checkpt %lu, wksp %lu)",
+                     path, wksp->name, part_cnt, wksp->part_max ));
+    err = EPROTO;
+    goto fini;
+  }
+
+  ulong gaddr_last = data_lo;
+  for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) {
+    ulong tag      = part[ part_idx ].tag;
+    ulong gaddr_lo = part[ part_idx ].gaddr_lo;
+    ulong gaddr_hi = gaddr_lo + part[ part_idx ].sz;
+    if( FD_UNLIKELY( !( (!!tag) & (gaddr_last<=gaddr_lo) & (gaddr_lo<gaddr_hi) & (gaddr_hi<=data_hi) ) ) ) {
+      FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed due to checkpt format error (bad partition)", path, wksp->name ));
+      err = EPROTO;
+      goto fini;
+    }
+    if( FD_UNLIKELY( !((wksp_data_lo<=gaddr_lo) & (gaddr_hi<=wksp_data_hi)) ) ) {
+      FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed because checkpt partition [0x%016lx,0x%016lx) tag %lu "
+                       "does not fit into wksp data region [0x%016lx,0x%016lx)",
+                       path, wksp->name, gaddr_lo, gaddr_hi, tag, wksp_data_lo, wksp_data_hi ));
+      err = EPROTO;
+      goto fini;
+    }
+    gaddr_last = gaddr_hi;
+  }
+
+  /* Validate the frames exactly tile the partitions */
+
+  int   has_ref   = 0;
+  ulong frame_idx = 0UL;
+  for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) {
+    ulong gaddr_lo = part[ part_idx ].gaddr_lo;
+    ulong gaddr_hi = gaddr_lo + part[ part_idx ].sz;
+    while( gaddr_lo<gaddr_hi ) {
+      if( FD_UNLIKELY( frame_idx>=frame_cnt ) ) goto bad_frame;
+      fd_wksp_private_frame_t const * f = frame + frame_idx;
+      ulong codec = f->codec & ~FD_WKSP_PRIVATE_FRAME_CODEC_REF;
+      if( FD_UNLIKELY( !( (f->gaddr_lo==gaddr_lo) & (0UL<f->sz) & (f->sz<=fd_ulong_min( gaddr_hi-gaddr_lo, FD_WKSP_CHECKPT_FRAME_SZ_MAX )) ) ) )
+        goto bad_frame;
+      if( codec==FD_WKSP_PRIVATE_FRAME_CODEC_RAW ) {
+        if( FD_UNLIKELY( f->csz!=f->sz ) ) goto bad_frame;
+      } else if( codec==FD_WKSP_PRIVATE_FRAME_CODEC_ZSTD ) {
+#       if FD_HAS_ZSTD
+        if( FD_UNLIKELY( f->csz>buf_sz ) ) goto bad_frame;
+#       else
+        FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed because checkpt is zstd compressed and this build "
+                         "does not have zstd support", path, wksp->name ));
+        err = EPROTO;
+        goto fini;
+#       endif
+      } else goto bad_frame;
+      has_ref |= !!(f->codec & FD_WKSP_PRIVATE_FRAME_CODEC_REF);
+      gaddr_lo += f->sz;
+      frame_idx++;
+    }
+  }
+  if( FD_UNLIKELY( frame_idx!=frame_cnt ) ) goto bad_frame;
+
+  if( has_ref ) {
+    if( FD_UNLIKELY( !base_len ) ) goto bad_frame;
+    base_fd = open( base, O_RDONLY, (mode_t)0 );
+    if( FD_UNLIKELY( base_fd==-1 ) ) {
+      err = errno;
+      FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed because its base checkpt could not be opened; "
+                       "open(\"%s\",O_RDONLY,0) failed (%i-%s)", path, wksp->name, base, err, fd_io_strerror( err ) ));
+      goto fini;
+    }
+  }
+
+  if( FD_LIKELY( buf_sz ) ) {
+    buf = fd_wksp_private_frame_mmap( thread_cnt*buf_sz );
+    if( FD_UNLIKELY( !buf ) ) { err = ENOMEM; goto fini; }
+  }
+
+  /* Restore the frames into the wksp */
+
+  *_dirty = 1;
+
+  for( ulong part_idx=0UL; part_idx<part_cnt; part_idx++ ) {
+    ulong gaddr_lo = part[ part_idx ].gaddr_lo;
+    ulong sz       = part[ part_idx ].sz;
+#   if FD_HAS_DEEPASAN
+    /* Poison the restored allocations (see fd_wksp_restore) */
+    ulong laddr_lo = (ulong)fd_wksp_laddr_fast( wksp, gaddr_lo );
+    ulong laddr_hi = laddr_lo + sz;
+    ulong aligned_laddr_lo = fd_ulong_align_up( laddr_lo, FD_ASAN_ALIGN );
+    ulong aligned_laddr_hi = fd_ulong_align_dn( laddr_hi, FD_ASAN_ALIGN );
+    if( aligned_laddr_lo < aligned_laddr_hi ) {
+      fd_asan_poison( (void*)aligned_laddr_lo, aligned_laddr_hi - aligned_laddr_lo );
+    }
+#   endif
+    fd_wksp_private_pinfo_t * pinfo = fd_wksp_private_pinfo( wksp ) + part_idx;
+    pinfo->gaddr_lo = gaddr_lo;
+    pinfo->gaddr_hi = gaddr_lo + sz;
+    pinfo->tag      = part[ part_idx ].tag;
+  }
+
+  fd_wksp_private_frame_ctx_t ctx[1] = {{
+    .wksp       = wksp,
+    .frame      = frame,
+    .base_frame = NULL,
+    .fd         = fd,
+    .base_fd    = base_fd,
+    .cursor     = 0UL,
+    .buf        = buf,
+    .buf_sz     = buf_sz,
+    .t0         = t0,
+    .err        = 0,
+    .err_idx    = ULONG_MAX
+  }};
+
+  fd_wksp_private_frame_exec( tpool, t0, t1, fd_wksp_private_restore_frame_task, ctx, frame_cnt );
+
+  err = ctx->err;
+  if( FD_UNLIKELY( err ) ) {
+    fd_wksp_private_frame_t const * f = frame + ctx->err_idx;
+    FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed for frame [0x%016lx,0x%016lx) from \"%s\" (%i-%s)",
+                     path, wksp->name, f->gaddr_lo, f->gaddr_lo + f->sz,
+                     (f->codec & FD_WKSP_PRIVATE_FRAME_CODEC_REF) ? base : path, err, fd_io_strerror( err ) ));
+    goto fini;
+  }
+
+  *_part_cnt = part_cnt;
+
+fini:
+  if( FD_UNLIKELY( (base_fd!=-1) && close( base_fd ) ) )
+    FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", base, errno, fd_io_strerror( errno ) ));
+  fd_wksp_private_frame_munmap( buf,   thread_cnt*buf_sz                              );
+  fd_wksp_private_frame_munmap( frame, frame_cnt*sizeof(fd_wksp_private_frame_t)      );
+  fd_wksp_private_frame_munmap( part,  part_cnt *sizeof(fd_wksp_private_frame_part_t) );
+  return err;
+
+bad_frame:
+  FD_LOG_WARNING(( "Restore \"%s\" to wksp \"%s\" failed due to checkpt format error (bad frame)", path, wksp->name ));
+  err = EPROTO;
+  goto fini;
+}
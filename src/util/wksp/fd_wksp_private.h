@@ -596,6 +596,54 @@ fd_wksp_private_restore_buf( fd_io_buffered_istream_t * in,
                              ulong                      buf_max,
                              ulong *                    _buf_sz );
 
+/* fd_wksp_private_checkpt_header writes the checkpt header (magic,
+   style and the metadata common to all styles) for wksp to the output
+   stream checkpt.  wbuf_sz is checkpt's wbuf_sz.  Returns 0 on success
+   and non-zero on failure (will be an errno compat error code). */
+
+int
+fd_wksp_private_checkpt_header( fd_io_buffered_ostream_t * checkpt,
+                                ulong                      wbuf_sz,
+                                fd_wksp_t *                wksp,
+                                int                        style,
+                                char const *               uinfo );
+
+/* fd_wksp_private_checkpt_frame writes a FRAME style checkpt.  See
+   fd_wksp_checkpt_tpool for details.  Assumes the arguments have
+   already been validated and the wksp is not locked by the caller. */
+
+int
+fd_wksp_private_checkpt_frame( fd_tpool_t * tpool,
+                               ulong        t0,
+                               ulong        t1,
+                               fd_wksp_t *  wksp,
+                               char const * path,
+                               ulong        mode,
+                               char const * uinfo,
+                               char const * base );
+
+/* fd_wksp_private_restore_frame restores the allocations of a FRAME
+   style checkpt into wksp.  restore is the input stream of the checkpt
+   at path (with file descriptor fd), positioned just after the metadata
+   common to all styles.  [data_lo,data_hi) is the checkpt's data region.
+   Assumes the caller holds the wksp lock.  On return, wksp's first
+   *_part_cnt pinfo give the restored partitions and *_dirty is 1 if the
+   wksp memory was modified.  Returns 0 on success and non-zero on
+   failure (logs details). */
+
+int
+fd_wksp_private_restore_frame( fd_tpool_t *               tpool,
+                               ulong                      t0,
+                               ulong                      t1,
+                               fd_wksp_t *                wksp,
+                               char const *               path,
+                               int                        fd,
+                               fd_io_buffered_istream_t * restore,
+                               ulong                      data_lo,
+                               ulong                      data_hi,
+                               ulong *                    _part_cnt,
+                               int *                      _dirty );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_util_wksp_fd_wksp_private_h */
@@ -0,0 +1,256 @@
+#include "../fd_util.h"
+
+#if FD_HAS_HOSTED
+
+#include <errno.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Tests FRAME style checkpts (full and incremental, serial and with a
+   tpool) round trip and benchmarks them against RAW style checkpts. */
+
+#define ALLOC_MAX (1024UL)
+
+static ulong alloc_gaddr[ ALLOC_MAX ];
+static ulong alloc_sz   [ ALLOC_MAX ];
+static ulong alloc_hash [ ALLOC_MAX ];
+
+static void
+alloc_fill( fd_wksp_t * wksp,
+            ulong       idx,
+            fd_rng_t *  rng ) {
+  uchar * mem = (uchar *)fd_wksp_laddr_fast( wksp, alloc_gaddr[ idx ] );
+  ulong   sz  = alloc_sz[ idx ];
+
+  /* Half random (incompressible) and half a repeating pattern */
+
+  ulong i = 0UL;
+  for( ; i<sz/2UL; i++ ) mem[ i ] = (uchar)fd_rng_uint( rng );
+  for( ; i<sz;     i++ ) mem[ i ] = (uchar)(i*idx);
+
+  alloc_hash[ idx ] = fd_hash( 0UL, mem, sz );
+}
+
+static void
+alloc_check( fd_wksp_t * wksp,
+             ulong       alloc_cnt ) {
+  for( ulong idx=0UL; idx<alloc_cnt; idx++ )
+    FD_TEST( fd_hash( 0UL, fd_wksp_laddr_fast( wksp, alloc_gaddr[ idx ] ), alloc_sz[ idx ] )==alloc_hash[ idx ] );
+}
+
+/* scribble overwrites all allocations (such that a restore that
+   silently skips a frame is detected) */
+
+static void
+scribble( fd_wksp_t * wksp,
+          ulong       alloc_cnt ) {
+  for( ulong idx=0UL; idx<alloc_cnt; idx++ ) memset( fd_wksp_laddr_fast( wksp, alloc_gaddr[ idx ] ), 0xa5, alloc_sz[ idx ] );
+}
+
+static ulong
+file_sz( char const * path ) {
+  struct stat st[1];
+  FD_TEST( !stat( path, st ) );
+  return (ulong)st->st_size;
+}
+
+/* file_flip flips the bits of the byte at offset off of path */
+
+static void
+file_flip( char const * path,
+           ulong        off ) {
+  int fd = open( path, O_RDWR, (mode_t)0 ); FD_TEST( fd!=-1 );
+  uchar b;
+  FD_TEST( pread ( fd, &b, 1UL, (off_t)off )==1L );
+  b = (uchar)~b;
+  FD_TEST( pwrite( fd, &b, 1UL, (off_t)off )==1L );
+  FD_TEST( !close( fd ) );
+}
+
+static void
+file_rm( char const * path ) {
+  if( FD_UNLIKELY( unlink( path ) && errno!=ENOENT ) ) FD_LOG_ERR(( "unlink(\"%s\") failed", path ));
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",   NULL,      "gigantic" );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",  NULL,             1UL );
+  ulong        near_cpu  = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",  NULL, fd_log_cpu_id() );
+  ulong        alloc_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--alloc-cnt", NULL,            256UL );
+  ulong        sz_max    = fd_env_strip_cmdline_ulong( &argc, &argv, "--sz-max",    NULL,         262144UL );
+  ulong        big_sz    = fd_env_strip_cmdline_ulong( &argc, &argv, "--big-sz",    NULL,       20UL<<20 );
+  char const * dir       = fd_env_strip_cmdline_cstr ( &argc, &argv, "--dir",       NULL,           "/tmp" );
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz                      ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+  if( FD_UNLIKELY( !alloc_cnt                    ) ) FD_LOG_ERR(( "--alloc-cnt should be positive" ));
+  if( FD_UNLIKELY( alloc_cnt>ALLOC_MAX-1UL       ) ) FD_LOG_ERR(( "--alloc-cnt too large for this unit test" ));
+  if( FD_UNLIKELY( !sz_max                       ) ) FD_LOG_ERR(( "--sz-max should be positive" ));
+
+  FD_LOG_NOTICE(( "Testing with --page-sz %s --page-cnt %lu --near-cpu %lu --alloc-cnt %lu --sz-max %lu --big-sz %lu --dir %s",
+                  _page_sz, page_cnt, near_cpu, alloc_cnt, sz_max, big_sz, dir ));
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Create a tpool from the tiles */
+
+  static uchar tpool_mem[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned( FD_TPOOL_ALIGN )));
+
+  ulong        tile_cnt = fd_tile_cnt();
+  fd_tpool_t * tpool    = fd_tpool_init( tpool_mem, tile_cnt ); FD_TEST( tpool );
+  for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ ) FD_TEST( fd_tpool_worker_push( tpool, tile_idx, NULL, 0UL ) );
+  FD_LOG_NOTICE(( "Using %lu tpool threads", tile_cnt ));
+
+  /* Populate the wksp (the big allocation spans multiple frames) */
+
+  for( ulong idx=0UL; idx<=alloc_cnt; idx++ ) {
+    ulong sz = idx<alloc_cnt ? 1UL+fd_rng_ulong_roll( rng, sz_max ) : big_sz;
+    alloc_gaddr[ idx ] = fd_wksp_alloc( wksp, 1UL, sz, 1UL+(idx%7UL) ); FD_TEST( alloc_gaddr[ idx ] );
+    alloc_sz   [ idx ] = sz;
+    alloc_fill( wksp, idx, rng );
+  }
+  alloc_cnt++;
+
+  char raw [ PATH_MAX ]; FD_TEST( fd_cstr_printf_check( raw,  PATH_MAX, NULL, "%s/test_wksp_checkpt_frame.%lu.raw",  dir, fd_log_group_id() ) );
+  char full[ PATH_MAX ]; FD_TEST( fd_cstr_printf_check( full, PATH_MAX, NULL, "%s/test_wksp_checkpt_frame.%lu.full", dir, fd_log_group_id() ) );
+  char incr[ PATH_MAX ]; FD_TEST( fd_cstr_printf_check( incr, PATH_MAX, NULL, "%s/test_wksp_checkpt_frame.%lu.incr", dir, fd_log_group_id() ) );
+  char ser [ PATH_MAX ]; FD_TEST( fd_cstr_printf_check( ser,  PATH_MAX, NULL, "%s/test_wksp_checkpt_frame.%lu.ser",  dir, fd_log_group_id() ) );
+  file_rm( raw ); file_rm( full ); file_rm( incr ); file_rm( ser );
+
+  /* Bad args */
+
+  FD_TEST( fd_wksp_checkpt_tpool( tpool, 1UL, 1UL, wksp, full, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "", NULL )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_tpool( tpool, 0UL, 1UL, wksp, full, 0600UL, FD_WKSP_CHECKPT_STYLE_RAW,   "", raw  )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_tpool( tpool, 0UL, 1UL, wksp, full, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "", raw  )==FD_WKSP_ERR_FAIL  ); /* no base */
+
+  /* Full checkpts */
+
+  long dt_raw = -fd_log_wallclock();
+  FD_TEST( !fd_wksp_checkpt( wksp, raw, 0600UL, FD_WKSP_CHECKPT_STYLE_RAW, "raw" ) );
+  dt_raw += fd_log_wallclock();
+
+  long dt_ser = -fd_log_wallclock();
+  FD_TEST( !fd_wksp_checkpt_tpool( NULL, 0UL, 1UL, wksp, ser, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "ser", NULL ) );
+  dt_ser += fd_log_wallclock();
+
+  long dt_full = -fd_log_wallclock();
+  FD_TEST( !fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, full, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "full", NULL ) );
+  dt_full += fd_log_wallclock();
+
+  FD_TEST( fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, full, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "full", NULL ) ); /* exists */
+
+  uint  preview_seed;
+  ulong preview_part_max;
+  ulong preview_data_max;
+  FD_TEST( !fd_wksp_restore_preview( full, &preview_seed, &preview_part_max, &preview_data_max ) );
+  FD_TEST( preview_seed    ==fd_wksp_seed    ( wksp ) );
+  FD_TEST( preview_part_max==fd_wksp_part_max( wksp ) );
+  FD_TEST( preview_data_max==fd_wksp_data_max( wksp ) );
+
+  /* Restore (serial and parallel) */
+
+  scribble( wksp, alloc_cnt );
+  FD_TEST( !fd_wksp_restore( wksp, ser, 1234U ) );
+  FD_TEST( !fd_wksp_verify( wksp ) );
+  alloc_check( wksp, alloc_cnt );
+
+  scribble( wksp, alloc_cnt );
+  long dt_restore_raw = -fd_log_wallclock();
+  FD_TEST( !fd_wksp_restore( wksp, raw, 1234U ) );
+  dt_restore_raw += fd_log_wallclock();
+  alloc_check( wksp, alloc_cnt );
+
+  scribble( wksp, alloc_cnt );
+  long dt_restore_full = -fd_log_wallclock();
+  FD_TEST( !fd_wksp_restore_tpool( tpool, 0UL, tile_cnt, wksp, full, 1234U ) );
+  dt_restore_full += fd_log_wallclock();
+  FD_TEST( !fd_wksp_verify( wksp ) );
+  alloc_check( wksp, alloc_cnt );
+  for( ulong idx=0UL; idx<alloc_cnt; idx++ ) FD_TEST( fd_wksp_tag( wksp, alloc_gaddr[ idx ] )==1UL+(idx%7UL) );
+
+  /* Incremental checkpt after changing some allocations */
+
+  ulong chg_cnt = 0UL;
+  for( ulong idx=0UL; idx<alloc_cnt; idx+=8UL ) { alloc_fill( wksp, idx, rng ); chg_cnt++; }
+
+  long dt_incr = -fd_log_wallclock();
+  FD_TEST( !fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, incr, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "incr", full ) );
+  dt_incr += fd_log_wallclock();
+
+  FD_TEST( file_sz( incr )<file_sz( full ) );
+
+  scribble( wksp, alloc_cnt );
+  FD_TEST( !fd_wksp_restore_tpool( tpool, 0UL, tile_cnt, wksp, incr, 1234U ) );
+  FD_TEST( !fd_wksp_verify( wksp ) );
+  alloc_check( wksp, alloc_cnt );
+
+  /* An incremental checkpt can't be a base and can't be restored
+     without its base */
+
+  file_rm( ser );
+  FD_TEST( fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, ser, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "", incr )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, ser, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "", raw  )==FD_WKSP_ERR_FAIL  );
+
+  FD_TEST( !rename( full, ser ) );
+  FD_TEST( fd_wksp_restore( wksp, incr, 1234U )==FD_WKSP_ERR_FAIL );
+  FD_TEST( !rename( ser, full ) );
+  FD_TEST( !fd_wksp_restore( wksp, incr, 1234U ) );
+  alloc_check( wksp, alloc_cnt );
+
+  /* A base whose frame bytes differ from the wksp although its index
+     hashes match is not referenced (the hashes are not trusted) */
+
+  file_rm( incr ); file_rm( ser );
+  FD_TEST( !fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, ser, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "ser", NULL ) );
+  ulong ser_sz = file_sz( ser );
+  for( ulong off=ser_sz/8UL; off<ser_sz/2UL; off+=ser_sz/32UL ) file_flip( ser, off ); /* frame payloads, not the index */
+  FD_TEST( !fd_wksp_checkpt_tpool( tpool, 0UL, tile_cnt, wksp, incr, 0600UL, FD_WKSP_CHECKPT_STYLE_FRAME, "incr", ser ) );
+  FD_TEST( file_sz( incr )<file_sz( full ) ); /* untouched base frames still referenced */
+
+  scribble( wksp, alloc_cnt );
+  FD_TEST( !fd_wksp_restore_tpool( tpool, 0UL, tile_cnt, wksp, incr, 1234U ) );
+  FD_TEST( !fd_wksp_verify( wksp ) );
+  alloc_check( wksp, alloc_cnt );
+
+  ulong sz = 0UL; for( ulong idx=0UL; idx<alloc_cnt; idx++ ) sz += alloc_sz[ idx ];
+  FD_LOG_NOTICE(( "%lu allocations, %lu bytes, %lu changed for incremental", alloc_cnt, sz, chg_cnt ));
+  FD_LOG_NOTICE(( "style\tcheckpt (GB/s)\trestore (GB/s)\tsize (bytes)" ));
+  FD_LOG_NOTICE(( "raw\t%.3f\t%.3f\t%lu",          (double)sz/(double)dt_raw,  (double)sz/(double)dt_restore_raw,  file_sz( raw  ) ));
+  FD_LOG_NOTICE(( "frame serial\t%.3f\t-\t-",      (double)sz/(double)dt_ser                                                       ));
+  FD_LOG_NOTICE(( "frame\t%.3f\t%.3f\t%lu",        (double)sz/(double)dt_full, (double)sz/(double)dt_restore_full, file_sz( full ) ));
+  FD_LOG_NOTICE(( "frame incr\t%.3f\t-\t%lu",      (double)sz/(double)dt_incr,                                     file_sz( incr ) ));
+
+  file_rm( raw ); file_rm( full ); file_rm( incr ); file_rm( ser );
+
+  for( ulong tile_idx=tile_cnt-1UL; tile_idx>0UL; tile_idx-- ) FD_TEST( fd_tpool_worker_pop( tpool ) );
+  FD_TEST( fd_tpool_fini( tpool )==(void *)tpool_mem );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_wksp_delete_anonymous( wksp );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif